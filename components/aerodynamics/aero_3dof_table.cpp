@@ -9,6 +9,8 @@
 //   Use for: Missiles, aircraft with aerodynamic data
 //
 // INPUTS (from vehicle array):
+//   vehicle[0]  - grav - double - Gravity acceleration m/s²
+//   vehicle[50] - mprop - int - Motor flag (0=off, 1=on)
 //   vehicle[56] - vmach - double - Mach number
 //   vehicle[57] - pdynmc - double - Dynamic pressure Pa
 //   vehicle[61] - mass - double - Vehicle mass kg
@@ -113,11 +113,11 @@ void Vehicle::forces(double int_step)
 	}
 
 	//Specific force (includes both gravity and drag)
-	//Note: In Earth frame, gravity is downward (negative Z)
+	//Note: In Earth frame Z is down, so gravity is positive Z
 	//Drag opposes velocity
 	FSPB[0] = -drag_mag * VBEL_unit[0]; // Drag in X
 	FSPB[1] = -drag_mag * VBEL_unit[1]; // Drag in Y
-	FSPB[2] = -drag_mag * VBEL_unit[2] - grav; // Drag in Z + gravity (down)
+	FSPB[2] = -drag_mag * VBEL_unit[2] + grav; // Drag in Z + gravity (down)
 
 	//loading module-variables
 	//output to other modules
@@ -10,6 +10,7 @@
 //   Use for: Air-to-air missiles, surface-to-air missiles, guided projectiles
 //
 // INPUTS (from vehicle array):
+//   vehicle[0]  - grav - double - Gravity acceleration m/s²
 //   vehicle[30] - gmax - double - Maximum g available g's
 //   vehicle[81] - dvta - double - Closing velocity m/s
 //   vehicle[87] - UTAA - Matrix(3x1) - Unit LOS vector in missile body coords
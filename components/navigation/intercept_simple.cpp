@@ -76,7 +76,7 @@ void Vehicle::init_intercept()
 	//Initialize
 	vehicle[160].gets(0.0);      // miss
 	vehicle[161].gets(0.0);      // tintercept
-	vehicle[162].gets_int(0);    // intercept_flag
+	vehicle[162].gets(0);    // intercept_flag
 	vehicle[164].gets(0.0);      // dvta_prev
 }
 
@@ -141,7 +141,7 @@ void Vehicle::intercept(double int_step)
 	//output to other modules
 	vehicle[160].gets(miss);
 	vehicle[161].gets(tintercept);
-	vehicle[162].gets_int(intercept_flag);
+	vehicle[162].gets(intercept_flag);
 	//saved values
 	vehicle[164].gets(dvta_prev);
 }
@@ -138,7 +138,8 @@ void Vehicle::target(double int_step)
 
 	//Integrate position: s = s0 + v*dt
 	Matrix STELD = VTEL;
-	STEL = integrate(STELD, Matrix(3,1), STEL, int_step);
+	//velocity is constant, so the previous derivative equals the current one
+	STEL = integrate(STELD, STELD, STEL, int_step);
 
 	//-------------------------------------------------------------------------
 	//loading module-variables
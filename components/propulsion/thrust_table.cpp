@@ -93,7 +93,7 @@ void Vehicle::init_propulsion()
 
 	//Initialize mass and motor status
 	vehicle[61].gets(mass_init);
-	vehicle[50].gets_int(1);  // Motor starts ON
+	vehicle[50].gets(1);  // Motor starts ON
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -149,7 +149,7 @@ void Vehicle::propulsion(double int_step)
 	//-------------------------------------------------------------------------
 	//loading module-variables
 	//output to other modules
-	vehicle[50].gets_int(mprop);
+	vehicle[50].gets(mprop);
 	vehicle[60].gets(thrust);
 	vehicle[61].gets(mass);
 }
@@ -125,6 +125,6 @@ void Vehicle::termination(double int_step)
 	//-------------------------------------------------------------------------
 	//loading module-variables
 	//output to executive
-	vehicle[5].gets_int(stop);
-	vehicle[6].gets_int(lconv);
+	vehicle[5].gets(stop);
+	vehicle[6].gets(lconv);
 }
@@ -0,0 +1,181 @@
+///////////////////////////////////////////////////////////////////////////////
+//FILE: 'benchmark.cpp'
+//Stand-alone check and timing of the 'combus' proximity grid
+//Built and run by 'make bench-grid' (not part of the simulation executable)
+//
+//A synthetic engagement of 500 vehicles on 'combus': 250 missiles 'm1...',
+// 125 aircraft 'a1...' and 125 rockets 'r1...', scattered over a 60x60 km
+// area between 1 and 12 km altitude and flying straight and level at
+// 300 m/s. Every step each missile
+//	- looks up its paired aircraft by 'id' and
+//	- searches its seeker field of regard (7 km, 40 deg half angle)
+// once by scanning all of 'combus' and once through the grid. Both must
+// return the same slots in the same order.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "class_hierarchy.hpp"
+#include <chrono>
+#include <iomanip>
+
+///////////////////////////////////////////////////////////////////////////////
+//Seconds elapsed since 'start', which is reset to now
+///////////////////////////////////////////////////////////////////////////////
+static double lap(std::chrono::steady_clock::time_point &start)
+{
+	std::chrono::steady_clock::time_point now=std::chrono::steady_clock::now();
+	double dt=std::chrono::duration<double>(now-start).count();
+	start=now;
+	return dt;
+}
+///////////////////////////////////////////////////////////////////////////////
+//All-pairs reference of 'Grid::fov()': rockets and aircraft within 'radius'
+// of 'apex' and inside the cone of half angle 'half' about 'axis'
+///////////////////////////////////////////////////////////////////////////////
+static int fov_scan(int *found,Packet *combus,int num_vehicles,const double *apex,const double *axis,
+					double half,double radius)
+{
+	double cos_half=cos(half);
+	int nfound(0);
+	for(int i=0;i<num_vehicles;i++)
+	{
+		string id=combus[i].get_id();
+		if(id[0]!='r'&&id[0]!='a') continue;
+		if(combus[i].get_status()!=1) continue;
+		Matrix SXEL=combus[i].get_data()[4].vec();
+		double d1=SXEL[0]-apex[0];
+		double d2=SXEL[1]-apex[1];
+		double d3=SXEL[2]-apex[2];
+		double dd=d1*d1+d2*d2+d3*d3;
+		if(dd>radius*radius||dd<SMALL) continue;
+		double proj=d1*axis[0]+d2*axis[1]+d3*axis[2];
+		if(proj>=sqrt(dd)*cos_half) found[nfound++]=i;
+	}
+	return nfound;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Main function of the benchmark
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	const int nmissile=250;
+	const int naircraft=125;
+	const int nvehicle=500;
+	const int nstep=100;
+	const double step=0.1;
+	const double radius=7000;
+	const double half=40*RAD;
+	int i(0),k(0);
+
+	//vehicles on 'combus': missile 'SBEL' is data[3], rocket and aircraft 'SAEL' is data[4]
+	Packet *combus=new Packet[nvehicle];
+	Variable *data=new Variable[5*nvehicle];
+	double *pos=new double[3*nvehicle];
+	double *vel=new double[3*nvehicle];
+	double *axis=new double[3*nmissile];
+	char number[CHARN];
+	srand(1);
+	for(i=0;i<nvehicle;i++){
+		string id;
+		if(i<nmissile) {sprintf(number,"%d",i+1);id="m"+string(number);}
+		else if(i<nmissile+naircraft) {sprintf(number,"%d",i-nmissile+1);id="a"+string(number);}
+		else {sprintf(number,"%d",i-nmissile-naircraft+1);id="r"+string(number);}
+		combus[i].set_id(id);
+		combus[i].set_status(1);
+		combus[i].set_ndata(5);
+		combus[i].set_data(data+5*i);
+		pos[3*i]=60000*unituni();
+		pos[3*i+1]=60000*unituni();
+		pos[3*i+2]=-1000-11000*unituni();
+		double psi=2*PI*unituni();
+		vel[3*i]=300*cos(psi);
+		vel[3*i+1]=300*sin(psi);
+		vel[3*i+2]=0;
+	}
+	//seeker boresights, 20 deg below the horizontal
+	for(i=0;i<nmissile;i++){
+		double psi=2*PI*unituni();
+		axis[3*i]=cos(20*RAD)*cos(psi);
+		axis[3*i+1]=cos(20*RAD)*sin(psi);
+		axis[3*i+2]=sin(20*RAD);
+	}
+	Grid grid(nvehicle,GRID_CELL);
+	int *found_scan=new int[nvehicle];
+	int *found_grid=new int[nvehicle];
+	double time_scan(0),time_grid(0),time_id_scan(0),time_id_grid(0);
+	long nhit(0),nmismatch(0);
+
+	for(int n=0;n<nstep;n++)
+	{
+		//flying all vehicles
+		for(i=0;i<nvehicle;i++){
+			for(k=0;k<3;k++) pos[3*i+k]+=vel[3*i+k]*step;
+			Matrix SXEL(3,1);
+			SXEL.build_vec3(pos[3*i],pos[3*i+1],pos[3*i+2]);
+			data[5*i+(i<nmissile?3:4)].gets_vec(SXEL);
+		}
+		std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+
+		//all-pairs: 'id' comparison and field-of-regard scan of 'combus'
+		int slot_scan(0);
+		for(i=0;i<nmissile;i++){
+			sprintf(number,"%d",i%naircraft+1);
+			string target="a"+string(number);
+			for(k=0;k<nvehicle;k++)
+				if(combus[k].get_id()==target) {slot_scan+=k;break;}
+		}
+		time_id_scan+=lap(start);
+		for(i=0;i<nmissile;i++){
+			int nfound=fov_scan(found_scan,combus,nvehicle,pos+3*i,axis+3*i,half,radius);
+			nhit+=nfound;
+		}
+		time_scan+=lap(start);
+
+		//grid: building, 'id' look-up and field-of-regard query
+		grid.build(combus,nvehicle);
+		int slot_grid(0);
+		for(i=0;i<nmissile;i++){
+			sprintf(number,"%d",i%naircraft+1);
+			slot_grid+=grid.slot("a"+string(number));
+		}
+		time_id_grid+=lap(start);
+		for(i=0;i<nmissile;i++){
+			Matrix APEX(3,1),UAXIS(3,1);
+			APEX.build_vec3(pos[3*i],pos[3*i+1],pos[3*i+2]);
+			UAXIS.build_vec3(axis[3*i],axis[3*i+1],axis[3*i+2]);
+			grid.fov(found_grid,nvehicle,APEX,UAXIS,half,radius,"ra");
+		}
+		time_grid+=lap(start);
+
+		//same slots in the same order
+		if(slot_scan!=slot_grid) nmismatch++;
+		for(i=0;i<nmissile;i++){
+			Matrix APEX(3,1),UAXIS(3,1);
+			APEX.build_vec3(pos[3*i],pos[3*i+1],pos[3*i+2]);
+			UAXIS.build_vec3(axis[3*i],axis[3*i+1],axis[3*i+2]);
+			int nscan=fov_scan(found_scan,combus,nvehicle,pos+3*i,axis+3*i,half,radius);
+			int ngrid=grid.fov(found_grid,nvehicle,APEX,UAXIS,half,radius,"ra");
+			if(nscan!=ngrid) {nmismatch++;continue;}
+			for(k=0;k<nscan;k++)
+				if(found_scan[k]!=found_grid[k]) {nmismatch++;break;}
+		}
+	}
+	cout<<"\n *** Proximity grid benchmark: "<<nvehicle<<" vehicles, "<<nmissile
+		<<" missiles, "<<nstep<<" steps ***\n";
+	cout<<fixed<<setprecision(3);
+	cout<<"  field-of-regard hits per missile and step "<<(double)nhit/nmissile/nstep<<'\n';
+	cout<<"                     all-pairs scan     grid (incl. build)\n";
+	cout<<"  id look-up      "<<setw(12)<<time_id_scan/nstep*1e3<<" ms"
+		<<setw(16)<<time_id_grid/nstep*1e3<<" ms   per step\n";
+	cout<<"  field of regard "<<setw(12)<<time_scan/nstep*1e3<<" ms"
+		<<setw(16)<<time_grid/nstep*1e3<<" ms   per step\n";
+	cout<<" *** "<<nmismatch<<" mismatches between scan and grid ***\n";
+
+	delete [] combus;
+	delete [] data;
+	delete [] pos;
+	delete [] vel;
+	delete [] axis;
+	delete [] found_scan;
+	delete [] found_grid;
+	return nmismatch?1:0;
+}
@@ -34,6 +34,27 @@ Flat6::Flat6()
 	for(int i=0;i<NFLAT6;i++)flat6[i].init("empty",0," "," "," "," ");
 }
 ///////////////////////////////////////////////////////////////////////////////
+//Attaching the state derivatives of 'newton' to an output plan for dense output
+//
+//The first 'flat6_count' entries of 'plan' must have been compiled from
+// 'flat6[flat6_ind[i]]'. Each integrated state receives its derivative:
+// SBEL <- SBELD, VBEB <- VBEBD
+///////////////////////////////////////////////////////////////////////////////
+
+void Flat6::dense_rates(Output *plan,int *flat6_ind,int flat6_count)
+{
+	int column(0);
+
+	for(int i=0;i<flat6_count;i++)
+	{
+		int rate_ind(0);
+		if(flat6_ind[i]==219) rate_ind=216;
+		else if(flat6_ind[i]==213) rate_ind=210;
+		else continue;
+		plan[i].rate=flat6[rate_ind].output(column).vec;
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
 //Constructor initializing the modules and the module-variable arrays
 //Reading input data from 'input.asc' and putting into 'flat6' and 'missile' arrays 
 //Writing banners to screen, 'tabout.asc' and to 'traj.asc' files  
@@ -134,6 +155,11 @@ Missile::Missile(Module *module_list,int num_modules,int num_rocket)
 	flat6_com_ind=new int[flat6_com_count];
 	missile_com_ind=new int[missile_com_count];
 
+	//allocating memory for the output plans
+	scrn_plan=new Output[flat6_scrn_count+missile_scrn_count];
+	plot_plan=new Output[flat6_plot_count+missile_plot_count];
+	com_plan=new Output[flat6_com_count+missile_com_count];
+
 	//allocating memory for the 'grnd_range' array
 	grnd_range=new double[num_rocket];
 
@@ -187,6 +213,9 @@ Missile::~Missile()
 	delete [] missile_plot_ind;
 	delete [] flat6_com_ind;
 	delete [] missile_com_ind;
+	delete [] scrn_plan;
+	delete [] plot_plan;
+	delete [] com_plan;
 	delete [] grnd_range;
 	delete [] &event_ptr_list;
 }
@@ -206,6 +235,27 @@ Flat3::Flat3()
 	for(int i=0;i<NFLAT3;i++)flat3[i].init("empty",0," "," "," "," ");
 }
 ///////////////////////////////////////////////////////////////////////////////
+//Attaching the state derivatives of 'newton' to an output plan for dense output
+//
+//The first 'flat3_count' entries of 'plan' must have been compiled from
+// 'flat3[flat3_ind[i]]'. Each integrated state receives its derivative:
+// SAEL <- VAEL, VAEL <- AAEL
+///////////////////////////////////////////////////////////////////////////////
+
+void Flat3::dense_rates(Output *plan,int *flat3_ind,int flat3_count)
+{
+	int column(0);
+
+	for(int i=0;i<flat3_count;i++)
+	{
+		int rate_ind(0);
+		if(flat3_ind[i]==26) rate_ind=27;
+		else if(flat3_ind[i]==27) rate_ind=28;
+		else continue;
+		plan[i].rate=flat3[rate_ind].output(column).vec;
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
 //Constructor initializing the modules and the module-variable arrays
 //				  
 //010205 Created by Peter H Zipfel
@@ -255,6 +305,9 @@ Rocket::Rocket(Module *module_list,int num_modules)
 	if(!flat3_com_ind){cerr<<"*** Error: flat3_com_count[] allocation failed *** \n";system("pause");exit(1);}
 	rocket_com_ind=new int[rocket_com_count];
 	if(!rocket_com_ind){cerr<<"*** Error: rocket_com_count[] allocation failed *** \n";system("pause");exit(1);}
+
+	//allocating memory for the output plan
+	com_plan=new Output[flat3_com_count+rocket_com_count];
 	com_rocket3=new Variable[ncom_rocket5];
 	if(!com_rocket3){cerr<<"*** Error: com_missile6[] allocation failed *** \n";system("pause");exit(1);}
 
@@ -274,6 +327,7 @@ Rocket::~Rocket()
 	delete [] flat3;
 	delete [] flat3_com_ind;
 	delete [] rocket_com_ind;
+	delete [] com_plan;
 	delete [] com_rocket3;
 }
 ///////////////////////////////////////////////////////////////////////////////
@@ -318,6 +372,9 @@ Aircraft::Aircraft(Module *module_list,int num_modules)
 	if(!flat3_com_ind){cerr<<"*** Error: flat3_com_count[] allocation failed *** \n";system("pause");exit(1);}
 	aircraft_com_ind=new int[aircraft_com_count];
 	if(!aircraft_com_ind){cerr<<"*** Error: aircraft_com_count[] allocation failed *** \n";system("pause");exit(1);}
+
+	//allocating memory for the output plan
+	com_plan=new Output[flat3_com_count+aircraft_com_count];
 	com_aircraft3=new Variable[ncom_aircraft3];
 	if(!com_aircraft3){cerr<<"*** Error: com_missile6[] allocation failed *** \n";system("pause");exit(1);}
 
@@ -335,6 +392,7 @@ Aircraft::~Aircraft()
 	delete [] flat3;
 	delete [] flat3_com_ind;
 	delete [] aircraft_com_ind;
+	delete [] com_plan;
 	delete [] com_aircraft3;
 }
 ///////////////////////////////////////////////////////////////////////////////
@@ -387,6 +445,9 @@ Radar::Radar(Module *module_list,int num_modules)
 	if(!flat0_com_ind){cerr<<"*** Error: flat0_com_count[] allocation failed *** \n";system("pause");exit(1);}
 	radar_com_ind=new int[radar_com_count];
 	if(!radar_com_ind){cerr<<"*** Error: radar_com_count[] allocation failed *** \n";system("pause");exit(1);}
+
+	//allocating memory for the output plan
+	com_plan=new Output[flat0_com_count+radar_com_count];
 	com_radar0=new Variable[ncom_radar0];
 	if(!com_radar0){cerr<<"*** Error: com_missile6[] allocation failed *** \n";system("pause");exit(1);}
 
@@ -404,6 +465,7 @@ Radar::~Radar()
 	delete [] flat0;
 	delete [] flat0_com_ind;
 	delete [] radar_com_ind;
+	delete [] com_plan;
 	delete [] com_radar0;
 }
 ///////////////////////////////////////////////////////////////////////////////
@@ -97,7 +97,8 @@ public:
 	virtual void scrn_data()=0;
 	virtual void plot_banner(ofstream &fplot,char *title)=0;
 	virtual void plot_index_arrays()=0;
-	virtual void plot_data(ofstream &fplot,bool merge)=0;
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step)=0;
+	virtual void record_output()=0;
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot)=0;
 	virtual void event(char *options)=0;
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle)=0;
@@ -138,9 +139,9 @@ public:
 	virtual void init_ins()=0;
 	virtual void ins(double int_step)=0;
 	virtual void def_sensor()=0;
-	virtual void sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim_time,double int_step)=0;
+	virtual void sensor(Packet *combus,Grid &grid,int num_vehicles,int vehicle_slot,double sim_time,double int_step)=0;
 	virtual void def_intercept()=0;
-	virtual void intercept(Packet *combus,int vehicle_slot,double int_step,char *title)=0;
+	virtual void intercept(Packet *combus,Grid &grid,int vehicle_slot,double int_step,char *title)=0;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -185,7 +186,8 @@ public:
 	virtual void scrn_data()=0;
 	virtual void plot_banner(ofstream &fplot,char *title)=0;
 	virtual void plot_index_arrays()=0;
-	virtual void plot_data(ofstream &fplot,bool merge)=0;
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step)=0;
+	virtual void record_output()=0;
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot)=0;
 	virtual void event(char *options)=0;
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle)=0;
@@ -216,9 +218,9 @@ public:
 	virtual void init_ins()=0;
 	virtual void ins(double int_step)=0;
 	virtual void def_sensor()=0;
-	virtual void sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim_time,double int_step)=0;
+	virtual void sensor(Packet *combus,Grid &grid,int num_vehicles,int vehicle_slot,double sim_time,double int_step)=0;
 	virtual void def_intercept()=0;
-	virtual void intercept(Packet *combus,int vehicle_slot,double int_step,char *title)=0;
+	virtual void intercept(Packet *combus,Grid &grid,int vehicle_slot,double int_step,char *title)=0;
 
 	//virtual functions to be declared in this class
 	virtual void def_environment();
@@ -231,6 +233,9 @@ public:
 	virtual void newton(double int_step);
 	virtual void def_euler();
 	virtual void euler(double int_step);
+
+	//attaching the state derivatives of 'newton' to an output plan
+	void dense_rates(Output *plan,int *flat6_ind,int flat6_count);
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -280,6 +285,11 @@ protected:
 	//be written to 'combus' 'packets'
 	int *missile_com_ind; int missile_com_count;
 
+	//output plans compiled by the index arrays and executed by the writers
+	Output *scrn_plan; int nscrn_plan;
+	Output *plot_plan; int nplot_plan;
+	Output *com_plan; int ncom_plan;
+
 	//array of ground distances of 'Missile' object from all 'Rocket' objects
 	double *grnd_range;
 
@@ -312,7 +322,8 @@ public:
 	virtual void scrn_data();
 	virtual void plot_banner(ofstream &fplot,char *title);
 	virtual void plot_index_arrays();
-	virtual void plot_data(ofstream &fplot,bool merge);
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step);
+	virtual void record_output();
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot);
 	virtual void event(char *options);
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle);
@@ -343,9 +354,9 @@ public:
 	virtual void init_ins();
 	virtual void ins(double int_step);
 	virtual void def_sensor();
-	virtual void sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim_time,double int_step);
+	virtual void sensor(Packet *combus,Grid &grid,int num_vehicles,int vehicle_slot,double sim_time,double int_step);
 	virtual void def_intercept();
-	virtual void intercept(Packet *combus,int vehicle_slot,double int_step,char *title);
+	virtual void intercept(Packet *combus,Grid &grid,int vehicle_slot,double int_step,char *title);
 
 	//functions in respective modules
 	void aerodynamics_der();
@@ -363,7 +374,7 @@ public:
 	Matrix guidance_term_comp(double int_step);
 	Matrix guidance_term_pronav(double int_step);
 	
-	Matrix Missile::guidance_line(Matrix SIBLC,double psiflx,double thtflx);
+	Matrix guidance_line(Matrix SIBLC,double psiflx,double thtflx);
 	void sensor_rf_dyn(double &lamdrb,double &lamdqb,double &dab,double &ddab, double &ethtc,double &epsic,
 					    double &aztbx, double &eltbx, Matrix SBTL,double int_step);
 	Matrix sensor_rf_glint();
@@ -411,7 +422,8 @@ public:
 	virtual void scrn_data()=0;
 	virtual void plot_banner(ofstream &fplot,char *title)=0;
 	virtual void plot_index_arrays()=0;
-	virtual void plot_data(ofstream &fplot,bool merge)=0;
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step)=0;
+	virtual void record_output()=0;
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot)=0;
 	virtual void event(char *options)=0;
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle)=0;
@@ -442,9 +454,9 @@ public:
 	virtual void init_ins()=0;
 	virtual void ins(double int_step)=0;
 	virtual void def_sensor()=0;
-	virtual void sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim_time,double int_step)=0;
+	virtual void sensor(Packet *combus,Grid &grid,int num_vehicles,int vehicle_slot,double sim_time,double int_step)=0;
 	virtual void def_intercept()=0;
-	virtual void intercept(Packet *combus,int vehicle_slot,double int_step,char *title)=0;
+	virtual void intercept(Packet *combus,Grid &grid,int vehicle_slot,double int_step,char *title)=0;
 
 	//dummy returns of unused modules
 	virtual void def_euler(){};
@@ -459,6 +471,9 @@ public:
 	virtual void def_newton();
 	virtual void init_newton();
 	virtual void newton(double int_step);
+
+	//attaching the state derivatives of 'newton' to an output plan
+	void dense_rates(Output *plan,int *flat3_ind,int flat3_count);
 };
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -487,6 +502,9 @@ protected:
 	//be written to 'combus' 'packets'
 	int *rocket_com_ind; int rocket_com_count;
 
+	//output plan of 'com' compiled by 'com_index_arrays()', executed by 'traj_data()'
+	Output *com_plan; int ncom_plan;
+
 	//array of module-variables that carry Markov process random values
 	Markov markov_list[NMARKOV]; int nmarkov;
 
@@ -513,7 +531,8 @@ public:
 	virtual void scrn_data(){};
 	virtual void plot_banner(ofstream &fplot,char *title){};
 	virtual void plot_index_arrays(){};
-	virtual void plot_data(ofstream &fplot,bool merge){};
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step){};
+	virtual void record_output();
 	virtual void event(char *options){};
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot){};
 
@@ -546,7 +565,7 @@ public:
 	virtual void def_propulsion();
 	virtual void propulsion();
 	virtual void def_sensor();
-	virtual void sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim_time,double int_step);
+	virtual void sensor(Packet *combus,Grid &grid,int num_vehicles,int vehicle_slot,double sim_time,double int_step);
 	virtual void def_control();
 	virtual void control(double int_step);
 	virtual void def_guidance();
@@ -554,7 +573,7 @@ public:
 	virtual void def_forces();
 	virtual void forces();
 	virtual void def_intercept();
-	virtual void intercept(Packet *combus,int vehicle_slot,double int_step,char *title);
+	virtual void intercept(Packet *combus,Grid &grid,int vehicle_slot,double int_step,char *title);
 };
 ///////////////////////////////////////////////////////////////////////////////
 //Derived class:Aircraft
@@ -581,6 +600,9 @@ protected:
 	//be written to 'combus' 'packets'
 	int *aircraft_com_ind; int aircraft_com_count;
 
+	//output plan of 'com' compiled by 'com_index_arrays()', executed by 'traj_data()'
+	Output *com_plan; int ncom_plan;
+
 public:
 	Aircraft(){};
 	Aircraft(Module *module_list,int num_modules);
@@ -597,7 +619,8 @@ public:
 	virtual void scrn_data(){};
 	virtual void plot_banner(ofstream &fplot,char *title){};
 	virtual void plot_index_arrays(){};
-	virtual void plot_data(ofstream &fplot,bool merge){};
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step){};
+	virtual void record_output();
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot){};
 	virtual void event(char *options){};
 	virtual void markov_noise(double sim_time,double int_step,int nmonte){};
@@ -627,9 +650,9 @@ public:
 	virtual void init_ins(){};
 	virtual void ins(double int_step){};
 	virtual void def_intercept(){};
-	virtual void intercept(Packet *combus,int vehicle_slot,double int_step,char *title){};
+	virtual void intercept(Packet *combus,Grid &grid,int vehicle_slot,double int_step,char *title){};
 	virtual void def_sensor(){};
-	virtual void sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim_time,double int_step){};
+	virtual void sensor(Packet *combus,Grid &grid,int num_vehicles,int vehicle_slot,double sim_time,double int_step){};
 
 	//module functions active
 	virtual void def_control();
@@ -671,7 +694,8 @@ public:
 	virtual void scrn_data()=0;
 	virtual void plot_banner(ofstream &fplot,char *title)=0;
 	virtual void plot_index_arrays()=0;
-	virtual void plot_data(ofstream &fplot,bool merge)=0;
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step)=0;
+	virtual void record_output()=0;
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot)=0;
 	virtual void event(char *options)=0;
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle)=0;
@@ -702,9 +726,9 @@ public:
 	virtual void init_ins()=0;
 	virtual void ins(double int_step)=0;
 	virtual void def_sensor()=0;
-	virtual void sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim_time,double int_step)=0;
+	virtual void sensor(Packet *combus,Grid &grid,int num_vehicles,int vehicle_slot,double sim_time,double int_step)=0;
 	virtual void def_intercept()=0;
-	virtual void intercept(Packet *combus,int vehicle_slot,double int_step,char *title)=0;
+	virtual void intercept(Packet *combus,Grid &grid,int vehicle_slot,double int_step,char *title)=0;
 
 	//dummy returns of unused modules
 	virtual void def_euler(){};
@@ -745,6 +769,9 @@ protected:
 	//be written to 'combus' 'packets'
 	int *radar_com_ind; int radar_com_count;
 
+	//output plan of 'com' compiled by 'com_index_arrays()', executed by 'traj_data()'
+	Output *com_plan; int ncom_plan;
+
 	//array of module-variables that carry Markov process random values
 	Markov markov_list[NMARKOV]; int nmarkov;
 
@@ -771,7 +798,8 @@ public:
 	virtual void scrn_data(){};
 	virtual void plot_banner(ofstream &fplot,char *title){};
 	virtual void plot_index_arrays(){};
-	virtual void plot_data(ofstream &fplot,bool merge){};
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step){};
+	virtual void record_output();
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot){};
 	virtual void event(char *options){};
 	virtual void markov_noise(double sim_time,double int_step,int nmonte){};
@@ -801,7 +829,7 @@ public:
 	virtual void init_ins(){};
 	virtual void ins(double int_step){};
 	virtual void def_intercept(){};
-	virtual void intercept(Packet *combus,int vehicle_slot,double int_step,char *title){};
+	virtual void intercept(Packet *combus,Grid &grid,int vehicle_slot,double int_step,char *title){};
 	virtual void def_control(){};
 	virtual void control(double int_step){};
 	virtual void def_forces(){};
@@ -811,7 +839,7 @@ public:
 
 	//module functions active
 	virtual void def_sensor();
-	virtual void sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim_time,double int_step);
+	virtual void sensor(Packet *combus,Grid &grid,int num_vehicles,int vehicle_slot,double sim_time,double int_step);
 };
 ///////////////////////////////////////////////////////////////////////////////
 
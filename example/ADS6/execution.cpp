@@ -25,7 +25,7 @@ using namespace std;
 
 //acquiring the simmulation title
 void acquire_title_options(fstream &input,char *title,char *options,int &nmonte,
-						   int &iseed,int &nmc);
+						   int &iseed,char *sampling,int &nmc);
 
 //acquiring the simulation run time
 double acquire_endtime(fstream &input);
@@ -47,7 +47,7 @@ Cadac *set_obj_type(fstream &input,Module *module_list,int num_modules,
 void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			 double end_time,int num_vehicles,int num_modules,double plot_step,
 			 double int_step,double scrn_step,double com_step,double traj_step,char *options,
-			 ofstream &ftabout,ofstream *plot_ostream_list,Packet *combus,int *status,
+			 ofstream &ftabout,ofstream *plot_ostream_list,Packet *combus,Grid &grid,int *status,
 			 int num_missile,int num_rocket,int num_aircraft,int num_radar,ofstream &ftraj,char *title,bool traj_merge,
 			 int nmonte,int nmc,ofstream *stat_ostream_list,bool *stati_write_term,double *launch_delay_list);
 
@@ -73,7 +73,7 @@ void traj_banner(ofstream &ftraj,Packet *combus,char *title,int num_vehicles,
 				 int nmissile,int nrocket,int naircraft,int nradar);
 
 //writing 'traj.asc' file of 'combus' data
-void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge,double sim_time);
+void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge,double sim_time,double frac,double step);
 
 //Documenting 'input.asc' with module-variable definitions
 void document_input(Document *doc_missile6,Document *doc_rocket5,Document *doc_aircraft3,Document *doc_radar0);
@@ -120,6 +120,7 @@ int main()
 	int nmonte=0; //number of MC runs to be executed
 	int nmc=0; //MC counter
 	int iseed=0; //seeding srand()
+	char sampling[CHARN]="RANDOM"; //DOE method of the static dispersions
 	bool one_traj_banner=true; //write just one banner on file 'traj.asc'
 	bool *stati_write_term=NULL; //flag for writing impact data on 'stati.asc' once
 	Document *doc_missile6=NULL;  //array for documenting MISSILE6 module-variables of 'input.asc'
@@ -172,10 +173,14 @@ int main()
 		bool traj_merge=false; //flag used in writing 'time=-1' endblock on 'traj.asc'
 		
 		//aqcuiring title statement and option selections
-		acquire_title_options(input,title,options,nmonte,iseed,nmc);
+		acquire_title_options(input,title,options,nmonte,iseed,sampling,nmc);
 
-		//initializing random number generator
-		if(!nmc) srand(iseed); 
+		//initializing random number generator and design of experiments
+		if(!nmc){
+			srand(iseed);
+			doe_initialize(sampling,nmonte,iseed);
+		}
+		doe_run(nmc);
 
 		//acquiring number of module 
 		number_modules(input,num_modules);
@@ -200,6 +205,9 @@ int main()
 		//creating the 'vehicle_list' object
 		// at this point the constructor 'Vehicle' is called and memory is allocated
 		Vehicle vehicle_list(num_vehicles);
+
+		//creating the proximity grid over the 'combus' vehicle positions
+		Grid grid(num_vehicles,GRID_CELL);
 		
 		//allocating memory for 'ploti.asc' file streams, but do it only once
 		if(!nmc){
@@ -415,7 +423,7 @@ int main()
 			traj_banner(ftraj,combus,title,num_vehicles,num_missile,num_rocket,num_aircraft,num_radar);
 
 			//writing data after 'initial module' calculations
-			traj_data(ftraj,combus,num_vehicles,traj_merge,sim_time);
+			traj_data(ftraj,combus,num_vehicles,traj_merge,sim_time,1,0);
 		}
 
 		//acuire ending time (last entry on 'input.asc')
@@ -438,7 +446,7 @@ int main()
 		execute(vehicle_list,module_list,sim_time,
 				 end_time,num_vehicles,num_modules,plot_step,
 				 int_step,scrn_step,com_step,traj_step,options,ftabout,
-				 plot_ostream_list,combus,status,num_missile,num_rocket,num_aircraft,num_radar,ftraj,title,
+				 plot_ostream_list,combus,grid,status,num_missile,num_rocket,num_aircraft,num_radar,ftraj,title,
 				 traj_merge,nmonte,nmc,stat_ostream_list,stati_write_term,launch_delay_list);
 
 		//deallocating dynamic memory
@@ -544,6 +552,7 @@ int main()
 //				*plot_ostream_list = output file-steam list of 'ploti.asc' for each individual missile 
 //								missile object
 //				*combus = commumication bus
+//				&grid = proximity grid over 'combus', rebuilt every integration step
 //				*status = health of vehicles
 //				num_missile = number of 'Missile' objects
 //				num_rocket = number of 'Rocket' objects
@@ -568,7 +577,7 @@ int main()
 void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			 double end_time,int num_vehicles,int num_modules,double plot_step,
 			 double int_step,double scrn_step,double com_step,double traj_step,char *options,
-			 ofstream &ftabout,ofstream *plot_ostream_list,Packet *combus,int *status,
+			 ofstream &ftabout,ofstream *plot_ostream_list,Packet *combus,Grid &grid,int *status,
 			 int num_missile,int num_rocket,int num_aircraft,int num_radar,ofstream &ftraj,char *title,bool traj_merge,
 			 int nmonte,int nmc,ofstream *stat_ostream_list,bool *stati_write_term,double *launch_delay_list)
 {
@@ -578,9 +587,10 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 	double com_time(0);
 	int vehicle_slot(0);
 	bool increment_scrn_time(false);
-	bool increment_plot_time(false);
 	bool plot_merge(false);
 	double out_fact(0);
+	double sim_time_last(sim_time-int_step);
+	bool *holding=new bool[num_vehicles];
 	Variable *data_t;
 	string radar_id="f1";
 	double lnch_delay_m1(0);
@@ -593,10 +603,14 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 	//integration loop
 	while (sim_time<=(end_time+int_step))
 	{
+		//indexing the 'combus' vehicle positions for the sensor and intercept modules
+		grid.build(combus,num_vehicles);
+
 		//vehicle loop
 		for (int i=0;i<num_vehicles;i++)
 		{
-			if(sim_time<launch_delay_list[i]);
+			holding[i]=sim_time<launch_delay_list[i];
+			if(holding[i]);
 				//vehicle is holding at initial point
 			else			
 			{
@@ -649,9 +663,9 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 						else if(module_list[j].name=="ins")
 							vehicle_list[i]->ins(int_step);
 						else if(module_list[j].name=="sensor")
-							vehicle_list[i]->sensor(combus,num_vehicles,vehicle_slot,sim_time,int_step);
+							vehicle_list[i]->sensor(combus,grid,num_vehicles,vehicle_slot,sim_time,int_step);
 						else if(module_list[j].name=="intercept")
-							vehicle_list[i]->intercept(combus,vehicle_slot,int_step,title);
+							vehicle_list[i]->intercept(combus,grid,vehicle_slot,int_step,title);
 					} //end of module loop
 
 					//preserving 'health' status of vehicle objects
@@ -687,16 +701,6 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 					if(increment_scrn_time) scrn_time+=scrn_step*(1+out_fact);
 				}
 
-				//output to 'ploti.asc' file
-				if(fabs(plot_time-sim_time)<(int_step/2+EPS))
-				{
-					if(strstr(options,"y_plot"))
-					{
-						vehicle_list[i]->plot_data(plot_ostream_list[i],plot_merge);
-						if(i==(num_vehicles-1))increment_plot_time=true;
-					}
-					if(increment_plot_time) plot_time+=plot_step*(1+out_fact);
-				}
 				//output to 'stati.asc' file 
 				if(strstr(options,"y_stat"))
 				{
@@ -728,6 +732,26 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 
 		} //end of vehicle loop
 
+		//dense output: plot and traj times passed during the last step are sampled
+		//exactly, interpolating between 'sim_time_last' and 'sim_time'
+		double step=sim_time-sim_time_last;
+		double snap=int_step/100;
+
+		//output to 'ploti.asc' files of the progressing vehicles
+		if(strstr(options,"y_plot"))
+		{
+			while(plot_time>sim_time_last&&plot_time<sim_time+snap)
+			{
+				double frac(1);
+				if(fabs(plot_time-sim_time)>=snap) frac=(plot_time-sim_time_last)/step;
+				for(int i=0;i<num_vehicles;i++)
+					if(!holding[i])
+						vehicle_list[i]->plot_data(plot_ostream_list[i],plot_merge,frac,step);
+				if(plot_step*(1+out_fact)<=0) break;
+				plot_time+=plot_step*(1+out_fact);
+			}
+		}
+
 		//outputting 'combus' to screen 
 		if(fabs(com_time-sim_time)<(int_step/2+EPS))
 		{
@@ -738,17 +762,27 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			com_time+=com_step*(1+out_fact);
 		}
 		//outputting'combus' to 'traj.asc' file
-		if(fabs(traj_time-sim_time)<(int_step/2+EPS))
+		if(strstr(options,"y_traj"))
 		{
-			if(strstr(options,"y_traj"))
+			while(traj_time>sim_time_last&&traj_time<sim_time+snap)
 			{
-				traj_data(ftraj,combus,num_vehicles,traj_merge,sim_time);
+				double frac(1);
+				if(fabs(traj_time-sim_time)>=snap) frac=(traj_time-sim_time_last)/step;
+				traj_data(ftraj,combus,num_vehicles,traj_merge,sim_time,frac,step);
+				if(traj_step*(1+out_fact)<=0) break;
+				traj_time+=traj_step*(1+out_fact);
 			}
-			traj_time+=traj_step*(1+out_fact);
 		}
+		//recording the output plans at the end of the step for dense output
+		if(strstr(options,"y_plot")||strstr(options,"y_traj"))
+		{
+			for(int i=0;i<num_vehicles;i++)
+				vehicle_list[i]->record_output();
+		}
+		sim_time_last=sim_time;
+
 		//resetting output events
 		increment_scrn_time=false;
-		increment_plot_time=false;
 
 		//advancing time
 		sim_time+=int_step;
@@ -761,15 +795,16 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 	{
 		plot_merge=true;
 		for (int i=0;i<num_vehicles;i++)
-			vehicle_list[i]->plot_data(plot_ostream_list[i],plot_merge);
+			vehicle_list[i]->plot_data(plot_ostream_list[i],plot_merge,1,0);
 	}
 	//writing last integration out to 'traj.asc' 
 	//with time set to '-1' for multiple CADAC-Studio plots
 	if(strstr(options,"y_traj"))
 	{
 		traj_merge=true;
-		traj_data(ftraj,combus,num_vehicles,traj_merge,sim_time);
+		traj_data(ftraj,combus,num_vehicles,traj_merge,sim_time,1,0);
 	}
+	delete [] holding;
 } 
 
 
@@ -58,4 +58,6 @@ int const NRADAR=50;					//size of 'rocket' module-variable array
 int const NEVENT=20;					//max number of events
 int const NVAR=20;						//max number of variables to be input at every event 
 int const NMARKOV=10;					//max number of Markov noise variables
+//spatial index of 'combus'
+double const GRID_CELL=5000;			//cell edge of the 'combus' proximity grid - m
 #endif
\ No newline at end of file
@@ -17,7 +17,7 @@ using namespace std;
 //Acquiring simulation title and option line from the input file 'input.asc'.
 //Printing of title banner to screen
 //
-//Parameter output: *title, *options, &nmonte, &iseed
+//Parameter output: *title, *options, &nmonte, &iseed, *sampling
 //
 //Parameter input: &nmc
 //
@@ -25,7 +25,7 @@ using namespace std;
 //020919 Added 'document_input()', PZi
 ///////////////////////////////////////////////////////////////////////////////
 
-void acquire_title_options(fstream &input,char *title,char *options,int &nmonte,int &iseed,int &nmc)
+void acquire_title_options(fstream &input,char *title,char *options,int &nmonte,int &iseed,char *sampling,int &nmc)
 { 
 	char read[CHARN];
 	char line_clear[CHARL];
@@ -48,6 +48,14 @@ void acquire_title_options(fstream &input,char *title,char *options,int &nmonte,
 		{
 			input>>nmonte;
 			input>>iseed;
+			//optional DOE method of the static dispersions, see 'doe_initialize()'
+			input.getline(line_clear,CHARL,'\n');
+			strcpy(sampling,"RANDOM");
+			char *token=strtok(line_clear," \t\r");
+			if(token&&!ispunct(token[0])){
+				strncpy(sampling,token,CHARN-1);
+				sampling[CHARN-1]='\0';
+			}
 			cout<<" MONTE Run # "<<nmc+1<<'\n';
 		}
 	}while((strcmp(read,"OPTIONS"))&&(n<50));
@@ -738,20 +746,21 @@ void traj_banner(ofstream &ftraj,Packet *combus,char *title,int num_vehicles,
 //five accross, unlimited down
 //data field 16 spaces, total width 80 spaces
 //
+//Parameter input:
+//	frac = fraction of the last integration step 'step' at which the data are
+//		sampled; frac=1 writes the current values
+//
 //010212 Created by Peter H Zipfel
 //011129 Adapted to Missile6 simulation, PZi
 //071104 Added 'Aircraft', PZi
 //170912 Replacing in traj.asc combus 'time' by 'sim_time', PZi
 ///////////////////////////////////////////////////////////////////////////////
 
-void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge,double sim_time)
+void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge,double sim_time,double frac,double step)
 {
 
-	char *integer;
-	char *name;
-	Matrix VEC(3,1);
 	int k(0);
-	Variable *data;
+	Output *plan=NULL;
 	int ndata(0);
 	string id;
 	int missile_object(0);
@@ -774,6 +783,7 @@ void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge,double
 		//z170912 ### replacing combus 'time' by 'sim_time'
 		//Variable *data_m1=combus[0].get_data();
 		//double time=data_m1[0].real();
+		if(frac<1) sim_time-=(1-frac)*step;
 		ftraj.width(16);
 		ftraj<<sim_time;
 		k=1;
@@ -792,48 +802,40 @@ void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge,double
 		if(!missile_object)
 		//'Missile' object
 		{
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//writing communication variables to 'traj.asc'
 			for(int j=1;j<ndata;j++)
 			{
-				integer=data[j].get_type();
-				name=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<(double) data[j].integer();			
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<(double) *out.integer;
 					k++;
 				}
-				//checking for vectors
-				else if(isupper(name[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(0,0);
-					k++; 
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(1,0);
-					k++;
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>4){k=0;ftraj<<'\n';}
+						ftraj.width(16);
+						if(frac<1) ftraj<<out.sample(m,frac,step);
+						else ftraj<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<data[j].real(); 
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<*out.real;
 					k++;
 				}
 			}
@@ -842,48 +844,40 @@ void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge,double
 		else if(!rocket_object)
 		//'Rocket' object
 		{
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//writing communication variables to 'traj.asc'
 			for(int j=1;j<ndata;j++)
 			{
-				integer=data[j].get_type();
-				name=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<(double) data[j].integer();			
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<(double) *out.integer;
 					k++;
 				}
-				//checking for vectors
-				else if(isupper(name[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(0,0);
-					k++; 
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(1,0);
-					k++;
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>4){k=0;ftraj<<'\n';}
+						ftraj.width(16);
+						if(frac<1) ftraj<<out.sample(m,frac,step);
+						else ftraj<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<data[j].real(); 
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<*out.real;
 					k++;
 				}
 			}
@@ -892,48 +886,40 @@ void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge,double
 		else if(!aircraft_object)
 		//'Aircraft' object
 		{
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//writing communication variables to 'traj.asc'
 			for(int j=1;j<ndata;j++)
 			{
-				integer=data[j].get_type();
-				name=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<(double) data[j].integer();			
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<(double) *out.integer;
 					k++;
 				}
-				//checking for vectors
-				else if(isupper(name[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(0,0);
-					k++; 
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(1,0);
-					k++;
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>4){k=0;ftraj<<'\n';}
+						ftraj.width(16);
+						if(frac<1) ftraj<<out.sample(m,frac,step);
+						else ftraj<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<data[j].real(); 
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<*out.real;
 					k++;
 				}
 			}
@@ -943,48 +929,40 @@ void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge,double
 		else if(!radar_object)
 		//'Radar' object
 		{
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//writing communication variables to 'traj.asc'
 			for(int j=1;j<ndata;j++)
 			{
-				integer=data[j].get_type();
-				name=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<(double) data[j].integer();			
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<(double) *out.integer;
 					k++;
 				}
-				//checking for vectors
-				else if(isupper(name[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(0,0);
-					k++; 
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(1,0);
-					k++;
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>4){k=0;ftraj<<'\n';}
+						ftraj.width(16);
+						if(frac<1) ftraj<<out.sample(m,frac,step);
+						else ftraj<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<data[j].real(); 
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<*out.real;
 					k++;
 				}
 			}
@@ -1031,10 +1009,7 @@ void comscrn_data(Packet *combus,int num_vehicles,double sim_time)
 	Variable *data_aircraft; //Variable array stored in 'Packet data' of type aircraft
 	Variable *data_radar; //Variable array stored in 'Packet data' of type radar
 	int ndata;
-	Variable *data;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
+	Output *plan=NULL;
 	int i(0);
 	int k(0);
 
@@ -1154,8 +1129,8 @@ void comscrn_data(Packet *combus,int num_vehicles,double sim_time)
 			//'Missile' object
 			{
 				p++;
-				data=combus[i].get_data();
 				ndata=combus[i].get_ndata();
+				plan=combus[i].get_plan();
 
 				//write out label of i-th object
 				cout<<"\n *** m_";cout.width(8);cout<<p;
@@ -1164,42 +1139,31 @@ void comscrn_data(Packet *combus,int num_vehicles,double sim_time)
 				//writing communication variables to screen
 				for(int j=1;j<ndata;j++)
 				{
-					integer=data[j].get_type();
-					vector=data[j].get_name();
-
-					//checking for integer variables
-					if(!strcmp(integer,"int"))
+					Output &out=plan[j];
+					if(out.kind==1)
 					{
 						//casting integer to real variable
 						if(k>7){k=0;cout<<'\n';}
 						cout.width(15);
-						cout<<(double) data[j].integer();			
+						cout<<(double) *out.integer;
 						k++;
 					}
-					//checking vor vectors
-					else if(isupper(vector[0]))
+					else if(out.kind==2)
 					{
-						VEC=data[j].vec();
-
-						if(k>7){k=0;cout<<'\n';}
-						cout.width(15);
-						cout<<VEC.get_loc(0,0);
-						k++; 
-						if(k>7){k=0;cout<<'\n';}
-						cout.width(15);
-						cout<<VEC.get_loc(1,0);
-						k++;
-						if(k>7){k=0;cout<<'\n';}
-						cout.width(15);
-						cout<<VEC.get_loc(2,0);
-						k++;
+						double *vec=out.vec->get_pbody();
+						for(int m=0;m<3;m++)
+						{
+							if(k>7){k=0;cout<<'\n';}
+							cout.width(15);
+							cout<<vec[m];
+							k++;
+						}
 					}
-					//left are real variables
 					else
 					{
 						if(k>7){k=0;cout<<'\n';}
 						cout.width(15);
-						cout<<data[j].real(); 
+						cout<<*out.real;
 						k++;
 					}
 				}
@@ -1247,8 +1211,8 @@ void comscrn_data(Packet *combus,int num_vehicles,double sim_time)
 		//'Rocket' object
 		{
 			q++;
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//write out label of i-th object
 			cout<<"\n *** r_";cout.width(8);cout<<q;
@@ -1257,42 +1221,31 @@ void comscrn_data(Packet *combus,int num_vehicles,double sim_time)
 			//writing communication variables to screen
 			for(int j=1;j<ndata;j++)
 			{
-				integer=data[j].get_type();
-				vector=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<(double) data[j].integer();			
+					cout<<(double) *out.integer;
 					k++;
 				}
-				//checking vor vectors
-				else if(isupper(vector[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(0,0);
-					k++; 
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(1,0);
-					k++;
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>7){k=0;cout<<'\n';}
+						cout.width(15);
+						cout<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<data[j].real(); 
+					cout<<*out.real;
 					k++;
 				}
 			}
@@ -1339,8 +1292,8 @@ void comscrn_data(Packet *combus,int num_vehicles,double sim_time)
 		//'aircraft' object
 		{
 			r++;
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//write out label of i-th object
 			cout<<"\n *** a_";cout.width(8);cout<<r;
@@ -1349,42 +1302,31 @@ void comscrn_data(Packet *combus,int num_vehicles,double sim_time)
 			//writing communication variables to screen
 			for(int j=1;j<ndata;j++)
 			{
-				integer=data[j].get_type();
-				vector=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<(double) data[j].integer();			
+					cout<<(double) *out.integer;
 					k++;
 				}
-				//checking vor vectors
-				else if(isupper(vector[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(0,0);
-					k++; 
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(1,0);
-					k++;
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>7){k=0;cout<<'\n';}
+						cout.width(15);
+						cout<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<data[j].real(); 
+					cout<<*out.real;
 					k++;
 				}
 			}
@@ -1431,8 +1373,8 @@ void comscrn_data(Packet *combus,int num_vehicles,double sim_time)
 		//'radar' object
 		{
 			s++;
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//write out label of i-th object
 			cout<<"\n *** f_";cout.width(8);cout<<s;
@@ -1441,42 +1383,31 @@ void comscrn_data(Packet *combus,int num_vehicles,double sim_time)
 			//writing communication variables to screen
 			for(int j=1;j<ndata;j++)
 			{
-				integer=data[j].get_type();
-				vector=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<(double) data[j].integer();			
+					cout<<(double) *out.integer;
 					k++;
 				}
-				//checking vor vectors
-				else if(isupper(vector[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(0,0);
-					k++; 
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(1,0);
-					k++;
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>7){k=0;cout<<'\n';}
+						cout.width(15);
+						cout<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<data[j].real(); 
+					cout<<*out.real;
 					k++;
 				}
 			}
@@ -2218,8 +2149,8 @@ void parse_plot_traj_csv(string *files, int num_ucav, bool merge, string type)
 		ifs.close();
 
 		int num=i+1;
-		char cnum[3];
-		_itoa(num,cnum,10);
+		char cnum[CHARN];
+		sprintf(cnum,"%i",num);
 		string n(cnum);
 		string file;
 		ofstream csv_file;
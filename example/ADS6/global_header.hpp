@@ -1,7 +1,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 //FILE: 'global_header.hpp'
 //
-//Global structures and classes: 'Module', 'Variable', 'File', 'Event', 'Packet'
+//Global structures and classes: 'Module', 'Variable', 'File', 'Event', 'Packet', 'Grid'
 // with inline member function definitions
 //
 //001206 Created by Peter H Zipfel
@@ -37,6 +37,62 @@ struct Module
 	string termination;
 };
 
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Output'
+//
+//Entry of the output plans compiled by the index arrays, so that the writers
+// need no type or name inspection and no 'Matrix' copies during the run
+//
+//kind: =0 real, =1 integer, =2 3x1 vector
+//column: first output column of the entry; 'time' is at column 0
+//
+//Dense output: 'record()' saves the values at the end of each step, 'sample()'
+// interpolates within the last step. Vector states with a known derivative
+// 'rate' use cubic Hermite polynomials, all other reals are interpolated
+// linearly and integers hold their value until the end of the step
+///////////////////////////////////////////////////////////////////////////////
+struct Output
+{
+	double *real;
+	int *integer;
+	Matrix *vec;
+	int kind;
+	int column;
+	Matrix *rate;		//time derivative of 'vec', NULL if unknown
+	double last[3];		//values at the end of the previous step
+	double rate_last[3];	//derivative at the end of the previous step
+
+	void record()
+	{
+		if(kind==0) last[0]=*real;
+		else if(kind==1) last[0]=*integer;
+		else
+		{
+			double *pvec=vec->get_pbody();
+			for(int m=0;m<3;m++) last[m]=pvec[m];
+			if(rate)
+			{
+				double *prate=rate->get_pbody();
+				for(int m=0;m<3;m++) rate_last[m]=prate[m];
+			}
+		}
+	}
+	//value of component 'm' (m=0 for scalars) at fraction 'frac' of the last step 'step'
+	double sample(int m,double frac,double step)
+	{
+		if(kind==1) return last[0];
+		double y0=last[m];
+		double y1=(kind==2)?vec->get_pbody()[m]:*real;
+		if(!rate) return y0+(y1-y0)*frac;
+
+		double frac2=frac*frac;
+		double frac3=frac2*frac;
+		double dy0=rate_last[m]*step;
+		double dy1=rate->get_pbody()[m]*step;
+		return (2*frac3-3*frac2+1)*y0+(frac3-2*frac2+frac)*dy0+(3*frac2-2*frac3)*y1+(frac3-frac2)*dy1;
+	}
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 //Class 'Variable'
 //Establishing module-variables as type Variable
@@ -98,6 +154,41 @@ void init(char *na,
 	//001213 Created by Peter H Zipfel
 	///////////////////////////////////////////////////////////////////////////
 	char *get_name(){return name;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Copying the values of module-variable 'var', keeping the definition
+	//Refreshes the 'com' packets without reallocating 'VEC' and 'MAT'
+	///////////////////////////////////////////////////////////////////////////
+	void restore(Variable &var)
+	{
+		rval=var.rval;
+		ival=var.ival;
+		double *pvec=VEC.get_pbody();
+		double *pvec0=var.VEC.get_pbody();
+		for(int i=0;i<3;i++) pvec[i]=pvec0[i];
+		double *pmat=MAT.get_pbody();
+		double *pmat0=var.MAT.get_pbody();
+		for(int i=0;i<9;i++) pmat[i]=pmat0[i];
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Compiling the output plan entry of the module-variable at 'column'
+	//Integers are typed 'int', vectors are named in upper case, all else is real
+	//Advances 'column' by the number of values the entry writes
+	///////////////////////////////////////////////////////////////////////////
+	Output output(int &column)
+	{
+		Output entry={};
+		entry.real=&rval;
+		entry.integer=&ival;
+		entry.vec=&VEC;
+		if(!strcmp(type,"int")) entry.kind=1;
+		else if(isupper(name[0])) entry.kind=2;
+		else entry.kind=0;
+		entry.column=column;
+		column+=(entry.kind==2)?3:1;
+		return entry;
+	}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 'type' from module-variable array 
@@ -409,6 +500,7 @@ private:
 	int status;			//alive=1, dead=0 . hit=-1 (rockets are only stopped), 
 	int ndata;			//number of module-variables in data array
 	Variable *data;		//array of module-variables identified by "com" 
+	Output *plan;		//output plan of 'data', compiled by 'com_index_arrays()'
 public:
 	Packet(){};
 	~Packet(){};
@@ -440,6 +532,11 @@ public:
 	///////////////////////////////////////////////////////////////////////////
 	void set_data(Variable *vehicle_d){data=vehicle_d;}
 
+	///////////////////////////////////////////////////////////////////////////
+	//Setting the output plan of packet 'data'
+	///////////////////////////////////////////////////////////////////////////
+	void set_plan(Output *vehicle_plan){plan=vehicle_plan;}
+
 	///////////////////////////////////////////////////////////////////////////
 	//Setting packet 'data'
 	//
@@ -474,6 +571,88 @@ public:
 	//010207 Created by Peter H Zipfel
 	///////////////////////////////////////////////////////////////////////////
 	Variable *get_data(){return data;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Obtaining the output plan of 'data' from packet
+	///////////////////////////////////////////////////////////////////////////
+	Output *get_plan(){return plan;}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//Class 'Grid'
+//Broad-phase spatial index over the vehicle positions on 'combus'
+//
+//Rebuilt by 'execute()' at the start of every integration step from the
+// positions the packets hold at that moment (missile 'SBEL', rocket and
+// aircraft 'SAEL'; the radar has no position on 'combus'). Live vehicles are
+// hashed into cubic cells of edge 'cell'; the queries visit only the cells
+// overlapping the query sphere, or scan the live list if that is cheaper.
+//Resolves a vehicle 'id' (e.g. "a2") to its 'combus' slot without a scan.
+//Query results are 'combus' slots in ascending order, the order in which a
+// scan of 'combus' would have encountered them.
+//'kinds' selects vehicles by the first letter of their 'id', e.g. "ra" for
+// rockets and aircraft
+///////////////////////////////////////////////////////////////////////////////
+class Grid
+{
+private:
+	int capacity;	//number of 'combus' slots
+	int nbucket;	//number of hash buckets, power of 2
+	double cell;	//edge of the cubic cells - m
+	int nlive;		//number of vehicles indexed in the current step
+	int *list;		//[nlive] slots of the indexed vehicles, ascending
+	int *head;		//[nbucket] first slot in bucket; =-1: empty
+	int *next;		//[capacity] next slot in the same bucket; =-1: end
+	int *cellx;		//[3*capacity] cell indices of slot
+	double *pos;	//[3*capacity] position of slot at start of step - m
+	char *kind;		//[capacity] first letter of 'id'; =0: not indexed
+	int *tail;		//[capacity] tail number of 'id'
+	int *ids;		//[26*(capacity+1)] slot of 'id' by letter a-z and tail number 0...capacity; =-1: none
+	int *work;		//[capacity] scratch list of candidate slots
+
+	int bucket(int cx,int cy,int cz);
+	bool candidates(int &ncand,double *center,double radius,const char *kinds);
+public:
+	Grid(int capacity,double cell);
+	~Grid();
+	//owns its arrays: not copyable
+	Grid(const Grid&)=delete;
+	Grid &operator=(const Grid&)=delete;
+
+	///////////////////////////////////////////////////////////////////////////
+	//Indexing all live vehicles of 'combus'
+	///////////////////////////////////////////////////////////////////////////
+	void build(Packet *combus,int num_vehicles);
+
+	///////////////////////////////////////////////////////////////////////////
+	//'combus' slot of vehicle 'id'; =-1: not on 'combus'
+	///////////////////////////////////////////////////////////////////////////
+	int slot(string id);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Vehicles within 'radius' of 'CENTER'; returns their number, at most 'max'
+	///////////////////////////////////////////////////////////////////////////
+	int range(int *found,int max,Matrix CENTER,double radius,const char *kinds);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Vehicles within 'radius' of 'APEX' and inside the cone of half angle 'half'
+	// about the unit vector 'UAXIS'; returns their number, at most 'max'
+	///////////////////////////////////////////////////////////////////////////
+	int fov(int *found,int max,Matrix APEX,Matrix UAXIS,double half,double radius,const char *kinds);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Line of sight from 'SAEL' to 'SBEL' above the flat earth and not passing
+	// within 'clear' of any vehicle other than 'skip1' and 'skip2'
+	///////////////////////////////////////////////////////////////////////////
+	bool los(Matrix SAEL,Matrix SBEL,double clear,int skip1,int skip2);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Position of 'slot' at the start of the step - m
+	///////////////////////////////////////////////////////////////////////////
+	Matrix position(int slot);
+
+	int get_nlive(){return nlive;}
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -50,6 +50,7 @@ void Missile::def_intercept()
 	missile[660].init("dbt",0,"True distance between missile and target - m","intercept","diag","scrn,plot");
 	missile[661].init("psiptx",0,"Yaw angle of intercept plane - deg","intercept","/diag/data","plot");
 	missile[662].init("thtptx",0,"Pitch angle of intercept plane - deg","intercept","diag/data","plot");
+	missile[663].init("rlethal",0,"Lethal radius of warhead on other targets, =0:off - m","intercept","data","");
 }
 ///////////////////////////////////////////////////////////////////////////////
 //'intercept' module
@@ -63,6 +64,8 @@ void Missile::def_intercept()
 //
 //Parameter Input: 'vehicle_slot' is current 'Missile' object
 //Input from module-variable array: 'tgt_com_slot' target being attacked, determined in 'sensor' module
+//At intercept, other live targets within 'rlethal' of the missile are also declared 'dead';
+// they are found by a range query of the 'combus' grid
 //
 //* Intercept plane: the plane is normal to the differential  
 //  velocity vector and contains the target center of mass.
@@ -89,7 +92,7 @@ void Missile::def_intercept()
 //080422 Added miss calculations in intercept plane, PZi
 //171008 Added IP intercept for ADSim, PZi
 ///////////////////////////////////////////////////////////////////////////////
-void Missile::intercept(Packet *combus,int vehicle_slot,double int_step,char *title)
+void Missile::intercept(Packet *combus,Grid &grid,int vehicle_slot,double int_step,char *title)
 {
 	//local module-variables
 	double hit_time(0);
@@ -104,6 +107,7 @@ void Missile::intercept(Packet *combus,int vehicle_slot,double int_step,char *ti
 	int mterm=missile[650].integer();
 	double psiptx=missile[661].real();
 	double thtptx=missile[662].real();
+	double rlethal=missile[663].real();
 	//input from other modules
 	double time=flat6[0].real();
 	int stop=flat6[5].integer();
@@ -370,6 +374,24 @@ void Missile::intercept(Packet *combus,int vehicle_slot,double int_step,char *ti
 				combus[vehicle_slot].set_status(0);
 				combus[tgt_slot].set_status(0);
 
+				//other targets within the lethal radius of the warhead, from the 'combus' grid
+				if(rlethal>0)
+				{
+					int nlive=grid.get_nlive();
+					int *found=new int[nlive+1];
+					int nfound=grid.range(found,nlive,SBEL,rlethal,"ra");
+					for(int k=0;k<nfound;k++)
+					{
+						int slot=found[k];
+						if(slot==tgt_slot||combus[slot].get_status()!=1) continue;
+						combus[slot].set_status(0);
+						string id_missl=combus[vehicle_slot].get_id();
+						cout<<" *** Warhead of Missile_"<<id_missl<<" also kills target_"<<combus[slot].get_id()
+							<<" at distance = "<<(grid.position(slot)-SBEL).absolute()<<" m ***\n\n";
+					}
+					delete [] found;
+				}
+
 			}//end of closing speed change
 
 			//save from previous cycle
@@ -100,7 +100,7 @@ void Radar::def_sensor()
 //180110 Created by Peter H Zipfel
 ///////////////////////////////////////////////////////////////////////////////
 
-void Radar::sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim_time,double int_step)
+void Radar::sensor(Packet *combus,Grid &grid,int num_vehicles,int vehicle_slot,double sim_time,double int_step)
 {
 	//local variables
 	Variable *data_t;
@@ -188,20 +188,18 @@ void Radar::sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim_t
 			//next tracking epoch
 			track_epoch=sim_time+track_step;
 
-			//cycling through all vehicles to find the rocket 
+			//looking up the rockets in the grid instead of cycling through all vehicles
 			//initializing rocket counter
 			rocket_num=1;
-			//finding slot 'i' of rocket in 'combus' (same as in vehicle_list)
-			for(int i=0;i<num_vehicles;i++)
+			while(rocket_num<=3)
 			{
-				//downloading from 'combus' rocket variables
-				//getting vehicle id
-				string id=combus[i].get_id();
+				//finding slot 'i' of rocket in 'combus' (same as in vehicle_list)
 				char number[4];	
 				sprintf(number,"%i",rocket_num);
 				string rocket_id="r"+string(number);
+				int i=grid.slot(rocket_id);
 
-				if (id==rocket_id)
+				if (i>=0)
 				{
 					//downloading data from rocket packet
 					//(though in 'Flat3' the letter 'A' represents the air-target, which comprises both rocket and aircraft
@@ -371,6 +369,8 @@ void Radar::sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim_t
 					if(rocket_num>3)break;
 
 				}//one rocket tracked and corresponding missile's launch signal and IP coordinates transmitted
+				//no more rockets on 'combus'
+				else break;
 			}//all rockets tracked
 		}//end of measuring rocket parameters
 	}//end of rocket tracking
@@ -384,20 +384,18 @@ void Radar::sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim_t
 			//next tracking epoch
 			track_epoch=sim_time+track_step;
 
-			//cycling through all vehicles to find the aircraft 
+			//looking up the aircraft in the grid instead of cycling through all vehicles
 			//initializing aircraft counter
 			aircraft_num=1;
-			//finding slot 'i' of aircraft in 'combus' (same as in vehicle_list)
-			for(int i=0;i<num_vehicles;i++)
+			while(aircraft_num<=3)
 			{
-				//*Downloading from 'combus' aircraft variables
-				//getting vehicle id
-				string id=combus[i].get_id();
+				//finding slot 'i' of aircraft in 'combus' (same as in vehicle_list)
 				char number[4];	
 				sprintf(number,"%i",aircraft_num);
 				string aircraft_id="a"+string(number);
+				int i=grid.slot(aircraft_id);
 
-				if (id==aircraft_id)
+				if (i>=0)
 				{
 					//downloading data from aircraft packet
 					//(though in 'Flat3' the letter 'A' represents the air-target, which comprises both aircraft and aircraft
@@ -482,6 +480,8 @@ void Radar::sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim_t
 					if(aircraft_num>3)break;
 
 				}//one aircraft tracked and corresponding missile's launch signal and IP coordinates transmitted
+				//no more aircraft on 'combus'
+				else break;
 			}//all aircraft tracked
 		}//end of measuring aircraft parameters
 	}//end of aircraft tracking
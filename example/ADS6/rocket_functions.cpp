@@ -169,7 +169,7 @@ void Rocket::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=(second-first)/2.;
 				else
-					value=uniform(first,second);
+					value=doe_uniform(first,second);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NFLAT3;kk++)
@@ -200,7 +200,7 @@ void Rocket::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=gauss(first,second);
+					value=doe_gauss(first,second);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NFLAT3;kk++)
@@ -230,7 +230,7 @@ void Rocket::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=rayleigh(first);
+					value=doe_rayleigh(first);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NFLAT3;kk++)
@@ -260,7 +260,7 @@ void Rocket::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=exponential(first);
+					value=doe_exponential(first);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NFLAT3;kk++)
@@ -363,6 +363,33 @@ void Rocket::com_index_arrays()
 			l++;
 		}
 	}
+
+	//loading the definitions into 'com_rocket3' once and compiling its output plan
+	int column(0);
+	ncom_plan=0;
+	for(i=0;i<flat3_com_count;i++)
+	{
+		com_rocket3[ncom_plan]=flat3[flat3_com_ind[i]];
+		com_plan[ncom_plan]=com_rocket3[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	for(i=0;i<rocket_com_count;i++)
+	{
+		com_rocket3[ncom_plan]=rocket[rocket_com_ind[i]];
+		com_plan[ncom_plan]=com_rocket3[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	dense_rates(com_plan,flat3_com_ind,flat3_com_count);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Recording the 'combus' output plan at the end of the integration step
+// for dense output by 'traj_data()'
+///////////////////////////////////////////////////////////////////////////////
+
+void Rocket::record_output()
+{
+	for(int i=0;i<ncom_plan;i++)
+		com_plan[i].record();
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Initializing loading 'packet' of rocket
@@ -389,17 +416,18 @@ Packet Rocket::loading_packet_init(int num_missile,int num_aircraft,int num_rock
 	for(i=0;i<flat3_com_count;i++)
 	{
 		index=flat3_com_ind[i];
-		com_rocket3[i]=flat3[index];
+		com_rocket3[i].restore(flat3[index]);
 	}
 	for(int j=0;j<rocket_com_count;j++)
 	{
 		index=rocket_com_ind[j];
-		com_rocket3[i+j]=rocket[index];
+		com_rocket3[i+j].restore(rocket[index]);
 	}
 	//refreshing the packet
 	packet.set_id(id);
 	packet.set_status(1);
 	packet.set_data(com_rocket3);
+	packet.set_plan(com_plan);
 	packet.set_ndata(ncom_rocket5);
 
 	return packet;
@@ -429,12 +457,12 @@ Packet Rocket::loading_packet(int num_missile,int num_aircraft,int num_rocket,in
 	for(i=0;i<flat3_com_count;i++)
 	{
 		index=flat3_com_ind[i];
-		com_rocket3[i]=flat3[index];
+		com_rocket3[i].restore(flat3[index]);
 	}
 	for(int j=0;j<rocket_com_count;j++)
 	{
 		index=rocket_com_ind[j];
-		com_rocket3[i+j]=rocket[index];
+		com_rocket3[i+j].restore(rocket[index]);
 	}
 	//refreshing the packet
 	packet.set_data(com_rocket3);
@@ -618,7 +646,7 @@ void Rocket::read_tables(char *file_name,Datadeck &datatable)
 		//extracting table dimension
 		//at this point 'temp' is holding xDIM
 		int dim_check(0);
-		char dim_buff[2];
+		char dim_buff[2]={0};
 		int table_dim(0);
 		strncpy(dim_buff,temp,1);
 		//converting character to integer
@@ -282,7 +282,7 @@ void Rocket::def_sensor()
 //		
 //170911 Created by Peter H Zipfel
 ///////////////////////////////////////////////////////////////////////////////
-void Rocket::sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim_time,double int_step)
+void Rocket::sensor(Packet *combus,Grid &grid,int num_vehicles,int vehicle_slot,double sim_time,double int_step)
 {
 	//local variables
 	Matrix STEL(3,1);
@@ -754,7 +754,7 @@ void Rocket::def_intercept()
 //
 //170913 Created by Peter H Zipfel
 ///////////////////////////////////////////////////////////////////////////////
-void Rocket::intercept(Packet *combus,int vehicle_slot,double int_step,char *title)
+void Rocket::intercept(Packet *combus,Grid &grid,int vehicle_slot,double int_step,char *title)
 {
 	//input data
 	//input from other modules
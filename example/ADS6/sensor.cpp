@@ -32,7 +32,8 @@ void Missile::def_sensor()
     missile[202].init("isets1","int",0,"Sensor flag","sensor","init","");
     missile[203].init("epchac",0,"Epoch of start of sensor acquisition - s","sensor","init","");
     missile[204].init("fst_tgt_slot","int",0,"Slot of first rocket in 'combus' - ND","sensor","save","");
-    missile[205].init("mtarget","int",0,"Target flag: =1:rocket; =2:aircraft - ND","sensor","data","");
+    missile[205].init("mtarget","int",0,"Target flag: =1:rocket; =2:aircraft; =3:nearest in FOR - ND","sensor","data","");
+    missile[206].init("rocc",0,"Occlusion radius of vehicles on seeker LOS, =0:off - m","sensor","data","");
 	missile[207].init("dbtk",0,"Seeker missile-target distance - m","sensor","diag","plot,scrn");
     missile[279].init("thtpb",0,"Pitch pointing angle - rad","sensor","out","");
     missile[280].init("psipb",0,"Yaw pointing angle - rad","sensor","out","");
@@ -176,7 +177,7 @@ void Missile::def_sensor()
 //170612 Created by Peter H Zipfel
 ///////////////////////////////////////////////////////////////////////////////
 
-void Missile::sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim_time,double int_step)
+void Missile::sensor(Packet *combus,Grid &grid,int num_vehicles,int vehicle_slot,double sim_time,double int_step)
 {
 	//local variables
 	Variable *data_t;
@@ -204,6 +205,7 @@ void Missile::sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim
 	int mseek=missile[200].integer();
 	int skr_dyn=missile[201].integer();
 	int mtarget=missile[205].integer();
+	double rocc=missile[206].real();
 	double racq_ir=missile[233].real();
 	double dtimac_ir=missile[234].real();
 	double fovyaw_ir=missile[269].real();
@@ -237,14 +239,8 @@ void Missile::sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim
 	if(mtarget==1)
 	{
 		//finding 1st rocket-target slot in 'combus'
-		char number[4];
-		sprintf(number,"%i",1);
-		string first_rocket_id="r"+string(number);
-		for(int i=0;i<num_vehicles;i++)
-		{
-			string id=combus[i].get_id();
-			if (id==first_rocket_id) fst_tgt_slot=i;
-		}
+		int first_slot=grid.slot("r1");
+		if(first_slot>=0) fst_tgt_slot=first_slot;
 		//pairing rocket-target slot to 'this' missile
 		//!!!assumption for 'input.asc': MISSILE6 objects are loaded first in  (usual order)
 		//  and there is a one-on-one missile-rocket assignement (m1->r1, m2->r2, m3->r3)
@@ -262,14 +258,8 @@ void Missile::sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim
 	else if(mtarget==2)
 	{
 		//finding 1st aircraft-target slot in 'combus'
-		char number[4];
-		sprintf(number,"%i",1);
-		string first_aircraft_id="a"+string(number);
-		for(int i=0;i<num_vehicles;i++)
-		{
-			string id=combus[i].get_id();
-			if (id==first_aircraft_id) fst_tgt_slot=i;
-		}
+		int first_slot=grid.slot("a1");
+		if(first_slot>=0) fst_tgt_slot=first_slot;
 		//pairing aircraft-target slot to 'this' missile
 		//!!!assumption for 'input.asc': MISSILE6 objects are loaded first in  (usual order)
 		//  and there is a one-on-one missile-aircraft assignement (m1->a1, m2->a2, m3->a3)
@@ -283,6 +273,63 @@ void Missile::sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim
 		VTEL=data_t[5].vec();
 		dta=data_t[10].real();
 	}
+	//nearest rocket or aircraft in the seeker field-of-regard
+	else if(mtarget==3)
+	{
+		if(skr_mode>=3)
+		{
+			//seeker has acquired; keeping the target
+			tgt_slot=missile[5].integer();
+		}
+		else
+		{
+			//before acquisition paired by tail number (m1->a1, m2->a2, ...), aircraft-targets first;
+			// =-1: no target with that number, tracking waits for the field-of-regard search
+			string tail=combus[vehicle_slot].get_id().substr(1);
+			tgt_slot=grid.slot("a"+tail);
+			if(tgt_slot<0) tgt_slot=grid.slot("r"+tail);
+			if(tgt_slot>=0&&combus[tgt_slot].get_status()!=1) tgt_slot=-1;
+			int first_slot=grid.slot("a1");
+			if(first_slot<0) first_slot=grid.slot("r1");
+			if(first_slot>=0) fst_tgt_slot=first_slot;
+
+			//searching the field-of-regard, once the seeker is enabled
+			if(skr_mode==2)
+			{
+				double racq=(skr_type==1)?racq_rf:racq_ir;
+				double half=(skr_type==1)?forlim_rfx*RAD:(fovyaw_ir>fovpitch_ir?fovyaw_ir:fovpitch_ir);
+				//boresight along missile x-axis, first row of TBL
+				Matrix TBL=flat6[120].mat();
+				Matrix UBXL(3,1);
+				UBXL.build_vec3(TBL.get_loc(0,0),TBL.get_loc(0,1),TBL.get_loc(0,2));
+				int *found=new int[num_vehicles];
+				int nfound=grid.fov(found,num_vehicles,SBEL,UBXL,half,racq,"ra");
+				double dmin=racq;
+				for(int k=0;k<nfound;k++)
+				{
+					Matrix SXEL=grid.position(found[k]);
+					double dist=(SXEL-SBEL).absolute();
+					if(dist<dmin&&grid.los(SBEL,SXEL,rocc,vehicle_slot,found[k])){
+						dmin=dist;
+						tgt_slot=found[k];
+					}
+				}
+				delete [] found;
+			}
+		}
+		//downloading from 'combus' target variables for seeker tracking
+		if(tgt_slot>=0){
+			data_t=combus[tgt_slot].get_data();
+			STEL=data_t[4].vec();
+			VTEL=data_t[5].vec();
+			dta=data_t[10].real();
+		}
+		else{
+			STEL=missile[2].vec();
+			VTEL=missile[3].vec();
+			dta=missile[277].real();
+		}
+	}
 
 	//establishing true displacement vector of missile wrt target
 	SBTL=SBEL-STEL;
@@ -292,8 +339,8 @@ void Missile::sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim
 	//***RF gimbaled seeker
 	if(skr_type==1)
 	{
-		//RF seeker is enabled
-		if(skr_mode==2){
+		//RF seeker is enabled (and has a target)
+		if(skr_mode==2&&tgt_slot>=0){
 			isets1=1;
 			//is target within RF acquisition range
 			if(dbtk<racq_rf)
@@ -350,8 +397,8 @@ void Missile::sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim
 	//***IR gimbaled seeker
 	if(skr_type==2)
 	{
-		//IR sensor is enabled
-		if(skr_mode==2){
+		//IR sensor is enabled (and has a target)
+		if(skr_mode==2&&tgt_slot>=0){
 			isets1=1;
 			//is target within IR acquisition range
 			if(dbtk<racq_ir)
@@ -15,7 +15,9 @@
 //			markov
 //			rayleigh
 //			exponential
+// Design of experiments (DOE) sampling
 // Table look-up
+// Combus proximity grid
 // Integration
 // US76 Atmosphere
 //
@@ -1378,6 +1380,258 @@ double exponential(double density)
 	return value/density;
 }
 ///////////////////////////////////////////////////////////////////////////////
+//////////////////// Design of experiments (DOE) sampling /////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//The static dispersions UNI, GAUSS, RAYL and EXP of 'input.asc' draw by default
+// from rand() ('MONTE nmonte iseed' or 'MONTE nmonte iseed RANDOM').
+// Alternatively the deck selects a design after the seed:
+//	LHS			Latin hypercube, one stratum of width 1/nmonte per run
+//	SOBOL		Sobol sequence (Joe-Kuo direction numbers) with random digital shift;
+//				dispersions beyond the 21st are stratified with LHS
+//	ANTITHETIC	pairs of runs with unit samples u and 1-u; 'nmonte' must be even
+//Each occurrence of a dispersion keyword, counted in reading order of the run,
+// is one dimension of the design. Its column of samples for all 'nmonte' runs
+// is generated from 'iseed' and the dimension index alone, so run 'nmc' gets
+// the same values no matter which runs were executed before it.
+//MARKOV variables are time-correlated noise and always draw from rand().
+//
+//Usage: doe_initialize() once before the first run, doe_run() at the start
+// of every run, doe_uniform() etc. in place of uniform() etc.
+///////////////////////////////////////////////////////////////////////////////
+
+//DOE methods
+enum {DOE_RANDOM,DOE_LHS,DOE_SOBOL,DOE_ANTITHETIC};
+
+//number of Sobol dimensions with tabulated direction numbers
+const int DOE_SOBOL_DIM=21;
+const int DOE_SOBOL_BITS=32;
+
+//Joe-Kuo primitive polynomials (degree s, coefficients a) and initial
+// direction numbers m of Sobol dimensions 2..21; dimension 1 is van der Corput
+const int doe_sobol_s[DOE_SOBOL_DIM]={0,1,2,3,3,4,4,5,5,5,5,5,5,6,6,6,6,6,6,7,7};
+const int doe_sobol_a[DOE_SOBOL_DIM]={0,0,1,1,2,1,4,2,4,7,11,13,14,1,13,16,19,22,25,1,4};
+const int doe_sobol_m[DOE_SOBOL_DIM][7]={
+	{0},{1},{1,3},{1,3,1},{1,1,1},{1,1,3,3},{1,3,5,13},{1,1,5,5,17},{1,1,5,5,5},
+	{1,1,7,11,19},{1,1,5,1,1},{1,1,1,3,11},{1,3,5,5,31},{1,3,3,9,7,49},
+	{1,1,1,15,21,21},{1,3,1,13,27,49},{1,1,1,15,7,5},{1,3,1,15,13,25},
+	{1,1,5,5,19,61},{1,3,7,11,23,15,103},{1,3,7,13,13,15,69}};
+
+static int doe_method=DOE_RANDOM;	//selected DOE method
+static int doe_nmonte=0;			//number of MC runs spanned by the design
+static int doe_seed=0;				//seed of the design
+static int doe_nmc=0;				//current MC run
+static int doe_dim=0;				//next dimension to be drawn in the current run
+static double **doe_columns=NULL;	//doe_columns[dim][nmc] unit sample in (0,1)
+static int doe_ncolumns=0;			//number of columns generated
+static int doe_capacity=0;			//allocated size of 'doe_columns'
+
+///////////////////////////////////////////////////////////////////////////////
+//Pseudo-random 64-bit integers (splitmix64) for the DOE columns
+//Independent of rand(), so that the design does not depend on other draws
+///////////////////////////////////////////////////////////////////////////////
+static unsigned long long doe_next(unsigned long long &state)
+{
+	unsigned long long z=(state+=0x9e3779b97f4a7c15ULL);
+	z=(z^(z>>30))*0xbf58476d1ce4e5b9ULL;
+	z=(z^(z>>27))*0x94d049bb133111ebULL;
+	return z^(z>>31);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Uniform sample in the open interval (0,1) from 'doe_next()'
+///////////////////////////////////////////////////////////////////////////////
+static double doe_open(unsigned long long &state)
+{
+	return ((doe_next(state)>>11)+0.5)/9007199254740992.;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Generating the column of unit samples of dimension 'dim' for all MC runs
+//
+//parameter input:
+//			dim = dimension of the design (0,1,2,...)
+//return output:
+//			column = array[doe_nmonte] of unit samples in (0,1)
+///////////////////////////////////////////////////////////////////////////////
+static double *doe_column(int dim)
+{
+	int n=doe_nmonte;
+	int k(0);
+	double *column=new double[n];
+	unsigned long long state=((unsigned long long)(unsigned)doe_seed<<32)^(unsigned long long)dim;
+	doe_next(state);
+
+	if(doe_method==DOE_SOBOL&&dim<DOE_SOBOL_DIM)
+	{
+		//direction numbers v[j]=m[j]*2^(32-j-1)
+		unsigned v[DOE_SOBOL_BITS];
+		int s=doe_sobol_s[dim];
+		int a=doe_sobol_a[dim];
+		int j(0);
+		if(!dim)
+			for(j=0;j<DOE_SOBOL_BITS;j++) v[j]=1u<<(DOE_SOBOL_BITS-1-j);
+		else{
+			for(j=0;j<s&&j<DOE_SOBOL_BITS;j++)
+				v[j]=doe_sobol_m[dim][j]<<(DOE_SOBOL_BITS-1-j);
+			for(j=s;j<DOE_SOBOL_BITS;j++){
+				v[j]=v[j-s]^(v[j-s]>>s);
+				for(int i=1;i<s;i++)
+					if((a>>(s-1-i))&1) v[j]^=v[j-i];
+			}
+		}
+		//Gray-code construction with random digital shift
+		unsigned shift=(unsigned)(doe_next(state)>>32);
+		unsigned x=0;
+		for(k=0;k<n;k++){
+			column[k]=((x^shift)+0.5)/4294967296.;
+			int c=0;
+			while((k>>c)&1) c++;
+			x^=v[c];
+		}
+	}
+	else if(doe_method==DOE_ANTITHETIC)
+	{
+		for(k=0;k<n;k++)
+			column[k]=(k%2)?1.-column[k-1]:doe_open(state);
+	}
+	else
+	{
+		//Latin hypercube: random permutation of the strata, random point in each
+		int *perm=new int[n];
+		for(k=0;k<n;k++) perm[k]=k;
+		for(k=n-1;k>0;k--){
+			int j=(int)(doe_next(state)%(unsigned long long)(k+1));
+			int temp=perm[k];perm[k]=perm[j];perm[j]=temp;
+		}
+		for(k=0;k<n;k++)
+			column[k]=(perm[k]+doe_open(state))/n;
+		delete [] perm;
+	}
+	return column;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Selecting the DOE method and sizing the design, called once before run 1
+//
+//parameter input:
+//			method = "RANDOM", "LHS", "SOBOL" or "ANTITHETIC" (empty: "RANDOM")
+//			nmonte = number of MC runs
+//			seed = seed of the design ('iseed' of MONTE)
+///////////////////////////////////////////////////////////////////////////////
+void doe_initialize(const char *method,int nmonte,int seed)
+{
+	if(!strlen(method)||!strcmp(method,"RANDOM")) doe_method=DOE_RANDOM;
+	else if(!strcmp(method,"LHS")) doe_method=DOE_LHS;
+	else if(!strcmp(method,"SOBOL")) doe_method=DOE_SOBOL;
+	else if(!strcmp(method,"ANTITHETIC")) doe_method=DOE_ANTITHETIC;
+	else
+	{cerr<<" *** Error: unknown MONTE sampling '"<<method<<"' (RANDOM, LHS, SOBOL, ANTITHETIC) *** \n";system("pause");exit(1);}
+	if(doe_method==DOE_ANTITHETIC&&nmonte%2)
+	{cerr<<" *** Error: MONTE ANTITHETIC needs an even number of runs, not "<<nmonte<<" *** \n";system("pause");exit(1);}
+
+	for(int i=0;i<doe_ncolumns;i++) delete [] doe_columns[i];
+	delete [] doe_columns;
+	doe_columns=NULL;
+	doe_ncolumns=0;
+	doe_capacity=0;
+	doe_nmonte=nmonte>0?nmonte:1;
+	doe_seed=seed;
+	doe_nmc=0;
+	doe_dim=0;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Starting MC run 'nmc' (0,1,2,...) of the design
+///////////////////////////////////////////////////////////////////////////////
+void doe_run(int nmc)
+{
+	if(doe_method!=DOE_RANDOM&&(nmc<0||nmc>=doe_nmonte))
+	{cerr<<" *** Error: MC run "<<nmc+1<<" outside of the design of "<<doe_nmonte<<" runs *** \n";system("pause");exit(1);}
+	doe_nmc=nmc;
+	doe_dim=0;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Unit sample in (0,1) of the next dimension of the current run
+//Falls back to 'unituni()' if no design is selected
+///////////////////////////////////////////////////////////////////////////////
+double doe_unituni()
+{
+	if(doe_method==DOE_RANDOM) return unituni();
+
+	//generating the columns of the design as the dimensions are first reached
+	if(doe_dim==doe_capacity){
+		doe_capacity=doe_capacity?2*doe_capacity:16;
+		double **columns=new double *[doe_capacity];
+		for(int i=0;i<doe_ncolumns;i++) columns[i]=doe_columns[i];
+		delete [] doe_columns;
+		doe_columns=columns;
+	}
+	while(doe_ncolumns<=doe_dim){
+		doe_columns[doe_ncolumns]=doe_column(doe_ncolumns);
+		doe_ncolumns++;
+	}
+	return doe_columns[doe_dim++][doe_nmc];
+}
+///////////////////////////////////////////////////////////////////////////////
+//Inverse of the standard normal distribution function
+//Ref: P.J. Acklam, rational approximation with one Halley refinement step
+// (relative error < 1e-15)
+///////////////////////////////////////////////////////////////////////////////
+static double doe_inverse_normal(double p)
+{
+	const double a[6]={-3.969683028665376e+01,2.209460984245205e+02,-2.759285104469687e+02,
+		1.383577518672690e+02,-3.066479806614716e+01,2.506628277459239e+00};
+	const double b[5]={-5.447609879822406e+01,1.615858368580409e+02,-1.556989798598866e+02,
+		6.680131188771972e+01,-1.328068155288572e+01};
+	const double c[6]={-7.784894002430293e-03,-3.223964580411365e-01,-2.400758277161838e+00,
+		-2.549732539343734e+00,4.374664141464968e+00,2.938163982698783e+00};
+	const double d[4]={7.784695709041462e-03,3.224671290700398e-01,2.445134137142996e+00,
+		3.754408661907416e+00};
+	const double plow=0.02425;
+	double q,r,x;
+
+	if(p<plow){
+		q=sqrt(-2.*log(p));
+		x=(((((c[0]*q+c[1])*q+c[2])*q+c[3])*q+c[4])*q+c[5])/((((d[0]*q+d[1])*q+d[2])*q+d[3])*q+1.);
+	}
+	else if(p<=1.-plow){
+		q=p-0.5;
+		r=q*q;
+		x=(((((a[0]*r+a[1])*r+a[2])*r+a[3])*r+a[4])*r+a[5])*q/(((((b[0]*r+b[1])*r+b[2])*r+b[3])*r+b[4])*r+1.);
+	}
+	else{
+		q=sqrt(-2.*log(1.-p));
+		x=-(((((c[0]*q+c[1])*q+c[2])*q+c[3])*q+c[4])*q+c[5])/((((d[0]*q+d[1])*q+d[2])*q+d[3])*q+1.);
+	}
+	//refinement
+	double e=0.5*erfc(-x/sqrt(2.))-p;
+	double u=e*2.5066282746310002*exp(x*x/2.);
+	return x-u/(1.+x*u/2.);
+}
+///////////////////////////////////////////////////////////////////////////////
+//DOE counterparts of 'uniform()', 'gauss()', 'rayleigh()' and 'exponential()'
+//Without a design they call those functions, otherwise they transform
+// 'doe_unituni()' by the inverse distribution function
+///////////////////////////////////////////////////////////////////////////////
+double doe_uniform(double min,double max)
+{
+	if(doe_method==DOE_RANDOM) return uniform(min,max);
+	return min+(max-min)*doe_unituni();
+}
+double doe_gauss(double mean,double sig)
+{
+	if(doe_method==DOE_RANDOM) return gauss(mean,sig);
+	return mean+sig*doe_inverse_normal(doe_unituni());
+}
+double doe_rayleigh(double mode)
+{
+	if(doe_method==DOE_RANDOM) return rayleigh(mode);
+	return mode*sqrt(-2.*log(doe_unituni()));
+}
+double doe_exponential(double density)
+{
+	if(doe_method==DOE_RANDOM) return exponential(density);
+	if(!density)
+	{cout<<" *** Error: density not given a non-zero value in 'exponential()' *** \n";system("pause");exit(1);}
+	return -log(doe_unituni())/density;
+}
+///////////////////////////////////////////////////////////////////////////////
 //////////////// Table look-up and interpolation functions ////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -1646,6 +1900,272 @@ double Datadeck::interpolate(int ind10,int ind11,int ind20,int ind21,int ind30,i
 	return dumx2*(y22-y21)+y21;
 }
 ///////////////////////////////////////////////////////////////////////////////
+////////////////////  Combus proximity grid  //////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+//Constructor of 'Grid' for 'capacity' vehicles and cells of edge 'cell' - m
+///////////////////////////////////////////////////////////////////////////////
+Grid::Grid(int capacity,double cell)
+{
+	this->capacity=capacity;
+	this->cell=cell;
+	nlive=0;
+	//at least twice as many buckets as vehicles
+	nbucket=1;
+	while(nbucket<2*capacity) nbucket*=2;
+
+	try{
+		list=new int[capacity];
+		head=new int[nbucket];
+		next=new int[capacity];
+		cellx=new int[3*capacity];
+		pos=new double[3*capacity];
+		kind=new char[capacity];
+		tail=new int[capacity];
+		ids=new int[26*(capacity+1)];
+		work=new int[capacity];
+	}
+	catch(bad_alloc xa){cerr<<"*** Allocation failure of 'Grid' *** \n";system("pause");exit(1);}
+
+	for(int i=0;i<nbucket;i++) head[i]=-1;
+	for(int i=0;i<26*(capacity+1);i++) ids[i]=-1;
+	for(int i=0;i<capacity;i++){
+		next[i]=-1;
+		kind[i]=0;
+		tail[i]=0;
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Destructor of 'Grid'
+///////////////////////////////////////////////////////////////////////////////
+Grid::~Grid()
+{
+	delete [] list;
+	delete [] head;
+	delete [] next;
+	delete [] cellx;
+	delete [] pos;
+	delete [] kind;
+	delete [] tail;
+	delete [] ids;
+	delete [] work;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Hash bucket of cell (cx,cy,cz)
+///////////////////////////////////////////////////////////////////////////////
+int Grid::bucket(int cx,int cy,int cz)
+{
+	unsigned int h=(unsigned int)cx*73856093u^(unsigned int)cy*19349663u^(unsigned int)cz*83492791u;
+	return (int)(h&(unsigned int)(nbucket-1));
+}
+///////////////////////////////////////////////////////////////////////////////
+//Indexing all live vehicles of 'combus'
+//
+//Only vehicles with status=1 are indexed; the 'id' of every slot is decoded
+// so that 'slot()' also finds dead vehicles
+///////////////////////////////////////////////////////////////////////////////
+void Grid::build(Packet *combus,int num_vehicles)
+{
+	int n=num_vehicles<capacity?num_vehicles:capacity;
+
+	//emptying the buckets and the id table of the previous step
+	for(int k=0;k<nlive;k++){
+		int i=list[k];
+		head[bucket(cellx[3*i],cellx[3*i+1],cellx[3*i+2])]=-1;
+	}
+	nlive=0;
+	for(int i=0;i<capacity;i++)
+		if(kind[i]>='a'&&kind[i]<='z'&&tail[i]>=0&&tail[i]<=capacity)
+			ids[(kind[i]-'a')*(capacity+1)+tail[i]]=-1;
+
+	//inserting in descending slot order leaves every bucket in ascending order
+	for(int i=n-1;i>=0;i--)
+	{
+		string id=combus[i].get_id();
+		kind[i]=id.size()?id[0]:0;
+		tail[i]=id.size()>1?atoi(id.c_str()+1):0;
+		next[i]=-1;
+		if(kind[i]>='a'&&kind[i]<='z'&&tail[i]>=0&&tail[i]<=capacity)
+			ids[(kind[i]-'a')*(capacity+1)+tail[i]]=i;
+
+		//position on 'combus': missile 'SBEL' is data[3], rocket and aircraft 'SAEL' is data[4]
+		int loc=-1;
+		if(kind[i]=='m') loc=3;
+		else if(kind[i]=='r'||kind[i]=='a') loc=4;
+		if(loc<0||combus[i].get_status()!=1) continue;
+
+		Variable *data=combus[i].get_data();
+		Matrix SXEL=data[loc].vec();
+		for(int k=0;k<3;k++){
+			pos[3*i+k]=SXEL[k];
+			cellx[3*i+k]=(int)floor(SXEL[k]/cell);
+		}
+		int b=bucket(cellx[3*i],cellx[3*i+1],cellx[3*i+2]);
+		next[i]=head[b];
+		head[b]=i;
+		list[nlive++]=i;
+	}
+	//'list' ascending
+	for(int k=0;k<nlive/2;k++){
+		int dum=list[k];
+		list[k]=list[nlive-1-k];
+		list[nlive-1-k]=dum;
+	}
+	//slots beyond 'num_vehicles' are not on 'combus'
+	for(int i=n;i<capacity;i++) kind[i]=0;
+}
+///////////////////////////////////////////////////////////////////////////////
+//'combus' slot of vehicle 'id'; =-1: not on 'combus'
+///////////////////////////////////////////////////////////////////////////////
+int Grid::slot(string id)
+{
+	if(id.size()<2) return -1;
+	char letter=id[0];
+	int number=atoi(id.c_str()+1);
+	if(letter<'a'||letter>'z'||number<0||number>capacity) return -1;
+	return ids[(letter-'a')*(capacity+1)+number];
+}
+///////////////////////////////////////////////////////////////////////////////
+//Collecting into 'work' the slots of 'kinds' in the cells overlapping
+// the sphere ('center','radius'), ascending
+//
+//Returns false if the sphere spans more cells than there are live vehicles;
+// the caller then tests the 'list' of all live vehicles instead
+///////////////////////////////////////////////////////////////////////////////
+bool Grid::candidates(int &ncand,double *center,double radius,const char *kinds)
+{
+	int lo[3],hi[3];
+	double ncell=1;
+	for(int k=0;k<3;k++){
+		lo[k]=(int)floor((center[k]-radius)/cell);
+		hi[k]=(int)floor((center[k]+radius)/cell);
+		ncell*=hi[k]-lo[k]+1;
+	}
+	ncand=0;
+	if(ncell>nlive) return false;
+
+	for(int cx=lo[0];cx<=hi[0];cx++)
+		for(int cy=lo[1];cy<=hi[1];cy++)
+			for(int cz=lo[2];cz<=hi[2];cz++)
+				for(int i=head[bucket(cx,cy,cz)];i>=0;i=next[i])
+				{
+					//buckets are shared by cells with the same hash
+					if(cellx[3*i]!=cx||cellx[3*i+1]!=cy||cellx[3*i+2]!=cz) continue;
+					if(!strchr(kinds,kind[i])) continue;
+					//insertion keeps 'work' ascending
+					int k=ncand++;
+					while(k>0&&work[k-1]>i){work[k]=work[k-1];k--;}
+					work[k]=i;
+				}
+	return true;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Vehicles within 'radius' of 'CENTER'; returns their number, at most 'max'
+///////////////////////////////////////////////////////////////////////////////
+int Grid::range(int *found,int max,Matrix CENTER,double radius,const char *kinds)
+{
+	double center[3]={CENTER[0],CENTER[1],CENTER[2]};
+	int ncand(0);
+	int *cand=work;
+	if(!candidates(ncand,center,radius,kinds)){
+		cand=list;
+		ncand=nlive;
+	}
+	int nfound(0);
+	for(int k=0;k<ncand&&nfound<max;k++)
+	{
+		int i=cand[k];
+		if(!strchr(kinds,kind[i])) continue;
+		double d1=pos[3*i]-center[0];
+		double d2=pos[3*i+1]-center[1];
+		double d3=pos[3*i+2]-center[2];
+		if(d1*d1+d2*d2+d3*d3<=radius*radius) found[nfound++]=i;
+	}
+	return nfound;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Vehicles within 'radius' of 'APEX' and inside the cone of half angle 'half'
+// about the unit vector 'UAXIS'; returns their number, at most 'max'
+///////////////////////////////////////////////////////////////////////////////
+int Grid::fov(int *found,int max,Matrix APEX,Matrix UAXIS,double half,double radius,const char *kinds)
+{
+	double apex[3]={APEX[0],APEX[1],APEX[2]};
+	double axis[3]={UAXIS[0],UAXIS[1],UAXIS[2]};
+	double cos_half=cos(half);
+	int ncand(0);
+	int *cand=work;
+	if(!candidates(ncand,apex,radius,kinds)){
+		cand=list;
+		ncand=nlive;
+	}
+	int nfound(0);
+	for(int k=0;k<ncand&&nfound<max;k++)
+	{
+		int i=cand[k];
+		if(!strchr(kinds,kind[i])) continue;
+		double d1=pos[3*i]-apex[0];
+		double d2=pos[3*i+1]-apex[1];
+		double d3=pos[3*i+2]-apex[2];
+		double dd=d1*d1+d2*d2+d3*d3;
+		if(dd>radius*radius||dd<SMALL) continue;
+		//inside the cone if the projection on the axis exceeds |d|*cos(half)
+		double proj=d1*axis[0]+d2*axis[1]+d3*axis[2];
+		if(proj>=sqrt(dd)*cos_half) found[nfound++]=i;
+	}
+	return nfound;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Line of sight from 'SAEL' to 'SBEL' above the flat earth and not passing
+// within 'clear' of any vehicle other than 'skip1' and 'skip2'
+//
+//With both end points above ground the straight line is above the flat earth;
+// occluders are searched in the sphere enclosing the line, widened by 'clear'
+///////////////////////////////////////////////////////////////////////////////
+bool Grid::los(Matrix SAEL,Matrix SBEL,double clear,int skip1,int skip2)
+{
+	//down coordinate positive is below ground
+	if(SAEL[2]>0||SBEL[2]>0) return false;
+	if(clear<=0) return true;
+
+	double a[3]={SAEL[0],SAEL[1],SAEL[2]};
+	double d[3]={SBEL[0]-a[0],SBEL[1]-a[1],SBEL[2]-a[2]};
+	double dd=d[0]*d[0]+d[1]*d[1]+d[2]*d[2];
+	double center[3]={a[0]+d[0]/2,a[1]+d[1]/2,a[2]+d[2]/2};
+	double radius=sqrt(dd)/2+clear;
+
+	int ncand(0);
+	int *cand=work;
+	if(!candidates(ncand,center,radius,"mra")){
+		cand=list;
+		ncand=nlive;
+	}
+	for(int k=0;k<ncand;k++)
+	{
+		int i=cand[k];
+		if(i==skip1||i==skip2) continue;
+		//closest point of the line to the vehicle
+		double p[3]={pos[3*i]-a[0],pos[3*i+1]-a[1],pos[3*i+2]-a[2]};
+		double t=dd>SMALL?(p[0]*d[0]+p[1]*d[1]+p[2]*d[2])/dd:0;
+		if(t<0) t=0;
+		if(t>1) t=1;
+		double e1=p[0]-t*d[0];
+		double e2=p[1]-t*d[1];
+		double e3=p[2]-t*d[2];
+		if(e1*e1+e2*e2+e3*e3<clear*clear) return false;
+	}
+	return true;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Position of 'slot' at the start of the step - m
+///////////////////////////////////////////////////////////////////////////////
+Matrix Grid::position(int slot)
+{
+	Matrix SXEL(3,1);
+	SXEL.build_vec3(pos[3*slot],pos[3*slot+1],pos[3*slot+2]);
+	return SXEL;
+}
+///////////////////////////////////////////////////////////////////////////////
 ////////////////////  Integration functions  //////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -15,6 +15,7 @@
 //			markov
 //			rayleigh
 //			exponential
+// Design of experiments (DOE) sampling
 // Table look-up
 // Integration
 // US76 Atmosphere
@@ -391,6 +392,30 @@ double rayleigh(double mode);
 //The variance is density^2
 double exponential(double density);
 
+///////////////////////////////////////////////////////////////////////////////
+//////////////////// Design of experiments (DOE) sampling /////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+//Selecting the DOE method of the static dispersions, called once before run 1
+//parameter input:
+//			method = "RANDOM", "LHS", "SOBOL" or "ANTITHETIC" (empty: "RANDOM")
+//			nmonte = number of MC runs
+//			seed = seed of the design ('iseed' of MONTE)
+void doe_initialize(const char *method,int nmonte,int seed);
+
+//Starting MC run 'nmc' (0,1,2,...) of the design; resets the dimension count
+void doe_run(int nmc);
+
+//Unit sample in (0,1) of the next dimension of the current run
+//Falls back to 'unituni()' if no design is selected
+double doe_unituni();
+
+//DOE counterparts of 'uniform()', 'gauss()', 'rayleigh()' and 'exponential()'
+double doe_uniform(double min,double max);
+double doe_gauss(double mean,double sig);
+double doe_rayleigh(double mode);
+double doe_exponential(double density);
+
 ///////////////////////////////////////////////////////////////////////////////
 ////////////////////  Integration functions  //////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -120,7 +120,7 @@ void Aircraft::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=(second-first)/2.;
 				else
-					value=uniform(first,second);
+					value=doe_uniform(first,second);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NFLAT3;kk++)
@@ -151,7 +151,7 @@ void Aircraft::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=gauss(first,second);
+					value=doe_gauss(first,second);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NFLAT3;kk++)
@@ -181,7 +181,7 @@ void Aircraft::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=rayleigh(first);
+					value=doe_rayleigh(first);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NFLAT3;kk++)
@@ -211,7 +211,7 @@ void Aircraft::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=exponential(first);
+					value=doe_exponential(first);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NFLAT3;kk++)
@@ -305,6 +305,33 @@ void Aircraft::com_index_arrays()
 			l++;
 		}
 	}
+
+	//loading the definitions into 'com_aircraft3' once and compiling its output plan
+	int column(0);
+	ncom_plan=0;
+	for(i=0;i<flat3_com_count;i++)
+	{
+		com_aircraft3[ncom_plan]=flat3[flat3_com_ind[i]];
+		com_plan[ncom_plan]=com_aircraft3[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	for(i=0;i<aircraft_com_count;i++)
+	{
+		com_aircraft3[ncom_plan]=aircraft[aircraft_com_ind[i]];
+		com_plan[ncom_plan]=com_aircraft3[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	dense_rates(com_plan,flat3_com_ind,flat3_com_count);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Recording the 'combus' output plan at the end of the integration step
+// for dense output by 'traj_data()'
+///////////////////////////////////////////////////////////////////////////////
+
+void Aircraft::record_output()
+{
+	for(int i=0;i<ncom_plan;i++)
+		com_plan[i].record();
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Initializing loading 'packet' of aircraft
@@ -331,17 +358,18 @@ Packet Aircraft::loading_packet_init(int num_missile,int num_aircraft,int num_ta
 	for(i=0;i<flat3_com_count;i++)
 	{
 		index=flat3_com_ind[i];
-		com_aircraft3[i]=flat3[index];
+		com_aircraft3[i].restore(flat3[index]);
 	}
 	for(int j=0;j<aircraft_com_count;j++)
 	{
 		index=aircraft_com_ind[j];
-		com_aircraft3[i+j]=aircraft[index];
+		com_aircraft3[i+j].restore(aircraft[index]);
 	}
 	//refreshing the packet
 	packet.set_id(id);
 	packet.set_status(1);
 	packet.set_data(com_aircraft3);
+	packet.set_plan(com_plan);
 	packet.set_ndata(ncom_aircraft3);
 
 	return packet;
@@ -371,12 +399,12 @@ Packet Aircraft::loading_packet(int num_missile,int num_aircraft,int num_target)
 	for(i=0;i<flat3_com_count;i++)
 	{
 		index=flat3_com_ind[i];
-		com_aircraft3[i]=flat3[index];
+		com_aircraft3[i].restore(flat3[index]);
 	}
 	for(int j=0;j<aircraft_com_count;j++)
 	{
 		index=aircraft_com_ind[j];
-		com_aircraft3[i+j]=aircraft[index];
+		com_aircraft3[i+j].restore(aircraft[index]);
 	}
 	//refreshing the packet
 	packet.set_data(com_aircraft3);
@@ -92,7 +92,8 @@ public:
 	virtual void scrn_data()=0;
 	virtual void plot_banner(ofstream &fplot,char *title)=0;
 	virtual void plot_index_arrays()=0;
-	virtual void plot_data(ofstream &fplot,bool merge)=0;
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step)=0;
+	virtual void record_output()=0;
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot)=0;
 	virtual void event(char *options)=0;
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle)=0;
@@ -187,7 +188,8 @@ public:
 	virtual void scrn_data()=0;
 	virtual void plot_banner(ofstream &fplot,char *title)=0;
 	virtual void plot_index_arrays()=0;
-	virtual void plot_data(ofstream &fplot,bool merge)=0;
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step)=0;
+	virtual void record_output()=0;
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot)=0;
 	virtual void event(char *options)=0;
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle)=0;
@@ -234,6 +236,9 @@ public:
 	virtual void newton(double int_step);
 	virtual void def_euler();
 	virtual void euler(double int_step);
+
+	//attaching the state derivatives of 'newton' to an output plan
+	void dense_rates(Output *plan,int *flat6_ind,int flat6_count);
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -284,6 +289,11 @@ protected:
 	//be written to 'combus' 'packets'
 	int *missile_com_ind; int missile_com_count;
 
+	//output plans compiled by the index arrays and executed by the writers
+	Output *scrn_plan; int nscrn_plan;
+	Output *plot_plan; int nplot_plan;
+	Output *com_plan; int ncom_plan;
+
 	//array of ground distances of 'Missile' object from all 'Target' objects
 	double *grnd_range;
 
@@ -314,7 +324,8 @@ public:
 	virtual void scrn_data();
 	virtual void plot_banner(ofstream &fplot,char *title);
 	virtual void plot_index_arrays();
-	virtual void plot_data(ofstream &fplot,bool merge);
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step);
+	virtual void record_output();
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot);
 	virtual void event(char *options);
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle);
@@ -410,7 +421,8 @@ public:
 	virtual void scrn_data()=0;
 	virtual void plot_banner(ofstream &fplot,char *title)=0;
 	virtual void plot_index_arrays()=0;
-	virtual void plot_data(ofstream &fplot,bool merge)=0;
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step)=0;
+	virtual void record_output()=0;
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot)=0;
 	virtual void event(char *options)=0;
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle)=0;
@@ -458,6 +470,9 @@ public:
 	virtual void def_newton();
 	virtual void init_newton();
 	virtual void newton(double int_step);
+
+	//attaching the state derivatives of 'newton' to an output plan
+	void dense_rates(Output *plan,int *flat3_ind,int flat3_count);
 };
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -487,6 +502,9 @@ protected:
 	//be written to 'combus' 'packets'
 	int *target_com_ind; int target_com_count;
 
+	//output plan of 'com' compiled by 'com_index_arrays()', executed by 'traj_data()'
+	Output *com_plan; int ncom_plan;
+
 	//array of module-variables that carry Markov process random values
 	Markov markov_list[NMARKOV]; int nmarkov;
 
@@ -513,7 +531,8 @@ public:
 	virtual void scrn_data(){};
 	virtual void plot_banner(ofstream &fplot,char *title){};
 	virtual void plot_index_arrays(){};
-	virtual void plot_data(ofstream &fplot,bool merge){};
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step){};
+	virtual void record_output();
 	virtual void event(char *options){};
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot){};
 
@@ -580,6 +599,9 @@ protected:
 	//be written to 'combus' 'packets'
 	int *aircraft_com_ind; int aircraft_com_count;
 
+	//output plan of 'com' compiled by 'com_index_arrays()', executed by 'traj_data()'
+	Output *com_plan; int ncom_plan;
+
 public:
 	Aircraft(){};
 	Aircraft(Module *module_list,int num_modules);
@@ -596,7 +618,8 @@ public:
 	virtual void scrn_data(){};
 	virtual void plot_banner(ofstream &fplot,char *title){};
 	virtual void plot_index_arrays(){};
-	virtual void plot_data(ofstream &fplot,bool merge){};
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step){};
+	virtual void record_output();
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot){};
 	virtual void event(char *options){};
 	virtual void markov_noise(double sim_time,double int_step,int nmonte){};
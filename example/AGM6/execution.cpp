@@ -24,7 +24,7 @@ using namespace std;
 
 //acquiring the simmulation title
 void acquire_title_options(fstream &input,char *title,char *options,int &nmonte,
-						   int &iseed,int &nmc);
+						   int &iseed,char *sampling,int &nmc);
 
 //acquiring the simulation run time
 double acquire_endtime(fstream &input);
@@ -72,7 +72,7 @@ void traj_banner(ofstream &ftraj,Packet *combus,char *title,int num_vehicles,
 				 int nmissile,int ntarget,int naircraft);
 
 //writing 'traj.asc' file of 'combus' data
-void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge);
+void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge,double frac,double step);
 
 //Documenting 'input.asc' with module-variable definitions
 void document_input(Document *doc_missile6,Document *doc_target3,Document *doc_aircraft3);
@@ -116,6 +116,7 @@ int main()
 	int nmonte=0; //number of MC runs to be executed
 	int nmc=0; //MC counter
 	int iseed; //seeding srand()
+	char sampling[CHARN]="RANDOM"; //DOE method of the static dispersions
 	bool one_traj_banner=true; //write just one banner on file 'traj.asc'
 	bool *stati_write_term = NULL; //flag for writing impact data on 'stati.asc' once
 	Document *doc_missile6 = NULL;  //array for documenting MISSILE6 module-variables of 'input.asc'
@@ -165,10 +166,14 @@ int main()
 		bool traj_merge=false; //flag used in writing 'time=-1' endblock on 'traj.asc'
 		
 		//aqcuiring title statement and option selections
-		acquire_title_options(input,title,options,nmonte,iseed,nmc);
+		acquire_title_options(input,title,options,nmonte,iseed,sampling,nmc);
 
-		//initializing random number generator
-		if(!nmc) srand(iseed); 
+		//initializing random number generator and design of experiments
+		if(!nmc){
+			srand(iseed);
+			doe_initialize(sampling,nmonte,iseed);
+		}
+		doe_run(nmc);
 
 		//acquiring number of module 
 		number_modules(input,num_modules);
@@ -403,7 +408,7 @@ int main()
 			traj_banner(ftraj,combus,title,num_vehicles,num_missile,num_target,num_aircraft);
 
 			//writing data after 'initial module' calculations
-			traj_data(ftraj,combus,num_vehicles,traj_merge);
+			traj_data(ftraj,combus,num_vehicles,traj_merge,1,0);
 		}
 
 		//acuire ending time (last entry on 'input.asc')
@@ -542,9 +547,10 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 	double com_time(0);
 	int vehicle_slot(0);
 	bool increment_scrn_time(false);
-	bool increment_plot_time(false);
 	bool plot_merge(false);
 	double out_fact(0);
+	double sim_time_last(sim_time-int_step);
+	bool *holding=new bool[num_vehicles];
 
 	//integration loop
 	while (sim_time<=(end_time+int_step))
@@ -552,7 +558,8 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 		//vehicle loop
 		for (int i=0;i<num_vehicles;i++)
 		{
-			if(sim_time<launch_delay_list[i]);
+			holding[i]=sim_time<launch_delay_list[i];
+			if(holding[i]);
 				//vehicle is holding at initial point
 			else{
 				//vehicle is progressing
@@ -640,16 +647,6 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 					if(increment_scrn_time) scrn_time+=scrn_step*(1+out_fact);
 				}
 
-				//output to 'ploti.asc' file
-				if(fabs(plot_time-sim_time)<(int_step/2+EPS))
-				{
-					if(strstr(options,"y_plot"))
-					{
-						vehicle_list[i]->plot_data(plot_ostream_list[i],plot_merge);
-						if(i==(num_vehicles-1))increment_plot_time=true;
-					}
-					if(increment_plot_time) plot_time+=plot_step*(1+out_fact);
-				}
 				//output to 'stati.asc' file 
 				if(strstr(options,"y_stat"))
 				{
@@ -664,6 +661,26 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			}
 		} //end of vehicle loop
 
+		//dense output: plot and traj times passed during the last step are sampled
+		//exactly, interpolating between 'sim_time_last' and 'sim_time'
+		double step=sim_time-sim_time_last;
+		double snap=int_step/100;
+
+		//output to 'ploti.asc' files of the progressing vehicles
+		if(strstr(options,"y_plot"))
+		{
+			while(plot_time>sim_time_last&&plot_time<sim_time+snap)
+			{
+				double frac(1);
+				if(fabs(plot_time-sim_time)>=snap) frac=(plot_time-sim_time_last)/step;
+				for(int i=0;i<num_vehicles;i++)
+					if(!holding[i])
+						vehicle_list[i]->plot_data(plot_ostream_list[i],plot_merge,frac,step);
+				if(plot_step*(1+out_fact)<=0) break;
+				plot_time+=plot_step*(1+out_fact);
+			}
+		}
+
 		//outputting 'combus' to screen 
 		if(fabs(com_time-sim_time)<(int_step/2+EPS))
 		{
@@ -674,17 +691,27 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			com_time+=com_step*(1+out_fact);
 		}
 		//outputting'combus' to 'traj.asc' file
-		if(fabs(traj_time-sim_time)<(int_step/2+EPS))
+		if(strstr(options,"y_traj"))
 		{
-			if(strstr(options,"y_traj"))
+			while(traj_time>sim_time_last&&traj_time<sim_time+snap)
 			{
-				traj_data(ftraj,combus,num_vehicles,traj_merge);
+				double frac(1);
+				if(fabs(traj_time-sim_time)>=snap) frac=(traj_time-sim_time_last)/step;
+				traj_data(ftraj,combus,num_vehicles,traj_merge,frac,step);
+				if(traj_step*(1+out_fact)<=0) break;
+				traj_time+=traj_step*(1+out_fact);
 			}
-			traj_time+=traj_step*(1+out_fact);
 		}
+		//recording the output plans at the end of the step for dense output
+		if(strstr(options,"y_plot")||strstr(options,"y_traj"))
+		{
+			for(int i=0;i<num_vehicles;i++)
+				vehicle_list[i]->record_output();
+		}
+		sim_time_last=sim_time;
+
 		//resetting output events
 		increment_scrn_time=false;
-		increment_plot_time=false;
 
 		//advancing time
 		sim_time+=int_step;
@@ -697,15 +724,16 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 	{
 		plot_merge=true;
 		for (int i=0;i<num_vehicles;i++)
-			vehicle_list[i]->plot_data(plot_ostream_list[i],plot_merge);
+			vehicle_list[i]->plot_data(plot_ostream_list[i],plot_merge,1,0);
 	}
 	//writing last integration out to 'traj.asc' 
 	//with time set to '-1' for multiple CADAC-Studio plots
 	if(strstr(options,"y_traj"))
 	{
 		traj_merge=true;
-		traj_data(ftraj,combus,num_vehicles,traj_merge);
+		traj_data(ftraj,combus,num_vehicles,traj_merge,1,0);
 	}
+	delete [] holding;
 } 
 
 
@@ -406,7 +406,7 @@ void Missile::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=(second-first)/2.;
 				else
-					value=uniform(first,second);
+					value=doe_uniform(first,second);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NFLAT6;kk++)
@@ -437,7 +437,7 @@ void Missile::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=gauss(first,second);
+					value=doe_gauss(first,second);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NFLAT6;kk++)
@@ -467,7 +467,7 @@ void Missile::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=rayleigh(first);
+					value=doe_rayleigh(first);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NFLAT6;kk++)
@@ -497,7 +497,7 @@ void Missile::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=exponential(first);
+					value=doe_exponential(first);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NFLAT6;kk++)
@@ -690,6 +690,14 @@ void Missile::scrn_index_arrays()
 			l++;
 		}
 	}
+
+	//compiling the output plan
+	int column(0);
+	nscrn_plan=0;
+	for(i=0;i<flat6_scrn_count;i++)
+		scrn_plan[nscrn_plan++]=flat6[flat6_scrn_ind[i]].output(column);
+	for(i=0;i<missile_scrn_count;i++)
+		scrn_plan[nscrn_plan++]=missile[missile_scrn_ind[i]].output(column);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Writing data to screen
@@ -705,85 +713,36 @@ void Missile::scrn_index_arrays()
 void Missile::scrn_data()
 {
 
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k(0);
 	int i(0);
 	
 	cout<<missile6_name<<'\n';
 	cout.setf(ios::left);
 
-	//writing to screen the variables from the 'Flat6' class
-	for(i=0;i<flat6_scrn_count;i++)
+	//writing to screen the variables of the output plan
+	for(i=0;i<nscrn_plan;i++)
 	{
-		index=flat6_scrn_ind[i];
-		//checking for integers
-		integer=flat6[index].get_type();
-		vector=flat6[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=scrn_plan[i];
+		if(out.kind==1)
 		{
 			cout.width(15);
-			cout<<flat6[index].integer();			
+			cout<<*out.integer;
 			k++; if(k>7){k=0;cout<<'\n';}
 		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		else if(out.kind==2)
 		{
-			VEC=flat6[index].vec();
-
-			cout.width(15);
-			cout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-		}
-		else
-		{
-			//real variables
-			cout.width(15);
-			cout<<flat6[index].real();
-			k++; if(k>7){k=0;cout<<'\n';}
-		}
-	}
-	//writing to screen the variables from the 'Missile' class
-	for(i=0;i<missile_scrn_count;i++)
-	{
-		index=missile_scrn_ind[i];
-		//checking for integers
-		integer=missile[index].get_type();
-		vector=missile[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			cout.width(15);
-			cout<<missile[index].integer();			
-			k++; if(k>7){k=0;cout<<'\n';}
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=missile[index].vec();
-			cout.width(15);
-			cout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;cout<<'\n';}
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
+			{
+				cout.width(15);
+				cout<<vec[m];
+				k++; if(k>7){k=0;cout<<'\n';}
+			}
 		}
 		else
 		{
-			//real variables
 			cout.width(15);
-			cout<<missile[index].real();
+			cout<<*out.real;
 			k++; if(k>7){k=0;cout<<'\n';}
 		}
 	}
@@ -803,85 +762,36 @@ void Missile::scrn_data()
 void Missile::tabout_data(ofstream &ftabout)
 {
 
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k(0);
 	int i(0);
 	
 	ftabout<<missile6_name<<'\n';
 	ftabout.setf(ios::left);
 
-	//writing to 'tabout.asc' the variables from the 'Flat6' class
-	for(i=0;i<flat6_scrn_count;i++)
-	{
-		index=flat6_scrn_ind[i];
-		//checking for integers
-		integer=flat6[index].get_type();
-		vector=flat6[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			ftabout.width(15);
-			ftabout<<flat6[index].integer();			
-			k++; if(k>7){k=0;ftabout<<'\n';}
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=flat6[index].vec();
-
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-		}
-		else
-		{
-			//real variables
-			ftabout.width(15);
-			ftabout<<flat6[index].real(); 
-			k++; if(k>7){k=0;ftabout<<'\n';}
-		}
-	}
-	//writing to 'tabout.asc' the variables from the 'Missile' class
-	for(i=0;i<missile_scrn_count;i++)
+	//writing to 'tabout.asc' the variables of the output plan
+	for(i=0;i<nscrn_plan;i++)
 	{
-		index=missile_scrn_ind[i];
-		//checking for integers
-		integer=missile[index].get_type();
-		vector=missile[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=scrn_plan[i];
+		if(out.kind==1)
 		{
 			ftabout.width(15);
-			ftabout<<missile[index].integer();			
+			ftabout<<*out.integer;
 			k++; if(k>7){k=0;ftabout<<'\n';}
-
 		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		else if(out.kind==2)
 		{
-			VEC=missile[index].vec();
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
+			{
+				ftabout.width(15);
+				ftabout<<vec[m];
+				k++; if(k>7){k=0;ftabout<<'\n';}
+			}
 		}
 		else
 		{
-			//real variables
 			ftabout.width(15);
-			ftabout<<missile[index].real();
+			ftabout<<*out.real;
 			k++; if(k>7){k=0;ftabout<<'\n';}
 		}
 	}
@@ -986,6 +896,15 @@ void Missile::plot_index_arrays()
 			l++;
 		}
 	}
+
+	//compiling the output plan
+	int column(0);
+	nplot_plan=0;
+	for(i=0;i<flat6_plot_count;i++)
+		plot_plan[nplot_plan++]=flat6[flat6_plot_ind[i]].output(column);
+	for(i=0;i<missile_plot_count;i++)
+		plot_plan[nplot_plan++]=missile[missile_plot_ind[i]].output(column);
+	dense_rates(plot_plan,flat6_plot_ind,flat6_plot_count);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Writing data to 'ploti.asc', i=1,2,3...
@@ -994,118 +913,79 @@ void Missile::plot_index_arrays()
 //five accross, unlimited down
 //data field 16 spaces, total width 80 spaces
 //
+//Parameter input:
+//	frac = fraction of the last integration step 'step' at which the data are
+//		sampled; frac=1 writes the current values
+//
 //010116 Created by Peter H Zipfel
 //011129 Adapted to MISSILE6 simulation, PZi
 ///////////////////////////////////////////////////////////////////////////////
-void Missile::plot_data(ofstream &fplot,bool merge)
+void Missile::plot_data(ofstream &fplot,bool merge,double frac,double step)
 {
 
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k(0);
 	int i(0);
 	
 	fplot.setf(ios::left);
 
-	//writing to 'ploti.asc' the variables from the 'Flat6' class
-	for(i=0;i<flat6_plot_count;i++)
+	//writing to 'ploti.asc' the variables of the output plan
+	for(i=0;i<nplot_plan;i++)
 	{
-		index=flat6_plot_ind[i];
-		//checking for integers
-		integer=flat6[index].get_type();
-		vector=flat6[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=plot_plan[i];
+		if(out.kind==1)
 		{
 			//casting integer to real variable
 			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<(double) flat6[index].integer();			
-			k++;
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=flat6[index].vec();
-
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++; 
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
+			if(frac<1) fplot<<out.sample(0,frac,step);
+			else fplot<<(double) *out.integer;
 			k++;
 		}
-		else
+		else if(out.kind==2)
 		{
-			//real variables
-			if(merge&&(index==0))
-				//for merging files, time at last entry must be '-1'
-			{
-				fplot.width(16);
-				fplot<<"-1.0";
-				k++;
-			}
-			else
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
 			{
 				if(k>4){k=0;fplot<<'\n';}
 				fplot.width(16);
-				fplot<<flat6[index].real(); 
+				if(frac<1) fplot<<out.sample(m,frac,step);
+				else fplot<<vec[m];
 				k++;
 			}
 		}
-	}
-	//writing to 'ploti.asc' the variables from the 'Missile' class
-	for(i=0;i<missile_plot_count;i++)
-	{
-		index=missile_plot_ind[i];
-		//checking for integers
-		integer=missile[index].get_type();
-		vector=missile[index].get_name();
-		if(!strcmp(integer,"int"))
+		else if(merge&&!out.column)
+		//for merging files, time at last entry must be '-1'
 		{
-			//casting integer to real variable
-			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<(double) missile[index].integer();			
-			k++;
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=missile[index].vec();
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
+			fplot<<"-1.0";
 			k++;
 		}
 		else
 		{
-			//real variables
 			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<missile[index].real();
+			if(frac<1) fplot<<out.sample(0,frac,step);
+			else fplot<<*out.real;
 			k++;
 		}
 	}
 	fplot<<"\n";
 }
 ///////////////////////////////////////////////////////////////////////////////
+//Recording the plot and 'combus' output plans at the end of the integration
+// step for dense output by 'plot_data()' and 'traj_data()'
+///////////////////////////////////////////////////////////////////////////////
+
+void Missile::record_output()
+{
+	int i(0);
+
+	for(i=0;i<nplot_plan;i++)
+		plot_plan[i].record();
+	for(i=0;i<ncom_plan;i++)
+		com_plan[i].record();
+}
+///////////////////////////////////////////////////////////////////////////////
 //Watching for and executing events
 // 
 //Max number of events set by global constant NEVENT
@@ -1398,6 +1278,23 @@ void Missile::com_index_arrays()
 			l++;
 		}
 	}
+
+	//loading the definitions into 'com_missile6' once and compiling its output plan
+	int column(0);
+	ncom_plan=0;
+	for(i=0;i<flat6_com_count;i++)
+	{
+		com_missile6[ncom_plan]=flat6[flat6_com_ind[i]];
+		com_plan[ncom_plan]=com_missile6[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	for(i=0;i<missile_com_count;i++)
+	{
+		com_missile6[ncom_plan]=missile[missile_com_ind[i]];
+		com_plan[ncom_plan]=com_missile6[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	dense_rates(com_plan,flat6_com_ind,flat6_com_count);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Initializing loading 'packet' with 'MISSILE6' data
@@ -1427,17 +1324,18 @@ Packet Missile::loading_packet_init(int num_missile,int num_aircraft,int num_tar
 	for(i=0;i<flat6_com_count;i++)
 	{
 		index=flat6_com_ind[i];
-		com_missile6[i]=flat6[index]; 
+		com_missile6[i].restore(flat6[index]); 
 	}
 	for(int j=0;j<missile_com_count;j++)
 	{
 		index=missile_com_ind[j];
-		com_missile6[i+j]=missile[index];
+		com_missile6[i+j].restore(missile[index]);
 	}
 	//refreshing the packet
 	packet.set_id(id);
 	packet.set_status(1);
 	packet.set_data(com_missile6);
+	packet.set_plan(com_plan);
 	packet.set_ndata(ncom_missile6);
 
 	return packet;
@@ -1468,12 +1366,12 @@ Packet Missile::loading_packet(int num_missile,int num_aircraft,int num_target)
 	for(i=0;i<flat6_com_count;i++)
 	{
 		index=flat6_com_ind[i];
-		com_missile6[i]=flat6[index];
+		com_missile6[i].restore(flat6[index]);
 	}
 	for(int j=0;j<missile_com_count;j++)
 	{
 		index=missile_com_ind[j];
-		com_missile6[i+j]=missile[index];
+		com_missile6[i+j].restore(missile[index]);
 	}
 	//refreshing the packet
 //	packet.set_id(id);
@@ -1541,95 +1439,39 @@ void Missile::markov_noise(double time,double int_step,int nmonte)
 ///////////////////////////////////////////////////////////////////////////////
 void Missile::stat_data(ofstream &fstat,int nmc,int vehicle_slot)
 {
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k(0);
 	int i(0);
 	
 	fstat.setf(ios::left);
 
-	//writing to 'stati.asc' the variables from the 'Flat6' class
-	for(i=0;i<flat6_plot_count;i++)
+	//writing to 'stati.asc' the variables of the output plan
+	for(i=0;i<nplot_plan;i++)
 	{
-		index=flat6_plot_ind[i];
-		//checking for integers
-		integer=flat6[index].get_type();
-		vector=flat6[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=plot_plan[i];
+		if(out.kind==1)
 		{
 			//casting integer to real variable
 			if(k>4){k=0;fstat<<'\n';}
 			fstat.width(16);
-			fstat<<(double) flat6[index].integer();			
+			fstat<<(double) *out.integer;
 			k++;
 		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		else if(out.kind==2)
 		{
-			VEC=flat6[index].vec();
-
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(0,0);
-			k++; 
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(2,0);
-			k++;
-		}
-		else
-		{
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<flat6[index].real(); 
-			k++;
-		}
-	}
-	//writing to 'stati.asc' the variables from the 'Missile' class
-	for(i=0;i<missile_plot_count;i++)
-	{
-		index=missile_plot_ind[i];
-		//checking for integers
-		integer=missile[index].get_type();
-		vector=missile[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<(double) missile[index].integer();			
-			k++;
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=missile[index].vec();
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(0,0);
-			k++;
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(2,0);
-			k++;
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
+			{
+				if(k>4){k=0;fstat<<'\n';}
+				fstat.width(16);
+				fstat<<vec[m];
+				k++;
+			}
 		}
 		else
 		{
-			//real variables
 			if(k>4){k=0;fstat<<'\n';}
 			fstat.width(16);
-			fstat<<missile[index].real();
+			fstat<<*out.real;
 			k++;
 		}
 	}
@@ -1712,7 +1554,7 @@ void Missile::read_tables(char *file_name,Datadeck &datatable)
 		//extracting table dimension
 		//at this point 'temp' is holding xDIM
 		int dim_check(0);
-		char dim_buff[2];
+		char dim_buff[2]={0};
 		int table_dim(0);
 		strncpy(dim_buff,temp,1);
 		//converting character to integer
@@ -168,7 +168,7 @@ void Target::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=(second-first)/2.;
 				else
-					value=uniform(first,second);
+					value=doe_uniform(first,second);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NFLAT3;kk++)
@@ -199,7 +199,7 @@ void Target::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=gauss(first,second);
+					value=doe_gauss(first,second);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NFLAT3;kk++)
@@ -229,7 +229,7 @@ void Target::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=rayleigh(first);
+					value=doe_rayleigh(first);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NFLAT3;kk++)
@@ -259,7 +259,7 @@ void Target::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=exponential(first);
+					value=doe_exponential(first);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NFLAT3;kk++)
@@ -362,6 +362,33 @@ void Target::com_index_arrays()
 			l++;
 		}
 	}
+
+	//loading the definitions into 'com_target3' once and compiling its output plan
+	int column(0);
+	ncom_plan=0;
+	for(i=0;i<flat3_com_count;i++)
+	{
+		com_target3[ncom_plan]=flat3[flat3_com_ind[i]];
+		com_plan[ncom_plan]=com_target3[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	for(i=0;i<target_com_count;i++)
+	{
+		com_target3[ncom_plan]=target[target_com_ind[i]];
+		com_plan[ncom_plan]=com_target3[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	dense_rates(com_plan,flat3_com_ind,flat3_com_count);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Recording the 'combus' output plan at the end of the integration step
+// for dense output by 'traj_data()'
+///////////////////////////////////////////////////////////////////////////////
+
+void Target::record_output()
+{
+	for(int i=0;i<ncom_plan;i++)
+		com_plan[i].record();
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Initializing loading 'packet' of target
@@ -388,17 +415,18 @@ Packet Target::loading_packet_init(int num_missile,int num_aircraft,int num_targ
 	for(i=0;i<flat3_com_count;i++)
 	{
 		index=flat3_com_ind[i];
-		com_target3[i]=flat3[index];
+		com_target3[i].restore(flat3[index]);
 	}
 	for(int j=0;j<target_com_count;j++)
 	{
 		index=target_com_ind[j];
-		com_target3[i+j]=target[index];
+		com_target3[i+j].restore(target[index]);
 	}
 	//refreshing the packet
 	packet.set_id(id);
 	packet.set_status(1);
 	packet.set_data(com_target3);
+	packet.set_plan(com_plan);
 	packet.set_ndata(ncom_target3);
 
 	return packet;
@@ -428,12 +456,12 @@ Packet Target::loading_packet(int num_missile,int num_aircraft,int num_target)
 	for(i=0;i<flat3_com_count;i++)
 	{
 		index=flat3_com_ind[i];
-		com_target3[i]=flat3[index];
+		com_target3[i].restore(flat3[index]);
 	}
 	for(int j=0;j<target_com_count;j++)
 	{
 		index=target_com_ind[j];
-		com_target3[i+j]=target[index];
+		com_target3[i+j].restore(target[index]);
 	}
 	//refreshing the packet
 	packet.set_data(com_target3);
@@ -617,7 +645,7 @@ void Target::read_tables(char *file_name,Datadeck &datatable)
 		//extracting table dimension
 		//at this point 'temp' is holding xDIM
 		int dim_check(0);
-		char dim_buff[2];
+		char dim_buff[2]={0};
 		int table_dim(0);
 		strncpy(dim_buff,temp,1);
 		//converting character to integer
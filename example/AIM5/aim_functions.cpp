@@ -512,6 +512,14 @@ void Aim::scrn_index_arrays()
 			l++;
 		}
 	}
+
+	//compiling the output plan
+	int column(0);
+	nscrn_plan=0;
+	for(i=0;i<flat3_scrn_count;i++)
+		scrn_plan[nscrn_plan++]=flat3[flat3_scrn_ind[i]].output(column);
+	for(i=0;i<aim_scrn_count;i++)
+		scrn_plan[nscrn_plan++]=aim[aim_scrn_ind[i]].output(column);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Writing data to screen
@@ -527,85 +535,36 @@ void Aim::scrn_index_arrays()
 void Aim::scrn_data()
 {
 
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k(0);
 	int i(0);
 	
 	cout<<aim5_name<<'\n';
 	cout.setf(ios::left);
 
-	//writing to screen the variables from the 'Flat3' class
-	for(i=0;i<flat3_scrn_count;i++)
+	//writing to screen the variables of the output plan
+	for(i=0;i<nscrn_plan;i++)
 	{
-		index=flat3_scrn_ind[i];
-		//checking for integers
-		integer=flat3[index].get_type();
-		vector=flat3[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=scrn_plan[i];
+		if(out.kind==1)
 		{
 			cout.width(15);
-			cout<<flat3[index].integer();			
+			cout<<*out.integer;
 			k++; if(k>7){k=0;cout<<'\n';}
 		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		else if(out.kind==2)
 		{
-			VEC=flat3[index].vec();
-
-			cout.width(15);
-			cout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-		}
-		else
-		{
-			//real variables
-			cout.width(15);
-			cout<<flat3[index].real();
-			k++; if(k>7){k=0;cout<<'\n';}
-		}
-	}
-	//writing to screen the variables from the 'Aim' class
-	for(i=0;i<aim_scrn_count;i++)
-	{
-		index=aim_scrn_ind[i];
-		//checking for integers
-		integer=aim[index].get_type();
-		vector=aim[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			cout.width(15);
-			cout<<aim[index].integer();			
-			k++; if(k>7){k=0;cout<<'\n';}
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=aim[index].vec();
-			cout.width(15);
-			cout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;cout<<'\n';}
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
+			{
+				cout.width(15);
+				cout<<vec[m];
+				k++; if(k>7){k=0;cout<<'\n';}
+			}
 		}
 		else
 		{
-			//real variables
 			cout.width(15);
-			cout<<aim[index].real();
+			cout<<*out.real;
 			k++; if(k>7){k=0;cout<<'\n';}
 		}
 	}
@@ -625,85 +584,36 @@ void Aim::scrn_data()
 void Aim::tabout_data(ofstream &ftabout)
 {
 
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k(0);
 	int i(0);
 	
 	ftabout<<aim5_name<<'\n';
 	ftabout.setf(ios::left);
 
-	//writing to 'tabout.asc' the variables from the 'Flat3' class
-	for(i=0;i<flat3_scrn_count;i++)
-	{
-		index=flat3_scrn_ind[i];
-		//checking for integers
-		integer=flat3[index].get_type();
-		vector=flat3[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			ftabout.width(15);
-			ftabout<<flat3[index].integer();			
-			k++; if(k>7){k=0;ftabout<<'\n';}
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=flat3[index].vec();
-
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-		}
-		else
-		{
-			//real variables
-			ftabout.width(15);
-			ftabout<<flat3[index].real(); 
-			k++; if(k>7){k=0;ftabout<<'\n';}
-		}
-	}
-	//writing to 'tabout.asc' the variables from the 'Aim' class
-	for(i=0;i<aim_scrn_count;i++)
+	//writing to 'tabout.asc' the variables of the output plan
+	for(i=0;i<nscrn_plan;i++)
 	{
-		index=aim_scrn_ind[i];
-		//checking for integers
-		integer=aim[index].get_type();
-		vector=aim[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=scrn_plan[i];
+		if(out.kind==1)
 		{
 			ftabout.width(15);
-			ftabout<<aim[index].integer();			
+			ftabout<<*out.integer;
 			k++; if(k>7){k=0;ftabout<<'\n';}
-
 		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		else if(out.kind==2)
 		{
-			VEC=aim[index].vec();
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
+			{
+				ftabout.width(15);
+				ftabout<<vec[m];
+				k++; if(k>7){k=0;ftabout<<'\n';}
+			}
 		}
 		else
 		{
-			//real variables
 			ftabout.width(15);
-			ftabout<<aim[index].real();
+			ftabout<<*out.real;
 			k++; if(k>7){k=0;ftabout<<'\n';}
 		}
 	}
@@ -808,6 +718,14 @@ void Aim::plot_index_arrays()
 			l++;
 		}
 	}
+
+	//compiling the output plan
+	int column(0);
+	nplot_plan=0;
+	for(i=0;i<flat3_plot_count;i++)
+		plot_plan[nplot_plan++]=flat3[flat3_plot_ind[i]].output(column);
+	for(i=0;i<aim_plot_count;i++)
+		plot_plan[nplot_plan++]=aim[aim_plot_ind[i]].output(column);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Writing data to 'ploti.asc', i=1,2,3...
@@ -822,106 +740,46 @@ void Aim::plot_index_arrays()
 void Aim::plot_data(ofstream &fplot,bool merge)
 {
 
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k(0);
 	int i(0);
 	
 	fplot.setf(ios::left);
 
-	//writing to 'ploti.asc' the variables from the 'Flat3' class
-	for(i=0;i<flat3_plot_count;i++)
+	//writing to 'ploti.asc' the variables of the output plan
+	for(i=0;i<nplot_plan;i++)
 	{
-		index=flat3_plot_ind[i];
-		//checking for integers
-		integer=flat3[index].get_type();
-		vector=flat3[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=plot_plan[i];
+		if(out.kind==1)
 		{
 			//casting integer to real variable
 			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<(double) flat3[index].integer();			
+			fplot<<(double) *out.integer;
 			k++;
 		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		else if(out.kind==2)
 		{
-			VEC=flat3[index].vec();
-
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++; 
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
-			k++;
-		}
-		else
-		{
-			//real variables
-			if(merge&&(index==0))
-				//for merging files, time at last entry must be '-1'
-			{
-				fplot.width(16);
-				fplot<<"-1.0";
-				k++;
-			}
-			else
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
 			{
 				if(k>4){k=0;fplot<<'\n';}
 				fplot.width(16);
-				fplot<<flat3[index].real(); 
+				fplot<<vec[m];
 				k++;
 			}
 		}
-	}
-	//writing to 'ploti.asc' the variables from the 'Aim' class
-	for(i=0;i<aim_plot_count;i++)
-	{
-		index=aim_plot_ind[i];
-		//checking for integers
-		integer=aim[index].get_type();
-		vector=aim[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<(double) aim[index].integer();			
-			k++;
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		else if(merge&&!out.column)
+		//for merging files, time at last entry must be '-1'
 		{
-			VEC=aim[index].vec();
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
+			fplot<<"-1.0";
 			k++;
 		}
 		else
 		{
-			//real variables
 			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<aim[index].real();
+			fplot<<*out.real;
 			k++;
 		}
 	}
@@ -1220,6 +1078,22 @@ void Aim::com_index_arrays()
 			l++;
 		}
 	}
+
+	//loading the definitions into 'com_aim5' once and compiling its output plan
+	int column(0);
+	ncom_plan=0;
+	for(i=0;i<flat3_com_count;i++)
+	{
+		com_aim5[ncom_plan]=flat3[flat3_com_ind[i]];
+		com_plan[ncom_plan]=com_aim5[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	for(i=0;i<aim_com_count;i++)
+	{
+		com_aim5[ncom_plan]=aim[aim_com_ind[i]];
+		com_plan[ncom_plan]=com_aim5[ncom_plan].output(column);
+		ncom_plan++;
+	}
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Initializing loading 'packet' with 'AIM5' data
@@ -1249,17 +1123,18 @@ Packet Aim::loading_packet_init(int num_aim,int num_aircraft)
 	for(i=0;i<flat3_com_count;i++)
 	{
 		index=flat3_com_ind[i];
-		com_aim5[i]=flat3[index]; 
+		com_aim5[i].restore(flat3[index]); 
 	}
 	for(int j=0;j<aim_com_count;j++)
 	{
 		index=aim_com_ind[j];
-		com_aim5[i+j]=aim[index];
+		com_aim5[i+j].restore(aim[index]);
 	}
 	//refreshing the packet
 	packet.set_id(id);
 	packet.set_status(1);
 	packet.set_data(com_aim5);
+	packet.set_plan(com_plan);
 	packet.set_ndata(ncom_aim5);
 
 	return packet;
@@ -1281,12 +1156,12 @@ Packet Aim::loading_packet(int num_aim,int num_aircraft)
 	for(i=0;i<flat3_com_count;i++)
 	{
 		index=flat3_com_ind[i];
-		com_aim5[i]=flat3[index];
+		com_aim5[i].restore(flat3[index]);
 	}
 	for(int j=0;j<aim_com_count;j++)
 	{
 		index=aim_com_ind[j];
-		com_aim5[i+j]=aim[index];
+		com_aim5[i+j].restore(aim[index]);
 	}
 	//refreshing the packet
 	packet.set_data(com_aim5);
@@ -1368,7 +1243,7 @@ void Aim::read_tables(char *file_name,Datadeck &datatable)
 		//extracting table dimension
 		//at this point 'temp' is holding xDIM
 		int dim_check(0);
-		char dim_buff[2];
+		char dim_buff[2]={0};
 		int table_dim(0);
 		strncpy(dim_buff,temp,1);
 		//converting character to integer
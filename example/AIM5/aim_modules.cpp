@@ -718,6 +718,11 @@ void Aim::def_intercept()
 	//Definition of module-variables
 	aim[161].init("aspazx",0,"Aspect azimuth of incoming missile - deg","intercept","diag","");
 	aim[162].init("aspelx",0,"Aspect elevation of incoming missile - deg","intercept","diag","");
+	aim[163].init("miss",0,"Miss distance - m","intercept","diag","");
+	aim[164].init("hit_time",0,"Intercept time - s","intercept","diag","");
+	aim[165].init("time_m",0,"Previous time - s","intercept","save","");
+	aim[166].init("STALM",0,0,0,"Previous displacement of aircraft wrt missile - m","intercept","save","");
+	aim[167].init("VTALM",0,0,0,"Previous velocity of aircraft wrt missile - m/s","intercept","save","");
 }
 ///////////////////////////////////////////////////////////////////////////////
 //'intercept' module 
@@ -736,10 +741,13 @@ void Aim::intercept(Packet *combus,int vehicle_slot,double int_step,char *title)
 {
 	//local module-variables
 	Matrix TTL(3,3);//T.M. of aircraft wrt local level coordinates
+	Matrix MISS_L(3,1);
 
 	//localizing module-variables
 	double aspazx(0);
 	double aspelx(0);
+	double miss(0);
+	double hit_time(0);
 
 	//input data
 	//input from other modules
@@ -752,14 +760,32 @@ void Aim::intercept(Packet *combus,int vehicle_slot,double int_step,char *title)
 	double dta=aim[80].real();
 	double dvta=aim[81].real();
 	Matrix STAL=aim[89].vec();
+	//restore saved values
+	double time_m=aim[165].real();
+	Matrix STALM=aim[166].vec();
+	Matrix VTALM=aim[167].vec();
 	//-------------------------------------------------------------------------
+	//aircraft T velocity relative to incoming missile A
+	Matrix VTAEL=VTEL-VAEL;
+
 	// displaying miss distance only if missile is inside sphere of aircraft
 	if(dta<500){
 		// point of closest approach
 		if(dvta>0){
+			//miss distance and intercept time from the cubic relative trajectory
+			//between the previous and the current integration step;
+			//without a previous step, the miss at the current step
+			if(time_m>0){
+				double tau=closest_approach(MISS_L,STALM,VTALM,STAL,VTAEL,time-time_m);
+				hit_time=time_m+tau;
+			}
+			else{
+				MISS_L=STAL;
+				hit_time=time;
+			}
+			miss=MISS_L.absolute();
+
 			//calculating aspect angles of incoming missile
-			//aircraft T velocity relative to incoming missile A
-			Matrix VTAEL=VTEL-VAEL;
 			//differential speed of missile wrt aircraft
 			double diff_speed=VTAEL.absolute();
 			//T.M. of aircraft wrt local level coordinates
@@ -778,13 +804,28 @@ void Aim::intercept(Packet *combus,int vehicle_slot,double int_step,char *title)
 
 			//missile intercepted aircraft
 			cout<<"\n"<<" $$$ Intercept of Missile_"<<id_aim<<" with Aircraft_"<<id_acft
-				<<"   at sim_time = "<<time<<" sec $$$\n";
-			cout<<"      miss distance = "<<dta<<" m     differential speed = "<<diff_speed<<" m/s \n";
+				<<"   at sim_time = "<<hit_time<<" sec $$$\n";
+			cout<<"      miss distance = "<<miss<<" m     differential speed = "<<diff_speed<<" m/s \n";
 			cout<<"      incoming missile azimuth = "<<aspazx<<" deg          elevation = "<<aspelx<<" deg \n\n";
 
 			//missile and aircraft are set to be 'dead'
 			combus[vehicle_slot].set_status(0);
 			combus[acft_com_slot].set_status(0);
 		}
-	}	
+	}
+	//save from previous cycle
+	STALM=STAL;
+	VTALM=VTAEL;
+	time_m=time;
+	//-------------------------------------------------------------------------
+	//loading module-variables
+	//saving values
+	aim[165].gets(time_m);
+	aim[166].gets_vec(STALM);
+	aim[167].gets_vec(VTALM);
+	//diagnostics
+	aim[161].gets(aspazx);
+	aim[162].gets(aspelx);
+	aim[163].gets(miss);
+	aim[164].gets(hit_time);
 }
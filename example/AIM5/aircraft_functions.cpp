@@ -178,6 +178,22 @@ void Aircraft::com_index_arrays()
 			l++;
 		}
 	}
+
+	//loading the definitions into 'com_aircraft3' once and compiling its output plan
+	int column(0);
+	ncom_plan=0;
+	for(i=0;i<flat3_com_count;i++)
+	{
+		com_aircraft3[ncom_plan]=flat3[flat3_com_ind[i]];
+		com_plan[ncom_plan]=com_aircraft3[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	for(i=0;i<aircraft_com_count;i++)
+	{
+		com_aircraft3[ncom_plan]=aircraft[aircraft_com_ind[i]];
+		com_plan[ncom_plan]=com_aircraft3[ncom_plan].output(column);
+		ncom_plan++;
+	}
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Initializing loading 'packet' of aircraft
@@ -204,17 +220,18 @@ Packet Aircraft::loading_packet_init(int num_aircraft,int num_aim)
 	for(i=0;i<flat3_com_count;i++)
 	{
 		index=flat3_com_ind[i];
-		com_aircraft3[i]=flat3[index];
+		com_aircraft3[i].restore(flat3[index]);
 	}
 	for(int j=0;j<aircraft_com_count;j++)
 	{
 		index=aircraft_com_ind[j];
-		com_aircraft3[i+j]=aircraft[index];
+		com_aircraft3[i+j].restore(aircraft[index]);
 	}
 	//refreshing the packet
 	packet.set_id(id);
 	packet.set_status(1);
 	packet.set_data(com_aircraft3);
+	packet.set_plan(com_plan);
 	packet.set_ndata(ncom_aircraft3);
 
 	return packet;
@@ -235,12 +252,12 @@ Packet Aircraft::loading_packet(int num_aircraft,int num_aim)
 	for(i=0;i<flat3_com_count;i++)
 	{
 		index=flat3_com_ind[i];
-		com_aircraft3[i]=flat3[index];
+		com_aircraft3[i].restore(flat3[index]);
 	}
 	for(int j=0;j<aircraft_com_count;j++)
 	{
 		index=aircraft_com_ind[j];
-		com_aircraft3[i+j]=aircraft[index];
+		com_aircraft3[i+j].restore(aircraft[index]);
 	}
 	//refreshing the packet
 	packet.set_data(com_aircraft3);
@@ -106,6 +106,11 @@ Aim::Aim(Module *module_list,int num_modules)
 	flat3_com_ind=new int[flat3_com_count];
 	aim_com_ind=new int[aim_com_count];
 
+	//allocating memory for the output plans
+	scrn_plan=new Output[flat3_scrn_count+aim_scrn_count];
+	plot_plan=new Output[flat3_plot_count+aim_plot_count];
+	com_plan=new Output[flat3_com_count+aim_com_count];
+
 
 	//allocating memory to each event object in event object list
 	for (int i=0;i<NEVENT;i++)
@@ -153,6 +158,9 @@ Aim::~Aim()
 	delete [] aim_plot_ind;
 	delete [] flat3_com_ind;
 	delete [] aim_com_ind;
+	delete [] scrn_plan;
+	delete [] plot_plan;
+	delete [] com_plan;
 	delete [] &event_ptr_list;
 }
 ///////////////////////////////////////////////////////////////////////////////
@@ -195,6 +203,9 @@ Aircraft::Aircraft(Module *module_list,int num_modules)
 	if(!flat3_com_ind){cerr<<"*** Error: flat3_com_count[] allocation failed *** \n";system("pause");exit(1);}
 	aircraft_com_ind=new int[aircraft_com_count];
 	if(!aircraft_com_ind){cerr<<"*** Error: aircraft_com_count[] allocation failed *** \n";system("pause");exit(1);}
+
+	//allocating memory for the output plan
+	com_plan=new Output[flat3_com_count+aircraft_com_count];
 	com_aircraft3=new Variable[ncom_aircraft3];
 	if(!com_aircraft3){cerr<<"*** Error: com_aircraft[] allocation failed *** \n";system("pause");exit(1);}
 
@@ -213,6 +224,7 @@ Aircraft::~Aircraft()
 	delete [] flat3;
 	delete [] flat3_com_ind;
 	delete [] aircraft_com_ind;
+	delete [] com_plan;
 	delete [] com_aircraft3;
 }
 ///////////////////////////////////////////////////////////////////////////////
@@ -244,6 +244,11 @@ protected:
 	//be written to 'combus' 'packets'
 	int *aim_com_ind; int aim_com_count;
 
+	//output plans compiled by the index arrays and executed by the writers
+	Output *scrn_plan; int nscrn_plan;
+	Output *plot_plan; int nplot_plan;
+	Output *com_plan; int ncom_plan;
+
 	//declaring Table pointer as temporary storage of a single table
 	Table *table;
 	//declaring Datadeck 'aerotable' that stores all aero tables
@@ -319,6 +324,9 @@ protected:
 	//be written to 'combus' 'packets'
 	int *aircraft_com_ind; int aircraft_com_count;
 
+	//output plan of 'com' compiled by 'com_index_arrays()', executed by 'traj_data()'
+	Output *com_plan; int ncom_plan;
+
 public:
 	Aircraft(){};
 	Aircraft(Module *module_list,int num_modules);
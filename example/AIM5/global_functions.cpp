@@ -598,11 +598,8 @@ void traj_banner(ofstream &ftraj,Packet *combus,char *title,int num_vehicles,
 void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
 {
 
-	char *integer;
-	char *name;
-	Matrix VEC(3,1);
 	int k(0);
-	Variable *data;
+	Output *plan=NULL;
 	int ndata(0);
 	string id;
 	int aim_object(0);
@@ -638,48 +635,37 @@ void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
 
 		//'Aim' object
 		{
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//writing communication variables to 'traj.asc'
 			for(int j=1;j<ndata;j++)
 			{
-				integer=data[j].get_type();
-				name=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<(double) data[j].integer();			
+					ftraj<<(double) *out.integer;
 					k++;
 				}
-				//checking for vectors
-				else if(isupper(name[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(0,0);
-					k++; 
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(1,0);
-					k++;
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>4){k=0;ftraj<<'\n';}
+						ftraj.width(16);
+						ftraj<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<data[j].real(); 
+					ftraj<<*out.real;
 					k++;
 				}
 			}
@@ -688,48 +674,37 @@ void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
 
 		//'Aircraft' object
 		{
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//writing communication variables to 'traj.asc'
 			for(int j=1;j<ndata;j++)
 			{
-				integer=data[j].get_type();
-				name=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<(double) data[j].integer();			
+					ftraj<<(double) *out.integer;
 					k++;
 				}
-				//checking for vectors
-				else if(isupper(name[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(0,0);
-					k++; 
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(1,0);
-					k++;
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>4){k=0;ftraj<<'\n';}
+						ftraj.width(16);
+						ftraj<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<data[j].real(); 
+					ftraj<<*out.real;
 					k++;
 				}
 			}
@@ -767,10 +742,7 @@ void comscrn_data(Packet *combus,int num_vehicles)
 	Variable *data_aim; //Variable array stored in 'Packet data' of type Aim
 	Variable *data_aircraft; //Variable array stored in 'Packet data' of type aircraft
 	int ndata;
-	Variable *data;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
+	Output *plan=NULL;
 	int i(0);
 	int k(0);
 
@@ -855,8 +827,8 @@ void comscrn_data(Packet *combus,int num_vehicles)
 		//'Aim' object
 		{
 			q++;
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//write out label of i-th object
 			cout<<"\n *** m_";cout.width(8);cout<<q;
@@ -865,42 +837,31 @@ void comscrn_data(Packet *combus,int num_vehicles)
 			//writing communication variables to screen
 			for(int j=1;j<ndata;j++)
 			{
-				integer=data[j].get_type();
-				vector=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<(double) data[j].integer();			
+					cout<<(double) *out.integer;
 					k++;
 				}
-				//checking vor vectors
-				else if(isupper(vector[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(0,0);
-					k++; 
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(1,0);
-					k++;
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>7){k=0;cout<<'\n';}
+						cout.width(15);
+						cout<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<data[j].real(); 
+					cout<<*out.real;
 					k++;
 				}
 			}
@@ -947,8 +908,8 @@ void comscrn_data(Packet *combus,int num_vehicles)
 		//'aircraft' object
 		{
 			r++;
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//write out label of i-th object
 			cout<<"\n *** a_";cout.width(8);cout<<r;
@@ -957,42 +918,31 @@ void comscrn_data(Packet *combus,int num_vehicles)
 			//writing communication variables to screen
 			for(int j=1;j<ndata;j++)
 			{
-				integer=data[j].get_type();
-				vector=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<(double) data[j].integer();			
+					cout<<(double) *out.integer;
 					k++;
 				}
-				//checking vor vectors
-				else if(isupper(vector[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(0,0);
-					k++; 
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(1,0);
-					k++;
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>7){k=0;cout<<'\n';}
+						cout.width(15);
+						cout<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<data[j].real(); 
+					cout<<*out.real;
 					k++;
 				}
 			}
@@ -38,6 +38,24 @@ struct Module
 	string termination;
 };
 
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Output'
+//
+//Entry of the output plans compiled by the index arrays, so that the writers
+// need no type or name inspection and no 'Matrix' copies during the run
+//
+//kind: =0 real, =1 integer, =2 3x1 vector
+//column: first output column of the entry; 'time' is at column 0
+///////////////////////////////////////////////////////////////////////////////
+struct Output
+{
+	double *real;
+	int *integer;
+	Matrix *vec;
+	int kind;
+	int column;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 //Class 'Variable'
 //Establishing module-variables as type Variable
@@ -99,6 +117,41 @@ void init(char *na,
 	//001213 Created by Peter H Zipfel
 	///////////////////////////////////////////////////////////////////////////
 	char *get_name(){return name;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Copying the values of module-variable 'var', keeping the definition
+	//Refreshes the 'com' packets without reallocating 'VEC' and 'MAT'
+	///////////////////////////////////////////////////////////////////////////
+	void restore(Variable &var)
+	{
+		rval=var.rval;
+		ival=var.ival;
+		double *pvec=VEC.get_pbody();
+		double *pvec0=var.VEC.get_pbody();
+		for(int i=0;i<3;i++) pvec[i]=pvec0[i];
+		double *pmat=MAT.get_pbody();
+		double *pmat0=var.MAT.get_pbody();
+		for(int i=0;i<9;i++) pmat[i]=pmat0[i];
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Compiling the output plan entry of the module-variable at 'column'
+	//Integers are typed 'int', vectors are named in upper case, all else is real
+	//Advances 'column' by the number of values the entry writes
+	///////////////////////////////////////////////////////////////////////////
+	Output output(int &column)
+	{
+		Output entry;
+		entry.real=&rval;
+		entry.integer=&ival;
+		entry.vec=&VEC;
+		if(!strcmp(type,"int")) entry.kind=1;
+		else if(isupper(name[0])) entry.kind=2;
+		else entry.kind=0;
+		entry.column=column;
+		column+=(entry.kind==2)?3:1;
+		return entry;
+	}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 'type' from module-variable array 
@@ -410,6 +463,7 @@ private:
 	int status;			//alive=1, dead=0 . hit=-1 (targets are only stopped), 
 	int ndata;			//number of module-variables in data array
 	Variable *data;		//array of module-variables identified by "com" 
+	Output *plan;		//output plan of 'data', compiled by 'com_index_arrays()'
 public:
 	Packet(){};
 	~Packet(){};
@@ -441,6 +495,11 @@ public:
 	///////////////////////////////////////////////////////////////////////////
 	void set_data(Variable *vehicle_d){data=vehicle_d;}
 
+	///////////////////////////////////////////////////////////////////////////
+	//Setting the output plan of packet 'data'
+	///////////////////////////////////////////////////////////////////////////
+	void set_plan(Output *vehicle_plan){plan=vehicle_plan;}
+
 	///////////////////////////////////////////////////////////////////////////
 	//Setting packet 'data'
 	//
@@ -475,6 +534,11 @@ public:
 	//010207 Created by Peter H Zipfel
 	///////////////////////////////////////////////////////////////////////////
 	Variable *get_data(){return data;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Obtaining the output plan of 'data' from packet
+	///////////////////////////////////////////////////////////////////////////
+	Output *get_plan(){return plan;}
 };
 
 ///////////////////////////////////////////////////////////////////////////////
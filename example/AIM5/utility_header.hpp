@@ -317,6 +317,12 @@ int sign(const double &variable);
 //Returns the angle between two 3x1 vectors
 double angle(Matrix VEC1,Matrix VEC2);
 
+//Returns the time of closest approach within an integration step and the
+// relative position MISS at that time (cubic Hermite relative trajectory)
+//Example: tau=closest_approach(MISS,SBTLM,VBTLM,SBTL,VBTL,time-time_m);
+double closest_approach(Matrix &MISS,Matrix SREL0,Matrix VREL0,Matrix SREL1,Matrix VREL1
+						,const double &step);
+
 
 ///////////////////////////////////////////////////////////////////////////////
 ////////////////////  Integration functions  //////////////////////////////////
@@ -422,6 +422,12 @@ void Ball::scrn_index_arrays()
 			l++;
 		}
 	}
+
+	//compiling the output plan
+	int column(0);
+	nscrn_plan=0;
+	for(i=0;i<ball_scrn_count;i++)
+		scrn_plan[nscrn_plan++]=ball[ball_scrn_ind[i]].output(column);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Writing data to screen
@@ -438,48 +444,35 @@ void Ball::scrn_index_arrays()
 void Ball::scrn_data()
 {
 
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k(0),i(0);
 	
 	cout<<ball3_name<<'\n';
 	cout.setf(ios::left);
 
-	//writing to screen the variables from the 'Ball' class
-	for(i=0;i<ball_scrn_count;i++)
+	//writing to screen the variables of the output plan
+	for(i=0;i<nscrn_plan;i++)
 	{
-		index=ball_scrn_ind[i];
-		//checking for integers
-		integer=ball[index].get_type();
-		vector=ball[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=scrn_plan[i];
+		if(out.kind==1)
 		{
 			cout.width(15);
-			cout<<ball[index].integer();			
+			cout<<*out.integer;
 			k++; if(k>7){k=0;cout<<'\n';}
-
 		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		else if(out.kind==2)
 		{
-			VEC=ball[index].vec();
-			cout.width(15);
-			cout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;cout<<'\n';}
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
+			{
+				cout.width(15);
+				cout<<vec[m];
+				k++; if(k>7){k=0;cout<<'\n';}
+			}
 		}
 		else
 		{
-			//real variables
 			cout.width(15);
-			cout<<ball[index].real();
+			cout<<*out.real;
 			k++; if(k>7){k=0;cout<<'\n';}
 		}
 	}
@@ -500,48 +493,35 @@ void Ball::scrn_data()
 void Ball::tabout_data(ofstream &ftabout)
 {
 
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k(0),i(0);
 	
 	ftabout<<ball3_name<<'\n';
 	ftabout.setf(ios::left);
 
-	//writing to 'tabout.asc' the variables from the 'Ball' class
-	for(i=0;i<ball_scrn_count;i++)
+	//writing to 'tabout.asc' the variables of the output plan
+	for(i=0;i<nscrn_plan;i++)
 	{
-		index=ball_scrn_ind[i];
-		//checking for integers
-		integer=ball[index].get_type();
-		vector=ball[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=scrn_plan[i];
+		if(out.kind==1)
 		{
 			ftabout.width(15);
-			ftabout<<ball[index].integer();			
+			ftabout<<*out.integer;
 			k++; if(k>7){k=0;ftabout<<'\n';}
-
 		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		else if(out.kind==2)
 		{
-			VEC=ball[index].vec();
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
+			{
+				ftabout.width(15);
+				ftabout<<vec[m];
+				k++; if(k>7){k=0;ftabout<<'\n';}
+			}
 		}
 		else
 		{
-			//real variables
 			ftabout.width(15);
-			ftabout<<ball[index].real();
+			ftabout<<*out.real;
 			k++; if(k>7){k=0;ftabout<<'\n';}
 		}
 	}
@@ -638,6 +618,12 @@ void Ball::plot_index_arrays()
 			l++;
 		}
 	}
+
+	//compiling the output plan
+	int column(0);
+	nplot_plan=0;
+	for(i=0;i<ball_plot_count;i++)
+		plot_plan[nplot_plan++]=ball[ball_plot_ind[i]].output(column);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Writing data to 'ploti.asc', i=1,2,3...
@@ -653,53 +639,38 @@ void Ball::plot_index_arrays()
 void Ball::plot_data(ofstream &fplot,bool merge)
 {
 
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k(0),i(0);
 	
 	fplot.setf(ios::left);
 
-	//writing to 'ploti.asc' the variables from the 'Ball' class
-	for(i=0;i<ball_plot_count;i++)
+	//writing to 'ploti.asc' the variables of the output plan
+	for(i=0;i<nplot_plan;i++)
 	{
-		index=ball_plot_ind[i];
-		//checking for integers
-		integer=ball[index].get_type();
-		vector=ball[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=plot_plan[i];
+		if(out.kind==1)
 		{
 			//casting integer to real variable
 			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<(double) ball[index].integer();			
+			fplot<<(double) *out.integer;
 			k++;
-
 		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		else if(out.kind==2)
 		{
-			VEC=ball[index].vec();
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
-			k++;
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
+			{
+				if(k>4){k=0;fplot<<'\n';}
+				fplot.width(16);
+				fplot<<vec[m];
+				k++;
+			}
 		}
 		else
 		{
-			//real variables
 			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<ball[index].real();
+			fplot<<*out.real;
 			k++;
 		}
 	}
@@ -926,6 +897,16 @@ void Ball::com_index_arrays()
 			l++;
 		}
 	}
+
+	//loading the definitions into 'com_ball3' once and compiling its output plan
+	int column(0);
+	ncom_plan=0;
+	for(i=0;i<ball_com_count;i++)
+	{
+		com_ball3[ncom_plan]=ball[ball_com_ind[i]];
+		com_plan[ncom_plan]=com_ball3[ncom_plan].output(column);
+		ncom_plan++;
+	}
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Initializing loading 'packet' with 'BALL' data
@@ -956,12 +937,13 @@ Packet Ball::loading_packet_init(int num_ball)
 	for(j=0;j<ball_com_count;j++)
 	{
 		index=ball_com_ind[j];
-		com_ball3[i+j]=ball[index];
+		com_ball3[i+j].restore(ball[index]);
 	}
 	//refreshing the packet
 	packet.set_id(id);
 	packet.set_status(1);
 	packet.set_data(com_ball3);
+	packet.set_plan(com_plan);
 	packet.set_ndata(ncom_ball3);
 
 	return packet;
@@ -993,7 +975,7 @@ Packet Ball::loading_packet(int num_ball)
 	for(j=0;j<ball_com_count;j++)
 	{
 		index=ball_com_ind[j];
-		com_ball3[i+j]=ball[index];
+		com_ball3[i+j].restore(ball[index]);
 	}
 	//refreshing the packet
 //	packet.set_id(id);
@@ -1074,7 +1056,7 @@ void Ball::read_tables(char *file_name,Datadeck &datatable)
 		//extracting table dimension
 		//at this point 'temp' is holding xDIM
 		int dim_check(0);
-		char dim_buff[2];
+		char dim_buff[2]={0};
 		int table_dim(0);
 		strncpy(dim_buff,temp,1);
 		//converting character to integer
@@ -90,6 +90,11 @@ Ball::Ball(Module *module_list,int num_modules)
 	// allocating memory for the com index arrays
 	ball_com_ind=new int[ball_com_count];
 
+	//allocating memory for the output plans
+	scrn_plan=new Output[ball_scrn_count];
+	plot_plan=new Output[ball_plot_count];
+	com_plan=new Output[ball_com_count];
+
 	//allocating memory to each event object in event object list
 	for (i=0;i<NEVENT;i++)
 		event_ptr_list[i]=new Event;
@@ -133,6 +138,9 @@ Ball::~Ball()
 	delete [] ball_scrn_ind;
 	delete [] ball_plot_ind;
 	delete [] ball_com_ind;
+	delete [] scrn_plan;
+	delete [] plot_plan;
+	delete [] com_plan;
 	delete [] &event_ptr_list;
 }
 
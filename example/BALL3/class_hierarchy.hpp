@@ -120,6 +120,11 @@ protected:
 	//indicator array pointing to the module-variable which are to be written to 'combus'
 	int *ball_com_ind; int ball_com_count;
 
+	//output plans compiled by the index arrays and executed by the writers
+	Output *scrn_plan; int nscrn_plan;
+	Output *plot_plan; int nplot_plan;
+	Output *com_plan; int ncom_plan;
+
 	//declaring Table pointer as temporary storage of a single table
 	Table *table;
 	//declaring Datadeck 'aerotable' that stores all aero tables
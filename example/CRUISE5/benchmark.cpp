@@ -0,0 +1,160 @@
+///////////////////////////////////////////////////////////////////////////////
+//FILE: 'benchmark.cpp'
+//Stand-alone check and timing of the satellite visibility service 'Visibility'
+//Built and run by 'make bench-visibility' (not part of the simulation executable)
+//
+//300 satellites 's1...' on circular orbits between 7000 and 42000 km radius
+// and 1000 ground targets 't1...' fixed on the rotating earth are put on
+// 'combus' and propagated over 100 one-second steps. Every step the
+// satellite-target line-of-sight table is built
+//	- by the all-pairs 'angle()' test of the legacy 'targeting_satellite()' and
+//	- by 'Visibility::update()' with its cached rows.
+//Both tables must be identical.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "class_hierarchy.hpp"
+#include <chrono>
+#include <iomanip>
+
+///////////////////////////////////////////////////////////////////////////////
+//Seconds elapsed since 'start', which is reset to now
+///////////////////////////////////////////////////////////////////////////////
+static double lap(std::chrono::steady_clock::time_point &start)
+{
+	std::chrono::steady_clock::time_point now=std::chrono::steady_clock::now();
+	double dt=std::chrono::duration<double>(now-start).count();
+	start=now;
+	return dt;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Uniform random number in [0,1]
+///////////////////////////////////////////////////////////////////////////////
+static double uniform()
+{
+	return (double)rand()/RAND_MAX;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Inertial position 'SXII' and geographic speed 'dvbe' on a circular orbit of
+// radius 'dxi', ascending node 'node' and inclination 'incl' at angle 'phase'
+// from the node, rotating at 'rate' rad/s
+///////////////////////////////////////////////////////////////////////////////
+static void circle(Matrix &SXII,double &dvbe,double node,double incl,double dxi,double phase,double rate)
+{
+	Matrix UP(3,1),UQ(3,1);
+	UP.build_vec3(cos(node),sin(node),0);
+	UQ.build_vec3(-cos(incl)*sin(node),cos(incl)*cos(node),sin(incl));
+	SXII=(UP*cos(phase)+UQ*sin(phase))*dxi;
+	Matrix VXII=(UQ*cos(phase)-UP*sin(phase))*(dxi*rate);
+	//geographic velocity: inertial velocity less the earth's rotation
+	Matrix WEII(3,1);
+	WEII.build_vec3(0,0,WEII3);
+	dvbe=(VXII-WEII.skew_sym()*SXII).absolute();
+}
+///////////////////////////////////////////////////////////////////////////////
+//Main function of the benchmark
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	const int nsat=300;
+	const int ntgt=1000;
+	const int nvehicle=nsat+ntgt;
+	const int nstep=100;
+	const double step=1;
+	const double gm=3.986004418e14;
+	const double radius=REARTH;
+	int i(0),k(0),j(0);
+
+	//vehicles on 'combus': 'dvbe' is data[5], 'SBII' is data[10]
+	Packet *combus=new Packet[nvehicle];
+	Variable *data=new Variable[11*nvehicle];
+	double *node=new double[nvehicle];
+	double *incl=new double[nvehicle];
+	double *dxi=new double[nvehicle];	//orbit radius of satellites, latitude of targets
+	double *phase=new double[nvehicle];
+	double *rate=new double[nvehicle];
+	char number[CHARN];
+	srand(1);
+	for(i=0;i<nvehicle;i++){
+		string id;
+		if(i<nsat) {sprintf(number,"%d",i+1);id="s"+string(number);}
+		else {sprintf(number,"%d",i-nsat+1);id="t"+string(number);}
+		combus[i].set_id(id);
+		combus[i].set_status(1);
+		combus[i].set_ndata(11);
+		combus[i].set_data(data+11*i);
+		if(i<nsat){
+			//orbit plane of random inclination and node
+			node[i]=2*PI*uniform();
+			incl[i]=PI*uniform();
+			dxi[i]=7000e3+35000e3*uniform();
+			rate[i]=sqrt(gm/(dxi[i]*dxi[i]*dxi[i]));
+		}
+		else{
+			//target at rest on the earth, uniform over the sphere; 'dxi' is the latitude
+			dxi[i]=asin(2*uniform()-1);
+			rate[i]=WEII3;
+		}
+		phase[i]=2*PI*uniform();
+	}
+	Visibility service;
+	int *clear=new int[nsat*ntgt];
+	double time_legacy(0),time_service(0);
+	long nclear(0),nmismatch(0);
+
+	for(int n=0;n<nstep;n++)
+	{
+		double time=n*step;
+		for(i=0;i<nvehicle;i++){
+			Matrix SXII(3,1);
+			double dvbe(0);
+			if(i<nsat)
+				circle(SXII,dvbe,node[i],incl[i],dxi[i],phase[i]+rate[i]*time,rate[i]);
+			else{
+				double psi=phase[i]+rate[i]*time;
+				SXII.build_vec3(REARTH*cos(dxi[i])*cos(psi),REARTH*cos(dxi[i])*sin(psi),REARTH*sin(dxi[i]));
+			}
+			data[11*i+5].gets(dvbe);
+			data[11*i+10].gets_vec(SXII);
+		}
+		std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+
+		//legacy: grazing angle against the 'angle()' of every pair
+		for(k=0;k<nsat;k++){
+			Matrix SSII=combus[k].get_data()[10].vec();
+			double grazing_angle=acos(radius/SSII.absolute());
+			for(j=0;j<ntgt;j++){
+				Matrix STII=combus[nsat+j].get_data()[10].vec();
+				clear[k*ntgt+j]=angle(SSII,STII)<grazing_angle;
+			}
+		}
+		time_legacy+=lap(start);
+
+		//service
+		service.update(combus,nvehicle,radius,time);
+		time_service+=lap(start);
+
+		for(k=0;k<nsat;k++)
+			for(j=0;j<ntgt;j++){
+				nclear+=clear[k*ntgt+j];
+				if(clear[k*ntgt+j]!=service.get_clear(k,j)) nmismatch++;
+			}
+	}
+	cout<<"\n *** Satellite visibility benchmark: "<<nsat<<" satellites, "<<ntgt
+		<<" targets, "<<nstep<<" steps of "<<step<<" s ***\n";
+	cout<<fixed<<setprecision(3);
+	cout<<"  clear pairs per step          "<<(double)nclear/nstep<<'\n';
+	cout<<"  rows recomputed per step      "<<(double)service.get_nrefresh()/nstep<<'\n';
+	cout<<"  legacy angle() all pairs      "<<setw(10)<<time_legacy/nstep*1e3<<" ms per step\n";
+	cout<<"  'Visibility' service          "<<setw(10)<<time_service/nstep*1e3<<" ms per step\n";
+	cout<<" *** "<<nmismatch<<" mismatches between legacy and service ***\n";
+
+	delete [] combus;
+	delete [] data;
+	delete [] node;
+	delete [] incl;
+	delete [] dxi;
+	delete [] phase;
+	delete [] rate;
+	delete [] clear;
+	return nmismatch?1:0;
+}
@@ -90,7 +90,8 @@ public:
 	virtual void scrn_data()=0;
 	virtual void plot_banner(ofstream &fplot,char *title)=0;
 	virtual void plot_index_arrays()=0;
-	virtual void plot_data(ofstream &fplot,bool merge)=0;
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step)=0;
+	virtual void record_output()=0;
 	virtual void event(char *options)=0;
 	virtual void document(ostream &fdoc,char *title,Document *doc_cruise3)=0;
 	virtual void com_index_arrays()=0;
@@ -167,7 +168,8 @@ public:
 	virtual void scrn_data()=0;
 	virtual void plot_banner(ofstream &fplot,char *title)=0;
 	virtual void plot_index_arrays()=0;
-	virtual void plot_data(ofstream &fplot,bool merge)=0;
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step)=0;
+	virtual void record_output()=0;
 	virtual void event(char *options)=0;
 	virtual void document(ostream &fdoc,char *title,Document *doc_cruise3)=0;
 	virtual void com_index_arrays()=0;
@@ -201,6 +203,9 @@ public:
 	virtual void def_newton();
 	virtual void init_newton();
 	virtual void newton(double int_step);
+
+	//attaching the state derivatives of 'newton' to an output plan
+	void dense_rates(Output *plan,int *round3_ind,int round3_count);
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -253,6 +258,11 @@ protected:
 	// be written to 'combus' 'packets'
 	int *cruise_com_ind; int cruise_com_count;
 
+	//output plans compiled by the index arrays and executed by the writers
+	Output *scrn_plan; int nscrn_plan;
+	Output *plot_plan; int nplot_plan;
+	Output *com_plan; int ncom_plan;
+
 	//array of ground distances of 'Missile' object from all 'Target' objects
 	double *grnd_range;
 
@@ -260,6 +270,9 @@ protected:
 	// and first target to assure that satellite can provide targeting data to missile 
 	Targeting *visibility;
 
+	//line-of-sight service between satellites and targets, with cached windows
+	Visibility sat_visibility;
+
 	//declaring Table pointer as temporary storage of a single table
 	Table *table;
 	//	declaring Datadeck 'aerotable' that stores all aerodynamic tables
@@ -286,7 +299,8 @@ public:
 	virtual void scrn_data();
 	virtual void plot_banner(ofstream &fplot,char *title);
 	virtual void plot_index_arrays();
-	virtual void plot_data(ofstream &fplot,bool merge);
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step);
+	virtual void record_output();
 	virtual void event(char *options);
 	virtual void document(ostream &fdoc,char *title,Document *doc_cruise3);
 	virtual void com_index_arrays();
@@ -360,6 +374,9 @@ protected:
 	//Indicator array pointing to the module-variable which are to 
 	//be written to 'combus' 'packets'
 	int *target_com_ind; int target_com_count;
+
+	//output plan of 'com' compiled by 'com_index_arrays()', executed by 'traj_data()'
+	Output *com_plan; int ncom_plan;
 public:
 	Target(){};
 	Target(Module *module_list,int num_modules);
@@ -376,7 +393,8 @@ public:
 	virtual void scrn_data(){};
 	virtual void plot_banner(ofstream &fplot,char *title){};
 	virtual void plot_index_arrays(){};
-	virtual void plot_data(ofstream &fplot,bool merge){};
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step){};
+	virtual void record_output();
 	virtual void event(char *options){};
 	virtual void doc_input(fstream &input){};
 
@@ -436,6 +454,9 @@ protected:
 	//be written to 'combus' 'packets'
 	int *satellite_com_ind; int satellite_com_count;
 
+	//output plan of 'com' compiled by 'com_index_arrays()', executed by 'traj_data()'
+	Output *com_plan; int ncom_plan;
+
 public:
 	Satellite(){};
 	Satellite(Module *module_list,int num_modules);
@@ -452,7 +473,8 @@ public:
 	virtual void scrn_data(){};
 	virtual void plot_banner(ofstream &fplot,char *title){};
 	virtual void plot_index_arrays(){};
-	virtual void plot_data(ofstream &fplot,bool merge){};
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step){};
+	virtual void record_output();
 	virtual void event(char *options){};
 	virtual void doc_input(fstream &input){};
 
@@ -510,6 +510,14 @@ void Cruise::scrn_index_arrays()
 			l++;
 		}
 	}
+
+	//compiling the output plan
+	int column(0);
+	nscrn_plan=0;
+	for(i=0;i<round3_scrn_count;i++)
+		scrn_plan[nscrn_plan++]=round3[round3_scrn_ind[i]].output(column);
+	for(i=0;i<cruise_scrn_count;i++)
+		scrn_plan[nscrn_plan++]=cruise[cruise_scrn_ind[i]].output(column);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Writing data to screen
@@ -526,85 +534,36 @@ void Cruise::scrn_index_arrays()
 void Cruise::scrn_data()
 {
 
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k(0);
 	int i(0);
 	
 	cout<<cruise3_name<<'\n';
 	cout.setf(ios::left);
 
-	//writing to screen the variables from the 'Round3' class
-	for(i=0;i<round3_scrn_count;i++)
+	//writing to screen the variables of the output plan
+	for(i=0;i<nscrn_plan;i++)
 	{
-		index=round3_scrn_ind[i];
-		//checking for integers
-		integer=round3[index].get_type();
-		vector=round3[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=scrn_plan[i];
+		if(out.kind==1)
 		{
 			cout.width(15);
-			cout<<round3[index].integer();			
+			cout<<*out.integer;
 			k++; if(k>7){k=0;cout<<'\n';}
 		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		else if(out.kind==2)
 		{
-			VEC=round3[index].vec();
-
-			cout.width(15);
-			cout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-		}
-		else
-		{
-			//real variables
-			cout.width(15);
-			cout<<round3[index].real();
-			k++; if(k>7){k=0;cout<<'\n';}
-		}
-	}
-	//writing to screen the variables from the 'Cruise' class
-	for(i=0;i<cruise_scrn_count;i++)
-	{
-		index=cruise_scrn_ind[i];
-		//checking for integers
-		integer=cruise[index].get_type();
-		vector=cruise[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			cout.width(15);
-			cout<<cruise[index].integer();			
-			k++; if(k>7){k=0;cout<<'\n';}
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=cruise[index].vec();
-			cout.width(15);
-			cout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;cout<<'\n';}
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
+			{
+				cout.width(15);
+				cout<<vec[m];
+				k++; if(k>7){k=0;cout<<'\n';}
+			}
 		}
 		else
 		{
-			//real variables
 			cout.width(15);
-			cout<<cruise[index].real();
+			cout<<*out.real;
 			k++; if(k>7){k=0;cout<<'\n';}
 		}
 	}
@@ -625,85 +584,36 @@ void Cruise::scrn_data()
 void Cruise::tabout_data(ofstream &ftabout)
 {
 
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k(0);
 	int i(0);
 	
 	ftabout<<cruise3_name<<'\n';
 	ftabout.setf(ios::left);
 
-	//writing to 'tabout.asc' the variables from the 'Round3' class
-	for(i=0;i<round3_scrn_count;i++)
+	//writing to 'tabout.asc' the variables of the output plan
+	for(i=0;i<nscrn_plan;i++)
 	{
-		index=round3_scrn_ind[i];
-		//checking for integers
-		integer=round3[index].get_type();
-		vector=round3[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=scrn_plan[i];
+		if(out.kind==1)
 		{
 			ftabout.width(15);
-			ftabout<<round3[index].integer();			
+			ftabout<<*out.integer;
 			k++; if(k>7){k=0;ftabout<<'\n';}
 		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		else if(out.kind==2)
 		{
-			VEC=round3[index].vec();
-
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-		}
-		else
-		{
-			//real variables
-			ftabout.width(15);
-			ftabout<<round3[index].real(); 
-			k++; if(k>7){k=0;ftabout<<'\n';}
-		}
-	}
-	//writing to 'tabout.asc' the variables from the 'Cruise' class
-	for(i=0;i<cruise_scrn_count;i++)
-	{
-		index=cruise_scrn_ind[i];
-		//checking for integers
-		integer=cruise[index].get_type();
-		vector=cruise[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			ftabout.width(15);
-			ftabout<<cruise[index].integer();			
-			k++; if(k>7){k=0;ftabout<<'\n';}
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=cruise[index].vec();
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
+			{
+				ftabout.width(15);
+				ftabout<<vec[m];
+				k++; if(k>7){k=0;ftabout<<'\n';}
+			}
 		}
 		else
 		{
-			//real variables
 			ftabout.width(15);
-			ftabout<<cruise[index].real();
+			ftabout<<*out.real;
 			k++; if(k>7){k=0;ftabout<<'\n';}
 		}
 	}
@@ -809,6 +719,15 @@ void Cruise::plot_index_arrays()
 			l++;
 		}
 	}
+
+	//compiling the output plan
+	int column(0);
+	nplot_plan=0;
+	for(i=0;i<round3_plot_count;i++)
+		plot_plan[nplot_plan++]=round3[round3_plot_ind[i]].output(column);
+	for(i=0;i<cruise_plot_count;i++)
+		plot_plan[nplot_plan++]=cruise[cruise_plot_ind[i]].output(column);
+	dense_rates(plot_plan,round3_plot_ind,round3_plot_count);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Writing data to 'ploti.asc', i=1,2,3...
@@ -817,118 +736,80 @@ void Cruise::plot_index_arrays()
 //five accross, unlimited down
 //data field 16 spaces, total width 80 spaces
 //
+//Parameter input:
+//	frac = fraction of the last integration step 'step' at which the data are
+//		sampled; frac=1 writes the current values
+//
 //010116 Created by Peter Zipfel
 //030627 Adapted to CRUISE simulation, PZi
 ///////////////////////////////////////////////////////////////////////////////
 
-void Cruise::plot_data(ofstream &fplot,bool merge)
+void Cruise::plot_data(ofstream &fplot,bool merge,double frac,double step)
 {
 
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k(0);
 	int i(0);
 	
 	fplot.setf(ios::left);
 
-	//writing to 'ploti.asc' the variables from the 'Round3' class
-	for(i=0;i<round3_plot_count;i++)
+	//writing to 'ploti.asc' the variables of the output plan
+	for(i=0;i<nplot_plan;i++)
 	{
-		index=round3_plot_ind[i];
-		//checking for integers
-		integer=round3[index].get_type();
-		vector=round3[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=plot_plan[i];
+		if(out.kind==1)
 		{
 			//casting integer to real variable
 			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<(double) round3[index].integer();			
+			if(frac<1) fplot<<out.sample(0,frac,step);
+			else fplot<<(double) *out.integer;
 			k++;
 		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		else if(out.kind==2)
 		{
-			VEC=round3[index].vec();
-
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++; 
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
-			k++;
-		}
-		else
-		{
-			//real variables
-			if(merge&&(!index))
-				//for merging files, time at last entry must be '-1'
-			{
-				fplot.width(16);
-				fplot<<"-1.0";
-				k++;
-			}
-			else
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
 			{
 				if(k>4){k=0;fplot<<'\n';}
 				fplot.width(16);
-				fplot<<round3[index].real(); 
+				if(frac<1) fplot<<out.sample(m,frac,step);
+				else fplot<<vec[m];
 				k++;
 			}
 		}
-	}
-	//writing to 'ploti.asc' the variables from the 'Cruise' class
-	for(i=0;i<cruise_plot_count;i++)
-	{
-		index=cruise_plot_ind[i];
-		//checking for integers
-		integer=cruise[index].get_type();
-		vector=cruise[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<(double) cruise[index].integer();			
-			k++;
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		else if(merge&&!out.column)
+		//for merging files, time at last entry must be '-1'
 		{
-			VEC=cruise[index].vec();
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
+			fplot<<"-1.0";
 			k++;
 		}
 		else
 		{
-			//real variables
 			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<cruise[index].real();
+			if(frac<1) fplot<<out.sample(0,frac,step);
+			else fplot<<*out.real;
 			k++;
 		}
 	}
 	fplot<<"\n";
 }
 ///////////////////////////////////////////////////////////////////////////////
+//Recording the plot and 'combus' output plans at the end of the integration
+// step for dense output by 'plot_data()' and 'traj_data()'
+///////////////////////////////////////////////////////////////////////////////
+
+void Cruise::record_output()
+{
+	int i(0);
+
+	for(i=0;i<nplot_plan;i++)
+		plot_plan[i].record();
+	for(i=0;i<ncom_plan;i++)
+		com_plan[i].record();
+}
+///////////////////////////////////////////////////////////////////////////////
 //Watching for and executing events
 // 
 //Max number of events set by global constant NEVENT
@@ -1245,6 +1126,23 @@ void Cruise::com_index_arrays()
 			l++;
 		}
 	}
+
+	//loading the definitions into 'com_cruise3' once and compiling its output plan
+	int column(0);
+	ncom_plan=0;
+	for(i=0;i<round3_com_count;i++)
+	{
+		com_cruise3[ncom_plan]=round3[round3_com_ind[i]];
+		com_plan[ncom_plan]=com_cruise3[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	for(i=0;i<cruise_com_count;i++)
+	{
+		com_cruise3[ncom_plan]=cruise[cruise_com_ind[i]];
+		com_plan[ncom_plan]=com_cruise3[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	dense_rates(com_plan,round3_com_ind,round3_com_count);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Initializing loading 'packet' with 'CRUISE3' data
@@ -1275,17 +1173,18 @@ Packet Cruise::loading_packet_init(int num_cruise,int num_target,int num_satelli
 	for(i=0;i<round3_com_count;i++)
 	{
 		index=round3_com_ind[i];
-		com_cruise3[i]=round3[index]; 
+		com_cruise3[i].restore(round3[index]); 
 	}
 	for(int j=0;j<cruise_com_count;j++)
 	{
 		index=cruise_com_ind[j];
-		com_cruise3[i+j]=cruise[index];
+		com_cruise3[i+j].restore(cruise[index]);
 	}
 	//refreshing the packet
 	packet.set_id(id);
 	packet.set_status(1);
 	packet.set_data(com_cruise3);
+	packet.set_plan(com_plan);
 	packet.set_ndata(ncom_cruise3);
 
 	return packet;
@@ -1318,12 +1217,12 @@ Packet Cruise::loading_packet(int num_cruise,int num_target,int num_satellite)
 	for(i=0;i<round3_com_count;i++)
 	{
 		index=round3_com_ind[i];
-		com_cruise3[i]=round3[index];
+		com_cruise3[i].restore(round3[index]);
 	}
 	for(j=0;j<cruise_com_count;j++)
 	{
 		index=cruise_com_ind[j];
-		com_cruise3[i+j]=cruise[index];
+		com_cruise3[i+j].restore(cruise[index]);
 	}
 	//refreshing the packet
 //	packet.set_id(id);
@@ -1406,7 +1305,7 @@ void Cruise::read_tables(char *file_name,Datadeck &datatable)
 		//extracting table dimension
 		//at this point 'temp' is holding xDIM
 		int dim_check(0);
-		char dim_buff[2];
+		char dim_buff[2]={0};
 		int table_dim(0);
 		strncpy(dim_buff,temp,1);
 		//converting character to integer
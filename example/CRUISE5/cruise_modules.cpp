@@ -428,25 +428,18 @@ void Cruise::targeting(Packet *combus,int vehicle_slot,int num_vehicles,int num_
 				//building 'grnd_range[]' (ranges to all targets)
 				targeting_grnd_ranges(combus,num_vehicles);
 
-				//determining closest target
+				//determining closest target in line-of-sight of the satellite
 				range=BIG;
 
-				int j=0;
-
-				for(int i=0;i<num_vehicles;i++)
+				for(int j=0;j<sat_visibility.get_ntgt();j++)
 				{
-					string id=combus[i].get_id();
-					char loc=id.find("t");
-					if(!loc)
+					if(!sat_visibility.get_clear(k,j)) continue;
+					//getting ground ranges to targets
+					double new_range=grnd_range[j];
+					if(new_range<range)
 					{
-						//getting ground ranges to targets
-						double new_range=grnd_range[j];
-						j++;
-						if(new_range<range)
-						{
-							range=new_range;
-							clost_tgt_slot=i;
-						}
+						range=new_range;
+						clost_tgt_slot=sat_visibility.get_tgt_slot(j);
 					}
 				}//closest target determined
 			}//first satellite that is able to provide targeting info
@@ -485,111 +478,37 @@ void Cruise::targeting(Packet *combus,int vehicle_slot,int num_vehicles,int num_
 //The status of all satellites (targeting or not-targeting) is stored in 'Targeting visibility[]'
 //
 //Assumption:
-//  If the first target can be seen, so all targets can be seen by the satellite;
-//  therefore target visibility is soley based on first target 
+//  If the first target can be seen, the satellite can provide targeting data;
+//  therefore satellite selection is soley based on first target 
+//The grazing-angle tests are made by the 'Visibility' service 'sat_visibility',
+// which caches the satellite-target lines-of-sight between updates
 //Requirement:
-// The 'Target'-object variables SBII(3x1) must be located in 'combus' at
-//  'Packet data[i]', i=10;
+// The 'Target' and 'Satellite'-object variables 'dvbe' and SBII(3x1) must be located
+//  in 'combus' at 'Packet data[i]', i=5 and i=10;
 //  this location is determined by the sequence of the "com"-key entry
 //   in the module-variable array 'round3[]' 
 //
 //Output: 'Targeting Cruise::visibility[]'; entry: not visible = '0', visible = '1'
 //		
 //010813 Created by Peter H Zipfel
+//first target line-of-sight tested from the satellite (was from the missile)
 ///////////////////////////////////////////////////////////////////////////////
 void Cruise::targeting_satellite(Packet *combus,int num_vehicles)
 {
-	//local variables
-	int k(0);
-	int i(0);
-	string id;
-	Variable *data_first_target; //module-variable data of first target 
-	Variable *data_sat;
-	Matrix STII(3,1);
-	Matrix SSII(3,1);
-	double grazing_angle(0);
-	double satellite_missile_angle(0);
-	double satellite_target_angle(0);
-	double alt_crit(0);
-	bool first_target=false;
-
 	//localizing module-variables
 	//input data
 	double del_radius=cruise[131].real();
 	//input from other modules
+	double time=round3[0].real();
 	Matrix SBII=round3[35].vec();
 	//-------------------------------------------------------------------------
 	double radius=REARTH+del_radius;
-	//locating first target in 'combus' and its inertial vector
-	for(i=0;i<num_vehicles;i++)
-	{
-		if(!first_target)
-		{
-			id=combus[i].get_id();
-			char loc=id.find("t"); //Schildt p.687, returns index (0, first letter) of match
-			if(!loc)
-			{
-				first_target=true;
-				data_first_target=combus[i].get_data();
-				STII=data_first_target[10].vec();
-			}
-		}
-	}
-	//cycling through the vehicles, locating  satellites
-	for(i=0;i<num_vehicles;i++)
-	{
-		id=combus[i].get_id();
-		char loc=id.find("s"); //Schildt p.687, returns index (0, first letter) of match
 
-		if(!loc)
-		//satellite is found
-		{
-			data_sat=combus[i].get_data();
-			SSII=data_sat[10].vec();
-		//
-			//Determining clear line-of-sight between satellite and cruise
-			double dsi=SSII.absolute();
-			grazing_angle=acos(radius/dsi);
-			satellite_missile_angle=angle(SBII,SSII);
-
-			if(satellite_missile_angle<grazing_angle)
-			//always visible
-			{
-				visibility[k].tracking=1;
-				visibility[k].vehicle_slot=i;
-				k++;
-			}
-			else
-			//visible if altitude of cruise is sufficient
-			{
-				//critical altitude
-				double radius_crit;
-				double dum=cos(satellite_missile_angle-grazing_angle);
-				if(fabs(dum)>EPS) radius_crit=radius/dum;				
-				alt_crit=radius_crit-REARTH;
-				double dbi=SBII.absolute();
-				if(dbi>radius_crit)
-				{
-					visibility[k].tracking=1;
-					visibility[k].vehicle_slot=i;
-					k++;
-				}
-				else
-				{
-					visibility[k].tracking=0;
-					visibility[k].vehicle_slot=i;
-					k++;
-				}
-			}
-			//determining if there is NO clear line-of-site to first target
-			// then reset 'tracking=0'
-			satellite_target_angle=angle(SBII,STII);
-			if(satellite_target_angle>grazing_angle)
-			{
-				visibility[k-1].tracking=0;
-			}
-		}
-	}//all satellites evaluated and stored in 'visibility[]'
+	//refreshing the satellite-target lines-of-sight whose windows have expired
+	sat_visibility.update(combus,num_vehicles,radius,time);
+
+	//satellites in line-of-sight of 'this' cruise missile and of the first target
+	sat_visibility.vehicle(visibility,SBII);
 }
 ///////////////////////////////////////////////////////////////////////////////  
 //Calculating ground distances of cruise missile to all targets
@@ -607,10 +526,6 @@ void Cruise::targeting_satellite(Packet *combus,int num_vehicles)
 ///////////////////////////////////////////////////////////////////////////////
 void Cruise::targeting_grnd_ranges(Packet *combus,int num_vehicles)
 {
-	//local variables
-	int k(0);
-	string id;
-
 	//localizing module-variables
 	//input from other modules
 	double lonx=round3[19].real();
@@ -619,26 +534,21 @@ void Cruise::targeting_grnd_ranges(Packet *combus,int num_vehicles)
 	double lon_c=lonx*RAD;
 	double lat_c=latx*RAD;
 
-	for(int i=0;i<num_vehicles;i++)
+	//targets located by 'sat_visibility', in 'combus' order
+	for(int k=0;k<sat_visibility.get_ntgt();k++)
 	{
-		id=combus[i].get_id();
-		char loc=id.find("t");
-		if(!loc)
-		{
-			Variable *data_c2=combus[i].get_data();
-			double lonx_t=data_c2[2].real();
-			double latx_t=data_c2[3].real();
+		Variable *data_c2=combus[sat_visibility.get_tgt_slot(k)].get_data();
+		double lonx_t=data_c2[2].real();
+		double latx_t=data_c2[3].real();
 
-			double lon_t=lonx_t*RAD;
-			double lat_t=latx_t*RAD;
+		double lon_t=lonx_t*RAD;
+		double lat_t=latx_t*RAD;
 
-			//calculating separation distance over round earth
-			double dum=sin(lat_t)*sin(lat_c)+cos(lat_t)*cos(lat_c)*cos(lon_t-lon_c);
+		//calculating separation distance over round earth
+		double dum=sin(lat_t)*sin(lat_c)+cos(lat_t)*cos(lat_c)*cos(lon_t-lon_c);
 
-			//load into 'grnd_range' array 
-			grnd_range[k]=REARTH*acos(dum);
- 			k++;
-		}
+		//load into 'grnd_range' array 
+		grnd_range[k]=REARTH*acos(dum);
 	}
 }
 
@@ -2072,8 +1982,7 @@ void Cruise::def_intercept()
 	cruise[124].init("MISS_G",0,0,0,"Miss vector in geog. coord. - m","intercept","diag","");
 	cruise[125].init("time_m",0,"Previous time - s","intercept","save","");
 	cruise[126].init("SBTGM",0,0,0,"Previous displacment vector. - m","intercept","save","");
-	cruise[127].init("STMEG",0,0,0,"Previous taget displacment vector. - m","intercept","save","");
-	cruise[128].init("SBMEG",0,0,0,"Previous cruise missile displacment vector. - m","intercept","save","");
+	cruise[127].init("VBTGM",0,0,0,"Previous velocity of cruise missile wrt target - m/s","intercept","save","");
 }
 //$$$//////////////////////////////////////////////////////////////////////////
 //Intercept module
@@ -2092,7 +2001,7 @@ void Cruise::intercept(Packet *combus,int vehicle_slot,double int_step,char *tit
 	//local variables
 	double tau(0);
 	Matrix SBTG(3,1);
-	Matrix SBBMG(3,1);
+	Matrix VBTG(3,1);
 	double swbg1(0);
 	double swbg2(0);
 	double dwbh(0);
@@ -2109,13 +2018,12 @@ void Cruise::intercept(Packet *combus,int vehicle_slot,double int_step,char *tit
 	double alt=round3[21].real();
 	double psivgx=round3[28].real();
 	double thtvgx=round3[29].real();
-	Matrix SBEG=round3[31].vec();
+	Matrix VBEG=round3[32].vec();
 	//restore saved values
 	int write=cruise[121].integer();
 	double time_m=cruise[125].real();
 	Matrix SBTGM=cruise[126].vec();
-	Matrix STMEG=cruise[127].vec();
-	Matrix SBMEG=cruise[128].vec();
+	Matrix VBTGM=cruise[127].vec();
 	//input from other modules
 	int mguidance=cruise[80].integer();
 	double wp_lonx=cruise[85].real();
@@ -2195,35 +2103,37 @@ void Cruise::intercept(Packet *combus,int vehicle_slot,double int_step,char *tit
 	//Seeker/pronav
 	if(mseeker==3)
 	{
+		Variable *data_t;
+		Matrix VTEG(3,1);
+		
+		//get target velocity
+		data_t=combus[targ_com_slot].get_data();
+		VTEG=data_t[9].vec();
+
+		//cruise missile wrt target
+		SBTG=STBG*(-1);
+		VBTG=VBEG-VTEG;
+
 		//entering sphere of target influence of 100m 
 		if(range_go<100)
 		{		
-			Variable *data_t;
-			Matrix STEG(3,1);
-			Matrix SBBMG(3,1);
-			Matrix STTMG(3,1);
-			
-			//get target location
-			data_t=combus[targ_com_slot].get_data();
-			STEG=data_t[8].vec();
-			
 			//Intercept (closing speed becomes negative)
-			//Miss is closest distance between cruise missile and target points; obtained by linear interpolation
-			//between integration steps
-			SBTG=STBG*(-1);
+			//Miss is closest distance between cruise missile and target points; obtained from the cubic
+			//relative trajectory between integration steps
 			if((closing_speed<0)&&write)
 			{
 				write=0;
 
-				SBBMG=SBEG-SBMEG;
-				STTMG=STEG-STMEG;
-
-				//intercept time at point of closest approach
-				hit_time=time_m-int_step*((SBBMG-STTMG)^SBTGM)/(SBBMG^SBBMG);
-
-				//miss distance vector in geographic coordinates
-				tau=hit_time-time_m;
-				MISS_G=(SBBMG-STTMG)*(tau/int_step)+SBTGM;
+				//intercept time and miss distance vector in geographic coordinates;
+				//without a previous step, the miss at the current step
+				if(time_m>0){
+					tau=closest_approach(MISS_G,SBTGM,VBTGM,SBTG,VBTG,time-time_m);
+					hit_time=time_m+tau;
+				}
+				else{
+					MISS_G=SBTG;
+					hit_time=time;
+				}
 				miss=MISS_G.absolute();
 
 				//getting cruise missile # and target #
@@ -2242,12 +2152,11 @@ void Cruise::intercept(Packet *combus,int vehicle_slot,double int_step,char *tit
 				combus[targ_com_slot].set_status(-1);
 				combus[vehicle_slot].set_status(0);
 			}
-			//save from previous cycle
-			SBTGM=SBTG;
-			STMEG=STEG;
-			SBMEG=SBEG;
-			time_m=time;
 		}
+		//save from previous cycle
+		SBTGM=SBTG;
+		VBTGM=VBTG;
+		time_m=time;
 	}//end of seeker/pronav
 	//-------------------------------------------------------------------------
 	//loading module-variables
@@ -2255,8 +2164,7 @@ void Cruise::intercept(Packet *combus,int vehicle_slot,double int_step,char *tit
 	cruise[121].gets(write);
 	cruise[125].gets(time_m);
 	cruise[126].gets_vec(SBTGM);
-	cruise[127].gets_vec(STMEG);
-	cruise[128].gets_vec(SBMEG);
+	cruise[127].gets_vec(VBTGM);
 	//diagnostics
 	cruise[122].gets(miss);
 	cruise[123].gets(hit_time);
@@ -656,19 +656,20 @@ void traj_banner(ofstream &ftraj,Packet *combus,char *title,int num_vehicles,
 //five accross, unlimited down
 //data field 16 spaces, total width 80 spaces
 //
+//Parameter input:
+//	frac = fraction of the last integration step 'step' at which the data are
+//		sampled; frac=1 writes the current values
+//
 //010212 Created by Peter Zipfel
 //030627 Adapted to CRUISE simulation, PZi
 //060524 Including satellites, PZi
 ///////////////////////////////////////////////////////////////////////////////
 
-void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
+void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge,double frac,double step)
 {
 
-	char *integer=NULL;
-	char *vector=NULL;
-	Matrix VEC(3,1);
 	int k(0);
-	Variable *data=NULL;
+	Output *plan=NULL;
 	int ndata(0);
 	string id;
 	int cruise_object(0);
@@ -689,6 +690,7 @@ void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
 	{
 		Variable *data_c1=combus[0].get_data();
 		double time=data_c1[0].real();
+		if(frac<1) time=combus[0].get_plan()[0].sample(0,frac,step);
 		ftraj.width(16);
 		ftraj<<time;
 		k=1;
@@ -705,49 +707,40 @@ void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
 		if(!cruise_object)
 		//'Cruise' object
 		{
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//writing communication variables to 'traj.asc'
 			for(int j=1;j<ndata;j++)
 			{
-
-				integer=data[j].get_type();
-				vector=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<(double) data[j].integer();			
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<(double) *out.integer;
 					k++;
 				}
-				//checking vor vectors
-				else if(isupper(vector[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(0,0);
-					k++; 
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(1,0);
-					k++;
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>4){k=0;ftraj<<'\n';}
+						ftraj.width(16);
+						if(frac<1) ftraj<<out.sample(m,frac,step);
+						else ftraj<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<data[j].real(); 
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<*out.real;
 					k++;
 				}
 			}
@@ -756,49 +749,40 @@ void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
 		else if(!target_object)
 		//'Target' object
 		{
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//writing communication variables to 'traj.asc'
 			for(int j=1;j<ndata;j++)
 			{
-
-				integer=data[j].get_type();
-				vector=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<(double) data[j].integer();			
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<(double) *out.integer;
 					k++;
 				}
-				//checking vor vectors
-				else if(isupper(vector[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(0,0);
-					k++; 
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(1,0);
-					k++;
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>4){k=0;ftraj<<'\n';}
+						ftraj.width(16);
+						if(frac<1) ftraj<<out.sample(m,frac,step);
+						else ftraj<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<data[j].real(); 
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<*out.real;
 					k++;
 				}
 			}
@@ -807,49 +791,40 @@ void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
 		else if(!satellite_object)
 		//'Satellite' object
 		{
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//writing communication variables to 'traj.asc'
 			for(int j=1;j<ndata;j++)
 			{
-
-				integer=data[j].get_type();
-				vector=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<(double) data[j].integer();			
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<(double) *out.integer;
 					k++;
 				}
-				//checking vor vectors
-				else if(isupper(vector[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(0,0);
-					k++; 
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(1,0);
-					k++;
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>4){k=0;ftraj<<'\n';}
+						ftraj.width(16);
+						if(frac<1) ftraj<<out.sample(m,frac,step);
+						else ftraj<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<data[j].real(); 
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<*out.real;
 					k++;
 				}
 			}
@@ -892,10 +867,7 @@ void comscrn_data(Packet *combus,int num_vehicles)
 	Variable *data_target=NULL; //Variable array stored in 'Packet data' of type Target
 	Variable *data_satellite=NULL; //Variable array stored in 'Packet data' of type Satellite
 	int ndata(0);
-	Variable *data=NULL;
-	char *integer=NULL;
-	char *vector=NULL;
-	Matrix VEC(3,1);
+	Output *plan=NULL;
 
 	//find first cruise packet index in 'combus'
 	for(i=0;i<num_vehicles;i++)
@@ -994,8 +966,8 @@ void comscrn_data(Packet *combus,int num_vehicles)
 			//'Cruise' object
 			{
 				p++;
-				data=combus[i].get_data();
 				ndata=combus[i].get_ndata();
+				plan=combus[i].get_plan();
 
 				//write out label of i-th object
 				cout<<"\n *** c_";cout.width(8);cout<<p;
@@ -1004,42 +976,31 @@ void comscrn_data(Packet *combus,int num_vehicles)
 				//writing communication variables to screen
 				for(int j=1;j<ndata;j++)
 				{
-					integer=data[j].get_type();
-					vector=data[j].get_name();
-
-					//checking for integer variables
-					if(!strcmp(integer,"int"))
+					Output &out=plan[j];
+					if(out.kind==1)
 					{
 						//casting integer to real variable
 						if(k>7){k=0;cout<<'\n';}
 						cout.width(15);
-						cout<<(double) data[j].integer();			
+						cout<<(double) *out.integer;
 						k++;
 					}
-					//checking vor vectors
-					else if(isupper(vector[0]))
+					else if(out.kind==2)
 					{
-						VEC=data[j].vec();
-
-						if(k>7){k=0;cout<<'\n';}
-						cout.width(15);
-						cout<<VEC.get_loc(0,0);
-						k++; 
-						if(k>7){k=0;cout<<'\n';}
-						cout.width(15);
-						cout<<VEC.get_loc(1,0);
-						k++;
-						if(k>7){k=0;cout<<'\n';}
-						cout.width(15);
-						cout<<VEC.get_loc(2,0);
-						k++;
+						double *vec=out.vec->get_pbody();
+						for(int m=0;m<3;m++)
+						{
+							if(k>7){k=0;cout<<'\n';}
+							cout.width(15);
+							cout<<vec[m];
+							k++;
+						}
 					}
-					//left are real variables
 					else
 					{
 						if(k>7){k=0;cout<<'\n';}
 						cout.width(15);
-						cout<<data[j].real(); 
+						cout<<*out.real;
 						k++;
 					}
 				}
@@ -1088,8 +1049,8 @@ void comscrn_data(Packet *combus,int num_vehicles)
 			//'Target' object
 			{
 				q++;
-				data=combus[i].get_data();
 				ndata=combus[i].get_ndata();
+				plan=combus[i].get_plan();
 
 				//write out label of i-th object
 				cout<<"\n *** t_";cout.width(8);cout<<q;
@@ -1098,42 +1059,31 @@ void comscrn_data(Packet *combus,int num_vehicles)
 				//writing communication variables to screen
 				for(int j=1;j<ndata;j++)
 				{
-					integer=data[j].get_type();
-					vector=data[j].get_name();
-
-					//checking for integer variables
-					if(!strcmp(integer,"int"))
+					Output &out=plan[j];
+					if(out.kind==1)
 					{
 						//casting integer to real variable
 						if(k>7){k=0;cout<<'\n';}
 						cout.width(15);
-						cout<<(double) data[j].integer();			
+						cout<<(double) *out.integer;
 						k++;
 					}
-					//checking vor vectors
-					else if(isupper(vector[0]))
+					else if(out.kind==2)
 					{
-						VEC=data[j].vec();
-
-						if(k>7){k=0;cout<<'\n';}
-						cout.width(15);
-						cout<<VEC.get_loc(0,0);
-						k++; 
-						if(k>7){k=0;cout<<'\n';}
-						cout.width(15);
-						cout<<VEC.get_loc(1,0);
-						k++;
-						if(k>7){k=0;cout<<'\n';}
-						cout.width(15);
-						cout<<VEC.get_loc(2,0);
-						k++;
+						double *vec=out.vec->get_pbody();
+						for(int m=0;m<3;m++)
+						{
+							if(k>7){k=0;cout<<'\n';}
+							cout.width(15);
+							cout<<vec[m];
+							k++;
+						}
 					}
-					//left are real variables
 					else
 					{
 						if(k>7){k=0;cout<<'\n';}
 						cout.width(15);
-						cout<<data[j].real(); 
+						cout<<*out.real;
 						k++;
 					}
 				}
@@ -1182,8 +1132,8 @@ void comscrn_data(Packet *combus,int num_vehicles)
 			//'Satellite' object
 			{
 				r++;
-				data=combus[i].get_data();
 				ndata=combus[i].get_ndata();
+				plan=combus[i].get_plan();
 
 				//write out label of i-th object
 				cout<<"\n *** s_";cout.width(8);cout<<r;
@@ -1192,42 +1142,31 @@ void comscrn_data(Packet *combus,int num_vehicles)
 				//writing communication variables to screen
 				for(int j=1;j<ndata;j++)
 				{
-					integer=data[j].get_type();
-					vector=data[j].get_name();
-
-					//checking for integer variables
-					if(!strcmp(integer,"int"))
+					Output &out=plan[j];
+					if(out.kind==1)
 					{
 						//casting integer to real variable
 						if(k>7){k=0;cout<<'\n';}
 						cout.width(15);
-						cout<<(double) data[j].integer();			
+						cout<<(double) *out.integer;
 						k++;
 					}
-					//checking vor vectors
-					else if(isupper(vector[0]))
+					else if(out.kind==2)
 					{
-						VEC=data[j].vec();
-
-						if(k>7){k=0;cout<<'\n';}
-						cout.width(15);
-						cout<<VEC.get_loc(0,0);
-						k++; 
-						if(k>7){k=0;cout<<'\n';}
-						cout.width(15);
-						cout<<VEC.get_loc(1,0);
-						k++;
-						if(k>7){k=0;cout<<'\n';}
-						cout.width(15);
-						cout<<VEC.get_loc(2,0);
-						k++;
+						double *vec=out.vec->get_pbody();
+						for(int m=0;m<3;m++)
+						{
+							if(k>7){k=0;cout<<'\n';}
+							cout.width(15);
+							cout<<vec[m];
+							k++;
+						}
 					}
-					//left are real variables
 					else
 					{
 						if(k>7){k=0;cout<<'\n';}
 						cout.width(15);
-						cout<<data[j].real(); 
+						cout<<*out.real;
 						k++;
 					}
 				}
@@ -38,6 +38,62 @@ struct Module
 	string termination;
 };
 
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Output'
+//
+//Entry of the output plans compiled by the index arrays, so that the writers
+// need no type or name inspection and no 'Matrix' copies during the run
+//
+//kind: =0 real, =1 integer, =2 3x1 vector
+//column: first output column of the entry; 'time' is at column 0
+//
+//Dense output: 'record()' saves the values at the end of each step, 'sample()'
+// interpolates within the last step. Vector states with a known derivative
+// 'rate' use cubic Hermite polynomials, all other reals are interpolated
+// linearly and integers hold their value until the end of the step
+///////////////////////////////////////////////////////////////////////////////
+struct Output
+{
+	double *real;
+	int *integer;
+	Matrix *vec;
+	int kind;
+	int column;
+	Matrix *rate;		//time derivative of 'vec', NULL if unknown
+	double last[3];		//values at the end of the previous step
+	double rate_last[3];	//derivative at the end of the previous step
+
+	void record()
+	{
+		if(kind==0) last[0]=*real;
+		else if(kind==1) last[0]=*integer;
+		else
+		{
+			double *pvec=vec->get_pbody();
+			for(int m=0;m<3;m++) last[m]=pvec[m];
+			if(rate)
+			{
+				double *prate=rate->get_pbody();
+				for(int m=0;m<3;m++) rate_last[m]=prate[m];
+			}
+		}
+	}
+	//value of component 'm' (m=0 for scalars) at fraction 'frac' of the last step 'step'
+	double sample(int m,double frac,double step)
+	{
+		if(kind==1) return last[0];
+		double y0=last[m];
+		double y1=(kind==2)?vec->get_pbody()[m]:*real;
+		if(!rate) return y0+(y1-y0)*frac;
+
+		double frac2=frac*frac;
+		double frac3=frac2*frac;
+		double dy0=rate_last[m]*step;
+		double dy1=rate->get_pbody()[m]*step;
+		return (2*frac3-3*frac2+1)*y0+(frac3-2*frac2+frac)*dy0+(3*frac2-2*frac3)*y1+(frac3-frac2)*dy1;
+	}
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 //Class 'Variable'
 //Establishing module-variables as type Variable
@@ -87,6 +143,41 @@ public:
 	//001213 Created by Peter Zipfel
 	///////////////////////////////////////////////////////////////////////////
 	char *get_name(){return name;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Copying the values of module-variable 'var', keeping the definition
+	//Refreshes the 'com' packets without reallocating 'VEC' and 'MAT'
+	///////////////////////////////////////////////////////////////////////////
+	void restore(Variable &var)
+	{
+		rval=var.rval;
+		ival=var.ival;
+		double *pvec=VEC.get_pbody();
+		double *pvec0=var.VEC.get_pbody();
+		for(int i=0;i<3;i++) pvec[i]=pvec0[i];
+		double *pmat=MAT.get_pbody();
+		double *pmat0=var.MAT.get_pbody();
+		for(int i=0;i<9;i++) pmat[i]=pmat0[i];
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Compiling the output plan entry of the module-variable at 'column'
+	//Integers are typed 'int', vectors are named in upper case, all else is real
+	//Advances 'column' by the number of values the entry writes
+	///////////////////////////////////////////////////////////////////////////
+	Output output(int &column)
+	{
+		Output entry={};
+		entry.real=&rval;
+		entry.integer=&ival;
+		entry.vec=&VEC;
+		if(!strcmp(type,"int")) entry.kind=1;
+		else if(isupper(name[0])) entry.kind=2;
+		else entry.kind=0;
+		entry.column=column;
+		column+=(entry.kind==2)?3:1;
+		return entry;
+	}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 'type' from module-variable array 
@@ -126,6 +217,14 @@ public:
 	//001226 Created by Peter Zipfel
 	///////////////////////////////////////////////////////////////////////////
 	Matrix mat(){return MAT;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Copying vector (matrix) value from module-variable array to local
+	//'double' array of 3 (9, row by row) without creating a 'Matrix'
+	//Example: round3[35].vec(SBII); round3[23].mat(TIG);
+	///////////////////////////////////////////////////////////////////////////
+	void vec(double *VE){double *pvec=VEC.get_pbody();for(int i=0;i<3;i++)VE[i]=pvec[i];}
+	void mat(double *MA){double *pmat=MAT.get_pbody();for(int i=0;i<9;i++)MA[i]=pmat[i];}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Four-times overloaded function gets()
@@ -158,6 +257,11 @@ public:
 		return MAT;
 	} 
 
+	//loading local 'double' arrays of 3 (9) in place, without reallocating 'VEC' ('MAT')
+	//Example: round3[35].gets_vec(SBII); round3[23].gets_mat(TIG);
+	void gets_vec(double *VE){double *pvec=VEC.get_pbody();for(int i=0;i<3;i++)pvec[i]=VE[i];}
+	void gets_mat(double *MA){double *pmat=MAT.get_pbody();for(int i=0;i<9;i++)pmat[i]=MA[i];}
+
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 'def' from module-variable array 
 	//
@@ -372,6 +476,7 @@ private:
 	int status;			//alive=1, dead=0. hit=-1 
 	int ndata;			//number of module-variables in data array
 	Variable *data;		//array of module-variables identified by "com" 
+	Output *plan;		//output plan of 'data', compiled by 'com_index_arrays()'
 public:
 	Packet(){};
 	~Packet(){};
@@ -403,6 +508,11 @@ public:
 	///////////////////////////////////////////////////////////////////////////
 	void set_data(Variable *vehicle_d){data=vehicle_d;}
 
+	///////////////////////////////////////////////////////////////////////////
+	//Setting the output plan of packet 'data'
+	///////////////////////////////////////////////////////////////////////////
+	void set_plan(Output *vehicle_plan){plan=vehicle_plan;}
+
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 'id' from packet 
 	//
@@ -430,6 +540,11 @@ public:
 	//010207 Created by Peter Zipfel
 	///////////////////////////////////////////////////////////////////////////
 	Variable *get_data(){return data;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Obtaining the output plan of 'data' from packet
+	///////////////////////////////////////////////////////////////////////////
+	Output *get_plan(){return plan;}
 };
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -446,6 +561,67 @@ struct Targeting
 	int tracking; //no=0; yes=1;
 };
 ///////////////////////////////////////////////////////////////////////////////
+//Class 'Visibility'
+//
+//Line-of-sight service between the satellites and the ground targets on 'combus'
+//The positions are kept as structure of arrays. The grazing-angle test of
+// one satellite against all targets is a single loop over the target arrays,
+// comparing the cosine of the separation angle with the cosine 'radius/dsi'
+// of the grazing angle, without 'acos' or 'Matrix' temporaries.
+//Each satellite row of the satellite-target table is cached with a window:
+// the smallest cosine margin of the row divided by a bound of the rate at
+// which separation and grazing angles can change. The row is recomputed only
+// after its window has expired (or the radius changed), so large
+// constellations and target sets are evaluated only when visibility may flip
+///////////////////////////////////////////////////////////////////////////////
+class Visibility
+{
+private:
+	int nsat;			//number of satellites on 'combus'
+	int ntgt;			//number of targets on 'combus'
+	int *sat_slot;		//[nsat] 'combus' slots of the satellites
+	int *tgt_slot;		//[ntgt] 'combus' slots of the targets
+	double *ssx,*ssy,*ssz;	//[nsat] satellite inertial positions SSII - m
+	double *sdsi;		//[nsat] satellite distance from earth center - m
+	double *scg;		//[nsat] cosine of grazing angle 'radius/dsi' - ND
+	double *srate;		//[nsat] bound of satellite angle rates - rad/s
+	double *stx,*sty,*stz;	//[ntgt] target inertial positions STII - m
+	double *sdti;		//[ntgt] target distance from earth center - m
+	double trate;		//bound of target angular rate - rad/s
+	double radius;		//radius of the occulting sphere - m
+	int *clear;			//[nsat*ntgt] satellite-target line-of-sight; =1:clear
+	double *expiry;		//[nsat] time until which the cached row is valid - s
+	double *work;		//[ntgt] scratch of cosines
+	bool targets_fresh;	//target arrays loaded in the current update
+	int nrefresh;		//number of rows recomputed (diagnostic)
+
+	void load_targets(Packet *combus);
+public:
+	Visibility();
+	~Visibility();
+	//owns its arrays: not copyable
+	Visibility(const Visibility&)=delete;
+	Visibility &operator=(const Visibility&)=delete;
+
+	///////////////////////////////////////////////////////////////////////////
+	//Locating satellites and targets on 'combus' (once) and refreshing the
+	// satellite-target rows whose windows have expired at 'time'
+	///////////////////////////////////////////////////////////////////////////
+	void update(Packet *combus,int num_vehicles,double radius,double time);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Satellites seen from the vehicle at 'SBII' and seeing the first target,
+	// stored in 'visibility[nsat]' in 'combus' order
+	///////////////////////////////////////////////////////////////////////////
+	void vehicle(Targeting *visibility,Matrix SBII);
+
+	int get_nsat(){return nsat;}
+	int get_ntgt(){return ntgt;}
+	int get_tgt_slot(int j){return tgt_slot[j];}
+	int get_clear(int k,int j){return clear[k*ntgt+j];}
+	int get_nrefresh(){return nrefresh;}
+};
+///////////////////////////////////////////////////////////////////////////////
 //Class 'Document'
 //Stores a subset of module-variable for documentation
 //
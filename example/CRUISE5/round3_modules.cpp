@@ -17,6 +17,7 @@ using namespace std;
 //Member function of class 'Round3'
 //Module-variable locations are assigned to round3[11-16]
 //For executive use: round3[0-9]
+//Cruise segment step: round3[4-9]
 //round3[10] is used for FSPV in 'Cruise::def_forces()' 
 //
 //Initializing the module-variables
@@ -32,6 +33,12 @@ void Round3::def_environment()
 	round3[1].init("event_time",0,"Time elapsed during an event - s","environment","exec","scrn");
 	round3[2].init("int_step_new",0,"New integration step size  - s","environment","data","");
 	round3[3].init("out_step_fact",0,"Fact.to mod output,e.g.plot_step*(1+out_step_fact)","environment","data","");
+	round3[4].init("cruise_step",0,"Integration step in steady cruise, =0:off - s","environment","data","");
+	round3[5].init("cruise_jerk",0,"Max rate of change of FSPV in steady cruise - m/s^3","environment","data","");
+	round3[6].init("cruise_dwell",0,"Time FSPV must be steady before 'cruise_step' - s","environment","data","");
+	round3[7].init("mcruise","int",0,"=0:nominal step; =1:cruise step - ND","environment","diag","");
+	round3[8].init("cruise_time",0,"Time FSPV has been steady - s","environment","save","");
+	round3[9].init("FSPV_STEADY",0,0,0,"FSPV of the previous step - m/s^2","environment","save","");
 	round3[11].init("grav",0,"Gravitational acceleration - m/s^2","environment","out","");
 	round3[12].init("rho",0,"Air density - kg/m^3","environment","out","");
 	round3[13].init("pdynmc",0,"Dynamic pressure - Pa","environment","out","scrn,plot");
@@ -72,6 +79,15 @@ void Round3::init_environment(double sim_time,double int_step)
 //Accepting new integration step size 'int_step' from 'input.asc'
 //Implementing the ISO 62 standard atmosphere
 //
+//Cruise segments (off by default, single-vehicle runs):
+// With 'cruise_step'>0 the integration step is raised to 'cruise_step' after
+// the specific force FSPV, i.e. the executed guidance and control commands,
+// has changed by less than 'cruise_jerk'*'int_step' per step for 'cruise_dwell'.
+// Any faster change and every event return to the nominal 'int_step_new'.
+// 'cruise_step' must be a multiple of 'int_step_new' and divide 'scrn_step'
+// and 'com_step'; plot and 'traj.asc' output is interpolated (dense output).
+// The executive shares one step among all vehicles
+//
 //000623 Created by Michael Chiaramonte
 //060512 Upgraded variable initialization, PZi
 ///////////////////////////////////////////////////////////////////////////////
@@ -81,6 +97,9 @@ void Round3::environment(double sim_time,double event_time,double &int_step,doub
 	//local variables
 	double ptemp(0);
 	double k(0);
+	double dbi(0);
+	double dfspv(0);
+	double grid(0);
 	
 	//local module-variables
 	double time(0);
@@ -89,24 +108,56 @@ void Round3::environment(double sim_time,double event_time,double &int_step,doub
 	double pdynmc(0);
 	double mach(0);
 	double vsound(0);
+	int mcruise(0);
 
 	//localizing module-variables
 	//input data
 	double int_step_new=round3[2].real();
 	double out_step_fact=round3[3].real();
+	double cruise_step=round3[4].real();
+	double cruise_jerk=round3[5].real();
+	double cruise_dwell=round3[6].real();
+	//restore saved values
+	double cruise_time=round3[8].real();
+	double FSPV_STEADY[3]; round3[9].vec(FSPV_STEADY);
 	//input from other modules
 	double alt=round3[21].real();
 	double dvbe=round3[25].real();
+	double FSPV[3]; round3[10].vec(FSPV);
 	//-------------------------------------------------------------------------
 	//setting vehicle time to simulation time
 	time=sim_time;
+	//timing the steady specific force over the last step (of size 'int_step')
+	if(cruise_step>0)
+	{
+		for(int i=0;i<3;i++)
+			dfspv+=(FSPV[i]-FSPV_STEADY[i])*(FSPV[i]-FSPV_STEADY[i]);
+		dfspv=sqrt(dfspv);
+		if(dfspv<=cruise_jerk*int_step&&event_time>0)
+			cruise_time+=int_step;
+		else
+			cruise_time=0;
+		for(int i=0;i<3;i++) FSPV_STEADY[i]=FSPV[i];
+	}
 	//accepting new integration step size at 'events'
 	int_step=int_step_new;
+	//taking the cruise step in steady flight
+	if(cruise_step>0&&cruise_time>0&&cruise_time>=cruise_dwell)
+	{
+		//starting on the time grid of 'cruise_step', so that the output times remain on the steps
+		grid=(sim_time/cruise_step-floor(sim_time/cruise_step+0.5))*cruise_step;
+		if(fabs(grid)<int_step_new/2)
+		{
+			int_step=cruise_step;
+			mcruise=1;
+		}
+	}
 	//changing the step size of all outputs by 'out_step_fact' at 'events'
 	out_fact=out_step_fact;
 	//-------------------------------------------------------------------------
 	//Newtonian gravitational acceleration
-	grav=G*EARTH_MASS/pow((REARTH+alt),2);
+	dbi=REARTH+alt;
+	grav=G*EARTH_MASS/(dbi*dbi);
 
 	//ISO 62 standard atmosphere
 	if(alt<11000.0)
@@ -134,7 +185,11 @@ void Round3::environment(double sim_time,double event_time,double &int_step,doub
 	round3[12].gets(rho);
 	round3[13].gets(pdynmc);
 	round3[14].gets(mach);
+	//saving variables
+	round3[8].gets(cruise_time);
+	round3[9].gets_vec(FSPV_STEADY);
 	//diagnostics
+	round3[7].gets(mcruise);
 	round3[15].gets(vsound);
 }
 
@@ -281,17 +336,19 @@ void Round3::newton(double int_step)
 	//local variables
 	double lon(0);
 	double lat(0);
-	Matrix SBIE(3,1);
-	Matrix TEMP(3,1);
-	Matrix VBEI(3,1);
-	Matrix GRAV(3,1);
-	Matrix ABII_NEW(3,1);
-	Matrix VBII_NEW(3,1);
-	Matrix POLAR(3,1);
-	Matrix VBEG_NEW(3,1);
-	Matrix TEI(3,3);
-	Matrix TGI(3,3);
-	Matrix TEG(3,3);
+	double SBIE[3];
+	double TEMP[3];
+	double GRAV[3]={0,0,0};
+	double FSPG[3];
+	double FSPGI[3];
+	double ABII_NEW[3];
+	double VBII_NEW[3];
+	double VBEI[3];
+	double VBEG_NEW[3];
+	double POLAR[3];
+	double TEI[9];
+	double TGI[9];
+	double TVG[9];
 
 	//localized module-variables
 	double dvbe(0);
@@ -303,75 +360,83 @@ void Round3::newton(double int_step)
 	double psivgx(0);
 	double thtvgx(0);
 	double altx(0);
-	Matrix TVG(3,3);
-	Matrix TGE(3,3);
+	double TGE[9];
 	
 	//localizing module-variables
 	//input from initialization
-	Matrix WEII=round3[27].mat();
+	double WEII[9]; round3[27].mat(WEII);
 	//state variables
-	Matrix SBEG=round3[31].vec();
-	Matrix VBEG=round3[32].vec();
-	Matrix SBII=round3[35].vec();
-	Matrix VBII=round3[36].vec();
-	Matrix ABII=round3[37].vec();
+	double SBEG[3]; round3[31].vec(SBEG);
+	double VBEG[3]; round3[32].vec(VBEG);
+	double SBII[3]; round3[35].vec(SBII);
+	double VBII[3]; round3[36].vec(VBII);
+	double ABII[3]; round3[37].vec(ABII);
 	//restore saved values
-	Matrix TGV=round3[22].mat();
-	Matrix TIG=round3[23].mat();
+	double TGV[9]; round3[22].mat(TGV);
+	double TIG[9]; round3[23].mat(TIG);
 	//input from other modules
 	double time=round3[0].real();
-	Matrix FSPV=round3[10].vec();
+	double FSPV[3]; round3[10].vec(FSPV);
 	double grav=round3[11].real();
 	//-------------------------------------------------------------------------
 	//building gravitational vector in geographic coordinates
-	GRAV.assign_loc(2,0,grav);
+	GRAV[2]=grav;
 
 	//integrating inertial state variables
-	ABII_NEW=TIG*((TGV*FSPV)+GRAV);
-	VBII_NEW=integrate(ABII_NEW,ABII,VBII,int_step);
-	SBII=integrate(VBII_NEW,VBII,SBII,int_step);
-	ABII=ABII_NEW;
-	VBII=VBII_NEW;
+	mat3vec(FSPG,TGV,FSPV);
+	for(int i=0;i<3;i++) FSPGI[i]=FSPG[i]+GRAV[i];
+	mat3vec(ABII_NEW,TIG,FSPGI);
+	for(int i=0;i<3;i++){
+		VBII_NEW[i]=integrate(ABII_NEW[i],ABII[i],VBII[i],int_step);
+		SBII[i]=integrate(VBII_NEW[i],VBII[i],SBII[i],int_step);
+		ABII[i]=ABII_NEW[i];
+		VBII[i]=VBII_NEW[i];
+	}
 
 	//inertial position in earth coordinates
-	TEI=cadtei(time);
-	SBIE=TEI*SBII;
+	//(the Earth rotation 'TEI' is formed once and also serves 'TGI' below)
+	cadtei(TEI,time);
+	mat3vec(SBIE,TEI,SBII);
 
 	//getting lon, lat and alt
-	TEMP=cadsph(SBIE);
-	lon=TEMP.get_loc(0,0);
-	lat=TEMP.get_loc(1,0);
-	alt=TEMP.get_loc(2,0);
+	cadsph(TEMP,SBIE);
+	lon=TEMP[0];
+	lat=TEMP[1];
+	alt=TEMP[2];
 	lonx=lon*DEG;
 	latx=lat*DEG;
 	altx=alt/1000;
 	
 	//calculating TM of geographic wrt earth coordinates
-	TGE=cadtge(lon,lat);
+	cadtge(TGE,lon,lat);
 
 	//calculating TM of geographic wrt inertial coordinates
-	TGI=TGE*TEI;
+	mat3mat(TGI,TGE,TEI);
 
 	//calculating geographic velocity VBEG=TGI*(VBII-(WEII*SBII));
-	VBEG_NEW=TGI*(VBII-(WEII*SBII));
+	mat3vec(TEMP,WEII,SBII);
+	for(int i=0;i<3;i++) VBEI[i]=VBII[i]-TEMP[i];
+	mat3vec(VBEG_NEW,TGI,VBEI);
 
 	//and integrating to obtain geographic displacement wrt initial launch point E
 	//(SBEG should only be used for diagnostics!)
-	SBEG=integrate(VBEG_NEW,VBEG,SBEG,int_step);
-	VBEG=VBEG_NEW;
+	for(int i=0;i<3;i++){
+		SBEG[i]=integrate(VBEG_NEW[i],VBEG[i],SBEG[i],int_step);
+		VBEG[i]=VBEG_NEW[i];
+	}
 
 	//getting speed, heading and flight path angle
-	POLAR=VBEG.pol_from_cart();		
-	dvbe=POLAR.get_loc(0,0);
-	psivg=POLAR.get_loc(1,0);
-	thtvg=POLAR.get_loc(2,0);
+	pol_from_cart(POLAR,VBEG);
+	dvbe=POLAR[0];
+	psivg=POLAR[1];
+	thtvg=POLAR[2];
 	psivgx=psivg*DEG;
 	thtvgx=thtvg*DEG;
 
 	//preparing TMs for output
-	TIG=TGI.trans();
-	TVG=mat2tr(psivg,thtvg);
-	TGV=TVG.trans();
+	mat3trans(TIG,TGI);
+	mat2tr(TVG,psivg,thtvg);
+	mat3trans(TGV,TVG);
 	//-------------------------------------------------------------------------
 	//loading module-variables
 	//state variables
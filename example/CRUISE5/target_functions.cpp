@@ -175,6 +175,33 @@ void Target::com_index_arrays()
 			l++;
 		}
 	}
+
+	//loading the definitions into 'com_target3' once and compiling its output plan
+	int column(0);
+	ncom_plan=0;
+	for(i=0;i<round3_com_count;i++)
+	{
+		com_target3[ncom_plan]=round3[round3_com_ind[i]];
+		com_plan[ncom_plan]=com_target3[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	for(i=0;i<target_com_count;i++)
+	{
+		com_target3[ncom_plan]=target[target_com_ind[i]];
+		com_plan[ncom_plan]=com_target3[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	dense_rates(com_plan,round3_com_ind,round3_com_count);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Recording the 'combus' output plan at the end of the integration step
+// for dense output by 'traj_data()'
+///////////////////////////////////////////////////////////////////////////////
+
+void Target::record_output()
+{
+	for(int i=0;i<ncom_plan;i++)
+		com_plan[i].record();
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Initializing loading 'packet' of target
@@ -203,17 +230,18 @@ Packet Target::loading_packet_init(int num_cruise,int num_target,int num_satelli
 	for(i=0;i<round3_com_count;i++)
 	{
 		index=round3_com_ind[i];
-		com_target3[i]=round3[index];
+		com_target3[i].restore(round3[index]);
 	}
 	for(j=0;j<target_com_count;j++)
 	{
 		index=target_com_ind[j];
-		com_target3[i+j]=target[index];
+		com_target3[i+j].restore(target[index]);
 	}
 	//refreshing the packet
 	packet.set_id(id);
 	packet.set_status(1);
 	packet.set_data(com_target3);
+	packet.set_plan(com_plan);
 	packet.set_ndata(ncom_target3);
 
 	return packet;
@@ -236,12 +264,12 @@ Packet Target::loading_packet(int num_cruise,int num_target,int num_satellite)
 	for(i=0;i<round3_com_count;i++)
 	{
 		index=round3_com_ind[i];
-		com_target3[i]=round3[index];
+		com_target3[i].restore(round3[index]);
 	}
 	for(j=0;j<target_com_count;j++)
 	{
 		index=target_com_ind[j];
-		com_target3[i+j]=target[index];
+		com_target3[i+j].restore(target[index]);
 	}
 	//refreshing the packet
 	packet.set_data(com_target3);
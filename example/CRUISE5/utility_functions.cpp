@@ -12,7 +12,10 @@
 //	cadine
 //	sign
 //	angle
+//Closest point of approach
+//Fixed-size 3x1 and 3x3 utility functions
 //Table look-up,'Table' and 'Datadeck' class member functions
+//Satellite visibility service, 'Visibility' class member functions
 //Integration
 //US76 Atmosphere
 //
@@ -1317,6 +1320,244 @@ double angle(Matrix VEC1,Matrix VEC2)
 
 	return acos(argument);
 }
+///////////////////////////////////////////////////////////////////////////////
+////////////////////////// Closest point of approach //////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//Returns the time of closest approach of two points within an integration step
+//
+//The relative position and velocity are known at the beginning (SREL0,VREL0)
+// and at the end (SREL1,VREL1) of the step 'step'. A cubic Hermite polynomial
+// joins them; the closest approach is the root of SREL^VREL=0 in the step,
+// obtained by Newton iterations safeguarded by bisection
+//
+//Parameter output: MISS(3x1) = relative position at closest approach
+//Example: tau=closest_approach(MISS,SBTLM,VBTLM,SBTL,VBTL,time-time_m);
+///////////////////////////////////////////////////////////////////////////////
+double closest_approach(Matrix &MISS,Matrix SREL0,Matrix VREL0,Matrix SREL1,Matrix VREL1
+						,const double &step)
+{
+	double A[3],B[3],C[3],D[3];
+	double S[3],SD[3];
+	double x(0);
+	double lo(0);
+	double hi(1);
+	int i(0);
+
+	double *s0=SREL0.get_pbody();
+	double *v0=VREL0.get_pbody();
+	double *s1=SREL1.get_pbody();
+	double *v1=VREL1.get_pbody();
+
+	//polynomial SREL(x)=A+B*x+C*x^2+D*x^3 with x=t/step in [0,1]
+	for(i=0;i<3;i++)
+	{
+		A[i]=s0[i];
+		B[i]=v0[i]*step;
+		C[i]=3*(s1[i]-s0[i])-2*B[i]-v1[i]*step;
+		D[i]=2*(s0[i]-s1[i])+B[i]+v1[i]*step;
+	}
+	double g0=A[0]*B[0]+A[1]*B[1]+A[2]*B[2];
+	double g1=(s1[0]*v1[0]+s1[1]*v1[1]+s1[2]*v1[2])*step;
+
+	if(g0>=0) x=0;
+	else if(g1<=0) x=1;
+	else
+	{
+		//starting from the closest approach of the straight line
+		double dss(0),sds(0);
+		for(i=0;i<3;i++)
+		{
+			dss+=(s1[i]-s0[i])*(s1[i]-s0[i]);
+			sds+=s0[i]*(s1[i]-s0[i]);
+		}
+		x=0.5;
+		if(dss>0) x=-sds/dss;
+		if(x<=lo||x>=hi) x=0.5;
+
+		for(int iter=0;iter<50;iter++)
+		{
+			double g(0),dg(0);
+			for(i=0;i<3;i++)
+			{
+				S[i]=A[i]+x*(B[i]+x*(C[i]+x*D[i]));
+				SD[i]=B[i]+x*(2*C[i]+x*3*D[i]);
+				g+=S[i]*SD[i];
+				dg+=SD[i]*SD[i]+S[i]*(2*C[i]+6*D[i]*x);
+			}
+			if(g<0) lo=x;
+			else hi=x;
+
+			double x_new=(lo+hi)/2;
+			if(dg>0)
+			{
+				x_new=x-g/dg;
+				if(x_new<=lo||x_new>=hi) x_new=(lo+hi)/2;
+			}
+			if(fabs(x_new-x)<EPS) {x=x_new;break;}
+			x=x_new;
+		}
+	}
+	for(i=0;i<3;i++)
+		MISS.assign_loc(i,0,A[i]+x*(B[i]+x*(C[i]+x*D[i])));
+
+	return x*step;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+////////////////// Fixed-size 3x1 and 3x3 utility functions //////////////////
+///////////////////////////////////////////////////////////////////////////////
+//Operate on 'double' arrays of 3 (vectors) and 9 (matrices, row by row)
+//without heap allocation. The arithmetic follows the 'Matrix' functions
+//term by term, so the results are identical
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+//Multiplies 3x3 matrix with 3x1 vector
+//'RESULT' must not be the same array as 'VEC'
+//Example: mat3vec(VBII,TIG,VBEG); (VBII=TIG*VBEG)
+///////////////////////////////////////////////////////////////////////////////
+void mat3vec(double *RESULT,double *AMAT,double *VEC)
+{
+	for(int i=0;i<3;i++){
+		RESULT[i]=0;
+		for(int k=0;k<3;k++)
+			RESULT[i]+=AMAT[3*i+k]*VEC[k];
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Multiplies two 3x3 matrices
+//'RESULT' must not be the same array as 'AMAT' or 'BMAT'
+//Example: mat3mat(TGI,TGE,TEI); (TGI=TGE*TEI)
+///////////////////////////////////////////////////////////////////////////////
+void mat3mat(double *RESULT,double *AMAT,double *BMAT)
+{
+	for(int i=0;i<9;i++){
+		int r=i/3;
+		int c=i%3;
+		RESULT[i]=0;
+		for(int k=0;k<3;k++)
+			RESULT[i]+=AMAT[3*r+k]*BMAT[3*k+c];
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Transposes 3x3 matrix
+//'RESULT' must not be the same array as 'AMAT'
+//Example: mat3trans(TIG,TGI);
+///////////////////////////////////////////////////////////////////////////////
+void mat3trans(double *RESULT,double *AMAT)
+{
+	for(int r=0;r<3;r++)
+		for(int c=0;c<3;c++)
+			RESULT[3*c+r]=AMAT[3*r+c];
+}
+///////////////////////////////////////////////////////////////////////////////
+//Returns polar from cartesian coordinates of 3x1 vector
+//POLAR = [magnitude, azimuth, elevation]
+//Example: pol_from_cart(POLAR,VBEG);
+///////////////////////////////////////////////////////////////////////////////
+void pol_from_cart(double *POLAR,double *VEC)
+{
+	double elevation=0.0;
+	double v1=VEC[0];
+	double v2=VEC[1];
+	double v3=VEC[2];
+
+	double d=sqrt(v1*v1+v2*v2+v3*v3);
+	double azimuth=atan2(v2,v1);
+
+	double denom=sqrt(v1*v1+v2*v2);
+	if(denom>0.)
+		elevation=atan2(-v3,denom);
+	else{
+		if(v3>0) elevation=-PI/2.;
+		if(v3<0) elevation=PI/2.;
+		if(v3==0) elevation=0.;
+	}
+	POLAR[0]=d;
+	POLAR[1]=azimuth;
+	POLAR[2]=elevation;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Returns the T.M. of the psivg -> thtvg sequence
+//Example: mat2tr(TVG,psivg,thtvg);
+///////////////////////////////////////////////////////////////////////////////
+void mat2tr(double *AMAT,double psivg,double thtvg)
+{
+	AMAT[2]=-sin(thtvg);
+	AMAT[3]=-sin(psivg);
+	AMAT[4]=cos(psivg);
+	AMAT[8]=cos(thtvg);
+	AMAT[0]=AMAT[8]*AMAT[4];
+	AMAT[1]=-AMAT[8]*AMAT[3];
+	AMAT[6]=-AMAT[2]*AMAT[4];
+	AMAT[7]=AMAT[2]*AMAT[3];
+	AMAT[5]=0.0;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Returns the T.M. of geographic wrt earth coordinates
+//Example: cadtge(TGE,lon,lat);
+///////////////////////////////////////////////////////////////////////////////
+void cadtge(double *AMAT,double lon,double lat)
+{
+	double clon=cos(lon);
+	double slon=sin(lon);
+	double clat=cos(lat);
+	double slat=sin(lat);
+
+	AMAT[0]=-slat*clon;
+	AMAT[1]=-slat*slon;
+	AMAT[2]=clat;
+	AMAT[3]=-slon;
+	AMAT[4]=clon;
+	AMAT[5]=0.0;
+	AMAT[6]=-clat*clon;
+	AMAT[7]=-clat*slon;
+	AMAT[8]=-slat;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Returns the T.M. of earth wrt inertial coordinates
+//Example: cadtei(TEI,time);
+///////////////////////////////////////////////////////////////////////////////
+void cadtei(double *TEI,double simulation_time)
+{
+	double xi=WEII3*simulation_time;
+	double sxi=sin(xi);
+	double cxi=cos(xi);
+
+	TEI[0]=cxi;  TEI[1]=sxi; TEI[2]=0;
+	TEI[3]=-sxi; TEI[4]=cxi; TEI[5]=0;
+	TEI[6]=0;    TEI[7]=0;   TEI[8]=1;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Returns lon, lat, alt from inertial displacement vector
+//Example: cadsph(LLA,SBIE);
+///////////////////////////////////////////////////////////////////////////////
+void cadsph(double *RESULT,double *SBIE)
+{
+	double alamda(0);
+	double x=SBIE[0];
+	double y=SBIE[1];
+	double z=SBIE[2];
+
+	//latitude and altitude
+	double dbi=sqrt(x*x+y*y+z*z);
+	double lat=asin((z)/dbi);
+	double alt=dbi-REARTH;
+
+	//longitude, resolving the multi-valued arcsin function
+	double dum4=asin(y/sqrt(x*x+y*y));
+	if((x>=0)&&(y>=0)) alamda=dum4;				//quadrant I
+	if((x<0)&&(y>=0)) alamda=180*RAD-dum4;		//quadrant II
+	if((x<0)&&(y<0)) alamda=180*RAD-dum4;		//quadrant III
+	if((x>=0)&&(y<0)) alamda=360*RAD+dum4;		//quadrant IV
+	double lon=alamda;
+	if(lon>180*RAD) lon= -(360*RAD-lon);		//east positive, west negative
+
+	RESULT[0]=lon;
+	RESULT[1]=lat;
+	RESULT[2]=alt;
+}
+
 
 ///////////////////////////////////////////////////////////////////////////////
 //////////////// Table look-up and interpolation functions ////////////////////
@@ -1596,6 +1837,171 @@ double Datadeck::interpolate(int ind10,int ind11,int ind20,int ind21,int ind30,i
 	return dumx2*(y22-y21)+y21;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//////////////////// Satellite visibility service /////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+//Constructor of 'Visibility'; arrays are allocated when 'combus' is located
+///////////////////////////////////////////////////////////////////////////////
+Visibility::Visibility()
+{
+	nsat=-1;
+	ntgt=0;
+	sat_slot=NULL;tgt_slot=NULL;
+	ssx=NULL;ssy=NULL;ssz=NULL;sdsi=NULL;scg=NULL;srate=NULL;
+	stx=NULL;sty=NULL;stz=NULL;sdti=NULL;
+	clear=NULL;expiry=NULL;work=NULL;
+	trate=0;
+	radius=0;
+	targets_fresh=false;
+	nrefresh=0;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Destructor of 'Visibility'
+///////////////////////////////////////////////////////////////////////////////
+Visibility::~Visibility()
+{
+	delete [] sat_slot;delete [] tgt_slot;
+	delete [] ssx;delete [] ssy;delete [] ssz;delete [] sdsi;delete [] scg;delete [] srate;
+	delete [] stx;delete [] sty;delete [] stz;delete [] sdti;
+	delete [] clear;delete [] expiry;delete [] work;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Loading the target positions and the bound of their angular rate
+//
+//The inertial speed is bounded by the geographic speed 'dvbe' (data[5])
+// plus the earth's rotation at the target's distance
+///////////////////////////////////////////////////////////////////////////////
+void Visibility::load_targets(Packet *combus)
+{
+	trate=0;
+	for(int j=0;j<ntgt;j++)
+	{
+		Variable *data_t=combus[tgt_slot[j]].get_data();
+		Matrix STII=data_t[10].vec();
+		stx[j]=STII[0];
+		sty[j]=STII[1];
+		stz[j]=STII[2];
+		sdti[j]=sqrt(stx[j]*stx[j]+sty[j]*sty[j]+stz[j]*stz[j]);
+		double rate=sdti[j]>SMALL?fabs(data_t[5].real())/sdti[j]+WEII3:BIG;
+		if(rate>trate) trate=rate;
+	}
+	targets_fresh=true;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Locating satellites and targets on 'combus' (once) and refreshing the
+// satellite-target rows whose windows have expired at 'time'
+//
+//The satellite positions are loaded every call (they are needed by 'vehicle()');
+// the target positions only if a row is recomputed.
+//A row is valid while no separation angle can reach the grazing angle:
+// window = (smallest |cos(sep)-cos(graze)|)/(satellite rate + target rate
+// + grazing-angle rate), since |d acos| >= |d cos|
+///////////////////////////////////////////////////////////////////////////////
+void Visibility::update(Packet *combus,int num_vehicles,double radius,double time)
+{
+	//locating the satellites and targets once, in 'combus' order
+	if(nsat<0)
+	{
+		nsat=0;
+		for(int i=0;i<num_vehicles;i++){
+			string id=combus[i].get_id();
+			if(!id.find("s")) nsat++;
+			if(!id.find("t")) ntgt++;
+		}
+		int ns=nsat>0?nsat:1;
+		int nt=ntgt>0?ntgt:1;
+		try{
+			sat_slot=new int[ns];tgt_slot=new int[nt];
+			ssx=new double[ns];ssy=new double[ns];ssz=new double[ns];
+			sdsi=new double[ns];scg=new double[ns];srate=new double[ns];
+			stx=new double[nt];sty=new double[nt];stz=new double[nt];sdti=new double[nt];
+			clear=new int[ns*nt];expiry=new double[ns];work=new double[nt];
+		}
+		catch(bad_alloc xa){cerr<<"*** Allocation failure of 'Visibility' *** \n";system("pause");exit(1);}
+		int k(0),j(0);
+		for(int i=0;i<num_vehicles;i++){
+			string id=combus[i].get_id();
+			if(!id.find("s")) sat_slot[k++]=i;
+			if(!id.find("t")) tgt_slot[j++]=i;
+		}
+		for(k=0;k<ns;k++) expiry[k]=-BIG;
+	}
+	//a changed occulting radius invalidates all rows
+	if(radius!=this->radius){
+		this->radius=radius;
+		for(int k=0;k<nsat;k++) expiry[k]=-BIG;
+	}
+	targets_fresh=false;
+
+	for(int k=0;k<nsat;k++)
+	{
+		Variable *data_s=combus[sat_slot[k]].get_data();
+		Matrix SSII=data_s[10].vec();
+		ssx[k]=SSII[0];
+		ssy[k]=SSII[1];
+		ssz[k]=SSII[2];
+		double dsi=sqrt(ssx[k]*ssx[k]+ssy[k]*ssy[k]+ssz[k]*ssz[k]);
+		sdsi[k]=dsi;
+		scg[k]=dsi>SMALL?radius/dsi:BIG;
+		//inertial speed bound, angular rate and rate of the grazing angle
+		double vin=fabs(data_s[5].real())+WEII3*dsi;
+		double graze_rate=BIG;
+		if(dsi>radius) graze_rate=radius*vin/(dsi*sqrt(dsi*dsi-radius*radius));
+		srate[k]=dsi>SMALL?vin/dsi+graze_rate:BIG;
+
+		if(time<expiry[k]) continue;
+
+		//recomputing the row of satellite 'k' against all targets
+		if(!targets_fresh) load_targets(combus);
+		nrefresh++;
+		double sx=ssx[k],sy=ssy[k],sz=ssz[k];
+		double cg=scg[k];
+		//cosine of the separation angle; one pass over the target arrays
+		for(int j=0;j<ntgt;j++)
+			work[j]=(sx*stx[j]+sy*sty[j]+sz*stz[j])/(dsi*sdti[j]);
+		double margin=BIG;
+		int *row=clear+k*ntgt;
+		for(int j=0;j<ntgt;j++){
+			row[j]=work[j]>cg;
+			double dum=fabs(work[j]-cg);
+			if(dum<margin) margin=dum;
+		}
+		expiry[k]=time+margin/(srate[k]+trate);
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Satellites seen from the vehicle at 'SBII' and seeing the first target,
+// stored in 'visibility[nsat]' in 'combus' order
+//
+//A satellite is seen if the separation angle is less than its grazing angle,
+// or else if the vehicle flies above the critical radius
+// 'radius/cos(separation-grazing)'
+///////////////////////////////////////////////////////////////////////////////
+void Visibility::vehicle(Targeting *visibility,Matrix SBII)
+{
+	double bx=SBII[0],by=SBII[1],bz=SBII[2];
+	double dbi=sqrt(bx*bx+by*by+bz*bz);
+
+	for(int k=0;k<nsat;k++)
+	{
+		double cosa=(bx*ssx[k]+by*ssy[k]+bz*ssz[k])/(dbi*sdsi[k]);
+		int seen=cosa>scg[k];
+		if(!seen&&scg[k]<1)
+		{
+			//critical radius for the vehicle to clear the horizon
+			if(cosa>1.) cosa=1.;
+			if(cosa<-1.) cosa=-1.;
+			double dum=cos(acos(cosa)-acos(scg[k]));
+			if(fabs(dum)>EPS) seen=dbi>radius/dum;
+		}
+		//satellite must also see the first target
+		if(ntgt>0&&!clear[k*ntgt]) seen=0;
+		visibility[k].tracking=seen;
+		visibility[k].vehicle_slot=sat_slot[k];
+	}
+}
 ///////////////////////////////////////////////////////////////////////////////
 ////////////////////  Integration functions  //////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
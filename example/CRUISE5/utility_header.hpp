@@ -12,6 +12,7 @@
 //	cadine
 //	sign
 //	angle
+//Fixed-size 3x1 and 3x3 utility functions
 //Table look-up, classes 'Table' and 'Datadeck'
 //Integration
 //US76 Atmosphere
@@ -322,6 +323,42 @@ int sign(const double &variable);
 //Example: theta=angle(VEC1,VEC2);
 double angle(Matrix VEC1,Matrix VEC2);
 
+//Returns the time of closest approach within an integration step and the
+// relative position MISS at that time (cubic Hermite relative trajectory)
+//Example: tau=closest_approach(MISS,SBTLM,VBTLM,SBTL,VBTL,time-time_m);
+double closest_approach(Matrix &MISS,Matrix SREL0,Matrix VREL0,Matrix SREL1,Matrix VREL1
+						,const double &step);
+
+///////////////////////////////////////////////////////////////////////////////
+////////////////// Fixed-size 3x1 and 3x3 utility functions //////////////////
+///////////////////////////////////////////////////////////////////////////////
+//'double' arrays of 3 (vectors) and 9 (matrices, row by row), no heap allocation
+//Results are identical to the corresponding 'Matrix' functions
+
+//Multiplies 3x3 matrix with 3x1 vector: RESULT=AMAT*VEC
+void mat3vec(double *RESULT,double *AMAT,double *VEC);
+
+//Multiplies two 3x3 matrices: RESULT=AMAT*BMAT
+void mat3mat(double *RESULT,double *AMAT,double *BMAT);
+
+//Transposes 3x3 matrix: RESULT=AMAT'
+void mat3trans(double *RESULT,double *AMAT);
+
+//Returns polar from cartesian coordinates: POLAR=[magnitude,azimuth,elevation]
+void pol_from_cart(double *POLAR,double *VEC);
+
+//Returns the T.M. of the psivg -> thtvg sequence
+void mat2tr(double *AMAT,double psivg,double thtvg);
+
+//Returns the T.M. of geographic wrt earth coordinates
+void cadtge(double *AMAT,double lon,double lat);
+
+//Returns the T.M. of earth wrt inertial coordinates 
+void cadtei(double *TEI,double simulation_time);
+
+//Returns lon, lat, alt from inertial displacement vector
+void cadsph(double *RESULT,double *SBIE);
+
 ///////////////////////////////////////////////////////////////////////////////
 ////////// Table look-up and interpolation function declarations //////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -124,6 +124,11 @@ Plane::Plane(Module *module_list,int num_modules)
 	flat6_com_ind=new int[flat6_com_count];
 	plane_com_ind=new int[plane_com_count];
 
+	//allocating memory for the output plans
+	scrn_plan=new Output[flat6_scrn_count+plane_scrn_count];
+	plot_plan=new Output[flat6_plot_count+plane_plot_count];
+	com_plan=new Output[flat6_com_count+plane_com_count];
+
 	//allocating memory to each event object in event object list
 	for (i=0;i<NEVENT;i++)
 		event_ptr_list[i]=new Event;
@@ -151,6 +156,47 @@ Plane::Plane(Module *module_list,int num_modules)
 	com_index_arrays();
 }
 ///////////////////////////////////////////////////////////////////////////////
+//Copy constructor creating a clone for the derivative passes of 'linearize()'
+//Copies the module-variable arrays 'flat6' and 'plane' and shares the tables of
+// the data decks. The clone has no output arrays and no events; it is never
+// written to screen or files
+///////////////////////////////////////////////////////////////////////////////
+
+Plane::Plane(Plane &plane_orig):aerotable(plane_orig.aerotable),proptable(plane_orig.proptable),
+	gaintable(plane_orig.gaintable),linear(plane_orig.linear)
+{
+	int i(0);
+	//creating module-variable array ('flat6' is created by 'Flat6()')
+	plane=new Variable[NPLANE];
+	if(plane==0){cerr<<"*** Error: plane[] allocation failed ***\n";system("pause");exit(1);}
+
+	set_name(plane_orig.get_vname());
+	strcpy(plane6_name,plane_orig.plane6_name);
+	event_epoch=false;
+	table=NULL;
+
+	//no output arrays and no events
+	plane6=NULL;nplane6=0;
+	scrn_plane6=NULL;nscrn_plane6=0;
+	plot_plane6=NULL;nplot_plane6=0;
+	com_plane6=NULL;ncom_plane6=0;
+	flat6_scrn_ind=NULL;flat6_scrn_count=0;
+	plane_scrn_ind=NULL;plane_scrn_count=0;
+	flat6_plot_ind=NULL;flat6_plot_count=0;
+	plane_plot_ind=NULL;plane_plot_count=0;
+	flat6_com_ind=NULL;flat6_com_count=0;
+	plane_com_ind=NULL;plane_com_count=0;
+	scrn_plan=NULL;nscrn_plan=0;
+	plot_plan=NULL;nplot_plan=0;
+	com_plan=NULL;ncom_plan=0;
+	for(i=0;i<NEVENT;i++) event_ptr_list[i]=NULL;
+	nevent=0;
+	event_total=0;
+
+	//copying the module-variables
+	linear_copy(plane_orig);
+}
+///////////////////////////////////////////////////////////////////////////////
 //Destructor deallocating dynamic memory
 //				  
 //010115 Created by Peter H Zipfel
@@ -167,10 +213,14 @@ Plane::~Plane()
 	delete [] com_plane6;
 	delete [] flat6_scrn_ind;
 	delete [] plane_scrn_ind;
+	delete [] flat6_plot_ind;
 	delete [] plane_plot_ind;
 	delete [] flat6_com_ind;
 	delete [] plane_com_ind;
-	delete [] &event_ptr_list;
+	delete [] scrn_plan;
+	delete [] plot_plan;
+	delete [] com_plan;
+	for(int i=0;i<NEVENT;i++) delete event_ptr_list[i];
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -80,6 +80,8 @@ public:
 	virtual void com_index_arrays()=0;
 	virtual Packet loading_packet_init(int num_plane)=0;
 	virtual Packet loading_packet(int num_plane)=0;
+	virtual void linearize(Module *module_list,int num_modules,double sim_time,double int_step,char *title)=0;
+	virtual void trim(Module *module_list,int num_modules)=0;
 
 	//module functions -MOD
 	virtual void def_environment()=0;
@@ -157,6 +159,8 @@ public:
 	virtual void com_index_arrays()=0;
 	virtual Packet loading_packet_init(int num_plane)=0;
 	virtual Packet loading_packet(int num_plane)=0;
+	virtual void linearize(Module *module_list,int num_modules,double sim_time,double int_step,char *title)=0;
+	virtual void trim(Module *module_list,int num_modules)=0;
 
 	//module functions -MOD
 	virtual void def_aerodynamics()=0;
@@ -248,16 +252,29 @@ protected:
 	//be written to 'combus' 'packets'
 	int *plane_com_ind; int plane_com_count;
 
+	//output plans compiled by the index arrays and executed by the writers
+	Output *scrn_plan; int nscrn_plan;
+	Output *plot_plan; int nplot_plan;
+	Output *com_plan; int ncom_plan;
+
 	//declaring Table pointer as temporary storage of a single table
 	Table *table;
 	//	declaring Datadeck 'aerotable' that stores all aero tables
 	Datadeck aerotable;
 	//	declaring Datadeck 'proptable' that stores all aero tables
 	Datadeck proptable;
+	//	declaring Datadeck 'gaintable' that stores the gamma control gain schedule
+	Datadeck gaintable;
+
+	//linearization request ('LINEARIZE' block of 'input.asc') and its output file
+	Linear linear;
+	ofstream flinear;
+	Trim trimming;
 
 public:
 	Plane(){};
 	Plane(Module *module_list,int num_modules);
+	Plane(Plane &plane_orig);
 	virtual~Plane();
 
 	//executive functions
@@ -280,6 +297,8 @@ public:
 	virtual void com_index_arrays();
 	virtual Packet loading_packet_init(int num_plane);
 	virtual Packet loading_packet(int num_plane);
+	virtual void linearize(Module *module_list,int num_modules,double sim_time,double int_step,char *title);
+	virtual void trim(Module *module_list,int num_modules);
 
 	//module functions -MOD
 	virtual void def_aerodynamics();
@@ -309,6 +328,15 @@ public:
 //f16c09_4 - end
 	double control_normal_accel(double ancomx,double int_step);
 	double control_gamma(double thtvlcomx);
+	void control_gamma_gains(Matrix &GAINGAM,double &gainff,double dla,double dlde,
+		double dma,double dmq,double dmde,double dvbe,double pgam,double wgam,double zgam);
+	double control_gamma_speed(double vmach,double pdynmc);
+	double control_gamma_trim(double alphax);
+	void control_gamma_plant(double &dla,double &dlde,double &dma,double &dmq,double &dmde,
+		double dvba,double alphax,double delex,double pdynmc);
+	void control_gamma_schedule();
+	void control_gamma_lookup(Matrix &GAINGAM,double &gainff,double vmach,double alphax,double pdynmc);
+	double control_gamma_error(Matrix GAINGAM,double gainff,Matrix GAINPP,double gainffpp);
 	double control_heading(double psivlcomx);
 	double control_altitude(double altcom);
 
@@ -316,6 +344,23 @@ public:
 	void control_rate();
 	void control_accel(double int_step);
 	Matrix guidance_line(Matrix SWBL,double psiflx,double thtflx);
+
+	//linearization functions
+	void linear_data(fstream &input);
+	void linear_element(char *name,char *kind,int &count,string *names,int *locs,int *comps);
+	Variable &linear_variable(int loc);
+	double linear_get(int loc,int comp);
+	void linear_put(int loc,int comp,double value);
+	void linear_copy(Plane &plane_orig);
+	void linear_pass(Module *module_list,int num_modules,double sim_time,string *hold,int nhold);
+	void linear_columns(int first,int stride,Module *module_list,int num_modules,double sim_time,
+		double *AB,double *CD);
+
+	//trim functions
+	void trim_data(fstream &input);
+	void trim_residuals(Plane &clone,Module *module_list,int num_modules,double *u,double *r);
+	void trim_jacobian(Plane &clone,Module *module_list,int num_modules,double *u,double *J);
+	bool trim_solve(double *J,double *r,double *du);
   };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -29,6 +29,11 @@
 //   			 mroll= 0 roll position control (default)
 //					    1 roll rate control
 //
+// Flight path angle control gains (mautp=4)
+//		mgain = 0 pole placement every integration step (default)
+//			  = 1 gains interpolated from the gain schedule 'gaintable'
+//			  = 2 scheduled gains, checked against pole placement every step
+//
 //030731 Created by Peter H Zipfel
 // /////////////////////////////////////////////////////////////////////////////
  
@@ -100,6 +105,10 @@ void Plane::def_control()
 	plane[565].init("zgam",0,"Damping of gamma close loop complex pole - rad/s","control","data","");
 	plane[566].init("GAINGAM",0,0,0,"Gamma fbck gain of q, theta and gamma","control","diag","");
 	plane[567].init("gainff",0,"Gamma feed-forward gain","control","diag","");
+	plane[568].init("mgain","int",0,"=0:Pole placement; =1:Gain schedule; =2:Schedule+check","control","data","");
+	plane[569].init("igain","int",0,"Flag set when gain schedule is built","control","init","");
+	plane[570].init("gainerr0",0,"Max gain schedule error at mid-cells (startup) - ND","control","diag","");
+	plane[571].init("gainerr",0,"Max error scheduled vs pole placement gains - ND","control","diag","");
 
 }
 ///////////////////////////////////////////////////////////////////////////////
@@ -544,13 +553,6 @@ double Plane::control_lateral_accel(double alcomx)
 
 double Plane::control_gamma(double thtvlcomx)
 {
-	//local variables
-	Matrix AA(3,3);
-	Matrix BB(3,1);
-	Matrix DP(3,3);
-	Matrix DD(3,1);
-	Matrix HH(3,1);
-
 	//local module-variables
 	Matrix GAINGAM(3,1);
 	double gainff=0;
@@ -560,10 +562,17 @@ double Plane::control_gamma(double thtvlcomx)
 	double pgam=plane[563].real();
 	double wgam=plane[564].real();
 	double zgam=plane[565].real();
+	int mgain=plane[568].integer();
+	//initialization
+	int igain=plane[569].integer();
+	//diagnostics
+	double gainerr=plane[571].real();
 	//input from other modules
 	double time=flat6[0].real();
+	double vmach=flat6[56].real();
 	double pdynmc=flat6[57].real();
 	double thtblx=flat6[138].real();
+	double alphax=flat6[144].real();
 	double qqx=flat6[161].real();
 	double thtvlx=flat6[241].real();
 	double dvbe=flat6[236].real();
@@ -576,7 +585,77 @@ double Plane::control_gamma(double thtvlcomx)
 
 	//prevent division by zero
 	if(dvbe==0)dvbe=dvbe;
-	
+
+	if(mgain==0){
+		//feedback and feed-forward gains from closed-loop pole placement
+		control_gamma_gains(GAINGAM,gainff,dla,dlde,dma,dmq,dmde,dvbe,pgam,wgam,zgam);
+	}
+	else{
+		//building the gain schedule on first call
+		if(!igain){
+			control_gamma_schedule();
+			igain=1;
+		}
+		//interpolating the gains at the present flight condition
+		control_gamma_lookup(GAINGAM,gainff,vmach,alphax,pdynmc);
+
+		//accuracy check against the pole placement gains
+		if(mgain==2){
+			Matrix GAINPP(3,1);
+			double gainffpp(0);
+			control_gamma_gains(GAINPP,gainffpp,dla,dlde,dma,dmq,dmde,dvbe,pgam,wgam,zgam);
+			double err=control_gamma_error(GAINGAM,gainff,GAINPP,gainffpp);
+			if(err>gainerr) gainerr=err;
+		}
+	}
+
+	//pitch control command
+	double thtc=gainff*thtvlcomx*RAD;
+	double qqf=GAINGAM[0]*qqx*RAD;
+	double thtblf=GAINGAM[1]*thtblx*RAD;
+	double thtvlf=GAINGAM[2]*thtvlx*RAD;
+	double delec=thtc-(qqf+thtblf+thtvlf);
+	double delecx=delec*DEG;
+
+	//--------------------------------------------------------------------------
+	//loading module-variables
+	//initialization
+	plane[569].gets(igain);
+	//diagnostics
+	plane[566].gets_vec(GAINGAM);
+	plane[567].gets(gainff);
+	plane[571].gets(gainerr);
+
+	return delecx;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Pole placement gains of the flight path angle controller
+//Solves for the three feedback gains that place the closed loop poles at the
+// conjugate complex pair 'wgam','zgam' and the real pole 'pgam', and for the
+// feed-forward gain that achieves unit steady-state gamma response
+//
+//Parameter output:
+//         GAINGAM = feedback gains of q, theta and gamma
+//         gainff = feed-forward gain
+//Parameter input:
+//         dla,dlde,dma,dmq,dmde = pitch plane dimensional derivatives
+//         dvbe = plane speed - m/s
+//         pgam,wgam,zgam = closed loop poles
+//
+//020614 Created by Peter H Zipfel 
+///////////////////////////////////////////////////////////////////////////////
+
+void Plane::control_gamma_gains(Matrix &GAINGAM,double &gainff,double dla,double dlde,
+							   double dma,double dmq,double dmde,double dvbe,
+							   double pgam,double wgam,double zgam)
+{
+	//local variables
+	Matrix AA(3,3);
+	Matrix BB(3,1);
+	Matrix DP(3,3);
+	Matrix DD(3,1);
+	Matrix HH(3,1);
+
 	//building fundamental matrices (body rate, acceleration, fin deflection)
 	AA.build_mat33(dmq,dma,-dma,1.,0.,0.,0.,dla/dvbe,-dla/dvbe);
 	BB.build_vec3(dmde,0.,dlde/dvbe);
@@ -606,22 +685,307 @@ double Plane::control_gamma(double thtvlcomx)
 	HH.build_vec3(0.,0.,1.);
 	double denom=HH^DUM3;
 	gainff=-1./denom;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Speed at a scheduling point
+//Mach and dynamic pressure fix the static pressure, press=pdynmc/(0.7*vmach^2);
+// the US76 atmosphere ('environment' module) is searched for that altitude
+//
+//Return output:
+//         dvba = speed - m/s
+//Parameter input:
+//         vmach = Mach number
+//         pdynmc = dynamic pressure - Pa
+///////////////////////////////////////////////////////////////////////////////
 
-	//pitch control command
-	double thtc=gainff*thtvlcomx*RAD;
-	double qqf=GAINGAM[0]*qqx*RAD;
-	double thtblf=GAINGAM[1]*thtblx*RAD;
-	double thtvlf=GAINGAM[2]*thtvlx*RAD;
-	double delec=thtc-(qqf+thtblf+thtvlf);
-	double delecx=delec*DEG;
+double Plane::control_gamma_speed(double vmach,double pdynmc)
+{
+	double press=pdynmc/(0.7*vmach*vmach);
+	double rho(0),pressa(0),tempk(0);
+	double alt0=0;
+	double alt1=84000;
+	for(int i=0;i<40;i++){
+		double alt=(alt0+alt1)/2;
+		atmosphere76(rho,pressa,tempk,alt);
+		if(pressa>press) alt0=alt;
+		else alt1=alt;
+	}
+	atmosphere76(rho,pressa,tempk,(alt0+alt1)/2);
 
-	//--------------------------------------------------------------------------
+	return sqrt(2*pdynmc/rho);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Trim elevator at a scheduling point
+//Zero pitching moment about the actual c.g. 'xcg' (zero pitch rate):
+// cm(delex,alphax)+(cz(alphax)-0.19*delex/25)*(xcgr-xcg)/refc=0
+// solved by bisection over the elevator range of the aero deck
+//
+//Return output:
+//         delex = trim elevator - deg
+//Parameter input:
+//         alphax = angle of attack - deg
+///////////////////////////////////////////////////////////////////////////////
+
+double Plane::control_gamma_trim(double alphax)
+{
+	//localizing module-variables
+	//input data
+	double xcg=plane[193].real();
+	double xcgr=plane[194].real();
+	//from initialization
+	double refc=plane[106].real();
+	//-------------------------------------------------------------------------
+	double cz=aerotable.look_up("cz_vs_alpha",alphax);
+	double dele0=-24;
+	double dele1=24;
+	double cmt0=aerotable.look_up("cm_vs_elev_alpha",dele0,alphax)+(cz-0.19*dele0/25)*(xcgr-xcg)/refc;
+	double cmt1=aerotable.look_up("cm_vs_elev_alpha",dele1,alphax)+(cz-0.19*dele1/25)*(xcgr-xcg)/refc;
+
+	//no trim within elevator range: take the elevator stop closest to trim
+	if(cmt0*cmt1>0){
+		if(fabs(cmt0)<fabs(cmt1)) return dele0;
+		else return dele1;
+	}
+	for(int i=0;i<40;i++){
+		double delex=(dele0+dele1)/2;
+		double cmt=aerotable.look_up("cm_vs_elev_alpha",delex,alphax)+(cz-0.19*delex/25)*(xcgr-xcg)/refc;
+		if(cmt*cmt0>0){
+			dele0=delex;
+			cmt0=cmt;
+		}
+		else
+			dele1=delex;
+	}
+	return (dele0+dele1)/2;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Pitch plane dimensional derivatives at a scheduling point
+//Same derivatives as 'aerodynamics_der', including the c.g. shift of 'cma'
+//
+//Parameter output:
+//         dla,dlde,dma,dmq,dmde = pitch plane dimensional derivatives
+//Parameter input:
+//         dvba = speed - m/s
+//         alphax = angle of attack - deg
+//         delex = elevator deflection - deg
+//         pdynmc = dynamic pressure - Pa
+///////////////////////////////////////////////////////////////////////////////
+
+void Plane::control_gamma_plant(double &dla,double &dlde,double &dma,double &dmq,double &dmde,
+							   double dvba,double alphax,double delex,double pdynmc)
+{
+	//localizing module-variables
+	//input data
+	double xcg=plane[193].real();
+	double xcgr=plane[194].real();
+	//from initialization
+	double refa=plane[104].real();
+	double refc=plane[106].real();
+	double vmass=plane[190].real();
+	Matrix IBBB=plane[191].mat();
+	//-------------------------------------------------------------------------
+	double czp=aerotable.look_up("cz_vs_alpha",alphax+1.5);
+	double czn=aerotable.look_up("cz_vs_alpha",alphax-1.5);
+	double cza=(czp-czn)/3;
+	double cla=-cza;
+	double clde=0.19/25;
+	double cmp=aerotable.look_up("cm_vs_elev_alpha",delex,alphax+1.5);
+	double cmn=aerotable.look_up("cm_vs_elev_alpha",delex,alphax-1.5);
+	double cma=(cmp-cmn)/3+cza*(xcgr-xcg)/refc;
+	cmp=aerotable.look_up("cm_vs_elev_alpha",delex+1.5,alphax);
+	cmn=aerotable.look_up("cm_vs_elev_alpha",delex-1.5,alphax);
+	double cmde=(cmp-cmn)/3;
+	double cmq=aerotable.look_up("cmq_vs_alpha",alphax);
+
+	double duml=(pdynmc*refa/vmass)/RAD;
+	dla=duml*cla;
+	dlde=duml*clde;
+	double dumm=pdynmc*refa*refc/IBBB.get_loc(1,1);
+	dma=dumm*cma/RAD;
+	dmq=dumm*(refc/(2.*dvba))*cmq;
+	dmde=dumm*cmde/RAD;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Building the gain schedule of the flight path angle controller
+//Sweeps the flight envelope in Mach, angle of attack and dynamic pressure,
+// designs the gains by pole placement at each point and stores them in
+// 'Datadeck gaintable' as 3DIM tables (gains q, theta, gamma feedback and
+// feed-forward in slots 0-3). The elevator is trimmed about the c.g. 'xcg'
+// at each alpha, so the schedule holds for the c.g. of this run.
+//The alpha breakpoints are those of the aero deck and their +-1.5 deg offsets,
+// where the central-difference derivatives have their kinks.
+//The gains fall off roughly with 1/pdynmc^2; the tables hold gain*pdynmc^2,
+// which is nearly linear between breakpoints.
+//
+//Accuracy check: at the center of every cell the interpolated gains are
+// compared with the pole placement design; the largest and the mean relative
+// error are displayed, the largest is stored in 'gainerr0'.
+///////////////////////////////////////////////////////////////////////////////
+
+void Plane::control_gamma_schedule()
+{
+	//local variables
+	double mach_tab[9]={0.2,0.3,0.4,0.5,0.6,0.7,0.8,0.9,1};
+	double alpha_tab[34]={-10,-8.5,-6.5,-5,-3.5,-1.5,0,1.5,3.5,5,6.5,8.5,10,11.5,13.5,15,16.5,18.5,20,21.5,23.5,25,26.5,28.5,30,31.5,33.5,35,36.5,38.5,40,41.5,43.5,45};
+	double pdynmc_tab[13]={1000,1400,2000,2800,4000,5600,8000,11000,16000,22000,31000,
+						   43000,60000};
+	int nmach(9),nalpha(34),npdynmc(13);
+	string gain_names[NGAIN]={"gainq","gaintht","gaingam","gainff"};
+	Matrix GAINGAM(3,1);
+	double gainff(0);
+	double dla(0),dlde(0),dma(0),dmq(0),dmde(0);
+
+	//local module-variables
+	double gainerr0(0);
+
+	//localizing module-variables
+	//input data
+	double pgam=plane[563].real();
+	double wgam=plane[564].real();
+	double zgam=plane[565].real();
+	double xcg=plane[193].real();
+	//-------------------------------------------------------------------------
+	//creating the table deck
+	gaintable.set_title("Flight path angle control gain schedule");
+	gaintable.set_capacity(NGAIN);
+	gaintable.alloc_mem();
+	for(int g=0;g<NGAIN;g++){
+		table=new Table;
+		table->set_dim(3);
+		table->set_name(gain_names[g]+"_vs_mach_alpha_pdynmc");
+		table->set_var1_dim(nmach);
+		table->set_var2_dim(nalpha);
+		table->set_var3_dim(npdynmc);
+		table->var1_values=new double [nmach];
+		table->var2_values=new double [nalpha];
+		table->var3_values=new double [npdynmc];
+		table->data=new double[nmach*nalpha*npdynmc];
+		for(int i=0;i<nmach;i++) table->set_var1_value(i,mach_tab[i]);
+		for(int j=0;j<nalpha;j++) table->set_var2_value(j,alpha_tab[j]);
+		for(int l=0;l<npdynmc;l++) table->set_var3_value(l,pdynmc_tab[l]);
+		gaintable.set_counter(g);
+		gaintable.add_table(*table);
+	}
+
+	//pole placement design at every breakpoint
+	for(int j=0;j<nalpha;j++){
+		double delex=control_gamma_trim(alpha_tab[j]);
+		for(int i=0;i<nmach;i++){
+			for(int l=0;l<npdynmc;l++){
+				double dvba=control_gamma_speed(mach_tab[i],pdynmc_tab[l]);
+				control_gamma_plant(dla,dlde,dma,dmq,dmde,dvba,alpha_tab[j],delex,pdynmc_tab[l]);
+				control_gamma_gains(GAINGAM,gainff,dla,dlde,dma,dmq,dmde,dvba,pgam,wgam,zgam);
+				int offset=i*nalpha*npdynmc+j*npdynmc+l;
+				double qsq=pdynmc_tab[l]*pdynmc_tab[l];
+				gaintable[0]->set_data(offset,GAINGAM[0]*qsq);
+				gaintable[1]->set_data(offset,GAINGAM[1]*qsq);
+				gaintable[2]->set_data(offset,GAINGAM[2]*qsq);
+				gaintable[3]->set_data(offset,gainff*qsq);
+			}
+		}
+	}
+
+	//accuracy check at the cell centers
+	Matrix GAINPP(3,1);
+	double gainffpp(0);
+	double errsum(0);
+	int ncell(0);
+	for(int j=0;j<nalpha-1;j++){
+		double alphax=(alpha_tab[j]+alpha_tab[j+1])/2;
+		double delex=control_gamma_trim(alphax);
+		for(int i=0;i<nmach-1;i++){
+			for(int l=0;l<npdynmc-1;l++){
+				double vmach=(mach_tab[i]+mach_tab[i+1])/2;
+				double pdynmc=(pdynmc_tab[l]+pdynmc_tab[l+1])/2;
+				double dvba=control_gamma_speed(vmach,pdynmc);
+				control_gamma_plant(dla,dlde,dma,dmq,dmde,dvba,alphax,delex,pdynmc);
+				control_gamma_gains(GAINPP,gainffpp,dla,dlde,dma,dmq,dmde,dvba,pgam,wgam,zgam);
+				control_gamma_lookup(GAINGAM,gainff,vmach,alphax,pdynmc);
+				double err=control_gamma_error(GAINGAM,gainff,GAINPP,gainffpp);
+				if(err>gainerr0) gainerr0=err;
+				errsum+=err;
+				ncell++;
+			}
+		}
+	}
+	cout<<" *** Gamma control gain schedule: "<<nmach*nalpha*npdynmc<<" designs over Mach "
+		<<mach_tab[0]<<"-"<<mach_tab[nmach-1]<<", alpha "<<alpha_tab[0]<<"-"<<alpha_tab[nalpha-1]
+		<<" deg, pdynmc "<<pdynmc_tab[0]<<"-"<<pdynmc_tab[npdynmc-1]<<" Pa, xcg "<<xcg<<" m ***\n";
+	cout<<"     Relative gain error at "<<ncell<<" mid-cells: max gainerr0 = "<<gainerr0
+		<<"  mean = "<<errsum/ncell<<'\n';
+	//-------------------------------------------------------------------------
 	//loading module-variables
 	//diagnostics
-	plane[566].gets_vec(GAINGAM);
-	plane[567].gets(gainff);
+	plane[570].gets(gainerr0);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Interpolating the flight path angle control gains from the gain schedule
+//The flight condition is held to the swept envelope (no extrapolation).
+//All tables share their breakpoints, so the table indices are found once and
+// the tables are interpolated by slot without the name search of 'look_up';
+// division by pdynmc^2 restores the gains.
+//
+//Parameter output:
+//         GAINGAM = feedback gains of q, theta and gamma
+//         gainff = feed-forward gain
+//Parameter input:
+//         vmach = Mach number
+//         alphax = angle of attack - deg
+//         pdynmc = dynamic pressure - Pa
+///////////////////////////////////////////////////////////////////////////////
 
-	return delecx;
+void Plane::control_gamma_lookup(Matrix &GAINGAM,double &gainff,double vmach,double alphax,
+								double pdynmc)
+{
+	//local variables
+	double gain[NGAIN];
+
+	Table *tbl=gaintable.get_tbl(0);
+	int max1=tbl->get_var1_dim()-1;
+	int max2=tbl->get_var2_dim()-1;
+	int max3=tbl->get_var3_dim()-1;
+	if(vmach<tbl->var1_values[0]) vmach=tbl->var1_values[0];
+	if(vmach>tbl->var1_values[max1]) vmach=tbl->var1_values[max1];
+	if(alphax<tbl->var2_values[0]) alphax=tbl->var2_values[0];
+	if(alphax>tbl->var2_values[max2]) alphax=tbl->var2_values[max2];
+	if(pdynmc<tbl->var3_values[0]) pdynmc=tbl->var3_values[0];
+	if(pdynmc>tbl->var3_values[max3]) pdynmc=tbl->var3_values[max3];
+	int loc1=gaintable.find_index(max1,vmach,tbl->var1_values);
+	int loc2=gaintable.find_index(max2,alphax,tbl->var2_values);
+	int loc3=gaintable.find_index(max3,pdynmc,tbl->var3_values);
+
+	for(int g=0;g<NGAIN;g++)
+		gain[g]=gaintable.interpolate(loc1,loc1+1,loc2,loc2+1,loc3,loc3+1,g,vmach,alphax,pdynmc)
+				/(pdynmc*pdynmc);
+
+	GAINGAM.build_vec3(gain[0],gain[1],gain[2]);
+	gainff=gain[3];
+}
+///////////////////////////////////////////////////////////////////////////////
+//Relative error of scheduled gains against the pole placement gains
+//The feedback gain vector error is normalized by the magnitude of the pole
+// placement vector (individual gains may pass through zero); the larger of
+// the feedback and feed-forward errors is returned
+//
+//Return output:
+//         err = max relative error - ND
+//Parameter input:
+//         GAINGAM,gainff = scheduled gains
+//         GAINPP,gainffpp = pole placement gains
+///////////////////////////////////////////////////////////////////////////////
+
+double Plane::control_gamma_error(Matrix GAINGAM,double gainff,Matrix GAINPP,double gainffpp)
+{
+	double ref=GAINPP.absolute();
+	if(ref<SMALL) ref=SMALL;
+	double err=(GAINGAM-GAINPP).absolute()/ref;
+
+	ref=fabs(gainffpp);
+	if(ref<SMALL) ref=SMALL;
+	double dum=fabs(gainff-gainffpp)/ref;
+	if(dum>err) err=dum;
+
+	return err;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -193,6 +193,9 @@ int main()
 		//vehicle data and tables read from 'input.asc' 
 		vehicle_list[i]->vehicle_data(input);
 
+		//trimming the initial conditions ('TRIM' block)
+		vehicle_list[i]->trim(module_list,num_modules);
+
 		//executing initialization computations -MOD		
 		for (int j=0;j<num_modules;j++)
 		{
@@ -404,6 +407,9 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			//watching for the next event			
 			vehicle_list[i]->event(options);
 
+			//linearizing at design times and events ('LINEARIZE' block)
+			vehicle_list[i]->linearize(module_list,num_modules,sim_time,int_step,title);
+
 			{
 				//module loop -MOD
 				for(int j=0;j<num_modules;j++)
@@ -33,4 +33,7 @@ const int NFLAT6=250;					//size of 'flat6' module-variable array
 const int NPLANE=750;					//size of 'missile' module-variable array
 const int NEVENT=20;					//max number of events
 const int NVAR=15;						//max number of variables to be input at every event 
+const int NGAIN=4;						//gains of flight path angle control (3 feedback, 1 feed-forward)
+const int NLINEAR=30;					//max number of states, controls or outputs of a linearization
+const int NDESIGN=20;					//max number of linearization design times
 #endif
\ No newline at end of file
@@ -514,11 +514,8 @@ void traj_banner(ofstream &ftraj,Packet *combus,char *title,int num_vehicles,
 void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
 {
 
-	char *integer;
-	char *name;
-	Matrix VEC(3,1);
 	int k=0;
-	Variable *data;
+	Output *plan=NULL;
 	int ndata;
 	string id;
 	int loc;
@@ -552,49 +549,37 @@ void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
 		if(!loc)
 		//'Plane' object
 		{
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//writing communication variables to 'traj.asc'
 			for(int j=1;j<ndata;j++)
 			{
-
-				integer=data[j].get_type();
-				name=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<(double) data[j].integer();			
+					ftraj<<(double) *out.integer;
 					k++;
 				}
-				//checking vor vectors
-				else if(isupper(name[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(0,0);
-					k++; 
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(1,0);
-					k++;
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>4){k=0;ftraj<<'\n';}
+						ftraj.width(16);
+						ftraj<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<data[j].real(); 
+					ftraj<<*out.real;
 					k++;
 				}
 			}
@@ -624,10 +609,7 @@ void comscrn_data(Packet *combus,int num_vehicles)
 	int ncom_plane6; //number of module variables in 'com_plane6'
 	Variable *data_plane; //Variable array stored in 'Packet data' of type Plane
 	int ndata;
-	Variable *data;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
+	Output *plan=NULL;
 	int k(0),i(0);
 
 	//find first plane packet index in 'combus'
@@ -696,8 +678,8 @@ void comscrn_data(Packet *combus,int num_vehicles)
 		//'Plane' object
 		{
 			p++;
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//write out label of i-th object
 			cout<<"\n *** m_";cout.width(8);cout<<p;
@@ -706,42 +688,31 @@ void comscrn_data(Packet *combus,int num_vehicles)
 			//writing communication variables to screen
 			for(int j=1;j<ndata;j++)
 			{
-				integer=data[j].get_type();
-				vector=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<(double) data[j].integer();			
+					cout<<(double) *out.integer;
 					k++;
 				}
-				//checking vor vectors
-				else if(isupper(vector[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(0,0);
-					k++; 
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(1,0);
-					k++;
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>7){k=0;cout<<'\n';}
+						cout.width(15);
+						cout<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<data[j].real(); 
+					cout<<*out.real;
 					k++;
 				}
 			}
@@ -950,6 +921,21 @@ void document_input(Document *doc_plane6)
 					fcopy.getline(line_clear,CHARL,'\n');
 					input<<line_clear<<'\n';
 				}
+				//copying 'LINEARIZE' and 'TRIM' blocks through their own 'END' as they stand
+				else if(!strcmp(buffn,"LINEARIZE")||!strcmp(buffn,"TRIM")){
+					input<<"\t\t"<<buffn;
+					fcopy.getline(line_clear,CHARL,'\n');
+					input<<line_clear<<'\n';
+					bool block_end=false;
+					do{
+						fcopy.getline(line_clear,CHARL,'\n');
+						input<<line_clear<<'\n';
+						char *key=line_clear+strspn(line_clear," \t");
+						block_end=!strncmp(key,"END",3)&&(!key[3]||isspace(key[3]));
+					}while(!block_end&&!fcopy.eof());
+					//the block's 'END' does not close the vehicle
+					*buffn=NULL;
+				}
 				//inserting 'END' with only one tab
 				else if(!strcmp(buffn,"END")){
 					input<<'\t'<<buffn;
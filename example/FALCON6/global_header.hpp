@@ -36,6 +36,70 @@ struct Module
 	string termination;
 };
 
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Linear'
+//
+//Provides the structure of the linearization request of a vehicle object,
+// read from the 'LINEARIZE' block of 'input.asc'
+//Each element is a scalar: a real module-variable or one component of a vector.
+// Its location 'loc' indexes 'flat6[loc]' if loc<NFLAT6, else 'plane[loc-NFLAT6]';
+// 'comp' is the vector component (0,1,2) or -1 for a real variable
+///////////////////////////////////////////////////////////////////////////////
+struct Linear
+{
+	string file;					//output file name
+	int nx,nu,ny;					//number of states, controls and outputs
+	string xname[NLINEAR];int xloc[NLINEAR];int xcomp[NLINEAR];int xdloc[NLINEAR];
+	string uname[NLINEAR];int uloc[NLINEAR];int ucomp[NLINEAR];
+	string yname[NLINEAR];int yloc[NLINEAR];int ycomp[NLINEAR];
+	string hold[NLINEAR];int nhold;	//modules not executed in the derivative pass
+	double times[NDESIGN];int ntimes;	//design times - sec
+	int itime;						//next design time
+	bool events;					//linearizing also at every event
+	double delta;					//relative perturbation size
+
+	Linear(){nx=0;nu=0;ny=0;nhold=0;ntimes=0;itime=0;events=false;delta=1.e-5;}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Trim'
+//
+//Provides the structure of the trim request of a vehicle object, read from the
+// 'TRIM' block of 'input.asc'. Elements are located as in 'Linear'
+///////////////////////////////////////////////////////////////////////////////
+struct Trim
+{
+	int nu,nr;						//number of unknowns and residuals
+	string uname[NLINEAR];int uloc[NLINEAR];int ucomp[NLINEAR];
+	string rname[NLINEAR];int rloc[NLINEAR];int rcomp[NLINEAR];
+	string hold[NLINEAR];int nhold;	//modules not executed in the residual pass
+	double tol;						//convergence tolerance of each residual
+	int iter;						//max number of Newton iterations
+	double delta;					//relative perturbation size of the Jacobian
+
+	Trim(){nu=0;nr=0;nhold=0;tol=1.e-6;iter=50;delta=1.e-5;}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Output'
+//
+//Entry of the output plans compiled by the index arrays, so that the writers
+// need no type or name inspection and no 'Matrix' copies during the run
+//
+//kind: =0 real, =1 integer, =2 3x1 vector
+//column: first output column of the entry; 'time' is at column 0
+///////////////////////////////////////////////////////////////////////////////
+struct Output
+{
+	double *real;
+	int *integer;
+	Matrix *vec;
+	int kind;
+	int column;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 //Class 'Variable'
 //Establishing module-variables as type Variable
@@ -84,6 +148,41 @@ void init(char *na,double v11,double v12,double v13,double v21,double v22,double
 	//001213 Created by Peter Zipfel
 	///////////////////////////////////////////////////////////////////////////
 	char *get_name(){return name;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Copying the values of module-variable 'var', keeping the definition
+	//Refreshes the 'com' packets without reallocating 'VEC' and 'MAT'
+	///////////////////////////////////////////////////////////////////////////
+	void restore(Variable &var)
+	{
+		rval=var.rval;
+		ival=var.ival;
+		double *pvec=VEC.get_pbody();
+		double *pvec0=var.VEC.get_pbody();
+		for(int i=0;i<3;i++) pvec[i]=pvec0[i];
+		double *pmat=MAT.get_pbody();
+		double *pmat0=var.MAT.get_pbody();
+		for(int i=0;i<9;i++) pmat[i]=pmat0[i];
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Compiling the output plan entry of the module-variable at 'column'
+	//Integers are typed 'int', vectors are named in upper case, all else is real
+	//Advances 'column' by the number of values the entry writes
+	///////////////////////////////////////////////////////////////////////////
+	Output output(int &column)
+	{
+		Output entry;
+		entry.real=&rval;
+		entry.integer=&ival;
+		entry.vec=&VEC;
+		if(!strcmp(type,"int")) entry.kind=1;
+		else if(isupper(name[0])) entry.kind=2;
+		else entry.kind=0;
+		entry.column=column;
+		column+=(entry.kind==2)?3:1;
+		return entry;
+	}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 'type' from module-variable array 
@@ -368,6 +467,7 @@ private:
 	int status;			//alive=1, dead=0. hit=-1 
 	int ndata;			//number of module-variables in data array
 	Variable *data;		//array of module-variables identified by "com" 
+	Output *plan;		//output plan of 'data', compiled by 'com_index_arrays()'
 public:
 	Packet(){};
 	~Packet(){};
@@ -399,6 +499,11 @@ public:
 	///////////////////////////////////////////////////////////////////////////
 	void set_data(Variable *vehicle_d){data=vehicle_d;}
 
+	///////////////////////////////////////////////////////////////////////////
+	//Setting the output plan of packet 'data'
+	///////////////////////////////////////////////////////////////////////////
+	void set_plan(Output *vehicle_plan){plan=vehicle_plan;}
+
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 'id' from packet 
 	//
@@ -427,6 +532,11 @@ public:
 	///////////////////////////////////////////////////////////////////////////
 	Variable *get_data(){return data;}
 
+	///////////////////////////////////////////////////////////////////////////
+	//Obtaining the output plan of 'data' from packet
+	///////////////////////////////////////////////////////////////////////////
+	Output *get_plan(){return plan;}
+
 /*/ zi0100709 Not working, 'delete [] data;' generates application error
 	///////////////////////////////////////////////////////////////////////////
 	//Overloaded assignment operator for deep copies 
@@ -675,9 +785,24 @@ private:
 
 public:
 
-	Datadeck(){}
+	Datadeck(){table_ptr=NULL;}
 	virtual ~Datadeck(){ delete [] table_ptr;}
 
+	///////////////////////////////////////////////////////////////////////////////
+	//Copy constructor; the copy has its own pointer array, the tables are shared
+	///////////////////////////////////////////////////////////////////////////////
+	Datadeck(const Datadeck &deck)
+	{
+		title=deck.title;
+		capacity=deck.capacity;
+		tbl_counter=deck.tbl_counter;
+		table_ptr=NULL;
+		if(deck.table_ptr){
+			table_ptr=new Table *[capacity];
+			for(int i=0;i<capacity;i++) table_ptr[i]=deck.table_ptr[i];
+		}
+	}
+
 	///////////////////////////////////////////////////////////////////////////////
 	//Allocating memory  for table_ptr array 
 	//030711 Created by Peter H Zipfel
@@ -5,11 +5,14 @@
 //		array sizing
 //		writing banners to output
 //		writing data to output
+//		linearization
+//		trim
 //
 //030627 Created by Peter H Zipfel
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "class_hierarchy.hpp"
+#include <thread>
 
 ///////////////////////////////////////////////////////////////////////////////
 //Determining dimensions of arrays: 'plane6', 'scrn_plane6', 'plot_plane6'
@@ -276,6 +279,8 @@ void Plane::tabout_banner(ofstream &ftabout,char *title)
 //			flat6[] data values (Flat6 data member)
 //			plane[] data values ('Plane' data member)
 //			event_ptr_list[] ('Event' data members)
+//			linear ('Linear' data member)
+//			trimming ('Trim' data member)
 //
 //Limitation: only real and integer variables can be read 			 
 //
@@ -380,6 +385,14 @@ void Plane::vehicle_data(fstream &input)
 				read_tables(file_name,proptable);
 			}
 
+			//reading the linearization request
+			if(!strcmp(read,"LINEARIZE"))
+				linear_data(input);
+
+			//reading the trim request
+			if(!strcmp(read,"TRIM"))
+				trim_data(input);
+
 			//reading events into 'Event' pointer array 'event_ptr_list' of size NEVENT
 			if(!strcmp(read,"IF"))
 			{
@@ -506,6 +519,14 @@ void Plane::scrn_index_arrays()
 			l++;
 		}
 	}
+
+	//compiling the output plan
+	int column(0);
+	nscrn_plan=0;
+	for(i=0;i<flat6_scrn_count;i++)
+		scrn_plan[nscrn_plan++]=flat6[flat6_scrn_ind[i]].output(column);
+	for(i=0;i<plane_scrn_count;i++)
+		scrn_plan[nscrn_plan++]=plane[plane_scrn_ind[i]].output(column);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Writing data to screen
@@ -522,84 +543,35 @@ void Plane::scrn_index_arrays()
 void Plane::scrn_data()
 {
 
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k(0),i(0);
 	
 	cout<<plane6_name<<'\n';
 	cout.setf(ios::left);
 
-	//writing to screen the variables from the 'Flat6' class
-	for(i=0;i<flat6_scrn_count;i++)
+	//writing to screen the variables of the output plan
+	for(i=0;i<nscrn_plan;i++)
 	{
-		index=flat6_scrn_ind[i];
-		//checking for integers
-		integer=flat6[index].get_type();
-		vector=flat6[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			cout.width(15);
-			cout<<flat6[index].integer();			
-			k++; if(k>7){k=0;cout<<'\n';}
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		Output &out=scrn_plan[i];
+		if(out.kind==1)
 		{
-			VEC=flat6[index].vec();
-
-			cout.width(15);
-			cout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;cout<<'\n';}
 			cout.width(15);
-			cout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(2,0);
+			cout<<*out.integer;
 			k++; if(k>7){k=0;cout<<'\n';}
 		}
-		else
+		else if(out.kind==2)
 		{
-			//real variables
-			cout.width(15);
-			cout<<flat6[index].real();
-			k++; if(k>7){k=0;cout<<'\n';}
-		}
-	}
-	//writing to screen the variables from the 'Plane' class
-	for(i=0;i<plane_scrn_count;i++)
-	{
-		index=plane_scrn_ind[i];
-		//checking for integers
-		integer=plane[index].get_type();
-		vector=plane[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			cout.width(15);
-			cout<<plane[index].integer();			
-			k++; if(k>7){k=0;cout<<'\n';}
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=plane[index].vec();
-			cout.width(15);
-			cout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;cout<<'\n';}
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
+			{
+				cout.width(15);
+				cout<<vec[m];
+				k++; if(k>7){k=0;cout<<'\n';}
+			}
 		}
 		else
 		{
-			//real variables
 			cout.width(15);
-			cout<<plane[index].real();
+			cout<<*out.real;
 			k++; if(k>7){k=0;cout<<'\n';}
 		}
 	}
@@ -620,84 +592,35 @@ void Plane::scrn_data()
 void Plane::tabout_data(ofstream &ftabout)
 {
 
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k(0),i(0);
 	
 	ftabout<<plane6_name<<'\n';
 	ftabout.setf(ios::left);
 
-	//writing to 'tabout.asc' the variables from the 'Flat6' class
-	for(i=0;i<flat6_scrn_count;i++)
+	//writing to 'tabout.asc' the variables of the output plan
+	for(i=0;i<nscrn_plan;i++)
 	{
-		index=flat6_scrn_ind[i];
-		//checking for integers
-		integer=flat6[index].get_type();
-		vector=flat6[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=scrn_plan[i];
+		if(out.kind==1)
 		{
 			ftabout.width(15);
-			ftabout<<flat6[index].integer();			
-			k++; if(k>7){k=0;ftabout<<'\n';}
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=flat6[index].vec();
-
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(2,0);
+			ftabout<<*out.integer;
 			k++; if(k>7){k=0;ftabout<<'\n';}
 		}
-		else
+		else if(out.kind==2)
 		{
-			//real variables
-			ftabout.width(15);
-			ftabout<<flat6[index].real(); 
-			k++; if(k>7){k=0;ftabout<<'\n';}
-		}
-	}
-	//writing to 'tabout.asc' the variables from the 'Plane' class
-	for(i=0;i<plane_scrn_count;i++)
-	{
-		index=plane_scrn_ind[i];
-		//checking for integers
-		integer=plane[index].get_type();
-		vector=plane[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			ftabout.width(15);
-			ftabout<<plane[index].integer();			
-			k++; if(k>7){k=0;ftabout<<'\n';}
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=plane[index].vec();
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
+			{
+				ftabout.width(15);
+				ftabout<<vec[m];
+				k++; if(k>7){k=0;ftabout<<'\n';}
+			}
 		}
 		else
 		{
-			//real variables
 			ftabout.width(15);
-			ftabout<<plane[index].real();
+			ftabout<<*out.real;
 			k++; if(k>7){k=0;ftabout<<'\n';}
 		}
 	}
@@ -802,6 +725,14 @@ void Plane::plot_index_arrays()
 			l++;
 		}
 	}
+
+	//compiling the output plan
+	int column(0);
+	nplot_plan=0;
+	for(i=0;i<flat6_plot_count;i++)
+		plot_plan[nplot_plan++]=flat6[flat6_plot_ind[i]].output(column);
+	for(i=0;i<plane_plot_count;i++)
+		plot_plan[nplot_plan++]=plane[plane_plot_ind[i]].output(column);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Writing data to 'ploti.asc', i=1,2,3...
@@ -817,105 +748,45 @@ void Plane::plot_index_arrays()
 void Plane::plot_data(ofstream &fplot,bool merge)
 {
 
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k(0),i(0);
 	
 	fplot.setf(ios::left);
 
-	//writing to 'ploti.asc' the variables from the 'Flat6' class
-	for(i=0;i<flat6_plot_count;i++)
+	//writing to 'ploti.asc' the variables of the output plan
+	for(i=0;i<nplot_plan;i++)
 	{
-		index=flat6_plot_ind[i];
-		//checking for integers
-		integer=flat6[index].get_type();
-		vector=flat6[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=plot_plan[i];
+		if(out.kind==1)
 		{
 			//casting integer to real variable
 			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<(double) flat6[index].integer();			
-			k++;
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=flat6[index].vec();
-
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++; 
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
+			fplot<<(double) *out.integer;
 			k++;
 		}
-		else
+		else if(out.kind==2)
 		{
-			//real variables
-			if(merge&&(index==0))
-				//for merging files, time at last entry must be '-1'
-			{
-				fplot.width(16);
-				fplot<<"-1.0";
-				k++;
-			}
-			else
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
 			{
 				if(k>4){k=0;fplot<<'\n';}
 				fplot.width(16);
-				fplot<<flat6[index].real(); 
+				fplot<<vec[m];
 				k++;
 			}
 		}
-	}
-	//writing to 'ploti.asc' the variables from the 'Plane' class
-	for(i=0;i<plane_plot_count;i++)
-	{
-		index=plane_plot_ind[i];
-		//checking for integers
-		integer=plane[index].get_type();
-		vector=plane[index].get_name();
-		if(!strcmp(integer,"int"))
+		else if(merge&&!out.column)
+		//for merging files, time at last entry must be '-1'
 		{
-			//casting integer to real variable
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<(double) plane[index].integer();			
-			k++;
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=plane[index].vec();
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
+			fplot<<"-1.0";
 			k++;
 		}
 		else
 		{
-			//real variables
 			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<plane[index].real();
+			fplot<<*out.real;
 			k++;
 		}
 	}
@@ -1214,6 +1085,22 @@ void Plane::com_index_arrays()
 			l++;
 		}
 	}
+
+	//loading the definitions into 'com_plane6' once and compiling its output plan
+	int column(0);
+	ncom_plan=0;
+	for(i=0;i<flat6_com_count;i++)
+	{
+		com_plane6[ncom_plan]=flat6[flat6_com_ind[i]];
+		com_plan[ncom_plan]=com_plane6[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	for(i=0;i<plane_com_count;i++)
+	{
+		com_plane6[ncom_plan]=plane[plane_com_ind[i]];
+		com_plan[ncom_plan]=com_plane6[ncom_plan].output(column);
+		ncom_plan++;
+	}
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Initializing loading 'packet' with 'PLANE6' data
@@ -1244,17 +1131,18 @@ Packet Plane::loading_packet_init(int num_plane)
 	for(i=0;i<flat6_com_count;i++)
 	{
 		index=flat6_com_ind[i];
-		com_plane6[i]=flat6[index]; 
+		com_plane6[i].restore(flat6[index]); 
 	}
 	for(j=0;j<plane_com_count;j++)
 	{
 		index=plane_com_ind[j];
-		com_plane6[i+j]=plane[index];
+		com_plane6[i+j].restore(plane[index]);
 	}
 	//refreshing the packet
 	packet.set_id(id);
 	packet.set_status(1);
 	packet.set_data(com_plane6);
+	packet.set_plan(com_plan);
 	packet.set_ndata(ncom_plane6);
 
 	return packet;
@@ -1286,12 +1174,12 @@ Packet Plane::loading_packet(int num_plane)
 	for(i=0;i<flat6_com_count;i++)
 	{
 		index=flat6_com_ind[i];
-		com_plane6[i]=flat6[index];
+		com_plane6[i].restore(flat6[index]);
 	}
 	for(j=0;j<plane_com_count;j++)
 	{
 		index=plane_com_ind[j];
-		com_plane6[i+j]=plane[index];
+		com_plane6[i+j].restore(plane[index]);
 	}
 	//refreshing the packet
 //	packet.set_id(id);
@@ -1372,7 +1260,7 @@ void Plane::read_tables(char *file_name,Datadeck &datatable)
 		//extracting table dimension
 		//at this point 'temp' is holding xDIM
 		int dim_check(0);
-		char dim_buff[2];
+		char dim_buff[2]={0};
 		int table_dim(0);
 		strncpy(dim_buff,temp,1);
 		//converting character to integer
@@ -1550,4 +1438,775 @@ void Plane::read_tables(char *file_name,Datadeck &datatable)
 		}//end of 3-dim tables
 	}//end of diagnostic table print-out
 	/*//////////////////////////////////////////////////////////////////////////
-}
\ No newline at end of file
+}
+///////////////////////////////////////////////////////////////////////////////
+//Reading the linearization request from the 'LINEARIZE' block of 'input.asc'
+//
+//	LINEARIZE lin.asc				//output file
+//		STATES VBEB1 VBEB3 WBEB2 q0 q2	//state variables
+//		CONTROLS delex				//control inputs
+//		OUTPUTS alphax anx			//output variables
+//		HOLD control actuator		//modules not executed in the derivative pass
+//		TIMES 5 10					//design times - sec
+//		EVENTS						//linearizing also at every event
+//		DELTA 1e-5					//relative perturbation size (default 1e-5)
+//	END
+//
+//Vectors (upper case names) enter with their three components, or with a
+// single component if its number is appended ('VBEB1'). A state is a module-
+// variable of role 'state' whose derivative is named with a 'D' or 'd' appended.
+// A control input must be 'data' or be calculated by a held module, otherwise
+// the derivative pass would overwrite its perturbation
+//
+//Output:	linear ('Plane' data member)
+///////////////////////////////////////////////////////////////////////////////
+
+void Plane::linear_data(fstream &input)
+{
+	char line[CHARL];
+	char file_name[CHARN];
+	char dname[CHARN];
+	char *key=NULL;
+	char *token=NULL;
+	char *comment=NULL;
+	int i(0),k(0),h(0);
+	bool end=false;
+
+	input>>file_name;
+	input.getline(line,CHARL,'\n');
+	linear.file=file_name;
+
+	//reading keyword lines until 'END'
+	while(!end)
+	{
+		if(input.eof())
+			{cerr<<"*** Error: 'LINEARIZE' block without 'END' ***\n";system("pause");exit(1);}
+		input.getline(line,CHARL,'\n');
+		comment=strstr(line,"//");
+		if(comment) *comment='\0';
+		key=strtok(line," \t\r");
+		if(key==NULL) continue;
+
+		if(!strcmp(key,"END"))
+			end=true;
+		else if(!strcmp(key,"STATES"))
+			while((token=strtok(NULL," \t\r")))
+				linear_element(token,"STATES",linear.nx,linear.xname,linear.xloc,linear.xcomp);
+		else if(!strcmp(key,"CONTROLS"))
+			while((token=strtok(NULL," \t\r")))
+				linear_element(token,"CONTROLS",linear.nu,linear.uname,linear.uloc,linear.ucomp);
+		else if(!strcmp(key,"OUTPUTS"))
+			while((token=strtok(NULL," \t\r")))
+				linear_element(token,"OUTPUTS",linear.ny,linear.yname,linear.yloc,linear.ycomp);
+		else if(!strcmp(key,"HOLD"))
+			while((token=strtok(NULL," \t\r"))){
+				if(linear.nhold==NLINEAR)
+					{cerr<<"*** Error: 'LINEARIZE' too many HOLD modules (NLINEAR) ***\n";system("pause");exit(1);}
+				linear.hold[linear.nhold++]=token;
+			}
+		else if(!strcmp(key,"TIMES"))
+			while((token=strtok(NULL," \t\r"))){
+				if(linear.ntimes==NDESIGN)
+					{cerr<<"*** Error: 'LINEARIZE' too many TIMES (NDESIGN) ***\n";system("pause");exit(1);}
+				linear.times[linear.ntimes]=atof(token);
+				if(linear.ntimes&&linear.times[linear.ntimes]<=linear.times[linear.ntimes-1])
+					{cerr<<"*** Error: 'LINEARIZE' TIMES must increase ***\n";system("pause");exit(1);}
+				linear.ntimes++;
+			}
+		else if(!strcmp(key,"EVENTS"))
+			linear.events=true;
+		else if(!strcmp(key,"DELTA")){
+			token=strtok(NULL," \t\r");
+			if(token) linear.delta=atof(token);
+			if(linear.delta<=0)
+				{cerr<<"*** Error: 'LINEARIZE' DELTA must be positive ***\n";system("pause");exit(1);}
+		}
+		else
+			{cerr<<"*** Error: 'LINEARIZE' unknown keyword '"<<key<<"' ***\n";system("pause");exit(1);}
+	}
+
+	if(!linear.nx)
+		{cerr<<"*** Error: 'LINEARIZE' without STATES ***\n";system("pause");exit(1);}
+
+	//locating the state derivatives
+	for(i=0;i<linear.nx;i++){
+		Variable &state=linear_variable(linear.xloc[i]);
+		if(strcmp(state.get_role(),"state"))
+			{cerr<<"*** Error: 'LINEARIZE' '"<<linear.xname[i]<<"' is not a state variable ***\n";system("pause");exit(1);}
+		for(h=0;h<linear.nhold;h++)
+			if(linear.hold[h]==state.get_mod())
+				{cerr<<"*** Error: 'LINEARIZE' state '"<<linear.xname[i]<<"' of held module '"<<state.get_mod()<<"' ***\n";system("pause");exit(1);}
+		linear.xdloc[i]=-1;
+		for(k=0;k<2;k++){
+			strcpy(dname,state.get_name());
+			strcat(dname,k?"d":"D");
+			for(h=0;h<NFLAT6;h++)
+				if(!strcmp(flat6[h].get_name(),dname)) linear.xdloc[i]=h;
+			for(h=0;h<NPLANE;h++)
+				if(!strcmp(plane[h].get_name(),dname)) linear.xdloc[i]=NFLAT6+h;
+		}
+		if(linear.xdloc[i]<0)
+			{cerr<<"*** Error: 'LINEARIZE' no derivative of state '"<<linear.xname[i]<<"' ***\n";system("pause");exit(1);}
+	}
+	//controls must keep their perturbation during the derivative pass
+	for(i=0;i<linear.nu;i++){
+		Variable &control=linear_variable(linear.uloc[i]);
+		bool held=!strcmp(control.get_role(),"data");
+		for(h=0;h<linear.nhold;h++)
+			if(linear.hold[h]==control.get_mod()) held=true;
+		if(!held)
+			{cerr<<"*** Error: 'LINEARIZE' control '"<<linear.uname[i]<<"' is calculated by module '"
+				<<control.get_mod()<<"'; add the module to HOLD ***\n";system("pause");exit(1);}
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Adding a module-variable to a list of the linearization request
+//A vector adds its three components, 'NAMEi' the i-th component only
+//
+//Parameter output:
+//         count = number of elements in the list
+//         names = element names
+//         locs = module-variable locations (flat6: 0...NFLAT6-1; plane: NFLAT6...)
+//         comps = vector components, -1 for real variables
+//Parameter input:
+//         name = module-variable name as read from 'input.asc'
+//         kind = list keyword
+///////////////////////////////////////////////////////////////////////////////
+
+void Plane::linear_element(char *name,char *kind,int &count,string *names,int *locs,int *comps)
+{
+	char base[CHARN];
+	int loc(-1),comp(-1);
+	int i(0);
+
+	//searching the module-variable arrays
+	strcpy(base,name);
+	for(i=0;i<NFLAT6;i++)
+		if(!strcmp(flat6[i].get_name(),base)) loc=i;
+	for(i=0;i<NPLANE;i++)
+		if(!strcmp(plane[i].get_name(),base)) loc=NFLAT6+i;
+
+	//single component of a vector
+	int len=strlen(name);
+	if(loc<0&&len>1&&isupper(name[0])&&name[len-1]>='1'&&name[len-1]<='3'){
+		comp=name[len-1]-'1';
+		base[len-1]='\0';
+		for(i=0;i<NFLAT6;i++)
+			if(!strcmp(flat6[i].get_name(),base)) loc=i;
+		for(i=0;i<NPLANE;i++)
+			if(!strcmp(plane[i].get_name(),base)) loc=NFLAT6+i;
+	}
+	if(loc<0)
+		{cerr<<"*** Error: 'LINEARIZE' "<<kind<<" '"<<name<<"' is not a module-variable ***\n";system("pause");exit(1);}
+	if(!strcmp(linear_variable(loc).get_type(),"int"))
+		{cerr<<"*** Error: 'LINEARIZE' "<<kind<<" '"<<name<<"' is an integer ***\n";system("pause");exit(1);}
+
+	//loading the elements
+	int first=comp;
+	int last=comp;
+	if(comp<0&&isupper(name[0])){first=0;last=2;}
+	for(i=first;i<=last;i++){
+		if(count==NLINEAR)
+			{cerr<<"*** Error: 'LINEARIZE' too many "<<kind<<" (NLINEAR) ***\n";system("pause");exit(1);}
+		names[count]=base;
+		if(i>=0) names[count]+=char('1'+i);
+		locs[count]=loc;
+		comps[count]=i;
+		count++;
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Module-variable at location 'loc' (flat6: 0...NFLAT6-1; plane: NFLAT6...)
+///////////////////////////////////////////////////////////////////////////////
+
+Variable &Plane::linear_variable(int loc)
+{
+	if(loc<NFLAT6) return flat6[loc];
+	return plane[loc-NFLAT6];
+}
+///////////////////////////////////////////////////////////////////////////////
+//Getting the value of a linearization element
+///////////////////////////////////////////////////////////////////////////////
+
+double Plane::linear_get(int loc,int comp)
+{
+	Variable &var=linear_variable(loc);
+	if(comp<0) return var.real();
+	Matrix VEC=var.vec();
+	return VEC[comp];
+}
+///////////////////////////////////////////////////////////////////////////////
+//Loading the value of a linearization element
+///////////////////////////////////////////////////////////////////////////////
+
+void Plane::linear_put(int loc,int comp,double value)
+{
+	Variable &var=linear_variable(loc);
+	if(comp<0){
+		var.gets(value);
+		return;
+	}
+	Matrix VEC=var.vec();
+	VEC[comp]=value;
+	var.gets_vec(VEC);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Copying the module-variables of 'plane_orig' into this clone
+///////////////////////////////////////////////////////////////////////////////
+
+void Plane::linear_copy(Plane &plane_orig)
+{
+	int i(0);
+	for(i=0;i<NFLAT6;i++) flat6[i]=plane_orig.flat6[i];
+	for(i=0;i<NPLANE;i++) plane[i]=plane_orig.plane[i];
+}
+///////////////////////////////////////////////////////////////////////////////
+//Derivative pass of the module chain
+//The modules are called in their 'input.asc' sequence with zero integration
+// step: the states keep their values and the state derivatives are evaluated
+// at the present state. The second pass lets modules see the outputs of the
+// modules that follow them (e.g. 'environment' uses 'VBEL' from 'newton').
+//The held modules are not executed; their outputs keep their values.
+//
+//Parameter input:
+//         module_list = modules and their calling sequence
+//         num_modules = number of modules
+//         sim_time = simulation time - sec
+//         hold = names of held modules
+//         nhold = number of held modules
+///////////////////////////////////////////////////////////////////////////////
+
+void Plane::linear_pass(Module *module_list,int num_modules,double sim_time,string *hold,int nhold)
+{
+	int j(0),h(0);
+	bool held=false;
+
+	for(int pass=0;pass<2;pass++)
+	{
+		for(j=0;j<num_modules;j++)
+		{
+			held=false;
+			for(h=0;h<nhold;h++)
+				if(module_list[j].name==hold[h]) held=true;
+			if(held) continue;
+
+			if(module_list[j].name=="environment")
+				environment(0);
+			else if(module_list[j].name=="kinematics")
+				kinematics(0);
+			else if(module_list[j].name=="newton")
+				newton(sim_time,0);
+			else if(module_list[j].name=="euler")
+				euler(0);
+			else if(module_list[j].name=="aerodynamics")
+				aerodynamics();
+			else if(module_list[j].name=="propulsion")
+				propulsion(0);
+			else if(module_list[j].name=="forces")
+				forces();
+			else if(module_list[j].name=="actuator")
+				actuator(0);
+			else if(module_list[j].name=="control") 
+				control(0);
+			else if(module_list[j].name=="guidance")
+				guidance();
+		}
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Central-difference columns of the linearization, computed by one worker
+//Each worker owns a clone; it restores the clone to the present state, perturbs
+// one state or control by +-delta, runs the derivative pass and differences the
+// state derivatives and outputs. Columns first, first+stride, ... are computed
+//
+//Parameter output:
+//         AB = [A B] (nx x (nx+nu)), column-wise
+//         CD = [C D] (ny x (nx+nu)), column-wise
+//Parameter input:
+//         first = first column
+//         stride = number of workers
+//         module_list = modules and their calling sequence
+//         num_modules = number of modules
+//         sim_time = simulation time - sec
+///////////////////////////////////////////////////////////////////////////////
+
+void Plane::linear_columns(int first,int stride,Module *module_list,int num_modules,double sim_time,
+						   double *AB,double *CD)
+{
+	//local variables
+	double xdp[NLINEAR],yp[NLINEAR];
+	int loc(0),comp(0);
+	int i(0);
+
+	int nx=linear.nx;
+	int ny=linear.ny;
+	int ncol=linear.nx+linear.nu;
+	Plane clone(*this);
+
+	for(int j=first;j<ncol;j+=stride)
+	{
+		if(j<nx){
+			loc=linear.xloc[j];
+			comp=linear.xcomp[j];
+		}
+		else{
+			loc=linear.uloc[j-nx];
+			comp=linear.ucomp[j-nx];
+		}
+		double value=linear_get(loc,comp);
+		double delta=linear.delta*fabs(value);
+		if(delta<linear.delta) delta=linear.delta;
+
+		//positive perturbation
+		clone.linear_copy(*this);
+		clone.linear_put(loc,comp,value+delta);
+		clone.linear_pass(module_list,num_modules,sim_time,linear.hold,linear.nhold);
+		for(i=0;i<nx;i++) xdp[i]=clone.linear_get(linear.xdloc[i],linear.xcomp[i]);
+		for(i=0;i<ny;i++) yp[i]=clone.linear_get(linear.yloc[i],linear.ycomp[i]);
+
+		//negative perturbation
+		clone.linear_copy(*this);
+		clone.linear_put(loc,comp,value-delta);
+		clone.linear_pass(module_list,num_modules,sim_time,linear.hold,linear.nhold);
+		for(i=0;i<nx;i++)
+			AB[j*nx+i]=(xdp[i]-clone.linear_get(linear.xdloc[i],linear.xcomp[i]))/(2*delta);
+		for(i=0;i<ny;i++)
+			CD[j*ny+i]=(yp[i]-clone.linear_get(linear.yloc[i],linear.ycomp[i]))/(2*delta);
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Linearization at the design times and events of the 'LINEARIZE' block
+//Called by the executive before the modules of the integration step. The
+// vehicle itself is not changed: the nominal point and the perturbed points are
+// evaluated on clones, the columns are distributed over one worker thread per
+// core. The linear model
+//		xd = A*x + B*u ,  y = C*x + D*u
+// and the nominal point are appended to the output file of the request.
+//
+//Parameter input:
+//         module_list = modules and their calling sequence
+//         num_modules = number of modules
+//         sim_time = simulation time - sec
+//         int_step = integration step - sec
+//         title = title of 'input.asc'
+///////////////////////////////////////////////////////////////////////////////
+
+void Plane::linearize(Module *module_list,int num_modules,double sim_time,double int_step,char *title)
+{
+	//local variables
+	double xd0[NLINEAR],y0[NLINEAR];
+	int i(0),j(0),w(0);
+
+	//returning if no linearization is due
+	if(!linear.nx) return;
+	bool due=linear.events&&event_epoch;
+	while(linear.itime<linear.ntimes&&sim_time>linear.times[linear.itime]-int_step/2){
+		due=true;
+		linear.itime++;
+	}
+	if(!due) return;
+
+	int nx=linear.nx;
+	int nu=linear.nu;
+	int ny=linear.ny;
+	int ncol=nx+nu;
+
+	//nominal point
+	Plane *nominal=new Plane(*this);
+	nominal->linear_pass(module_list,num_modules,sim_time,linear.hold,linear.nhold);
+	for(i=0;i<nx;i++) xd0[i]=nominal->linear_get(linear.xdloc[i],linear.xcomp[i]);
+	for(i=0;i<ny;i++) y0[i]=nominal->linear_get(linear.yloc[i],linear.ycomp[i]);
+	delete nominal;
+
+	//perturbed points, one worker per core
+	double *AB=new double[nx*ncol];
+	double *CD=new double[ny*ncol+1];
+	int nworker=thread::hardware_concurrency();
+	if(nworker<1) nworker=1;
+	if(nworker>ncol) nworker=ncol;
+	thread *workers=new thread[nworker];
+	for(w=0;w<nworker;w++)
+		workers[w]=thread(&Plane::linear_columns,this,w,nworker,module_list,num_modules,sim_time,AB,CD);
+	for(w=0;w<nworker;w++)
+		workers[w].join();
+	delete [] workers;
+
+	//opening the output file at the first design point
+	if(!flinear.is_open()){
+		flinear.open(linear.file.c_str());
+		if(!flinear){cout<<" *** Error: cannot open '"<<linear.file<<"' file *** \n";system("pause");exit(1);}
+		flinear<<title<<'\n';
+		flinear.precision(10);
+	}
+	flinear.setf(ios::left);
+	flinear<<"\nLINEAR  time = "<<sim_time<<" sec  "<<plane6_name<<'\n';
+
+	//nominal point: states with their derivatives, controls, outputs
+	flinear<<"STATES "<<nx<<'\n';
+	for(i=0;i<nx;i++){
+		flinear.width(15);flinear<<linear.xname[i];
+		flinear.width(20);flinear<<linear_get(linear.xloc[i],linear.xcomp[i]);
+		flinear<<xd0[i]<<'\n';
+	}
+	flinear<<"CONTROLS "<<nu<<'\n';
+	for(i=0;i<nu;i++){
+		flinear.width(15);flinear<<linear.uname[i];
+		flinear<<linear_get(linear.uloc[i],linear.ucomp[i])<<'\n';
+	}
+	flinear<<"OUTPUTS "<<ny<<'\n';
+	for(i=0;i<ny;i++){
+		flinear.width(15);flinear<<linear.yname[i];
+		flinear<<y0[i]<<'\n';
+	}
+
+	//system matrices A, B, C, D
+	for(int m=0;m<4;m++){
+		int rows=(m<2)?nx:ny;
+		int col0=(m%2)?nx:0;
+		int cols=(m%2)?nu:nx;
+		double *M=(m<2)?AB:CD;
+		flinear<<"ABCD"[m]<<' '<<rows<<' '<<cols<<'\n';
+		for(i=0;i<rows;i++){
+			for(j=0;j<cols;j++){
+				flinear.width(20);flinear<<M[(col0+j)*rows+i];
+			}
+			flinear<<'\n';
+		}
+	}
+	flinear<<"END\n";
+	flinear.flush();
+
+	cout<<" *** Linearization at time = "<<sim_time<<" sec: "<<nx<<" states, "<<nu<<" controls, "
+		<<ny<<" outputs on "<<nworker<<" threads -> '"<<linear.file<<"' ***\n";
+
+	delete [] AB;
+	delete [] CD;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Reading the trim request from the 'TRIM' block of 'input.asc'
+//
+//	TRIM
+//		UNKNOWNS alpha0x thtblx throttle power delex	//variables solved for
+//		RESIDUALS VBEBD1 VBEBD3 SBELD3 powerd WBEBD2	//variables driven to zero
+//		HOLD control actuator		//modules not executed in the residual pass
+//		TOL 1e-6					//tolerance of each residual (default 1e-6)
+//		ITER 50						//max number of iterations (default 50)
+//		DELTA 1e-5					//relative perturbation of the Jacobian (default 1e-5)
+//	END
+//
+//Unknowns and residuals are entered as in the 'LINEARIZE' block; their numbers
+// must be equal. The unknowns are loaded before the initialization modules are
+// called, so initial conditions like 'alpha0x' and 'thtblx' can be trimmed.
+//
+//Output:	trimming ('Plane' data member)
+///////////////////////////////////////////////////////////////////////////////
+
+void Plane::trim_data(fstream &input)
+{
+	char line[CHARL];
+	char *key=NULL;
+	char *token=NULL;
+	char *comment=NULL;
+	bool end=false;
+
+	input.getline(line,CHARL,'\n');
+
+	//reading keyword lines until 'END'
+	while(!end)
+	{
+		if(input.eof())
+			{cerr<<"*** Error: 'TRIM' block without 'END' ***\n";system("pause");exit(1);}
+		input.getline(line,CHARL,'\n');
+		comment=strstr(line,"//");
+		if(comment) *comment='\0';
+		key=strtok(line," \t\r");
+		if(key==NULL) continue;
+
+		if(!strcmp(key,"END"))
+			end=true;
+		else if(!strcmp(key,"UNKNOWNS"))
+			while((token=strtok(NULL," \t\r")))
+				linear_element(token,"UNKNOWNS",trimming.nu,trimming.uname,trimming.uloc,trimming.ucomp);
+		else if(!strcmp(key,"RESIDUALS"))
+			while((token=strtok(NULL," \t\r")))
+				linear_element(token,"RESIDUALS",trimming.nr,trimming.rname,trimming.rloc,trimming.rcomp);
+		else if(!strcmp(key,"HOLD"))
+			while((token=strtok(NULL," \t\r"))){
+				if(trimming.nhold==NLINEAR)
+					{cerr<<"*** Error: 'TRIM' too many HOLD modules (NLINEAR) ***\n";system("pause");exit(1);}
+				trimming.hold[trimming.nhold++]=token;
+			}
+		else if(!strcmp(key,"TOL")||!strcmp(key,"ITER")||!strcmp(key,"DELTA")){
+			token=strtok(NULL," \t\r");
+			double value=token?atof(token):0;
+			if(value<=0)
+				{cerr<<"*** Error: 'TRIM' "<<key<<" must be positive ***\n";system("pause");exit(1);}
+			if(!strcmp(key,"TOL")) trimming.tol=value;
+			else if(!strcmp(key,"ITER")) trimming.iter=int(value);
+			else trimming.delta=value;
+		}
+		else
+			{cerr<<"*** Error: 'TRIM' unknown keyword '"<<key<<"' ***\n";system("pause");exit(1);}
+	}
+
+	if(!trimming.nu||trimming.nu!=trimming.nr)
+		{cerr<<"*** Error: 'TRIM' needs as many RESIDUALS as UNKNOWNS ("<<trimming.nr<<" vs "
+			<<trimming.nu<<") ***\n";system("pause");exit(1);}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Residuals of the trim at the unknowns 'u'
+//Restores the clone to the vehicle as read from 'input.asc', loads the unknowns,
+// calls the initialization modules and the derivative pass at time zero
+//
+//Parameter output:
+//         r = residuals
+//Parameter input:
+//         clone = work copy of the vehicle
+//         module_list = modules and their calling sequence
+//         num_modules = number of modules
+//         u = unknowns
+///////////////////////////////////////////////////////////////////////////////
+
+void Plane::trim_residuals(Plane &clone,Module *module_list,int num_modules,double *u,double *r)
+{
+	int i(0),j(0);
+
+	clone.linear_copy(*this);
+	for(i=0;i<trimming.nu;i++)
+		clone.linear_put(trimming.uloc[i],trimming.ucomp[i],u[i]);
+
+	//initialization computations, as in 'execute()'
+	for(j=0;j<num_modules;j++)
+	{
+		if((module_list[j].name=="aerodynamics")&&(module_list[j].initialization=="init"))
+			clone.init_aerodynamics();
+		else if((module_list[j].name=="newton")&&(module_list[j].initialization=="init"))
+			clone.init_newton();
+		else if((module_list[j].name=="euler")&&(module_list[j].initialization=="init"))
+			clone.init_euler();
+		else if((module_list[j].name=="kinematics")&&(module_list[j].initialization=="init"))
+			clone.init_kinematics();
+	}
+	clone.linear_pass(module_list,num_modules,0,trimming.hold,trimming.nhold);
+
+	for(i=0;i<trimming.nr;i++)
+		r[i]=clone.linear_get(trimming.rloc[i],trimming.rcomp[i]);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Jacobian of the trim residuals by central differences
+//
+//Parameter output:
+//         J = Jacobian dr/du (nr x nu), row-wise
+//Parameter input:
+//         clone = work copy of the vehicle
+//         module_list = modules and their calling sequence
+//         num_modules = number of modules
+//         u = unknowns
+///////////////////////////////////////////////////////////////////////////////
+
+void Plane::trim_jacobian(Plane &clone,Module *module_list,int num_modules,double *u,double *J)
+{
+	double up[NLINEAR],rp[NLINEAR],rm[NLINEAR];
+	int i(0),j(0);
+	int n=trimming.nu;
+
+	for(i=0;i<n;i++) up[i]=u[i];
+	for(j=0;j<n;j++)
+	{
+		double delta=trimming.delta*fabs(u[j]);
+		if(delta<trimming.delta) delta=trimming.delta;
+
+		up[j]=u[j]+delta;
+		trim_residuals(clone,module_list,num_modules,up,rp);
+		up[j]=u[j]-delta;
+		trim_residuals(clone,module_list,num_modules,up,rm);
+		up[j]=u[j];
+
+		bool effective=false;
+		for(i=0;i<n;i++){
+			J[i*n+j]=(rp[i]-rm[i])/(2*delta);
+			if(J[i*n+j]!=0) effective=true;
+		}
+		if(!effective)
+			{cerr<<"*** Error: 'TRIM' unknown '"<<trimming.uname[j]<<"' does not change the residuals ***\n";
+				system("pause");exit(1);}
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Newton step of the trim: solving J*du=-r by Gauss elimination with partial
+// pivoting. Returns false if 'J' is singular
+//
+//Parameter output:
+//         du = Newton step
+//Parameter input:
+//         J = Jacobian (nu x nu), row-wise
+//         r = residuals
+///////////////////////////////////////////////////////////////////////////////
+
+bool Plane::trim_solve(double *J,double *r,double *du)
+{
+	double A[NLINEAR*NLINEAR];
+	int i(0),j(0),k(0);
+	int n=trimming.nu;
+	double scale(0);
+
+	for(i=0;i<n*n;i++){
+		A[i]=J[i];
+		if(fabs(A[i])>scale) scale=fabs(A[i]);
+	}
+	for(i=0;i<n;i++) du[i]=-r[i];
+
+	//forward elimination
+	for(k=0;k<n;k++)
+	{
+		int pivot=k;
+		for(i=k+1;i<n;i++)
+			if(fabs(A[i*n+k])>fabs(A[pivot*n+k])) pivot=i;
+		if(fabs(A[pivot*n+k])<=1.e-14*scale) return false;
+		if(pivot!=k){
+			for(j=0;j<n;j++){double dum=A[k*n+j];A[k*n+j]=A[pivot*n+j];A[pivot*n+j]=dum;}
+			double dum=du[k];du[k]=du[pivot];du[pivot]=dum;
+		}
+		for(i=k+1;i<n;i++){
+			double factor=A[i*n+k]/A[k*n+k];
+			for(j=k;j<n;j++) A[i*n+j]-=factor*A[k*n+j];
+			du[i]-=factor*du[k];
+		}
+	}
+	//back substitution
+	for(k=n-1;k>=0;k--){
+		for(j=k+1;j<n;j++) du[k]-=A[k*n+j]*du[j];
+		du[k]/=A[k*n+k];
+	}
+	return true;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Trim of the initial conditions requested by the 'TRIM' block
+//Called by the executive after the vehicle data are read and before the
+// initialization modules. Damped Newton iteration with a cached Jacobian: the
+// central-difference Jacobian is refreshed only when a Broyden-updated step
+// fails to reduce the residuals. The step is halved until the residual norm
+// decreases. The converged unknowns are loaded into the vehicle; otherwise the
+// 'input.asc' values are kept with a warning.
+//The Mach hold ('mprop=2') overwrites 'throttle'. If 'throttle' is an unknown,
+// the trim is solved with direct throttle ('mprop=1') and the Mach command
+// 'vmachcom' is then set so that the hold commands the trimmed throttle
+//
+//Parameter input:
+//         module_list = modules and their calling sequence
+//         num_modules = number of modules
+///////////////////////////////////////////////////////////////////////////////
+
+void Plane::trim(Module *module_list,int num_modules)
+{
+	//local variables
+	double u[NLINEAR],r[NLINEAR],du[NLINEAR];
+	double un[NLINEAR],rn[NLINEAR],Js[NLINEAR];
+	double J[NLINEAR*NLINEAR];
+	int i(0),j(0),k(0),iter(0);
+
+	if(!trimming.nu) return;
+	int n=trimming.nu;
+
+	//opening the Mach hold while the throttle is trimmed
+	int mprop=plane[50].integer();
+	bool mach_hold=false;
+	for(i=0;i<n;i++)
+		if(mprop==2&&trimming.uname[i]=="throttle") mach_hold=true;
+	if(mach_hold){
+		if(plane[53].real()<=0)
+			{cerr<<"*** Error: 'TRIM' of 'throttle' with Mach hold needs 'gmach' > 0 ***\n";system("pause");exit(1);}
+		plane[50].gets(1);
+	}
+
+	Plane clone(*this);
+
+	for(i=0;i<n;i++) u[i]=linear_get(trimming.uloc[i],trimming.ucomp[i]);
+	trim_residuals(clone,module_list,num_modules,u,r);
+	double norm(0);
+	for(i=0;i<n;i++) norm+=r[i]*r[i];
+	trim_jacobian(clone,module_list,num_modules,u,J);
+	int njacobian=1;
+	bool fresh=true;
+
+	for(iter=0;iter<trimming.iter;iter++)
+	{
+		bool converged=true;
+		for(i=0;i<n;i++)
+			if(fabs(r[i])>trimming.tol) converged=false;
+		if(converged) break;
+
+		//damped Newton step
+		bool decreased=false;
+		double normn(0);
+		if(trim_solve(J,r,du)){
+			double lambda=1;
+			for(k=0;k<10&&!decreased;k++){
+				for(i=0;i<n;i++) un[i]=u[i]+lambda*du[i];
+				trim_residuals(clone,module_list,num_modules,un,rn);
+				normn=0;
+				for(i=0;i<n;i++) normn+=rn[i]*rn[i];
+				if(normn<norm) decreased=true;
+				else lambda/=2;
+			}
+		}
+		if(!decreased){
+			//an updated Jacobian is refreshed once, a fresh one has failed
+			if(fresh) break;
+			trim_jacobian(clone,module_list,num_modules,u,J);
+			njacobian++;
+			fresh=true;
+			continue;
+		}
+		//Broyden update J=J+(dr-J*du)*du'/(du'*du)
+		double ss(0);
+		for(i=0;i<n;i++){
+			du[i]=un[i]-u[i];
+			ss+=du[i]*du[i];
+		}
+		for(i=0;i<n;i++){
+			Js[i]=0;
+			for(j=0;j<n;j++) Js[i]+=J[i*n+j]*du[j];
+		}
+		for(i=0;i<n;i++)
+			for(j=0;j<n;j++)
+				J[i*n+j]+=(rn[i]-r[i]-Js[i])*du[j]/ss;
+		for(i=0;i<n;i++){
+			u[i]=un[i];
+			r[i]=rn[i];
+		}
+		norm=normn;
+		fresh=false;
+	}
+
+	double rmax(0);
+	for(i=0;i<n;i++)
+		if(fabs(r[i])>rmax) rmax=fabs(r[i]);
+	if(rmax>trimming.tol){
+		if(mach_hold) plane[50].gets(2);
+		cout<<" *** Warning: trim of"<<plane6_name<<" not converged after "<<iter
+			<<" iterations, max residual = "<<rmax<<"; 'input.asc' values kept ***\n";
+		return;
+	}
+	//loading the trimmed unknowns
+	for(i=0;i<n;i++)
+		linear_put(trimming.uloc[i],trimming.ucomp[i],u[i]);
+
+	cout<<" *** Trim of"<<plane6_name<<": "<<iter<<" iterations, "<<njacobian
+		<<" Jacobians, max residual = "<<rmax<<" ***\n";
+	for(i=0;i<n;i++)
+		cout<<"\t"<<trimming.uname[i]<<" = "<<u[i]<<'\n';
+
+	//closing the Mach hold on the trimmed throttle: throttle=gmach*(vmachcom-vmach)
+	if(mach_hold){
+		plane[50].gets(2);
+		trim_residuals(clone,module_list,num_modules,u,r);
+		double vmach=clone.flat6[56].real();
+		double throttle=plane[52].real();
+		double vmachcom=vmach+throttle/plane[53].real();
+		plane[51].gets(vmachcom);
+		cout<<"\tvmachcom = "<<vmachcom<<" (Mach hold of the trimmed throttle)\n";
+		if(throttle<0||throttle>0.77)
+			cout<<" *** Warning: trimmed throttle outside the Mach hold limits 0...0.77 ***\n";
+	}
+}
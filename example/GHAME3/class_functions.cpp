@@ -35,6 +35,28 @@ Round3::Round3()
 	for(int i=0;i<NROUND3;i++)round3[i].init("empty",0," "," "," "," ");
 }
 ///////////////////////////////////////////////////////////////////////////////
+//Attaching the state derivatives of 'newton' to an output plan for dense output
+//
+//The first 'round3_count' entries of 'plan' must have been compiled from
+// 'round3[round3_ind[i]]'. Each integrated state receives its derivative:
+// SBII <- VBII, VBII <- ABII, SBEG <- VBEG
+///////////////////////////////////////////////////////////////////////////////
+
+void Round3::dense_rates(Output *plan,int *round3_ind,int round3_count)
+{
+	int column(0);
+
+	for(int i=0;i<round3_count;i++)
+	{
+		int rate_ind(0);
+		if(round3_ind[i]==35) rate_ind=36;
+		else if(round3_ind[i]==36) rate_ind=37;
+		else if(round3_ind[i]==31) rate_ind=32;
+		else continue;
+		plan[i].rate=round3[rate_ind].output(column).vec;
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
 //Constructor initializing the modules and the module-variable arrays
 //Reading input data from 'input.asc' and putting into 'round3' and 'cruise' arrays 
 //Writing banners to screen, 'tabout.asc' and to 'traj.asc' files  
@@ -118,6 +140,11 @@ Cruise::Cruise(Module *module_list,int num_modules)
 	round3_com_ind=new int[round3_com_count];
 	cruise_com_ind=new int[cruise_com_count];
 
+	//allocating memory for the output plans
+	scrn_plan=new Output[round3_scrn_count+cruise_scrn_count];
+	plot_plan=new Output[round3_plot_count+cruise_plot_count];
+	com_plan=new Output[round3_com_count+cruise_com_count];
+
 	//allocating memory to each event object in event object list
 	for (i=0;i<NEVENT;i++)
 		try{event_ptr_list[i]=new Event;}
@@ -166,6 +193,9 @@ Cruise::~Cruise()
 	delete [] cruise_plot_ind;
 	delete [] round3_com_ind;
 	delete [] cruise_com_ind;
+	delete [] scrn_plan;
+	delete [] plot_plan;
+	delete [] com_plan;
 	delete [] &event_ptr_list;
 }
 ///////////////////////////////////////////////////////////////////////////////
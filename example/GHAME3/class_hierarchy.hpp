@@ -82,7 +82,8 @@ public:
 	virtual void scrn_data()=0;
 	virtual void plot_banner(ofstream &fplot,char *title)=0;
 	virtual void plot_index_arrays()=0;
-	virtual void plot_data(ofstream &fplot,bool merge)=0;
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step)=0;
+	virtual void record_output()=0;
 	virtual void event(char *options)=0;
 	virtual void document(ostream &fdoc,char *title,Document *doc_cruise3)=0;
 	virtual void com_index_arrays()=0;
@@ -148,7 +149,8 @@ public:
 	virtual void scrn_data()=0;
 	virtual void plot_banner(ofstream &fplot,char *title)=0;
 	virtual void plot_index_arrays()=0;
-	virtual void plot_data(ofstream &fplot,bool merge)=0;
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step)=0;
+	virtual void record_output()=0;
 	virtual void event(char *options)=0;
 	virtual void document(ostream &fdoc,char *title,Document *doc_cruise3)=0;
 	virtual void com_index_arrays()=0;
@@ -171,6 +173,9 @@ public:
 	virtual void def_newton();
 	virtual void init_newton();
 	virtual void newton(double int_step);
+
+	//attaching the state derivatives of 'newton' to an output plan
+	void dense_rates(Output *plan,int *round3_ind,int round3_count);
 };
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -223,6 +228,11 @@ protected:
 	// be written to 'combus' 'packets'
 	int *cruise_com_ind; int cruise_com_count;
 
+	//output plans compiled by the index arrays and executed by the writers
+	Output *scrn_plan; int nscrn_plan;
+	Output *plot_plan; int nplot_plan;
+	Output *com_plan; int ncom_plan;
+
 	//declaring Table pointer as temporary storage of a single table
 	Table *table;
 	//	declaring Datadeck 'aerotable' that stores all aerodynamic tables
@@ -249,7 +259,8 @@ public:
 	virtual void scrn_data();
 	virtual void plot_banner(ofstream &fplot,char *title);
 	virtual void plot_index_arrays();
-	virtual void plot_data(ofstream &fplot,bool merge);
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step);
+	virtual void record_output();
 	virtual void event(char *options);
 	virtual void document(ostream &fdoc,char *title,Document *doc_cruise3);
 	virtual void com_index_arrays();
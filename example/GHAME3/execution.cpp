@@ -63,7 +63,7 @@ void traj_banner(ofstream &ftraj,Packet *combus,char *title,int num_vehicles,
 				 int ncruise);
 
 //writing 'traj.asc' file of 'combus' data
-void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge);
+void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge,double frac,double step);
 
 //Documenting 'input.asc' with module-variable definitions
 void document_input(Document *doc_cruise3);
@@ -289,7 +289,7 @@ int main(void)
 		traj_banner(ftraj,combus,title,num_vehicles,num_cruise);
 
 		//writing data after 'initial module' calculations
-		traj_data(ftraj,combus,num_vehicles,traj_merge);
+		traj_data(ftraj,combus,num_vehicles,traj_merge,1,0);
 	}
 		//Aquire ending time (last entry on 'input.asc')
 		end_time=acquire_endtime(input);
@@ -393,9 +393,9 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 	double com_time(0);
 	int vehicle_slot(0);
 	bool increment_scrn_time=false;
-	bool increment_plot_time=false;
 	bool plot_merge=false;
 	double out_fact(0);
+	double sim_time_last(sim_time-int_step);
 
 	//integration loop
 	while (sim_time<=(end_time+int_step))
@@ -461,19 +461,26 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 				}
 				if(increment_scrn_time) scrn_time+=scrn_step*(1+out_fact);
 			}
+		} //end of vehicle loop
+
+		//dense output: plot and traj times passed during the last step are sampled
+		//exactly, interpolating between 'sim_time_last' and 'sim_time'
+		double step=sim_time-sim_time_last;
+		double snap=int_step/100;
 
-			//output to 'ploti.asc' file
-			if(fabs(plot_time-sim_time)<(int_step/2+EPS))
+		//output to 'ploti.asc' files
+		if(strstr(options,"y_plot"))
+		{
+			while(plot_time>sim_time_last&&plot_time<sim_time+snap)
 			{
-				if(strstr(options,"y_plot"))
-				{
-					vehicle_list[i]->plot_data(plot_ostream_list[i],plot_merge);
-					if(i==(num_vehicles-1))increment_plot_time=true;
-				}
-				if(increment_plot_time) plot_time+=plot_step*(1+out_fact);
+				double frac(1);
+				if(fabs(plot_time-sim_time)>=snap) frac=(plot_time-sim_time_last)/step;
+				for(int i=0;i<num_vehicles;i++)
+					vehicle_list[i]->plot_data(plot_ostream_list[i],plot_merge,frac,step);
+				if(plot_step*(1+out_fact)<=0) break;
+				plot_time+=plot_step*(1+out_fact);
 			}
-
-		} //end of vehicle loop
+		}
 
 		//outputting 'combus' to screen 
 		if(fabs(com_time-sim_time)<(int_step/2+EPS))
@@ -485,17 +492,27 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			com_time+=com_step*(1+out_fact);
 		}
 		//outputting'combus' to 'traj.asc' file
-		if(fabs(traj_time-sim_time)<(int_step/2+EPS))
+		if(strstr(options,"y_traj"))
 		{
-			if(strstr(options,"y_traj"))
+			while(traj_time>sim_time_last&&traj_time<sim_time+snap)
 			{
-				traj_data(ftraj,combus,num_vehicles,traj_merge);
+				double frac(1);
+				if(fabs(traj_time-sim_time)>=snap) frac=(traj_time-sim_time_last)/step;
+				traj_data(ftraj,combus,num_vehicles,traj_merge,frac,step);
+				if(traj_step*(1+out_fact)<=0) break;
+				traj_time+=traj_step*(1+out_fact);
 			}
-			traj_time+=traj_step*(1+out_fact);
 		}
+		//recording the output plans at the end of the step for dense output
+		if(strstr(options,"y_plot")||strstr(options,"y_traj"))
+		{
+			for(int i=0;i<num_vehicles;i++)
+				vehicle_list[i]->record_output();
+		}
+		sim_time_last=sim_time;
+
 		//resetting output events
 		increment_scrn_time=false;
-		increment_plot_time=false;
 
 		//advancing time
 		sim_time+=int_step;
@@ -508,14 +525,14 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 	{
 		plot_merge=true;
 		for (int i=0;i<num_vehicles;i++)
-			vehicle_list[i]->plot_data(plot_ostream_list[i],plot_merge);
+			vehicle_list[i]->plot_data(plot_ostream_list[i],plot_merge,1,0);
 	}
 	//writing last integration out to 'traj.asc' 
 	//with time set to '-1' for multiple CADAC-Studio plots
 	if(strstr(options,"y_traj"))
 	{
 		traj_merge=true;
-		traj_data(ftraj,combus,num_vehicles,traj_merge);
+		traj_data(ftraj,combus,num_vehicles,traj_merge,1,0);
 	}
 } 
 
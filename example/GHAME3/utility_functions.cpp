@@ -12,6 +12,7 @@
 //	cadine
 //	sign
 //	angle
+//Fixed-size 3x1 and 3x3 utility functions
 //Table look-up,'Table' and 'Datadeck' class member functions
 //Integration
 //US76 Atmosphere
@@ -1318,6 +1319,162 @@ double angle(Matrix VEC1,Matrix VEC2)
 	return acos(argument);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+////////////////// Fixed-size 3x1 and 3x3 utility functions //////////////////
+///////////////////////////////////////////////////////////////////////////////
+//Operate on 'double' arrays of 3 (vectors) and 9 (matrices, row by row)
+//without heap allocation. The arithmetic follows the 'Matrix' functions
+//term by term, so the results are identical
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+//Multiplies 3x3 matrix with 3x1 vector
+//'RESULT' must not be the same array as 'VEC'
+//Example: mat3vec(VBII,TIG,VBEG); (VBII=TIG*VBEG)
+///////////////////////////////////////////////////////////////////////////////
+void mat3vec(double *RESULT,double *AMAT,double *VEC)
+{
+	for(int i=0;i<3;i++){
+		RESULT[i]=0;
+		for(int k=0;k<3;k++)
+			RESULT[i]+=AMAT[3*i+k]*VEC[k];
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Multiplies two 3x3 matrices
+//'RESULT' must not be the same array as 'AMAT' or 'BMAT'
+//Example: mat3mat(TGI,TGE,TEI); (TGI=TGE*TEI)
+///////////////////////////////////////////////////////////////////////////////
+void mat3mat(double *RESULT,double *AMAT,double *BMAT)
+{
+	for(int i=0;i<9;i++){
+		int r=i/3;
+		int c=i%3;
+		RESULT[i]=0;
+		for(int k=0;k<3;k++)
+			RESULT[i]+=AMAT[3*r+k]*BMAT[3*k+c];
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Transposes 3x3 matrix
+//'RESULT' must not be the same array as 'AMAT'
+//Example: mat3trans(TIG,TGI);
+///////////////////////////////////////////////////////////////////////////////
+void mat3trans(double *RESULT,double *AMAT)
+{
+	for(int r=0;r<3;r++)
+		for(int c=0;c<3;c++)
+			RESULT[3*c+r]=AMAT[3*r+c];
+}
+///////////////////////////////////////////////////////////////////////////////
+//Returns polar from cartesian coordinates of 3x1 vector
+//POLAR = [magnitude, azimuth, elevation]
+//Example: pol_from_cart(POLAR,VBEG);
+///////////////////////////////////////////////////////////////////////////////
+void pol_from_cart(double *POLAR,double *VEC)
+{
+	double elevation=0.0;
+	double v1=VEC[0];
+	double v2=VEC[1];
+	double v3=VEC[2];
+
+	double d=sqrt(v1*v1+v2*v2+v3*v3);
+	double azimuth=atan2(v2,v1);
+
+	double denom=sqrt(v1*v1+v2*v2);
+	if(denom>0.)
+		elevation=atan2(-v3,denom);
+	else{
+		if(v3>0) elevation=-PI/2.;
+		if(v3<0) elevation=PI/2.;
+		if(v3==0) elevation=0.;
+	}
+	POLAR[0]=d;
+	POLAR[1]=azimuth;
+	POLAR[2]=elevation;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Returns the T.M. of the psivg -> thtvg sequence
+//Example: mat2tr(TVG,psivg,thtvg);
+///////////////////////////////////////////////////////////////////////////////
+void mat2tr(double *AMAT,double psivg,double thtvg)
+{
+	AMAT[2]=-sin(thtvg);
+	AMAT[3]=-sin(psivg);
+	AMAT[4]=cos(psivg);
+	AMAT[8]=cos(thtvg);
+	AMAT[0]=AMAT[8]*AMAT[4];
+	AMAT[1]=-AMAT[8]*AMAT[3];
+	AMAT[6]=-AMAT[2]*AMAT[4];
+	AMAT[7]=AMAT[2]*AMAT[3];
+	AMAT[5]=0.0;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Returns the T.M. of geographic wrt earth coordinates
+//Example: cadtge(TGE,lon,lat);
+///////////////////////////////////////////////////////////////////////////////
+void cadtge(double *AMAT,double lon,double lat)
+{
+	double clon=cos(lon);
+	double slon=sin(lon);
+	double clat=cos(lat);
+	double slat=sin(lat);
+
+	AMAT[0]=-slat*clon;
+	AMAT[1]=-slat*slon;
+	AMAT[2]=clat;
+	AMAT[3]=-slon;
+	AMAT[4]=clon;
+	AMAT[5]=0.0;
+	AMAT[6]=-clat*clon;
+	AMAT[7]=-clat*slon;
+	AMAT[8]=-slat;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Returns the T.M. of earth wrt inertial coordinates
+//Example: cadtei(TEI,time);
+///////////////////////////////////////////////////////////////////////////////
+void cadtei(double *TEI,double simulation_time)
+{
+	double xi=WEII3*simulation_time;
+	double sxi=sin(xi);
+	double cxi=cos(xi);
+
+	TEI[0]=cxi;  TEI[1]=sxi; TEI[2]=0;
+	TEI[3]=-sxi; TEI[4]=cxi; TEI[5]=0;
+	TEI[6]=0;    TEI[7]=0;   TEI[8]=1;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Returns lon, lat, alt from inertial displacement vector
+//Example: cadsph(LLA,SBIE);
+///////////////////////////////////////////////////////////////////////////////
+void cadsph(double *RESULT,double *SBIE)
+{
+	double alamda(0);
+	double x=SBIE[0];
+	double y=SBIE[1];
+	double z=SBIE[2];
+
+	//latitude and altitude
+	double dbi=sqrt(x*x+y*y+z*z);
+	double lat=asin((z)/dbi);
+	double alt=dbi-REARTH;
+
+	//longitude, resolving the multi-valued arcsin function
+	double dum4=asin(y/sqrt(x*x+y*y));
+	if((x>=0)&&(y>=0)) alamda=dum4;				//quadrant I
+	if((x<0)&&(y>=0)) alamda=180*RAD-dum4;		//quadrant II
+	if((x<0)&&(y<0)) alamda=180*RAD-dum4;		//quadrant III
+	if((x>=0)&&(y<0)) alamda=360*RAD+dum4;		//quadrant IV
+	double lon=alamda;
+	if(lon>180*RAD) lon= -(360*RAD-lon);		//east positive, west negative
+
+	RESULT[0]=lon;
+	RESULT[1]=lat;
+	RESULT[2]=alt;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////
 //////////////// Table look-up and interpolation functions ////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -12,6 +12,7 @@
 //	cadine
 //	sign
 //	angle
+//Fixed-size 3x1 and 3x3 utility functions
 //Table look-up, classes 'Table' and 'Datadeck'
 //Integration
 //US76 Atmosphere
@@ -322,6 +323,36 @@ int sign(const double &variable);
 //Example: theta=angle(VEC1,VEC2);
 double angle(Matrix VEC1,Matrix VEC2);
 
+///////////////////////////////////////////////////////////////////////////////
+////////////////// Fixed-size 3x1 and 3x3 utility functions //////////////////
+///////////////////////////////////////////////////////////////////////////////
+//'double' arrays of 3 (vectors) and 9 (matrices, row by row), no heap allocation
+//Results are identical to the corresponding 'Matrix' functions
+
+//Multiplies 3x3 matrix with 3x1 vector: RESULT=AMAT*VEC
+void mat3vec(double *RESULT,double *AMAT,double *VEC);
+
+//Multiplies two 3x3 matrices: RESULT=AMAT*BMAT
+void mat3mat(double *RESULT,double *AMAT,double *BMAT);
+
+//Transposes 3x3 matrix: RESULT=AMAT'
+void mat3trans(double *RESULT,double *AMAT);
+
+//Returns polar from cartesian coordinates: POLAR=[magnitude,azimuth,elevation]
+void pol_from_cart(double *POLAR,double *VEC);
+
+//Returns the T.M. of the psivg -> thtvg sequence
+void mat2tr(double *AMAT,double psivg,double thtvg);
+
+//Returns the T.M. of geographic wrt earth coordinates
+void cadtge(double *AMAT,double lon,double lat);
+
+//Returns the T.M. of earth wrt inertial coordinates 
+void cadtei(double *TEI,double simulation_time);
+
+//Returns lon, lat, alt from inertial displacement vector
+void cadsph(double *RESULT,double *SBIE);
+
 ///////////////////////////////////////////////////////////////////////////////
 ////////// Table look-up and interpolation function declarations //////////////
 ///////////////////////////////////////////////////////////////////////////////
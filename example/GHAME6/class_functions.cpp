@@ -32,6 +32,27 @@ Round6::Round6()
 	for(int i=0;i<NROUND6;i++)round6[i].init("empty",0," "," "," "," ");
 }
 ///////////////////////////////////////////////////////////////////////////////
+//Attaching the state derivatives of 'newton' to an output plan for dense output
+//
+//The first 'round6_count' entries of 'plan' must have been compiled from
+// 'round6[round6_ind[i]]'. Each integrated state receives its derivative:
+// SBII <- VBII, VBII <- ABII
+///////////////////////////////////////////////////////////////////////////////
+
+void Round6::dense_rates(Output *plan,int *round6_ind,int round6_count)
+{
+	int column(0);
+
+	for(int i=0;i<round6_count;i++)
+	{
+		int rate_ind(0);
+		if(round6_ind[i]==235) rate_ind=236;
+		else if(round6_ind[i]==236) rate_ind=237;
+		else continue;
+		plan[i].rate=round6[rate_ind].output(column).vec;
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
 //Constructor initializing the modules and the module-variable arrays
 //Reading input data from 'input.asc' and putting into 'round6' and 'hyper' arrays 
 //Writing banners to screen, 'tabout.asc' and to 'traj.asc' files  
@@ -137,6 +158,11 @@ Hyper::Hyper(Module *module_list,int num_modules,int num_satellite,int num_radar
 	round6_com_ind=new int[round6_com_count];
 	hyper_com_ind=new int[hyper_com_count];
 
+	//allocating memory for the output plans
+	scrn_plan=new Output[round6_scrn_count+hyper_scrn_count];
+	plot_plan=new Output[round6_plot_count+hyper_plot_count];
+	com_plan=new Output[round6_com_count+hyper_com_count];
+
 	//allocating memory for the 'grnd_range' array
 	grnd_range=new double[num_satellite];
 
@@ -167,9 +193,17 @@ Hyper::Hyper(Module *module_list,int num_modules,int num_satellite,int num_radar
 	com_index_arrays();
 
 	//initializing the indices in the 'markov_list' to large integers
-	for(i=0;i<NMARKOV;i++)
+	for(i=0;i<NMARKOV;i++){
 		markov_list[i].set_markov_round6_index(ILARGE);
+		markov_list[i].set_markov_vehicle_index(ILARGE);
+	}
 	nmarkov=0;
+
+	//saving the defined module-variables for resetting in place
+	round6_def=new Variable[NROUND6];
+	hyper_def=new Variable[NHYPER];
+	for(i=0;i<NROUND6;i++) round6_def[i]=round6[i];
+	for(i=0;i<NHYPER;i++) hyper_def[i]=hyper[i];
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Destructor deallocating dynamic memory
@@ -188,11 +222,46 @@ Hyper::~Hyper()
 	delete [] com_hyper6;
 	delete [] round6_scrn_ind;
 	delete [] hyper_scrn_ind;
+	delete [] round6_plot_ind;
 	delete [] hyper_plot_ind;
 	delete [] round6_com_ind;
 	delete [] hyper_com_ind;
+	delete [] scrn_plan;
+	delete [] plot_plan;
+	delete [] com_plan;
 	delete [] grnd_range;
-	delete [] &event_ptr_list;
+	for(int i=0;i<NEVENT;i++) delete event_ptr_list[i];
+	delete [] round6_def;
+	delete [] hyper_def;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Resetting a pooled vehicle object in place for the next Monte Carlo run
+//Restores the module-variable values to their state after the module
+// definitions, re-draws the random ones and clears the events, Markov
+// variables and trim request that 'vehicle_data()' rebuilds. The output arrays
+// depend only on the definitions and are kept; so are the aero and propulsion
+// tables, which are read only once per vehicle object.
+///////////////////////////////////////////////////////////////////////////////
+
+void Hyper::reset(Module *module_list,int num_modules)
+{
+	int i(0);
+	for(i=0;i<NROUND6;i++) round6[i].restore(round6_def[i]);
+	for(i=0;i<NHYPER;i++) hyper[i].restore(hyper_def[i]);
+
+	nevent=0;
+	event_total=0;
+	for(i=0;i<NMARKOV;i++){
+		markov_list[i].set_markov_round6_index(ILARGE);
+		markov_list[i].set_markov_vehicle_index(ILARGE);
+	}
+	nmarkov=0;
+	trimming=Trim();
+
+	//re-drawing the INS instrument errors, which the definitions draw at random
+	for(int j=0;j<num_modules;j++)
+		if((module_list[j].name=="ins")&&(module_list[j].definition=="def"))
+			def_ins();
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Constructor allocating array memory and initializing  
@@ -211,6 +280,28 @@ Round3::Round3()
 	for(int i=0;i<NROUND3;i++)round3[i].init("empty",0," "," "," "," ");
 }
 ///////////////////////////////////////////////////////////////////////////////
+//Attaching the state derivatives of 'newton' to an output plan for dense output
+//
+//The first 'round3_count' entries of 'plan' must have been compiled from
+// 'round3[round3_ind[i]]'. Each integrated state receives its derivative:
+// SBII <- VBII, VBII <- ABII, SBEG <- VBEG
+///////////////////////////////////////////////////////////////////////////////
+
+void Round3::dense_rates(Output *plan,int *round3_ind,int round3_count)
+{
+	int column(0);
+
+	for(int i=0;i<round3_count;i++)
+	{
+		int rate_ind(0);
+		if(round3_ind[i]==35) rate_ind=36;
+		else if(round3_ind[i]==36) rate_ind=37;
+		else if(round3_ind[i]==31) rate_ind=32;
+		else continue;
+		plan[i].rate=round3[rate_ind].output(column).vec;
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
 //Constructor initializing the modules and the module-variable arrays
 //				  
 //010205 Created by Peter H Zipfel
@@ -246,12 +337,20 @@ Satellite::Satellite(Module *module_list,int num_modules)
 	round3_com_ind=new int[round3_com_count];
 	satellite_com_ind=new int[satellite_com_count];
 
+	//allocating memory for the output plan
+	com_plan=new Output[round3_com_count+satellite_com_count];
+
 	com_satellite3=new Variable[ncom_satellite3];
 	if(!com_satellite3){cerr<<"*** Error: com_hyper6[] allocation failed *** \n";system("pause");exit(1);}
 
 	//building the index arrays of the data to be loaded into the packets of 'combus'
 	com_index_arrays();
 
+	//saving the defined module-variables for resetting in place
+	round3_def=new Variable[NROUND3];
+	satellite_def=new Variable[NSAT];
+	for(int i=0;i<NROUND3;i++) round3_def[i]=round3[i];
+	for(int i=0;i<NSAT;i++) satellite_def[i]=satellite[i];
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Constructor allocating array memory and initializing  
@@ -300,12 +399,20 @@ Radar::Radar(Module *module_list,int num_modules)
 	ground0_com_ind=new int[ground0_com_count]; 
 	radar_com_ind=new int[radar_com_count];
 
+	//allocating memory for the output plan
+	com_plan=new Output[ground0_com_count+radar_com_count];
+
 	com_radar0=new Variable[ncom_radar0];
 	if(!com_radar0){cerr<<"*** Error: com_hyper6[] allocation failed *** \n";system("pause");exit(1);}
 
 	//building the index arrays of the data to be loaded into the packets of 'combus'
 	com_index_arrays();
 
+	//saving the defined module-variables for resetting in place
+	ground0_def=new Variable[NGROUND0];
+	radar_def=new Variable[NRADAR];
+	for(int i=0;i<NGROUND0;i++) ground0_def[i]=ground0[i];
+	for(int i=0;i<NRADAR;i++) radar_def[i]=radar[i];
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Destructor deallocating dynamic memory
@@ -319,7 +426,20 @@ Satellite::~Satellite()
 	delete [] round3;
 	delete [] round3_com_ind;
 	delete [] satellite_com_ind;
+	delete [] com_plan;
 	delete [] com_satellite3;
+	delete [] round3_def;
+	delete [] satellite_def;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Resetting a pooled vehicle object in place for the next Monte Carlo run
+///////////////////////////////////////////////////////////////////////////////
+
+void Satellite::reset(Module *module_list,int num_modules)
+{
+	int i(0);
+	for(i=0;i<NROUND3;i++) round3[i].restore(round3_def[i]);
+	for(i=0;i<NSAT;i++) satellite[i].restore(satellite_def[i]);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -334,7 +454,20 @@ Radar::~Radar()
 	delete [] ground0;
 	delete [] ground0_com_ind;
 	delete [] radar_com_ind;
+	delete [] com_plan;
 	delete [] com_radar0;
+	delete [] ground0_def;
+	delete [] radar_def;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Resetting a pooled vehicle object in place for the next Monte Carlo run
+///////////////////////////////////////////////////////////////////////////////
+
+void Radar::reset(Module *module_list,int num_modules)
+{
+	int i(0);
+	for(i=0;i<NGROUND0;i++) ground0[i].restore(ground0_def[i]);
+	for(i=0;i<NRADAR;i++) radar[i].restore(radar_def[i]);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
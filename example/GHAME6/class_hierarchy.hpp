@@ -91,12 +91,15 @@ public:
 	virtual void tabout_banner(ofstream &ftabout,char *title,int &nmonte,int &nmc)=0;
 	virtual void tabout_data(ofstream &ftabout)=0;
 	virtual void vehicle_data(fstream &input,int nmonte)=0;
+	virtual void reset(Module *module_list,int num_modules)=0;
+	virtual void trim(Module *module_list,int num_modules)=0;
 	virtual void read_tables(char *file_name,Datadeck &datatable)=0;
 	virtual void scrn_index_arrays()=0;
 	virtual void scrn_data()=0;
 	virtual void plot_banner(ofstream &fplot,char *title)=0;
 	virtual void plot_index_arrays()=0;
-	virtual void plot_data(ofstream &fplot,bool merge)=0;
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step)=0;
+	virtual void record_output()=0;
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot)=0;
 	virtual void event(char *options)=0;
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle)=0;
@@ -187,12 +190,15 @@ public:
 	virtual void tabout_banner(ofstream &ftabout,char *title,int &nmonte,int &nmc)=0;
 	virtual void tabout_data(ofstream &ftabout)=0;
 	virtual void vehicle_data(fstream &input,int nmonte)=0;
+	virtual void reset(Module *module_list,int num_modules)=0;
+	virtual void trim(Module *module_list,int num_modules)=0;
 	virtual void read_tables(char *file_name,Datadeck &datatable)=0;
 	virtual void scrn_index_arrays()=0;
 	virtual void scrn_data()=0;
 	virtual void plot_banner(ofstream &fplot,char *title)=0;
 	virtual void plot_index_arrays()=0;
-	virtual void plot_data(ofstream &fplot,bool merge)=0;
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step)=0;
+	virtual void record_output()=0;
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot)=0;
 	virtual void event(char *options)=0;
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle)=0;
@@ -248,6 +254,9 @@ public:
 
 	//functions in respective modules
 	Matrix environment_dryden(double dvba,double int_step); 
+
+	//attaching the state derivatives of 'newton' to an output plan
+	void dense_rates(Output *plan,int *round6_ind,int round6_count);
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -300,6 +309,15 @@ protected:
 	//be written to 'combus' 'packets'
 	int *hyper_com_ind; int hyper_com_count;
 
+	//output plans compiled by the index arrays and executed by the writers
+	Output *scrn_plan; int nscrn_plan;
+	Output *plot_plan; int nplot_plan;
+	Output *com_plan; int ncom_plan;
+
+	//module-variable arrays after the module definitions, restored by 'reset()'
+	Variable *round6_def;
+	Variable *hyper_def;
+
 	//array of ground distances of 'Hyper' object from all 'Satellite' objects
 	double *grnd_range;
 
@@ -312,6 +330,11 @@ protected:
 	Datadeck aerotable;
 	//	declaring Datadeck 'proptable' that stores all aero tables
 	Datadeck proptable;
+	//	declaring Datadeck 'gaintable' that stores the gamma control gain schedule
+	Datadeck gaintable;
+
+	//trim request of the initial conditions ('TRIM' block of 'input.asc')
+	Trim trimming;
 
 public:
 	Hyper(){};
@@ -327,12 +350,15 @@ public:
 	virtual void tabout_banner(ofstream &ftabout,char *title,int &nmonte,int &nmc);
 	virtual void tabout_data(ofstream &ftabout);
 	virtual void vehicle_data(fstream &input,int nmonte);
+	virtual void reset(Module *module_list,int num_modules);
+	virtual void trim(Module *module_list,int num_modules);
 	virtual void read_tables(char *file_name,Datadeck &datatable);
 	virtual void scrn_index_arrays();
 	virtual void scrn_data();
 	virtual void plot_banner(ofstream &fplot,char *title);
 	virtual void plot_index_arrays();
-	virtual void plot_data(ofstream &fplot,bool merge);
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step);
+	virtual void record_output();
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot);
 	virtual void event(char *options);
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle);
@@ -384,6 +410,15 @@ public:
 	double control_lateral_accel(double alcomx);
 	double control_normal_accel(double ancomx,double int_step);
 	double control_gamma(double thtvdcomx);
+	void control_gamma_gains(Matrix &GAINGAM,double &gainff,double dla,double dlde,
+		double dma,double dmq,double dmde,double dvbec,double pgam,double wgam,double zgam);
+	double control_gamma_speed(double vmach,double pdynmc);
+	void control_gamma_plant(double &dla,double &dlde,double &dma,double &dmq,double &dmde,
+		double dvba,double vmach,double alphax,double pdynmc,double vmass);
+	void control_gamma_schedule();
+	void control_gamma_lookup(Matrix &GAINGAM,double &gainff,double vmach,double alphax,
+		double pdynmc,double vmass);
+	double control_gamma_error(Matrix GAINGAM,double gainff,Matrix GAINPP,double gainffpp);
 	double control_heading(double psivdcomx);
 	double control_altitude(double altcom);
 
@@ -429,7 +464,7 @@ public:
 	Matrix guidance_AGL(Matrix &UTBBC, Matrix STBIK,Matrix VTBIK);
 
 	void gps_sv_init(double *sv_init_data,double &rsi,double &wsi,double &incl);
-	void gps_quadriga(double *ssii_quad,double *vsii_quad,double &gdop,int &mgps 
+	void gps_quadriga(double *ssii_quad,double *vsii_quad,double &gdop,int &mgps,int *quad_slot 
 						,const double *sv_init_data,const double &rsi,const double &wsi
 						,const double &incl,double almanac_time,double del_rearth
 						,double time,Matrix SBII);
@@ -446,6 +481,19 @@ public:
 	void seeker_kin(double &azob,double &elob,double &dab,double &ddab,Matrix SBTL);
 	void seeker_filter(Matrix &STBIK,Matrix &VTBIK
 			,double azab,double elabx,double dab,double ddab,int mseek,double int_step);
+
+	//trim functions
+	void trim_data(fstream &input);
+	void trim_element(char *name,char *kind,int &count,string *names,int *locs,int *comps);
+	Variable &trim_variable(int loc);
+	double trim_get(int loc,int comp);
+	void trim_put(int loc,int comp,double value);
+	void trim_pass(Module *module_list,int num_modules);
+	void trim_residuals(Variable *round6_start,Variable *hyper_start,Module *module_list,int num_modules,
+		double *u,double *r);
+	void trim_jacobian(Variable *round6_start,Variable *hyper_start,Module *module_list,int num_modules,
+		double *u,double *J);
+	bool trim_solve(double *J,double *r,double *du);
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -479,12 +527,15 @@ public:
 	virtual void tabout_banner(ofstream &ftabout,char *title,int &nmonte,int &nmc)=0;
 	virtual void tabout_data(ofstream &ftabout)=0;
 	virtual void vehicle_data(fstream &input,int nmonte)=0;
+	virtual void reset(Module *module_list,int num_modules)=0;
+	virtual void trim(Module *module_list,int num_modules)=0;
 	virtual void read_tables(char *file_name,Datadeck &datatable)=0;
 	virtual void scrn_index_arrays()=0;
 	virtual void scrn_data()=0;
 	virtual void plot_banner(ofstream &fplot,char *title)=0;
 	virtual void plot_index_arrays()=0;
-	virtual void plot_data(ofstream &fplot,bool merge)=0;
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step)=0;
+	virtual void record_output()=0;
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot)=0;
 	virtual void event(char *options)=0;
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle)=0;
@@ -531,6 +582,9 @@ public:
 	virtual void def_environment();
 	virtual void init_environment(){};
 	virtual void environment(double int_step);
+
+	//attaching the state derivatives of 'newton' to an output plan
+	void dense_rates(Output *plan,int *round3_ind,int round3_count);
 };
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -559,6 +613,13 @@ protected:
 	//be written to 'combus' 'packets'
 	int *satellite_com_ind; int satellite_com_count;
 
+	//output plan of 'com' compiled by 'com_index_arrays()', executed by 'traj_data()'
+	Output *com_plan; int ncom_plan;
+
+	//module-variable arrays after the module definitions, restored by 'reset()'
+	Variable *round3_def;
+	Variable *satellite_def;
+
 public:
 	Satellite(){};
 	Satellite(Module *module_list,int num_modules);
@@ -575,7 +636,8 @@ public:
 	virtual void scrn_data(){};
 	virtual void plot_banner(ofstream &fplot,char *title){};
 	virtual void plot_index_arrays(){};
-	virtual void plot_data(ofstream &fplot,bool merge){};
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step){};
+	virtual void record_output();
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot){};
 	virtual void event(char *options){};
 	virtual void markov_noise(double sim_time,double int_step,int nmonte){};
@@ -583,6 +645,8 @@ public:
 	//executive functions active
 	virtual void sizing_arrays();
 	virtual void vehicle_data(fstream &input,int nmonte);
+	virtual void reset(Module *module_list,int num_modules);
+	virtual void trim(Module *module_list,int num_modules){};
 	virtual void read_tables(char *file_name,Datadeck &datatable){};
 	virtual void com_index_arrays();
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle);
@@ -656,12 +720,15 @@ public:
 	virtual void tabout_banner(ofstream &ftabout,char *title,int &nmonte,int &nmc)=0;
 	virtual void tabout_data(ofstream &ftabout)=0;
 	virtual void vehicle_data(fstream &input,int nmonte)=0;
+	virtual void reset(Module *module_list,int num_modules)=0;
+	virtual void trim(Module *module_list,int num_modules)=0;
 	virtual void read_tables(char *file_name,Datadeck &datatable)=0;
 	virtual void scrn_index_arrays()=0;
 	virtual void scrn_data()=0;
 	virtual void plot_banner(ofstream &fplot,char *title)=0;
 	virtual void plot_index_arrays()=0;
-	virtual void plot_data(ofstream &fplot,bool merge)=0;
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step)=0;
+	virtual void record_output()=0;
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot)=0;
 	virtual void event(char *options)=0;
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle)=0;
@@ -737,6 +804,13 @@ protected:
 	//be written to 'combus' 'packets'
 	int *radar_com_ind; int radar_com_count;
 
+	//output plan of 'com' compiled by 'com_index_arrays()', executed by 'traj_data()'
+	Output *com_plan; int ncom_plan;
+
+	//module-variable arrays after the module definitions, restored by 'reset()'
+	Variable *ground0_def;
+	Variable *radar_def;
+
 public:
 	Radar(){};
 	Radar(Module *module_list,int num_modules);
@@ -753,7 +827,8 @@ public:
 	virtual void scrn_data(){};
 	virtual void plot_banner(ofstream &fplot,char *title){};
 	virtual void plot_index_arrays(){};
-	virtual void plot_data(ofstream &fplot,bool merge){};
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step){};
+	virtual void record_output();
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot){};
 	virtual void event(char *options){};
 	virtual void markov_noise(double sim_time,double int_step,int nmonte){};
@@ -761,6 +836,8 @@ public:
 	//executive functions active
 	virtual void sizing_arrays();
 	virtual void vehicle_data(fstream &input,int nmonte);
+	virtual void reset(Module *module_list,int num_modules);
+	virtual void trim(Module *module_list,int num_modules){};
 	virtual void read_tables(char *file_name,Datadeck &datatable){};
 	virtual void com_index_arrays();
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle);
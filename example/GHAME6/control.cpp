@@ -29,6 +29,11 @@
 //   			 mroll= 0 roll position control (default)
 //					  = 1 roll rate control
 //
+// Flight path angle control gains (mautp=4)
+//		mgain = 0 pole placement every integration step (default)
+//			  = 1 gains interpolated from the gain schedule 'gaintable'
+//			  = 2 scheduled gains, checked against pole placement every step
+//
 // 030520 Created by Peter H Zipfel
 // /////////////////////////////////////////////////////////////////////////////
  
@@ -99,6 +104,10 @@ void Hyper::def_control()
 	hyper[565].init("zgam",0,"Damping of gamma close loop complex pole - rad/s","control","data","");
 	hyper[566].init("GAINGAM",0,0,0,"Gamma fbck gain of q, theta and gamma","control","diag","");
 	hyper[567].init("gainff",0,"Gamma feed-forward gain","control","diag","");
+	hyper[568].init("mgain","int",0,"=0:Pole placement; =1:Gain schedule; =2:Schedule+check","control","data","");
+	hyper[569].init("igain","int",0,"Flag set when gain schedule is built","control","init","");
+	hyper[570].init("gainerr0",0,"Max gain schedule error at mid-cells (startup) - ND","control","diag","");
+	hyper[571].init("gainerr",0,"Max error scheduled vs pole placement gains - ND","control","diag","");
 
 }
 ///////////////////////////////////////////////////////////////////////////////
@@ -540,13 +549,6 @@ double Hyper::control_lateral_accel(double alcomx)
 
 double Hyper::control_gamma(double thtvdcomx)
 {
-	//local variables
-	Matrix AA(3,3);
-	Matrix BB(3,1);
-	Matrix DP(3,3);
-	Matrix DD(3,1);
-	Matrix HH(3,1);
-
 	//local module-variables
 	Matrix GAINGAM(3,1);
 	double gainff=0;
@@ -556,10 +558,18 @@ double Hyper::control_gamma(double thtvdcomx)
 	double pgam=hyper[563].real();
 	double wgam=hyper[564].real();
 	double zgam=hyper[565].real();
+	int mgain=hyper[568].integer();
+	//initialization
+	int igain=hyper[569].integer();
+	//diagnostics
+	double gainerr=hyper[571].real();
 	//input from other modules
 	double time=round6[0].real();
+	double vmach=round6[56].real();
 	double pdynmc=round6[57].real();
+	double alphax=round6[144].real();
 	double dvbe=round6[225].real();
+	double vmass=hyper[15].real();
 	double dla=hyper[145].real();
 	double dlde=hyper[146].real();
 	double dma=hyper[147].real();
@@ -573,7 +583,77 @@ double Hyper::control_gamma(double thtvdcomx)
 
 	//prevent division by zero
 	if(dvbec==0)dvbec=dvbe;
-	
+
+	if(mgain==0){
+		//feedback and feed-forward gains from closed-loop pole placement
+		control_gamma_gains(GAINGAM,gainff,dla,dlde,dma,dmq,dmde,dvbec,pgam,wgam,zgam);
+	}
+	else{
+		//building the gain schedule on first call
+		if(!igain){
+			control_gamma_schedule();
+			igain=1;
+		}
+		//interpolating the gains at the present flight condition
+		control_gamma_lookup(GAINGAM,gainff,vmach,alphax,pdynmc,vmass);
+
+		//accuracy check against the pole placement gains
+		if(mgain==2){
+			Matrix GAINPP(3,1);
+			double gainffpp(0);
+			control_gamma_gains(GAINPP,gainffpp,dla,dlde,dma,dmq,dmde,dvbec,pgam,wgam,zgam);
+			double err=control_gamma_error(GAINGAM,gainff,GAINPP,gainffpp);
+			if(err>gainerr) gainerr=err;
+		}
+	}
+
+	//pitch control command
+	double thtc=gainff*thtvdcomx*RAD;
+	double qqf=GAINGAM.get_loc(0,0)*qqcx*RAD;
+	double thtbgf=GAINGAM.get_loc(1,0)*thtbdcx*RAD;
+	double thtugf=GAINGAM.get_loc(2,0)*thtvdcx*RAD;
+	double delec=thtc-(qqf+thtbgf+thtugf);
+	double delecx=delec*DEG;
+
+	//--------------------------------------------------------------------------
+	//loading module-variables
+	//initialization
+	hyper[569].gets(igain);
+	//diagnostics
+	hyper[566].gets_vec(GAINGAM);
+	hyper[567].gets(gainff);
+	hyper[571].gets(gainerr);
+
+	return delecx;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Pole placement gains of the flight path angle controller
+//Solves for the three feedback gains that place the closed loop poles at the
+// conjugate complex pair 'wgam','zgam' and the real pole 'pgam', and for the
+// feed-forward gain that achieves unit steady-state gamma response
+//
+//Parameter output:
+//         GAINGAM = feedback gains of q, theta and gamma
+//         gainff = feed-forward gain
+//Parameter input:
+//         dla,dlde,dma,dmq,dmde = pitch plane dimensional derivatives
+//         dvbec = vehicle speed - m/s
+//         pgam,wgam,zgam = closed loop poles
+//
+//020614 Created by Peter H Zipfel 
+///////////////////////////////////////////////////////////////////////////////
+
+void Hyper::control_gamma_gains(Matrix &GAINGAM,double &gainff,double dla,double dlde,
+							   double dma,double dmq,double dmde,double dvbec,
+							   double pgam,double wgam,double zgam)
+{
+	//local variables
+	Matrix AA(3,3);
+	Matrix BB(3,1);
+	Matrix DP(3,3);
+	Matrix DD(3,1);
+	Matrix HH(3,1);
+
 	//building fundamental matrices (body rate, acceleration, fin deflection)
 	AA.build_mat33(dmq,dma,-dma,1.,0.,0.,0.,dla/dvbec,-dla/dvbec);
 	BB.build_vec3(dmde,0.,dlde/dvbec);
@@ -603,22 +683,290 @@ double Hyper::control_gamma(double thtvdcomx)
 	HH.build_vec3(0.,0.,1.);
 	double denom=HH^DUM3;
 	gainff=-1./denom;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Speed at a scheduling point
+//Mach and dynamic pressure fix the static pressure, press=pdynmc/(0.7*vmach^2);
+// the US76 atmosphere is searched for that pressure altitude
+//
+//Return output:
+//         dvba = speed - m/s
+//Parameter input:
+//         vmach = Mach number
+//         pdynmc = dynamic pressure - Pa
+///////////////////////////////////////////////////////////////////////////////
 
-	//pitch control command
-	double thtc=gainff*thtvdcomx*RAD;
-	double qqf=GAINGAM.get_loc(0,0)*qqcx*RAD;
-	double thtbgf=GAINGAM.get_loc(1,0)*thtbdcx*RAD;
-	double thtugf=GAINGAM.get_loc(2,0)*thtvdcx*RAD;
-	double delec=thtc-(qqf+thtbgf+thtugf);
-	double delecx=delec*DEG;
+double Hyper::control_gamma_speed(double vmach,double pdynmc)
+{
+	double press=pdynmc/(0.7*vmach*vmach);
+	double rho(0),pressa(0),tempk(0);
+	double alt0=0;
+	double alt1=84000;
+	for(int i=0;i<40;i++){
+		double alt=(alt0+alt1)/2;
+		atmosphere76(rho,pressa,tempk,alt);
+		if(pressa>press) alt0=alt;
+		else alt1=alt;
+	}
+	atmosphere76(rho,pressa,tempk,(alt0+alt1)/2);
 
-	//--------------------------------------------------------------------------
+	return sqrt(2*pdynmc/rho);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Pitch plane dimensional derivatives at a scheduling point
+//Same aero table look-up as 'aerodynamics' and same derivatives as
+// 'aerodynamics_der'; the pitch moment of inertia is interpolated with
+// fuel expended as in 'propulsion'
+//
+//Parameter output:
+//         dla,dlde,dma,dmq,dmde = pitch plane dimensional derivatives
+//Parameter input:
+//         dvba = speed - m/s
+//         vmach = Mach number
+//         alphax = angle of attack - deg
+//         pdynmc = dynamic pressure - Pa
+//         vmass = vehicle mass - kg
+///////////////////////////////////////////////////////////////////////////////
+
+void Hyper::control_gamma_plant(double &dla,double &dlde,double &dma,double &dmq,double &dmde,
+							   double dvba,double vmach,double alphax,double pdynmc,double vmass)
+{
+	//localizing module-variables
+	//from initialization
+	double refa=hyper[104].real();
+	double refc=hyper[106].real();
+	double vmass0=hyper[16].real();
+	double fmass0=hyper[21].real();
+	Matrix IBBB0=hyper[19].mat();
+	Matrix IBBB1=hyper[20].mat();
+	//-------------------------------------------------------------------------
+	double cla=aerotable.look_up("cla_vs_alpha_mach",alphax,vmach);
+	double clde=aerotable.look_up("clde_vs_alpha_mach",alphax,vmach);
+	double cma=aerotable.look_up("cma_vs_alpha_mach",alphax,vmach);
+	double cmde=aerotable.look_up("cmde_vs_alpha_mach",alphax,vmach);
+	double cmq=aerotable.look_up("cmq_vs_alpha_mach",alphax,vmach);
+
+	double mass_ratio=(vmass0-vmass)/fmass0;
+	double ibbb22=IBBB0.get_loc(1,1)+(IBBB1.get_loc(1,1)-IBBB0.get_loc(1,1))*mass_ratio;
+
+	double duml=(pdynmc*refa/vmass)/RAD;
+	dla=duml*cla;
+	dlde=duml*clde;
+	double dumm=pdynmc*refa*refc/ibbb22;
+	dma=dumm*cma/RAD;
+	dmq=dumm*(refc/(2.*dvba))*cmq;
+	dmde=dumm*cmde/RAD;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Building the gain schedule of the flight path angle controller
+//Sweeps the flight envelope in Mach, angle of attack, dynamic pressure and
+// mass, designs the gains by pole placement at each point and stores them in
+// 'Datadeck gaintable'. Each gain has one 3DIM table over Mach, alpha and
+// dynamic pressure per mass breakpoint; the mass breakpoints span burn-out to
+// gross mass. Table slot = NGAIN*(mass breakpoint)+(gain), with the gains
+// ordered q, theta, gamma feedback and feed-forward.
+//The gains fall off roughly with 1/pdynmc^2; the tables hold gain*pdynmc^2,
+// which is nearly linear between breakpoints.
+//
+//Accuracy check: at the center of every cell the interpolated gains are
+// compared with the pole placement design; the largest and the mean relative
+// error are displayed, the largest is stored in 'gainerr0'. The largest errors
+// occur where the pole placement itself is near singular (transonic, high
+// dynamic pressure at burn-out mass), outside of the GHAME ascent corridor.
+///////////////////////////////////////////////////////////////////////////////
+
+void Hyper::control_gamma_schedule()
+{
+	//local variables
+	double mach_tab[33]={0.4,0.5,0.6,0.7,0.8,0.85,0.9,0.95,1,1.05,1.1,1.2,1.35,1.5,1.75,2,2.25,2.5,2.75,
+						3,3.5,4,4.5,5,6,7,8,10,12,14,17,20,24};
+	double alpha_tab[9]={-3,0,3,6,9,12,15,18,21};
+	double pdynmc_tab[17]={500,700,1000,1400,2000,2800,4000,5600,8000,11000,16000,
+						   22000,31000,43000,58000,75000,95000};
+	int nmach(33),nalpha(9),npdynmc(17);
+	string gain_names[NGAIN]={"gainq","gaintht","gaingam","gainff"};
+	Matrix GAINGAM(3,1);
+	double gainff(0);
+	double dla(0),dlde(0),dma(0),dmq(0),dmde(0);
+
+	//local module-variables
+	double gainerr0(0);
+
+	//localizing module-variables
+	//input data
+	double pgam=hyper[563].real();
+	double wgam=hyper[564].real();
+	double zgam=hyper[565].real();
+	double vmass0=hyper[16].real();
+	double fmass0=hyper[21].real();
+	//-------------------------------------------------------------------------
+	//creating the table deck
+	gaintable.set_title("Flight path angle control gain schedule");
+	gaintable.set_capacity(NGAIN*NGAIN_MASS);
+	gaintable.alloc_mem();
+	for(int k=0;k<NGAIN_MASS;k++){
+		for(int g=0;g<NGAIN;g++){
+			char buff[CHARL];
+			sprintf(buff,"%s_vs_mach_alpha_pdynmc_m%i",gain_names[g].c_str(),k);
+			table=new Table;
+			table->set_dim(3);
+			table->set_name(buff);
+			table->set_var1_dim(nmach);
+			table->set_var2_dim(nalpha);
+			table->set_var3_dim(npdynmc);
+			table->var1_values=new double [nmach];
+			table->var2_values=new double [nalpha];
+			table->var3_values=new double [npdynmc];
+			table->data=new double[nmach*nalpha*npdynmc];
+			for(int i=0;i<nmach;i++) table->set_var1_value(i,mach_tab[i]);
+			for(int j=0;j<nalpha;j++) table->set_var2_value(j,alpha_tab[j]);
+			for(int l=0;l<npdynmc;l++) table->set_var3_value(l,pdynmc_tab[l]);
+			gaintable.set_counter(NGAIN*k+g);
+			gaintable.add_table(*table);
+		}
+	}
+
+	//pole placement design at every breakpoint
+	for(int i=0;i<nmach;i++){
+		for(int l=0;l<npdynmc;l++){
+			double dvba=control_gamma_speed(mach_tab[i],pdynmc_tab[l]);
+			for(int j=0;j<nalpha;j++){
+				for(int k=0;k<NGAIN_MASS;k++){
+					double vmass=vmass0-fmass0+fmass0*k/(NGAIN_MASS-1);
+					control_gamma_plant(dla,dlde,dma,dmq,dmde,dvba,mach_tab[i],alpha_tab[j],pdynmc_tab[l],vmass);
+					control_gamma_gains(GAINGAM,gainff,dla,dlde,dma,dmq,dmde,dvba,pgam,wgam,zgam);
+					int offset=i*nalpha*npdynmc+j*npdynmc+l;
+					double qsq=pdynmc_tab[l]*pdynmc_tab[l];
+					gaintable[NGAIN*k]->set_data(offset,GAINGAM.get_loc(0,0)*qsq);
+					gaintable[NGAIN*k+1]->set_data(offset,GAINGAM.get_loc(1,0)*qsq);
+					gaintable[NGAIN*k+2]->set_data(offset,GAINGAM.get_loc(2,0)*qsq);
+					gaintable[NGAIN*k+3]->set_data(offset,gainff*qsq);
+				}
+			}
+		}
+	}
+
+	//accuracy check at the cell centers
+	Matrix GAINPP(3,1);
+	double gainffpp(0);
+	double errsum(0);
+	int ncell(0);
+	for(int i=0;i<nmach-1;i++){
+		for(int l=0;l<npdynmc-1;l++){
+			double vmach=(mach_tab[i]+mach_tab[i+1])/2;
+			double pdynmc=(pdynmc_tab[l]+pdynmc_tab[l+1])/2;
+			double dvba=control_gamma_speed(vmach,pdynmc);
+			for(int j=0;j<nalpha-1;j++){
+				for(int k=0;k<NGAIN_MASS-1;k++){
+					double alphax=(alpha_tab[j]+alpha_tab[j+1])/2;
+					double vmass=vmass0-fmass0+fmass0*(k+0.5)/(NGAIN_MASS-1);
+					control_gamma_plant(dla,dlde,dma,dmq,dmde,dvba,vmach,alphax,pdynmc,vmass);
+					control_gamma_gains(GAINPP,gainffpp,dla,dlde,dma,dmq,dmde,dvba,pgam,wgam,zgam);
+					control_gamma_lookup(GAINGAM,gainff,vmach,alphax,pdynmc,vmass);
+					double err=control_gamma_error(GAINGAM,gainff,GAINPP,gainffpp);
+					if(err>gainerr0) gainerr0=err;
+					errsum+=err;
+					ncell++;
+				}
+			}
+		}
+	}
+	cout<<" *** Gamma control gain schedule: "<<nmach*nalpha*npdynmc*NGAIN_MASS<<" designs over Mach "
+		<<mach_tab[0]<<"-"<<mach_tab[nmach-1]<<", alpha "<<alpha_tab[0]<<"-"<<alpha_tab[nalpha-1]
+		<<" deg, pdynmc "<<pdynmc_tab[0]<<"-"<<pdynmc_tab[npdynmc-1]<<" Pa, vmass "
+		<<vmass0-fmass0<<"-"<<vmass0<<" kg ***\n";
+	cout<<"     Relative gain error at "<<ncell<<" mid-cells: max gainerr0 = "<<gainerr0
+		<<"  mean = "<<errsum/ncell<<'\n';
+	//-------------------------------------------------------------------------
 	//loading module-variables
 	//diagnostics
-	hyper[566].gets_vec(GAINGAM);
-	hyper[567].gets(gainff);
+	hyper[570].gets(gainerr0);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Interpolating the flight path angle control gains from the gain schedule
+//The flight condition is held to the swept envelope (no extrapolation).
+//All tables share their breakpoints, so the table indices are found once and
+// the tables are interpolated by slot without the name search of 'look_up'.
+// Linear interpolation between the two bracketing mass breakpoints, then
+// division by pdynmc^2 restores the gains.
+//
+//Parameter output:
+//         GAINGAM = feedback gains of q, theta and gamma
+//         gainff = feed-forward gain
+//Parameter input:
+//         vmach = Mach number
+//         alphax = angle of attack - deg
+//         pdynmc = dynamic pressure - Pa
+//         vmass = vehicle mass - kg
+///////////////////////////////////////////////////////////////////////////////
 
-	return delecx;
+void Hyper::control_gamma_lookup(Matrix &GAINGAM,double &gainff,double vmach,double alphax,
+								double pdynmc,double vmass)
+{
+	//local variables
+	double gain[NGAIN];
+
+	//localizing module-variables
+	//input data
+	double vmass0=hyper[16].real();
+	double fmass0=hyper[21].real();
+	//-------------------------------------------------------------------------
+	Table *tbl=gaintable.get_tbl(0);
+	int max1=tbl->get_var1_dim()-1;
+	int max2=tbl->get_var2_dim()-1;
+	int max3=tbl->get_var3_dim()-1;
+	if(vmach<tbl->var1_values[0]) vmach=tbl->var1_values[0];
+	if(vmach>tbl->var1_values[max1]) vmach=tbl->var1_values[max1];
+	if(alphax<tbl->var2_values[0]) alphax=tbl->var2_values[0];
+	if(alphax>tbl->var2_values[max2]) alphax=tbl->var2_values[max2];
+	if(pdynmc<tbl->var3_values[0]) pdynmc=tbl->var3_values[0];
+	if(pdynmc>tbl->var3_values[max3]) pdynmc=tbl->var3_values[max3];
+	int loc1=gaintable.find_index(max1,vmach,tbl->var1_values);
+	int loc2=gaintable.find_index(max2,alphax,tbl->var2_values);
+	int loc3=gaintable.find_index(max3,pdynmc,tbl->var3_values);
+
+	//bracketing mass breakpoints
+	double dmass=fmass0/(NGAIN_MASS-1);
+	double xmass=(vmass-(vmass0-fmass0))/dmass;
+	if(xmass<0) xmass=0;
+	if(xmass>NGAIN_MASS-1) xmass=NGAIN_MASS-1;
+	int k=int(xmass);
+	if(k==NGAIN_MASS-1) k--;
+	double fract=xmass-k;
+
+	for(int g=0;g<NGAIN;g++){
+		double gain0=gaintable.interpolate(loc1,loc1+1,loc2,loc2+1,loc3,loc3+1,NGAIN*k+g,vmach,alphax,pdynmc);
+		double gain1=gaintable.interpolate(loc1,loc1+1,loc2,loc2+1,loc3,loc3+1,NGAIN*(k+1)+g,vmach,alphax,pdynmc);
+		gain[g]=(gain0+(gain1-gain0)*fract)/(pdynmc*pdynmc);
+	}
+	GAINGAM.build_vec3(gain[0],gain[1],gain[2]);
+	gainff=gain[3];
+}
+///////////////////////////////////////////////////////////////////////////////
+//Relative error of scheduled gains against the pole placement gains
+//The feedback gain vector error is normalized by the magnitude of the pole
+// placement vector (individual gains may pass through zero); the larger of
+// the feedback and feed-forward errors is returned
+//
+//Return output:
+//         err = max relative error - ND
+//Parameter input:
+//         GAINGAM,gainff = scheduled gains
+//         GAINPP,gainffpp = pole placement gains
+///////////////////////////////////////////////////////////////////////////////
+
+double Hyper::control_gamma_error(Matrix GAINGAM,double gainff,Matrix GAINPP,double gainffpp)
+{
+	double ref=GAINPP.absolute();
+	if(ref<SMALL) ref=SMALL;
+	double err=(GAINGAM-GAINPP).absolute()/ref;
+
+	ref=fabs(gainffpp);
+	if(ref<SMALL) ref=SMALL;
+	double dum=fabs(gainff-gainffpp)/ref;
+	if(dum>err) err=dum;
+
+	return err;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -47,4 +47,7 @@ int const NRADAR=30;					//size of 'recce' module-variable array
 int const NEVENT=20;					//max number of events
 int const NVAR=50;						//max number of variables to be input at every event 
 int const NMARKOV=20;					//max number of Markov noise variables
+int const NGAIN=4;						//gains of flight path angle control (3 feedback, 1 feed-forward)
+int const NGAIN_MASS=5;					//mass breakpoints of the gamma control gain schedule
+int const NTRIM=10;						//max number of unknowns, residuals or held modules of a trim
 #endif
\ No newline at end of file
@@ -13,7 +13,7 @@
 //Acquiring simulation title and option line from the input file 'input.asc'.
 //Printing of title banner to screen
 //
-//Parameter output: *title, *options, &nmonte, &iseed
+//Parameter output: *title, *options, &nmonte, &iseed, *sampling
 //
 //Parameter input: &nmc
 //
@@ -22,7 +22,7 @@
 //030415 Adopted for HYPER simulation, PZi
 ///////////////////////////////////////////////////////////////////////////////
 
-void acquire_title_options(fstream &input,char *title,char *options,int &nmonte,int &iseed,int &nmc)
+void acquire_title_options(fstream &input,char *title,char *options,int &nmonte,int &iseed,char *sampling,int &nmc)
 { 
 	char read[CHARN];
 	char line_clear[CHARL];
@@ -45,6 +45,14 @@ void acquire_title_options(fstream &input,char *title,char *options,int &nmonte,
 		{
 			input>>nmonte;
 			input>>iseed;
+			//optional DOE method of the static dispersions, see 'doe_initialize()'
+			input.getline(line_clear,CHARL,'\n');
+			strcpy(sampling,"RANDOM");
+			char *token=strtok(line_clear," \t\r");
+			if(token&&!ispunct(token[0])){
+				strncpy(sampling,token,CHARN-1);
+				sampling[CHARN-1]='\0';
+			}
 			cout<<" MONTE Run # "<<nmc+1<<'\n';
 		}
 	}while((strcmp(read,"OPTIONS"))&&(n<100));
@@ -268,12 +276,15 @@ void number_objects(fstream &input,int &num_vehicles,int &num_hyper,int &num_sat
 //Arguments of object: module_list, num_modules, num_satellite, num_radar to be passed 
 // to the constructorof 'Hyper', 'Satellite' and 'Radar'
 //Return output: type, type-of-vehicle as defined in 'input.asc'
+//Parameter input: pooled = vehicle object of the previous Monte Carlo run in this
+// slot (NULL in the first run); if of the same type it is reset in place and returned
 //
 //011128 Created by Peter H Zipfel
 //030415 Adopted for HYPER simulation, PZi
 ///////////////////////////////////////////////////////////////////////////////
 
-Cadac *set_obj_type(fstream &input,Module *module_list,int num_modules,int num_satellite,int num_radar)				   
+Cadac *set_obj_type(fstream &input,Module *module_list,int num_modules,int num_satellite,int num_radar,
+					Cadac *pooled)				   
 {
 	char line_clear[CHARL];
 	char temp[CHARN];
@@ -290,6 +301,15 @@ Cadac *set_obj_type(fstream &input,Module *module_list,int num_modules,int num_s
 			input.getline(line_clear,CHARL,'\n');
 	}while(ispunct(temp[0]));
 
+	//re-using the pooled vehicle object
+	if(pooled){
+		if(!strcmp(pooled->get_vname(),temp)){
+			pooled->reset(module_list,num_modules);
+			return pooled;
+		}
+		delete pooled;
+	}
+
 	if (!strcmp(temp,"HYPER6"))
 	{
 		//the pointer 'obj' is allocated the type 'Hyper' 
@@ -664,18 +684,19 @@ void traj_banner(ofstream &ftraj,Packet *combus,char *title,int num_vehicles,
 //five accross, unlimited down
 //data field 16 spaces, total width 80 spaces
 //
+//Parameter input:
+//	frac = fraction of the last integration step 'step' at which the data are
+//		sampled; frac=1 writes the current values
+//
 //010212 Created by Peter Zipfel
 //030415 Adopted for HYPER simulation, PZi
 //050214 Added third object 'Radar', PZi
 ///////////////////////////////////////////////////////////////////////////////
 
-void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
+void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge,double frac,double step)
 {
-	char *integer;
-	char *name;
-	Matrix VEC(3,1);
 	int k=0;
-	Variable *data;
+	Output *plan=NULL;
 	int ndata;
 	string id;
 	int hyper_object;
@@ -696,6 +717,7 @@ void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
 	{
 		Variable *data_c1=combus[0].get_data();
 		double time=data_c1[0].real();
+		if(frac<1) time=combus[0].get_plan()[0].sample(0,frac,step);
 		ftraj.width(16);
 		ftraj<<time;
 		k=1;
@@ -713,49 +735,40 @@ void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
 		if(!hyper_object)
 		//'Hyper' object
 		{
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//writing communication variables to 'traj.asc'
 			for(int j=1;j<ndata;j++)
 			{
-
-				integer=data[j].get_type();
-				name=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<(double) data[j].integer();			
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<(double) *out.integer;
 					k++;
 				}
-				//checking vor vectors
-				else if(isupper(name[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(0,0);
-					k++; 
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(1,0);
-					k++;
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>4){k=0;ftraj<<'\n';}
+						ftraj.width(16);
+						if(frac<1) ftraj<<out.sample(m,frac,step);
+						else ftraj<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<data[j].real(); 
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<*out.real;
 					k++;
 				}
 			}
@@ -764,48 +777,40 @@ void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
 		else if(!satellite_object)
 		//'Satellite' object
 		{
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//writing communication variables to 'traj.asc'
 			for(int j=0;j<ndata;j++)
 			{
-				integer=data[j].get_type();
-				name=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<(double) data[j].integer();			
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<(double) *out.integer;
 					k++;
 				}
-				//checking vor vectors
-				else if(isupper(name[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(0,0);
-					k++; 
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(1,0);
-					k++;
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>4){k=0;ftraj<<'\n';}
+						ftraj.width(16);
+						if(frac<1) ftraj<<out.sample(m,frac,step);
+						else ftraj<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<data[j].real(); 
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<*out.real;
 					k++;
 				}
 			}
@@ -815,48 +820,40 @@ void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
 		else if(!radar_object)
 		//'Radar' object
 		{
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//writing communication variables to 'traj.asc'
 			for(int j=0;j<ndata;j++)
 			{
-				integer=data[j].get_type();
-				name=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<(double) data[j].integer();			
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<(double) *out.integer;
 					k++;
 				}
-				//checking vor vectors
-				else if(isupper(name[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(0,0);
-					k++; 
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(1,0);
-					k++;
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>4){k=0;ftraj<<'\n';}
+						ftraj.width(16);
+						if(frac<1) ftraj<<out.sample(m,frac,step);
+						else ftraj<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<data[j].real(); 
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<*out.real;
 					k++;
 				}
 			}
@@ -896,10 +893,7 @@ void comscrn_data(Packet *combus,int num_vehicles)
 	Variable *data_satellite; //Variable array stored in 'Packet data' of type Satellite
 	Variable *data_radar; //Variable array stored in 'Packet data' of type Radar
 	int ndata;
-	Variable *data;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
+	Output *plan=NULL;
 	int i(0);
 
 	//find first hyper packet index in 'combus'
@@ -999,8 +993,8 @@ void comscrn_data(Packet *combus,int num_vehicles)
 		//'Hyper' object
 		{
 			p++;
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//write out label of i-th object
 			cout<<"\n *** h_";cout.width(8);cout<<p;
@@ -1009,42 +1003,31 @@ void comscrn_data(Packet *combus,int num_vehicles)
 			//writing communication variables to screen
 			for(int j=1;j<ndata;j++)
 			{
-				integer=data[j].get_type();
-				vector=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<(double) data[j].integer();			
+					cout<<(double) *out.integer;
 					k++;
 				}
-				//checking vor vectors
-				else if(isupper(vector[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(0,0);
-					k++; 
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(1,0);
-					k++;
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>7){k=0;cout<<'\n';}
+						cout.width(15);
+						cout<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<data[j].real(); 
+					cout<<*out.real;
 					k++;
 				}
 			}
@@ -1091,8 +1074,8 @@ void comscrn_data(Packet *combus,int num_vehicles)
 		//'Satellite' object
 		{
 			q++;
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//write out label of i-th object
 			cout<<"\n *** t_";cout.width(8);cout<<q;
@@ -1101,42 +1084,31 @@ void comscrn_data(Packet *combus,int num_vehicles)
 			//writing communication variables to screen
 			for(int j=0;j<ndata;j++)
 			{
-				integer=data[j].get_type();
-				vector=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<(double) data[j].integer();			
+					cout<<(double) *out.integer;
 					k++;
 				}
-				//checking vor vectors
-				else if(isupper(vector[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(0,0);
-					k++; 
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(1,0);
-					k++;
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>7){k=0;cout<<'\n';}
+						cout.width(15);
+						cout<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<data[j].real(); 
+					cout<<*out.real;
 					k++;
 				}
 			}
@@ -1183,8 +1155,8 @@ void comscrn_data(Packet *combus,int num_vehicles)
 		//'Radar' object
 		{
 			r++;
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//write out label of i-th object
 			cout<<"\n *** r_";cout.width(8);cout<<r;
@@ -1193,42 +1165,31 @@ void comscrn_data(Packet *combus,int num_vehicles)
 			//writing communication variables to screen
 			for(int j=0;j<ndata;j++)
 			{
-				integer=data[j].get_type();
-				vector=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<(double) data[j].integer();			
+					cout<<(double) *out.integer;
 					k++;
 				}
-				//checking vor vectors
-				else if(isupper(vector[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(0,0);
-					k++; 
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(1,0);
-					k++;
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>7){k=0;cout<<'\n';}
+						cout.width(15);
+						cout<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<data[j].real(); 
+					cout<<*out.real;
 					k++;
 				}
 			}
@@ -1523,6 +1484,21 @@ void document_input(Document *doc_hyper6,Document *doc_satellite3,Document *doc_
 					fcopy.getline(line_clear,CHARL,'\n');
 					input<<line_clear<<'\n';
 				}
+				//copying the 'TRIM' block through its own 'END' as it stands
+				else if(!strcmp(buffn,"TRIM")){
+					input<<"\t\t"<<buffn;
+					fcopy.getline(line_clear,CHARL,'\n');
+					input<<line_clear<<'\n';
+					bool block_end=false;
+					do{
+						fcopy.getline(line_clear,CHARL,'\n');
+						input<<line_clear<<'\n';
+						char *key=line_clear+strspn(line_clear," \t");
+						block_end=!strncmp(key,"END",3)&&(!key[3]||isspace(key[3]));
+					}while(!block_end&&!fcopy.eof());
+					//the block's 'END' does not close the vehicle
+					*buffn=NULL;
+				}
 				//inserting 'END' with only one tab
 				else if(!strcmp(buffn,"END")){
 					input<<'\t'<<buffn;
@@ -49,6 +49,10 @@ void Hyper::def_gps()
 	hyper[724].init("dr3_noise",0,"Delta-range 3 noise - m/s MARKOV","gps","data","");
 	hyper[725].init("dr4_noise",0,"Delta-range 4 noise - m/s MARKOV","gps","data","");
 	hyper[730].init("slotsum",0,"Sum of stored slot numbers of quadriga - ND","gps","save","");
+	hyper[740].init("quad_slot1","int",0,"Slot# of SV 1 of the last quadriga (warm start) - ND","gps","save","");
+	hyper[741].init("quad_slot2","int",0,"Slot# of SV 2 of the last quadriga (warm start) - ND","gps","save","");
+	hyper[742].init("quad_slot3","int",0,"Slot# of SV 3 of the last quadriga (warm start) - ND","gps","save","");
+	hyper[743].init("quad_slot4","int",0,"Slot# of SV 4 of the last quadriga (warm start) - ND","gps","save","");
 	//GPS filter
 	hyper[750].init("uctime_cor",0,"User clock correlation time constant - s","gps","data","");
 	hyper[751].init("ppos",0,"Init 1sig pos values of cov matrix - m","gps","data","");
@@ -197,6 +201,11 @@ void Hyper::gps(double int_step)
 	int gps_acq=hyper[708].integer();
 	double ucfreqm=hyper[713].real();
 	double slotsum=hyper[730].real();
+	int quad_slot[4];
+	quad_slot[0]=hyper[740].integer();
+	quad_slot[1]=hyper[741].integer();
+	quad_slot[2]=hyper[742].integer();
+	quad_slot[3]=hyper[743].integer();
 	//input from other modules
 	double time=round6[0].real();
 	Matrix WBII=round6[166].vec();
@@ -355,7 +364,7 @@ void Hyper::gps(double int_step)
 		gps_epoch=time;
 
 		//*** SV propagation and quadriga selection 'ssii_quad' (4 SVs with best GDOP) ***
-		gps_quadriga(ssii_quad,vsii_quad,gdop,mgps, sv_init_data,rsi,wsi,incl,almanac_time,del_rearth,time,SBII);
+		gps_quadriga(ssii_quad,vsii_quad,gdop,mgps,quad_slot, sv_init_data,rsi,wsi,incl,almanac_time,del_rearth,time,SBII);
 
 		//Pseudo-range and range-rate measurements
 		for(int i=0;i<4;i++){
@@ -506,6 +515,10 @@ void Hyper::gps(double int_step)
 	hyper[710].gets(ucbias_error);
 	hyper[713].gets(ucfreqm);
 	hyper[730].gets(slotsum);	
+	hyper[740].gets(quad_slot[0]);
+	hyper[741].gets(quad_slot[1]);
+	hyper[742].gets(quad_slot[2]);
+	hyper[743].gets(quad_slot[3]);
 	//diagnostics
 	hyper[704].gets(gdop);
 	hyper[711].gets(ucfreq_error);
@@ -515,6 +528,76 @@ void Hyper::gps(double int_step)
 	hyper[777].gets(std_ucbias);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//GDOP^2 of a quadriga from the Gram matrix of the GPS 'H' rows [u,1]
+//Closed-form trace of the inverse of the symmetric 4x4 matrix G=H*H^T:
+// trace(G^-1)=(sum of principal 3x3 minors)/det(G), both built from the
+// 2x2 minors of the upper and lower row pairs
+//
+//parameter input:
+//	*gvis = Gram matrix of all visible SVs, gvis[n*k+l]=u_k^u_l+1
+//	n = number of visible SVs
+//	i1,i2,i3,i4 = quadriga SVs
+//return output:
+//	GDOP^2 (LARGE if the geometry is singular)
+///////////////////////////////////////////////////////////////////////////////
+static double quadriga_gdop2(const double *gvis,int n,int i1,int i2,int i3,int i4)
+{
+	const int k[4]={i1,i2,i3,i4};
+	double g[4][4];
+	for(int a=0;a<4;a++)
+		for(int b=0;b<4;b++)
+			g[a][b]=gvis[n*k[a]+k[b]];
+
+	double s0=g[0][0]*g[1][1]-g[1][0]*g[0][1];
+	double s1=g[0][0]*g[1][2]-g[1][0]*g[0][2];
+	double s2=g[0][0]*g[1][3]-g[1][0]*g[0][3];
+	double s3=g[0][1]*g[1][2]-g[1][1]*g[0][2];
+	double s4=g[0][1]*g[1][3]-g[1][1]*g[0][3];
+	double s5=g[0][2]*g[1][3]-g[1][2]*g[0][3];
+	double c0=g[2][0]*g[3][1]-g[3][0]*g[2][1];
+	double c1=g[2][0]*g[3][2]-g[3][0]*g[2][2];
+	double c2=g[2][0]*g[3][3]-g[3][0]*g[2][3];
+	double c3=g[2][1]*g[3][2]-g[3][1]*g[2][2];
+	double c4=g[2][1]*g[3][3]-g[3][1]*g[2][3];
+	double c5=g[2][2]*g[3][3]-g[3][2]*g[2][3];
+
+	double det=s0*c5-s1*c4+s2*c3+s3*c2-s4*c1+s5*c0;
+	if(det<=0) return LARGE;
+	double trace_adj=(g[1][1]*c5-g[1][2]*c4+g[1][3]*c3)
+					+(g[0][0]*c5-g[0][2]*c2+g[0][3]*c1)
+					+(g[2][0]*s3-g[2][1]*s1+g[2][2]*s0)
+					+(g[3][0]*s4-g[3][1]*s2+g[3][3]*s0);
+	return trace_adj/det;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Lower bound of GDOP^2 of all quadrigas that contain the SVs 'i1', 'i2'
+//and, if i3>=0, 'i3'
+//Column j of H^-1 is orthogonal to the other three rows of H and has unit
+// projection on row j. Its length is therefore at least 1/(distance of row j
+// from the span of the other known rows); for a row not yet picked it is at
+// least 1/|[u,1]|=1/sqrt(2). The distances follow from Gram determinants.
+///////////////////////////////////////////////////////////////////////////////
+static double quadriga_bound2(const double *gvis,int n,int i1,int i2,int i3)
+{
+	double g11=gvis[n*i1+i1];
+	double g22=gvis[n*i2+i2];
+	double g12=gvis[n*i1+i2];
+	if(i3<0){
+		double d2=g11*g22-g12*g12;
+		if(d2<=0) return LARGE;
+		return (g11+g22)/d2+1.;
+	}
+	double g33=gvis[n*i3+i3];
+	double g13=gvis[n*i1+i3];
+	double g23=gvis[n*i2+i3];
+	double m1=g22*g33-g23*g23;
+	double m2=g11*g33-g13*g13;
+	double m3=g11*g22-g12*g12;
+	double d3=g11*m1-g12*(g12*g33-g23*g13)+g13*(g12*g23-g22*g13);
+	if(d3<=0) return LARGE;
+	return (m1+m2+m3)/d3+0.5;
+}
 ///////////////////////////////////////////////////////////////////////////////
 //Selection of the best four SVs (quadriga)
 //Member function of class 'Hyper'
@@ -532,17 +615,19 @@ void Hyper::gps(double int_step)
 //	del_rearth = increase added to Earth's radius for GPS signal LOS calculations (data) - m
 //	time = simulation time - sec
 //	SBII = inertial coordinates of hypersonic vehicle - m
+//	*quad_slot = slot# of the four SVs of the previous quadriga (warm start)
 //
 // parameter output:
 //	*ssii_quad = inertial coordinates + slot# of each quadriga SV, stored sequentially - m
 //	*vsii_quad = inertial velocities of each SV of the quadriga , stored sequentially - m/s
 //	gdop = geometric dillution of precision of quadriga - m
 //	mgps = set here to 1 (GPS initialization), if less than  4 SVs are visible 
+//	*quad_slot = slot# of the four SVs of the selected quadriga
 //	
 //040105 Created by Peter H Zipfel
 ///////////////////////////////////////////////////////////////////////////////
 
-void Hyper::gps_quadriga(double *ssii_quad,double *vsii_quad,double &gdop,int &mgps 
+void Hyper::gps_quadriga(double *ssii_quad,double *vsii_quad,double &gdop,int &mgps,int *quad_slot 
 						,const double *sv_init_data,const double &rsi,const double &wsi
 						,const double &incl,double almanac_time,double del_rearth
 						,double time,Matrix SBII)
@@ -634,51 +719,60 @@ void Hyper::gps_quadriga(double *ssii_quad,double *vsii_quad,double &gdop,int &m
 				k=k+4;
 			}
 		}
-		//selecting quadriga (four SVs) with best GDOP
-		//i1, i2, i3, i4 are the SVs picked by the binomial combination
+		//unit vectors of user wrt the visible SVs and their Gram matrix
+		// gvis[visible_count*k+l]=u_k^u_l+1, the entries of H*H^T of any quadriga
+		double *uvis=new double[3*visible_count];
+		double *gvis=new double[visible_count*visible_count];
+		for(i=0;i<visible_count;i++){
+			double dx=SBII[0]-*(ssii_vis+4*i);
+			double dy=SBII[1]-*(ssii_vis+4*i+1);
+			double dz=SBII[2]-*(ssii_vis+4*i+2);
+			double dsb=sqrt(dx*dx+dy*dy+dz*dz);
+			*(uvis+3*i)=dx/dsb;
+			*(uvis+3*i+1)=dy/dsb;
+			*(uvis+3*i+2)=dz/dsb;
+		}
+		for(i=0;i<visible_count;i++){
+			for(k=i;k<visible_count;k++){
+				double gik=*(uvis+3*i)**(uvis+3*k)+*(uvis+3*i+1)**(uvis+3*k+1)+*(uvis+3*i+2)**(uvis+3*k+2)+1;
+				*(gvis+visible_count*i+k)=gik;
+				*(gvis+visible_count*k+i)=gik;
+			}
+		}
+		//warm start: GDOP of the previous quadriga if all four SVs are still visible
+		double gdop2=LARGE;
+		int prev[4]={-1,-1,-1,-1};
+		for(i=0;i<visible_count;i++){
+			int slot_vis=(int)*(ssii_vis+4*i+3);
+			for(int m=0;m<4;m++)
+				if(quad_slot[m]==slot_vis) prev[m]=i;
+		}
+		if(prev[0]>=0&&prev[1]>=0&&prev[2]>=0&&prev[3]>=0){
+			gdop2=quadriga_gdop2(gvis,visible_count,prev[0],prev[1],prev[2],prev[3]);
+			for(int m=0;m<4;m++) quad[m]=prev[m];
+		}
+		//selecting quadriga (four SVs) with smallest GDOP
+		//i1, i2, i3, i4 are the SVs picked by the binomial combination;
+		// branches whose GDOP lower bound exceeds the best GDOP are skipped
+		//ties go to the first quadriga in the order of the binomial combination
 		int nm3=visible_count-3; //nm3=1 
 		int nm2=visible_count-2; //nm2=2
 		int nm1=visible_count-1; //nm1=3
+		const double margin=1+1e-9; //protects the bounds against round-off
 		
 		for(int i1=0;i1<nm3;i1++){
 			for(int i2=i1+1;i2<nm2;i2++){
+				if(quadriga_bound2(gvis,visible_count,i1,i2,-1)>gdop2*margin) continue;
 				for(int i3=i2+1;i3<nm1;i3++){
+					if(quadriga_bound2(gvis,visible_count,i1,i2,i3)>gdop2*margin) continue;
 					for(int i4=i3+1;i4<visible_count;i4++){
 
-						//pullling the quadriga inertial coordinates
-						Matrix SSII1(3,1);
-						Matrix SSII2(3,1);
-						Matrix SSII3(3,1);
-						Matrix SSII4(3,1);
-						int m(0);
-						for(m=0;m<3;m++){
-							SSII1[m]=*(ssii_vis+4*i1+m);
-							SSII2[m]=*(ssii_vis+4*i2+m);
-							SSII3[m]=*(ssii_vis+4*i3+m);
-							SSII4[m]=*(ssii_vis+4*i4+m);
-						}
-						//calculating user wrt the SV displacement vectors
-						Matrix UNI1=(SBII-SSII1).univec3();
-						Matrix UNI2=(SBII-SSII2).univec3();
-						Matrix UNI3=(SBII-SSII3).univec3();
-						Matrix UNI4=(SBII-SSII4).univec3();
-
-						//building the GPS 'H' matrix
-						Matrix HGPS(4,4);HGPS.ones();					
-						for(m=0;m<3;m++){
-							HGPS.assign_loc(0,m,UNI1[m]);
-							HGPS.assign_loc(1,m,UNI2[m]);
-							HGPS.assign_loc(2,m,UNI3[m]);
-							HGPS.assign_loc(3,m,UNI4[m]);
-						}
-						//calculating GDOP 
-						Matrix COV(4,4);
-						COV=(HGPS*HGPS.trans()).inverse();
-						double gdop_local=sqrt(COV.get_loc(0,0)+COV.get_loc(1,1)+COV.get_loc(2,2)+COV.get_loc(3,3));
-
-						//save location of quadriga SVs in 'ssii_vis[visible_count]' if GDOP has decreased
-						if(gdop_local<gdop){
-							gdop=gdop_local;
+						double gdop2_local=quadriga_gdop2(gvis,visible_count,i1,i2,i3,i4);
+
+						//save quadriga if GDOP has decreased
+						bool earlier=(i1<quad[0])||(i1==quad[0]&&(i2<quad[1]||(i2==quad[1]&&(i3<quad[2]||(i3==quad[2]&&i4<quad[3])))));
+						if(gdop2_local<gdop2||(gdop2_local==gdop2&&earlier)){
+							gdop2=gdop2_local;
 							quad[0]=i1;
 							quad[1]=i2;
 							quad[2]=i3;
@@ -688,6 +782,9 @@ void Hyper::gps_quadriga(double *ssii_quad,double *vsii_quad,double &gdop,int &m
 				}
 			}
 		}//end of picking quadriga amongst visible SVs
+		if(gdop2<LARGE) gdop=sqrt(gdop2);
+		delete[] uvis;
+		delete[] gvis;
 
 		//extract quadriga from visible SVs
 		//storing inertial coordinates of the four SVs and their slot# in ssii_quad[16]
@@ -705,6 +802,7 @@ void Hyper::gps_quadriga(double *ssii_quad,double *vsii_quad,double &gdop,int &m
 			slot[i]=*(ssii_quad+4*i+3);
 			//casting into an int
 			islot[i]=(int)slot[i];
+			quad_slot[i]=islot[i];
 		}
 		//storing inertial velocities of the four SVs in vsii_quad[12]
 		double sin_incl=sin(incl);
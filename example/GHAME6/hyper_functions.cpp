@@ -5,6 +5,7 @@
 //		array sizing
 //		writing banners to output
 //		writing data to output
+//		trim of the initial conditions
 //
 //001222 Created by Peter H Zipfel
 //030415 Adapted to HYPER6 simulation, PZi
@@ -375,12 +376,14 @@ void Hyper::vehicle_data(fstream &input,int nmonte)
 				}				
 			}
 			//reading aero data from aero-deck file
+			//(a vehicle object reset for a Monte Carlo run keeps its tables)
 			if(!strcmp(read,"AERO_DECK")){
 				//reading aerodeck file name
 				input>>file_name;
 				input.getline(line_clear,CHARL,'\n');
 
-				read_tables(file_name,aerotable);
+				if(!aerotable.get_capacity())
+					read_tables(file_name,aerotable);
 			}
 
 			//reading prop data from prop-deck file
@@ -389,9 +392,14 @@ void Hyper::vehicle_data(fstream &input,int nmonte)
 				input>>file_name;
 				input.getline(line_clear,CHARL,'\n');
 
-				read_tables(file_name,proptable);
+				if(!proptable.get_capacity())
+					read_tables(file_name,proptable);
 			}
 
+			//reading the trim request
+			if(!strcmp(read,"TRIM"))
+				trim_data(input);
+
 			//loading values for random variables and building 'markov_list'
 
 			//uniform distribution
@@ -403,7 +411,7 @@ void Hyper::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=(second-first)/2.;
 				else
-					value=uniform(first,second);
+					value=doe_uniform(first,second);
 
 				//loading radom value into module-variable
 				int kk(0);
@@ -436,7 +444,7 @@ void Hyper::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=gauss(first,second);
+					value=doe_gauss(first,second);
 
 				//loading radom value into module-variable
 				int kk(0);
@@ -468,7 +476,7 @@ void Hyper::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=rayleigh(first);
+					value=doe_rayleigh(first);
 
 				//loading radom value into module-variable
 				int kk(0);
@@ -500,7 +508,7 @@ void Hyper::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=exponential(first);
+					value=doe_exponential(first);
 
 				//loading radom value into module-variable
 				int kk(0);
@@ -697,6 +705,14 @@ void Hyper::scrn_index_arrays()
 			l++;
 		}
 	}
+
+	//compiling the output plan
+	int column(0);
+	nscrn_plan=0;
+	for(i=0;i<round6_scrn_count;i++)
+		scrn_plan[nscrn_plan++]=round6[round6_scrn_ind[i]].output(column);
+	for(i=0;i<hyper_scrn_count;i++)
+		scrn_plan[nscrn_plan++]=hyper[hyper_scrn_ind[i]].output(column);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Writing data to screen
@@ -712,10 +728,6 @@ void Hyper::scrn_index_arrays()
 void Hyper::scrn_data()
 {
 
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k=0;
 	
 	cout<<hyper6_name<<'\n';
@@ -723,74 +735,30 @@ void Hyper::scrn_data()
 
 	//writing to screen the variables from the 'Round6' class
 	int i(0);
-	for(i=0;i<round6_scrn_count;i++)
-	{
-		index=round6_scrn_ind[i];
-		//checking for integers
-		integer=round6[index].get_type();
-		vector=round6[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			cout.width(15);
-			cout<<round6[index].integer();			
-			k++; if(k>7){k=0;cout<<'\n';}
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=round6[index].vec();
-
-			cout.width(15);
-			cout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-		}
-		else
-		{
-			//real variables
-			cout.width(15);
-			cout<<round6[index].real();
-			k++; if(k>7){k=0;cout<<'\n';}
-		}
-	}
-	//writing to screen the variables from the 'Hyper' class
-	for(i=0;i<hyper_scrn_count;i++)
+	//writing to screen the variables of the output plan
+	for(i=0;i<nscrn_plan;i++)
 	{
-		index=hyper_scrn_ind[i];
-		//checking for integers
-		integer=hyper[index].get_type();
-		vector=hyper[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=scrn_plan[i];
+		if(out.kind==1)
 		{
 			cout.width(15);
-			cout<<hyper[index].integer();			
+			cout<<*out.integer;
 			k++; if(k>7){k=0;cout<<'\n';}
-
 		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		else if(out.kind==2)
 		{
-			VEC=hyper[index].vec();
-			cout.width(15);
-			cout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;cout<<'\n';}
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
+			{
+				cout.width(15);
+				cout<<vec[m];
+				k++; if(k>7){k=0;cout<<'\n';}
+			}
 		}
 		else
 		{
-			//real variables
 			cout.width(15);
-			cout<<hyper[index].real();
+			cout<<*out.real;
 			k++; if(k>7){k=0;cout<<'\n';}
 		}
 	}
@@ -810,10 +778,6 @@ void Hyper::scrn_data()
 void Hyper::tabout_data(ofstream &ftabout)
 {
 
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k=0;
 	
 	ftabout<<hyper6_name<<'\n';
@@ -821,74 +785,30 @@ void Hyper::tabout_data(ofstream &ftabout)
 
 	//writing to 'tabout.asc' the variables from the 'Round6' class
 	int i(0);
-	for(i=0;i<round6_scrn_count;i++)
-	{
-		index=round6_scrn_ind[i];
-		//checking for integers
-		integer=round6[index].get_type();
-		vector=round6[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			ftabout.width(15);
-			ftabout<<round6[index].integer();			
-			k++; if(k>7){k=0;ftabout<<'\n';}
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=round6[index].vec();
-
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-		}
-		else
-		{
-			//real variables
-			ftabout.width(15);
-			ftabout<<round6[index].real(); 
-			k++; if(k>7){k=0;ftabout<<'\n';}
-		}
-	}
-	//writing to 'tabout.asc' the variables from the 'Hyper' class
-	for(i=0;i<hyper_scrn_count;i++)
+	//writing to 'tabout.asc' the variables of the output plan
+	for(i=0;i<nscrn_plan;i++)
 	{
-		index=hyper_scrn_ind[i];
-		//checking for integers
-		integer=hyper[index].get_type();
-		vector=hyper[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=scrn_plan[i];
+		if(out.kind==1)
 		{
 			ftabout.width(15);
-			ftabout<<hyper[index].integer();			
+			ftabout<<*out.integer;
 			k++; if(k>7){k=0;ftabout<<'\n';}
-
 		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		else if(out.kind==2)
 		{
-			VEC=hyper[index].vec();
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
+			{
+				ftabout.width(15);
+				ftabout<<vec[m];
+				k++; if(k>7){k=0;ftabout<<'\n';}
+			}
 		}
 		else
 		{
-			//real variables
 			ftabout.width(15);
-			ftabout<<hyper[index].real();
+			ftabout<<*out.real;
 			k++; if(k>7){k=0;ftabout<<'\n';}
 		}
 	}
@@ -991,6 +911,15 @@ void Hyper::plot_index_arrays()
 			l++;
 		}
 	}
+
+	//compiling the output plan
+	int column(0);
+	nplot_plan=0;
+	for(i=0;i<round6_plot_count;i++)
+		plot_plan[nplot_plan++]=round6[round6_plot_ind[i]].output(column);
+	for(i=0;i<hyper_plot_count;i++)
+		plot_plan[nplot_plan++]=hyper[hyper_plot_ind[i]].output(column);
+	dense_rates(plot_plan,round6_plot_ind,round6_plot_count);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Writing data to 'ploti.asc', i=1,2,3...
@@ -999,118 +928,80 @@ void Hyper::plot_index_arrays()
 //five accross, unlimited down
 //data field 16 spaces, total width 80 spaces
 //
+//Parameter input:
+//	frac = fraction of the last integration step 'step' at which the data are
+//		sampled; frac=1 writes the current values
+//
 //010116 Created by Peter Zipfel
 //030404 Adapted to HYPER6 simulation, PZi
 ///////////////////////////////////////////////////////////////////////////////
-void Hyper::plot_data(ofstream &fplot,bool merge)
+void Hyper::plot_data(ofstream &fplot,bool merge,double frac,double step)
 {
 
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k=0;
 	
 	fplot.setf(ios::left);
 
 	//writing to 'ploti.asc' the variables from the 'Round6' class
 	int i(0);
-	for(i=0;i<round6_plot_count;i++)
+	//writing to 'ploti.asc' the variables of the output plan
+	for(i=0;i<nplot_plan;i++)
 	{
-		index=round6_plot_ind[i];
-		//checking for integers
-		integer=round6[index].get_type();
-		vector=round6[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=plot_plan[i];
+		if(out.kind==1)
 		{
 			//casting integer to real variable
 			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<(double) round6[index].integer();			
-			k++;
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=round6[index].vec();
-
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++; 
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
+			if(frac<1) fplot<<out.sample(0,frac,step);
+			else fplot<<(double) *out.integer;
 			k++;
 		}
-		else
+		else if(out.kind==2)
 		{
-			//real variables
-			if(merge&&(index==0))
-				//for merging files, time at last entry must be '-1'
-			{
-				fplot.width(16);
-				fplot<<"-1.0";
-				k++;
-			}
-			else
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
 			{
 				if(k>4){k=0;fplot<<'\n';}
 				fplot.width(16);
-				fplot<<round6[index].real(); 
+				if(frac<1) fplot<<out.sample(m,frac,step);
+				else fplot<<vec[m];
 				k++;
 			}
 		}
-	}
-	//writing to 'ploti.asc' the variables from the 'Hyper' class
-	for(i=0;i<hyper_plot_count;i++)
-	{
-		index=hyper_plot_ind[i];
-		//checking for integers
-		integer=hyper[index].get_type();
-		vector=hyper[index].get_name();
-		if(!strcmp(integer,"int"))
+		else if(merge&&!out.column)
+		//for merging files, time at last entry must be '-1'
 		{
-			//casting integer to real variable
-			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<(double) hyper[index].integer();			
-			k++;
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=hyper[index].vec();
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
+			fplot<<"-1.0";
 			k++;
 		}
 		else
 		{
-			//real variables
 			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<hyper[index].real();
+			if(frac<1) fplot<<out.sample(0,frac,step);
+			else fplot<<*out.real;
 			k++;
 		}
 	}
 	fplot<<"\n";
 }
 ///////////////////////////////////////////////////////////////////////////////
+//Recording the plot and 'combus' output plans at the end of the integration
+// step for dense output by 'plot_data()' and 'traj_data()'
+///////////////////////////////////////////////////////////////////////////////
+
+void Hyper::record_output()
+{
+	int i(0);
+
+	for(i=0;i<nplot_plan;i++)
+		plot_plan[i].record();
+	for(i=0;i<ncom_plan;i++)
+		com_plan[i].record();
+}
+///////////////////////////////////////////////////////////////////////////////
 //Watching for and executing events
 // 
 //Max number of events set by global constant NEVENT
@@ -1400,6 +1291,23 @@ void Hyper::com_index_arrays()
 			l++;
 		}
 	}
+
+	//loading the definitions into 'com_hyper6' once and compiling its output plan
+	int column(0);
+	ncom_plan=0;
+	for(i=0;i<round6_com_count;i++)
+	{
+		com_hyper6[ncom_plan]=round6[round6_com_ind[i]];
+		com_plan[ncom_plan]=com_hyper6[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	for(i=0;i<hyper_com_count;i++)
+	{
+		com_hyper6[ncom_plan]=hyper[hyper_com_ind[i]];
+		com_plan[ncom_plan]=com_hyper6[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	dense_rates(com_plan,round6_com_ind,round6_com_count);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Initializing loading 'packet' with 'HYPER6' data
@@ -1429,17 +1337,18 @@ Packet Hyper::loading_packet_init(int num_hyper,int num_satellite,int num_radar)
 	for(i=0;i<round6_com_count;i++)
 	{
 		index=round6_com_ind[i];
-		com_hyper6[i]=round6[index]; 
+		com_hyper6[i].restore(round6[index]); 
 	}
 	for(int j=0;j<hyper_com_count;j++)
 	{
 		index=hyper_com_ind[j];
-		com_hyper6[i+j]=hyper[index];
+		com_hyper6[i+j].restore(hyper[index]);
 	}
 	//refreshing the packet
 	packet.set_id(id);
 	packet.set_status(1);
 	packet.set_data(com_hyper6);
+	packet.set_plan(com_plan);
 	packet.set_ndata(ncom_hyper6);
 
 	return packet;
@@ -1460,12 +1369,12 @@ Packet Hyper::loading_packet(int num_hyper,int num_satellite,int num_radar)
 	for(i=0;i<round6_com_count;i++)
 	{
 		index=round6_com_ind[i];
-		com_hyper6[i]=round6[index];
+		com_hyper6[i].restore(round6[index]);
 	}
 	for(int j=0;j<hyper_com_count;j++)
 	{
 		index=hyper_com_ind[j];
-		com_hyper6[i+j]=hyper[index];
+		com_hyper6[i+j].restore(hyper[index]);
 	}
 	//refreshing the packet
 //	packet.set_id(id);
@@ -1533,95 +1442,40 @@ void Hyper::markov_noise(double time,double int_step,int nmonte)
 ///////////////////////////////////////////////////////////////////////////////
 void Hyper::stat_data(ofstream &fstat,int nmc,int vehicle_slot)
 {
-	int index(0);
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
 	int k=0;
 	
 	fstat.setf(ios::left);
 
 	//writing to 'stati.asc' the variables from the 'Round6' class
 	int i(0);
-	for(i=0;i<round6_plot_count;i++)
+	//writing to 'stati.asc' the variables of the output plan
+	for(i=0;i<nplot_plan;i++)
 	{
-		index=round6_plot_ind[i];
-		//checking for integers
-		integer=round6[index].get_type();
-		vector=round6[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=plot_plan[i];
+		if(out.kind==1)
 		{
 			//casting integer to real variable
 			if(k>4){k=0;fstat<<'\n';}
 			fstat.width(16);
-			fstat<<(double) round6[index].integer();			
+			fstat<<(double) *out.integer;
 			k++;
 		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		else if(out.kind==2)
 		{
-			VEC=round6[index].vec();
-
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(0,0);
-			k++; 
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(2,0);
-			k++;
-		}
-		else
-		{
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<round6[index].real(); 
-			k++;
-		}
-	}
-	//writing to 'stati.asc' the variables from the 'Hyper' class
-	for(i=0;i<hyper_plot_count;i++)
-	{
-		index=hyper_plot_ind[i];
-		//checking for integers
-		integer=hyper[index].get_type();
-		vector=hyper[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<(double) hyper[index].integer();			
-			k++;
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=hyper[index].vec();
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(0,0);
-			k++;
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(2,0);
-			k++;
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
+			{
+				if(k>4){k=0;fstat<<'\n';}
+				fstat.width(16);
+				fstat<<vec[m];
+				k++;
+			}
 		}
 		else
 		{
-			//real variables
 			if(k>4){k=0;fstat<<'\n';}
 			fstat.width(16);
-			fstat<<hyper[index].real();
+			fstat<<*out.real;
 			k++;
 		}
 	}
@@ -1702,7 +1556,7 @@ void Hyper::read_tables(char *file_name,Datadeck &datatable)
 		//extracting table dimension
 		//at this point 'temp' is holding xDIM
 		int dim_check(0);
-		char dim_buff[2];
+		char dim_buff[2]={0};
 		int table_dim(0);
 		strncpy(dim_buff,temp,1);
 		//converting character to integer
@@ -1882,4 +1736,475 @@ void Hyper::read_tables(char *file_name,Datadeck &datatable)
 	}//end of diagnostic table print-out
 	/*//////////////////////////////////////////////////////////////////////////
 
-}
\ No newline at end of file
+}///////////////////////////////////////////////////////////////////////////////
+//Reading the trim request from the 'TRIM' block of 'input.asc'
+//
+//	TRIM
+//		UNKNOWNS alpha0x thtbdx throttle delex		//variables solved for
+//		RESIDUALS thtvdx thtvddx dvbed WBIBD2		//variables driven to zero
+//		HOLD control actuator		//modules not executed in the residual pass
+//		TOL 1e-6					//tolerance of each residual (default 1e-6)
+//		ITER 50						//max number of iterations (default 50)
+//		DELTA 1e-5					//relative perturbation of the Jacobian (default 1e-5)
+//	END
+//
+//Unknowns and residuals are 'round6' or 'hyper' module-variables; a vector
+// enters its three components, 'NAMEi' the i-th component only. Their numbers
+// must be equal. The unknowns are loaded before the initialization modules are
+// called, so initial conditions like 'alpha0x' and 'thtbdx' can be trimmed.
+//
+//Output:	trimming ('Hyper' data member)
+///////////////////////////////////////////////////////////////////////////////
+
+void Hyper::trim_data(fstream &input)
+{
+	char line[CHARL];
+	char *key=NULL;
+	char *token=NULL;
+	char *comment=NULL;
+	bool end=false;
+
+	input.getline(line,CHARL,'\n');
+
+	//reading keyword lines until 'END'
+	while(!end)
+	{
+		if(input.eof())
+			{cerr<<"*** Error: 'TRIM' block without 'END' ***\n";system("pause");exit(1);}
+		input.getline(line,CHARL,'\n');
+		comment=strstr(line,"//");
+		if(comment) *comment='\0';
+		key=strtok(line," \t\r");
+		if(key==NULL) continue;
+
+		if(!strcmp(key,"END"))
+			end=true;
+		else if(!strcmp(key,"UNKNOWNS"))
+			while((token=strtok(NULL," \t\r")))
+				trim_element(token,"UNKNOWNS",trimming.nu,trimming.uname,trimming.uloc,trimming.ucomp);
+		else if(!strcmp(key,"RESIDUALS"))
+			while((token=strtok(NULL," \t\r")))
+				trim_element(token,"RESIDUALS",trimming.nr,trimming.rname,trimming.rloc,trimming.rcomp);
+		else if(!strcmp(key,"HOLD"))
+			while((token=strtok(NULL," \t\r"))){
+				if(trimming.nhold==NTRIM)
+					{cerr<<"*** Error: 'TRIM' too many HOLD modules (NTRIM) ***\n";system("pause");exit(1);}
+				trimming.hold[trimming.nhold++]=token;
+			}
+		else if(!strcmp(key,"TOL")||!strcmp(key,"ITER")||!strcmp(key,"DELTA")){
+			token=strtok(NULL," \t\r");
+			double value=token?atof(token):0;
+			if(value<=0)
+				{cerr<<"*** Error: 'TRIM' "<<key<<" must be positive ***\n";system("pause");exit(1);}
+			if(!strcmp(key,"TOL")) trimming.tol=value;
+			else if(!strcmp(key,"ITER")) trimming.iter=int(value);
+			else trimming.delta=value;
+		}
+		else
+			{cerr<<"*** Error: 'TRIM' unknown keyword '"<<key<<"' ***\n";system("pause");exit(1);}
+	}
+
+	if(!trimming.nu||trimming.nu!=trimming.nr)
+		{cerr<<"*** Error: 'TRIM' needs as many RESIDUALS as UNKNOWNS ("<<trimming.nr<<" vs "
+			<<trimming.nu<<") ***\n";system("pause");exit(1);}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Adding a module-variable to a list of the trim request
+//A vector adds its three components, 'NAMEi' the i-th component only
+//
+//Parameter output:
+//         count = number of elements in the list
+//         names = element names
+//         locs = module-variable locations (round6: 0...NROUND6-1; hyper: NROUND6...)
+//         comps = vector components, -1 for real variables
+//Parameter input:
+//         name = module-variable name as read from 'input.asc'
+//         kind = list keyword
+///////////////////////////////////////////////////////////////////////////////
+
+void Hyper::trim_element(char *name,char *kind,int &count,string *names,int *locs,int *comps)
+{
+	char base[CHARN];
+	int loc(-1),comp(-1);
+	int i(0);
+
+	//searching the module-variable arrays
+	strncpy(base,name,CHARN-1);
+	base[CHARN-1]='\0';
+	for(i=0;i<NROUND6;i++)
+		if(!strcmp(round6[i].get_name(),base)) loc=i;
+	for(i=0;i<NHYPER;i++)
+		if(!strcmp(hyper[i].get_name(),base)) loc=NROUND6+i;
+
+	//single component of a vector
+	int len=strlen(base);
+	if(loc<0&&len>1&&isupper(base[0])&&base[len-1]>='1'&&base[len-1]<='3'){
+		comp=base[len-1]-'1';
+		base[len-1]='\0';
+		for(i=0;i<NROUND6;i++)
+			if(!strcmp(round6[i].get_name(),base)) loc=i;
+		for(i=0;i<NHYPER;i++)
+			if(!strcmp(hyper[i].get_name(),base)) loc=NROUND6+i;
+	}
+	if(loc<0)
+		{cerr<<"*** Error: 'TRIM' "<<kind<<" '"<<name<<"' is not a module-variable ***\n";system("pause");exit(1);}
+	if(!strcmp(trim_variable(loc).get_type(),"int"))
+		{cerr<<"*** Error: 'TRIM' "<<kind<<" '"<<name<<"' is an integer ***\n";system("pause");exit(1);}
+
+	//loading the elements
+	int first=comp;
+	int last=comp;
+	if(comp<0&&isupper(base[0])){first=0;last=2;}
+	for(i=first;i<=last;i++){
+		if(count==NTRIM)
+			{cerr<<"*** Error: 'TRIM' too many "<<kind<<" (NTRIM) ***\n";system("pause");exit(1);}
+		names[count]=base;
+		if(i>=0) names[count]+=char('1'+i);
+		locs[count]=loc;
+		comps[count]=i;
+		count++;
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Module-variable at location 'loc' (round6: 0...NROUND6-1; hyper: NROUND6...)
+///////////////////////////////////////////////////////////////////////////////
+
+Variable &Hyper::trim_variable(int loc)
+{
+	if(loc<NROUND6) return round6[loc];
+	return hyper[loc-NROUND6];
+}
+///////////////////////////////////////////////////////////////////////////////
+//Getting the value of a trim element
+///////////////////////////////////////////////////////////////////////////////
+
+double Hyper::trim_get(int loc,int comp)
+{
+	Variable &var=trim_variable(loc);
+	if(comp<0) return var.real();
+	Matrix VEC=var.vec();
+	return VEC[comp];
+}
+///////////////////////////////////////////////////////////////////////////////
+//Loading the value of a trim element
+///////////////////////////////////////////////////////////////////////////////
+
+void Hyper::trim_put(int loc,int comp,double value)
+{
+	Variable &var=trim_variable(loc);
+	if(comp<0){
+		var.gets(value);
+		return;
+	}
+	Matrix VEC=var.vec();
+	VEC[comp]=value;
+	var.gets_vec(VEC);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Derivative pass of the flight dynamics modules
+//The modules are called in their 'input.asc' sequence with zero integration
+// step at time zero: the states keep their values and the state derivatives
+// are evaluated at the present state. The second pass lets modules see the
+// outputs of the modules that follow them (e.g. 'forces' before 'newton').
+//The held modules and the sensor, guidance and engagement modules are not
+// executed; their outputs keep their values.
+//
+//Parameter input:
+//         module_list = modules and their calling sequence
+//         num_modules = number of modules
+///////////////////////////////////////////////////////////////////////////////
+
+void Hyper::trim_pass(Module *module_list,int num_modules)
+{
+	int j(0),h(0);
+	bool held=false;
+	double int_step(0),out_fact(0);
+
+	for(int pass=0;pass<2;pass++)
+	{
+		for(j=0;j<num_modules;j++)
+		{
+			held=false;
+			for(h=0;h<trimming.nhold;h++)
+				if(module_list[j].name==trimming.hold[h]) held=true;
+			if(held) continue;
+
+			if(module_list[j].name=="newton")
+				newton(0);
+			else if(module_list[j].name=="euler")
+				euler(0);
+			else if(module_list[j].name=="kinematics")
+				kinematics(0,0,int_step,out_fact);
+			else if(module_list[j].name=="environment")
+				environment(0);
+			else if(module_list[j].name=="aerodynamics")
+				aerodynamics();
+			else if(module_list[j].name=="forces")
+				forces();
+			else if(module_list[j].name=="propulsion")
+				propulsion(0);
+			else if(module_list[j].name=="actuator")
+				actuator(0);
+			else if(module_list[j].name=="control") 
+				control(0);
+		}
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Residuals of the trim at the unknowns 'u'
+//Restores the vehicle to its values as read from 'input.asc', loads the
+// unknowns, calls the initialization modules and the derivative pass
+//
+//Parameter output:
+//         r = residuals
+//Parameter input:
+//         round6_start, hyper_start = module-variables as read from 'input.asc'
+//         module_list = modules and their calling sequence
+//         num_modules = number of modules
+//         u = unknowns
+///////////////////////////////////////////////////////////////////////////////
+
+void Hyper::trim_residuals(Variable *round6_start,Variable *hyper_start,Module *module_list,int num_modules,
+	double *u,double *r)
+{
+	int i(0),j(0);
+
+	for(i=0;i<NROUND6;i++) round6[i].restore(round6_start[i]);
+	for(i=0;i<NHYPER;i++) hyper[i].restore(hyper_start[i]);
+	for(i=0;i<trimming.nu;i++)
+		trim_put(trimming.uloc[i],trimming.ucomp[i],u[i]);
+
+	//initialization computations of the flight dynamics, as in 'main()'
+	for(j=0;j<num_modules;j++)
+	{
+		if((module_list[j].name=="newton")&&(module_list[j].initialization=="init"))
+			init_newton();
+		else if((module_list[j].name=="kinematics")&&(module_list[j].initialization=="init"))
+			init_kinematics(0,0);
+		else if((module_list[j].name=="euler")&&(module_list[j].initialization=="init"))
+			init_euler();
+		else if((module_list[j].name=="environment")&&(module_list[j].initialization=="init"))
+			init_environment();
+		else if((module_list[j].name=="aerodynamics")&&(module_list[j].initialization=="init"))
+			init_aerodynamics();
+		else if((module_list[j].name=="propulsion")&&(module_list[j].initialization=="init"))
+			init_propulsion();
+	}
+	trim_pass(module_list,num_modules);
+
+	for(i=0;i<trimming.nr;i++)
+		r[i]=trim_get(trimming.rloc[i],trimming.rcomp[i]);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Jacobian of the trim residuals by central differences
+//
+//Parameter output:
+//         J = Jacobian dr/du (nr x nu), row-wise
+//Parameter input:
+//         round6_start, hyper_start = module-variables as read from 'input.asc'
+//         module_list = modules and their calling sequence
+//         num_modules = number of modules
+//         u = unknowns
+///////////////////////////////////////////////////////////////////////////////
+
+void Hyper::trim_jacobian(Variable *round6_start,Variable *hyper_start,Module *module_list,int num_modules,
+	double *u,double *J)
+{
+	double up[NTRIM],rp[NTRIM],rm[NTRIM];
+	int i(0),j(0);
+	int n=trimming.nu;
+
+	for(i=0;i<n;i++) up[i]=u[i];
+	for(j=0;j<n;j++)
+	{
+		double delta=trimming.delta*fabs(u[j]);
+		if(delta<trimming.delta) delta=trimming.delta;
+
+		up[j]=u[j]+delta;
+		trim_residuals(round6_start,hyper_start,module_list,num_modules,up,rp);
+		up[j]=u[j]-delta;
+		trim_residuals(round6_start,hyper_start,module_list,num_modules,up,rm);
+		up[j]=u[j];
+
+		bool effective=false;
+		for(i=0;i<n;i++){
+			J[i*n+j]=(rp[i]-rm[i])/(2*delta);
+			if(J[i*n+j]!=0) effective=true;
+		}
+		if(!effective)
+			{cerr<<"*** Error: 'TRIM' unknown '"<<trimming.uname[j]<<"' does not change the residuals ***\n";
+				system("pause");exit(1);}
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Newton step of the trim: solving J*du=-r by Gauss elimination with partial
+// pivoting. Returns false if 'J' is singular
+//
+//Parameter output:
+//         du = Newton step
+//Parameter input:
+//         J = Jacobian (nu x nu), row-wise
+//         r = residuals
+///////////////////////////////////////////////////////////////////////////////
+
+bool Hyper::trim_solve(double *J,double *r,double *du)
+{
+	double A[NTRIM*NTRIM];
+	int i(0),j(0),k(0);
+	int n=trimming.nu;
+	double scale(0);
+
+	for(i=0;i<n*n;i++){
+		A[i]=J[i];
+		if(fabs(A[i])>scale) scale=fabs(A[i]);
+	}
+	for(i=0;i<n;i++) du[i]=-r[i];
+
+	//forward elimination
+	for(k=0;k<n;k++)
+	{
+		int pivot=k;
+		for(i=k+1;i<n;i++)
+			if(fabs(A[i*n+k])>fabs(A[pivot*n+k])) pivot=i;
+		if(fabs(A[pivot*n+k])<=1.e-14*scale) return false;
+		if(pivot!=k){
+			for(j=0;j<n;j++){double dum=A[k*n+j];A[k*n+j]=A[pivot*n+j];A[pivot*n+j]=dum;}
+			double dum=du[k];du[k]=du[pivot];du[pivot]=dum;
+		}
+		for(i=k+1;i<n;i++){
+			double factor=A[i*n+k]/A[k*n+k];
+			for(j=k;j<n;j++) A[i*n+j]-=factor*A[k*n+j];
+			du[i]-=factor*du[k];
+		}
+	}
+	//back substitution
+	for(k=n-1;k>=0;k--){
+		for(j=k+1;j<n;j++) du[k]-=A[k*n+j]*du[j];
+		du[k]/=A[k*n+k];
+	}
+	return true;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Trim of the initial conditions requested by the 'TRIM' block
+//Called by the executive after the vehicle data are read and before the
+// initialization modules. Damped Newton iteration with a cached Jacobian: the
+// central-difference Jacobian is refreshed only when a Broyden-updated step
+// fails to reduce the residuals. The step is halved until the residual norm
+// decreases. The residuals are evaluated on the vehicle itself, which is
+// restored afterwards to its 'input.asc' values with the converged unknowns;
+// if not converged the 'input.asc' values are kept with a warning.
+//The autothrottle ('mprop=2') overwrites 'throttle', which then cannot be an
+// unknown (trim 'qhold' instead). Turbulence needs a finite integration step
+// and must be off ('mair').
+//
+//Parameter input:
+//         module_list = modules and their calling sequence
+//         num_modules = number of modules
+///////////////////////////////////////////////////////////////////////////////
+
+void Hyper::trim(Module *module_list,int num_modules)
+{
+	//local variables
+	double u[NTRIM],r[NTRIM],du[NTRIM];
+	double un[NTRIM],rn[NTRIM],Js[NTRIM];
+	double J[NTRIM*NTRIM];
+	int i(0),j(0),k(0),iter(0);
+
+	if(!trimming.nu) return;
+	int n=trimming.nu;
+
+	int mprop=hyper[10].integer();
+	for(i=0;i<n;i++)
+		if(mprop==2&&trimming.uname[i]=="throttle")
+			{cerr<<"*** Error: 'TRIM' of 'throttle' with autothrottle 'mprop'=2 (trim 'qhold') ***\n";system("pause");exit(1);}
+	int mair=round6[50].integer();
+	if((mair%100)/10)
+		{cerr<<"*** Error: 'TRIM' with turbulence 'mair'="<<mair<<" ***\n";system("pause");exit(1);}
+
+	//module-variables as read from 'input.asc'
+	Variable *round6_start=new Variable[NROUND6];
+	Variable *hyper_start=new Variable[NHYPER];
+	for(i=0;i<NROUND6;i++) round6_start[i]=round6[i];
+	for(i=0;i<NHYPER;i++) hyper_start[i]=hyper[i];
+
+	for(i=0;i<n;i++) u[i]=trim_get(trimming.uloc[i],trimming.ucomp[i]);
+	trim_residuals(round6_start,hyper_start,module_list,num_modules,u,r);
+	double norm(0);
+	for(i=0;i<n;i++) norm+=r[i]*r[i];
+	trim_jacobian(round6_start,hyper_start,module_list,num_modules,u,J);
+	int njacobian=1;
+	bool fresh=true;
+
+	for(iter=0;iter<trimming.iter;iter++)
+	{
+		bool converged=true;
+		for(i=0;i<n;i++)
+			if(fabs(r[i])>trimming.tol) converged=false;
+		if(converged) break;
+
+		//damped Newton step
+		bool decreased=false;
+		double normn(0);
+		if(trim_solve(J,r,du)){
+			double lambda=1;
+			for(k=0;k<10&&!decreased;k++){
+				for(i=0;i<n;i++) un[i]=u[i]+lambda*du[i];
+				trim_residuals(round6_start,hyper_start,module_list,num_modules,un,rn);
+				normn=0;
+				for(i=0;i<n;i++) normn+=rn[i]*rn[i];
+				if(normn<norm) decreased=true;
+				else lambda/=2;
+			}
+		}
+		if(!decreased){
+			//an updated Jacobian is refreshed once, a fresh one has failed
+			if(fresh) break;
+			trim_jacobian(round6_start,hyper_start,module_list,num_modules,u,J);
+			njacobian++;
+			fresh=true;
+			continue;
+		}
+		//Broyden update J=J+(dr-J*du)*du'/(du'*du)
+		double ss(0);
+		for(i=0;i<n;i++){
+			du[i]=un[i]-u[i];
+			ss+=du[i]*du[i];
+		}
+		for(i=0;i<n;i++){
+			Js[i]=0;
+			for(j=0;j<n;j++) Js[i]+=J[i*n+j]*du[j];
+		}
+		for(i=0;i<n;i++)
+			for(j=0;j<n;j++)
+				J[i*n+j]+=(rn[i]-r[i]-Js[i])*du[j]/ss;
+		for(i=0;i<n;i++){
+			u[i]=un[i];
+			r[i]=rn[i];
+		}
+		norm=normn;
+		fresh=false;
+	}
+
+	//restoring the 'input.asc' values
+	for(i=0;i<NROUND6;i++) round6[i].restore(round6_start[i]);
+	for(i=0;i<NHYPER;i++) hyper[i].restore(hyper_start[i]);
+	delete [] round6_start;
+	delete [] hyper_start;
+
+	double rmax(0);
+	for(i=0;i<n;i++)
+		if(fabs(r[i])>rmax) rmax=fabs(r[i]);
+	if(rmax>trimming.tol){
+		cout<<" *** Warning: trim of"<<hyper6_name<<" not converged after "<<iter
+			<<" iterations, max residual = "<<rmax<<"; 'input.asc' values kept ***\n";
+		return;
+	}
+	//loading the trimmed unknowns
+	for(i=0;i<n;i++)
+		trim_put(trimming.uloc[i],trimming.ucomp[i],u[i]);
+
+	cout<<" *** Trim of"<<hyper6_name<<": "<<iter<<" iterations, "<<njacobian
+		<<" Jacobians, max residual = "<<rmax<<" ***\n";
+	for(i=0;i<n;i++)
+		cout<<"\t"<<trimming.uname[i]<<" = "<<u[i]<<'\n';
+}
@@ -62,6 +62,8 @@ void Round6::def_newton()
 	round6[256].init("ranglex_l_t",0,"Range angle of hyper wrt to satellite at start - deg","newton","data","");
 	round6[257].init("headon_flag","int",0,"headon_flag=1:head-on =0:tail-chase","newton","data","");
 	round6[258].init("tgo_insertion",0,"Estimated time to intercept - sec","newton","data","");
+	round6[259].init("dvbed",0,"Vehicle geographic speed derivative - m/s^2","newton","diag","");
+	round6[260].init("thtvddx",0,"Vehicle flight path angle derivative - deg/s","newton","diag","");
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -332,6 +334,8 @@ void Round6::newton(double int_step)
 	double gndtrnmx(0);
 	Matrix TVD(3,3);
 	Matrix VBED(3,1);
+	double dvbed(0);
+	double thtvddx(0);
 	
 	//localizing module-variables
 	//initializations
@@ -384,13 +388,29 @@ void Round6::newton(double int_step)
 	//T.M. of geographic velocity wrt geodetic coordinates
 	TVD=mat2tr(psivdx*RAD,thtvdx*RAD);
 
+	//diagnostics: rates of geographic speed and flight path angle (residuals of a 'TRIM')
+	//angular velocity of geodetic wrt inertial coord, with the transport rate of a spherical Earth
+	double vbed1=VBED[0];
+	double vbed2=VBED[1];
+	double vbed3=VBED[2];
+	Matrix WEI(3,1);
+	WEI.build_vec3(0,0,WEII3);
+	Matrix WDID(3,1);
+	WDID.build_vec3(vbed2/dbi,-vbed1/dbi,-vbed2*tan(lat)/dbi);
+	WDID=WDID+TDI*WEI;
+	//geographic acceleration in geodetic coord
+	Matrix ABED=TDI*(ABII-WEII*VBII)-WDID.skew_sym()*VBED;
+	double vbedh=sqrt(vbed1*vbed1+vbed2*vbed2);
+	if(dvbe>0&&vbedh>0){
+		dvbed=(VBED^ABED)/dvbe;
+		thtvddx=DEG*(-ABED[2]*vbedh+vbed3*(vbed1*ABED[0]+vbed2*ABED[1])/vbedh)/(dvbe*dvbe);
+	}
+
 	//diagnostics: acceleration achieved
 	ayx=FSPB[1]/AGRAV;
 	anx=-FSPB[2]/AGRAV;
 
 	//ground track travelled (10% accuracy, usually on the high side)
-	double vbed1=VBED[0];
-	double vbed2=VBED[1];
 	grndtrck+=sqrt(vbed1*vbed1+vbed2*vbed2)*int_step*REARTH/dbi;
 	gndtrkmx=0.001*grndtrck;
 	gndtrnmx=NMILES*grndtrck;
@@ -435,4 +455,6 @@ void Round6::newton(double int_step)
 	round6[241].gets(anx);
 	round6[242].gets(gndtrkmx);
 	round6[243].gets(gndtrnmx);
+	round6[259].gets(dvbed);
+	round6[260].gets(thtvddx);
 }
@@ -118,7 +118,7 @@ void Radar::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=(second-first)/2.;
 				else
-					value=uniform(first,second);
+					value=doe_uniform(first,second);
 
 				//loading radom value into module-variable
 				int kk(0);
@@ -151,7 +151,7 @@ void Radar::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=gauss(first,second);
+					value=doe_gauss(first,second);
 
 				//loading radom value into module-variable
 				int kk(0);
@@ -183,7 +183,7 @@ void Radar::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=rayleigh(first);
+					value=doe_rayleigh(first);
 
 				//loading radom value into module-variable
 				int kk(0);
@@ -215,7 +215,7 @@ void Radar::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=exponential(first);
+					value=doe_exponential(first);
 
 				//loading radom value into module-variable
 				int kk(0);
@@ -315,6 +315,32 @@ void Radar::com_index_arrays()
 			l++;
 		}
 	}
+
+	//loading the definitions into 'com_radar0' once and compiling its output plan
+	int column(0);
+	ncom_plan=0;
+	for(i=0;i<ground0_com_count;i++)
+	{
+		com_radar0[ncom_plan]=ground0[ground0_com_ind[i]];
+		com_plan[ncom_plan]=com_radar0[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	for(i=0;i<radar_com_count;i++)
+	{
+		com_radar0[ncom_plan]=radar[radar_com_ind[i]];
+		com_plan[ncom_plan]=com_radar0[ncom_plan].output(column);
+		ncom_plan++;
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Recording the 'combus' output plan at the end of the integration step
+// for dense output by 'traj_data()'
+///////////////////////////////////////////////////////////////////////////////
+
+void Radar::record_output()
+{
+	for(int i=0;i<ncom_plan;i++)
+		com_plan[i].record();
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Initializing loading 'packet' of radar
@@ -342,17 +368,18 @@ Packet Radar::loading_packet_init(int num_hyper,int num_satellite,int num_radar)
 	for(i=0;i<ground0_com_count;i++)
 	{
 		index=ground0_com_ind[i];
-		com_radar0[i]=ground0[index];
+		com_radar0[i].restore(ground0[index]);
 	}
 	for(int j=0;j<radar_com_count;j++)
 	{
 		index=radar_com_ind[j];
-		com_radar0[i+j]=radar[index];
+		com_radar0[i+j].restore(radar[index]);
 	}
 	//refreshing the packet
 	packet.set_id(id);
 	packet.set_status(1);
 	packet.set_data(com_radar0);
+	packet.set_plan(com_plan);
 	packet.set_ndata(ncom_radar0);
 
 	return packet;
@@ -374,12 +401,12 @@ Packet Radar::loading_packet(int num_hyper,int num_satellite,int num_radar)
 	for(i=0;i<ground0_com_count;i++)
 	{
 		index=ground0_com_ind[i];
-		com_radar0[i]=ground0[index];
+		com_radar0[i].restore(ground0[index]);
 	}
 	for(int j=0;j<radar_com_count;j++)
 	{
 		index=radar_com_ind[j];
-		com_radar0[i+j]=radar[index];
+		com_radar0[i+j].restore(radar[index]);
 	}
 	//refreshing the packet
 	packet.set_data(com_radar0);
@@ -31,6 +31,7 @@
 //	rayleigh
 //	uniform
 //	unituni
+// Design of experiments (DOE) sampling
 // Table look-up
 // Integration
 // US76 Atmosphere
@@ -1699,6 +1700,7 @@ int cad_kepler(Matrix &SPII,Matrix &VPII, Matrix SBII,Matrix VBII,const double &
 //
 // Return output
 //			       iter_flag=0: # of iterations < 20; =1: # of iterations > 20;  - ND
+//				   (the Newton iteration stops after 100 iterations)
 // Parameter output
 //			       SPII = projected inertial position after tgo - m
 //			       VPII = projected inertial velocity after tgo - m/s
@@ -1741,11 +1743,11 @@ int cad_kepler1(Matrix &SPII,Matrix &VPII, Matrix SBII,Matrix VBII,const double
 		dt=(x*x*x*s+dum*x*x*c/sqrt_GM+ro*x*(1-z*s))/sqrt_GM;
 		double dtx=(x*x*c+dum*x*(1-z*s)/sqrt_GM+ro*(1-z*c))/sqrt_GM;
 		x=x+(tgo-dt)/dtx;
-	}while(fabs((tgo-dt)/tgo)>SMALL);
+	}while(fabs((tgo-dt)/tgo)>SMALL&&count20<100);
 
 	//projected inertial position
 	double f=1-x*x*c/ro;
-	double g=tgo-x*x*s/sqrt_GM;
+	double g=tgo-x*x*x*s/sqrt_GM;
 	SPII=SBII*f+VBII*g;
 
 	//projecting inertial velocity
@@ -2262,6 +2264,258 @@ double unituni()
 	return value;
 }
 ///////////////////////////////////////////////////////////////////////////////
+//////////////////// Design of experiments (DOE) sampling /////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//The static dispersions UNI, GAUSS, RAYL and EXP of 'input.asc' draw by default
+// from rand() ('MONTE nmonte iseed' or 'MONTE nmonte iseed RANDOM').
+// Alternatively the deck selects a design after the seed:
+//	LHS			Latin hypercube, one stratum of width 1/nmonte per run
+//	SOBOL		Sobol sequence (Joe-Kuo direction numbers) with random digital shift;
+//				dispersions beyond the 21st are stratified with LHS
+//	ANTITHETIC	pairs of runs with unit samples u and 1-u; 'nmonte' must be even
+//Each occurrence of a dispersion keyword, counted in reading order of the run,
+// is one dimension of the design. Its column of samples for all 'nmonte' runs
+// is generated from 'iseed' and the dimension index alone, so run 'nmc' gets
+// the same values no matter which runs were executed before it.
+//MARKOV variables are time-correlated noise and always draw from rand().
+//
+//Usage: doe_initialize() once before the first run, doe_run() at the start
+// of every run, doe_uniform() etc. in place of uniform() etc.
+///////////////////////////////////////////////////////////////////////////////
+
+//DOE methods
+enum {DOE_RANDOM,DOE_LHS,DOE_SOBOL,DOE_ANTITHETIC};
+
+//number of Sobol dimensions with tabulated direction numbers
+const int DOE_SOBOL_DIM=21;
+const int DOE_SOBOL_BITS=32;
+
+//Joe-Kuo primitive polynomials (degree s, coefficients a) and initial
+// direction numbers m of Sobol dimensions 2..21; dimension 1 is van der Corput
+const int doe_sobol_s[DOE_SOBOL_DIM]={0,1,2,3,3,4,4,5,5,5,5,5,5,6,6,6,6,6,6,7,7};
+const int doe_sobol_a[DOE_SOBOL_DIM]={0,0,1,1,2,1,4,2,4,7,11,13,14,1,13,16,19,22,25,1,4};
+const int doe_sobol_m[DOE_SOBOL_DIM][7]={
+	{0},{1},{1,3},{1,3,1},{1,1,1},{1,1,3,3},{1,3,5,13},{1,1,5,5,17},{1,1,5,5,5},
+	{1,1,7,11,19},{1,1,5,1,1},{1,1,1,3,11},{1,3,5,5,31},{1,3,3,9,7,49},
+	{1,1,1,15,21,21},{1,3,1,13,27,49},{1,1,1,15,7,5},{1,3,1,15,13,25},
+	{1,1,5,5,19,61},{1,3,7,11,23,15,103},{1,3,7,13,13,15,69}};
+
+static int doe_method=DOE_RANDOM;	//selected DOE method
+static int doe_nmonte=0;			//number of MC runs spanned by the design
+static int doe_seed=0;				//seed of the design
+static int doe_nmc=0;				//current MC run
+static int doe_dim=0;				//next dimension to be drawn in the current run
+static double **doe_columns=NULL;	//doe_columns[dim][nmc] unit sample in (0,1)
+static int doe_ncolumns=0;			//number of columns generated
+static int doe_capacity=0;			//allocated size of 'doe_columns'
+
+///////////////////////////////////////////////////////////////////////////////
+//Pseudo-random 64-bit integers (splitmix64) for the DOE columns
+//Independent of rand(), so that the design does not depend on other draws
+///////////////////////////////////////////////////////////////////////////////
+static unsigned long long doe_next(unsigned long long &state)
+{
+	unsigned long long z=(state+=0x9e3779b97f4a7c15ULL);
+	z=(z^(z>>30))*0xbf58476d1ce4e5b9ULL;
+	z=(z^(z>>27))*0x94d049bb133111ebULL;
+	return z^(z>>31);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Uniform sample in the open interval (0,1) from 'doe_next()'
+///////////////////////////////////////////////////////////////////////////////
+static double doe_open(unsigned long long &state)
+{
+	return ((doe_next(state)>>11)+0.5)/9007199254740992.;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Generating the column of unit samples of dimension 'dim' for all MC runs
+//
+//parameter input:
+//			dim = dimension of the design (0,1,2,...)
+//return output:
+//			column = array[doe_nmonte] of unit samples in (0,1)
+///////////////////////////////////////////////////////////////////////////////
+static double *doe_column(int dim)
+{
+	int n=doe_nmonte;
+	int k(0);
+	double *column=new double[n];
+	unsigned long long state=((unsigned long long)(unsigned)doe_seed<<32)^(unsigned long long)dim;
+	doe_next(state);
+
+	if(doe_method==DOE_SOBOL&&dim<DOE_SOBOL_DIM)
+	{
+		//direction numbers v[j]=m[j]*2^(32-j-1)
+		unsigned v[DOE_SOBOL_BITS];
+		int s=doe_sobol_s[dim];
+		int a=doe_sobol_a[dim];
+		int j(0);
+		if(!dim)
+			for(j=0;j<DOE_SOBOL_BITS;j++) v[j]=1u<<(DOE_SOBOL_BITS-1-j);
+		else{
+			for(j=0;j<s&&j<DOE_SOBOL_BITS;j++)
+				v[j]=doe_sobol_m[dim][j]<<(DOE_SOBOL_BITS-1-j);
+			for(j=s;j<DOE_SOBOL_BITS;j++){
+				v[j]=v[j-s]^(v[j-s]>>s);
+				for(int i=1;i<s;i++)
+					if((a>>(s-1-i))&1) v[j]^=v[j-i];
+			}
+		}
+		//Gray-code construction with random digital shift
+		unsigned shift=(unsigned)(doe_next(state)>>32);
+		unsigned x=0;
+		for(k=0;k<n;k++){
+			column[k]=((x^shift)+0.5)/4294967296.;
+			int c=0;
+			while((k>>c)&1) c++;
+			x^=v[c];
+		}
+	}
+	else if(doe_method==DOE_ANTITHETIC)
+	{
+		for(k=0;k<n;k++)
+			column[k]=(k%2)?1.-column[k-1]:doe_open(state);
+	}
+	else
+	{
+		//Latin hypercube: random permutation of the strata, random point in each
+		int *perm=new int[n];
+		for(k=0;k<n;k++) perm[k]=k;
+		for(k=n-1;k>0;k--){
+			int j=(int)(doe_next(state)%(unsigned long long)(k+1));
+			int temp=perm[k];perm[k]=perm[j];perm[j]=temp;
+		}
+		for(k=0;k<n;k++)
+			column[k]=(perm[k]+doe_open(state))/n;
+		delete [] perm;
+	}
+	return column;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Selecting the DOE method and sizing the design, called once before run 1
+//
+//parameter input:
+//			method = "RANDOM", "LHS", "SOBOL" or "ANTITHETIC" (empty: "RANDOM")
+//			nmonte = number of MC runs
+//			seed = seed of the design ('iseed' of MONTE)
+///////////////////////////////////////////////////////////////////////////////
+void doe_initialize(const char *method,int nmonte,int seed)
+{
+	if(!strlen(method)||!strcmp(method,"RANDOM")) doe_method=DOE_RANDOM;
+	else if(!strcmp(method,"LHS")) doe_method=DOE_LHS;
+	else if(!strcmp(method,"SOBOL")) doe_method=DOE_SOBOL;
+	else if(!strcmp(method,"ANTITHETIC")) doe_method=DOE_ANTITHETIC;
+	else
+	{cerr<<" *** Error: unknown MONTE sampling '"<<method<<"' (RANDOM, LHS, SOBOL, ANTITHETIC) *** \n";system("pause");exit(1);}
+	if(doe_method==DOE_ANTITHETIC&&nmonte%2)
+	{cerr<<" *** Error: MONTE ANTITHETIC needs an even number of runs, not "<<nmonte<<" *** \n";system("pause");exit(1);}
+
+	for(int i=0;i<doe_ncolumns;i++) delete [] doe_columns[i];
+	delete [] doe_columns;
+	doe_columns=NULL;
+	doe_ncolumns=0;
+	doe_capacity=0;
+	doe_nmonte=nmonte>0?nmonte:1;
+	doe_seed=seed;
+	doe_nmc=0;
+	doe_dim=0;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Starting MC run 'nmc' (0,1,2,...) of the design
+///////////////////////////////////////////////////////////////////////////////
+void doe_run(int nmc)
+{
+	if(doe_method!=DOE_RANDOM&&(nmc<0||nmc>=doe_nmonte))
+	{cerr<<" *** Error: MC run "<<nmc+1<<" outside of the design of "<<doe_nmonte<<" runs *** \n";system("pause");exit(1);}
+	doe_nmc=nmc;
+	doe_dim=0;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Unit sample in (0,1) of the next dimension of the current run
+//Falls back to 'unituni()' if no design is selected
+///////////////////////////////////////////////////////////////////////////////
+double doe_unituni()
+{
+	if(doe_method==DOE_RANDOM) return unituni();
+
+	//generating the columns of the design as the dimensions are first reached
+	if(doe_dim==doe_capacity){
+		doe_capacity=doe_capacity?2*doe_capacity:16;
+		double **columns=new double *[doe_capacity];
+		for(int i=0;i<doe_ncolumns;i++) columns[i]=doe_columns[i];
+		delete [] doe_columns;
+		doe_columns=columns;
+	}
+	while(doe_ncolumns<=doe_dim){
+		doe_columns[doe_ncolumns]=doe_column(doe_ncolumns);
+		doe_ncolumns++;
+	}
+	return doe_columns[doe_dim++][doe_nmc];
+}
+///////////////////////////////////////////////////////////////////////////////
+//Inverse of the standard normal distribution function
+//Ref: P.J. Acklam, rational approximation with one Halley refinement step
+// (relative error < 1e-15)
+///////////////////////////////////////////////////////////////////////////////
+static double doe_inverse_normal(double p)
+{
+	const double a[6]={-3.969683028665376e+01,2.209460984245205e+02,-2.759285104469687e+02,
+		1.383577518672690e+02,-3.066479806614716e+01,2.506628277459239e+00};
+	const double b[5]={-5.447609879822406e+01,1.615858368580409e+02,-1.556989798598866e+02,
+		6.680131188771972e+01,-1.328068155288572e+01};
+	const double c[6]={-7.784894002430293e-03,-3.223964580411365e-01,-2.400758277161838e+00,
+		-2.549732539343734e+00,4.374664141464968e+00,2.938163982698783e+00};
+	const double d[4]={7.784695709041462e-03,3.224671290700398e-01,2.445134137142996e+00,
+		3.754408661907416e+00};
+	const double plow=0.02425;
+	double q,r,x;
+
+	if(p<plow){
+		q=sqrt(-2.*log(p));
+		x=(((((c[0]*q+c[1])*q+c[2])*q+c[3])*q+c[4])*q+c[5])/((((d[0]*q+d[1])*q+d[2])*q+d[3])*q+1.);
+	}
+	else if(p<=1.-plow){
+		q=p-0.5;
+		r=q*q;
+		x=(((((a[0]*r+a[1])*r+a[2])*r+a[3])*r+a[4])*r+a[5])*q/(((((b[0]*r+b[1])*r+b[2])*r+b[3])*r+b[4])*r+1.);
+	}
+	else{
+		q=sqrt(-2.*log(1.-p));
+		x=-(((((c[0]*q+c[1])*q+c[2])*q+c[3])*q+c[4])*q+c[5])/((((d[0]*q+d[1])*q+d[2])*q+d[3])*q+1.);
+	}
+	//refinement
+	double e=0.5*erfc(-x/sqrt(2.))-p;
+	double u=e*2.5066282746310002*exp(x*x/2.);
+	return x-u/(1.+x*u/2.);
+}
+///////////////////////////////////////////////////////////////////////////////
+//DOE counterparts of 'uniform()', 'gauss()', 'rayleigh()' and 'exponential()'
+//Without a design they call those functions, otherwise they transform
+// 'doe_unituni()' by the inverse distribution function
+///////////////////////////////////////////////////////////////////////////////
+double doe_uniform(double min,double max)
+{
+	if(doe_method==DOE_RANDOM) return uniform(min,max);
+	return min+(max-min)*doe_unituni();
+}
+double doe_gauss(double mean,double sig)
+{
+	if(doe_method==DOE_RANDOM) return gauss(mean,sig);
+	return mean+sig*doe_inverse_normal(doe_unituni());
+}
+double doe_rayleigh(double mode)
+{
+	if(doe_method==DOE_RANDOM) return rayleigh(mode);
+	return mode*sqrt(-2.*log(doe_unituni()));
+}
+double doe_exponential(double density)
+{
+	if(doe_method==DOE_RANDOM) return exponential(density);
+	if(!density)
+	{cout<<" *** Error: density not given a non-zero value in 'exponential()' *** \n";system("pause");exit(1);}
+	return -log(doe_unituni())/density;
+}
+///////////////////////////////////////////////////////////////////////////////
 //////////////// Table look-up and interpolation functions ////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
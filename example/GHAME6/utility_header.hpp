@@ -31,6 +31,7 @@
 //	rayleigh
 //	uniform
 //	unituni
+// Design of experiments (DOE) sampling
 // Integration
 // US76 Atmosphere
 // US76 Atmosphere extended to 1000km (NASA Marshall)
@@ -451,6 +452,30 @@ double uniform(double min,double max);
 //Generating uniform random distribution between 0-1 based on C function rand()
 double unituni();
 
+///////////////////////////////////////////////////////////////////////////////
+//////////////////// Design of experiments (DOE) sampling /////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+//Selecting the DOE method of the static dispersions, called once before run 1
+//parameter input:
+//			method = "RANDOM", "LHS", "SOBOL" or "ANTITHETIC" (empty: "RANDOM")
+//			nmonte = number of MC runs
+//			seed = seed of the design ('iseed' of MONTE)
+void doe_initialize(const char *method,int nmonte,int seed);
+
+//Starting MC run 'nmc' (0,1,2,...) of the design; resets the dimension count
+void doe_run(int nmc);
+
+//Unit sample in (0,1) of the next dimension of the current run
+//Falls back to 'unituni()' if no design is selected
+double doe_unituni();
+
+//DOE counterparts of 'uniform()', 'gauss()', 'rayleigh()' and 'exponential()'
+double doe_uniform(double min,double max);
+double doe_gauss(double mean,double sig);
+double doe_rayleigh(double mode);
+double doe_exponential(double density);
+
 ///////////////////////////////////////////////////////////////////////////////
 ////////////////////  Integration functions  //////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -90,6 +90,11 @@ Rotor::Rotor(Module *module_list,int num_modules)
 	// allocating memory for the com index arrays
 	rotor_com_ind=new int[rotor_com_count];
 
+	//allocating memory for the output plans
+	scrn_plan=new Output[rotor_scrn_count];
+	plot_plan=new Output[rotor_plot_count];
+	com_plan=new Output[rotor_com_count];
+
 	//allocating memory to each event object in event object list
 	for (i=0;i<NEVENT;i++)
 		event_ptr_list[i]=new Event;
@@ -133,6 +138,9 @@ Rotor::~Rotor()
 	delete [] rotor_scrn_ind;
 	delete [] rotor_plot_ind;
 	delete [] rotor_com_ind;
+	delete [] scrn_plan;
+	delete [] plot_plan;
+	delete [] com_plan;
 	delete [] &event_ptr_list;
 }
 
@@ -139,6 +139,11 @@ protected:
 	//be written to 'combus' 'packets'
 	int *rotor_com_ind; int rotor_com_count;
 
+	//output plans compiled by the index arrays and executed by the writers
+	Output *scrn_plan; int nscrn_plan;
+	Output *plot_plan; int nplot_plan;
+	Output *com_plan; int ncom_plan;
+
 	//declaring Table pointer as temporary storage of a single table
 	Table *table;
 	//	declaring Datadeck 'aerotable' that stores all aero tables
@@ -0,0 +1,336 @@
+///////////////////////////////////////////////////////////////////////////////
+//FILE: 'benchmark.cpp'
+//Stand-alone checks and timings of the ROCKET6G utility services
+//Built and run by the 'bench-*' targets of the Makefile (not part of the
+// simulation executable):
+//	make bench-startrack	star catalog field of regard and triad selection
+//	make bench-kepler		batch Kepler engine vs cad_kepler and cad_kepler1
+//
+//Each check compares a service with the straightforward reference it
+// replaced and reports the time per call
+///////////////////////////////////////////////////////////////////////////////
+
+#include "class_hierarchy.hpp"
+#include <chrono>
+#include <iomanip>
+
+///////////////////////////////////////////////////////////////////////////////
+//Seconds elapsed since 'start', which is reset to now
+///////////////////////////////////////////////////////////////////////////////
+static double lap(std::chrono::steady_clock::time_point &start)
+{
+	std::chrono::steady_clock::time_point now=std::chrono::steady_clock::now();
+	double dt=std::chrono::duration<double>(now-start).count();
+	start=now;
+	return dt;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Random unit vector, uniform on the sphere
+///////////////////////////////////////////////////////////////////////////////
+static void random_unit(double *u)
+{
+	double z=2*unituni()-1;
+	double phi=2*PI*unituni();
+	double r=sqrt(1-z*z);
+	u[0]=r*cos(phi);
+	u[1]=r*sin(phi);
+	u[2]=z;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Star catalog benchmark
+//
+//Uniform synthetic catalogs of 25, 1000 and 10000 stars, vehicle zenith at
+// random, 1 deg horizon mask (about half the stars in the field of regard).
+//The triad volume is checked against the exhaustive search of the legacy
+// 'star_triad()' (Matrix arithmetic over all binomial combinations), which
+// runs on the first three queries of fields of regard small enough to finish
+// in seconds.
+///////////////////////////////////////////////////////////////////////////////
+static int bench_startrack()
+{
+	const int ncat=3;
+	int nstar[ncat]={25,1000,10000};
+	int nquery[ncat]={1000,100,10};
+	const int max_exhaustive=600; //largest field of regard searched exhaustively
+	const int nmax_exhaustive=3; //exhaustive searches per catalog
+	const double cos_radius=sin(1*RAD);
+	int mismatches(0);
+
+	srand(1);
+	cout<<"\n *** Star catalog benchmark: uniform catalogs, 1 deg horizon mask ***\n";
+	cout<<"   stars   in view   FOR query        triad   exhaustive (Matrix)\n";
+	cout<<fixed<<setprecision(1);
+	for(int c=0;c<ncat;c++){
+		int n=nstar[c];
+		double *unit=new double[3*n];
+		char *name_list=new char[CHARN*n];
+		for(int k=0;k<n;k++){
+			random_unit(unit+3*k);
+			sprintf(name_list+CHARN*k,"star%d",k+1);
+		}
+		Starcatalog catalog;
+		catalog.load(n,unit,name_list);
+
+		double time_for(0),time_triad(0),time_exhaustive(0);
+		long nview(0);
+		int nexhaustive(0);
+		for(int q=0;q<nquery[c];q++){
+			double center[3];
+			random_unit(center);
+			std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+			int nfor=catalog.field_of_regard(center,cos_radius);
+			time_for+=lap(start);
+			nview+=nfor;
+			if(nfor<3) continue;
+			int tri[3];
+			double volume=catalog.triad(tri);
+			time_triad+=lap(start);
+
+			if(nfor>max_exhaustive||nexhaustive==nmax_exhaustive) continue;
+			//legacy exhaustive search over the stars in the field of regard
+			double *usii_vis=new double[3*nfor];
+			int m(0);
+			for(int k=0;k<n;k++){
+				double u[3];
+				catalog.get_star(k,u);
+				if(u[0]*center[0]+u[1]*center[1]+u[2]*center[2]>cos_radius){
+					for(int j=0;j<3;j++) usii_vis[3*m+j]=u[j];
+					m++;
+				}
+			}
+			lap(start);
+			double star_volume(0);
+			for(int i1=0;i1<m-2;i1++){
+				for(int i2=i1+1;i2<m-1;i2++){
+					for(int i3=i2+1;i3<m;i3++){
+						Matrix USII1(3,1);
+						Matrix USII2(3,1);
+						Matrix USII3(3,1);
+						for(int j=0;j<3;j++){
+							USII1[j]=usii_vis[3*i1+j];
+							USII2[j]=usii_vis[3*i2+j];
+							USII3[j]=usii_vis[3*i3+j];
+						}
+						double volume_local=fabs(USII1^(USII2.skew_sym()*USII3));
+						if(volume_local>star_volume) star_volume=volume_local;
+					}
+				}
+			}
+			time_exhaustive+=lap(start);
+			nexhaustive++;
+			if(m!=nfor||fabs(volume-star_volume)>1e-12) mismatches++;
+			delete [] usii_vis;
+		}
+		cout<<setw(8)<<n<<setw(10)<<nview/nquery[c]
+			<<setw(9)<<time_for/nquery[c]*1e6<<" us"
+			<<setw(10)<<time_triad/nquery[c]*1e6<<" us";
+		if(nexhaustive)
+			cout<<setw(16)<<time_exhaustive/nexhaustive*1e6<<" us";
+		else
+			cout<<"     (field of regard too large)";
+		cout<<'\n';
+		delete [] unit;
+		delete [] name_list;
+	}
+	cout<<" *** "<<mismatches<<" triad mismatches against the exhaustive search ***\n";
+	return mismatches?1:0;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Inertial state on an ellipse of semi-major axis 'a', eccentricity 'e' and
+// orientation 'rot' (perifocal P and Q axes, rot[0..5]) at eccentric anomaly 'ea'
+///////////////////////////////////////////////////////////////////////////////
+static void ellipse_state(double *s,double *v,double a,double e,const double *rot,double ea)
+{
+	double b=a*sqrt(1-e*e);
+	double r=a*(1-e*cos(ea));
+	double xp=a*(cos(ea)-e);
+	double yp=b*sin(ea);
+	double vxp=-sqrt(GM*a)/r*sin(ea);
+	double vyp=sqrt(GM*a)/r*sqrt(1-e*e)*cos(ea);
+	for(int j=0;j<3;j++){
+		s[j]=xp*rot[j]+yp*rot[3+j];
+		v[j]=vxp*rot[j]+vyp*rot[3+j];
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Eccentric anomaly of mean anomaly 'ma' by Newton iteration to round-off
+///////////////////////////////////////////////////////////////////////////////
+static double eccentric_anomaly(double ma,double e)
+{
+	double ea=ma+e*sin(ma);
+	for(int i=0;i<50;i++){
+		double dea=(ea-e*sin(ea)-ma)/(1-e*cos(ea));
+		ea-=dea;
+		if(fabs(dea)<1e-15) break;
+	}
+	return ea;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Largest position difference between the projections and the reference
+///////////////////////////////////////////////////////////////////////////////
+static double max_error(const double *sp,const double *sref,int n)
+{
+	double emax(0);
+	for(int k=0;k<n;k++){
+		double dx=sp[3*k]-sref[3*k];
+		double dy=sp[3*k+1]-sref[3*k+1];
+		double dz=sp[3*k+2]-sref[3*k+2];
+		double err=sqrt(dx*dx+dy*dy+dz*dz);
+		if(err>emax) emax=err;
+	}
+	return emax;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Batch Kepler benchmark
+//
+//10000 random elliptic orbits (semi-major axis 6700-42200 km, eccentricity
+// below 0.7, time of flight up to one period) projected by 'Kepler' (cold
+// start, then warm start at a time of flight 0.1% longer), 'cad_kepler' and
+// 'cad_kepler1'. Position errors are taken against the exact solution of
+// Kepler's equation in mean anomaly, leaving out the projections that the
+// utilities reject or flag.
+//1000 random hyperbolic arcs check 'Kepler' against 'cad_kepler1';
+// 'cad_kepler' rejects hyperbolic arcs.
+///////////////////////////////////////////////////////////////////////////////
+static int bench_kepler()
+{
+	const int n=10000;
+	const int nhyp=1000;
+	double *s0=new double[3*n];
+	double *v0=new double[3*n];
+	double *tof=new double[n];
+	double *sref=new double[3*n];
+	double *sref_warm=new double[3*n];
+	double *sp=new double[3*n];
+	double vp[3];
+	int k(0);
+	int failures(0);
+
+	//random orbits and their exact end states
+	srand(1);
+	for(k=0;k<n;k++){
+		double a=6700e3+(42200e3-6700e3)*unituni();
+		double e=0.7*unituni();
+		double p[3],q[3],w[3];
+		random_unit(p);
+		random_unit(w);
+		//Q perpendicular to P
+		q[0]=w[1]*p[2]-w[2]*p[1];
+		q[1]=w[2]*p[0]-w[0]*p[2];
+		q[2]=w[0]*p[1]-w[1]*p[0];
+		double qabs=sqrt(q[0]*q[0]+q[1]*q[1]+q[2]*q[2]);
+		double rot[6]={p[0],p[1],p[2],q[0]/qabs,q[1]/qabs,q[2]/qabs};
+		double mean_motion=sqrt(GM/(a*a*a));
+		double ma0=2*PI*unituni();
+		tof[k]=2*PI/mean_motion*unituni();
+		double vdum[3];
+		ellipse_state(s0+3*k,v0+3*k,a,e,rot,eccentric_anomaly(ma0,e));
+		ellipse_state(sref+3*k,vdum,a,e,rot,eccentric_anomaly(ma0+mean_motion*tof[k],e));
+		ellipse_state(sref_warm+3*k,vdum,a,e,rot,eccentric_anomaly(ma0+mean_motion*tof[k]*1.001,e));
+	}
+	cout<<"\n *** Kepler benchmark: "<<n<<" elliptic orbits, position error vs exact solution ***\n";
+	cout<<scientific<<setprecision(1);
+
+	//batch engine, cold and warm start
+	Kepler kepler;
+	kepler.resize(n);
+	for(k=0;k<n;k++) kepler.set_state(k,s0+3*k,v0+3*k,tof[k]);
+	std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+	failures+=kepler.propagate();
+	double time_cold=lap(start);
+	int sweeps_cold=kepler.get_iterations();
+	for(k=0;k<n;k++) kepler.get_state(k,sp+3*k,vp);
+	double err_cold=max_error(sp,sref,n);
+
+	for(k=0;k<n;k++) kepler.set_state(k,s0+3*k,v0+3*k,tof[k]*1.001);
+	lap(start);
+	failures+=kepler.propagate();
+	double time_warm=lap(start);
+	int sweeps_warm=kepler.get_iterations();
+	for(k=0;k<n;k++) kepler.get_state(k,sp+3*k,vp);
+	double err_warm=max_error(sp,sref_warm,n);
+
+	//single-object utilities
+	Matrix SBII(3,1),VBII(3,1),SPII(3,1),VPII(3,1);
+	int rejected(0),flagged(0);
+	lap(start);
+	for(k=0;k<n;k++){
+		SBII.build_vec3(s0[3*k],s0[3*k+1],s0[3*k+2]);
+		VBII.build_vec3(v0[3*k],v0[3*k+1],v0[3*k+2]);
+		int flag=cad_kepler(SPII,VPII,SBII,VBII,tof[k]);
+		rejected+=flag;
+		for(int j=0;j<3;j++) sp[3*k+j]=flag?sref[3*k+j]:SPII[j];
+	}
+	double time_kepler=lap(start);
+	double err_kepler=max_error(sp,sref,n);
+	for(k=0;k<n;k++){
+		SBII.build_vec3(s0[3*k],s0[3*k+1],s0[3*k+2]);
+		VBII.build_vec3(v0[3*k],v0[3*k+1],v0[3*k+2]);
+		int flag=cad_kepler1(SPII,VPII,SBII,VBII,tof[k]);
+		flagged+=flag;
+		for(int j=0;j<3;j++) sp[3*k+j]=flag?sref[3*k+j]:SPII[j];
+	}
+	double time_kepler1=lap(start);
+	double err_kepler1=max_error(sp,sref,n);
+
+	cout<<"  Kepler, cold start  "<<setw(8)<<fixed<<setprecision(0)<<time_cold/n*1e9<<" ns/object, "
+		<<sweeps_cold<<" sweeps, max "<<scientific<<setprecision(1)<<err_cold<<" m\n";
+	cout<<"  Kepler, warm start  "<<setw(8)<<fixed<<setprecision(0)<<time_warm/n*1e9<<" ns/object, "
+		<<sweeps_warm<<" sweeps, max "<<scientific<<setprecision(1)<<err_warm<<" m\n";
+	cout<<"  cad_kepler          "<<setw(8)<<fixed<<setprecision(0)<<time_kepler/n*1e9<<" ns/object,"
+		<<"           max "<<scientific<<setprecision(1)<<err_kepler<<" m ("<<rejected<<" rejected)\n";
+	cout<<"  cad_kepler1         "<<setw(8)<<fixed<<setprecision(0)<<time_kepler1/n*1e9<<" ns/object,"
+		<<"           max "<<scientific<<setprecision(1)<<err_kepler1<<" m ("<<flagged<<" flagged)\n";
+
+	//hyperbolic arcs: batch engine against cad_kepler1
+	double dmax(0);
+	kepler.resize(nhyp);
+	for(k=0;k<nhyp;k++){
+		double r0=6700e3+13300e3*unituni();
+		double speed=sqrt(2*GM/r0)*(1.05+0.45*unituni());
+		double u[3],d[3];
+		random_unit(u);
+		random_unit(d);
+		for(int j=0;j<3;j++){
+			s0[3*k+j]=r0*u[j];
+			v0[3*k+j]=speed*d[j];
+		}
+		tof[k]=3600*unituni();
+		kepler.set_state(k,s0+3*k,v0+3*k,tof[k]);
+	}
+	kepler.reset();
+	failures+=kepler.propagate();
+	for(k=0;k<nhyp;k++){
+		kepler.get_state(k,sp+3*k,vp);
+		SBII.build_vec3(s0[3*k],s0[3*k+1],s0[3*k+2]);
+		VBII.build_vec3(v0[3*k],v0[3*k+1],v0[3*k+2]);
+		cad_kepler1(SPII,VPII,SBII,VBII,tof[k]);
+		double dx=sp[3*k]-SPII[0],dy=sp[3*k+1]-SPII[1],dz=sp[3*k+2]-SPII[2];
+		double diff=sqrt(dx*dx+dy*dy+dz*dz);
+		if(diff>dmax) dmax=diff;
+	}
+	cout<<" *** "<<nhyp<<" hyperbolic arcs: Kepler and cad_kepler1 agree within "
+		<<fixed<<setprecision(2)<<dmax<<" m ***\n";
+	cout<<" *** "<<failures<<" objects not converged ***\n";
+
+	delete [] s0;
+	delete [] v0;
+	delete [] tof;
+	delete [] sref;
+	delete [] sref_warm;
+	delete [] sp;
+
+	//the batch engine must match the exact solution to well below a meter
+	return (failures||err_cold>1e-3||err_warm>1e-3)?1:0;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Selecting the benchmark by the first command line argument
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc,char **argv)
+{
+	if(argc>1&&!strcmp(argv[1],"startrack")) return bench_startrack();
+	if(argc>1&&!strcmp(argv[1],"kepler")) return bench_kepler();
+
+	cerr<<"*** Usage: "<<argv[0]<<" startrack|kepler ***\n";
+	return 1;
+}
@@ -33,6 +33,27 @@ Round6::Round6()
 	for(int i=0;i<NROUND6;i++)round6[i].init("empty",0," "," "," "," ");
 }
 ///////////////////////////////////////////////////////////////////////////////
+//Attaching the state derivatives of 'newton' to an output plan for dense output
+//
+//The first 'round6_count' entries of 'plan' must have been compiled from
+// 'round6[round6_ind[i]]'. Each integrated state receives its derivative:
+// SBII <- VBII, VBII <- ABII
+///////////////////////////////////////////////////////////////////////////////
+
+void Round6::dense_rates(Output *plan,int *round6_ind,int round6_count)
+{
+	int column(0);
+
+	for(int i=0;i<round6_count;i++)
+	{
+		int rate_ind(0);
+		if(round6_ind[i]==235) rate_ind=236;
+		else if(round6_ind[i]==236) rate_ind=237;
+		else continue;
+		plan[i].rate=round6[rate_ind].output(column).vec;
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
 //Constructor initializing the modules and the module-variable arrays
 //Reading input data from 'input.asc' and putting into 'round6' and 'hyper' arrays 
 //Writing banners to screen, 'tabout.asc' and to 'traj.asc' files  
@@ -136,6 +157,11 @@ Hyper::Hyper(Module *module_list,int num_modules)
 	round6_com_ind=new int[round6_com_count];
 	hyper_com_ind=new int[hyper_com_count];
 
+	//allocating memory for the output plans
+	scrn_plan=new Output[round6_scrn_count+hyper_scrn_count];
+	plot_plan=new Output[round6_plot_count+hyper_plot_count];
+	com_plan=new Output[round6_com_count+hyper_com_count];
+
 	//allocating memory to each event object in event object list
 	for (i=0;i<NEVENT;i++)
 		event_ptr_list[i]=new Event;
@@ -163,9 +189,17 @@ Hyper::Hyper(Module *module_list,int num_modules)
 	com_index_arrays();
 
 	//initializing the indices in the 'markov_list' to large integers
-	for(i=0;i<NMARKOV;i++)
+	for(i=0;i<NMARKOV;i++){
 		markov_list[i].set_markov_round6_index(ILARGE);
+		markov_list[i].set_markov_vehicle_index(ILARGE);
+	}
 	nmarkov=0;
+
+	//saving the defined module-variables for resetting in place
+	round6_def=new Variable[NROUND6];
+	hyper_def=new Variable[NHYPER];
+	for(i=0;i<NROUND6;i++) round6_def[i]=round6[i];
+	for(i=0;i<NHYPER;i++) hyper_def[i]=hyper[i];
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Destructor deallocating dynamic memory
@@ -184,10 +218,54 @@ Hyper::~Hyper()
 	delete [] com_hyper6;
 	delete [] round6_scrn_ind;
 	delete [] hyper_scrn_ind;
+	delete [] round6_plot_ind;
 	delete [] hyper_plot_ind;
 	delete [] round6_com_ind;
 	delete [] hyper_com_ind;
-	delete [] &event_ptr_list;
+	delete [] scrn_plan;
+	delete [] plot_plan;
+	delete [] com_plan;
+	for(int i=0;i<NEVENT;i++) delete event_ptr_list[i];
+	delete [] round6_def;
+	delete [] hyper_def;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Resetting a pooled vehicle object in place for the next Monte Carlo run
+//Restores the module-variable values to their state after the module
+// definitions, re-draws the random ones and clears the events and Markov
+// variables that 'vehicle_data()' rebuilds. The output arrays depend only on
+// the definitions and are kept; so are the tables, the GNSS almanac and the
+// star catalog, which are read only once per vehicle object. The GNSS
+// propagation starts anew and the turbulence field is re-bound to the run.
+///////////////////////////////////////////////////////////////////////////////
+
+void Hyper::reset(Module *module_list,int num_modules)
+{
+	int i(0);
+	for(i=0;i<NROUND6;i++) round6[i].restore(round6_def[i]);
+	for(i=0;i<NHYPER;i++) hyper[i].restore(hyper_def[i]);
+
+	nevent=0;
+	event_total=0;
+	for(i=0;i<NMARKOV;i++){
+		markov_list[i].set_markov_round6_index(ILARGE);
+		markov_list[i].set_markov_vehicle_index(ILARGE);
+	}
+	nmarkov=0;
+
+	//re-drawing the INS instrument errors, which the definitions draw at random
+	for(int j=0;j<num_modules;j++)
+		if((module_list[j].name=="ins")&&(module_list[j].definition=="def"))
+			def_ins();
+
+	//no warm start of the Kepler solver from the previous run
+	kepler.reset();
+
+	//GNSS constellation anchored anew at the first propagation
+	constellation.reset();
+
+	//turbulence field of this run, same parameters as in the first run
+	turbulence.rebind();
 }
 ///////////////////////////////////////////////////////////////////////////////
 //////////////////// Members of class 'Vehicle' ///////////////////////////////
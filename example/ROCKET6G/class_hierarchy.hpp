@@ -74,12 +74,14 @@ public:
 	virtual void tabout_banner(ofstream &ftabout,char *title,int &nmonte,int &nmc)=0;
 	virtual void tabout_data(ofstream &ftabout)=0;
 	virtual void vehicle_data(fstream &input,int nmonte)=0;
+	virtual void reset(Module *module_list,int num_modules)=0;
 	virtual void read_tables(char *file_name,Datadeck &datatable)=0;
 	virtual void scrn_index_arrays()=0;
 	virtual void scrn_data()=0;
 	virtual void plot_banner(ofstream &fplot,char *title)=0;
 	virtual void plot_index_arrays()=0;
-	virtual void plot_data(ofstream &fplot,bool merge)=0;
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step)=0;
+	virtual void record_output()=0;
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot)=0;
 	virtual void event(char *options)=0;
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle)=0;
@@ -159,6 +161,8 @@ protected:
 	Table *table;
 	//declaring Datadeck 'weathertable' that stores all weather tables
 	Datadeck weathertable;
+	//declaring Turbulence 'turbulence' that serves the pre-generated turbulence field
+	Turbulence turbulence;
 
 public:
 	Round6();
@@ -173,12 +177,14 @@ public:
 	virtual void tabout_banner(ofstream &ftabout,char *title,int &nmonte,int &nmc)=0;
 	virtual void tabout_data(ofstream &ftabout)=0;
 	virtual void vehicle_data(fstream &input,int nmonte)=0;
+	virtual void reset(Module *module_list,int num_modules)=0;
 	virtual void read_tables(char *file_name,Datadeck &datatable)=0;
 	virtual void scrn_index_arrays()=0;
 	virtual void scrn_data()=0;
 	virtual void plot_banner(ofstream &fplot,char *title)=0;
 	virtual void plot_index_arrays()=0;
-	virtual void plot_data(ofstream &fplot,bool merge)=0;
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step)=0;
+	virtual void record_output()=0;
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot)=0;
 	virtual void event(char *options)=0;
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle)=0;
@@ -231,7 +237,10 @@ public:
 	virtual void environment(double int_step);
 
 	//functions in respective modules
-	Matrix environment_dryden(double dvba,double int_step); 
+	Matrix environment_dryden(double dvba,double int_step,int mturb); 
+
+	//attaching the state derivatives of 'newton' to an output plan
+	void dense_rates(Output *plan,int *round6_ind,int round6_count);
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -284,6 +293,15 @@ protected:
 	//be written to 'combus' 'packets'
 	int *hyper_com_ind; int hyper_com_count;
 
+	//output plans compiled by the index arrays and executed by the writers
+	Output *scrn_plan; int nscrn_plan;
+	Output *plot_plan; int nplot_plan;
+	Output *com_plan; int ncom_plan;
+
+	//module-variable arrays after the module definitions, restored by 'reset()'
+	Variable *round6_def;
+	Variable *hyper_def;
+
 	//array of module-variables that carry Markov process random values
 	Markov markov_list[NMARKOV]; int nmarkov;
 
@@ -291,6 +309,14 @@ protected:
 	Datadeck aerotable;
 	//declaring Datadeck 'proptable' that stores all aero tables
 	Datadeck proptable;
+	//declaring Constellation 'constellation' that stores the GNSS almanac SVs
+	Constellation constellation;
+	//pseudo-range bias and noise, delta-range noise of GNSS channels 5...NCHANNEL
+	double gnss_pr_bias[NCHANNEL],gnss_pr_noise[NCHANNEL],gnss_dr_noise[NCHANNEL];
+	//declaring Starcatalog 'starcatalog' that stores the zone-indexed star catalog
+	Starcatalog starcatalog;
+	//declaring Kepler 'kepler' that projects the LTG end state
+	Kepler kepler;
 
 public:
 	Hyper(){};
@@ -306,12 +332,14 @@ public:
 	virtual void tabout_banner(ofstream &ftabout,char *title,int &nmonte,int &nmc);
 	virtual void tabout_data(ofstream &ftabout);
 	virtual void vehicle_data(fstream &input,int nmonte);
+	virtual void reset(Module *module_list,int num_modules);
 	virtual void read_tables(char *file_name,Datadeck &datatable);
 	virtual void scrn_index_arrays();
 	virtual void scrn_data();
 	virtual void plot_banner(ofstream &fplot,char *title);
 	virtual void plot_index_arrays();
-	virtual void plot_data(ofstream &fplot,bool merge);
+	virtual void plot_data(ofstream &fplot,bool merge,double frac,double step);
+	virtual void record_output();
 	virtual void stat_data(ofstream &fstat,int nmc,int vehicle_slot);
 	virtual void event(char *options);
 	virtual void document(ostream &fdoc,char *title,Document *doc_vehicle);
@@ -398,13 +426,16 @@ public:
 
 
 	void gps_sv_init(double *sv_init_data,double &rsi,double &wsi,double &incl);
-	void gps_quadriga(double *ssii_quad,double *vsii_quad,double &gdop,int &mgps 
+	void gps_quadriga(double *ssii_quad,double *vsii_quad,double &gdop,int &mgps,int *quad_slot 
 						,const double *sv_init_data,const double &rsi,const double &wsi
 						,const double &incl,double almanac_time,double del_rearth
 						,double time,Matrix SBII);
+	void gps_constellation(double *ssii_chan,double *vsii_chan,double &gdop,int &mgps,int &nchan
+						,int &gnss_nvis,int gnss_nsel,double almanac_time,double del_rearth
+						,double time,Matrix SBII);
 
-	void star_init(double *star_data,string *star_names);
-	void star_triad(double *usii_triad,double star_volume, double *star_data,double star_el_min,Matrix SBII);
+	void star_init();
+	int star_triad(double *usii_triad,int *triad,double &star_volume,double star_el_min,double star_for,Matrix SBII);
 
 	double rcs_prop(double input,double limiter);
 	int rcs_schmitt(double input_new,double input,double dead_zone,double hysteresis);
@@ -23,6 +23,8 @@
 //
 //				   mturb = 0 no turbulence
 //						 = 1 dryden turbulence model
+//						 = 2 dryden turbulence field of the turbulence service
+//						 = 3 von Karman turbulence field of the turbulence service
 //
 //						 mwind = 0 no wind
 //							   = 1 constant wind, input: dvaeg,psiwdx
@@ -69,6 +71,8 @@ void Round6::def_environment()
 	 round6[83].init("tau",0,"Turblence velocity component in load factor plane - m/s","environment","diag","");
 	 round6[84].init("gauss_value",0,"White Gaussian noise - ND","environment","diag","");
 	 round6[85].init("tempc",0,"Atmospheric temperature - Centigrade","environment","diag","");
+	 round6[86].init("turb_dist",0,"Distance flown through the turbulence field - m","environment","state","");
+	 round6[87].init("turb_cache","int",0,"=1: turbulence field cached in 'turb_*.bin' files - ND","environment","data","");
 }	
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -76,6 +80,8 @@ void Round6::def_environment()
 //Member function of class 'Round6'
 //
 // (1) Initializes airspeed dvba with geographic speed dvbe
+// (2) Binds the turbulence field of the vehicle (mturb=2,3); a pooled vehicle
+//     is re-bound by 'reset()' and only re-generated if the parameters changed
 //
 //030528 Created by Peter H Zipfel
 ///////////////////////////////////////////////////////////////////////////////
@@ -86,10 +92,22 @@ void Round6::init_environment()
 	double dvba(0);
 
 	//localizing module-variables
+	//input data
+	int mair=round6[50].integer();
+	double turb_length=round6[77].real();
+	int turb_cache=round6[87].integer();
 	//input from other modules
 	double dvbe=round6[225].real();
 //-----------------------------------------------------------------------------
 	dvba=dvbe;
+
+	//turbulence field, deterministic per (seed, MC run, vehicle)
+	int mturb=(mair%100)/10;
+	if(mturb>=2&&!turbulence.get_kind())
+		turbulence.bind(mturb,turb_length,turb_cache==1);
+	else if(mturb>=2&&(mturb!=turbulence.get_kind()||turb_length!=turbulence.get_length()
+			||(turb_cache==1)!=turbulence.get_cache()))
+		turbulence.regenerate(mturb,turb_length,turb_cache==1);
 //-----------------------------------------------------------------------------
 	//loading module-variables
 	//initialization
@@ -112,6 +130,8 @@ void Round6::init_environment()
 //
 //				   mturb = 0 no turbulence
 //						 = 1 dryden turbulence model
+//						 = 2 dryden turbulence field of the turbulence service
+//						 = 3 von Karman turbulence field of the turbulence service
 //
 //						 mwind = 0 no wind
 //							   = 1 constant wind, input: dvaeg,psiwdx
@@ -245,8 +265,8 @@ void Round6::environment(double int_step)
 		VAED=VAEDS;
 	}
 	//wind turbulence in normal-load plane
-	if(mturb==1){
-		Matrix VTAD=environment_dryden(dvba,int_step);
+	if(mturb>0){
+		Matrix VTAD=environment_dryden(dvba,int_step,mturb);
 		VAED=VTAD+VAEDS;
 	}
 	//flight conditions
@@ -305,15 +325,18 @@ void Round6::environment(double int_step)
 // Dryden turbulence model
 // Ref: Etkin, Dynamics of Flight,Wiley 1958, p.318
 // Modeling assumption: turbulence is of interest only in the load factor plane
+// mturb=2,3: the turbulence velocity is served from the pre-generated field
+//  of 'turbulence' at the distance flown through the air mass
 // Return output:
 //          VTAD(3)=Velocity of turbulence wrt steady air mass in geodetic coord - m/s
 // Parameter input:
 //          dvba = Vehicle speed wrt air mass - m/s
+//          mturb = 1 Dryden filter, 2 Dryden field, 3 von Karman field
 //
 //030528 Adapted from FORTRAN by Peter H Zipfel
 ///////////////////////////////////////////////////////////////////////////////
 
-Matrix Round6::environment_dryden(double dvba,double int_step)
+Matrix Round6::environment_dryden(double dvba,double int_step,int mturb)
 {	
 	//local variables
 	Matrix VTAD(3,1);
@@ -337,28 +360,36 @@ Matrix Round6::environment_dryden(double dvba,double int_step)
 	double taux1d=round6[80].real();
 	double taux2=round6[81].real();
 	double taux2d=round6[82].real();
+	double turb_dist=round6[86].real();
 	//-------------------------------------------------------------------------
-	//white Gaussian noise with zero mean
-	double value1;
-	do
-		value1=(double)rand()/RAND_MAX;
-	while(value1==0);
-	double value2=(double)rand()/RAND_MAX;
-	gauss_value=(1/sqrt(int_step))*sqrt(2*log(1/value1))*cos(2*PI*value2);
+	if(mturb>=2){
+		//pre-generated field at the distance flown through the air mass
+		turb_dist+=dvba*int_step;
+		tau=turb_sigma*turbulence.sample(turb_dist);
+	}
+	else{
+		//white Gaussian noise with zero mean
+		double value1;
+		do
+			value1=(double)rand()/RAND_MAX;
+		while(value1==0);
+		double value2=(double)rand()/RAND_MAX;
+		gauss_value=(1/sqrt(int_step))*sqrt(2*log(1/value1))*cos(2*PI*value2);
 
-	//filter, converting white gaussian noise into a time sequence of Dryden
-	// turbulence velocity variable 'tau'  (One-dimensional cross-velocity Dryden spectrum)
-	//integrating first state variable
-	double taux1d_new=taux2;
-	taux1=integrate(taux1d_new,taux1d,taux1,int_step);
-	taux1d=taux1d_new;
-	//integrating second state variable
-	double vl=dvba/turb_length;
-	double taux2d_new=-vl*vl*taux1-2*vl*taux2+vl*vl*gauss_value;
-	taux2=integrate(taux2d_new,taux2d,taux2,int_step);
-	taux2d=taux2d_new;
-	//computing Dryden 'tau' from the two filter states ('2*PI' changed to 'PI' according to Pritchard)
-	tau=turb_sigma*sqrt(1/(vl*PI))*(taux1+sqrt(3.)*taux2/vl);
+		//filter, converting white gaussian noise into a time sequence of Dryden
+		// turbulence velocity variable 'tau'  (One-dimensional cross-velocity Dryden spectrum)
+		//integrating first state variable
+		double taux1d_new=taux2;
+		taux1=integrate(taux1d_new,taux1d,taux1,int_step);
+		taux1d=taux1d_new;
+		//integrating second state variable
+		double vl=dvba/turb_length;
+		double taux2d_new=-vl*vl*taux1-2*vl*taux2+vl*vl*gauss_value;
+		taux2=integrate(taux2d_new,taux2d,taux2,int_step);
+		taux2d=taux2d_new;
+		//computing Dryden 'tau' from the two filter states ('2*PI' changed to 'PI' according to Pritchard)
+		tau=turb_sigma*sqrt(1/(vl*PI))*(taux1+sqrt(3.)*taux2/vl);
+	}
 
 	//inserting the turbulence into the load factor plane (aeroballistic 1A-3A plane)
 	// and transforming into body coordinates VTAB=TBA*VTAA; VTAA=[0 0 tau]
@@ -378,6 +409,7 @@ Matrix Round6::environment_dryden(double dvba,double int_step)
 	round6[80].gets(taux1d);
 	round6[81].gets(taux2);
 	round6[82].gets(taux2d);
+	round6[86].gets(turb_dist);
 	//diagnostics
 	round6[83].gets(tau);
 	round6[84].gets(gauss_value);
@@ -23,7 +23,7 @@
 
 //acquiring the simmulation title
 void acquire_title_options(fstream &input,char *title,char *options,int &nmonte
-						   ,int &iseed,int &nmc);
+						   ,int &iseed,char *sampling,int &nmc);
 
 //acquiring the simulation run time
 double acquire_endtime(fstream &input);
@@ -38,7 +38,7 @@ void order_modules(fstream &input,int &num,Module *module_list);
 void number_objects(fstream &input,int &num_vehicles,int &num_hyper);
 
 //creating a type of vehicle object
-Cadac *set_obj_type(fstream &input,Module *module_list,int num_modules);
+Cadac *set_obj_type(fstream &input,Module *module_list,int num_modules,Cadac *pooled);
 
 //running the simulation
 void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
@@ -70,7 +70,7 @@ void traj_banner(ofstream &ftraj,Packet *combus,char *title,int num_vehicles,
 				 int nhyper);
 
 //writing 'traj.asc' file of 'combus' data
-void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge);
+void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge,double frac,double step);
 
 //Documenting 'input.asc' with module-variable definitions
 void document_input(Document *doc_hyper6);
@@ -102,6 +102,7 @@ int main(void)
 	int num_vehicles; //total number of vehicle objects
 	int num_hyper; //number of hyper objects
 	Cadac *vehicle_type=NULL; //array of vehicle object pointers
+	Cadac **vehicle_pool=NULL; //vehicle objects of the first run, reset in place for MC repeat runs
 	char vehicle_name[CHARN]; //name of each vehicle type
 	double end_time; //run termination time from 'input.asc'
 	string *plot_file_list=NULL; //array containing file names of 'ploti.asc', i=1,2,3...
@@ -114,6 +115,7 @@ int main(void)
 	int nmonte=0; //number of MC runs to be executed
 	int nmc=0; //MC counter
 	int iseed; //seeding srand()
+	char sampling[CHARN]="RANDOM"; //DOE method of the static dispersions
 	bool one_traj_banner=true; //write just one banner on file 'traj.asc'
 	bool *stati_write_term=NULL; //flag for writing impact data on 'stati.asc' once
 	Document *doc_hyper6=NULL;  //array for documenting HYPER6 module-variables of 'input.asc'
@@ -158,10 +160,15 @@ int main(void)
 		bool traj_merge=false; //flag used in writing 'time=-1' endblock on 'traj.asc'
 		
 		//aqcuiring title statement and option selections
-		acquire_title_options(input,title,options,nmonte,iseed,nmc);
+		acquire_title_options(input,title,options,nmonte,iseed,sampling,nmc);
 
-		//initializing random number generator
-		if(!nmc) srand(iseed); 
+		//initializing random number generator and design of experiments
+		if(!nmc){
+			srand(iseed);
+			doe_initialize(sampling,nmonte,iseed);
+		}
+		doe_run(nmc);
+		turbulence_run(iseed,nmc);
 
 		//acquiring number of module 
 		number_modules(input,num_modules);
@@ -183,6 +190,13 @@ int main(void)
 		// at this point the constructor 'Vehicle' is called and memory is allocated
 		Vehicle vehicle_list(num_vehicles);
 		
+		//allocating the vehicle object pool, but do it only once
+		if(!nmc){
+			vehicle_pool=new Cadac *[num_vehicles];
+			for(int ii=0;ii<num_vehicles;ii++) vehicle_pool[ii]=NULL;
+		}
+		if(vehicle_pool==0){cerr<<"*** Error: vehicle_pool[] alloc. failed *** \n";system("pause");exit(1);}
+
 		//allocating memory for 'ploti.asc' file streams, but do it only once
 		if(!nmc) plot_ostream_list=new ofstream[num_vehicles];
 		if(plot_ostream_list==0){cerr<<"*** Error: plot_ostream_list[] alloc. failed *** \n";system("pause");exit(1);} 
@@ -229,7 +243,9 @@ int main(void)
 			// as required by the vehicle object 
 			//The function returns the 'vehicle_type' as specified in 'input.asc' 
 			//Furthermore, it passes 'module_list', 'num_modules' to the 'Hyper'constructors
-			vehicle_type=set_obj_type(input,module_list,num_modules);
+			//In MC repeat runs the vehicle object of the previous run is reset in place
+			vehicle_type=set_obj_type(input,module_list,num_modules,vehicle_pool[i]);
+			vehicle_pool[i]=vehicle_type;
  				
 			//add vehicle to 'vehicle_list'
 			vehicle_list.add_vehicle(*vehicle_type);
@@ -362,7 +378,7 @@ int main(void)
 			traj_banner(ftraj,combus,title,num_vehicles,num_hyper);
 
 			//writing data after 'initial module' calculations
-			traj_data(ftraj,combus,num_vehicles,traj_merge);
+			traj_data(ftraj,combus,num_vehicles,traj_merge,1,0);
 		}
 
 		//Acuire ending time (last entry on 'input.asc')
@@ -426,6 +442,8 @@ int main(void)
 		merge_stat_files(stat_file_list,num_hyper,title);
 	}
 	//Deallocate dynamic memory
+	for(f=0;f<num_vehicles;f++) delete vehicle_pool[f];
+	delete [] vehicle_pool;
 	delete [] plot_ostream_list;
 	delete [] plot_file_list;
 	delete [] stat_ostream_list;
@@ -494,9 +512,9 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 	double com_time(0);
 	int vehicle_slot(0);
 	bool increment_scrn_time(false);
-	bool increment_plot_time(false);
 	bool plot_merge(false);
 	double out_fact(0);
+	double sim_time_last(sim_time-int_step);
 
 	//integration loop
 	while (sim_time<=(end_time+int_step))
@@ -588,16 +606,6 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 				if(increment_scrn_time) scrn_time+=scrn_step*(1+out_fact);
 			}
 
-			//output to 'ploti.asc' file
-			if(fabs(plot_time-sim_time)<(int_step/2+EPS))
-			{
-				if(strstr(options,"y_plot"))
-				{
-					vehicle_list[i]->plot_data(plot_ostream_list[i],plot_merge);
-					if(i==(num_vehicles-1))increment_plot_time=true;
-				}
-				if(increment_plot_time) plot_time+=plot_step*(1+out_fact);
-			}
 			//output to 'stati.asc' file 
 			if(strstr(options,"y_stat"))
 			{
@@ -611,6 +619,25 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			}
 		} //end of vehicle loop
 
+		//dense output: plot and traj times passed during the last step are sampled
+		//exactly, interpolating between 'sim_time_last' and 'sim_time'
+		double step=sim_time-sim_time_last;
+		double snap=int_step/100;
+
+		//output to 'ploti.asc' files
+		if(strstr(options,"y_plot"))
+		{
+			while(plot_time>sim_time_last&&plot_time<sim_time+snap)
+			{
+				double frac(1);
+				if(fabs(plot_time-sim_time)>=snap) frac=(plot_time-sim_time_last)/step;
+				for(int i=0;i<num_vehicles;i++)
+					vehicle_list[i]->plot_data(plot_ostream_list[i],plot_merge,frac,step);
+				if(plot_step*(1+out_fact)<=0) break;
+				plot_time+=plot_step*(1+out_fact);
+			}
+		}
+
 		//outputting 'combus' to screen 
 		if(fabs(com_time-sim_time)<(int_step/2+EPS))
 		{
@@ -621,17 +648,27 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			com_time+=com_step*(1+out_fact);
 		}
 		//outputting'combus' to 'traj.asc' file
-		if(fabs(traj_time-sim_time)<(int_step/2+EPS))
+		if(strstr(options,"y_traj"))
 		{
-			if(strstr(options,"y_traj"))
+			while(traj_time>sim_time_last&&traj_time<sim_time+snap)
 			{
-				traj_data(ftraj,combus,num_vehicles,traj_merge);
+				double frac(1);
+				if(fabs(traj_time-sim_time)>=snap) frac=(traj_time-sim_time_last)/step;
+				traj_data(ftraj,combus,num_vehicles,traj_merge,frac,step);
+				if(traj_step*(1+out_fact)<=0) break;
+				traj_time+=traj_step*(1+out_fact);
 			}
-			traj_time+=traj_step*(1+out_fact);
 		}
+		//recording the output plans at the end of the step for dense output
+		if(strstr(options,"y_plot")||strstr(options,"y_traj"))
+		{
+			for(int i=0;i<num_vehicles;i++)
+				vehicle_list[i]->record_output();
+		}
+		sim_time_last=sim_time;
+
 		//resetting output events
 		increment_scrn_time=false;
-		increment_plot_time=false;
 
 		//advancing time
 		sim_time+=int_step;
@@ -644,14 +681,14 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 	{
 		plot_merge=true;
 		for (int i=0;i<num_vehicles;i++)
-			vehicle_list[i]->plot_data(plot_ostream_list[i],plot_merge);
+			vehicle_list[i]->plot_data(plot_ostream_list[i],plot_merge,1,0);
 	}
 	//writing last integration out to 'traj.asc' 
 	//with time set to '-1' for multiple CADAC-Studio plots
 	if(strstr(options,"y_traj"))
 	{
 		traj_merge=true;
-		traj_data(ftraj,combus,num_vehicles,traj_merge);
+		traj_data(ftraj,combus,num_vehicles,traj_merge,1,0);
 	}
 } 
 
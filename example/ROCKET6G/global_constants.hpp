@@ -43,4 +43,6 @@ int const NHYPER=950;					//size of 'hyper' module-variable array
 int const NEVENT=20;					//max number of events
 int const NVAR=50;						//max number of variables to be input at every event 
 int const NMARKOV=20;					//max number of Markov noise variables
+int const NCHANNEL=12;					//max number of GNSS receiver channels
+int const NTURB=32768;					//samples of periodic von Karman turbulence field (power of 2)
 #endif
\ No newline at end of file
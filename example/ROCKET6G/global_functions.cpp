@@ -14,7 +14,7 @@
 //Acquiring simulation title and option line from the input file 'input.asc'.
 //Printing of title banner to screen
 //
-//Parameter output: *title, *options, &nmonte, &iseed
+//Parameter output: *title, *options, &nmonte, &iseed, *sampling
 //
 //Parameter input: &nmc
 //
@@ -23,7 +23,7 @@
 //030415 Adopted for HYPER simulation, PZi
 ///////////////////////////////////////////////////////////////////////////////
 
-void acquire_title_options(fstream &input,char *title,char *options,int &nmonte,int &iseed,int &nmc)
+void acquire_title_options(fstream &input,char *title,char *options,int &nmonte,int &iseed,char *sampling,int &nmc)
 { 
 	char read[CHARN];
 	char line_clear[CHARL];
@@ -46,6 +46,14 @@ void acquire_title_options(fstream &input,char *title,char *options,int &nmonte,
 		{
 			input>>nmonte;
 			input>>iseed;
+			//optional DOE method of the static dispersions, see 'doe_initialize()'
+			input.getline(line_clear,CHARL,'\n');
+			strcpy(sampling,"RANDOM");
+			char *token=strtok(line_clear," \t\r");
+			if(token&&!ispunct(token[0])){
+				strncpy(sampling,token,CHARN-1);
+				sampling[CHARN-1]='\0';
+			}
 			cout<<" MONTE Run # "<<nmc+1<<'\n';
 		}
 	}while((strcmp(read,"OPTIONS"))&&(n<50));
@@ -263,12 +271,14 @@ void number_objects(fstream &input,int &num_vehicles,int &num_hyper)
 //Arguments of object: module_list, num_modules to be passed 
 // to the constructor of 'Hyper'
 //Return output: type, type-of-vehicle as defined in 'input.asc'
+//Parameter input: pooled = vehicle object of the previous Monte Carlo run in this
+// slot (NULL in the first run); if of the same type it is reset in place and returned
 //
 //011128 Created by Peter H Zipfel
 //030415 Adopted for HYPER simulation, PZi
 ///////////////////////////////////////////////////////////////////////////////
 
-Cadac *set_obj_type(fstream &input,Module *module_list,int num_modules)				   
+Cadac *set_obj_type(fstream &input,Module *module_list,int num_modules,Cadac *pooled)				   
 {
 	char line_clear[CHARL];
 	char temp[CHARN];
@@ -285,6 +295,15 @@ Cadac *set_obj_type(fstream &input,Module *module_list,int num_modules)
 			input.getline(line_clear,CHARL,'\n');
 	}while(ispunct(temp[0]));
 
+	//re-using the pooled vehicle object
+	if(pooled){
+		if(!strcmp(pooled->get_vname(),temp)){
+			pooled->reset(module_list,num_modules);
+			return pooled;
+		}
+		delete pooled;
+	}
+
 	if (!strcmp(temp,"HYPER6"))
 	{
 		//the pointer 'obj' is allocated the type 'Hyper' 
@@ -530,18 +549,19 @@ void traj_banner(ofstream &ftraj,Packet *combus,char *title,int num_vehicles,
 //five accross, unlimited down
 //data field 16 spaces, total width 80 spaces
 //
+//Parameter input:
+//	frac = fraction of the last integration step 'step' at which the data are
+//		sampled; frac=1 writes the current values
+//
 //010212 Created by Peter Zipfel
 //030415 Adopted for HYPER simulation, PZi
 //050214 Added third object for GSWS6, PZi
 ///////////////////////////////////////////////////////////////////////////////
 
-void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
+void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge,double frac,double step)
 {
-	char *integer=NULL;
-	char *name=NULL;
-	Matrix VEC(3,1);
 	int k=0;
-	Variable *data=NULL;
+	Output *plan=NULL;
 	int ndata(0);
 	string id;
 	int hyper_object(0);	
@@ -559,6 +579,7 @@ void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
 	{
 		Variable *data_c1=combus[0].get_data();
 		double time=data_c1[0].real();
+		if(frac<1) time=combus[0].get_plan()[0].sample(0,frac,step);
 		ftraj.width(16);
 		ftraj<<time;
 		k=1;
@@ -573,49 +594,40 @@ void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
 		if(!hyper_object)
 		//'Hyper' object
 		{
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//writing communication variables to 'traj.asc'
 			for(int j=1;j<ndata;j++)
 			{
-
-				integer=data[j].get_type();
-				name=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<(double) data[j].integer();			
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<(double) *out.integer;
 					k++;
 				}
-				//checking vor vectors
-				else if(isupper(name[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(0,0);
-					k++; 
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(1,0);
-					k++;
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>4){k=0;ftraj<<'\n';}
+						ftraj.width(16);
+						if(frac<1) ftraj<<out.sample(m,frac,step);
+						else ftraj<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>4){k=0;ftraj<<'\n';}
 					ftraj.width(16);
-					ftraj<<data[j].real(); 
+					if(frac<1) ftraj<<out.sample(0,frac,step);
+					else ftraj<<*out.real;
 					k++;
 				}
 			}
@@ -647,10 +659,7 @@ void comscrn_data(Packet *combus,int num_vehicles)
 	int ncom_hyper6; //number of module variables in 'com_hyper6'
 	Variable *data_hyper; //Variable array stored in 'Packet data' of type Hyper
 	int ndata(0);
-	Variable *data=NULL;
-	char *integer=NULL;
-	char *vector=NULL;
-	Matrix VEC(3,1);
+	Output *plan=NULL;
 
 	//find first hyper packet index in 'combus'
 	for(i=0;i<num_vehicles;i++)
@@ -718,8 +727,8 @@ void comscrn_data(Packet *combus,int num_vehicles)
 		//'Hyper' object
 		{
 			p++;
-			data=combus[i].get_data();
 			ndata=combus[i].get_ndata();
+			plan=combus[i].get_plan();
 
 			//write out label of i-th object
 			cout<<"\n *** h_";cout.width(8);cout<<p;
@@ -728,42 +737,31 @@ void comscrn_data(Packet *combus,int num_vehicles)
 			//writing communication variables to screen
 			for(int j=1;j<ndata;j++)
 			{
-				integer=data[j].get_type();
-				vector=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
+				Output &out=plan[j];
+				if(out.kind==1)
 				{
 					//casting integer to real variable
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<(double) data[j].integer();			
+					cout<<(double) *out.integer;
 					k++;
 				}
-				//checking vor vectors
-				else if(isupper(vector[0]))
+				else if(out.kind==2)
 				{
-					VEC=data[j].vec();
-
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(0,0);
-					k++; 
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(1,0);
-					k++;
-					if(k>7){k=0;cout<<'\n';}
-					cout.width(15);
-					cout<<VEC.get_loc(2,0);
-					k++;
+					double *vec=out.vec->get_pbody();
+					for(int m=0;m<3;m++)
+					{
+						if(k>7){k=0;cout<<'\n';}
+						cout.width(15);
+						cout<<vec[m];
+						k++;
+					}
 				}
-				//left are real variables
 				else
 				{
 					if(k>7){k=0;cout<<'\n';}
 					cout.width(15);
-					cout<<data[j].real(); 
+					cout<<*out.real;
 					k++;
 				}
 			}
@@ -1053,7 +1051,8 @@ void document_input(Document *doc_hyper6)
 					input<<line_clear<<'\n';
 				}
 				//inserting whole line starting with certain key words
-				else if(!strcmp(buffn,"AERO_DECK")||!strcmp(buffn,"PROP_DECK")||!strcmp(buffn,"WEATHER_DECK")){
+				else if(!strcmp(buffn,"AERO_DECK")||!strcmp(buffn,"PROP_DECK")||!strcmp(buffn,"WEATHER_DECK")
+					||!strcmp(buffn,"GNSS_DECK")||!strcmp(buffn,"STAR_DECK")){
 					input<<"\t\t\t"<<buffn;
 					fcopy.getline(line_clear,CHARL,'\n');
 					input<<line_clear<<'\n';
@@ -64,6 +64,13 @@ void Hyper::def_gps()
 	hyper[736].init("lon4",0,"Longitude of 4st SV - deg","gps","dia","");
 	hyper[737].init("lat4",0,"Latitude of 4st SV - deg","gps","dia","");
 	hyper[738].init("alt4",0,"Altitude of 4st SV - m","gps","dia","");
+	hyper[740].init("quad_slot1","int",0,"Slot# of SV 1 of the last quadriga (warm start) - ND","gps","save","");
+	hyper[741].init("quad_slot2","int",0,"Slot# of SV 2 of the last quadriga (warm start) - ND","gps","save","");
+	hyper[742].init("quad_slot3","int",0,"Slot# of SV 3 of the last quadriga (warm start) - ND","gps","save","");
+	hyper[743].init("quad_slot4","int",0,"Slot# of SV 4 of the last quadriga (warm start) - ND","gps","save","");
+	hyper[744].init("gnss_nsel","int",0,"=0:24 SV GPS quadriga; >=4:best-N of GNSS_DECK SVs - ND","gps","data","");
+	hyper[745].init("gnss_nvis","int",0,"Number of visible GNSS_DECK SVs - ND","gps","diag","");
+	hyper[746].init("gnss_ntrack","int",0,"Number of SVs tracked by the filter - ND","gps","diag","");
 	//GPS filter
 	hyper[750].init("uctime_cor",0,"User clock correlation time constant - s","gps","data","");
 	hyper[751].init("ppos",0,"Init 1sig pos values of state cov matrix - m","gps","data","");
@@ -98,6 +105,12 @@ void Hyper::def_gps()
 	hyper[779].init("gps_vel_meas",0,"GPS velocity measurement residuals - m/s","gps","diag","scrn,plot");
 	hyper[780].init("state_pos",0,"State x absolute position value - m","gps","diag","scrn,plot");
 	hyper[781].init("state_vel",0,"State x absolute velocity value - m","gps","diag","scrn,plot");
+	//GNSS receiver channels 5...NCHANNEL (channels 1...4 use 'pr1_bias'...'dr4_noise')
+	hyper[782].init("gnss_bias",0,"1sig pseudo-range bias of channels 5...NCHANNEL - m","gps","data","");
+	hyper[783].init("gnss_prnoise",0,"1sig pseudo-range noise of channels 5...NCHANNEL - m","gps","data","");
+	hyper[784].init("gnss_prbcor",0,"Beta correlation of pseudo-range noise of ch 5... - 1/s","gps","data","");
+	hyper[785].init("gnss_drnoise",0,"1sig delta-range noise of channels 5...NCHANNEL - m/s","gps","data","");
+	hyper[786].init("gnss_drbcor",0,"Beta correlation of delta-range noise of ch 5... - 1/s","gps","data","");
 }
 ///////////////////////////////////////////////////////////////////////////////  
 //GPS module
@@ -115,13 +128,18 @@ void Hyper::def_gps()
 //   given by the Yuma Almanac Week 787 (21 Sep 2014)
 //  The 24 satellites are arranged in 6 circular orbits at intervals of 60 deg right ascension
 //   and 55 deg inclination
+//  With 'gnss_nsel'>0 the SVs are read instead from the Yuma almanac of GNSS_DECK (any
+//   number and mix of constellations); the best 'gnss_nsel' visible SVs, or all in view if
+//   fewer, are tracked with a pseudo-range and delta-range each
 //  The pseudo-range errors are ephemeris, ionospheric and tropospheric; receiver noise and bias
 //  The delta-range errors are receiver dynamic noise
 //	The user clock errors are bias and frequency           
 //
 //* Kalman filter
 //  Eight states: 3 postion, 3 velocity, clock bias and frequency
-//  Observation matrix is 8x8 and nonlinear (-> extended K.F.)
+//  Observation matrix is 8x8 and nonlinear (-> extended K.F.); 2Nx8 for N tracked SVs
+//  More than four SVs are processed as sequential scalar updates ('RR' is diagonal), which
+//   avoids the cofactor inverse of the 2Nx2N innovation covariance matrix
 //	The position and velocity states update the INS nav solution
 //	Clock bias is updated 
 //
@@ -137,12 +155,13 @@ void Hyper::gps(double int_step)
 	static double wsi(0); //constant, same for all objects, -> static ok;
 	static double incl(0); //constant, same for all objects, -> static ok
 	static double sv_init_data[48];
-	double ssii_quad[16]; //quadriga inertial coordinates and SV slot#
-	double vsii_quad[12]; //quadriga inertial velocities
+	double ssii_quad[4*NCHANNEL]; //quadriga (tracked SVs) inertial coordinates and SV slot#
+	double vsii_quad[3*NCHANNEL]; //quadriga (tracked SVs) inertial velocities
 	double dtime_gps(0);
 	double time_gps(0);
-	double slot[4]={0,0,0,0}; //SV slot#  of quadriga
-	Matrix ZZ(8,1);
+	double slot[NCHANNEL]; //SV slot#  of quadriga (tracked SVs)
+	int nchan(4); //number of tracked SVs
+	bool update(false); //filter update at this epoch
 	double slotm(0);
 	Matrix PR_BIAS(4,1);	
 	Matrix PR_NOISE(4,1);
@@ -151,9 +170,7 @@ void Hyper::gps(double int_step)
 	static Matrix FF(8,8); //constant, same for all objects, -> static ok
 	static Matrix PHI(8,8);//constant, same for all objects, -> static ok
 	Matrix XH(8,1); //local
-	Matrix RR(8,8); //local
 	Matrix QQ(8,8); //local
-	Matrix HH(8,8); //local
 	Matrix PP(8,8);  //recursive, must be saved; separated into 8 PPx(3x3)
 	int i(0);
 	int j(0);
@@ -165,6 +182,8 @@ void Hyper::gps(double int_step)
 	double std_pos(0);
 	double std_vel(0);
 	double std_ucbias(0);
+	int gnss_nvis(0);
+	int gnss_ntrack(0);
 	//localizing module-variables
 	//input data
 	int mgps=hyper[700].integer();
@@ -186,6 +205,12 @@ void Hyper::gps(double int_step)
 	double dr2_noise=hyper[723].real();
 	double dr3_noise=hyper[724].real();	
 	double dr4_noise=hyper[725].real();
+	int gnss_nsel=hyper[744].integer();
+	double gnss_bias=hyper[782].real();
+	double gnss_prnoise=hyper[783].real();
+	double gnss_prbcor=hyper[784].real();
+	double gnss_drnoise=hyper[785].real();
+	double gnss_drbcor=hyper[786].real();
 	//assemble bias and noise measurement vectors 
 	PR_BIAS[0]=pr1_bias;
 	PR_BIAS[1]=pr2_bias;
@@ -219,6 +244,11 @@ void Hyper::gps(double int_step)
 	int gps_acq=hyper[708].integer();
 	double ucfreqm=hyper[713].real();
 	double slotsum=hyper[726].real();
+	int quad_slot[4];
+	quad_slot[0]=hyper[740].integer();
+	quad_slot[1]=hyper[741].integer();
+	quad_slot[2]=hyper[742].integer();
+	quad_slot[3]=hyper[743].integer();
 	double gps_pos_meas=hyper[778].real();
 	double gps_vel_meas=hyper[779].real();
 
@@ -291,6 +321,21 @@ void Hyper::gps(double int_step)
 		//24 SVs initialization
 		gps_sv_init(sv_init_data,rsi,wsi,incl);
 
+		//GNSS_DECK SVs
+		if(gnss_nsel){
+			if(!constellation.get_nsv())
+				{cerr<<" *** Error: 'gnss_nsel' > 0 requires the SVs of a GNSS_DECK *** \n";system("pause");exit(1);}
+			if(gnss_nsel<4||gnss_nsel>NCHANNEL)
+				{cerr<<" *** Error: 'gnss_nsel' must be 4..."<<NCHANNEL<<" *** \n";system("pause");exit(1);}
+		}
+		//independent errors of channels 5...gnss_nsel, drawn anew at each acquisition
+		// (none for the quadriga, so that its random number sequence is unchanged)
+		for(i=4;i<gnss_nsel;i++){
+			gnss_pr_bias[i]=gauss(0,gnss_bias);
+			gnss_pr_noise[i]=gauss(0,gnss_prnoise);
+			gnss_dr_noise[i]=gauss(0,gnss_drnoise);
+		}
+
 		//filter initialization
 		//covariance matrix
 		for(i=0;i<3;i++){
@@ -379,11 +424,29 @@ void Hyper::gps(double int_step)
 		time_gps=0;
 		gps_epoch=time;
 
-		//*** SV propagation and quadriga selection 'ssii_quad' (4 SVs with best GDOP) ***
-		gps_quadriga(ssii_quad,vsii_quad,gdop,mgps, sv_init_data,rsi,wsi,incl,almanac_time,del_rearth,time,SBII);
-		
+		if(gnss_nsel)
+			//*** GNSS_DECK SV propagation and selection of best 'gnss_nsel' SVs (or all in view) ***
+			gps_constellation(ssii_quad,vsii_quad,gdop,mgps,nchan,gnss_nvis,gnss_nsel,almanac_time,del_rearth,time,SBII);
+		else
+			//*** SV propagation and quadriga selection 'ssii_quad' (4 SVs with best GDOP) ***
+			gps_quadriga(ssii_quad,vsii_quad,gdop,mgps,quad_slot, sv_init_data,rsi,wsi,incl,almanac_time,del_rearth,time,SBII);
+
+		//a GNSS_DECK re-acquisition skips the update; the quadriga updates with the
+		// last quadriga also when it initiates re-acquisition (original behavior)
+		update=mgps==3||!gnss_nsel;
+	}
+	//filter update with the tracked SVs
+	if(update)
+	{
+		gnss_ntrack=nchan;
+
+		//measurement vector, observation and measurement noise covariance matrices
+		Matrix ZZ(2*nchan,1);
+		Matrix HH(2*nchan,8);
+		Matrix RR(2*nchan,2*nchan);
+
 		//Pseudo-range and range-rate measurements
-		for(i=0;i<4;i++){
+		for(i=0;i<nchan;i++){
 			//unpacking i-th SV inertial position
 			Matrix SSII(3,1);
 			for(j=0;j<3;j++){
@@ -405,7 +468,13 @@ void Hyper::gps(double int_step)
 			double dsb=SSBI.absolute();
 
 			//measured pseudo-range
-			double dsb_meas=dsb+PR_BIAS[i]+PR_NOISE[i]+ucbias_error;
+			double dsb_meas(0);
+			if(i<4)
+				dsb_meas=dsb+PR_BIAS[i]+PR_NOISE[i]+ucbias_error;
+			else{
+				gnss_pr_noise[i]=markov(gnss_prnoise,gnss_prbcor,time,gps_step,gnss_pr_noise[i]);
+				dsb_meas=dsb+gnss_pr_bias[i]+gnss_pr_noise[i]+ucbias_error;
+			}
 
 			//unpacking i-th SV inertial velocity
 			Matrix VSII(3,1);
@@ -422,7 +491,13 @@ void Hyper::gps(double int_step)
 			double dvsb=VSBI^USSBI;
 
 			//measured delta-range rate
-			double dvsb_meas=dvsb+DR_NOISE[i]+ucfreq_error;
+			double dvsb_meas(0);
+			if(i<4)
+				dvsb_meas=dvsb+DR_NOISE[i]+ucfreq_error;
+			else{
+				gnss_dr_noise[i]=markov(gnss_drnoise,gnss_drbcor,time,gps_step,gnss_dr_noise[i]);
+				dvsb_meas=dvsb+gnss_dr_noise[i]+ucfreq_error;
+			}
 
 			//INS derived range measurements
 			Matrix SSBIC(3,1);
@@ -439,19 +514,19 @@ void Hyper::gps(double int_step)
 			double dvsbc=VSBIC^USSBIC;
 
 			//loading measurement residuals into measurement vector
-			// ZZ[0->3] range meas resid of SV's; ZZ[4->7] range-rate meas resid of SV's
+			// ZZ[0->3] range meas resid of SV's; ZZ[4->7] range-rate meas resid of SV's (for 4 SVs)
 			ZZ[i]=dsb_meas-dsbc;
-			ZZ[i+4]=dvsb_meas-dvsbc;
+			ZZ[i+nchan]=dvsb_meas-dvsbc;
 
 			//observation matrix of filter
 			for(j=0;j<3;j++){
 				HH.assign_loc(i,j,USSBI.get_loc(j,0));
-				HH.assign_loc(i+4,j+3,USSBI.get_loc(j,0)*gps_step);
+				HH.assign_loc(i+nchan,j+3,USSBI.get_loc(j,0)*gps_step);
 			}
 			HH.assign_loc(i,6,1);
-			HH.assign_loc(i+4,7,gps_step);
+			HH.assign_loc(i+nchan,7,gps_step);
 
-			//for diagnostics: loading the 4 SV slot # of the quadriga
+			//for diagnostics: loading the SV slot # of the quadriga (tracked SVs)
 			*(slot+i)=*(ssii_quad+4*i+3);
 			//accumulating sum of slots
 			slotm=slotm+slot[i];
@@ -460,11 +535,15 @@ void Hyper::gps(double int_step)
 		// but only if they have changed (i.e., sum of slot# has changed)
 		if(slotsum!=slotm){
 			slotsum=slotm;
-			cout<<" *** GPS Quadriga slot # "<<slot[0]<<"  "<<slot[1]<<"  "<<slot[2]<<"  "<<slot[3]<<" ;  GDOP = "<<gdop<<" m ***\n";
+			if(gnss_nsel)
+				cout<<" *** GNSS "<<nchan<<" SVs ID #";
+			else
+				cout<<" *** GPS Quadriga slot #";
+			for(i=0;i<nchan;i++)
+				cout<<(i?"  ":" ")<<slot[i];
+			cout<<" ;  GDOP = "<<gdop<<" m ***\n";
 		}
 		//*** filter correction and update (to INS: 'SXH' and 'VXH') ***
-		//filter gain
-		Matrix KK(8,8);
 		/*/z150612
 		cout<<"PP = \n";
 		PP.print();
@@ -473,17 +552,33 @@ void Hyper::gps(double int_step)
 		//z150612*/
 
 		//measurement noise covariance matrix
-		for(i=0;i<4;i++){
+		for(i=0;i<nchan;i++){
 			RR.assign_loc(i,i,pow(rpos*(1+factr),2));
-			RR.assign_loc(i+4,i+4,pow(rvel*(1+factr),2));
+			RR.assign_loc(i+nchan,i+nchan,pow(rvel*(1+factr),2));
 		}		
-		//Kalman gain
-		KK=PP*~HH*(HH*PP*~HH+RR).inverse();
-		//state correction
-		XH=KK*ZZ;
-		//covariance correction for next cycle
 		Matrix EYE(8,8);
-		PP=(EYE.identity()-KK*HH)*PP;
+		EYE.identity();
+		if(nchan==4){
+			//filter gain
+			Matrix KK(8,8);
+			//Kalman gain
+			KK=PP*~HH*(HH*PP*~HH+RR).inverse();
+			//state correction
+			XH=KK*ZZ;
+			//covariance correction for next cycle
+			PP=(EYE-KK*HH)*PP;
+		}
+		else{
+			//sequential scalar updates, one per measurement
+			for(n=0;n<2*nchan;n++){
+				Matrix HN=HH.row_vec(n+1);
+				Matrix PHN=PP*~HN;
+				double sn=(HN*PHN).get_loc(0,0)+RR.get_loc(n,n);
+				Matrix KN=PHN*(1/sn);
+				XH=XH+KN*(ZZ[n]-(HN*XH).get_loc(0,0));
+				PP=(EYE-KN*HN)*PP;
+			}
+		}
 
 		//clock error bias update
 		ucbias_error=ucbias_error-XH.get_loc(6,0);
@@ -506,7 +601,7 @@ void Hyper::gps(double int_step)
 
 		//diagnostics of 1st SV of quadriga saved to plot file 
 		gps_pos_meas=ZZ.get_loc(0,0);
-		gps_vel_meas=ZZ.get_loc(4,0);
+		gps_vel_meas=ZZ.get_loc(nchan,0);
 
 		//decomposing state vector for output
 		for(int m=0;m<3;m++){
@@ -561,8 +656,14 @@ void Hyper::gps(double int_step)
 	hyper[710].gets(ucbias_error);
 	hyper[713].gets(ucfreqm);
 	hyper[726].gets(slotsum);	
+	hyper[740].gets(quad_slot[0]);
+	hyper[741].gets(quad_slot[1]);
+	hyper[742].gets(quad_slot[2]);
+	hyper[743].gets(quad_slot[3]);
 	//diagnostics
 	hyper[704].gets(gdop);
+	hyper[745].gets(gnss_nvis);
+	hyper[746].gets(gnss_ntrack);
 	hyper[711].gets(ucfreq_error);
 	hyper[766].gets_vec(CXH);
 	hyper[775].gets(std_pos);
@@ -587,6 +688,156 @@ void Hyper::gps(double int_step)
 	hyper[738].gets(alt4);
 }
 ///////////////////////////////////////////////////////////////////////////////
+//GDOP^2 of a quadriga from the Gram matrix of the GPS 'H' rows [u,1]
+//Closed-form trace of the inverse of the symmetric 4x4 matrix G=H*H^T:
+// trace(G^-1)=(sum of principal 3x3 minors)/det(G), both built from the
+// 2x2 minors of the upper and lower row pairs
+//
+//parameter input:
+//	*gvis = Gram matrix of all visible SVs, gvis[n*k+l]=u_k^u_l+1
+//	n = number of visible SVs
+//	i1,i2,i3,i4 = quadriga SVs
+//return output:
+//	GDOP^2 (LARGE if the geometry is singular)
+///////////////////////////////////////////////////////////////////////////////
+static double quadriga_gdop2(const double *gvis,int n,int i1,int i2,int i3,int i4)
+{
+	const int k[4]={i1,i2,i3,i4};
+	double g[4][4];
+	for(int a=0;a<4;a++)
+		for(int b=0;b<4;b++)
+			g[a][b]=gvis[n*k[a]+k[b]];
+
+	double s0=g[0][0]*g[1][1]-g[1][0]*g[0][1];
+	double s1=g[0][0]*g[1][2]-g[1][0]*g[0][2];
+	double s2=g[0][0]*g[1][3]-g[1][0]*g[0][3];
+	double s3=g[0][1]*g[1][2]-g[1][1]*g[0][2];
+	double s4=g[0][1]*g[1][3]-g[1][1]*g[0][3];
+	double s5=g[0][2]*g[1][3]-g[1][2]*g[0][3];
+	double c0=g[2][0]*g[3][1]-g[3][0]*g[2][1];
+	double c1=g[2][0]*g[3][2]-g[3][0]*g[2][2];
+	double c2=g[2][0]*g[3][3]-g[3][0]*g[2][3];
+	double c3=g[2][1]*g[3][2]-g[3][1]*g[2][2];
+	double c4=g[2][1]*g[3][3]-g[3][1]*g[2][3];
+	double c5=g[2][2]*g[3][3]-g[3][2]*g[2][3];
+
+	double det=s0*c5-s1*c4+s2*c3+s3*c2-s4*c1+s5*c0;
+	if(det<=0) return LARGE;
+	double trace_adj=(g[1][1]*c5-g[1][2]*c4+g[1][3]*c3)
+					+(g[0][0]*c5-g[0][2]*c2+g[0][3]*c1)
+					+(g[2][0]*s3-g[2][1]*s1+g[2][2]*s0)
+					+(g[3][0]*s4-g[3][1]*s2+g[3][3]*s0);
+	return trace_adj/det;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Lower bound of GDOP^2 of all quadrigas that contain the SVs 'i1', 'i2'
+//and, if i3>=0, 'i3'
+//Column j of H^-1 is orthogonal to the other three rows of H and has unit
+// projection on row j. Its length is therefore at least 1/(distance of row j
+// from the span of the other known rows); for a row not yet picked it is at
+// least 1/|[u,1]|=1/sqrt(2). The distances follow from Gram determinants.
+///////////////////////////////////////////////////////////////////////////////
+static double quadriga_bound2(const double *gvis,int n,int i1,int i2,int i3)
+{
+	double g11=gvis[n*i1+i1];
+	double g22=gvis[n*i2+i2];
+	double g12=gvis[n*i1+i2];
+	if(i3<0){
+		double d2=g11*g22-g12*g12;
+		if(d2<=0) return LARGE;
+		return (g11+g22)/d2+1.;
+	}
+	double g33=gvis[n*i3+i3];
+	double g13=gvis[n*i1+i3];
+	double g23=gvis[n*i2+i3];
+	double m1=g22*g33-g23*g23;
+	double m2=g11*g33-g13*g13;
+	double m3=g11*g22-g12*g12;
+	double d3=g11*m1-g12*(g12*g33-g23*g13)+g13*(g12*g23-g22*g13);
+	if(d3<=0) return LARGE;
+	return (m1+m2+m3)/d3+0.5;
+}
+#ifdef QUADRIGA_BENCH
+#include <chrono>
+///////////////////////////////////////////////////////////////////////////////
+//Benchmark of the quadriga selection against the exhaustive search
+//Built by 'make bench-quadriga'; every GPS update runs both selectors on the
+// same visible SVs and the summary is written when the program exits
+///////////////////////////////////////////////////////////////////////////////
+struct Quadriga_bench
+{
+	long calls;
+	long mismatches;
+	double time_fast;		//sec
+	double time_exhaustive;	//sec
+	std::chrono::steady_clock::time_point start;
+	Quadriga_bench():calls(0),mismatches(0),time_fast(0),time_exhaustive(0){}
+	double lap(){
+		std::chrono::steady_clock::time_point now=std::chrono::steady_clock::now();
+		double dt=std::chrono::duration<double>(now-start).count();
+		start=now;
+		return dt;
+	}
+	~Quadriga_bench(){
+		cout<<"\n *** Quadriga benchmark: "<<calls<<" selections, "<<mismatches<<" mismatches ***\n";
+		if(calls)
+			cout<<" *** exhaustive "<<time_exhaustive/calls*1e6<<" us, fast "<<time_fast/calls*1e6
+				<<" us per selection, speed-up "<<time_exhaustive/time_fast<<" ***\n";
+	}
+} quadriga_bench;
+///////////////////////////////////////////////////////////////////////////////
+//Exhaustive quadriga selection: GDOP of every binomial combination of the
+// visible SVs by inversion of H*H^T (reference for the benchmark)
+///////////////////////////////////////////////////////////////////////////////
+static void quadriga_exhaustive(const double *ssii_vis,int visible_count,Matrix SBII,int *quad,double &gdop)
+{
+	int m(0);
+	gdop=LARGE;
+	int nm3=visible_count-3;
+	int nm2=visible_count-2;
+	int nm1=visible_count-1;
+	for(int i1=0;i1<nm3;i1++){
+		for(int i2=i1+1;i2<nm2;i2++){
+			for(int i3=i2+1;i3<nm1;i3++){
+				for(int i4=i3+1;i4<visible_count;i4++){
+					Matrix SSII1(3,1);
+					Matrix SSII2(3,1);
+					Matrix SSII3(3,1);
+					Matrix SSII4(3,1);
+					for(m=0;m<3;m++){
+						SSII1[m]=*(ssii_vis+4*i1+m);
+						SSII2[m]=*(ssii_vis+4*i2+m);
+						SSII3[m]=*(ssii_vis+4*i3+m);
+						SSII4[m]=*(ssii_vis+4*i4+m);
+					}
+					Matrix UNI1=(SBII-SSII1).univec3();
+					Matrix UNI2=(SBII-SSII2).univec3();
+					Matrix UNI3=(SBII-SSII3).univec3();
+					Matrix UNI4=(SBII-SSII4).univec3();
+					Matrix HGPS(4,4);HGPS.ones();					
+					for(m=0;m<3;m++){
+						HGPS.assign_loc(0,m,UNI1[m]);
+						HGPS.assign_loc(1,m,UNI2[m]);
+						HGPS.assign_loc(2,m,UNI3[m]);
+						HGPS.assign_loc(3,m,UNI4[m]);
+					}
+					Matrix COV(4,4);
+					COV=(HGPS*HGPS.trans()).inverse();
+					double gdop_local=sqrt(COV.get_loc(0,0)+COV.get_loc(1,1)+COV.get_loc(2,2)+COV.get_loc(3,3));
+					if(gdop_local<gdop){
+						gdop=gdop_local;
+						quad[0]=i1;
+						quad[1]=i2;
+						quad[2]=i3;
+						quad[3]=i4;
+					}
+				}
+			}
+		}
+	}
+}
+#endif
+///////////////////////////////////////////////////////////////////////////////
 //Selection of the best four SVs (quadriga)
 //Member function of class 'Hyper'
 //Assumptions: (1) SVs on circular orbits at 55 deg inclination and  separated 
@@ -603,17 +854,19 @@ void Hyper::gps(double int_step)
 //	del_rearth = increase added to Earth's radius for GPS signal LOS calculations (data) - m
 //	time = simulation time - sec
 //	SBII = inertial coordinates of hypersonic vehicle - m
+//	*quad_slot = slot# of the four SVs of the previous quadriga (warm start)
 //
 // parameter output:
 //	*ssii_quad = inertial coordinates + slot# of each quadriga SV, stored sequentially - m
 //	*vsii_quad = inertial velocities of each SV of the quadriga , stored sequentially - m/s
 //	gdop = geometric dillution of precision of quadriga - m
 //	mgps = set here to 1 (GPS initialization), if less than  4 SVs are visible 
+//	*quad_slot = slot# of the four SVs of the selected quadriga
 //	
 //040105 Created by Peter H Zipfel
 ///////////////////////////////////////////////////////////////////////////////
 
-void Hyper::gps_quadriga(double *ssii_quad,double *vsii_quad,double &gdop,int &mgps 
+void Hyper::gps_quadriga(double *ssii_quad,double *vsii_quad,double &gdop,int &mgps,int *quad_slot 
 						,const double *sv_init_data,const double &rsi,const double &wsi
 						,const double &incl,double almanac_time,double del_rearth
 						,double time,Matrix SBII)
@@ -708,50 +961,63 @@ void Hyper::gps_quadriga(double *ssii_quad,double *vsii_quad,double &gdop,int &m
 				k=k+4;
 			}
 		}
+#ifdef QUADRIGA_BENCH
+		quadriga_bench.lap();
+#endif
+		//unit vectors of user wrt the visible SVs and their Gram matrix
+		// gvis[visible_count*k+l]=u_k^u_l+1, the entries of H*H^T of any quadriga
+		double *uvis=new double[3*visible_count];
+		double *gvis=new double[visible_count*visible_count];
+		for(i=0;i<visible_count;i++){
+			double dx=SBII[0]-*(ssii_vis+4*i);
+			double dy=SBII[1]-*(ssii_vis+4*i+1);
+			double dz=SBII[2]-*(ssii_vis+4*i+2);
+			double dsb=sqrt(dx*dx+dy*dy+dz*dz);
+			*(uvis+3*i)=dx/dsb;
+			*(uvis+3*i+1)=dy/dsb;
+			*(uvis+3*i+2)=dz/dsb;
+		}
+		for(i=0;i<visible_count;i++){
+			for(k=i;k<visible_count;k++){
+				double gik=*(uvis+3*i)**(uvis+3*k)+*(uvis+3*i+1)**(uvis+3*k+1)+*(uvis+3*i+2)**(uvis+3*k+2)+1;
+				*(gvis+visible_count*i+k)=gik;
+				*(gvis+visible_count*k+i)=gik;
+			}
+		}
+		//warm start: GDOP of the previous quadriga if all four SVs are still visible
+		double gdop2=LARGE;
+		int prev[4]={-1,-1,-1,-1};
+		for(i=0;i<visible_count;i++){
+			int slot_vis=(int)*(ssii_vis+4*i+3);
+			for(m=0;m<4;m++)
+				if(quad_slot[m]==slot_vis) prev[m]=i;
+		}
+		if(prev[0]>=0&&prev[1]>=0&&prev[2]>=0&&prev[3]>=0){
+			gdop2=quadriga_gdop2(gvis,visible_count,prev[0],prev[1],prev[2],prev[3]);
+			for(m=0;m<4;m++) quad[m]=prev[m];
+		}
 		//selecting quadriga (four SVs) with smallest GDOP
-		//i1, i2, i3, i4 are the SVs picked by the binomial combination
+		//i1, i2, i3, i4 are the SVs picked by the binomial combination;
+		// branches whose GDOP lower bound exceeds the best GDOP are skipped
+		//ties go to the first quadriga in the order of the binomial combination
 		int nm3=visible_count-3; //nm3=1 
 		int nm2=visible_count-2; //nm2=2
 		int nm1=visible_count-1; //nm1=3
+		const double margin=1+1e-9; //protects the bounds against round-off
 		
 		for(int i1=0;i1<nm3;i1++){
 			for(int i2=i1+1;i2<nm2;i2++){
+				if(quadriga_bound2(gvis,visible_count,i1,i2,-1)>gdop2*margin) continue;
 				for(int i3=i2+1;i3<nm1;i3++){
+					if(quadriga_bound2(gvis,visible_count,i1,i2,i3)>gdop2*margin) continue;
 					for(int i4=i3+1;i4<visible_count;i4++){
 
-						//pullling the quadriga inertial coordinates
-						Matrix SSII1(3,1);
-						Matrix SSII2(3,1);
-						Matrix SSII3(3,1);
-						Matrix SSII4(3,1);
-						for(m=0;m<3;m++){
-							SSII1[m]=*(ssii_vis+4*i1+m);
-							SSII2[m]=*(ssii_vis+4*i2+m);
-							SSII3[m]=*(ssii_vis+4*i3+m);
-							SSII4[m]=*(ssii_vis+4*i4+m);
-						}
-						//calculating user wrt the SV displacement unit vectors
-						Matrix UNI1=(SBII-SSII1).univec3();
-						Matrix UNI2=(SBII-SSII2).univec3();
-						Matrix UNI3=(SBII-SSII3).univec3();
-						Matrix UNI4=(SBII-SSII4).univec3();
-
-						//building the GPS 'H' matrix
-						Matrix HGPS(4,4);HGPS.ones();					
-						for(m=0;m<3;m++){
-							HGPS.assign_loc(0,m,UNI1[m]);
-							HGPS.assign_loc(1,m,UNI2[m]);
-							HGPS.assign_loc(2,m,UNI3[m]);
-							HGPS.assign_loc(3,m,UNI4[m]);
-						}
-						//calculating GDOP 
-						Matrix COV(4,4);
-						COV=(HGPS*HGPS.trans()).inverse();
-						double gdop_local=sqrt(COV.get_loc(0,0)+COV.get_loc(1,1)+COV.get_loc(2,2)+COV.get_loc(3,3));
-
-						//save slot # of quadriga SVs if GDOP has decreased
-						if(gdop_local<gdop){
-							gdop=gdop_local;
+						double gdop2_local=quadriga_gdop2(gvis,visible_count,i1,i2,i3,i4);
+
+						//save quadriga if GDOP has decreased
+						bool earlier=(i1<quad[0])||(i1==quad[0]&&(i2<quad[1]||(i2==quad[1]&&(i3<quad[2]||(i3==quad[2]&&i4<quad[3])))));
+						if(gdop2_local<gdop2||(gdop2_local==gdop2&&earlier)){
+							gdop2=gdop2_local;
 							quad[0]=i1;
 							quad[1]=i2;
 							quad[2]=i3;
@@ -761,6 +1027,21 @@ void Hyper::gps_quadriga(double *ssii_quad,double *vsii_quad,double &gdop,int &m
 				}
 			}
 		}//end of picking quadriga amongst visible SVs
+		if(gdop2<LARGE) gdop=sqrt(gdop2);
+		delete[] uvis;
+		delete[] gvis;
+#ifdef QUADRIGA_BENCH
+		quadriga_bench.time_fast+=quadriga_bench.lap();
+		int quad_ref[4]={0,0,0,0};
+		double gdop_ref(0);
+		quadriga_exhaustive(ssii_vis,visible_count,SBII,quad_ref,gdop_ref);
+		quadriga_bench.time_exhaustive+=quadriga_bench.lap();
+		quadriga_bench.calls++;
+		if(quad[0]!=quad_ref[0]||quad[1]!=quad_ref[1]||quad[2]!=quad_ref[2]||quad[3]!=quad_ref[3]){
+			quadriga_bench.mismatches++;
+			cout<<" *** Quadriga mismatch at time "<<time<<": GDOP "<<gdop<<" vs exhaustive "<<gdop_ref<<" ***\n";
+		}
+#endif
 
 		//extracting "best" quadriga from visible SVs
 		//and storing inertial coordinates of the four SVs and their slot# in ssii_quad[16]
@@ -777,6 +1058,7 @@ void Hyper::gps_quadriga(double *ssii_quad,double *vsii_quad,double &gdop,int &m
 			slot[i]=*(ssii_quad+4*i+3);
 			//casting into an int
 			islot[i]=(int)slot[i];
+			quad_slot[i]=islot[i];
 		}
 		//storing inertial velocities of the four SVs in vsii_quad[12]
 		double sin_incl=sin(incl);
@@ -791,6 +1073,57 @@ void Hyper::gps_quadriga(double *ssii_quad,double *vsii_quad,double &gdop,int &m
 	}//end of picking quadriga from 4 or more visible SVs
 }
 ///////////////////////////////////////////////////////////////////////////////
+//GNSS SV propagation and channel selection from the GNSS_DECK almanac
+//Member function of class 'Hyper'
+//
+//All almanac SVs are propagated in one pass, the Earth-occlusion test keeps the
+// visible ones, and of those the best 'gnss_nsel' by GDOP (all in view if fewer
+// are visible) are assigned to the receiver channels
+//
+// parameter input:
+//	gnss_nsel = number of receiver channels (4...NCHANNEL)
+//	almanac_time = time since almanac epoch at start of simulation (data) - sec
+//	del_rearth = increase added to Earth's radius for GPS signal LOS calculations (data) - m
+//	time = simulation time - sec
+//	SBII = inertial coordinates of hypersonic vehicle - m
+//
+// parameter output:
+//	*ssii_chan = inertial coordinates + SV ID# of each channel SV, stored sequentially - m
+//	*vsii_chan = inertial velocities of each channel SV, stored sequentially - m/s
+//	gdop = geometric dillution of precision of the channel SVs - m
+//	mgps = set here to 1 (GPS initialization), if less than 4 SVs are visible 
+//	nchan = number of channels filled
+//	gnss_nvis = number of visible SVs
+///////////////////////////////////////////////////////////////////////////////
+
+void Hyper::gps_constellation(double *ssii_chan,double *vsii_chan,double &gdop,int &mgps,int &nchan
+							,int &gnss_nvis,int gnss_nsel,double almanac_time,double del_rearth
+							,double time,Matrix SBII)
+{
+	int sel[NCHANNEL]; //SV indices of channels
+	gdop=LARGE;
+
+	//propagating all SVs and testing for Earth occlusion
+	constellation.propagate(almanac_time+time);
+	gnss_nvis=constellation.visibility(SBII,REARTH+del_rearth);
+
+	//re-acquiring GPS if not enough SVs visible (less than 4)
+	if(gnss_nvis<4){
+		mgps=1;
+		cout<<" *** Warning: only "<<gnss_nvis<<" SV are visible, mgps set = 1 ***\n";
+		return;
+	}
+	//best 'gnss_nsel' SVs, or all in view
+	gdop=constellation.select(gnss_nsel,sel);
+	nchan=gnss_nsel<gnss_nvis?gnss_nsel:gnss_nvis;
+
+	//storing inertial coordinates and ID# in ssii_chan[4*nchan], velocities in vsii_chan[3*nchan]
+	for(int i=0;i<nchan;i++){
+		constellation.get_state(sel[i],ssii_chan+4*i,vsii_chan+3*i);
+		*(ssii_chan+4*i+3)=constellation.get_prn(sel[i]);
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
 //Initialization of the Space Vehicles (GPS satellites)
 //Member function of class 'Hyper'
 //Assumptions: all SVs on circular orbits at 55 deg inclination and  separated 
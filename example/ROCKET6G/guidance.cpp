@@ -43,6 +43,7 @@ void Hyper::def_guidance()
 	hyper[444].init("num_stages","int",0,"Number of stages in boost phase - s","guidance","data","");
 	hyper[445].init("delay_ignition",0,"Delay of motor ignition after staging - s","guidance","data","");
 	hyper[446].init("amin",0,"Minimum longitudinal acceleration - m/s^2","guidance","data","");
+	hyper[447].init("ltg_kepler","int",0,"Kepler projection =0:cad_kepler; =1:batch engine 'Kepler' - ND","guidance","data","");
 	hyper[450].init("char_time1",0,"Characteristic time 'tau' of stage 1 - s","guidance","data","");
 	hyper[451].init("char_time2",0,"Characteristic time 'tau' of stage 2 - s","guidance","data","");
 	hyper[452].init("char_time3",0,"Characteristic time 'tau' of stage 3 - s","guidance","data","");
@@ -775,8 +776,22 @@ void Hyper::guidance_ltg_pdct(Matrix &SPII,Matrix &VPII,Matrix &RGRAV,Matrix &RB
 	Matrix SBIIC1=SBIIC-RTHRUST*0.1-VTHRUST*(tgo/30); //Jackson, p.23
 	Matrix VBIIC1=VBIIC+RTHRUST*(1.2/tgo)-VTHRUST*0.1;//Jackson, p.23
 
-	//calling Kepler utility to project to end state (two options available)
-	int flag=cad_kepler(SBIIC2,VBIIC2,SBIIC1,VBIIC1,tgo);
+	//calling Kepler utility to project to end state (three options available)
+	int flag(0);
+	if(hyper[447].integer()==1){
+		//universal-variable batch engine, warm-started by the previous LTG cycle
+		double sbiic1[3]={SBIIC1[0],SBIIC1[1],SBIIC1[2]};
+		double vbiic1[3]={VBIIC1[0],VBIIC1[1],VBIIC1[2]};
+		double sbiic2[3],vbiic2[3];
+		if(kepler.get_size()!=1) kepler.resize(1);
+		kepler.set_state(0,sbiic1,vbiic1,tgo);
+		flag=kepler.propagate();
+		kepler.get_state(0,sbiic2,vbiic2);
+		SBIIC2.build_vec3(sbiic2[0],sbiic2[1],sbiic2[2]);
+		VBIIC2.build_vec3(vbiic2[0],vbiic2[1],vbiic2[2]);
+	}
+	else
+		flag=cad_kepler(SBIIC2,VBIIC2,SBIIC1,VBIIC1,tgo);
 //	int flag=cad_kepler1(SBIIC2,VBIIC2,SBIIC1,VBIIC1,tgo);
 	if(flag){
 		cerr<<" *** Warning: bad Kepler projection in 'guidance_ltg_pdct()' *** \n";} 
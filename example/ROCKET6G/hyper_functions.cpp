@@ -380,12 +380,14 @@ void Hyper::vehicle_data(fstream &input,int nmonte)
 				}				
 			}
 			//reading aero data from aero-deck file
+			//(a vehicle object reset for a Monte Carlo run keeps its tables)
 			if(!strcmp(read,"AERO_DECK")){
 				//reading aerodeck file name
 				input>>file_name;
 				input.getline(line_clear,CHARL,'\n');
 
-				read_tables(file_name,aerotable);
+				if(!aerotable.get_capacity())
+					read_tables(file_name,aerotable);
 			}
 			//reading prop data from prop-deck file
 			if(!strcmp(read,"PROP_DECK")){
@@ -393,7 +395,8 @@ void Hyper::vehicle_data(fstream &input,int nmonte)
 				input>>file_name;
 				input.getline(line_clear,CHARL,'\n');
 
-				read_tables(file_name,proptable);
+				if(!proptable.get_capacity())
+					read_tables(file_name,proptable);
 			}
 			//reading weather data from weather-deck file
 			if(!strcmp(read,"WEATHER_DECK")){
@@ -401,7 +404,26 @@ void Hyper::vehicle_data(fstream &input,int nmonte)
 				input>>file_name;
 				input.getline(line_clear,CHARL,'\n');
 
-				read_tables(file_name,weathertable);
+				if(!weathertable.get_capacity())
+					read_tables(file_name,weathertable);
+			}
+			//reading GNSS SVs from almanac file
+			if(!strcmp(read,"GNSS_DECK")){
+				//reading almanac file name
+				input>>file_name;
+				input.getline(line_clear,CHARL,'\n');
+
+				if(!constellation.get_nsv())
+					constellation.read_almanac(file_name);
+			}
+			//reading star catalog file
+			if(!strcmp(read,"STAR_DECK")){
+				//reading star catalog file name
+				input>>file_name;
+				input.getline(line_clear,CHARL,'\n');
+
+				if(!starcatalog.get_nstar())
+					starcatalog.read_catalog(file_name);
 			}
 
 			//loading values for random variables and building 'markov_list'
@@ -415,7 +437,7 @@ void Hyper::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=(second-first)/2.;
 				else
-					value=uniform(first,second);
+					value=doe_uniform(first,second);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NROUND6;kk++)
@@ -447,7 +469,7 @@ void Hyper::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=gauss(first,second);
+					value=doe_gauss(first,second);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NROUND6;kk++)
@@ -478,7 +500,7 @@ void Hyper::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=rayleigh(first);
+					value=doe_rayleigh(first);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NROUND6;kk++)
@@ -509,7 +531,7 @@ void Hyper::vehicle_data(fstream &input,int nmonte)
 				if(!nmonte)
 					value=first;
 				else
-					value=exponential(first);
+					value=doe_exponential(first);
 
 				//loading radom value into module-variable
 				for(kk=0;kk<NROUND6;kk++)
@@ -703,6 +725,14 @@ void Hyper::scrn_index_arrays()
 			l++;
 		}
 	}
+
+	//compiling the output plan
+	int column(0);
+	nscrn_plan=0;
+	for(i=0;i<round6_scrn_count;i++)
+		scrn_plan[nscrn_plan++]=round6[round6_scrn_ind[i]].output(column);
+	for(i=0;i<hyper_scrn_count;i++)
+		scrn_plan[nscrn_plan++]=hyper[hyper_scrn_ind[i]].output(column);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Writing data to screen
@@ -718,85 +748,36 @@ void Hyper::scrn_index_arrays()
 void Hyper::scrn_data()
 {
 
-	int index(0);
-	char *integer=NULL;
-	char *vector=NULL;
-	Matrix VEC(3,1);
 	int k=0;
 	int i(0);
 	
 	cout<<hyper6_name<<'\n';
 	cout.setf(ios::left);
 
-	//writing to screen the variables from the 'Round6' class
-	for(i=0;i<round6_scrn_count;i++)
+	//writing to screen the variables of the output plan
+	for(i=0;i<nscrn_plan;i++)
 	{
-		index=round6_scrn_ind[i];
-		//checking for integers
-		integer=round6[index].get_type();
-		vector=round6[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=scrn_plan[i];
+		if(out.kind==1)
 		{
 			cout.width(15);
-			cout<<round6[index].integer();			
+			cout<<*out.integer;
 			k++; if(k>7){k=0;cout<<'\n';}
 		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
+		else if(out.kind==2)
 		{
-			VEC=round6[index].vec();
-
-			cout.width(15);
-			cout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-		}
-		else
-		{
-			//real variables
-			cout.width(15);
-			cout<<round6[index].real();
-			k++; if(k>7){k=0;cout<<'\n';}
-		}
-	}
-	//writing to screen the variables from the 'Hyper' class
-	for(i=0;i<hyper_scrn_count;i++)
-	{
-		index=hyper_scrn_ind[i];
-		//checking for integers
-		integer=hyper[index].get_type();
-		vector=hyper[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			cout.width(15);
-			cout<<hyper[index].integer();			
-			k++; if(k>7){k=0;cout<<'\n';}
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=hyper[index].vec();
-			cout.width(15);
-			cout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;cout<<'\n';}
-			cout.width(15);
-			cout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;cout<<'\n';}
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
+			{
+				cout.width(15);
+				cout<<vec[m];
+				k++; if(k>7){k=0;cout<<'\n';}
+			}
 		}
 		else
 		{
-			//real variables
 			cout.width(15);
-			cout<<hyper[index].real();
+			cout<<*out.real;
 			k++; if(k>7){k=0;cout<<'\n';}
 		}
 	}
@@ -816,85 +797,36 @@ void Hyper::scrn_data()
 void Hyper::tabout_data(ofstream &ftabout)
 {
 
-	int index(0);
-	char *integer=NULL;
-	char *vector=NULL;
-	Matrix VEC(3,1);
 	int k(0);
 	int i(0);
 	
 	ftabout<<hyper6_name<<'\n';
 	ftabout.setf(ios::left);
 
-	//writing to 'tabout.asc' the variables from the 'Round6' class
-	for(i=0;i<round6_scrn_count;i++)
+	//writing to 'tabout.asc' the variables of the output plan
+	for(i=0;i<nscrn_plan;i++)
 	{
-		index=round6_scrn_ind[i];
-		//checking for integers
-		integer=round6[index].get_type();
-		vector=round6[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			ftabout.width(15);
-			ftabout<<round6[index].integer();			
-			k++; if(k>7){k=0;ftabout<<'\n';}
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=round6[index].vec();
-
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-		}
-		else
+		Output &out=scrn_plan[i];
+		if(out.kind==1)
 		{
-			//real variables
 			ftabout.width(15);
-			ftabout<<round6[index].real(); 
+			ftabout<<*out.integer;
 			k++; if(k>7){k=0;ftabout<<'\n';}
 		}
-	}
-	//writing to 'tabout.asc' the variables from the 'Hyper' class
-	for(i=0;i<hyper_scrn_count;i++)
-	{
-		index=hyper_scrn_ind[i];
-		//checking for integers
-		integer=hyper[index].get_type();
-		vector=hyper[index].get_name();
-		if(!strcmp(integer,"int"))
+		else if(out.kind==2)
 		{
-			ftabout.width(15);
-			ftabout<<hyper[index].integer();			
-			k++; if(k>7){k=0;ftabout<<'\n';}
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=hyper[index].vec();
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(0,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(1,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
-			ftabout.width(15);
-			ftabout<<VEC.get_loc(2,0);
-			k++; if(k>7){k=0;ftabout<<'\n';}
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
+			{
+				ftabout.width(15);
+				ftabout<<vec[m];
+				k++; if(k>7){k=0;ftabout<<'\n';}
+			}
 		}
 		else
 		{
-			//real variables
 			ftabout.width(15);
-			ftabout<<hyper[index].real();
+			ftabout<<*out.real;
 			k++; if(k>7){k=0;ftabout<<'\n';}
 		}
 	}
@@ -997,6 +929,15 @@ void Hyper::plot_index_arrays()
 			l++;
 		}
 	}
+
+	//compiling the output plan
+	int column(0);
+	nplot_plan=0;
+	for(i=0;i<round6_plot_count;i++)
+		plot_plan[nplot_plan++]=round6[round6_plot_ind[i]].output(column);
+	for(i=0;i<hyper_plot_count;i++)
+		plot_plan[nplot_plan++]=hyper[hyper_plot_ind[i]].output(column);
+	dense_rates(plot_plan,round6_plot_ind,round6_plot_count);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Writing data to 'ploti.asc', i=1,2,3...
@@ -1005,118 +946,79 @@ void Hyper::plot_index_arrays()
 //five accross, unlimited down
 //data field 16 spaces, total width 80 spaces
 //
+//Parameter input:
+//	frac = fraction of the last integration step 'step' at which the data are
+//		sampled; frac=1 writes the current values
+//
 //010116 Created by Peter Zipfel
 //030404 Adapted to HYPER6 simulation, PZi
 ///////////////////////////////////////////////////////////////////////////////
-void Hyper::plot_data(ofstream &fplot,bool merge)
+void Hyper::plot_data(ofstream &fplot,bool merge,double frac,double step)
 {
 
-	int index(0);
-	char *integer=NULL;
-	char *vector=NULL;
-	Matrix VEC(3,1);
 	int k(0);
 	int i(0);
 	
 	fplot.setf(ios::left);
 
-	//writing to 'ploti.asc' the variables from the 'Round6' class
-	for(i=0;i<round6_plot_count;i++)
+	//writing to 'ploti.asc' the variables of the output plan
+	for(i=0;i<nplot_plan;i++)
 	{
-		index=round6_plot_ind[i];
-		//checking for integers
-		integer=round6[index].get_type();
-		vector=round6[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=plot_plan[i];
+		if(out.kind==1)
 		{
 			//casting integer to real variable
 			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<(double) round6[index].integer();			
-			k++;
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=round6[index].vec();
-
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++; 
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
+			if(frac<1) fplot<<out.sample(0,frac,step);
+			else fplot<<(double) *out.integer;
 			k++;
 		}
-		else
+		else if(out.kind==2)
 		{
-			//real variables
-			if(merge&&(index==0))
-				//for merging files, time at last entry must be '-1'
-			{
-				fplot.width(16);
-				fplot<<"-1.0";
-				k++;
-			}
-			else
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
 			{
 				if(k>4){k=0;fplot<<'\n';}
 				fplot.width(16);
-				fplot<<round6[index].real(); 
+				if(frac<1) fplot<<out.sample(m,frac,step);
+				else fplot<<vec[m];
 				k++;
 			}
 		}
-	}
-	//writing to 'ploti.asc' the variables from the 'Hyper' class
-	for(i=0;i<hyper_plot_count;i++)
-	{
-		index=hyper_plot_ind[i];
-		//checking for integers
-		integer=hyper[index].get_type();
-		vector=hyper[index].get_name();
-		if(!strcmp(integer,"int"))
+		else if(merge&&!out.column)
+		//for merging files, time at last entry must be '-1'
 		{
-			//casting integer to real variable
-			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<(double) hyper[index].integer();			
-			k++;
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=hyper[index].vec();
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
+			fplot<<"-1.0";
 			k++;
 		}
 		else
 		{
-			//real variables
 			if(k>4){k=0;fplot<<'\n';}
 			fplot.width(16);
-			fplot<<hyper[index].real();
+			if(frac<1) fplot<<out.sample(0,frac,step);
+			else fplot<<*out.real;
 			k++;
 		}
 	}
 	fplot<<"\n";
 }
 ///////////////////////////////////////////////////////////////////////////////
+//Recording the plot and 'combus' output plans at the end of the integration
+// step for dense output by 'plot_data()' and 'traj_data()'
+///////////////////////////////////////////////////////////////////////////////
+
+void Hyper::record_output()
+{
+	int i(0);
+
+	for(i=0;i<nplot_plan;i++)
+		plot_plan[i].record();
+	for(i=0;i<ncom_plan;i++)
+		com_plan[i].record();
+}
+///////////////////////////////////////////////////////////////////////////////
 //Watching for and executing events
 // 
 //Max number of events set by global constant NEVENT
@@ -1406,6 +1308,23 @@ void Hyper::com_index_arrays()
 			l++;
 		}
 	}
+
+	//loading the definitions into 'com_hyper6' once and compiling its output plan
+	int column(0);
+	ncom_plan=0;
+	for(i=0;i<round6_com_count;i++)
+	{
+		com_hyper6[ncom_plan]=round6[round6_com_ind[i]];
+		com_plan[ncom_plan]=com_hyper6[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	for(i=0;i<hyper_com_count;i++)
+	{
+		com_hyper6[ncom_plan]=hyper[hyper_com_ind[i]];
+		com_plan[ncom_plan]=com_hyper6[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	dense_rates(com_plan,round6_com_ind,round6_com_count);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Initializing loading 'packet' with 'HYPER6' data
@@ -1435,17 +1354,18 @@ Packet Hyper::loading_packet_init(int num_hyper)
 	for(i=0;i<round6_com_count;i++)
 	{
 		index=round6_com_ind[i];
-		com_hyper6[i]=round6[index]; 
+		com_hyper6[i].restore(round6[index]); 
 	}
 	for(int j=0;j<hyper_com_count;j++)
 	{
 		index=hyper_com_ind[j];
-		com_hyper6[i+j]=hyper[index];
+		com_hyper6[i+j].restore(hyper[index]);
 	}
 	//refreshing the packet
 	packet.set_id(id);
 	packet.set_status(1);
 	packet.set_data(com_hyper6);
+	packet.set_plan(com_plan);
 	packet.set_ndata(ncom_hyper6);
 
 	return packet;
@@ -1467,12 +1387,12 @@ Packet Hyper::loading_packet(int num_hyper)
 	for(i=0;i<round6_com_count;i++)
 	{
 		index=round6_com_ind[i];
-		com_hyper6[i]=round6[index];
+		com_hyper6[i].restore(round6[index]);
 	}
 	for(int j=0;j<hyper_com_count;j++)
 	{
 		index=hyper_com_ind[j];
-		com_hyper6[i+j]=hyper[index];
+		com_hyper6[i+j].restore(hyper[index]);
 	}
 	//refreshing the packet
 //	packet.set_id(id);
@@ -1540,95 +1460,39 @@ void Hyper::markov_noise(double time,double int_step,int nmonte)
 ///////////////////////////////////////////////////////////////////////////////
 void Hyper::stat_data(ofstream &fstat,int nmc,int vehicle_slot)
 {
-	int index(0);
-	char *integer=NULL;
-	char *vector=NULL;
-	Matrix VEC(3,1);
 	int k(0);
 	int i(0);
 	
 	fstat.setf(ios::left);
 
-	//writing to 'stati.asc' the variables from the 'Round6' class
-	for(i=0;i<round6_plot_count;i++)
+	//writing to 'stati.asc' the variables of the output plan
+	for(i=0;i<nplot_plan;i++)
 	{
-		index=round6_plot_ind[i];
-		//checking for integers
-		integer=round6[index].get_type();
-		vector=round6[index].get_name();
-		if(!strcmp(integer,"int"))
+		Output &out=plot_plan[i];
+		if(out.kind==1)
 		{
 			//casting integer to real variable
 			if(k>4){k=0;fstat<<'\n';}
 			fstat.width(16);
-			fstat<<(double) round6[index].integer();			
-			k++;
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=round6[index].vec();
-
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(0,0);
-			k++; 
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(2,0);
+			fstat<<(double) *out.integer;
 			k++;
 		}
-		else
+		else if(out.kind==2)
 		{
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<round6[index].real(); 
-			k++;
-		}
-	}
-	//writing to 'stati.asc' the variables from the 'Hyper' class
-	for(i=0;i<hyper_plot_count;i++)
-	{
-		index=hyper_plot_ind[i];
-		//checking for integers
-		integer=hyper[index].get_type();
-		vector=hyper[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<(double) hyper[index].integer();			
-			k++;
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=hyper[index].vec();
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(0,0);
-			k++;
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(2,0);
-			k++;
+			double *vec=out.vec->get_pbody();
+			for(int m=0;m<3;m++)
+			{
+				if(k>4){k=0;fstat<<'\n';}
+				fstat.width(16);
+				fstat<<vec[m];
+				k++;
+			}
 		}
 		else
 		{
-			//real variables
 			if(k>4){k=0;fstat<<'\n';}
 			fstat.width(16);
-			fstat<<hyper[index].real();
+			fstat<<*out.real;
 			k++;
 		}
 	}
@@ -1711,7 +1575,7 @@ void Hyper::read_tables(char *file_name,Datadeck &datatable)
 		//extracting table dimension
 		//at this point 'temp' is holding xDIM
 		int dim_check(0);
-		char dim_buff[2];
+		char dim_buff[2]={0};
 		int table_dim(0);
 		strncpy(dim_buff,temp,1);
 		//converting character to integer
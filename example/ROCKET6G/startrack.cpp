@@ -43,6 +43,9 @@ void Hyper::def_startrack()
 	hyper[819].init("el1_noise",0,"Star elevation error 1 noise - rad MARKOV","startrack","data","");
 	hyper[820].init("el2_noise",0,"Star elevation error 2 noise - rad MARKOV","startrack","data","");
 	hyper[821].init("el3_noise",0,"Star elevation error 3 noise - rad MARKOV","startrack","data","");
+	hyper[822].init("star_for",0,"Field of regard half-angle from zenith, =0: horizon only - deg","startrack","data","");
+	hyper[823].init("star_nfor","int",0,"Number of stars in the field of regard - ND","startrack","diag","");
+	hyper[824].init("star_volume",0,"Volume of parallelepiped formed by the triad (max value=1) - ND","startrack","diag","");
 	hyper[830].init("URIC",0,0,0,"Tilt corrections for INS","startrack","out","plot");
 }
 ///////////////////////////////////////////////////////////////////////////////  
@@ -54,8 +57,8 @@ void Hyper::def_startrack()
 //		= 2 starting star track upates
 //		= 3 sending tilt corrections to INS ('ins' module resets mstar=2) 
 //
-//* Loads 25 bright stars from the star catalog
-//* Separates out the stars that are visible from the vehicle
+//* Loads the star catalog: STAR_DECK file, else 25 bright stars
+//* Separates out the stars in the field of regard (indexed cone query)
 //* Picks those three stars (called triad) that provide the best measurements
 //* Simulates the tracker errors by corrupting the true LOS
 //* Calculates the INS tilt updates and sends them to the INS    
@@ -66,9 +69,8 @@ void Hyper::def_startrack()
 void Hyper::startrack()
 {
 	//local variables
-	static double star_data[75];
-	static string star_names[25];
 	double usii_triad[12]; //star triad inertial coord and star slot#
+	int triad[3]={0,0,0}; //catalog index of triad stars
 	double dtime_star(0);
 	double time_star(0);
 	Matrix TRIAD_TRUE(3,3);
@@ -101,6 +103,7 @@ void Hyper::startrack()
 	double el1_noise=hyper[819].real();
 	double el2_noise=hyper[820].real();	
 	double el3_noise=hyper[821].real();
+	double star_for=hyper[822].real();
 	//assembling bias and noise measurement vectors 
 	AZ_BIAS[0]=az1_bias;
 	AZ_BIAS[1]=az2_bias;
@@ -119,6 +122,9 @@ void Hyper::startrack()
 	int star_acq=hyper[808].integer();
 	double star_slotsum=hyper[809].real();
 	Matrix URIC=hyper[830].vec();
+	//getting diagnostic values
+	int star_nfor=hyper[823].integer();
+	star_volume=hyper[824].real();
 	//input from other modules
 	double time=round6[0].real();
 	Matrix TBI=round6[121].mat();
@@ -129,8 +135,9 @@ void Hyper::startrack()
 	//star tracker initialization
 	if(mstar==1)
 	{
-		//Loading star catalog
-		star_init(star_data,star_names);
+		//Loading 25 bright stars, unless a catalog was read from STAR_DECK
+		if(!starcatalog.get_nstar())
+			star_init();
 		
 		//setting inital acquisition flag
 		star_acq=1;
@@ -169,8 +176,15 @@ void Hyper::startrack()
 		starfix_epoch=time;
 
 		//getting star triad
-		star_triad(usii_triad,star_volume, star_data,star_el_min,SBII);
-
+		star_nfor=star_triad(usii_triad,triad,star_volume,star_el_min,star_for,SBII);
+		//no fix: waiting for the next update, so that 'ins' does not apply the previous 'URIC' again
+		if(star_nfor<3){
+			cerr<<" *** Warning: only "<<star_nfor<<" stars in field of regard, no star fix at time = "<<time<<" sec ***\n";
+			mstar=2;
+		}
+	}
+	if(mstar==3)
+	{
 		//shooting stars of the triad (measurement of unit vectors)
 		for(int i=0;i<3;i++){
 			//unpacking i-th star's unit vector
@@ -215,11 +229,8 @@ void Hyper::startrack()
 		// but only if they have changed (sum of slot# has changed)
 		if(star_slotsum!=slotm){
 			star_slotsum=slotm;
-			int slot1=(int)slot[0];
-			int slot2=(int)slot[1];
-			int slot3=(int)slot[2];
-			cout<<" *** Star triad: "<<*(star_names+slot1-1)<<"  "
-				<<*(star_names+slot2-1)<<"  "<<*(star_names+slot3-1)<<" ***\n";
+			cout<<" *** Star triad: "<<starcatalog.get_name(triad[0])<<"  "
+				<<starcatalog.get_name(triad[1])<<"  "<<starcatalog.get_name(triad[2])<<" ***\n";
 		}
 		//calculating the tilt corrections for the INS
 		Matrix RDIFF(3,3);
@@ -238,150 +249,71 @@ void Hyper::startrack()
 	hyper[807].gets(starfix_epoch);
 	hyper[808].gets(star_acq);
 	hyper[809].gets(star_slotsum);	
+	//diagnostics
+	hyper[823].gets(star_nfor);
+	hyper[824].gets(star_volume);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 //Selection of the best three stars (triad)
 //Member function of class 'Hyper'
 //
+//The field of regard is the cone about the local vertical bounded by the
+// minimum elevation and, if set, by 'star_for'; its stars are taken from the
+// declination-zone index of 'starcatalog', and the triad of maximum volume
+// is found by the pruned search of 'Starcatalog::triad()'
+//
 // Parameter input:
-//	*star_data=25x3 array of 25 stars and their three unit vector components in the J2000 coord system
-//					(the two-dimensional array is stored in sequential rows in a one-dimensional array)
 //	star_el_min = minimum star elev angle from horizon - deg
+//	star_for = field of regard half-angle from zenith, =0: horizon only - deg
 //	SBII = inertial coordinates of hypersonic vehicle - m
 //
 // Parameter output:
 //	*usii_triad(3x4) = unit vector inertial coord & slot# of each star of the triad , stored sequentially - ND
+//	*triad(3) = catalog index of each star of the triad - ND
 //	star_volume = volume of parallelepiped formed by the triad (max value=1) - ND
+//
+// Return output:
+//	number of stars in the field of regard; no triad if less than 3
 //	
 //040211 Created by Peter H Zipfel
 ///////////////////////////////////////////////////////////////////////////////
 
-void Hyper::star_triad(double *usii_triad,double star_volume, double *star_data,double star_el_min,Matrix SBII)
+int Hyper::star_triad(double *usii_triad,int *triad,double &star_volume,double star_el_min,double star_for,Matrix SBII)
 {
-	double star_usii[25][3];
-	double slot[3]={0,0,0}; //star slot#  of triad 
-	int islot[4]={0,0,0}; //star slot#  of triad stored as integer 
-	int triad[3]={0,0,0}; //location of triad stars in 'usii_vis[visible_count]
-	int visible_count(0);
-	int i(0);
-
-	//unpacking the one-dimensional array of stars into star_usii[25][3]
-	for (i=0;i<25;i++){
-		for(int k=0;k<3;k++){
-			star_usii[i][k]=*(star_data+3*i+k);
-		}
-	}	
-	//determining visible stars slot #
-	Matrix UBII(3,1);
-	Matrix USII(3,1);
-	bool visible=false;
-	int vis_star_slot[25];//=0 if not visible, otherwise contains catalog slot#
-
 	//vehicle's inertial unit vector
+	Matrix UBII(3,1);
 	UBII=SBII.univec3();
+	double center[3]={UBII[0],UBII[1],UBII[2]};
 
-	for(i=0;i<25;i++){
-		visible=false;
-		USII[0]=star_usii[i][0];
-		USII[1]=star_usii[i][1];
-		USII[2]=star_usii[i][2];
-
-		//star elevation angle from local horizontal (note: star is at infinity)
-		double elstar=asin(USII^UBII);
-		vis_star_slot[i]=0;
-		if(elstar>star_el_min*RAD){
-			visible_count++;
-			//load slot# (starting at 1,2,3...) into 'int vis_star_slot[25]
-			// a zero means it is not visible
-			vis_star_slot[i]=i+1;
-		}
+	//star elevation above 'star_el_min' (note: star is at infinity) and within 'star_for' of zenith
+	double cos_radius=sin(star_el_min*RAD);
+	if(star_for>0&&cos(star_for*RAD)>cos_radius)
+		cos_radius=cos(star_for*RAD);
+	int nfor=starcatalog.field_of_regard(center,cos_radius);
+	if(nfor<3){
+		star_volume=0;
+		return nfor;
 	}
-	//repackage visible stars into 'usii_vis' single-dimensioned array
-	//inertial unit vector elements are stored sequentially in 'usii_vis[3*visible_count]'
-	double *usii_vis;
-	usii_vis=new double[3*visible_count];
-	int k(0);
-	for(i=0;i<25;i++){
-		if(vis_star_slot[i]>0){
-			*(usii_vis+k)=star_usii[i][0];
-			*(usii_vis+k+1)=star_usii[i][1];
-			*(usii_vis+k+2)=star_usii[i][2];
-			k=k+3;
-		}
-	}
-	//selecting triad (three stars) with maximum volume of their parallelepiped 
-	//i1, i2, i3 are the stars picked by the binomial combination
-	int nm2=visible_count-2; 
-	int nm1=visible_count-1;
-	
-	for(int i1=0;i1<nm2;i1++){
-		for(int i2=i1+1;i2<nm1;i2++){
-			for(int i3=i2+1;i3<visible_count;i3++){
-
-				//pullling the triad inertial coordinates
-				Matrix USII1(3,1);
-				Matrix USII2(3,1);
-				Matrix USII3(3,1);
-				for(int m=0;m<3;m++){
-					USII1[m]=*(usii_vis+3*i1+m);
-					USII2[m]=*(usii_vis+3*i2+m);
-					USII3[m]=*(usii_vis+3*i3+m);
-				}
-				//calculating volume
-				double volume_local(0);
-				volume_local=fabs(USII1^(USII2.skew_sym()*USII3));
+	//selecting triad (three stars) with maximum volume of their parallelepiped
+	star_volume=starcatalog.triad(triad);
 
-				//save location of triad stars in 'ssii_vis[visible_count]' if volume has increased
-				if(volume_local>star_volume){
-					star_volume=volume_local;
-					triad[0]=i1; 
-					triad[1]=i2; 
-					triad[2]=i3; 
-				}
-			}
-		}
-	}//end of picking triads amongst visible stars
-
-	//loading the visible catalog slot# from 'vis_star_slot[25]' into 'vis_star_slot_vis[visible_count]'
-	// deleting all slots with 0 (invisible)
-	int *vis_star_slot_vis;
-	vis_star_slot_vis=new int[visible_count];
-	int kk(0);
-	for(i=0;i<25;i++){
-		if(vis_star_slot[i]>0){
-			vis_star_slot_vis[kk]=vis_star_slot[i];
-			kk++;
-		}
-	}
-	//extract triad (max volume) from visible stars
 	//storing inertial coordinates of the three stars and their catalog slot# in usii_triad[12]
-	// m = star index (0, 1, 2,...) in 'usii_vis' 
 	for(int m=0;m<3;m++){
-		for(int n=0;n<3;n++){
-			*(usii_triad+4*m+n)=*(usii_vis+3*triad[m]+n);
-		}
-			*(usii_triad+4*m+3)=vis_star_slot_vis[triad[m]];
+		starcatalog.get_star(triad[m],usii_triad+4*m);
+		*(usii_triad+4*m+3)=starcatalog.get_slot(triad[m]);
 	}
-	delete[] vis_star_slot_vis;
-	delete[] usii_vis;	
+	return nfor;
 }
 ///////////////////////////////////////////////////////////////////////////////
-//Loading star catalog data
+//Loading the built-in star catalog into 'starcatalog'
 //Member function of class 'Hyper'
 //
-// parameter output:
-//	*star_data=25x3 array of 25 stars and their three unit vector components in the J2000 coord system
-//					(the two-dimensional array is stored in sequential rows in a one-dimensional array)
-//	*star_names=25 array of the 25 star names loaded as strings 
-//
 //040210 Created by Peter H Zipfel
 ///////////////////////////////////////////////////////////////////////////////
 
-void Hyper::star_init(double *star_data,string *star_names)
+void Hyper::star_init()
 {
-	int i(0);
-	
 	//25 bright star catalog
 	//unit vectors in J2000 coordinates
 
@@ -412,7 +344,7 @@ void Hyper::star_init(double *star_data,string *star_names)
 		-.103643,-.792588,-.600885, //24 Shaula
 		 .140796, .866902, .478181  //25 El Nath
 	};
-	string star_catalog_names[25]={
+	char star_catalog_names[25][CHARN]={
 		"Sirius",
 		"Canopus",
 		"Rigil Kent",
@@ -439,15 +371,6 @@ void Hyper::star_init(double *star_data,string *star_names)
 		"Shaula",
 		"El Nath"
 	};
-	//loading star unit vectors into 'star_data' array by pointer arithmetic 
-	for (i=0;i<25;i++){
-		for(int k=0;k<3;k++){
-			*(star_data+3*i+k)=star_catalog_data[i][k];
-		}
-	}
-	//loading star names into 'star_names' array by pointer arithmetic 
-	for (i=0;i<25;i++){
-		*(star_names+i)=star_catalog_names[i];
-	}
+	//loading the zone index
+	starcatalog.load(25,star_catalog_data[0],star_catalog_names[0]);
 }
-
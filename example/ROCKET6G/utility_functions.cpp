@@ -31,7 +31,12 @@
 //	rayleigh
 //	uniform
 //	unituni
+// Design of experiments (DOE) sampling
 // Table look-up
+// GNSS constellation
+// Star catalog
+// Turbulence service
+// Batch Kepler propagation
 // Integration
 // US76 Atmosphere
 // US76 Atmosphere extended to 1000km (NASA Marshall)
@@ -1756,6 +1761,7 @@ int cad_kepler(Matrix &SPII,Matrix &VPII, Matrix SBII,Matrix VBII,const double &
 //
 // Return output
 //			       iter_flag=0: # of iterations < 20; =1: # of iterations > 20;  - ND
+//				   (the Newton iteration stops after 100 iterations)
 // Parameter output
 //			       SPII = projected inertial position after tgo - m
 //			       VPII = projected inertial velocity after tgo - m/s
@@ -1798,11 +1804,11 @@ int cad_kepler1(Matrix &SPII,Matrix &VPII, Matrix SBII,Matrix VBII,const double
 		dt=(x*x*x*s+dum*x*x*c/sqrt_GM+ro*x*(1-z*s))/sqrt_GM;
 		double dtx=(x*x*c+dum*x*(1-z*s)/sqrt_GM+ro*(1-z*c))/sqrt_GM;
 		x=x+(tgo-dt)/dtx;
-	}while(fabs((tgo-dt)/tgo)>SMALL);
+	}while(fabs((tgo-dt)/tgo)>SMALL&&count20<100);
 
 	//projected inertial position
 	double f=1-x*x*c/ro;
-	double g=tgo-x*x*s/sqrt_GM;
+	double g=tgo-x*x*x*s/sqrt_GM;
 	SPII=SBII*f+VBII*g;
 
 	//projecting inertial velocity
@@ -2319,6 +2325,258 @@ double unituni()
 	return value;
 }
 ///////////////////////////////////////////////////////////////////////////////
+//////////////////// Design of experiments (DOE) sampling /////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//The static dispersions UNI, GAUSS, RAYL and EXP of 'input.asc' draw by default
+// from rand() ('MONTE nmonte iseed' or 'MONTE nmonte iseed RANDOM').
+// Alternatively the deck selects a design after the seed:
+//	LHS			Latin hypercube, one stratum of width 1/nmonte per run
+//	SOBOL		Sobol sequence (Joe-Kuo direction numbers) with random digital shift;
+//				dispersions beyond the 21st are stratified with LHS
+//	ANTITHETIC	pairs of runs with unit samples u and 1-u; 'nmonte' must be even
+//Each occurrence of a dispersion keyword, counted in reading order of the run,
+// is one dimension of the design. Its column of samples for all 'nmonte' runs
+// is generated from 'iseed' and the dimension index alone, so run 'nmc' gets
+// the same values no matter which runs were executed before it.
+//MARKOV variables are time-correlated noise and always draw from rand().
+//
+//Usage: doe_initialize() once before the first run, doe_run() at the start
+// of every run, doe_uniform() etc. in place of uniform() etc.
+///////////////////////////////////////////////////////////////////////////////
+
+//DOE methods
+enum {DOE_RANDOM,DOE_LHS,DOE_SOBOL,DOE_ANTITHETIC};
+
+//number of Sobol dimensions with tabulated direction numbers
+const int DOE_SOBOL_DIM=21;
+const int DOE_SOBOL_BITS=32;
+
+//Joe-Kuo primitive polynomials (degree s, coefficients a) and initial
+// direction numbers m of Sobol dimensions 2..21; dimension 1 is van der Corput
+const int doe_sobol_s[DOE_SOBOL_DIM]={0,1,2,3,3,4,4,5,5,5,5,5,5,6,6,6,6,6,6,7,7};
+const int doe_sobol_a[DOE_SOBOL_DIM]={0,0,1,1,2,1,4,2,4,7,11,13,14,1,13,16,19,22,25,1,4};
+const int doe_sobol_m[DOE_SOBOL_DIM][7]={
+	{0},{1},{1,3},{1,3,1},{1,1,1},{1,1,3,3},{1,3,5,13},{1,1,5,5,17},{1,1,5,5,5},
+	{1,1,7,11,19},{1,1,5,1,1},{1,1,1,3,11},{1,3,5,5,31},{1,3,3,9,7,49},
+	{1,1,1,15,21,21},{1,3,1,13,27,49},{1,1,1,15,7,5},{1,3,1,15,13,25},
+	{1,1,5,5,19,61},{1,3,7,11,23,15,103},{1,3,7,13,13,15,69}};
+
+static int doe_method=DOE_RANDOM;	//selected DOE method
+static int doe_nmonte=0;			//number of MC runs spanned by the design
+static int doe_seed=0;				//seed of the design
+static int doe_nmc=0;				//current MC run
+static int doe_dim=0;				//next dimension to be drawn in the current run
+static double **doe_columns=NULL;	//doe_columns[dim][nmc] unit sample in (0,1)
+static int doe_ncolumns=0;			//number of columns generated
+static int doe_capacity=0;			//allocated size of 'doe_columns'
+
+///////////////////////////////////////////////////////////////////////////////
+//Pseudo-random 64-bit integers (splitmix64) for the DOE columns
+//Independent of rand(), so that the design does not depend on other draws
+///////////////////////////////////////////////////////////////////////////////
+static unsigned long long doe_next(unsigned long long &state)
+{
+	unsigned long long z=(state+=0x9e3779b97f4a7c15ULL);
+	z=(z^(z>>30))*0xbf58476d1ce4e5b9ULL;
+	z=(z^(z>>27))*0x94d049bb133111ebULL;
+	return z^(z>>31);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Uniform sample in the open interval (0,1) from 'doe_next()'
+///////////////////////////////////////////////////////////////////////////////
+static double doe_open(unsigned long long &state)
+{
+	return ((doe_next(state)>>11)+0.5)/9007199254740992.;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Generating the column of unit samples of dimension 'dim' for all MC runs
+//
+//parameter input:
+//			dim = dimension of the design (0,1,2,...)
+//return output:
+//			column = array[doe_nmonte] of unit samples in (0,1)
+///////////////////////////////////////////////////////////////////////////////
+static double *doe_column(int dim)
+{
+	int n=doe_nmonte;
+	int k(0);
+	double *column=new double[n];
+	unsigned long long state=((unsigned long long)(unsigned)doe_seed<<32)^(unsigned long long)dim;
+	doe_next(state);
+
+	if(doe_method==DOE_SOBOL&&dim<DOE_SOBOL_DIM)
+	{
+		//direction numbers v[j]=m[j]*2^(32-j-1)
+		unsigned v[DOE_SOBOL_BITS];
+		int s=doe_sobol_s[dim];
+		int a=doe_sobol_a[dim];
+		int j(0);
+		if(!dim)
+			for(j=0;j<DOE_SOBOL_BITS;j++) v[j]=1u<<(DOE_SOBOL_BITS-1-j);
+		else{
+			for(j=0;j<s&&j<DOE_SOBOL_BITS;j++)
+				v[j]=doe_sobol_m[dim][j]<<(DOE_SOBOL_BITS-1-j);
+			for(j=s;j<DOE_SOBOL_BITS;j++){
+				v[j]=v[j-s]^(v[j-s]>>s);
+				for(int i=1;i<s;i++)
+					if((a>>(s-1-i))&1) v[j]^=v[j-i];
+			}
+		}
+		//Gray-code construction with random digital shift
+		unsigned shift=(unsigned)(doe_next(state)>>32);
+		unsigned x=0;
+		for(k=0;k<n;k++){
+			column[k]=((x^shift)+0.5)/4294967296.;
+			int c=0;
+			while((k>>c)&1) c++;
+			x^=v[c];
+		}
+	}
+	else if(doe_method==DOE_ANTITHETIC)
+	{
+		for(k=0;k<n;k++)
+			column[k]=(k%2)?1.-column[k-1]:doe_open(state);
+	}
+	else
+	{
+		//Latin hypercube: random permutation of the strata, random point in each
+		int *perm=new int[n];
+		for(k=0;k<n;k++) perm[k]=k;
+		for(k=n-1;k>0;k--){
+			int j=(int)(doe_next(state)%(unsigned long long)(k+1));
+			int temp=perm[k];perm[k]=perm[j];perm[j]=temp;
+		}
+		for(k=0;k<n;k++)
+			column[k]=(perm[k]+doe_open(state))/n;
+		delete [] perm;
+	}
+	return column;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Selecting the DOE method and sizing the design, called once before run 1
+//
+//parameter input:
+//			method = "RANDOM", "LHS", "SOBOL" or "ANTITHETIC" (empty: "RANDOM")
+//			nmonte = number of MC runs
+//			seed = seed of the design ('iseed' of MONTE)
+///////////////////////////////////////////////////////////////////////////////
+void doe_initialize(const char *method,int nmonte,int seed)
+{
+	if(!strlen(method)||!strcmp(method,"RANDOM")) doe_method=DOE_RANDOM;
+	else if(!strcmp(method,"LHS")) doe_method=DOE_LHS;
+	else if(!strcmp(method,"SOBOL")) doe_method=DOE_SOBOL;
+	else if(!strcmp(method,"ANTITHETIC")) doe_method=DOE_ANTITHETIC;
+	else
+	{cerr<<" *** Error: unknown MONTE sampling '"<<method<<"' (RANDOM, LHS, SOBOL, ANTITHETIC) *** \n";system("pause");exit(1);}
+	if(doe_method==DOE_ANTITHETIC&&nmonte%2)
+	{cerr<<" *** Error: MONTE ANTITHETIC needs an even number of runs, not "<<nmonte<<" *** \n";system("pause");exit(1);}
+
+	for(int i=0;i<doe_ncolumns;i++) delete [] doe_columns[i];
+	delete [] doe_columns;
+	doe_columns=NULL;
+	doe_ncolumns=0;
+	doe_capacity=0;
+	doe_nmonte=nmonte>0?nmonte:1;
+	doe_seed=seed;
+	doe_nmc=0;
+	doe_dim=0;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Starting MC run 'nmc' (0,1,2,...) of the design
+///////////////////////////////////////////////////////////////////////////////
+void doe_run(int nmc)
+{
+	if(doe_method!=DOE_RANDOM&&(nmc<0||nmc>=doe_nmonte))
+	{cerr<<" *** Error: MC run "<<nmc+1<<" outside of the design of "<<doe_nmonte<<" runs *** \n";system("pause");exit(1);}
+	doe_nmc=nmc;
+	doe_dim=0;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Unit sample in (0,1) of the next dimension of the current run
+//Falls back to 'unituni()' if no design is selected
+///////////////////////////////////////////////////////////////////////////////
+double doe_unituni()
+{
+	if(doe_method==DOE_RANDOM) return unituni();
+
+	//generating the columns of the design as the dimensions are first reached
+	if(doe_dim==doe_capacity){
+		doe_capacity=doe_capacity?2*doe_capacity:16;
+		double **columns=new double *[doe_capacity];
+		for(int i=0;i<doe_ncolumns;i++) columns[i]=doe_columns[i];
+		delete [] doe_columns;
+		doe_columns=columns;
+	}
+	while(doe_ncolumns<=doe_dim){
+		doe_columns[doe_ncolumns]=doe_column(doe_ncolumns);
+		doe_ncolumns++;
+	}
+	return doe_columns[doe_dim++][doe_nmc];
+}
+///////////////////////////////////////////////////////////////////////////////
+//Inverse of the standard normal distribution function
+//Ref: P.J. Acklam, rational approximation with one Halley refinement step
+// (relative error < 1e-15)
+///////////////////////////////////////////////////////////////////////////////
+static double doe_inverse_normal(double p)
+{
+	const double a[6]={-3.969683028665376e+01,2.209460984245205e+02,-2.759285104469687e+02,
+		1.383577518672690e+02,-3.066479806614716e+01,2.506628277459239e+00};
+	const double b[5]={-5.447609879822406e+01,1.615858368580409e+02,-1.556989798598866e+02,
+		6.680131188771972e+01,-1.328068155288572e+01};
+	const double c[6]={-7.784894002430293e-03,-3.223964580411365e-01,-2.400758277161838e+00,
+		-2.549732539343734e+00,4.374664141464968e+00,2.938163982698783e+00};
+	const double d[4]={7.784695709041462e-03,3.224671290700398e-01,2.445134137142996e+00,
+		3.754408661907416e+00};
+	const double plow=0.02425;
+	double q,r,x;
+
+	if(p<plow){
+		q=sqrt(-2.*log(p));
+		x=(((((c[0]*q+c[1])*q+c[2])*q+c[3])*q+c[4])*q+c[5])/((((d[0]*q+d[1])*q+d[2])*q+d[3])*q+1.);
+	}
+	else if(p<=1.-plow){
+		q=p-0.5;
+		r=q*q;
+		x=(((((a[0]*r+a[1])*r+a[2])*r+a[3])*r+a[4])*r+a[5])*q/(((((b[0]*r+b[1])*r+b[2])*r+b[3])*r+b[4])*r+1.);
+	}
+	else{
+		q=sqrt(-2.*log(1.-p));
+		x=-(((((c[0]*q+c[1])*q+c[2])*q+c[3])*q+c[4])*q+c[5])/((((d[0]*q+d[1])*q+d[2])*q+d[3])*q+1.);
+	}
+	//refinement
+	double e=0.5*erfc(-x/sqrt(2.))-p;
+	double u=e*2.5066282746310002*exp(x*x/2.);
+	return x-u/(1.+x*u/2.);
+}
+///////////////////////////////////////////////////////////////////////////////
+//DOE counterparts of 'uniform()', 'gauss()', 'rayleigh()' and 'exponential()'
+//Without a design they call those functions, otherwise they transform
+// 'doe_unituni()' by the inverse distribution function
+///////////////////////////////////////////////////////////////////////////////
+double doe_uniform(double min,double max)
+{
+	if(doe_method==DOE_RANDOM) return uniform(min,max);
+	return min+(max-min)*doe_unituni();
+}
+double doe_gauss(double mean,double sig)
+{
+	if(doe_method==DOE_RANDOM) return gauss(mean,sig);
+	return mean+sig*doe_inverse_normal(doe_unituni());
+}
+double doe_rayleigh(double mode)
+{
+	if(doe_method==DOE_RANDOM) return rayleigh(mode);
+	return mode*sqrt(-2.*log(doe_unituni()));
+}
+double doe_exponential(double density)
+{
+	if(doe_method==DOE_RANDOM) return exponential(density);
+	if(!density)
+	{cout<<" *** Error: density not given a non-zero value in 'exponential()' *** \n";system("pause");exit(1);}
+	return -log(doe_unituni())/density;
+}
+///////////////////////////////////////////////////////////////////////////////
 //////////////// Table look-up and interpolation functions ////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -2589,6 +2847,1120 @@ double Datadeck::interpolate(int ind10,int ind11,int ind20,int ind21,int ind30,i
 	return dumx2*(y22-y21)+y21;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/////////////////// GNSS constellation ('Constellation') //////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+//Reading the healthy SVs of a Yuma almanac file
+//
+//Each SV record consists of 'Label: value' lines and ends with the 'week' line:
+//	ID, Health, Eccentricity, Time of Applicability(s), Orbital Inclination(rad),
+//	Rate of Right Ascen(r/s), SQRT(A)  (m 1/2), Right Ascen at Week(rad),
+//	Argument of Perigee(rad), Mean Anom(rad), Af0(s), Af1(s/s), week
+//SVs with non-zero health are skipped; orbits are limited to GNSS-like e<=0.1
+//As in 'Hyper::gps_sv_init', the right ascension at the time of applicability
+// is taken as inertial right ascension at the almanac epoch
+//
+//parameter input:
+//	file_name = Yuma almanac file (keyword GNSS_DECK in 'input.asc')
+///////////////////////////////////////////////////////////////////////////////
+void Constellation::read_almanac(char *file_name)
+{
+	char line[CHARL];
+	int nrecord(0);
+	int k(0);
+
+	ifstream alm_stream(file_name);
+	if(alm_stream.fail())
+		{cerr<<"*** Error: File stream '"<<file_name<<"' failed to open (check spelling) ***\n";system("pause");exit(1);} 
+
+	//counting the SV records
+	while(alm_stream.getline(line,CHARL,'\n'))
+		if(!strncmp(line,"ID:",3)) nrecord++;
+	if(!nrecord)
+		{cerr<<"*** Error: no SV records in almanac '"<<file_name<<"' ***\n";system("pause");exit(1);} 
+
+	//allocating the SV arrays (re-reading replaces an earlier almanac)
+	delete [] prn;
+	delete [] block;
+	delete [] vis;
+	delete [] used;
+	const int narray=25;
+	prn=new int[nrecord];
+	vis=new int[nrecord];
+	used=new bool[nrecord];
+	block=new double[narray*nrecord];
+	double **array[narray]={&sma,&smb,&ecc,&mean_motion,&mean0,&toa,&raan0,&raan_dot,
+		&sin_incl,&cos_incl,&sin_argp,&cos_argp,&sx,&sy,&sz,&vx,&vy,&vz,&ux,&uy,&uz,&sin_m,&cos_m,&sin_o,&cos_o};
+	for(int n=0;n<narray;n++)
+		*array[n]=block+n*nrecord;
+
+	//rewinding to beginning
+	alm_stream.clear();
+	alm_stream.seekg(ios::beg);
+
+	//reading the SV records
+	int id(0),health(0);
+	double e(0),t(0),incl(0),rate(0),sqrt_a(0),raan(0),argp(0),mean(0);
+	double toa_epoch(0);
+	nsv=0;
+	max_motion=0;
+	while(alm_stream.getline(line,CHARL,'\n')){
+		char *colon=strchr(line,':');
+		if(!colon) continue;
+		double value=atof(colon+1);
+		if(!strncmp(line,"ID",2)) id=(int)value;
+		else if(!strncmp(line,"Health",6)) health=(int)value;
+		else if(!strncmp(line,"Eccentricity",12)) e=value;
+		else if(!strncmp(line,"Time of Applicability",21)) t=value;
+		else if(!strncmp(line,"Orbital Inclination",19)) incl=value;
+		else if(!strncmp(line,"Rate of Right Ascen",19)) rate=value;
+		else if(!strncmp(line,"SQRT(A)",7)) sqrt_a=value;
+		else if(!strncmp(line,"Right Ascen at Week",19)) raan=value;
+		else if(!strncmp(line,"Argument of Perigee",19)) argp=value;
+		else if(!strncmp(line,"Mean Anom",9)) mean=value;
+		else if(!strncmp(line,"week",4)){
+			//end of record
+			if(!k) toa_epoch=t;
+			k++;
+			if(health) continue;
+			if(sqrt_a<=0||e<0||e>0.1)
+				{cerr<<"*** Error: SV ID "<<id<<" in almanac '"<<file_name<<"' not a near-circular orbit (e<=0.1) ***\n";system("pause");exit(1);} 
+			prn[nsv]=id;
+			sma[nsv]=sqrt_a*sqrt_a;
+			smb[nsv]=sma[nsv]*sqrt(1-e*e);
+			ecc[nsv]=e;
+			mean_motion[nsv]=sqrt(GM/(sma[nsv]*sma[nsv]*sma[nsv]));
+			if(mean_motion[nsv]>max_motion) max_motion=mean_motion[nsv];
+			mean0[nsv]=mean;
+			toa[nsv]=t-toa_epoch;
+			raan0[nsv]=raan;
+			raan_dot[nsv]=rate;
+			sin_incl[nsv]=sin(incl);
+			cos_incl[nsv]=cos(incl);
+			sin_argp[nsv]=sin(argp);
+			cos_argp[nsv]=cos(argp);
+			nsv++;
+		}
+	}
+	nvis=0;
+	anchored=false;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Sine and cosine of a small angle |x|<=0.1 rad by Taylor series
+//Truncation error < 3e-15; no range reduction, no branches
+///////////////////////////////////////////////////////////////////////////////
+static inline void small_sincos(double x,double &sin_x,double &cos_x)
+{
+	double x2=x*x;
+	sin_x=x*(1+x2*(-1./6+x2*(1./120+x2*(-1./5040+x2*(1./362880)))));
+	cos_x=1+x2*(-0.5+x2*(1./24+x2*(-1./720+x2*(1./40320+x2*(-1./3628800)))));
+}
+///////////////////////////////////////////////////////////////////////////////
+//Propagating all SVs to 'time' since almanac epoch
+//
+//Mean anomaly and right ascension are carried as sine/cosine pairs and
+// advanced from the previous call by angle addition with the small increments
+// n*dt and raan_dot*dt; they are re-anchored with library trigonometry at the
+// first call, when time goes backwards, or when n*dt exceeds 0.1 rad
+//Kepler's equation: starter E0=M+e*sin(M) and one Newton step; sin/cos of the
+// corrected eccentric anomaly by second-order expansion about E0 (the step is
+// of order e^2, the error of order e^5, i.e. mm for GNSS orbits)
+//The loop over the SVs has no library calls and no branches
+//
+//parameter input:
+//	time = time since almanac epoch - s
+///////////////////////////////////////////////////////////////////////////////
+void Constellation::propagate(double time)
+{
+	double step=time-time_prop;
+	bool advance=anchored&&step>=0&&step*max_motion<=0.1;
+
+	if(!advance){
+		//anchoring mean anomaly and right ascension at 'time'
+		for(int k=0;k<nsv;k++){
+			double dt=time-toa[k];
+			double mean=mean0[k]+mean_motion[k]*dt;
+			double raan=raan0[k]+raan_dot[k]*dt;
+			sin_m[k]=sin(mean);
+			cos_m[k]=cos(mean);
+			sin_o[k]=sin(raan);
+			cos_o[k]=cos(raan);
+		}
+		anchored=true;
+	}
+	else{
+		//advancing by angle addition, with first-order renormalization against drift
+		for(int k=0;k<nsv;k++){
+			double sin_d,cos_d;
+			small_sincos(mean_motion[k]*step,sin_d,cos_d);
+			double sm=sin_m[k]*cos_d+cos_m[k]*sin_d;
+			double cm=cos_m[k]*cos_d-sin_m[k]*sin_d;
+			double norm=1.5-0.5*(sm*sm+cm*cm);
+			sin_m[k]=sm*norm;
+			cos_m[k]=cm*norm;
+			small_sincos(raan_dot[k]*step,sin_d,cos_d);
+			double so=sin_o[k]*cos_d+cos_o[k]*sin_d;
+			double co=cos_o[k]*cos_d-sin_o[k]*sin_d;
+			norm=1.5-0.5*(so*so+co*co);
+			sin_o[k]=so*norm;
+			cos_o[k]=co*norm;
+		}
+	}
+	time_prop=time;
+
+	for(int k=0;k<nsv;k++){
+		double e=ecc[k];
+
+		//eccentric anomaly: E0=M+x, x=e*sin(M)
+		double x=e*sin_m[k];
+		double sin_x,cos_x;
+		small_sincos(x,sin_x,cos_x);
+		double sin0=sin_m[k]*cos_x+cos_m[k]*sin_x;
+		double cos0=cos_m[k]*cos_x-sin_m[k]*sin_x;
+		double del=(e*sin0-x)/(1-e*cos0);
+		double sin_e=sin0+del*(cos0-0.5*del*sin0);
+		double cos_e=cos0-del*(sin0+0.5*del*cos0);
+
+		//perifocal position and velocity
+		double edot=mean_motion[k]/(1-e*cos_e);
+		double xp=sma[k]*(cos_e-e);
+		double yp=smb[k]*sin_e;
+		double vxp=-sma[k]*sin_e*edot;
+		double vyp=smb[k]*cos_e*edot;
+
+		//perifocal to inertial: unit vectors toward perigee 'p' and 90 deg ahead 'q'
+		double so=sin_o[k],co=cos_o[k];
+		double sw=sin_argp[k],cw=cos_argp[k],si=sin_incl[k],ci=cos_incl[k];
+		double px=co*cw-so*sw*ci;
+		double py=so*cw+co*sw*ci;
+		double pz=sw*si;
+		double qx=-co*sw-so*cw*ci;
+		double qy=-so*sw+co*cw*ci;
+		double qz=cw*si;
+		sx[k]=xp*px+yp*qx;
+		sy[k]=xp*py+yp*qy;
+		sz[k]=xp*pz+yp*qz;
+		vx[k]=vxp*px+vyp*qx;
+		vy[k]=vxp*py+vyp*qy;
+		vz[k]=vxp*pz+vyp*qz;
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Earth-occlusion test of all SVs
+//
+//An SV is visible if the line-of-sight from the user does not pass through
+// the sphere of 'radius'. A user inside the sphere is lifted onto it, which
+// reproduces the visibility cone of 'Hyper::gps_quadriga'. No trigonometry:
+// visible if (S-P)^P>=0, or else if the closest approach of the line-of-sight
+// lies outside the sphere
+//Also stores the unit vectors of the user wrt the visible SVs for 'select'
+//
+//parameter input:
+//	SBII = inertial position of user - m
+//	radius = Earth radius plus signal clearance - m
+//return output:
+//	number of visible SVs
+///////////////////////////////////////////////////////////////////////////////
+int Constellation::visibility(Matrix SBII,double radius)
+{
+	double px=SBII[0],py=SBII[1],pz=SBII[2];
+	double rad2=radius*radius;
+	double dbi2=px*px+py*py+pz*pz;
+	double dbi=sqrt(dbi2);
+	double lift=dbi<radius?radius/dbi:1;
+	double lx=px*lift,ly=py*lift,lz=pz*lift;
+	double dl2=lx*lx+ly*ly+lz*lz;
+	zenith[0]=px/dbi;
+	zenith[1]=py/dbi;
+	zenith[2]=pz/dbi;
+
+	nvis=0;
+	for(int k=0;k<nsv;k++){
+		double dx=sx[k]-lx;
+		double dy=sy[k]-ly;
+		double dz=sz[k]-lz;
+		double pd=lx*dx+ly*dy+lz*dz;
+		double d2=dx*dx+dy*dy+dz*dz;
+		if(pd>=0||dl2-pd*pd/d2>rad2){
+			//unit vector of user wrt SV (rows of the GDOP observation matrix)
+			double ex=px-sx[k];
+			double ey=py-sy[k];
+			double ez=pz-sz[k];
+			double dsb=sqrt(ex*ex+ey*ey+ez*ez);
+			ux[nvis]=ex/dsb;
+			uy[nvis]=ey/dsb;
+			uz[nvis]=ez/dsb;
+			vis[nvis]=k;
+			nvis++;
+		}
+	}
+	return nvis;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Best-N subset of the visible SVs
+//
+//All visible SVs if 'nsel' >= number visible. Otherwise greedy forward
+// selection starting with the highest elevation SV: with P the inverse of the
+// accumulated information H^T*H (started at I/delta), adding row a=[u,1]
+// reduces trace(P) by a^P^2a/(1+a^Pa) (Sherman-Morrison). Each pick scores all candidates in O(1) and updates P in
+// place, so selecting N of n SVs is O(N*n) instead of binomial(n,N) 4x4 inverses
+//GDOP=sqrt(trace((H^T*H)^-1)) of the selected subset is evaluated exactly
+//
+//parameter input:
+//	nsel = number of SVs to be selected (>=4)
+//parameter output:
+//	*sel = SV indices of the subset (in order of selection for best-N)
+//return output:
+//	GDOP of the subset - ND (LARGE if singular)
+///////////////////////////////////////////////////////////////////////////////
+double Constellation::select(int nsel,int *sel)
+{
+	const double delta=1e-3; //weak prior information, only breaks the rank deficit of the first picks
+	int nsub=nsel<nvis?nsel:nvis;
+
+	if(nsub==nvis){
+		for(int i=0;i<nvis;i++) sel[i]=i;
+	}
+	else{
+		for(int j=0;j<nvis;j++) used[j]=false;
+		double pp[16]={1/delta,0,0,0, 0,1/delta,0,0, 0,0,1/delta,0, 0,0,0,1/delta};
+		for(int i=0;i<nsub;i++){
+			int best(-1);
+			double wbest[4]={0,0,0,0};
+			double sbest(0);
+			if(!i){
+				//first pick: all scores are equal, highest elevation SV
+				double elev=LARGE;
+				for(int j=0;j<nvis;j++){
+					double uz_j=-(ux[j]*zenith[0]+uy[j]*zenith[1]+uz[j]*zenith[2]);
+					if(best<0||uz_j>elev){
+						elev=uz_j;
+						best=j;
+					}
+				}
+				double a[4]={ux[best],uy[best],uz[best],1};
+				for(int r=0;r<4;r++) wbest[r]=pp[5*r]*a[r];
+				sbest=a[0]*wbest[0]+a[1]*wbest[1]+a[2]*wbest[2]+a[3]*wbest[3];
+			}
+			else{
+				//score num/(1+s) compared cross-multiplied, without division
+				double num_best(-1);
+				for(int j=0;j<nvis;j++){
+					if(used[j]) continue;
+					double a[4]={ux[j],uy[j],uz[j],1};
+					double w[4];
+					for(int r=0;r<4;r++)
+						w[r]=pp[4*r]*a[0]+pp[4*r+1]*a[1]+pp[4*r+2]*a[2]+pp[4*r+3]*a[3];
+					double s=a[0]*w[0]+a[1]*w[1]+a[2]*w[2]+a[3]*w[3];
+					double num=w[0]*w[0]+w[1]*w[1]+w[2]*w[2]+w[3]*w[3];
+					if(best<0||num*(1+sbest)>num_best*(1+s)){
+						num_best=num;
+						best=j;
+						for(int r=0;r<4;r++) wbest[r]=w[r];
+						sbest=s;
+					}
+				}
+			}
+			//rank-one downdate of P
+			for(int r=0;r<4;r++)
+				for(int c=0;c<4;c++)
+					pp[4*r+c]-=wbest[r]*wbest[c]/(1+sbest);
+			used[best]=true;
+			sel[i]=best;
+		}
+	}
+	//exact GDOP: trace of the inverse of the 4x4 information matrix G=H^T*H
+	// from the 2x2 minors of its upper (s) and lower (c) row pairs
+	double g[16]={0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0};
+	for(int i=0;i<nsub;i++){
+		double a[4]={ux[sel[i]],uy[sel[i]],uz[sel[i]],1};
+		for(int r=0;r<4;r++)
+			for(int c=r;c<4;c++)
+				g[4*r+c]+=a[r]*a[c];
+	}
+	for(int r=1;r<4;r++)
+		for(int c=0;c<r;c++)
+			g[4*r+c]=g[4*c+r];
+	//visible index -> SV index
+	for(int i=0;i<nsub;i++) sel[i]=vis[sel[i]];
+	double s0=g[0]*g[5]-g[1]*g[4];
+	double s1=g[0]*g[6]-g[2]*g[4];
+	double s2=g[0]*g[7]-g[3]*g[4];
+	double s3=g[1]*g[6]-g[2]*g[5];
+	double s4=g[1]*g[7]-g[3]*g[5];
+	double s5=g[2]*g[7]-g[3]*g[6];
+	double c5=g[10]*g[15]-g[11]*g[14];
+	double c4=g[9]*g[15]-g[11]*g[13];
+	double c3=g[9]*g[14]-g[10]*g[13];
+	double c2=g[8]*g[15]-g[11]*g[12];
+	double c1=g[8]*g[14]-g[10]*g[12];
+	double c0=g[8]*g[13]-g[9]*g[12];
+	double det=s0*c5-s1*c4+s2*c3+s3*c2-s4*c1+s5*c0;
+	if(det<=EPS) return LARGE;
+	//diagonal cofactors
+	double m0=g[5]*c5-g[6]*c4+g[7]*c3;
+	double m1=g[0]*c5-g[2]*c2+g[3]*c1;
+	double m2=g[12]*s4-g[13]*s2+g[15]*s0;
+	double m3=g[8]*s3-g[9]*s1+g[10]*s0;
+	return sqrt((m0+m1+m2+m3)/det);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////// Star catalog ('Starcatalog') ////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+//sort key of the zone index
+struct Star_key
+{
+	int zone;
+	double ra;
+	int index;
+};
+static int star_key_compare(const void *a,const void *b)
+{
+	const Star_key *ka=(const Star_key *)a;
+	const Star_key *kb=(const Star_key *)b;
+	if(ka->zone!=kb->zone) return ka->zone<kb->zone?-1:1;
+	if(ka->ra!=kb->ra) return ka->ra<kb->ra?-1:1;
+	return ka->index<kb->index?-1:(ka->index>kb->index);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Building the declination-zone index
+//
+//About sqrt(n) zones (at most 180), so that a zone holds about sqrt(n) stars
+//The unit vectors are kept as given; they are normalized only for the index
+//
+//parameter input:
+//	n = number of stars
+//	*unit = unit vectors in J2000 coordinates, stored sequentially
+//	*name_list = star names, CHARN characters each
+///////////////////////////////////////////////////////////////////////////////
+void Starcatalog::build(int n,const double *unit,const char *name_list)
+{
+	int k(0);
+
+	delete [] slot;
+	delete [] names;
+	delete [] block;
+	delete [] zone_start;
+	delete [] cand;
+	delete [] in_for;
+	delete [] found;
+	nstar=n;
+	slot=new int[n];
+	names=new char[CHARN*n];
+	block=new double[4*n];
+	ux=block;
+	uy=block+n;
+	uz=block+2*n;
+	ra=block+3*n;
+	cand=new int[n];
+	in_for=new char[n];
+	found=new int[n];
+	ncand=0;
+
+	nzone=(int)sqrt((double)n);
+	if(nzone<1) nzone=1;
+	if(nzone>180) nzone=180;
+	zone_start=new int[nzone+1];
+
+	//sorting by zone and right ascension
+	Star_key *key=new Star_key[n];
+	for(k=0;k<n;k++){
+		const double *u=unit+3*k;
+		double norm=sqrt(u[0]*u[0]+u[1]*u[1]+u[2]*u[2]);
+		double sin_dec=u[2]/norm;
+		if(sin_dec>1) sin_dec=1;
+		if(sin_dec<-1) sin_dec=-1;
+		int zone=(int)((asin(sin_dec)+PI/2)/PI*nzone);
+		if(zone<0) zone=0;
+		if(zone>nzone-1) zone=nzone-1;
+		double alpha=atan2(u[1],u[0]);
+		if(alpha<0) alpha+=2*PI;
+		key[k].zone=zone;
+		key[k].ra=alpha;
+		key[k].index=k;
+	}
+	qsort(key,n,sizeof(Star_key),star_key_compare);
+
+	for(int z=0;z<=nzone;z++) zone_start[z]=0;
+	for(k=0;k<n;k++){
+		int i=key[k].index;
+		ux[k]=unit[3*i];
+		uy[k]=unit[3*i+1];
+		uz[k]=unit[3*i+2];
+		ra[k]=key[k].ra;
+		slot[k]=i+1;
+		strncpy(names+CHARN*k,name_list+CHARN*i,CHARN-1);
+		names[CHARN*k+CHARN-1]='\0';
+		in_for[k]=0;
+		zone_start[key[k].zone+1]++;
+	}
+	for(int z=0;z<nzone;z++) zone_start[z+1]+=zone_start[z];
+	delete [] key;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Reading a star catalog file keyed on STAR_DECK in 'input.asc'
+//
+//One star per line: right ascension - deg, declination - deg, name (rest of
+// line); lines starting with 'TITLE' or '//' and empty lines are skipped
+//
+//parameter input:
+//	file_name = star catalog file
+///////////////////////////////////////////////////////////////////////////////
+void Starcatalog::read_catalog(char *file_name)
+{
+	char line[CHARL];
+	char name[CHARL];
+	double ra_deg(0),dec_deg(0);
+	int n(0);
+
+	ifstream cat_stream(file_name);
+	if(cat_stream.fail())
+		{cerr<<"*** Error: File stream '"<<file_name<<"' failed to open (check spelling) ***\n";system("pause");exit(1);} 
+
+	//counting the stars
+	while(cat_stream.getline(line,CHARL,'\n')){
+		if(!strncmp(line,"TITLE",5)||!strncmp(line,"//",2)) continue;
+		if(sscanf(line,"%lf %lf",&ra_deg,&dec_deg)==2) n++;
+	}
+	if(n<3)
+		{cerr<<"*** Error: less than three stars in catalog '"<<file_name<<"' ***\n";system("pause");exit(1);} 
+
+	//rewinding to beginning
+	cat_stream.clear();
+	cat_stream.seekg(ios::beg);
+
+	//reading unit vectors and names
+	double *unit=new double[3*n];
+	char *name_list=new char[CHARN*n];
+	int k(0);
+	while(cat_stream.getline(line,CHARL,'\n')&&k<n){
+		if(!strncmp(line,"TITLE",5)||!strncmp(line,"//",2)) continue;
+		name[0]='\0';
+		if(sscanf(line,"%lf %lf %[^\r\n]",&ra_deg,&dec_deg,name)<2) continue;
+		double cos_dec=cos(dec_deg*RAD);
+		unit[3*k]=cos_dec*cos(ra_deg*RAD);
+		unit[3*k+1]=cos_dec*sin(ra_deg*RAD);
+		unit[3*k+2]=sin(dec_deg*RAD);
+		name[CHARN-1]='\0';
+		strcpy(name_list+CHARN*k,name);
+		k++;
+	}
+	build(n,unit,name_list);
+	delete [] unit;
+	delete [] name_list;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Cone query of the zone index
+//
+//Visits the zones overlapping the declination range of the cone and within
+// each the right ascension window +-alpha, alpha being the largest right
+// ascension offset on the cone (all of the zone if the cone holds a pole)
+//
+//parameter input:
+//	*center = unit vector of cone axis
+//	cos_radius = cosine of cone half-angle
+//parameter output:
+//	*list = stars with u^center > cos_radius
+//return output:
+//	number of stars found
+///////////////////////////////////////////////////////////////////////////////
+int Starcatalog::cone(const double *center,double cos_radius,int *list)
+{
+	int n(0);
+	if(cos_radius>1) return 0;
+	if(cos_radius<-1) cos_radius=-1;
+
+	//angular window, widened for catalog unit vectors not exactly of unit length
+	double radius=acos(cos_radius)+1e-6;
+	double cx=center[0],cy=center[1],cz=center[2];
+	double norm=sqrt(cx*cx+cy*cy+cz*cz);
+	double sin_dec=cz/norm;
+	if(sin_dec>1) sin_dec=1;
+	if(sin_dec<-1) sin_dec=-1;
+	double dec0=asin(sin_dec);
+	double ra0=atan2(cy,cx);
+	if(ra0<0) ra0+=2*PI;
+
+	int zlo=(int)((dec0-radius+PI/2)/PI*nzone);
+	int zhi=(int)((dec0+radius+PI/2)/PI*nzone);
+	if(zlo<0) zlo=0;
+	if(zhi>nzone-1) zhi=nzone-1;
+	bool full=(dec0+radius>=PI/2||dec0-radius<=-PI/2);
+	double alpha=PI;
+	if(!full) alpha=atan(sin(radius)/sqrt(fabs(cos(dec0-radius)*cos(dec0+radius))));
+	if(alpha>=PI) full=true;
+
+	//right ascension ranges [lo,hi], two if the window wraps around
+	double lo[2]={ra0-alpha,0},hi[2]={ra0+alpha,0};
+	int nrange(1);
+	if(full){
+		lo[0]=-1;hi[0]=2*PI+1;
+	}
+	else if(lo[0]<0){
+		lo[1]=lo[0]+2*PI;hi[1]=2*PI;lo[0]=0;nrange=2;
+	}
+	else if(hi[0]>2*PI){
+		lo[1]=0;hi[1]=hi[0]-2*PI;hi[0]=2*PI;nrange=2;
+	}
+	for(int z=zlo;z<=zhi;z++){
+		for(int r=0;r<nrange;r++){
+			//binary search of first star with ra>=lo
+			int first=zone_start[z];
+			int last=zone_start[z+1];
+			while(first<last){
+				int mid=(first+last)/2;
+				if(ra[mid]<lo[r]) first=mid+1;
+				else last=mid;
+			}
+			for(int k=first;k<zone_start[z+1]&&ra[k]<=hi[r];k++){
+				if(ux[k]*cx+uy[k]*cy+uz[k]*cz>cos_radius)
+					list[n++]=k;
+			}
+		}
+	}
+	return n;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Stars in the field of regard
+//
+//parameter input:
+//	*center = unit vector of the field of regard axis
+//	cos_radius = cosine of the field of regard half-angle
+//return output:
+//	number of stars in the field of regard
+///////////////////////////////////////////////////////////////////////////////
+int Starcatalog::field_of_regard(const double *center,double cos_radius)
+{
+	for(int i=0;i<ncand;i++) in_for[cand[i]]=0;
+	ncand=cone(center,cos_radius,cand);
+	for(int i=0;i<ncand;i++) in_for[cand[i]]=1;
+	return ncand;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Triad of the field of regard with maximum parallelepiped volume |u1^(u2 x u3)|
+//
+//Seed: coordinate ascent, each star in turn replaced by the star best
+// aligned with the normal of the other two (O(n) per pass)
+//Exact pruned search: since the volume is bounded by |u1 x u2|, only pairs
+// with |u1 x u2| > best volume are expanded, and their third star is taken
+// from the cone query about +-(u1 x u2) with cosine best/|u1 x u2|
+//Result equals the exhaustive search (ties aside)
+//
+//parameter output:
+//	*tri = indices of the three stars, in ascending catalog slot#
+//return output:
+//	volume of the parallelepiped (max value=1) - ND; 0 if less than 3 stars
+///////////////////////////////////////////////////////////////////////////////
+double Starcatalog::triad(int *tri)
+{
+	int i(0),j(0),k(0);
+	int m=ncand;
+	if(m<3) return 0;
+
+	//seed: first candidate, star most orthogonal to it, star best aligned with their normal
+	int t[3]={cand[0],cand[1],cand[2]};
+	double best_sin2(-1);
+	for(j=1;j<m;j++){
+		int c=cand[j];
+		double nx=uy[t[0]]*uz[c]-uz[t[0]]*uy[c];
+		double ny=uz[t[0]]*ux[c]-ux[t[0]]*uz[c];
+		double nz=ux[t[0]]*uy[c]-uy[t[0]]*ux[c];
+		double sin2=nx*nx+ny*ny+nz*nz;
+		if(sin2>best_sin2){best_sin2=sin2;t[1]=c;}
+	}
+	double best(-1);
+	for(int pass=0;pass<10;pass++){
+		bool improved=false;
+		for(int s=0;s<3;s++){
+			int a=t[(s+1)%3],b=t[(s+2)%3];
+			double nx=uy[a]*uz[b]-uz[a]*uy[b];
+			double ny=uz[a]*ux[b]-ux[a]*uz[b];
+			double nz=ux[a]*uy[b]-uy[a]*ux[b];
+			for(j=0;j<m;j++){
+				int c=cand[j];
+				double volume=fabs(nx*ux[c]+ny*uy[c]+nz*uz[c]);
+				if(volume>best&&c!=a&&c!=b){best=volume;t[s]=c;improved=true;}
+			}
+		}
+		if(!improved) break;
+	}
+	//exact search over the pairs that can beat the seed
+	for(i=0;i<m;i++){
+		int a=cand[i];
+		for(j=i+1;j<m;j++){
+			int b=cand[j];
+			double nx=uy[a]*uz[b]-uz[a]*uy[b];
+			double ny=uz[a]*ux[b]-ux[a]*uz[b];
+			double nz=ux[a]*uy[b]-uy[a]*ux[b];
+			double sin2=nx*nx+ny*ny+nz*nz;
+			if(sin2<=best*best) continue;
+			double sin_ab=sqrt(sin2);
+			for(int sign=-1;sign<=1;sign+=2){
+				double axis[3]={sign*nx/sin_ab,sign*ny/sin_ab,sign*nz/sin_ab};
+				int nfound=cone(axis,best/sin_ab,found);
+				for(k=0;k<nfound;k++){
+					int c=found[k];
+					if(!in_for[c]) continue;
+					double volume=fabs(nx*ux[c]+ny*uy[c]+nz*uz[c]);
+					if(volume>best){best=volume;t[0]=a;t[1]=b;t[2]=c;}
+				}
+			}
+		}
+	}
+	//ascending catalog slot#
+	for(i=0;i<3;i++) tri[i]=t[i];
+	for(i=0;i<2;i++)
+		for(j=0;j<2-i;j++)
+			if(slot[tri[j]]>slot[tri[j+1]]){k=tri[j];tri[j]=tri[j+1];tri[j+1]=k;}
+	return best;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/////////////////////// Turbulence service ('Turbulence') /////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+//samples per correlation length and samples per Dryden block
+const int TURB_NPL=32;
+const int TURB_BLOCK=4096;
+
+static int turb_seed=0;		//seed of the fields
+static int turb_nmc=0;		//current MC run
+static int turb_vehicle=0;	//vehicles bound in the current run
+
+void turbulence_run(int seed,int nmc)
+{
+	turb_seed=seed;
+	turb_nmc=nmc;
+	turb_vehicle=0;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Radix-2 FFT in place, n a power of 2
+//
+//parameter input:
+//			*re,*im = real and imaginary parts, n each
+//			sign = -1 forward, +1 inverse (not scaled by 1/n)
+///////////////////////////////////////////////////////////////////////////////
+static void turb_fft(double *re,double *im,int n,int sign)
+{
+	int i(0),j(0);
+	//bit reversal
+	for(i=1;i<n;i++){
+		int bit=n>>1;
+		for(;j&bit;bit>>=1) j^=bit;
+		j^=bit;
+		if(i<j){
+			double t=re[i];re[i]=re[j];re[j]=t;
+			t=im[i];im[i]=im[j];im[j]=t;
+		}
+	}
+	//butterflies
+	for(int len=2;len<=n;len<<=1){
+		double ang=sign*2*PI/len;
+		double wr=cos(ang),wi=sin(ang);
+		for(i=0;i<n;i+=len){
+			double cr=1,ci=0;
+			for(int k=0;k<len/2;k++){
+				int a=i+k,b=i+k+len/2;
+				double tr=re[b]*cr-im[b]*ci;
+				double ti=re[b]*ci+im[b]*cr;
+				re[b]=re[a]-tr;im[b]=im[a]-ti;
+				re[a]+=tr;im[a]+=ti;
+				double t=cr*wr-ci*wi;
+				ci=cr*wi+ci*wr;
+				cr=t;
+			}
+		}
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Batch of 'n' (even) white Gaussian samples of unit variance, Box-Muller pairs
+///////////////////////////////////////////////////////////////////////////////
+void Turbulence::white_noise(double *noise,int n)
+{
+	for(int i=0;i<n;i+=2){
+		double r=sqrt(-2*log(doe_open(stream)));
+		double a=2*PI*doe_open(stream);
+		noise[i]=r*cos(a);
+		noise[i+1]=r*sin(a);
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Binding the field of the next vehicle of the current run
+//
+//parameter input:
+//			kind = 2 Dryden, 3 von Karman ('mturb')
+//			length = correlation length - m
+//			cache = true: field read from/written to disk
+///////////////////////////////////////////////////////////////////////////////
+void Turbulence::bind(int kind_in,double length_in,bool cache_in)
+{
+	vehicle=++turb_vehicle;
+	regenerate(kind_in,length_in,cache_in);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Re-binding the field of a pooled vehicle to the current run
+//The vehicles are reset in the order they were first bound, so the field
+// keeps the key (seed, MC run, vehicle) it would have in a new object
+///////////////////////////////////////////////////////////////////////////////
+void Turbulence::rebind()
+{
+	if(!kind) return;
+	vehicle=++turb_vehicle;
+	generate();
+}
+///////////////////////////////////////////////////////////////////////////////
+//Re-generating the bound field with new parameters, same key
+///////////////////////////////////////////////////////////////////////////////
+void Turbulence::regenerate(int kind_in,double length_in,bool cache_in)
+{
+	if(kind_in!=2&&kind_in!=3)
+		{cerr<<" *** Error: turbulence field 'mturb' must be 2 or 3 *** \n";system("pause");exit(1);}
+	if(length_in<=0)
+		{cerr<<" *** Error: turbulence correlation length 'turb_length' must be positive *** \n";system("pause");exit(1);}
+
+	kind=kind_in;
+	length=length_in;
+	cache=cache_in;
+	generate();
+}
+///////////////////////////////////////////////////////////////////////////////
+//Generating the field of 'kind', 'length' and 'cache' under the key of the
+// current run and of 'vehicle'
+///////////////////////////////////////////////////////////////////////////////
+void Turbulence::generate()
+{
+	dx=length/TURB_NPL;
+	seed=turb_seed;
+	nmc=turb_nmc;
+	nfield=0;
+
+	//white noise stream keyed on (seed, MC run, vehicle)
+	stream=(unsigned long long)seed;
+	stream=doe_next(stream)^((unsigned long long)nmc*0xd1b54a32d192ed03ULL);
+	stream=doe_next(stream)^((unsigned long long)vehicle*0x8cb92ba72f3d8dd7ULL);
+
+	//Dryden filter dx/dxi=[0 1;-1 -2]x+[0 1]'w, xi=distance/length, discretized
+	// exactly over d=1/TURB_NPL; stationary covariance I/4, output x1+sqrt(3)x2
+	double d=1./TURB_NPL;
+	double e=exp(-d);
+	phi11=e*(1+d);phi12=e*d;
+	phi21=-e*d;phi22=e*(1-d);
+	double q11=0.25*(1-phi11*phi11-phi12*phi12);
+	double q12=-0.25*(phi11*phi21+phi12*phi22);
+	double q22=0.25*(1-phi21*phi21-phi22*phi22);
+	chol11=sqrt(q11);
+	chol21=q12/chol11;
+	chol22=sqrt(q22-chol21*chol21);
+
+	if(cache){
+		sprintf(cache_name,"turb_%i_%i_%i_%i.bin",kind,seed,nmc,vehicle);
+		if(read_cache()) return;
+	}
+	if(kind==2){
+		//initial state drawn from the stationary covariance
+		double noise[2];
+		white_noise(noise,2);
+		state1=0.5*noise[0];
+		state2=0.5*noise[1];
+		extend_dryden();
+	}
+	else
+		shape_von_karman();
+	if(cache) write_cache();
+}
+///////////////////////////////////////////////////////////////////////////////
+//Appending one block of TURB_BLOCK samples to the Dryden field
+///////////////////////////////////////////////////////////////////////////////
+void Turbulence::extend_dryden()
+{
+	if(nfield+TURB_BLOCK>capacity){
+		capacity=capacity?2*capacity:TURB_BLOCK;
+		while(capacity<nfield+TURB_BLOCK) capacity*=2;
+		double *grown=new double[capacity];
+		for(int i=0;i<nfield;i++) grown[i]=field[i];
+		delete [] field;
+		field=grown;
+	}
+	double *noise=new double[2*TURB_BLOCK];
+	white_noise(noise,2*TURB_BLOCK);
+	double sqrt3=sqrt(3.);
+	for(int i=0;i<TURB_BLOCK;i++){
+		field[nfield+i]=state1+sqrt3*state2;
+		double w1=noise[2*i],w2=noise[2*i+1];
+		double x1=phi11*state1+phi12*state2+chol11*w1;
+		double x2=phi21*state1+phi22*state2+chol21*w1+chol22*w2;
+		state1=x1;
+		state2=x2;
+	}
+	nfield+=TURB_BLOCK;
+	delete [] noise;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Periodic von Karman field of NTURB samples by FFT shaping
+//
+//Spectrum (vertical gust) over Omega=spatial frequency*length:
+//	S ~ (1+8/3*(1.339*Omega)^2)/(1+(1.339*Omega)^2)^(11/6)
+//scaled so that the field variance is one
+///////////////////////////////////////////////////////////////////////////////
+void Turbulence::shape_von_karman()
+{
+	int n=NTURB;
+	int i(0);
+	delete [] field;
+	field=new double[n];
+	capacity=n;
+	nfield=n;
+
+	double *re=new double[n];
+	double *im=new double[n];
+	double *gain=new double[n/2+1];
+	white_noise(re,n);
+	for(i=0;i<n;i++) im[i]=0;
+	turb_fft(re,im,n,-1);
+
+	//spectral gain, mean of spectrum over all n bins normalized to one
+	double sum(0);
+	for(i=0;i<=n/2;i++){
+		double omega=2*PI*i/(n*dx)*length;
+		double a2=1.339*omega*1.339*omega;
+		gain[i]=(1+8./3*a2)/pow(1+a2,11./6);
+		sum+=(i==0||i==n/2)?gain[i]:2*gain[i];
+	}
+	for(i=0;i<=n/2;i++) gain[i]=sqrt(gain[i]*n/sum);
+	for(i=0;i<n;i++){
+		int k=i<=n/2?i:n-i;
+		re[i]*=gain[k];
+		im[i]*=gain[k];
+	}
+	turb_fft(re,im,n,1);
+	for(i=0;i<n;i++) field[i]=re[i]/n;
+
+	delete [] re;
+	delete [] im;
+	delete [] gain;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Unit-variance gust velocity at distance 'dist' flown through the air mass - m
+//Dryden fields are extended as needed, von Karman fields repeat periodically
+///////////////////////////////////////////////////////////////////////////////
+double Turbulence::sample(double dist)
+{
+	if(!kind) return 0;
+	double pos=dist>0?dist/dx:0;
+	if(kind==3) pos=fmod(pos,(double)nfield);
+	int i=(int)pos;
+	int j=i+1;
+	if(kind==2&&j>=nfield){
+		while(j>=nfield) extend_dryden();
+		if(cache) write_cache();
+	}
+	else if(j==nfield) j=0;
+	return field[i]+(pos-i)*(field[j]-field[i]);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Turbulence field cache file
+//
+//Header: key (kind, seed, MC run, vehicle), correlation length, sample count,
+// Dryden filter state and noise stream (to continue the field); then samples
+///////////////////////////////////////////////////////////////////////////////
+bool Turbulence::read_cache()
+{
+	ifstream fcache(cache_name,ios::binary);
+	if(fcache.fail()) return false;
+	int key[5]={0,0,0,0,0};
+	double value[3]={0,0,0};
+	unsigned long long stream_in(0);
+	fcache.read((char *)key,sizeof(key));
+	fcache.read((char *)value,sizeof(value));
+	fcache.read((char *)&stream_in,sizeof(stream_in));
+	if(!fcache||key[0]!=kind||key[1]!=seed||key[2]!=nmc||key[3]!=vehicle||value[0]!=length||key[4]<2)
+		return false;
+	double *samples=new double[key[4]];
+	fcache.read((char *)samples,key[4]*sizeof(double));
+	if(!fcache){delete [] samples;return false;}
+	delete [] field;
+	field=samples;
+	nfield=capacity=key[4];
+	state1=value[1];
+	state2=value[2];
+	stream=stream_in;
+	return true;
+}
+void Turbulence::write_cache()
+{
+	ofstream fcache(cache_name,ios::binary);
+	if(!fcache){cerr<<" *** Warning: cannot write turbulence cache '"<<cache_name<<"' *** \n";cache=false;return;}
+	int key[5]={kind,seed,nmc,vehicle,nfield};
+	double value[3]={length,state1,state2};
+	fcache.write((char *)key,sizeof(key));
+	fcache.write((char *)value,sizeof(value));
+	fcache.write((char *)&stream,sizeof(stream));
+	fcache.write((char *)field,nfield*sizeof(double));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+////////////////////// Batch Kepler propagation ('Kepler') ////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+//number of arrays in 'Kepler::block' and max number of Newton sweeps
+const int KEPLER_NARRAY=18;
+const int KEPLER_MAXITER=50;
+
+///////////////////////////////////////////////////////////////////////////////
+//Stumpff functions c(z)=(1-cos(sqrt(z)))/z and s(z)=(sqrt(z)-sin(sqrt(z)))/sqrt(z)^3
+//Series near z=0, where the closed forms lose precision
+///////////////////////////////////////////////////////////////////////////////
+static inline void kepler_stumpff(double z,double &c,double &s)
+{
+	if(z>0.01){
+		double sz=sqrt(z);
+		c=(1-cos(sz))/z;
+		s=(sz-sin(sz))/(z*sz);
+	}
+	else if(z<-0.01){
+		double sz=sqrt(-z);
+		c=(cosh(sz)-1)/(-z);
+		s=(sinh(sz)-sz)/(-z*sz);
+	}
+	else{
+		c=0.5-z*(1./24-z*(1./720-z*(1./40320-z*(1./3628800-z/479001600.))));
+		s=1./6-z*(1./120-z*(1./5040-z*(1./362880-z*(1./39916800-z/6227020800.))));
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Setting the number of objects
+//
+//Grows the arrays if needed; initial states, projected states and warm starts
+// of the first 'min(num,n)' objects are kept, new objects start cold
+///////////////////////////////////////////////////////////////////////////////
+void Kepler::resize(int num)
+{
+	int k(0);
+	if(num>capacity){
+		int cap=capacity?capacity:1;
+		while(cap<num) cap*=2;
+		double *grown=new double[KEPLER_NARRAY*cap];
+		int *flag_grown=new int[cap];
+		int *active_grown=new int[cap];
+		for(int a=0;a<KEPLER_NARRAY;a++)
+			for(k=0;k<n;k++) grown[a*cap+k]=block[a*capacity+k];
+		for(k=0;k<n;k++) flag_grown[k]=flag[k];
+		delete [] block;
+		delete [] flag;
+		delete [] active;
+		block=grown;
+		flag=flag_grown;
+		active=active_grown;
+		capacity=cap;
+
+		double **array[KEPLER_NARRAY]={&sx,&sy,&sz,&vx,&vy,&vz,&px,&py,&pz,&wx,&wy,&wz,
+			&tof,&chi,&tof_prev,&ro,&rvo,&alpha};
+		for(int a=0;a<KEPLER_NARRAY;a++) *array[a]=block+a*capacity;
+	}
+	for(k=n;k<num;k++){
+		sx[k]=sy[k]=sz[k]=vx[k]=vy[k]=vz[k]=0;
+		px[k]=py[k]=pz[k]=wx[k]=wy[k]=wz[k]=0;
+		tof[k]=chi[k]=tof_prev[k]=0;
+		flag[k]=0;
+	}
+	n=num;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Projecting all objects through their time of flight
+//
+//Universal Kepler equation in the universal anomaly x, z=alpha*x^2:
+//	sqrt(GM)*tof = rvo*x^2*c(z) + (1-alpha*ro)*x^3*s(z) + ro*x
+//whose derivative wrt x is the projected radius r. Newton sweeps run over
+// the objects not yet converged (|dx| < 1e-13*|x| + 1e-9). Start: warm from
+// the last solution, else sqrt(GM)*alpha*tof (ellipse) or sqrt(GM)*tof/ro.
+//Objects not converged after KEPLER_MAXITER sweeps get flag=1 and their
+// projected state is set to the initial state
+//
+//return output:
+//	number of objects not converged
+///////////////////////////////////////////////////////////////////////////////
+int Kepler::propagate()
+{
+	int k(0),i(0);
+	int nact(0);
+	double sqrt_gm=sqrt(GM);
+
+	//orbit constants and starting values
+	for(k=0;k<n;k++){
+		double r=sqrt(sx[k]*sx[k]+sy[k]*sy[k]+sz[k]*sz[k]);
+		double v2=vx[k]*vx[k]+vy[k]*vy[k]+vz[k]*vz[k];
+		ro[k]=r;
+		rvo[k]=(sx[k]*vx[k]+sy[k]*vy[k]+sz[k]*vz[k])/sqrt_gm;
+		alpha[k]=2/r-v2/GM;
+		if(tof_prev[k]!=0)
+			chi[k]*=tof[k]/tof_prev[k];
+		else if(alpha[k]>0)
+			chi[k]=sqrt_gm*alpha[k]*tof[k];
+		else
+			chi[k]=sqrt_gm*tof[k]/r;
+		flag[k]=1;
+		active[nact++]=k;
+	}
+	//Newton sweeps over the unconverged objects
+	iterations=0;
+	while(nact&&iterations<KEPLER_MAXITER){
+		iterations++;
+		int nnext(0);
+		for(i=0;i<nact;i++){
+			k=active[i];
+			double x=chi[k];
+			double x2=x*x;
+			double z=alpha[k]*x2;
+			double c(0),s(0);
+			kepler_stumpff(z,c,s);
+			double a1=1-alpha[k]*ro[k];
+			double t=rvo[k]*x2*c+a1*x2*x*s+ro[k]*x;
+			double r=rvo[k]*x*(1-z*s)+a1*x2*c+ro[k];
+			double dx=(sqrt_gm*tof[k]-t)/r;
+			chi[k]=x+dx;
+			if(fabs(dx)<1e-13*fabs(x)+1e-9)
+				flag[k]=0;
+			else
+				active[nnext++]=k;
+		}
+		nact=nnext;
+	}
+	//projected states by f and g functions
+	int nfail(0);
+	for(k=0;k<n;k++){
+		if(flag[k]||chi[k]!=chi[k]){
+			flag[k]=1;
+			nfail++;
+			tof_prev[k]=0;
+			px[k]=sx[k];py[k]=sy[k];pz[k]=sz[k];
+			wx[k]=vx[k];wy[k]=vy[k];wz[k]=vz[k];
+			continue;
+		}
+		double x=chi[k];
+		double x2=x*x;
+		double z=alpha[k]*x2;
+		double c(0),s(0);
+		kepler_stumpff(z,c,s);
+		double f=1-x2*c/ro[k];
+		double g=tof[k]-x2*x*s/sqrt_gm;
+		px[k]=f*sx[k]+g*vx[k];
+		py[k]=f*sy[k]+g*vy[k];
+		pz[k]=f*sz[k]+g*vz[k];
+		double r=sqrt(px[k]*px[k]+py[k]*py[k]+pz[k]*pz[k]);
+		double fd=sqrt_gm*x*(z*s-1)/(r*ro[k]);
+		double gd=1-x2*c/r;
+		wx[k]=fd*sx[k]+gd*vx[k];
+		wy[k]=fd*sy[k]+gd*vy[k];
+		wz[k]=fd*sz[k]+gd*vz[k];
+		tof_prev[k]=tof[k];
+	}
+	return nfail;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ////////////////////  Integration functions  //////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -31,6 +31,11 @@
 //	rayleigh
 //	uniform
 //	unituni
+// Design of experiments (DOE) sampling
+// GNSS constellation
+// Star catalog
+// Turbulence service
+// Batch Kepler propagation
 // Integration
 // US76 Atmosphere
 // US76 Atmosphere extended to 1000km (NASA Marshall)
@@ -461,6 +466,327 @@ double uniform(double min,double max);
 //Generating uniform random distribution between 0-1 based on C function rand()
 double unituni();
 
+///////////////////////////////////////////////////////////////////////////////
+//////////////////// Design of experiments (DOE) sampling /////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+//Selecting the DOE method of the static dispersions, called once before run 1
+//parameter input:
+//			method = "RANDOM", "LHS", "SOBOL" or "ANTITHETIC" (empty: "RANDOM")
+//			nmonte = number of MC runs
+//			seed = seed of the design ('iseed' of MONTE)
+void doe_initialize(const char *method,int nmonte,int seed);
+
+//Starting MC run 'nmc' (0,1,2,...) of the design; resets the dimension count
+void doe_run(int nmc);
+
+//Unit sample in (0,1) of the next dimension of the current run
+//Falls back to 'unituni()' if no design is selected
+double doe_unituni();
+
+//DOE counterparts of 'uniform()', 'gauss()', 'rayleigh()' and 'exponential()'
+double doe_uniform(double min,double max);
+double doe_gauss(double mean,double sig);
+double doe_rayleigh(double mode);
+double doe_exponential(double density);
+
+///////////////////////////////////////////////////////////////////////////////
+/////////////////////////// GNSS constellation ////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//Class 'Constellation'
+//
+//GNSS space vehicles (SVs) read from a Yuma almanac file keyed on GNSS_DECK
+// in 'input.asc'. GPS, Galileo, GLONASS and BeiDou SVs may be mixed in one file.
+//The Keplerian elements and the propagated states are kept as structure of
+// arrays (one contiguous block per quantity), so that propagation and
+// visibility are flat loops over all SVs without 'Matrix' temporaries
+///////////////////////////////////////////////////////////////////////////////
+class Constellation
+{
+private:
+	int nsv; //number of healthy SVs
+	int *prn; //SV identification number 'ID' of the almanac
+	double *block; //storage of all SV arrays below
+	//Keplerian elements
+	double *sma; //semi-major axis - m
+	double *smb; //semi-minor axis - m
+	double *ecc; //eccentricity - ND
+	double *mean_motion; //mean motion - rad/s
+	double *mean0; //mean anomaly at time of applicability - rad
+	double *toa; //time of applicability wrt the first SV of the almanac - s
+	double *raan0; //right ascension of ascending node at time of applicability - rad
+	double *raan_dot; //rate of right ascension - rad/s
+	double *sin_incl,*cos_incl; //inclination
+	double *sin_argp,*cos_argp; //argument of perigee
+	double max_motion; //largest mean motion - rad/s
+	//mean anomaly and right ascension at 'time_prop', advanced by 'propagate'
+	double *sin_m,*cos_m;
+	double *sin_o,*cos_o;
+	double time_prop; //time of last propagation - s
+	bool anchored; //=false: sin/cos pairs to be evaluated anew
+	//propagated inertial states - m, m/s
+	double *sx,*sy,*sz;
+	double *vx,*vy,*vz;
+	//unit vectors of user wrt the visible SVs, indexed like 'vis'
+	double *ux,*uy,*uz;
+	double zenith[3]; //unit vector of user position
+	//visible SVs
+	int *vis; int nvis;
+	bool *used; //SVs already picked by 'select', indexed like 'vis'
+
+public:
+	Constellation():nsv(0),prn(0),block(0),time_prop(0),anchored(false),vis(0),nvis(0),used(0){}
+	virtual ~Constellation(){delete [] prn;delete [] block;delete [] vis;delete [] used;}
+	//owns its arrays: not copyable
+	Constellation(const Constellation&)=delete;
+	Constellation &operator=(const Constellation&)=delete;
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Reading the healthy SVs of a Yuma almanac file
+	///////////////////////////////////////////////////////////////////////////////
+	void read_almanac(char *file_name);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Propagating all SVs to 'time' since almanac epoch
+	///////////////////////////////////////////////////////////////////////////////
+	void propagate(double time);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Forgetting the propagation of a previous run; the next one is anchored anew
+	///////////////////////////////////////////////////////////////////////////////
+	void reset(){time_prop=0;anchored=false;nvis=0;}
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Earth-occlusion test of all SVs; returns number of visible SVs
+	///////////////////////////////////////////////////////////////////////////////
+	int visibility(Matrix SBII,double radius);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Best-N subset of the visible SVs; returns GDOP of the subset
+	///////////////////////////////////////////////////////////////////////////////
+	double select(int nsel,int *sel);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Getting inertial position and velocity of SV 'k'
+	///////////////////////////////////////////////////////////////////////////////
+	void get_state(int k,double *ssii,double *vsii)
+	{
+		ssii[0]=sx[k];ssii[1]=sy[k];ssii[2]=sz[k];
+		vsii[0]=vx[k];vsii[1]=vy[k];vsii[2]=vz[k];
+	}
+
+	int get_nsv(){return nsv;}
+	int get_nvis(){return nvis;}
+	int get_prn(int k){return prn[k];}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+////////////////////////////// Star catalog ///////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//Class 'Starcatalog'
+//
+//Star unit vectors (J2000) in a declination-zone index: the sphere is cut
+// into 'nzone' declination bands and the stars of each band are sorted by
+// right ascension, so that a cone query visits only the bands it overlaps
+// and binary-searches their right ascension window
+//Stars keep their catalog slot# (1,2,3,... in file order) for output
+///////////////////////////////////////////////////////////////////////////////
+class Starcatalog
+{
+private:
+	int nstar; //number of stars
+	int *slot; //catalog slot# of the sorted stars
+	char *names; //star names, CHARN characters each
+	double *block; //storage of all star arrays below
+	double *ux,*uy,*uz; //unit vectors in J2000 coordinates
+	double *ra; //right ascension 0...2PI - rad
+	int nzone; //number of declination zones
+	int *zone_start; //first star of each zone (nzone+1 entries)
+	//stars in the field of regard
+	int *cand; int ncand;
+	char *in_for; //=1: star in field of regard
+	int *found; //buffer of cone query
+
+	void build(int n,const double *unit,const char *name_list);
+	int cone(const double *center,double cos_radius,int *list);
+
+public:
+	Starcatalog():nstar(0),slot(0),names(0),block(0),zone_start(0),cand(0),ncand(0),in_for(0),found(0){}
+	virtual ~Starcatalog()
+	{delete [] slot;delete [] names;delete [] block;delete [] zone_start;delete [] cand;delete [] in_for;delete [] found;}
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Loading 'n' stars from unit vectors unit[3*n] and names name_list[CHARN*n]
+	///////////////////////////////////////////////////////////////////////////////
+	void load(int n,const double *unit,const char *name_list){build(n,unit,name_list);}
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Reading a star catalog file: right ascension - deg, declination - deg, name
+	///////////////////////////////////////////////////////////////////////////////
+	void read_catalog(char *file_name);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Stars with cosine of angle from 'center' > 'cos_radius'; returns their number
+	///////////////////////////////////////////////////////////////////////////////
+	int field_of_regard(const double *center,double cos_radius);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Triad of the field of regard with maximum parallelepiped volume; returns volume
+	///////////////////////////////////////////////////////////////////////////////
+	double triad(int *tri);
+
+	void get_star(int k,double *usii){usii[0]=ux[k];usii[1]=uy[k];usii[2]=uz[k];}
+	int get_nstar(){return nstar;}
+	int get_slot(int k){return slot[k];}
+	const char *get_name(int k){return names+CHARN*k;}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/////////////////////////// Turbulence service ////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//Selecting seed ('iseed' of MONTE) and MC run 'nmc' of the turbulence fields,
+// called at the start of every run; vehicles bind their fields in order
+void turbulence_run(int seed,int nmc);
+
+///////////////////////////////////////////////////////////////////////////////
+//Class 'Turbulence'
+//
+//Frozen turbulence field (Taylor's hypothesis): gust velocity of unit variance
+// as function of the distance flown through the air mass, sampled every
+// correlation length/32 and linearly interpolated.
+//Because the field is a function of distance, its shaping filter does not
+// depend on airspeed and is discretized once:
+//	Dryden		exact discretization of the shaping filter (1+sqrt(3)Ls)/(1+Ls)^2,
+//				generated block by block as the vehicle advances
+//	von Karman	one periodic field of NTURB samples, white noise shaped
+//				by FFT with the von Karman spectrum
+//The white noise is drawn in batches from a stream seeded by (seed, MC run,
+// vehicle), independent of rand(), so a run is reproducible on its own.
+//With 'cache' set, the field is kept in file 'turb_<kind>_<seed>_<run>_<vehicle>.bin'
+// and read back by later campaigns with the same seed and correlation length
+///////////////////////////////////////////////////////////////////////////////
+class Turbulence
+{
+private:
+	int kind; //=0 not bound, =2 Dryden, =3 von Karman
+	double length; //correlation length - m
+	double dx; //sample spacing - m
+	int seed,nmc,vehicle; //key of the field
+	unsigned long long stream; //state of the white noise stream
+	double *field; int nfield; int capacity; //samples of unit variance
+	//Dryden filter: transition matrix, Cholesky factor of the process noise and state
+	double phi11,phi12,phi21,phi22;
+	double chol11,chol21,chol22;
+	double state1,state2;
+	bool cache; char cache_name[CHARL];
+
+	void white_noise(double *noise,int n);
+	void extend_dryden();
+	void shape_von_karman();
+	bool read_cache();
+	void write_cache();
+	void generate();
+
+public:
+	Turbulence():kind(0),field(0),nfield(0),capacity(0){}
+	virtual ~Turbulence(){delete [] field;}
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Binding the field of the next vehicle of the current run
+	///////////////////////////////////////////////////////////////////////////////
+	void bind(int kind,double length,bool cache);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Re-binding the field of a pooled vehicle to the current run, with the
+	// parameters of its last binding; not bound: nothing to do
+	///////////////////////////////////////////////////////////////////////////////
+	void rebind();
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Re-generating the bound field with new parameters, same key
+	///////////////////////////////////////////////////////////////////////////////
+	void regenerate(int kind,double length,bool cache);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Unit-variance gust velocity at distance 'dist' - m
+	///////////////////////////////////////////////////////////////////////////////
+	double sample(double dist);
+
+	int get_kind(){return kind;}
+	double get_length(){return length;}
+	bool get_cache(){return cache;}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////// Batch Kepler propagation ////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//Class 'Kepler'
+//
+//Projects many objects along Keplerian trajectories in one call, e.g. the
+// satellites of a constellation or the end states of a guidance predictor.
+//Universal-variable formulation (Bate, Mueller, White), valid for elliptic,
+// parabolic and hyperbolic orbits. The states are kept as structure of
+// arrays and Newton's iteration sweeps over all objects not yet converged.
+//Each object keeps its universal anomaly, which warm-starts the next call
+// (scaled by the ratio of the flight times), so repeated predictions from
+// slowly changing states converge in one or two iterations
+///////////////////////////////////////////////////////////////////////////////
+class Kepler
+{
+private:
+	int n; //number of objects
+	int capacity; //allocated number of objects
+	double *block; //storage of all arrays below
+	double *sx,*sy,*sz,*vx,*vy,*vz; //initial inertial states - m, m/s
+	double *px,*py,*pz,*wx,*wy,*wz; //projected inertial states - m, m/s
+	double *tof; //time of flight - s
+	double *chi; //universal anomaly of the last solution - m^0.5
+	double *tof_prev; //time of flight of the last solution, =0: no warm start - s
+	double *ro,*rvo,*alpha; //initial radius - m, s^v/sqrt(GM) - m^0.5, 1/semi-major axis - 1/m
+	int *flag; //=0 converged; =1 not converged
+	int *active; //objects not yet converged
+	int iterations; //Newton sweeps of the last call
+
+public:
+	Kepler():n(0),capacity(0),block(0),flag(0),active(0),iterations(0){}
+	virtual ~Kepler(){delete [] block;delete [] flag;delete [] active;}
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Setting the number of objects; keeps the warm starts of existing objects
+	///////////////////////////////////////////////////////////////////////////////
+	void resize(int num);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Loading initial state SBII(3), VBII(3) and time of flight of object 'k'
+	///////////////////////////////////////////////////////////////////////////////
+	void set_state(int k,const double *sbii,const double *vbii,double time_flight)
+	{
+		sx[k]=sbii[0];sy[k]=sbii[1];sz[k]=sbii[2];
+		vx[k]=vbii[0];vy[k]=vbii[1];vz[k]=vbii[2];
+		tof[k]=time_flight;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Projecting all objects; returns number of objects not converged
+	///////////////////////////////////////////////////////////////////////////////
+	int propagate();
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Getting projected state SPII(3), VPII(3) of object 'k'; returns its flag
+	///////////////////////////////////////////////////////////////////////////////
+	int get_state(int k,double *spii,double *vpii)
+	{
+		spii[0]=px[k];spii[1]=py[k];spii[2]=pz[k];
+		vpii[0]=wx[k];vpii[1]=wy[k];vpii[2]=wz[k];
+		return flag[k];
+	}
+
+	//cancelling the warm start of all objects
+	void reset(){for(int k=0;k<n;k++) tof_prev[k]=0;}
+	int get_size(){return n;}
+	int get_iterations(){return iterations;}
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 ////////////////////  Integration functions  //////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -131,6 +131,11 @@ Missile::Missile(Module *module_list,int num_modules,int num_target)
 	flat6_com_ind=new int[flat6_com_count];
 	missile_com_ind=new int[missile_com_count];
 
+	//allocating memory for the output plans
+	scrn_plan=new Output[flat6_scrn_count+missile_scrn_count];
+	plot_plan=new Output[flat6_plot_count+missile_plot_count];
+	com_plan=new Output[flat6_com_count+missile_com_count];
+
 	//allocating memory for the 'grnd_range' array
 	grnd_range=new double[num_target];
 
@@ -180,6 +185,9 @@ Missile::~Missile()
 	delete [] missile_plot_ind;
 	delete [] flat6_com_ind;
 	delete [] missile_com_ind;
+	delete [] scrn_plan;
+	delete [] plot_plan;
+	delete [] com_plan;
 	delete [] grnd_range;
 	delete [] &event_ptr_list;
 }
@@ -238,6 +246,9 @@ Target::Target(Module *module_list,int num_modules)
 	flat3_com_ind=new int[flat3_com_count];
 	if(!flat3_com_count){cerr<<"*** Error: flat3_com_count[] allocation failed *** \n";system("pause");exit(1);}
 	target_com_ind=new int[target_com_count];
+
+	//allocating memory for the output plan
+	com_plan=new Output[flat3_com_count+target_com_count];
 	if(!target_com_count){cerr<<"*** Error: target_com_count[] allocation failed *** \n";system("pause");exit(1);}
 	com_target3=new Variable[ncom_target3];
 	if(!com_target3){cerr<<"*** Error: com_missile6[] allocation failed *** \n";system("pause");exit(1);}
@@ -259,6 +270,7 @@ Target::~Target()
 	delete [] flat3;
 	delete [] flat3_com_ind;
 	delete [] target_com_ind;
+	delete [] com_plan;
 	delete [] com_target3;
 }
 
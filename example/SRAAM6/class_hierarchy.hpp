@@ -258,6 +258,11 @@ protected:
 	//be written to 'combus' 'packets'
 	int *missile_com_ind; int missile_com_count;
 
+	//output plans compiled by the index arrays and executed by the writers
+	Output *scrn_plan; int nscrn_plan;
+	Output *plot_plan; int nplot_plan;
+	Output *com_plan; int ncom_plan;
+
 	//array of ground distances of 'Missile' object from all 'Target' objects
 	double *grnd_range;
 
@@ -438,6 +443,9 @@ protected:
 	//be written to 'combus' 'packets'
 	int *target_com_ind; int target_com_count;
 
+	//output plan of 'com' compiled by 'com_index_arrays()', executed by 'traj_data()'
+	Output *com_plan; int ncom_plan;
+
 public:
 	Target(){};
 	Target(Module *module_list,int num_modules);
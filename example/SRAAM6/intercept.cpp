@@ -24,8 +24,7 @@ void Missile::def_intercept()
 	missile[654].init("MISS_L",0,0,0,"Miss vector in local level coord. - m","intercept","diag","");
 	missile[655].init("time_m",0,"Previous time - s","intercept","save","");
 	missile[656].init("SBTLM",0,0,0,"Previous displacment vector. - m","intercept","save","");
-	missile[657].init("STMEL",0,0,0,"Previous aircraft taget displacment vector. - m","intercept","save","");
-	missile[658].init("SBMEL",0,0,0,"Previous missile displacment vector. - m","intercept","save","");
+	missile[657].init("VBTLM",0,0,0,"Previous velocity of missile wrt target - m/s","intercept","save","");
 	missile[659].init("mode","int",0,"Mode flags |mseek|mguid|maut|mprop|  - ND","intercept","diag","scrn");
 
 }
@@ -71,12 +70,15 @@ void Missile::intercept(Packet *combus,int vehicle_slot,double int_step,char *ti
 	int write=missile[651].integer();
 	double time_m=missile[655].real();
 	Matrix SBTLM=missile[656].vec();
-	Matrix STMEL=missile[657].vec();
-	Matrix SBMEL=missile[658].vec();
+	Matrix VBTLM=missile[657].vec();
 	//-------------------------------------------------------------------------
 	//trajectory mode flags
 	mode=1000*mseek+100*mguid+10*maut+mprop;
 
+	//a target later in 'combus' has not yet been integrated in this cycle;
+	//propagating it to the missile time, so that both bracketing states are simultaneous
+	if(tgt_com_slot>vehicle_slot) STEL=STEL+VTEL*int_step;
+
 	//LOS geometry
 	Matrix STBL=STEL-SBEL;
 	Matrix STBB=TBL*STBL;
@@ -114,35 +116,39 @@ void Missile::intercept(Packet *combus,int vehicle_slot,double int_step,char *ti
 	//Seeker/pronav
 	if(mseek>=3)
 	{
+		//relative velocity
+		Matrix VTBL=VTEL-VBEL;
+
+		//missile wrt target
+		Matrix SBTL=STBL*(-1);
+		Matrix VBTL=VTBL*(-1);
+
 		//entering sphere of target influence of 100m 
 		if(dbt<100)
 		{		
 			//unit LOS vector
 			Matrix UTBL=STBL*(1./dbt);
 
-			//relative velocity
-			Matrix VTBL=VTEL-VBEL;
-
 			//closing speed on target
 			double closing_speed=UTBL^VTBL;
 			
 			//Intercept (closing speed becomes negative)
-			//Miss is closest distance between missile and target points; obtained by linear interpolation
-			//between integration steps
-			Matrix SBTL=STBL*(-1);
+			//Miss is closest distance between missile and target points; obtained from the cubic
+			//relative trajectory between integration steps
 			if((closing_speed>0)&&write)
 			{
 				write=0;
 
-				Matrix SBBML=SBEL-SBMEL;
-				Matrix STTML=STEL-STMEL;
-
-				//intercept time at point of closest approach
-				hit_time=time_m-int_step*((SBBML-STTML)^SBTLM)/(SBBML^SBBML);
-
-				//miss distance vector in geographic coordinates
-				double tau=hit_time-time_m;
-				MISS_L=(SBBML-STTML)*(tau/int_step)+SBTLM;
+				//intercept time and miss distance vector at point of closest approach;
+				//without a previous step, the miss at the current step
+				if(time_m>0){
+					double tau=closest_approach(MISS_L,SBTLM,VBTLM,SBTL,VBTL,time-time_m);
+					hit_time=time_m+tau;
+				}
+				else{
+					MISS_L=SBTL;
+					hit_time=time;
+				}
 				miss=MISS_L.absolute();
 
 				//getting missile # and target #
@@ -161,12 +167,11 @@ void Missile::intercept(Packet *combus,int vehicle_slot,double int_step,char *ti
 				combus[tgt_com_slot].set_status(0);
 				combus[vehicle_slot].set_status(0);
 			}
-			//save from previous cycle
-			SBTLM=SBTL;
-			STMEL=STEL;
-			SBMEL=SBEL;
-			time_m=time;
 		}
+		//save from previous cycle
+		SBTLM=SBTL;
+		VBTLM=VBTL;
+		time_m=time;
 	}//end of seeker/pronav
 	//-------------------------------------------------------------------------
 	//loading module-variables
@@ -175,8 +180,7 @@ void Missile::intercept(Packet *combus,int vehicle_slot,double int_step,char *ti
 	missile[653].gets(hit_time);
 	missile[655].gets(time_m);
 	missile[656].gets_vec(SBTLM);
-	missile[657].gets_vec(STMEL);
-	missile[658].gets_vec(SBMEL);
+	missile[657].gets_vec(VBTLM);
 	//diagnostics
 	missile[652].gets(miss);
 	missile[654].gets_vec(MISS_L);
@@ -175,6 +175,22 @@ void Target::com_index_arrays()
 			l++;
 		}
 	}
+
+	//loading the definitions into 'com_target3' once and compiling its output plan
+	int column(0);
+	ncom_plan=0;
+	for(i=0;i<flat3_com_count;i++)
+	{
+		com_target3[ncom_plan]=flat3[flat3_com_ind[i]];
+		com_plan[ncom_plan]=com_target3[ncom_plan].output(column);
+		ncom_plan++;
+	}
+	for(i=0;i<target_com_count;i++)
+	{
+		com_target3[ncom_plan]=target[target_com_ind[i]];
+		com_plan[ncom_plan]=com_target3[ncom_plan].output(column);
+		ncom_plan++;
+	}
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Initializing loading 'packet' of target
@@ -202,17 +218,18 @@ Packet Target::loading_packet_init(int num_missile,int num_target)
 	for(i=0;i<flat3_com_count;i++)
 	{
 		index=flat3_com_ind[i];
-		com_target3[i]=flat3[index];
+		com_target3[i].restore(flat3[index]);
 	}
 	for(j=0;j<target_com_count;j++)
 	{
 		index=target_com_ind[j];
-		com_target3[i+j]=target[index];
+		com_target3[i+j].restore(target[index]);
 	}
 	//refreshing the packet
 	packet.set_id(id);
 	packet.set_status(1);
 	packet.set_data(com_target3);
+	packet.set_plan(com_plan);
 	packet.set_ndata(ncom_target3);
 
 	return packet;
@@ -243,12 +260,12 @@ Packet Target::loading_packet(int num_missile,int num_target)
 	for(i=0;i<flat3_com_count;i++)
 	{
 		index=flat3_com_ind[i];
-		com_target3[i]=flat3[index];
+		com_target3[i].restore(flat3[index]);
 	}
 	for(j=0;j<target_com_count;j++)
 	{
 		index=target_com_ind[j];
-		com_target3[i+j]=target[index];
+		com_target3[i+j].restore(target[index]);
 	}
 	//refreshing the packet
 	packet.set_data(com_target3);
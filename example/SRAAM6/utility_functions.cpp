@@ -7,6 +7,7 @@
 //		    mat3tr
 //			sign
 //			angle
+// Closest point of approach
 // Table look-up
 // Integration
 // US76 Atmosphere
@@ -1157,6 +1158,88 @@ double angle(Matrix VEC1,Matrix VEC2)
 
 	return acos(argument);
 }
+///////////////////////////////////////////////////////////////////////////////
+////////////////////////// Closest point of approach //////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//Returns the time of closest approach of two points within an integration step
+//
+//The relative position and velocity are known at the beginning (SREL0,VREL0)
+// and at the end (SREL1,VREL1) of the step 'step'. A cubic Hermite polynomial
+// joins them; the closest approach is the root of SREL^VREL=0 in the step,
+// obtained by Newton iterations safeguarded by bisection
+//
+//Parameter output: MISS(3x1) = relative position at closest approach
+//Example: tau=closest_approach(MISS,SBTLM,VBTLM,SBTL,VBTL,time-time_m);
+///////////////////////////////////////////////////////////////////////////////
+double closest_approach(Matrix &MISS,Matrix SREL0,Matrix VREL0,Matrix SREL1,Matrix VREL1
+						,const double &step)
+{
+	double A[3],B[3],C[3],D[3];
+	double S[3],SD[3];
+	double x(0);
+	double lo(0);
+	double hi(1);
+	int i(0);
+
+	double *s0=SREL0.get_pbody();
+	double *v0=VREL0.get_pbody();
+	double *s1=SREL1.get_pbody();
+	double *v1=VREL1.get_pbody();
+
+	//polynomial SREL(x)=A+B*x+C*x^2+D*x^3 with x=t/step in [0,1]
+	for(i=0;i<3;i++)
+	{
+		A[i]=s0[i];
+		B[i]=v0[i]*step;
+		C[i]=3*(s1[i]-s0[i])-2*B[i]-v1[i]*step;
+		D[i]=2*(s0[i]-s1[i])+B[i]+v1[i]*step;
+	}
+	double g0=A[0]*B[0]+A[1]*B[1]+A[2]*B[2];
+	double g1=(s1[0]*v1[0]+s1[1]*v1[1]+s1[2]*v1[2])*step;
+
+	if(g0>=0) x=0;
+	else if(g1<=0) x=1;
+	else
+	{
+		//starting from the closest approach of the straight line
+		double dss(0),sds(0);
+		for(i=0;i<3;i++)
+		{
+			dss+=(s1[i]-s0[i])*(s1[i]-s0[i]);
+			sds+=s0[i]*(s1[i]-s0[i]);
+		}
+		x=0.5;
+		if(dss>0) x=-sds/dss;
+		if(x<=lo||x>=hi) x=0.5;
+
+		for(int iter=0;iter<50;iter++)
+		{
+			double g(0),dg(0);
+			for(i=0;i<3;i++)
+			{
+				S[i]=A[i]+x*(B[i]+x*(C[i]+x*D[i]));
+				SD[i]=B[i]+x*(2*C[i]+x*3*D[i]);
+				g+=S[i]*SD[i];
+				dg+=SD[i]*SD[i]+S[i]*(2*C[i]+6*D[i]*x);
+			}
+			if(g<0) lo=x;
+			else hi=x;
+
+			double x_new=(lo+hi)/2;
+			if(dg>0)
+			{
+				x_new=x-g/dg;
+				if(x_new<=lo||x_new>=hi) x_new=(lo+hi)/2;
+			}
+			if(fabs(x_new-x)<EPS) {x=x_new;break;}
+			x=x_new;
+		}
+	}
+	for(i=0;i<3;i++)
+		MISS.assign_loc(i,0,A[i]+x*(B[i]+x*(C[i]+x*D[i])));
+
+	return x*step;
+}
 
 ///////////////////////////////////////////////////////////////////////////////
 //////////////// Table look-up and interpolation functions ////////////////////
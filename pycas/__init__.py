@@ -17,6 +17,7 @@ Key Features:
 - Framework adaptation layer (Vehicle → Ball/Rocket/Missile)
 - Input file generation with type checking
 - Compilation and execution orchestration
+- Parallel parameter sweeps with isolated per-case workspaces
 - Trajectory comparison for regression testing
 
 Example Usage:
@@ -25,7 +26,6 @@ Example Usage:
     # Build a ballistic simulation from fundamental components
     sim = Simulation("BALL3_test")
     sim.add_component(Component.kinematics_3dof_flat())
-    sim.add_component(Component.forces_3dof())
     sim.add_component(Component.drag_simple(cd=0.47, area=0.0314))
     sim.add_component(Component.gravity_constant())
     sim.add_component(Component.atmosphere_constant())
@@ -46,7 +46,8 @@ from .component import Component
 from .simulation import Simulation
 from .compiler import Compiler
 from .runner import Runner
-from .trajectory import Trajectory, TrajectoryComparator
+from .trajectory import Trajectory, TrajectoryComparator, TrajectoryReader, ErrorStats
+from .sweep import Sweep, Batch, SweepResults
 
 __all__ = [
     'ComponentRegistry',
@@ -56,6 +57,11 @@ __all__ = [
     'Runner',
     'Trajectory',
     'TrajectoryComparator',
+    'TrajectoryReader',
+    'ErrorStats',
+    'Sweep',
+    'Batch',
+    'SweepResults',
 ]
 
 __version__ = '0.1.0'
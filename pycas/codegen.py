@@ -0,0 +1,384 @@
+"""
+Code Generator - Assembles component sources into one CADAC simulation
+
+Every component in components/ is written against a generic 'Vehicle' class
+with a 'vehicle[]' module-variable array, and alternative components reuse the
+same module function names (e.g. both gravity_constant and atmosphere_constant
+define 'def_environment()'/'environment()'). The generator
+
+  - renames each component's module functions after the component
+    (def_<comp>, init_<comp>, <comp>) and prefixes its helper functions,
+  - links module-variables by name into one dense 'ball[]' array of the
+    BALL3 framework (see linker.py),
+  - emits the module schedule as straight-line calls in MODULES order, so the
+    executive no longer dispatches on module names at run time,
+  - writes a single translation unit per simulation, built with LTO.
+"""
+
+import re
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+from .component import Component
+from .linker import ComponentManifest, LinkMap, Linker
+
+# Executive taken from the BALL3 example
+FRAMEWORK_DIR = Path(__file__).parent.parent / 'example' / 'BALL3'
+FRAMEWORK_HEADERS = ['global_constants.hpp', 'global_header.hpp']
+FRAMEWORK_SOURCES = ['utility_functions.cpp', 'global_functions.cpp', 'class_functions.cpp',
+                     'ball_functions.cpp', 'execution.cpp']
+
+# Utility library taken from ROCKET6G: a superset of BALL3's that adds the
+# WGS84, Kepler and stochastic functions used by the 6DoF components
+UTILITY_DIR = Path(__file__).parent.parent / 'example' / 'ROCKET6G'
+UTILITY_FILES = ['utility_header.hpp', 'utility_functions.cpp']
+_CONSTANT_RE = re.compile(r'^(?:const\s+(?:double|int)|(?:double|int)\s+const)\s+(\w+)\s*=.*$',
+                          re.MULTILINE)
+
+# Arguments the executive can supply to lifecycle functions, by parameter name
+EXECUTIVE_ARGS = ('sim_time', 'event_time', 'int_step', 'out_fact')
+
+_FUNCTION_RE = re.compile(
+    r'^([A-Za-z_][\w \t\*&]*?)[ \t]*\bVehicle::(\w+)\s*\(([^)]*)\)\s*(?=\{)', re.MULTILINE)
+_SLOT_RE = re.compile(r'\bvehicle\[(\d+)\]')
+_MODULE_LOOP_RE = re.compile(
+    r'for\s*\(\s*(?:int\s+)?j\s*=\s*0\s*;\s*j\s*<\s*num_modules\s*;\s*j\+\+\s*\)\s*\{[^{}]*\}')
+
+
+class CodegenError(Exception):
+    """Raised when the selected components cannot be assembled"""
+
+
+@dataclass
+class ComponentFunction:
+    """A member function defined in a component source"""
+    ret: str
+    name: str
+    params: str
+    body: str
+
+    @property
+    def param_names(self) -> List[str]:
+        """Names of the formal parameters"""
+        names = []
+        for param in self.params.split(','):
+            match = re.search(r'(\w+)\s*$', param.strip())
+            if match and param.strip() != 'void':
+                names.append(match.group(1))
+        return names
+
+
+@dataclass
+class ComponentSource:
+    """Parsed component source file"""
+    name: str
+    path: Path
+    text: str
+    functions: Dict[str, ComponentFunction]
+
+    def_function: Optional[str] = None
+    init_function: Optional[str] = None
+    exec_function: Optional[str] = None
+    helpers: List[str] = field(default_factory=list)
+
+    @classmethod
+    def parse(cls, name: str, path: Path) -> 'ComponentSource':
+        """Parse the member functions of a component"""
+        text = path.read_text()
+        functions = {}
+        for match in _FUNCTION_RE.finditer(text):
+            ret, fname, params = match.group(1).strip(), match.group(2), match.group(3)
+            body = _braced(text, match.end())
+            if body is None:
+                raise CodegenError(f"{path.name}: unbalanced braces in {fname}()")
+            functions[fname] = ComponentFunction(ret, fname, ' '.join(params.split()), body)
+
+        source = cls(name, path, text, functions)
+        defs = [f for f in functions if f.startswith('def_')]
+        if len(defs) != 1:
+            raise CodegenError(f"{path.name}: expected one def_ function, found {defs}")
+        source.def_function = defs[0]
+        stem = defs[0][4:]
+        init = [f for f in functions if f.startswith('init_')]
+        source.init_function = init[0] if init else None
+        for candidate in (stem, name):
+            if candidate in functions:
+                source.exec_function = candidate
+                break
+        if source.exec_function is None:
+            raise CodegenError(f"{path.name}: no module function '{stem}()' or '{name}()'")
+        lifecycle = {source.def_function, source.init_function, source.exec_function}
+        source.helpers = [f for f in functions if f not in lifecycle]
+        return source
+
+    def renamed(self, function: str) -> str:
+        """Name of a function in the assembled vehicle class"""
+        if function == self.def_function:
+            return f"def_{self.name}"
+        if function == self.init_function:
+            return f"init_{self.name}"
+        if function == self.exec_function:
+            return self.name
+        return f"{self.name}_{function}"
+
+
+class CodeGenerator:
+    """Generates the sources of a simulation assembled from components"""
+
+    def __init__(self, components_dir: Optional[Path] = None,
+                 framework_dir: Optional[Path] = None, utility_dir: Optional[Path] = None):
+        self.components_dir = Path(components_dir) if components_dir else \
+            Path(__file__).parent.parent / 'components'
+        self.framework_dir = Path(framework_dir) if framework_dir else FRAMEWORK_DIR
+        self.utility_dir = Path(utility_dir) if utility_dir else UTILITY_DIR
+
+    def find_component_file(self, comp_name: str) -> Optional[Path]:
+        """Find component source file"""
+        for cpp_file in self.components_dir.rglob(f"{comp_name}.cpp"):
+            return cpp_file
+        return None
+
+    def generate(self, simulation_name: str, components: List[Component]) -> Dict[str, str]:
+        """
+        Generate all sources of the simulation
+
+        Args:
+            simulation_name: Name of simulation (used in banners)
+            components: Components in module execution order
+
+        Returns:
+            Mapping of file name -> content; 'simulation.cpp' is the only
+            translation unit, everything else is included by it
+
+        Raises:
+            CodegenError: If a component cannot be parsed or assembled
+            LinkError: If the module-variable dataflow is inconsistent
+        """
+        sources, manifests, link_map = self.link(components)
+
+        files = {}
+        for source, manifest in zip(sources, manifests):
+            files[f"comp_{source.name}.cpp"] = self._rewrite_component(source, manifest, link_map)
+
+        files['modules.cpp'] = self._schedule(simulation_name, components, sources, link_map)
+        files.update(self._framework(sources, link_map))
+        files['simulation.cpp'] = self._unity(simulation_name, sources)
+        return files
+
+    def link(self, components: List[Component]) -> Tuple[List[ComponentSource],
+                                                         List[ComponentManifest], LinkMap]:
+        """
+        Parse the components and link their module-variables
+
+        Args:
+            components: Components in module execution order
+
+        Returns:
+            Parsed sources, manifests and the slot layout
+
+        Raises:
+            CodegenError: If a component cannot be found or parsed
+            LinkError: If the module-variable dataflow is inconsistent
+        """
+        sources = []
+        for comp in components:
+            path = self.find_component_file(comp.name)
+            if path is None:
+                raise CodegenError(f"Component source not found: {comp.name}.cpp")
+            sources.append(ComponentSource.parse(comp.name, path))
+
+        manifests = [ComponentManifest.from_source(source) for source in sources]
+        link_map = Linker().link(manifests, [comp.enabled_lifecycle for comp in components])
+        return sources, manifests, link_map
+
+    def _rewrite_component(self, source: ComponentSource, manifest: ComponentManifest,
+                           link_map: LinkMap) -> str:
+        """Rename functions and remap slots of one component"""
+        text = source.text
+        for helper in source.helpers:
+            text = re.sub(rf'(?<![\w:]){helper}\s*\(', f"{source.renamed(helper)}(", text)
+        for fname in source.functions:
+            text = re.sub(rf'\bVehicle::{fname}\s*\(', f"Ball::{source.renamed(fname)}(", text)
+
+        def remap(match):
+            return f"ball[{link_map.slot(manifest.slot_names[int(match.group(1))])}]"
+
+        # The header block documents the component's own slot numbers; keep it as is
+        body_start = max(text.find('#include'), 0)
+        header, body = text[:body_start], text[body_start:]
+        body = _SLOT_RE.sub(remap, body)
+        body = body.replace('#include "class_hierarchy.hpp"', '')
+        return f"//Generated from {source.path.name} by pycas - do not edit\n" + header + body
+
+    def _call(self, source: ComponentSource, function: str) -> str:
+        """Statement calling a lifecycle function with executive arguments"""
+        func = source.functions[function]
+        for arg in func.param_names:
+            if arg not in EXECUTIVE_ARGS:
+                raise CodegenError(
+                    f"{source.path.name}: {function}() takes '{arg}', executive supplies "
+                    f"only {', '.join(EXECUTIVE_ARGS)}")
+        return f"\t{source.renamed(function)}({','.join(func.param_names)});"
+
+    def _schedule(self, simulation_name: str, components: List[Component],
+                  sources: List[ComponentSource], link_map: LinkMap) -> str:
+        """Static module schedule: def, init and exec calls in MODULES order"""
+        defs, inits, execs = [], [], []
+        for comp, source in zip(components, sources):
+            lifecycle = comp.enabled_lifecycle
+            if 'def' in lifecycle:
+                defs.append(self._call(source, source.def_function))
+            if 'init' in lifecycle:
+                if source.init_function is None:
+                    raise CodegenError(f"{comp.name}: 'init' enabled but component has no init_ function")
+                inits.append(self._call(source, source.init_function))
+            if 'exec' in lifecycle:
+                execs.append(self._call(source, source.exec_function))
+
+        layout = '\n'.join(f"//  {line}" for line in link_map.layout())
+        return f"""///////////////////////////////////////////////////////////////////////////////
+//FILE: 'modules.cpp'
+//
+//Module schedule of simulation '{simulation_name}', generated by pycas
+//Modules are called in the sequence of the MODULES block
+//
+//Module-variable layout (slot, name - owning module):
+{layout}
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+//Defining the module-variables of all modules
+//Member function of class 'Ball'
+///////////////////////////////////////////////////////////////////////////////
+void Ball::def_modules()
+{{
+	event_time=0;
+{chr(10).join(defs)}
+}}
+
+///////////////////////////////////////////////////////////////////////////////
+//Initial calculations of all modules
+//Member function of class 'Ball'
+///////////////////////////////////////////////////////////////////////////////
+void Ball::init_modules(double sim_time,double int_step)
+{{
+	double out_fact(0);
+{chr(10).join(inits)}
+}}
+
+///////////////////////////////////////////////////////////////////////////////
+//Executing all modules for one integration step
+//Member function of class 'Ball'
+///////////////////////////////////////////////////////////////////////////////
+void Ball::exec_modules(double sim_time,double int_step)
+{{
+	double out_fact(0);
+	if(event_epoch) event_time=0;
+{chr(10).join(execs)}
+	event_time+=int_step;
+}}
+"""
+
+    def _framework(self, sources: List[ComponentSource], link_map: LinkMap) -> Dict[str, str]:
+        """Framework headers and sources adapted to the generated module schedule"""
+        files = {}
+        for name in FRAMEWORK_HEADERS + FRAMEWORK_SOURCES:
+            files[name] = (self.framework_dir / name).read_text()
+        for name in UTILITY_FILES:
+            files[name] = (self.utility_dir / name).read_text()
+        files['global_constants.hpp'] = self._global_constants(files['global_constants.hpp'], link_map)
+
+        files['class_functions.cpp'], count = _MODULE_LOOP_RE.subn(
+            'def_modules();', files['class_functions.cpp'])
+        self._check_patch('class_functions.cpp', count, 1)
+
+        # Loops in main(): init functions and (empty) termination functions;
+        # loop in execute(): the modules of one integration step
+        loops = ['vehicle_list[i]->init_modules(sim_time,int_step);',
+                 '//termination is handled by the modules',
+                 'vehicle_list[i]->exec_modules(sim_time,int_step);']
+        self._check_patch('execution.cpp', len(_MODULE_LOOP_RE.findall(files['execution.cpp'])), 3)
+        replacements = iter(loops)
+        files['execution.cpp'] = _MODULE_LOOP_RE.sub(lambda m: next(replacements), files['execution.cpp'])
+
+        files['class_hierarchy.hpp'] = self._class_hierarchy(sources)
+        return files
+
+    def _global_constants(self, text: str, link_map: LinkMap) -> str:
+        """BALL3 constants sized for the slot map, plus those the utility library needs"""
+        text, count = re.subn(r'const int NBALL=\d+;', f'const int NBALL={link_map.size};', text)
+        self._check_patch('global_constants.hpp', count, 1)
+
+        defined = set(_CONSTANT_RE.findall(text))
+        utility = (self.utility_dir / 'global_constants.hpp').read_text()
+        missing = [m.group(0) for m in _CONSTANT_RE.finditer(utility) if m.group(1) not in defined]
+        end = text.rindex('#endif')
+        return (text[:end] + "//constants of the utility library\n" +
+                '\n'.join(missing) + '\n' + text[end:])
+
+    def _class_hierarchy(self, sources: List[ComponentSource]) -> str:
+        """Class hierarchy with the module functions of the selected components"""
+        text = (self.framework_dir / 'class_hierarchy.hpp').read_text()
+        blocks = list(re.finditer(r'(\t//module functions\n)(.*?)(?=\n\};)', text, re.DOTALL))
+        self._check_patch('class_hierarchy.hpp', len(blocks), 2)
+
+        cadac = ("\tvirtual void def_modules()=0;\n"
+                 "\tvirtual void init_modules(double sim_time,double int_step)=0;\n"
+                 "\tvirtual void exec_modules(double sim_time,double int_step)=0;")
+        ball = ["\tvirtual void def_modules();",
+                "\tvirtual void init_modules(double sim_time,double int_step);",
+                "\tvirtual void exec_modules(double sim_time,double int_step);",
+                "",
+                "\t//time elapsed in current event",
+                "\tdouble event_time;"]
+        for source in sources:
+            ball.append("")
+            ball.append(f"\t//{source.name}")
+            for func in source.functions.values():
+                ball.append(f"\t{func.ret} {source.renamed(func.name)}({func.params});")
+
+        # Replace from the back so the first match offsets stay valid
+        for match, body in reversed(list(zip(blocks, [cadac, '\n'.join(ball)]))):
+            text = text[:match.start(2)] + body + text[match.end(2):]
+        return text
+
+    def _unity(self, simulation_name: str, sources: List[ComponentSource]) -> str:
+        """The single translation unit of the simulation"""
+        lines = [
+            "///////////////////////////////////////////////////////////////////////////////",
+            f"//FILE: 'simulation.cpp'",
+            "//",
+            f"//Single translation unit of simulation '{simulation_name}', generated by pycas",
+            "//Framework, components and module schedule are compiled together so that",
+            "//module calls can be inlined across components",
+            "///////////////////////////////////////////////////////////////////////////////",
+            "",
+            '#include "class_hierarchy.hpp"',
+            "",
+            "//framework",
+        ]
+        lines += [f'#include "{name}"' for name in FRAMEWORK_SOURCES]
+        lines += ["", "//components"]
+        lines += [f'#include "comp_{source.name}.cpp"' for source in sources]
+        lines += ["", "//module schedule", '#include "modules.cpp"', ""]
+        return '\n'.join(lines)
+
+    @staticmethod
+    def _check_patch(name: str, count: int, expected: int):
+        if count != expected:
+            raise CodegenError(
+                f"Framework file {name} changed: expected {expected} patch site(s), found {count}")
+
+
+def _braced(text: str, start: int) -> Optional[str]:
+    """Text of the brace block opening at 'start', braces included"""
+    depth = 0
+    for pos in range(start, len(text)):
+        if text[pos] == '{':
+            depth += 1
+        elif text[pos] == '}':
+            depth -= 1
+            if depth == 0:
+                return text[start:pos + 1]
+    return None
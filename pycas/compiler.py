@@ -1,106 +1,202 @@
 """
 Compiler - Compiles CADAC simulations
+
+Builds are content-addressed: the generated simulation sources, the compiler
+flags and the toolchain version are hashed into a cache key. Executables are stored under a cache directory shared by all processes,
+so a cache hit skips the C++ compiler entirely.
 """
 
+import hashlib
+import json
+import os
+import shutil
 import subprocess
+import tempfile
 from pathlib import Path
-from typing import List
+from typing import Dict, List, Optional, Union
+
+from .codegen import CodeGenerator, CodegenError, ComponentSource
+from .linker import LinkError
+from .component import Component
 
 
 class Compiler:
     """Compiles CADAC C++ simulations"""
 
-    def __init__(self, working_dir: Path):
+    # Compiler settings (the example Makefiles plus link-time optimization)
+    CXX = 'g++'
+    CXXFLAGS = ['-std=c++11', '-O2', '-flto', '-Wno-write-strings']
+    LDFLAGS: List[str] = []
+
+    # Single translation unit produced by the code generator
+    UNIT = 'simulation.cpp'
+
+    # Name of the executable inside a cache entry
+    EXECUTABLE = 'ball3'
+
+    def __init__(self, working_dir: Path, cache_dir: Optional[Path] = None):
+        """
+        Initialize compiler
+
+        Args:
+            working_dir: Simulation working directory (executable is linked into working_dir/build)
+            cache_dir: Build cache directory (default: $PYCAS_CACHE_DIR or ~/.cache/pycas/build)
+        """
         self.working_dir = Path(working_dir)
-        self.components_dir = Path(__file__).parent.parent / 'components'
+        self.generator = CodeGenerator()
+        self.framework_dir = self.generator.framework_dir
+        self.cxx = os.environ.get('CXX', self.CXX)
+        self._toolchain: Optional[str] = None
+
+        if cache_dir is None:
+            cache_dir = os.environ.get('PYCAS_CACHE_DIR',
+                                       Path.home() / '.cache' / 'pycas' / 'build')
+        self.cache_dir = Path(cache_dir)
 
-    def compile(self, simulation_name: str, components: List[str]) -> Path:
+    def compile(self, simulation_name: str, components: List[Union[str, Component]]) -> Path:
         """
         Compile simulation executable
 
-        For now, this uses the existing BALL3 example as a base.
-        Future: Full compilation from modular components (see test_ball3_regression.py)
+        The components are assembled onto the BALL3 framework by the code
+        generator (see codegen.py). The build is looked up in the cache first;
+        on a miss the generated translation unit is compiled and the result is
+        published to the cache atomically so concurrent processes never see a
+        partial entry.
 
         Args:
             simulation_name: Name of simulation
-            components: List of component names to include
+            components: Components (or component names) in module execution order
 
         Returns:
             Path to compiled executable
 
         Raises:
-            RuntimeError: If compilation fails
+            RuntimeError: If code generation or compilation fails
         """
-        # Use existing BALL3 example for now
-        example_dir = self.components_dir.parent / 'example' / 'BALL3'
-        if not example_dir.exists():
-            raise RuntimeError(
-                f"BALL3 example not found at {example_dir}. "
-                "Full compilation from components requires framework adaptation. "
-                "See tests/regression/test_ball3_regression.py for proper implementation."
-            )
-
-        # Build BALL3 example
-        print(f"  Using existing BALL3 example for compilation...")
-        result = subprocess.run(
-            ['make'],
-            cwd=example_dir,
-            capture_output=True,
-            text=True
-        )
-
-        if result.returncode != 0:
-            raise RuntimeError(f"BALL3 compilation failed:\n{result.stderr}")
-
-        # Return path to executable
-        executable = example_dir / 'ball3'
-        if not executable.exists():
-            raise RuntimeError(f"Executable not found: {executable}")
+        if not self.framework_dir.exists():
+            raise RuntimeError(f"BALL3 framework not found at {self.framework_dir}")
+
+        components = [self._as_component(c) for c in components]
+        try:
+            sources = self.generator.generate(simulation_name, components)
+        except CodegenError as e:
+            raise RuntimeError(f"Code generation failed: {e}")
+        except LinkError as e:
+            raise RuntimeError(f"Linking module-variables failed:\n{e}")
+
+        key = self.cache_key(sources)
+        entry = self._entry_dir(key)
+        executable = entry / self.EXECUTABLE
+
+        if executable.exists():
+            print(f"  ✓ Build cache hit: {key[:12]}")
+        else:
+            print(f"  Build cache miss: {key[:12]}, compiling...")
+            self._build(key, sources)
 
         print(f"  ✓ Compiled: {executable}")
-        return executable
-
-    def _find_component_file(self, comp_name: str) -> Path:
-        """Find component source file"""
-        # Search all subdirectories for the component
-        for cpp_file in self.components_dir.rglob(f"{comp_name}.cpp"):
-            return cpp_file
-        return None
-
-    def _create_ball_functions(self, components: List[str], build_dir: Path) -> Path:
-        """Create ball_functions.cpp with adapted component code"""
-        # Start with Ball class implementation stub
-        content = """// Auto-generated ball_functions.cpp
-#include "class_hierarchy.hpp"
-
-// Ball class module implementations
-// These are stubs - the actual module implementations come from component files
-"""
-
-        ball_functions = build_dir / 'ball_functions.cpp'
-        ball_functions.write_text(content)
-        return ball_functions
+        return self._link_into_working_dir(executable)
 
-    def _create_generic_main(self, simulation_name: str, build_dir: Path) -> Path:
-        """Create a generic main.cpp for the simulation"""
-        main_content = f"""
-// Auto-generated main for {simulation_name}
-#include "class_hierarchy.hpp"
-
-int main()
-{{
-    // Create simulation
-    Vehicle vehicle;
+    def cache_key(self, sources: Dict[str, str]) -> str:
+        """
+        Content hash of everything that determines the executable
 
-    // Load input file
-    vehicle.load_input("../input.asc");
+        Args:
+            sources: Mapping of generated file name -> content
 
-    // Run simulation
-    vehicle.run();
+        Returns:
+            Hex SHA-256 digest
+        """
+        digest = hashlib.sha256()
+        digest.update(self._toolchain_version().encode())
+        digest.update(json.dumps([self.cxx] + self.CXXFLAGS + self.LDFLAGS).encode())
+        for name in sorted(sources):
+            digest.update(name.encode())
+            digest.update(b'\0')
+            digest.update(sources[name].encode())
+            digest.update(b'\0')
+        return digest.hexdigest()
+
+    def clear_cache(self):
+        """Remove all cached builds"""
+        if self.cache_dir.exists():
+            shutil.rmtree(self.cache_dir)
+
+    def _as_component(self, component: Union[str, Component]) -> Component:
+        """Component for a bare name, with every lifecycle function it defines enabled"""
+        if isinstance(component, Component):
+            return component
+        path = self.generator.find_component_file(component)
+        if path is None:
+            raise RuntimeError(f"Component source not found: {component}.cpp")
+        lifecycle = ['def', 'exec']
+        if ComponentSource.parse(component, path).init_function:
+            lifecycle.insert(1, 'init')
+        return Component(name=component, enabled_lifecycle=lifecycle)
+
+    def _toolchain_version(self) -> str:
+        """Version banner of the C++ compiler"""
+        if self._toolchain is not None:
+            return self._toolchain
+        try:
+            result = subprocess.run([self.cxx, '--version'], capture_output=True, text=True)
+        except OSError as e:
+            raise RuntimeError(f"C++ compiler '{self.cxx}' not available: {e}")
+        self._toolchain = result.stdout.splitlines()[0] if result.stdout else self.cxx
+        return self._toolchain
+
+    def _entry_dir(self, key: str) -> Path:
+        """Cache entry directory for a key"""
+        return self.cache_dir / key[:2] / key
+
+    def _build(self, key: str, sources: Dict[str, str]):
+        """Compile into a private directory, then publish it as the cache entry"""
+        entry = self._entry_dir(key)
+        entry.parent.mkdir(parents=True, exist_ok=True)
+        build_dir = Path(tempfile.mkdtemp(prefix=f"{key[:12]}-", dir=entry.parent))
+
+        try:
+            for name, content in sources.items():
+                (build_dir / name).write_text(content)
+
+            result = subprocess.run(
+                [self.cxx] + self.CXXFLAGS + self.LDFLAGS +
+                ['-o', self.EXECUTABLE, self.UNIT],
+                cwd=build_dir, capture_output=True, text=True
+            )
+            if result.returncode != 0:
+                raise RuntimeError(f"Compilation failed:\n{result.stderr}")
+
+            (build_dir / 'manifest.json').write_text(json.dumps({
+                'key': key,
+                'toolchain': self._toolchain_version(),
+                'cxxflags': self.CXXFLAGS,
+                'sources': sorted(sources),
+            }, indent=2))
+
+            # Publish atomically; if another process won the race keep its entry
+            try:
+                os.rename(build_dir, entry)
+            except OSError:
+                if not (entry / self.EXECUTABLE).exists():
+                    raise
+        finally:
+            if build_dir.exists():
+                shutil.rmtree(build_dir, ignore_errors=True)
+
+    def _link_into_working_dir(self, executable: Path) -> Path:
+        """
+        Expose the cached executable in the simulation's build directory
 
-    return 0;
-}}
-"""
-        main_file = build_dir / 'main.cpp'
-        main_file.write_text(main_content)
-        return main_file
+        Runs happen in the working directory, never inside the shared cache.
+        """
+        build_dir = self.working_dir / 'build'
+        build_dir.mkdir(parents=True, exist_ok=True)
+        target = build_dir / executable.name
+        if target.exists() or target.is_symlink():
+            target.unlink()
+        try:
+            os.link(executable, target)
+        except OSError:
+            shutil.copy2(executable, target)
+        return target
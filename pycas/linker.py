@@ -0,0 +1,229 @@
+"""
+Linker - Assigns module-variable slots to the components of a simulation
+
+Each component documents its module-variables in the INPUTS/OUTPUTS/PARAMETERS
+header blocks and defines them in its def_ function, using slot numbers that
+are only meaningful inside that component. The manifest collects those names
+together with the variables each lifecycle function actually reads
+('.real()', '.integer()', '.vec()', '.mat()') and writes ('.gets...()').
+
+The linker then lays out one dense 'ball[]' array for the whole simulation:
+slot 0 holds 'time' (the executive writes it as the first output column),
+followed by the variables of each module in execution order, so a module's
+working set occupies adjacent slots. Before any code is generated it checks
+the dataflow and reports every
+
+  - double writer: a variable written at run time by more than one module,
+  - read before write: a variable read although no module defines or writes
+    it, or read by an init_ function although only the exec function of
+    another module ever writes it.
+
+INPUTS marked '(optional)' in the header may stay unconnected; they read the
+zeroed slot.
+"""
+
+import re
+from dataclasses import dataclass, field
+from typing import Dict, List, Optional, Sequence
+
+# The framework writes 'time' from slot 0 as the first column of every output
+TIME_SLOT = 0
+TIME = 'time'
+
+_SECTION_RE = re.compile(r'^//\s*(INPUTS|OUTPUTS|PARAMETERS)\b.*\n((?://[ \t]+\S.*\n)*)', re.MULTILINE)
+_ENTRY_RE = re.compile(r'^//\s+vehicle\[(\d+)\]\s*-\s*(\w+)\s*-(.*)$', re.MULTILINE)
+_INIT_RE = re.compile(r'\bvehicle\[(\d+)\]\.init\(\s*"(\w+)"')
+_READ_RE = re.compile(r'\bvehicle\[(\d+)\]\.(?:real|integer|vec|mat)\s*\(')
+_WRITE_RE = re.compile(r'\bvehicle\[(\d+)\]\.gets\w*\s*\(')
+_SLOT_RE = re.compile(r'\bvehicle\[(\d+)\]')
+
+# Lifecycle phases that access module-variables at run time
+PHASES = ('init', 'exec')
+
+
+class LinkError(Exception):
+    """Raised when the components of a simulation cannot be linked"""
+
+    def __init__(self, conflicts: List[str]):
+        self.conflicts = conflicts
+        super().__init__('\n'.join(f"  - {c}" for c in conflicts))
+
+
+@dataclass
+class ComponentManifest:
+    """Module-variables a component documents, defines, reads and writes"""
+
+    name: str
+    inputs: Dict[str, int] = field(default_factory=dict)
+    outputs: Dict[str, int] = field(default_factory=dict)
+    parameters: Dict[str, int] = field(default_factory=dict)
+    """Header blocks: variable name -> component-local slot"""
+
+    optional: List[str] = field(default_factory=list)
+    """INPUTS documented as '(optional)'"""
+
+    defines: List[str] = field(default_factory=list)
+    """Variables defined in def_, in definition order"""
+
+    slot_names: Dict[int, str] = field(default_factory=dict)
+    """Component-local slot -> variable name"""
+
+    reads: Dict[str, List[str]] = field(default_factory=dict)
+    writes: Dict[str, List[str]] = field(default_factory=dict)
+    """Phase ('init', 'exec') -> variables in order of first access"""
+
+    @classmethod
+    def from_source(cls, source) -> 'ComponentManifest':
+        """
+        Build the manifest of a parsed component
+
+        Args:
+            source: ComponentSource (see codegen.py)
+
+        Raises:
+            LinkError: If a slot is used but never named
+        """
+        manifest = cls(source.name)
+        sections = {'INPUTS': manifest.inputs, 'OUTPUTS': manifest.outputs,
+                    'PARAMETERS': manifest.parameters}
+        for match in _SECTION_RE.finditer(source.text):
+            for slot, var, description in _ENTRY_RE.findall(match.group(2)):
+                sections[match.group(1)].setdefault(var, int(slot))
+                manifest.slot_names.setdefault(int(slot), var)
+                if match.group(1) == 'INPUTS' and '(optional)' in description:
+                    manifest.optional.append(var)
+
+        # Definitions in def_ are authoritative over the header documentation
+        def_body = source.functions[source.def_function].body
+        for slot, var in _INIT_RE.findall(def_body):
+            manifest.slot_names[int(slot)] = var
+            manifest.defines.append(var)
+
+        unnamed = sorted({int(s) for s in _SLOT_RE.findall(source.text)} - set(manifest.slot_names))
+        if unnamed:
+            raise LinkError([
+                f"{source.path.name}: vehicle[{slot}] is used but never named in its "
+                "INPUTS/OUTPUTS/PARAMETERS header or def_ function" for slot in unnamed])
+
+        # Helpers are called from the module function and count as exec accesses
+        phase_of = {source.init_function: 'init'}
+        for fname, func in source.functions.items():
+            if fname == source.def_function:
+                continue
+            phase = phase_of.get(fname, 'exec')
+            reads = manifest.reads.setdefault(phase, [])
+            writes = manifest.writes.setdefault(phase, [])
+            for slot in _READ_RE.findall(func.body):
+                _append_new(reads, manifest.slot_names[int(slot)])
+            for slot in _WRITE_RE.findall(func.body):
+                _append_new(writes, manifest.slot_names[int(slot)])
+        return manifest
+
+    @property
+    def variables(self) -> List[str]:
+        """All variables the component touches: definitions, then writes, then reads"""
+        names: List[str] = []
+        for var in self.defines:
+            _append_new(names, var)
+        for phase in PHASES:
+            for var in self.writes.get(phase, []):
+                _append_new(names, var)
+        for phase in PHASES:
+            for var in self.reads.get(phase, []):
+                _append_new(names, var)
+        return names
+
+
+@dataclass
+class LinkMap:
+    """Slot layout of the assembled module-variable array"""
+
+    slots: Dict[str, int]
+    """Variable name -> slot in 'ball[]'"""
+
+    owners: Dict[str, str]
+    """Variable name -> component that first defines or writes it"""
+
+    @property
+    def size(self) -> int:
+        """Required length of the module-variable array"""
+        return len(self.slots)
+
+    def slot(self, name: str) -> int:
+        return self.slots[name]
+
+    def layout(self) -> List[str]:
+        """One line per slot: 'ball[n] name - owner'"""
+        return [f"ball[{slot}] {name} - {self.owners.get(name, 'executive')}"
+                for name, slot in sorted(self.slots.items(), key=lambda item: item[1])]
+
+
+class Linker:
+    """Links component manifests into one slot layout"""
+
+    def link(self, manifests: Sequence[ComponentManifest],
+             lifecycles: Optional[Sequence[Sequence[str]]] = None) -> LinkMap:
+        """
+        Check the dataflow and assign dense slots in module execution order
+
+        Args:
+            manifests: Component manifests in module execution order
+            lifecycles: Enabled lifecycle functions per component (default: all)
+
+        Returns:
+            Slot layout
+
+        Raises:
+            LinkError: Listing every double writer and read before write
+        """
+        if lifecycles is None:
+            lifecycles = [('def',) + PHASES] * len(manifests)
+        enabled = [set(lifecycle) for lifecycle in lifecycles]
+
+        defined = set()
+        writers: Dict[str, Dict[str, List[str]]] = {}
+        for manifest, phases in zip(manifests, enabled):
+            if 'def' in phases:
+                defined.update(manifest.defines)
+            for phase in PHASES:
+                if phase in phases:
+                    for var in manifest.writes.get(phase, []):
+                        writers.setdefault(var, {}).setdefault(manifest.name, []).append(phase)
+
+        conflicts = []
+        for var, by_component in writers.items():
+            if len(by_component) > 1:
+                conflicts.append(f"double writer: '{var}' is written by "
+                                 f"{', '.join(by_component)}")
+
+        for manifest, phases in zip(manifests, enabled):
+            for phase in PHASES:
+                if phase not in phases:
+                    continue
+                for var in manifest.reads.get(phase, []):
+                    by_component = writers.get(var, {})
+                    if var not in defined and not by_component and var not in manifest.optional:
+                        conflicts.append(f"read before write: {manifest.name} reads '{var}', "
+                                         "which no module defines or writes")
+                    elif phase == 'init' and by_component and manifest.name not in by_component \
+                            and all(p == ['exec'] * len(p) for p in by_component.values()):
+                        conflicts.append(f"read before write: init of {manifest.name} reads "
+                                         f"'{var}', which only the exec function of "
+                                         f"{', '.join(by_component)} writes")
+        if conflicts:
+            raise LinkError(conflicts)
+
+        slots = {TIME: TIME_SLOT}
+        owners = {}
+        for manifest in manifests:
+            for var in manifest.variables:
+                if var not in slots:
+                    slots[var] = len(slots)
+            for var in manifest.defines + [v for p in PHASES for v in manifest.writes.get(p, [])]:
+                owners.setdefault(var, manifest.name)
+        return LinkMap(slots, owners)
+
+
+def _append_new(names: List[str], name: str):
+    if name not in names:
+        names.append(name)
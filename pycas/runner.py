@@ -5,6 +5,7 @@ Runner - Executes CADAC simulations
 import subprocess
 import shutil
 from pathlib import Path
+from typing import Optional
 
 
 class Runner:
@@ -13,13 +14,22 @@ class Runner:
     def __init__(self, working_dir: Path):
         self.working_dir = Path(working_dir)
 
-    def run(self, executable: Path, input_file: Path) -> Path:
+    def run(self, executable: Path, input_file: Path,
+            workspace: Optional[Path] = None, timeout: float = 300,
+            verbose: bool = True) -> Path:
         """
         Run simulation
 
+        CADAC executables read 'input.asc' from and write their output files
+        into the current directory. By default that is the executable's own
+        directory; pass a private 'workspace' to keep concurrent runs apart.
+
         Args:
             executable: Path to compiled executable
             input_file: Path to input.asc file
+            workspace: Directory to run in (default: executable directory)
+            timeout: Wall-clock limit for the run (sec)
+            verbose: Print progress messages
 
         Returns:
             Path to trajectory output file
@@ -33,31 +43,35 @@ class Runner:
         if not input_file.exists():
             raise RuntimeError(f"Input file not found: {input_file}")
 
-        # CADAC executables expect input.asc in their directory
-        # Copy input file to executable directory
-        exec_dir = executable.parent
-        exec_input = exec_dir / 'input.asc'
-        shutil.copy(input_file, exec_input)
-        print(f"  Copied input file to {exec_input}")
-
-        # Run simulation from executable directory
-        print(f"  Running {executable.name}...")
+        # CADAC executables expect input.asc in their run directory
+        run_dir = Path(workspace) if workspace is not None else executable.parent
+        run_dir.mkdir(parents=True, exist_ok=True)
+        run_input = run_dir / 'input.asc'
+        if run_input.resolve() != Path(input_file).resolve():
+            shutil.copy(input_file, run_input)
+            if verbose:
+                print(f"  Copied input file to {run_input}")
+
+        # Run simulation from the run directory
+        if verbose:
+            print(f"  Running {executable.name}...")
         try:
-            result = subprocess.run(
-                [f'./{executable.name}'],
-                cwd=exec_dir,
+            subprocess.run(
+                [str(Path(executable).resolve())],
+                cwd=run_dir,
                 capture_output=True,
                 text=True,
                 check=True,
-                timeout=300  # 5 minute timeout
+                timeout=timeout
             )
 
-            print(f"  ✓ Simulation completed")
+            if verbose:
+                print(f"  ✓ Simulation completed")
 
-            # Check for trajectory output in executable directory
-            traj_file = exec_dir / 'plot1.asc'
+            # Check for trajectory output in run directory
+            traj_file = run_dir / 'plot1.asc'
             if not traj_file.exists():
-                traj_file = exec_dir / 'traj.asc'
+                traj_file = run_dir / 'traj.asc'
 
             if not traj_file.exists():
                 raise RuntimeError("Trajectory file not generated")
@@ -65,6 +79,6 @@ class Runner:
             return traj_file
 
         except subprocess.TimeoutExpired:
-            raise RuntimeError("Simulation timed out (5 minutes)")
+            raise RuntimeError(f"Simulation timed out ({timeout:g} sec)")
         except subprocess.CalledProcessError as e:
             raise RuntimeError(f"Simulation failed:\n{e.stderr}")
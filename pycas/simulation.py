@@ -7,7 +7,9 @@ from typing import List, Dict, Any, Optional
 from .component import Component
 from .component_registry import ComponentRegistry, ComponentMetadata
 from .input_generator import InputFileGenerator
+from .codegen import CodegenError
 from .compiler import Compiler
+from .linker import LinkError
 from .runner import Runner
 from .trajectory import Trajectory
 
@@ -122,13 +124,20 @@ class Simulation:
         if 'termination' not in component_names:
             errors.append("Missing required component: termination")
 
-        # TODO: Add more sophisticated validation
-        # For now, just check that components exist in registry
         for component in self.components:
             meta = self.registry.get(component.name)
             if not meta:
                 errors.append(f"Unknown component: {component.name}")
 
+        # Module-variable dataflow: double writers and reads before writes
+        if not errors:
+            try:
+                self.compiler.generator.link(self.components)
+            except CodegenError as e:
+                errors.append(str(e))
+            except LinkError as e:
+                errors.extend(e.conflicts)
+
         return errors
 
     def generate_input_file(self, output_path: Optional[Path] = None) -> Path:
@@ -184,7 +193,7 @@ class Simulation:
         print(f"Compiling simulation '{self.name}'...")
         self._executable_path = self.compiler.compile(
             simulation_name=self.name,
-            components=[c.name for c in self.components]
+            components=self.components
         )
 
         self._compiled = True
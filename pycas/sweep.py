@@ -0,0 +1,273 @@
+"""
+Sweep - Parallel parameter sweeps over a simulation
+
+Each case is a set of overrides applied on top of a base Simulation:
+initial-state variables, component parameters ('component.param') and the
+simulation configuration ('dt', 'duration', 'output_step'). Every case gets
+its own scratch directory holding its rendered input.asc and output files, so
+cases can run concurrently against one compiled executable.
+"""
+
+import copy
+import itertools
+import os
+import shutil
+import tempfile
+from concurrent.futures import ProcessPoolExecutor, as_completed
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Any, Dict, Iterator, List, Optional
+
+import numpy as np
+
+from .runner import Runner
+from .trajectory import Trajectory
+
+# Override keys that address the simulation configuration
+CONFIG_KEYS = ('dt', 'duration', 'output_step')
+
+
+@dataclass
+class CaseResult:
+    """Outcome of a single sweep case"""
+
+    case_id: int
+    overrides: Dict[str, Any]
+    status: str
+    """'ok', 'failed' or 'timeout'"""
+
+    workspace: Path
+    trajectory: Optional[Trajectory] = None
+    error: str = ""
+
+
+@dataclass
+class SweepResults:
+    """
+    Columnar store of all case trajectories
+
+    Rows of every case are stacked into one array per variable. 'case_id'
+    holds the owning case of each row, and 'offsets[k]:offsets[k+1]' is the
+    row range of the k-th entry in 'case_ids'.
+    """
+
+    case_ids: np.ndarray
+    status: Dict[int, str]
+    errors: Dict[int, str]
+    parameters: Dict[str, np.ndarray]
+    """Override key -> value per entry in 'case_ids'"""
+
+    columns: Dict[str, np.ndarray]
+    offsets: np.ndarray
+    _index: Dict[int, int] = field(default_factory=dict, repr=False)
+
+    def __post_init__(self):
+        self._index = {int(cid): k for k, cid in enumerate(self.case_ids)}
+
+    @classmethod
+    def from_cases(cls, results: List[CaseResult]) -> 'SweepResults':
+        """Assemble the store from individual case results"""
+        results = sorted(results, key=lambda r: r.case_id)
+        case_ids = np.array([r.case_id for r in results], dtype=int)
+
+        keys = sorted({key for r in results for key in r.overrides})
+        parameters = {
+            key: np.array([r.overrides.get(key, np.nan) for r in results], dtype=float)
+            for key in keys
+        }
+
+        variables = []
+        for r in results:
+            if r.trajectory is not None:
+                variables.extend(v for v in r.trajectory.variables if v not in variables)
+
+        lengths = [len(r.trajectory.time) if r.trajectory is not None else 0 for r in results]
+        offsets = np.concatenate([[0], np.cumsum(lengths)]).astype(int)
+        total = int(offsets[-1])
+
+        columns = {'case_id': np.repeat(case_ids, lengths),
+                   'time': np.empty(total)}
+        for var in variables:
+            columns[var] = np.full(total, np.nan)
+        for k, r in enumerate(results):
+            if r.trajectory is None:
+                continue
+            rows = slice(offsets[k], offsets[k + 1])
+            columns['time'][rows] = r.trajectory.time
+            for var in r.trajectory.variables:
+                columns[var][rows] = r.trajectory.data[var]
+
+        return cls(case_ids=case_ids,
+                   status={r.case_id: r.status for r in results},
+                   errors={r.case_id: r.error for r in results if r.error},
+                   parameters=parameters,
+                   columns=columns,
+                   offsets=offsets)
+
+    @property
+    def variables(self) -> List[str]:
+        """Output variable names (excluding 'case_id' and 'time')"""
+        return [v for v in self.columns if v not in ('case_id', 'time')]
+
+    def case(self, case_id: int) -> Trajectory:
+        """Trajectory of a single case"""
+        k = self._index[case_id]
+        rows = slice(self.offsets[k], self.offsets[k + 1])
+        data = {var: self.columns[var][rows] for var in self.variables}
+        return Trajectory(self.columns['time'][rows], data)
+
+    def final(self, variable: str) -> np.ndarray:
+        """Last value of a variable for every case (NaN if the case produced no output)"""
+        values = np.full(len(self.case_ids), np.nan)
+        ends = self.offsets[1:]
+        has_rows = ends > self.offsets[:-1]
+        values[has_rows] = self.columns[variable][ends[has_rows] - 1]
+        return values
+
+    def save(self, path: Path):
+        """Write the store to a compressed .npz file"""
+        arrays = {f"col/{k}": v for k, v in self.columns.items()}
+        arrays.update({f"param/{k}": v for k, v in self.parameters.items()})
+        arrays['case_ids'] = self.case_ids
+        arrays['offsets'] = self.offsets
+        arrays['status'] = np.array([self.status[int(c)] for c in self.case_ids])
+        np.savez_compressed(path, **arrays)
+
+    @classmethod
+    def load(cls, path: Path) -> 'SweepResults':
+        """Read a store written by save()"""
+        with np.load(path) as npz:
+            case_ids = npz['case_ids']
+            return cls(case_ids=case_ids,
+                       status={int(c): str(s) for c, s in zip(case_ids, npz['status'])},
+                       errors={},
+                       parameters={k[6:]: npz[k] for k in npz.files if k.startswith('param/')},
+                       columns={k[4:]: npz[k] for k in npz.files if k.startswith('col/')},
+                       offsets=npz['offsets'])
+
+    def __repr__(self) -> str:
+        ok = sum(1 for s in self.status.values() if s == 'ok')
+        return (f"SweepResults({len(self.case_ids)} cases, {ok} ok, "
+                f"{len(self.columns['time'])} rows, {len(self.variables)} variables)")
+
+
+def _run_case(executable: str, workspace: str, case_id: int,
+              overrides: Dict[str, Any], timeout: float) -> CaseResult:
+    """Worker: run one rendered case in its workspace and parse its output"""
+    workspace = Path(workspace)
+    try:
+        output = Runner(workspace).run(Path(executable), workspace / 'input.asc',
+                                       workspace=workspace, timeout=timeout, verbose=False)
+        trajectory = Trajectory.from_file(output)
+        return CaseResult(case_id, overrides, 'ok', workspace, trajectory)
+    except RuntimeError as e:
+        status = 'timeout' if 'timed out' in str(e) else 'failed'
+        return CaseResult(case_id, overrides, status, workspace, error=str(e))
+    except (ValueError, FileNotFoundError) as e:
+        return CaseResult(case_id, overrides, 'failed', workspace, error=str(e))
+
+
+class Sweep:
+    """Runs a batch of parameter-override cases in parallel"""
+
+    def __init__(self, simulation, cases: List[Dict[str, Any]],
+                 workers: Optional[int] = None, timeout: float = 300,
+                 scratch_dir: Optional[Path] = None, keep_workspaces: bool = False):
+        """
+        Initialize sweep
+
+        Args:
+            simulation: Base Simulation; it is compiled once and never modified
+            cases: One dict of overrides per case; case IDs are list positions
+            workers: Number of concurrent cases (default: number of cores)
+            timeout: Wall-clock limit per case (sec)
+            scratch_dir: Parent of the per-case workspaces (default: working_dir/sweep)
+            keep_workspaces: Leave workspaces on disk after results are collected
+        """
+        self.simulation = simulation
+        self.cases = [dict(c) for c in cases]
+        self.workers = workers or os.cpu_count() or 1
+        self.timeout = timeout
+        self.scratch_dir = Path(scratch_dir) if scratch_dir else simulation.working_dir / 'sweep'
+        self.keep_workspaces = keep_workspaces
+
+    @classmethod
+    def grid(cls, simulation, axes: Dict[str, List[Any]], **kwargs) -> 'Sweep':
+        """
+        Full-factorial sweep over the given axes
+
+        Example:
+            Sweep.grid(sim, {'vbel1': [30, 35, 40], 'drag_simple.cd': [0.4, 0.47]})
+        """
+        keys = list(axes)
+        cases = [dict(zip(keys, values)) for values in itertools.product(*axes.values())]
+        return cls(simulation, cases, **kwargs)
+
+    def render(self, overrides: Dict[str, Any]) -> str:
+        """Render input.asc content for one case"""
+        sim = self.simulation
+        components = copy.deepcopy(sim.components)
+        initial_state = dict(sim.initial_state)
+        config = dict(sim.simulation_config)
+        by_name = {c.name: c for c in components}
+
+        for key, value in overrides.items():
+            if key in CONFIG_KEYS:
+                config[key] = value
+            elif '.' in key:
+                comp_name, param = key.split('.', 1)
+                if comp_name not in by_name:
+                    raise ValueError(f"Override '{key}': no component '{comp_name}' in simulation")
+                by_name[comp_name].set_parameter(param, value)
+            else:
+                initial_state[key] = value
+
+        return sim.input_generator.generate(
+            simulation_name=sim.name,
+            components=components,
+            initial_state=initial_state,
+            config=config
+        )
+
+    def iter_results(self) -> Iterator[CaseResult]:
+        """
+        Run all cases, yielding each result as soon as it finishes
+
+        Yields:
+            CaseResult in completion order
+        """
+        executable = self.simulation.compile()
+        self.scratch_dir.mkdir(parents=True, exist_ok=True)
+        batch_dir = Path(tempfile.mkdtemp(prefix='batch-', dir=self.scratch_dir))
+
+        # Render every case up front so a bad override fails before any run starts
+        workspaces = {}
+        for case_id, overrides in enumerate(self.cases):
+            workspace = batch_dir / f"case_{case_id:05d}"
+            workspace.mkdir()
+            (workspace / 'input.asc').write_text(self.render(overrides))
+            workspaces[case_id] = workspace
+
+        try:
+            with ProcessPoolExecutor(max_workers=self.workers) as pool:
+                futures = [
+                    pool.submit(_run_case, str(executable), str(workspaces[case_id]),
+                                case_id, overrides, self.timeout)
+                    for case_id, overrides in enumerate(self.cases)
+                ]
+                for future in as_completed(futures):
+                    yield future.result()
+        finally:
+            if not self.keep_workspaces:
+                shutil.rmtree(batch_dir, ignore_errors=True)
+
+    def run(self) -> SweepResults:
+        """Run all cases and collect them into a columnar store"""
+        return SweepResults.from_cases(list(self.iter_results()))
+
+    def __repr__(self) -> str:
+        return f"Sweep({self.simulation.name!r}, {len(self.cases)} cases, {self.workers} workers)"
+
+
+# A batch is a sweep over an explicit list of cases
+Batch = Sweep
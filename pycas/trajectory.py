@@ -1,11 +1,155 @@
 """
 Trajectory - Parse and analyze CADAC trajectory output
+
+Plot and traj files are read as a stream of row chunks (TrajectoryReader), so
+merged Monte Carlo files and very long trajectories never have to be held in
+memory as a whole. Runs in a merged file are closed by a row whose time is -1
+(the executive repeats the last integration step with 'time=-1' for
+CADAC-Studio); those rows separate runs and are not part of the data.
 """
 
-import numpy as np
-from pathlib import Path
-from typing import Dict, List, Optional
+import os
+from concurrent.futures import ProcessPoolExecutor
 from dataclasses import dataclass
+from pathlib import Path
+from typing import Dict, Iterator, List, Optional, Sequence, Tuple, Union
+
+import numpy as np
+
+# Time of the row that closes each run of a plot/traj file
+END_OF_RUN = -1.0
+
+# Rows parsed per chunk when streaming a file
+CHUNK_ROWS = 65536
+
+# Sampling assumed when a file has no time variable (typical plot_step)
+DEFAULT_PLOT_STEP = 0.05
+
+_TIME_NAMES = ('time', 'Time', 'TIME', 't')
+
+
+@dataclass
+class TrajectoryChunk:
+    """Consecutive rows of one run"""
+
+    run: int
+    """Run index in the file (0-based)"""
+
+    time: np.ndarray
+    values: np.ndarray
+    """Rows x variables, columns in file order"""
+
+
+class TrajectoryReader:
+    """Streams a CADAC plot/traj file in chunks of rows"""
+
+    def __init__(self, filepath: Path, chunk_rows: int = CHUNK_ROWS):
+        """
+        Open the file and parse its header
+
+        Args:
+            filepath: Path to plot*.asc or traj.asc
+            chunk_rows: Maximum rows per chunk
+
+        Raises:
+            FileNotFoundError: If the file does not exist
+            ValueError: If the header has no variable names
+        """
+        self.filepath = Path(filepath)
+        if not self.filepath.exists():
+            raise FileNotFoundError(f"Trajectory file not found: {self.filepath}")
+        self.chunk_rows = max(int(chunk_rows), 1)
+
+        # CADAC format:
+        # Line 1: Title and metadata
+        # Line 2: Header numbers
+        # Lines 3+: Variable names (may wrap)
+        # Lines N+: Data (may wrap)
+        self.variables: List[str] = []
+        self._data_offset = 0
+        with open(self.filepath, 'r') as f:
+            f.readline()
+            f.readline()
+            while True:
+                offset = f.tell()
+                line = f.readline()
+                if not line:
+                    self._data_offset = offset
+                    break
+                tokens = line.split()
+                if not tokens or tokens[0].startswith('//'):
+                    continue
+                if _numeric(tokens):
+                    self._data_offset = offset
+                    break
+                self.variables.extend(tokens)
+
+        if not self.variables:
+            raise ValueError("No variable names found in trajectory file")
+        self.time_index = next((self.variables.index(n) for n in _TIME_NAMES if n in self.variables), None)
+
+    def __iter__(self) -> Iterator[TrajectoryChunk]:
+        """
+        Yield the data rows in chunks; a chunk never spans two runs
+
+        Lines that are not all numeric are skipped and an incomplete last row
+        is dropped.
+        """
+        num_vars = len(self.variables)
+        block = self.chunk_rows * num_vars
+        state = {'run': 0, 'rows': 0}
+        pending: List[str] = []
+
+        with open(self.filepath, 'r') as f:
+            f.seek(self._data_offset)
+            for line in f:
+                tokens = line.split()
+                if not tokens or tokens[0].startswith('//') or not _numeric(tokens):
+                    continue
+                pending.extend(tokens)
+                if len(pending) >= block:
+                    yield from self._split_runs(np.array(pending[:block], dtype=float), state)
+                    del pending[:block]
+        complete = len(pending) - len(pending) % num_vars
+        if complete:
+            yield from self._split_runs(np.array(pending[:complete], dtype=float), state)
+
+    def _split_runs(self, values: np.ndarray, state: dict) -> Iterator[TrajectoryChunk]:
+        """Cut a block of rows at the end-of-run rows"""
+        rows = values.reshape(-1, len(self.variables))
+        if self.time_index is not None:
+            time = rows[:, self.time_index]
+            ends = np.flatnonzero(time == END_OF_RUN)
+        else:
+            time = (state['rows'] + np.arange(len(rows))) * DEFAULT_PLOT_STEP
+            ends = np.empty(0, dtype=int)
+
+        start = 0
+        for end in list(ends) + [len(rows)]:
+            if end > start:
+                yield TrajectoryChunk(state['run'], time[start:end], rows[start:end])
+                state['rows'] += end - start
+            if end < len(rows):
+                state['run'] += 1
+                state['rows'] = 0
+            start = end + 1
+
+    def runs(self) -> Iterator['Trajectory']:
+        """Yield every run of the file as a Trajectory"""
+        current, chunks = 0, []
+        for chunk in self:
+            if chunk.run != current and chunks:
+                yield self._assemble(chunks)
+                chunks = []
+            current = chunk.run
+            chunks.append(chunk)
+        if chunks:
+            yield self._assemble(chunks)
+
+    def _assemble(self, chunks: List[TrajectoryChunk]) -> 'Trajectory':
+        values = np.concatenate([c.values for c in chunks])
+        time = np.concatenate([c.time for c in chunks])
+        return Trajectory(time, {var: values[:, i] for i, var in enumerate(self.variables)})
 
 
 @dataclass
@@ -27,105 +171,27 @@ class Trajectory:
         self.variables = list(data.keys())
 
     @classmethod
-    def from_file(cls, filepath: Path) -> 'Trajectory':
+    def from_file(cls, filepath: Path, run: int = 0) -> 'Trajectory':
         """
         Load trajectory from CADAC output file
 
         Args:
             filepath: Path to traj.asc file
+            run: Run to load from a merged Monte Carlo file (0-based)
 
         Returns:
             Trajectory object
         """
-        filepath = Path(filepath)
-        if not filepath.exists():
-            raise FileNotFoundError(f"Trajectory file not found: {filepath}")
-
-        # Read the file
-        with open(filepath, 'r') as f:
-            lines = f.readlines()
-
-        # Parse CADAC format:
-        # Line 1: Title and metadata
-        # Line 2: Header numbers
-        # Lines 3+: Variable names (may wrap)
-        # Lines N+: Data (may wrap)
-
-        # Skip first 2 lines (title and header)
-        i = 2
-
-        # Collect variable names (may be wrapped across multiple lines)
-        variables = []
-        while i < len(lines):
-            line = lines[i].strip()
-            if not line or line.startswith('//'):
-                i += 1
-                continue
-
-            tokens = line.split()
-            # Check if this looks like variable names (not all numeric)
-            try:
-                # Try to convert to float - if it succeeds, it's data not variables
-                [float(x) for x in tokens]
-                # All numeric - this is the start of data
+        reader = TrajectoryReader(filepath)
+        chunks = []
+        for chunk in reader:
+            if chunk.run > run:
                 break
-            except ValueError:
-                # Has non-numeric tokens - still variable names
-                variables.extend(tokens)
-                i += 1
-
-        data_start_line = i
-
-        if not variables:
-            raise ValueError("No variable names found in trajectory file")
-
-        # Collect all remaining tokens as data values
-        all_values = []
-        for line in lines[data_start_line:]:
-            line = line.strip()
-            if not line or line.startswith('//'):
-                continue
-            try:
-                values = [float(x) for x in line.split()]
-                all_values.extend(values)
-            except ValueError:
-                continue
-
-        if not all_values:
+            if chunk.run == run:
+                chunks.append(chunk)
+        if not chunks:
             raise ValueError("No valid data found in trajectory file")
-
-        # Group values into rows of len(variables) each
-        num_vars = len(variables)
-        raw_data = []
-        for i in range(0, len(all_values), num_vars):
-            if i + num_vars <= len(all_values):
-                raw_data.append(all_values[i:i+num_vars])
-
-        if not raw_data:
-            raise ValueError("No complete data rows found in trajectory file")
-
-        data_array = np.array(raw_data)
-
-        # Build data dictionary
-        data_dict = {}
-        for i, var_name in enumerate(variables):
-            data_dict[var_name] = data_array[:, i]
-
-        # Try to find time variable
-        # Check for common time variable names
-        time = None
-        for time_name in ['time', 'Time', 'TIME', 't']:
-            if time_name in data_dict:
-                time = data_dict[time_name]
-                break
-
-        # If no time variable found, generate synthetic time array
-        if time is None:
-            # Generate time based on number of points
-            # Assume uniform sampling at 0.05s intervals (typical plot_step)
-            time = np.arange(len(raw_data), dtype=float) * 0.05
-
-        return cls(time, data_dict)
+        return reader._assemble(chunks)
 
     def get(self, variable: str) -> Optional[np.ndarray]:
         """Get data for a specific variable"""
@@ -175,62 +241,212 @@ class Trajectory:
         return '\n'.join(lines)
 
 
+@dataclass
+class ErrorStats:
+    """Errors of one test run against the reference"""
+
+    run: int
+    points: int
+    rms: Dict[str, float]
+    max: Dict[str, float]
+    source: str = ""
+    """Test file, if the run was read from one"""
+
+    time: Optional[np.ndarray] = None
+    errors: Optional[Dict[str, np.ndarray]] = None
+    """Error time series (test - reference), only if requested"""
+
+
+class ReferenceInterpolator:
+    """
+    Linear interpolation of all reference variables at once
+
+    Equivalent to np.interp per variable (values are held constant outside
+    the reference time span), but evaluated for a whole chunk of test times
+    and every variable in one pass.
+    """
+
+    def __init__(self, reference: Trajectory, variables: Sequence[str]):
+        self.time = np.asarray(reference.time, dtype=float)
+        self.values = np.column_stack([reference.data[var] for var in variables]) \
+            if variables else np.empty((len(self.time), 0))
+
+    def __call__(self, time: np.ndarray) -> np.ndarray:
+        """Reference values at 'time': rows x variables"""
+        if len(self.time) == 1:
+            return np.repeat(self.values, len(time), axis=0)
+        upper = np.clip(np.searchsorted(self.time, time, side='right'), 1, len(self.time) - 1)
+        t0, t1 = self.time[upper - 1], self.time[upper]
+        span = t1 - t0
+        weight = np.divide(time - t0, span, out=np.zeros_like(time, dtype=float), where=span > 0)
+        weight = np.clip(weight, 0.0, 1.0)[:, None]
+        return self.values[upper - 1] * (1.0 - weight) + self.values[upper] * weight
+
+
+class _ErrorAccumulator:
+    """Single-pass RMS and max error over chunks of one run"""
+
+    def __init__(self, variables: List[str], keep_errors: bool):
+        self.variables = variables
+        self.points = 0
+        self.sum_squares = np.zeros(len(variables))
+        self.max_abs = np.zeros(len(variables))
+        self.keep_errors = keep_errors
+        self.times: List[np.ndarray] = []
+        self.errors: List[np.ndarray] = []
+
+    def add(self, time: np.ndarray, test: np.ndarray, reference: np.ndarray):
+        diff = test - reference
+        self.points += len(diff)
+        self.sum_squares += np.einsum('ij,ij->j', diff, diff)
+        if len(diff):
+            self.max_abs = np.maximum(self.max_abs, np.abs(diff).max(axis=0))
+        if self.keep_errors:
+            self.times.append(np.array(time))
+            self.errors.append(diff)
+
+    def stats(self, run: int, source: str = "") -> ErrorStats:
+        rms = np.sqrt(self.sum_squares / self.points) if self.points else np.full(len(self.variables), np.nan)
+        stats = ErrorStats(run, self.points,
+                           dict(zip(self.variables, rms.tolist())),
+                           dict(zip(self.variables, self.max_abs.tolist())), source)
+        if self.keep_errors:
+            errors = np.concatenate(self.errors) if self.errors else np.empty((0, len(self.variables)))
+            stats.time = np.concatenate(self.times) if self.times else np.empty(0)
+            stats.errors = {var: errors[:, i] for i, var in enumerate(self.variables)}
+        return stats
+
+
+def _trajectory_chunks(trajectory: Trajectory, chunk_rows: int) -> Iterator[TrajectoryChunk]:
+    """Chunks of an in-memory trajectory"""
+    values = np.column_stack([trajectory.data[var] for var in trajectory.variables])
+    for start in range(0, len(trajectory.time), chunk_rows):
+        rows = slice(start, start + chunk_rows)
+        yield TrajectoryChunk(0, trajectory.time[rows], values[rows])
+
+
+def _compare_file(test_file: str, reference: Trajectory, chunk_rows: int,
+                  keep_errors: bool) -> List[ErrorStats]:
+    """Worker: errors of every run of a test file"""
+    return TrajectoryComparator.compare_file(test_file, reference, chunk_rows=chunk_rows,
+                                             keep_errors=keep_errors)
+
+
 class TrajectoryComparator:
     """Compare two trajectories for regression testing"""
 
-    def __init__(self, test: Trajectory, reference: Trajectory):
+    def __init__(self, test: Union[Trajectory, Path, str], reference: Trajectory,
+                 run: int = 0, chunk_rows: int = CHUNK_ROWS, keep_errors: bool = False):
         """
         Initialize comparator
 
+        The reference is interpolated to the test time points chunk by chunk
+        while RMS and max errors of all common variables accumulate, so a test
+        file is streamed rather than loaded.
+
         Args:
-            test: Test trajectory
+            test: Test trajectory, or path to a test file (streamed)
             reference: Reference trajectory
+            run: Run of a merged Monte Carlo test file (0-based)
+            chunk_rows: Rows per chunk
+            keep_errors: Keep the error time series of every variable
         """
         self.test = test
         self.reference = reference
-        self._interpolate_reference()
+        self.run = run
+        self.chunk_rows = chunk_rows
+        self.keep_errors = keep_errors
+
+        if isinstance(test, Trajectory):
+            test_vars = test.variables
+            chunks = _trajectory_chunks(test, chunk_rows)
+        else:
+            reader = TrajectoryReader(test, chunk_rows)
+            test_vars = reader.variables
+            chunks = (c for c in reader if c.run == run)
 
-    def _interpolate_reference(self):
-        """Interpolate reference trajectory to match test time points"""
         # Find common variables
-        self.common_vars = set(self.test.variables) & set(self.reference.variables)
+        self.common_vars = set(test_vars) & set(reference.variables)
+        self._vars = [v for v in test_vars if v in self.common_vars]
+        self.stats = self._accumulate(chunks, test_vars, self._vars, reference, keep_errors)\
+            .stats(run, '' if isinstance(test, Trajectory) else str(test))
+
+    @staticmethod
+    def _accumulate(chunks: Iterator[TrajectoryChunk], test_vars: List[str], variables: List[str],
+                    reference: Trajectory, keep_errors: bool, per_run: bool = False):
+        """Run the single pass; per_run returns one accumulator per run"""
+        interpolate = ReferenceInterpolator(reference, variables)
+        columns = [test_vars.index(v) for v in variables]
+        accumulators: Dict[int, _ErrorAccumulator] = {}
+        for chunk in chunks:
+            acc = accumulators.get(chunk.run)
+            if acc is None:
+                acc = accumulators[chunk.run] = _ErrorAccumulator(variables, keep_errors)
+            acc.add(chunk.time, chunk.values[:, columns], interpolate(chunk.time))
+        if per_run:
+            return accumulators
+        return next(iter(accumulators.values()), _ErrorAccumulator(variables, keep_errors))
 
-        # Interpolate reference to test time points
-        self.reference_interp = {}
-        for var in self.common_vars:
-            self.reference_interp[var] = np.interp(
-                self.test.time,
-                self.reference.time,
-                self.reference.data[var]
-            )
-
-    def rms_error(self, variable: Optional[str] = None) -> Dict[str, float]:
+    @classmethod
+    def compare_file(cls, test_file: Path, reference: Trajectory, chunk_rows: int = CHUNK_ROWS,
+                     keep_errors: bool = False) -> List[ErrorStats]:
         """
-        Calculate RMS error for variables
+        Errors of every run of a (merged Monte Carlo) test file, in one pass
 
         Args:
-            variable: Specific variable (if None, computes for all)
+            test_file: Plot/traj file with one or more runs
+            reference: Reference trajectory
+            chunk_rows: Rows per chunk
+            keep_errors: Keep the error time series
 
         Returns:
-            Dictionary of variable -> RMS error
+            ErrorStats per run, in run order
         """
-        errors = {}
+        reader = TrajectoryReader(test_file, chunk_rows)
+        variables = [v for v in reader.variables if v in reference.variables]
+        accumulators = cls._accumulate(iter(reader), reader.variables, variables,
+                                       reference, keep_errors, per_run=True)
+        return [acc.stats(run, str(test_file)) for run, acc in sorted(accumulators.items())]
 
-        vars_to_check = [variable] if variable else self.common_vars
+    @classmethod
+    def compare_many(cls, test_files: Sequence[Path], reference: Trajectory,
+                     workers: Optional[int] = None, chunk_rows: int = CHUNK_ROWS,
+                     keep_errors: bool = False) -> List[ErrorStats]:
+        """
+        Errors of many test files against one reference, files in parallel
 
-        for var in vars_to_check:
-            if var not in self.common_vars:
-                continue
+        Args:
+            test_files: Plot/traj files (each may hold several runs)
+            reference: Reference trajectory
+            workers: Concurrent files (default: number of cores)
+            chunk_rows: Rows per chunk
+            keep_errors: Keep the error time series
 
-            test_data = self.test.data[var]
-            ref_data = self.reference_interp[var]
+        Returns:
+            ErrorStats of every run, ordered by file then run
+        """
+        workers = min(workers or os.cpu_count() or 1, max(len(test_files), 1))
+        if workers == 1:
+            return [s for f in test_files for s in cls.compare_file(f, reference, chunk_rows, keep_errors)]
+        with ProcessPoolExecutor(max_workers=workers) as pool:
+            results = pool.map(_compare_file, [str(f) for f in test_files],
+                               [reference] * len(test_files), [chunk_rows] * len(test_files),
+                               [keep_errors] * len(test_files))
+            return [s for file_stats in results for s in file_stats]
 
-            # RMS error
-            diff = test_data - ref_data
-            rms = np.sqrt(np.mean(diff ** 2))
-            errors[var] = rms
+    def rms_error(self, variable: Optional[str] = None) -> Dict[str, float]:
+        """
+        Calculate RMS error for variables
 
-        return errors
+        Args:
+            variable: Specific variable (if None, computes for all)
+
+        Returns:
+            Dictionary of variable -> RMS error
+        """
+        if variable:
+            return {variable: self.stats.rms[variable]} if variable in self.common_vars else {}
+        return dict(self.stats.rms)
 
     def max_error(self, variable: Optional[str] = None) -> Dict[str, float]:
         """
@@ -242,22 +458,32 @@ class TrajectoryComparator:
         Returns:
             Dictionary of variable -> max absolute error
         """
-        errors = {}
-
-        vars_to_check = [variable] if variable else self.common_vars
-
-        for var in vars_to_check:
-            if var not in self.common_vars:
-                continue
+        if variable:
+            return {variable: self.stats.max[variable]} if variable in self.common_vars else {}
+        return dict(self.stats.max)
 
-            test_data = self.test.data[var]
-            ref_data = self.reference_interp[var]
+    def error_series(self, variable: str) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Error time series of one variable (test - reference)
 
-            # Max absolute error
-            max_err = np.max(np.abs(test_data - ref_data))
-            errors[var] = max_err
+        Uses the series kept with 'keep_errors', otherwise makes one more pass
+        over the test data for this variable only.
 
-        return errors
+        Returns:
+            Test time points and errors
+        """
+        if variable not in self.common_vars:
+            raise KeyError(f"Variable '{variable}' not in both trajectories")
+        if self.stats.errors is not None:
+            return self.stats.time, self.stats.errors[variable]
+        if isinstance(self.test, Trajectory):
+            test_vars, chunks = self.test.variables, _trajectory_chunks(self.test, self.chunk_rows)
+        else:
+            reader = TrajectoryReader(self.test, self.chunk_rows)
+            test_vars, chunks = reader.variables, (c for c in reader if c.run == self.run)
+        acc = self._accumulate(chunks, test_vars, [variable], self.reference, keep_errors=True)
+        stats = acc.stats(self.run)
+        return stats.time, stats.errors[variable]
 
     def summary(self) -> str:
         """Generate comparison summary"""
@@ -294,6 +520,8 @@ class TrajectoryComparator:
             print("matplotlib not available for plotting")
             return
 
+        test = self.test if isinstance(self.test, Trajectory) else Trajectory.from_file(self.test, self.run)
+
         fig, axes = plt.subplots(len(variables), 1, figsize=(12, 4 * len(variables)))
         if len(variables) == 1:
             axes = [axes]
@@ -304,7 +532,7 @@ class TrajectoryComparator:
                         ha='center', va='center')
                 continue
 
-            ax.plot(self.test.time, self.test.data[var], 'b-', label='Test', linewidth=2)
+            ax.plot(test.time, test.data[var], 'b-', label='Test', linewidth=2)
             ax.plot(self.reference.time, self.reference.data[var], 'r--', label='Reference', linewidth=2)
             ax.set_ylabel(var)
             ax.legend()
@@ -312,8 +540,8 @@ class TrajectoryComparator:
 
             # Add error subplot
             ax2 = ax.twinx()
-            error = self.test.data[var] - self.reference_interp[var]
-            ax2.plot(self.test.time, error, 'g-', alpha=0.3, label='Error')
+            time, error = self.error_series(var)
+            ax2.plot(time, error, 'g-', alpha=0.3, label='Error')
             ax2.set_ylabel('Error', color='g')
             ax2.tick_params(axis='y', labelcolor='g')
 
@@ -321,3 +549,11 @@ class TrajectoryComparator:
         fig.suptitle('Trajectory Comparison: Test vs Reference')
         plt.tight_layout()
         plt.show()
+
+
+def _numeric(tokens: List[str]) -> bool:
+    try:
+        [float(x) for x in tokens]
+        return True
+    except ValueError:
+        return False
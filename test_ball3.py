@@ -33,9 +33,6 @@ def build_ball3():
     # Kinematics - 3DoF on flat Earth
     sim.add_component(Component.kinematics_3dof_flat())
 
-    # Dynamics - 3DoF force summation
-    sim.add_component(Component.forces_3dof())
-
     # Aerodynamics - simple drag
     sim.add_component(Component.drag_simple(
         cd=0.47,      # Drag coefficient (sphere)
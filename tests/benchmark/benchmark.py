@@ -0,0 +1,344 @@
+#!/usr/bin/env python3
+"""
+CADAC Example Benchmark Suite
+
+Builds every example listed in the root Makefile (EXAMPLES), runs its input.asc
+headless in a scratch workspace and records per example
+
+  - wall_time        best wall-clock time of the timed runs (sec)
+  - steps_per_sec    integration steps per wall-clock second
+  - peak_rss_kb      peak resident set size of the executable (kB)
+  - allocs_per_step  C++ heap allocations (operator new) per integration step
+  - output_bytes     total size of the files the run writes
+
+Integration steps are the final simulated time of plot1.asc divided by the
+'int_step' of the input deck, times the number of MONTE runs. Allocations and
+peak RSS come from one extra run with probe.so (probe.cpp) preloaded, so the
+timed runs are not slowed down by the counting.
+
+The metrics are compared against baseline.json. A metric is a regression if it
+is worse than the baseline by more than its tolerance (relative); output_bytes
+is checked in both directions, since a change there means the outputs changed.
+Timing differences under TIME_NOISE are ignored for the very short examples.
+Baselines are machine specific: refresh them with --update-baseline on the
+machine that tracks performance.
+
+Usage:
+    python3 tests/benchmark/benchmark.py
+    python3 tests/benchmark/benchmark.py ROCKET6G GHAME3 --repeat 5
+    python3 tests/benchmark/benchmark.py --report bench_report.json
+    python3 tests/benchmark/benchmark.py --update-baseline
+"""
+
+import argparse
+import json
+import os
+import platform
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+from dataclasses import asdict, dataclass, field
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+CADAC_ROOT = Path(__file__).resolve().parent.parent.parent
+BENCH_DIR = Path(__file__).resolve().parent
+BASELINE = BENCH_DIR / 'baseline.json'
+
+# metric -> (default relative tolerance, direction: +1 higher is better,
+# -1 lower is better, 0 any change counts)
+METRICS = {
+    'wall_time': (0.25, -1),
+    'steps_per_sec': (0.25, +1),
+    'peak_rss_kb': (0.10, -1),
+    'allocs_per_step': (0.05, -1),
+    'output_bytes': (0.01, 0),
+}
+
+# Timing differences below this are scheduler noise, whatever their ratio (sec)
+TIME_NOISE = 0.05
+
+
+@dataclass
+class ExampleResult:
+    """Benchmark outcome of one example"""
+    example: str
+    status: str
+    """'ok', 'build_failed', 'run_failed' or 'timeout'"""
+
+    metrics: Dict[str, float] = field(default_factory=dict)
+    steps: int = 0
+    runs: int = 1
+    error: str = ""
+    regressions: List[str] = field(default_factory=list)
+
+
+def makefile_examples() -> List[str]:
+    """EXAMPLES list of the root Makefile"""
+    text = (CADAC_ROOT / 'Makefile').read_text()
+    match = re.search(r'^EXAMPLES\s*=\s*(.+)$', text, re.MULTILINE)
+    if not match:
+        raise RuntimeError("EXAMPLES not found in root Makefile")
+    return match.group(1).split()
+
+
+def executable_name(example_dir: Path) -> str:
+    """TARGET of an example Makefile"""
+    text = (example_dir / 'Makefile').read_text()
+    match = re.search(r'^TARGET\s*=\s*(\S+)', text, re.MULTILINE)
+    return match.group(1) if match else example_dir.name.lower()
+
+
+def deck_timing(input_file: Path) -> Tuple[float, int]:
+    """Integration step and number of Monte Carlo runs of an input deck"""
+    text = input_file.read_text(errors='replace')
+    step = re.search(r'^\s*int_step\s+([-+.\deE]+)', text, re.MULTILINE)
+    if not step:
+        raise ValueError(f"{input_file}: no 'int_step' in TIMING block")
+    monte = re.search(r'^\s*MONTE\s+(\d+)', text, re.MULTILINE)
+    runs = max(int(monte.group(1)), 1) if monte else 1
+    return float(step.group(1)), runs
+
+
+def final_time(plot_file: Path) -> float:
+    """Largest time of a CADAC plot file (rows may wrap over several lines)"""
+    lines = plot_file.read_text(errors='replace').splitlines()
+    nvars = int(lines[1].split()[2])
+    tokens = []
+    for line in lines[2:]:
+        tokens.extend(line.split())
+    values = tokens[nvars:]
+    times = [float(values[k]) for k in range(0, len(values) - nvars + 1, nvars)]
+    return max(times) if times else 0.0
+
+
+def build_probe(build_dir: Path) -> Optional[Path]:
+    """Compile the measuring preload library"""
+    library = build_dir / 'probe.so'
+    result = subprocess.run(['g++', '-std=c++11', '-O2', '-shared', '-fPIC', '-o', str(library),
+                             str(BENCH_DIR / 'probe.cpp')],
+                            capture_output=True, text=True)
+    if result.returncode != 0:
+        print(f"  warning: probe.so not built, allocations and peak RSS not measured\n"
+              f"{result.stderr}")
+        return None
+    return library
+
+
+def read_probe(probe_file: Path) -> Dict[str, int]:
+    """Values written by probe.so on exit"""
+    values = {}
+    if probe_file.exists():
+        for line in probe_file.read_text().splitlines():
+            key, value = line.split()
+            values[key] = int(value)
+    return values
+
+
+def snapshot(workspace: Path) -> Dict[str, tuple]:
+    """Size and modification time of the workspace files (harness files start with '.')"""
+    return {p.name: (p.stat().st_size, p.stat().st_mtime_ns)
+            for p in workspace.iterdir() if p.is_file() and not p.name.startswith('.')}
+
+
+def run_once(executable: Path, workspace: Path, timeout: float,
+             env: Optional[Dict[str, str]] = None) -> float:
+    """
+    Run the executable headless in its workspace
+
+    Returns:
+        Wall time (sec)
+    """
+    stderr_file = workspace / '.stderr'
+    start = time.perf_counter()
+    with open(stderr_file, 'wb') as stderr:
+        process = subprocess.Popen([str(executable)], cwd=workspace, env=env,
+                                   stdin=subprocess.DEVNULL, stdout=subprocess.DEVNULL,
+                                   stderr=stderr)
+    deadline = start + timeout
+    while True:
+        pid, status = os.waitpid(process.pid, os.WNOHANG)
+        if pid:
+            break
+        if time.perf_counter() > deadline:
+            process.kill()
+            os.waitpid(process.pid, 0)
+            raise TimeoutError(f"timed out after {timeout:g} sec")
+        time.sleep(0.002)
+    wall = time.perf_counter() - start
+    process.returncode = os.waitstatus_to_exitcode(status)
+    if process.returncode != 0:
+        stderr = stderr_file.read_text(errors='replace')
+        raise RuntimeError(f"exit code {process.returncode}\n{stderr[-2000:]}")
+    return wall
+
+
+def benchmark_example(example: str, repeat: int, timeout: float,
+                      probe: Optional[Path]) -> ExampleResult:
+    """Build and run one example"""
+    example_dir = CADAC_ROOT / 'example' / example
+    build = subprocess.run(['make', '-C', str(example_dir)], capture_output=True, text=True)
+    if build.returncode != 0:
+        errors = [l for l in build.stderr.splitlines() if 'error' in l]
+        return ExampleResult(example, 'build_failed', error='\n'.join(errors[:10]))
+
+    executable = example_dir / executable_name(example_dir)
+    step, runs = deck_timing(example_dir / 'input.asc')
+    workspace = Path(tempfile.mkdtemp(prefix=f'bench-{example}-'))
+    try:
+        for deck in example_dir.glob('*.asc'):
+            shutil.copy(deck, workspace)
+        inputs = snapshot(workspace)
+
+        walls = [run_once(executable, workspace, timeout) for _ in range(repeat)]
+
+        outputs = {name: size for name, (size, mtime) in snapshot(workspace).items()
+                   if inputs.get(name, (None, None))[1] != mtime}
+        plot = workspace / 'plot1.asc'
+        sim_time = final_time(plot) if plot.exists() else 0.0
+        steps = int(round(sim_time / step)) * runs
+
+        probed = {}
+        if probe is not None:
+            probe_file = workspace / '.probe'
+            env = dict(os.environ, LD_PRELOAD=str(probe), CADAC_PROBE=str(probe_file))
+            run_once(executable, workspace, timeout, env)
+            probed = read_probe(probe_file)
+
+        wall = min(walls)
+        metrics = {
+            'wall_time': round(wall, 4),
+            'steps_per_sec': round(steps / wall, 1) if wall > 0 else 0.0,
+            'output_bytes': sum(outputs.values()),
+        }
+        if probed.get('peak_rss_kb', -1) > 0:
+            metrics['peak_rss_kb'] = probed['peak_rss_kb']
+        if 'allocations' in probed and steps:
+            metrics['allocs_per_step'] = round(probed['allocations'] / steps, 3)
+        return ExampleResult(example, 'ok', metrics, steps, runs)
+    except TimeoutError as e:
+        return ExampleResult(example, 'timeout', error=str(e))
+    except (RuntimeError, ValueError, IndexError) as e:
+        return ExampleResult(example, 'run_failed', error=str(e))
+    finally:
+        shutil.rmtree(workspace, ignore_errors=True)
+
+
+def compare(result: ExampleResult, baseline: dict, tolerances: Dict[str, float]):
+    """Record the metrics that regressed against the baseline entry"""
+    if not baseline:
+        return
+    if baseline.get('status') == 'ok' and result.status != 'ok':
+        result.regressions.append(f"status {result.status} (baseline ok)")
+        return
+    reference_wall = baseline.get('metrics', {}).get('wall_time', 0.0)
+    for metric, value in result.metrics.items():
+        reference = baseline.get('metrics', {}).get(metric)
+        if reference is None or metric not in METRICS:
+            continue
+        if metric in ('wall_time', 'steps_per_sec') and \
+                abs(result.metrics['wall_time'] - reference_wall) < TIME_NOISE:
+            continue
+        direction = METRICS[metric][1]
+        tolerance = tolerances[metric]
+        if reference == 0:
+            change = 0.0 if value == 0 else float('inf')
+        else:
+            change = (value - reference) / abs(reference)
+        worse = {+1: -change, -1: change, 0: abs(change)}[direction]
+        if worse > tolerance:
+            result.regressions.append(f"{metric} {value:g} vs baseline {reference:g} "
+                                      f"({change:+.1%}, tolerance {tolerance:.0%})")
+
+
+def machine_info() -> dict:
+    return {
+        'host': platform.node(),
+        'platform': platform.platform(),
+        'processor': platform.processor() or platform.machine(),
+        'cpus': os.cpu_count(),
+        'python': platform.python_version(),
+    }
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('examples', nargs='*', help="examples to run (default: root Makefile EXAMPLES)")
+    parser.add_argument('--repeat', type=int, default=3, help="timed runs per example (best is kept)")
+    parser.add_argument('--timeout', type=float, default=900, help="wall-clock limit per run (sec)")
+    parser.add_argument('--tolerance', type=float,
+                        help="relative tolerance for wall_time and steps_per_sec")
+    parser.add_argument('--baseline', type=Path, default=BASELINE, help="baseline file")
+    parser.add_argument('--update-baseline', action='store_true',
+                        help="write the results as the new baseline")
+    parser.add_argument('--report', type=Path, help="write a JSON report")
+    parser.add_argument('--no-probe', action='store_true',
+                        help="skip the run measuring allocations and peak RSS")
+    args = parser.parse_args()
+
+    examples = args.examples or makefile_examples()
+    baseline = json.loads(args.baseline.read_text()) if args.baseline.exists() else {}
+    tolerances = {m: t for m, (t, _) in METRICS.items()}
+    tolerances.update(baseline.get('tolerances', {}))
+    if args.tolerance is not None:
+        tolerances['wall_time'] = tolerances['steps_per_sec'] = args.tolerance
+
+    build_dir = Path(tempfile.mkdtemp(prefix='bench-'))
+    try:
+        probe = None if args.no_probe else build_probe(build_dir)
+        results = []
+        for example in examples:
+            print(f"{example:10s}", end=' ', flush=True)
+            result = benchmark_example(example, args.repeat, args.timeout, probe)
+            if not args.update_baseline:
+                compare(result, baseline.get('examples', {}).get(example, {}), tolerances)
+            results.append(result)
+            if result.status == 'ok':
+                m = result.metrics
+                print(f"{m['wall_time']:8.3f} s {m['steps_per_sec']:11.0f} steps/s "
+                      f"{m.get('peak_rss_kb', 0):8d} kB "
+                      f"{m.get('allocs_per_step', float('nan')):9.1f} allocs/step "
+                      f"{m['output_bytes']:10d} B")
+            else:
+                print(f"{result.status}: {result.error.splitlines()[0] if result.error else ''}")
+            for regression in result.regressions:
+                print(f"           REGRESSION {regression}")
+    finally:
+        shutil.rmtree(build_dir, ignore_errors=True)
+
+    report = {
+        'machine': machine_info(),
+        'date': time.strftime('%Y-%m-%dT%H:%M:%S'),
+        'tolerances': tolerances,
+        'examples': {r.example: {k: v for k, v in asdict(r).items() if k != 'example'} for r in results},
+        'regressions': sum(len(r.regressions) for r in results),
+    }
+    if args.report:
+        args.report.write_text(json.dumps(report, indent=2) + '\n')
+        print(f"\nReport written to {args.report}")
+
+    if args.update_baseline:
+        merged = baseline.get('examples', {}) if args.examples else {}
+        merged.update({name: {'status': entry['status'], 'metrics': entry['metrics']}
+                       for name, entry in report['examples'].items()})
+        args.baseline.write_text(json.dumps({
+            'machine': report['machine'],
+            'date': report['date'],
+            'tolerances': {m: t for m, (t, _) in METRICS.items()},
+            'examples': merged,
+        }, indent=2) + '\n')
+        print(f"\nBaseline written to {args.baseline}")
+        return 0
+
+    if report['regressions']:
+        print(f"\n{report['regressions']} regression(s) against {args.baseline}")
+        return 1
+    print("\nNo regressions" if baseline else f"\nNo baseline at {args.baseline}")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
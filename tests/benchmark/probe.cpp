@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+//FILE: 'probe.cpp'
+//
+// Preload library measuring a CADAC executable from the inside
+//
+// Replaces the global 'operator new' family (every Matrix temporary goes
+// through it) to count heap allocations, and on exit writes to the file named
+// by the environment variable CADAC_PROBE
+//
+//	allocations <number of operator new calls>
+//	peak_rss_kb <VmHWM of the process>
+//
+// VmHWM is read from /proc/self/status; unlike the rusage of the parent it
+// does not include the memory of the process that forked the executable.
+// Built and injected with LD_PRELOAD by 'benchmark.py'; the executables
+// themselves are unchanged.
+//
+// g++ -std=c++11 -O2 -shared -fPIC -o probe.so probe.cpp
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+static std::atomic<unsigned long long> allocations(0);
+
+static void *counted(std::size_t size)
+{
+	allocations.fetch_add(1,std::memory_order_relaxed);
+	return std::malloc(size?size:1);
+}
+
+void *operator new(std::size_t size)
+{
+	void *ptr=counted(size);
+	if(!ptr)throw std::bad_alloc();
+	return ptr;
+}
+void *operator new[](std::size_t size)
+{
+	void *ptr=counted(size);
+	if(!ptr)throw std::bad_alloc();
+	return ptr;
+}
+void *operator new(std::size_t size,const std::nothrow_t &)noexcept{return counted(size);}
+void *operator new[](std::size_t size,const std::nothrow_t &)noexcept{return counted(size);}
+void operator delete(void *ptr)noexcept{std::free(ptr);}
+void operator delete[](void *ptr)noexcept{std::free(ptr);}
+void operator delete(void *ptr,std::size_t)noexcept{std::free(ptr);}
+void operator delete[](void *ptr,std::size_t)noexcept{std::free(ptr);}
+
+///////////////////////////////////////////////////////////////////////////////
+//Peak resident set size in kB, -1 if /proc is not available
+///////////////////////////////////////////////////////////////////////////////
+static long peak_rss_kb()
+{
+	long peak=-1;
+	if(FILE *status=std::fopen("/proc/self/status","r")){
+		char line[256];
+		while(std::fgets(line,sizeof(line),status)){
+			if(std::strncmp(line,"VmHWM:",6)==0){
+				peak=std::atol(line+6);
+				break;
+			}
+		}
+		std::fclose(status);
+	}
+	return peak;
+}
+
+__attribute__((destructor))
+static void report()
+{
+	const char *path=std::getenv("CADAC_PROBE");
+	if(!path)return;
+	if(FILE *file=std::fopen(path,"w")){
+		std::fprintf(file,"allocations %llu\n",allocations.load());
+		std::fprintf(file,"peak_rss_kb %ld\n",peak_rss_kb());
+		std::fclose(file);
+	}
+}
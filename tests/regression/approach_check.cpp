@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////
+//FILE: 'approach_check.cpp'
+//Stand-alone check of 'closest_approach()' of the 'utility_functions.cpp' it
+// is linked with (AIM5, CRUISE5 or SRAAM6)
+//Built and run by 'tests/regression/test_intercept_convergence.py'
+//
+//A target point passes the origin on a straight line, closest at time 'THIT'
+// with miss vector 'MISS0'. The cubic between two states of a straight line is
+// the line itself, so
+//	- any step bracketing 'THIT' returns it and 'MISS0' to round-off
+//	- a step entirely before 'THIT' returns its end, one after it its start
+//Returns the number of failed checks.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "utility_header.hpp"
+
+const double THIT=0.1;	//time of closest approach - s
+const double TOL=1e-9;
+
+static int nfailed=0;
+
+///////////////////////////////////////////////////////////////////////////////
+//Writing the outcome of check 'name' to the console
+///////////////////////////////////////////////////////////////////////////////
+static void report(const char *name,bool ok)
+{
+	cout<<"  "<<(ok?"ok    ":"FAILED")<<"  "<<name<<'\n';
+	if(!ok) nfailed++;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Closest approach of the straight line over the step from 't0' to 't1';
+// returns the time of closest approach and its miss vector in 'MISS'
+///////////////////////////////////////////////////////////////////////////////
+static double approach(Matrix &MISS,double t0,double t1)
+{
+	Matrix MISS0(3,1),VREL(3,1);
+	MISS0.build_vec3(0,3,-4);
+	VREL.build_vec3(1000,20,15);	//normal to MISS0
+
+	Matrix SREL0=MISS0+VREL*(t0-THIT);
+	Matrix SREL1=MISS0+VREL*(t1-THIT);
+	return t0+closest_approach(MISS,SREL0,VREL,SREL1,VREL,t1-t0);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Main function of the check
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	Matrix MISS(3,1),MISS0(3,1);
+	MISS0.build_vec3(0,3,-4);
+	double t0(0),t1(0),thit(0);
+	bool ok(true);
+
+	//steps of different length and phase bracketing the closest approach
+	const int nstep=5;
+	const double steps[nstep]={0.0001,0.001,0.01,0.05,0.1};
+	const double phases[3]={0.1,0.5,0.9};
+	for(int i=0;i<nstep;i++){
+		for(int j=0;j<3;j++){
+			t0=THIT-phases[j]*steps[i];
+			thit=approach(MISS,t0,t0+steps[i]);
+			if(fabs(thit-THIT)>TOL||(MISS-MISS0).absolute()>TOL) ok=false;
+		}
+	}
+	report("straight line: time and miss independent of the step",ok);
+
+	//closest approach after the step: still closing at its end
+	t0=THIT-0.02;
+	t1=THIT-0.01;
+	thit=approach(MISS,t0,t1);
+	report("closing over the whole step: end of the step",fabs(thit-t1)<TOL);
+
+	//closest approach before the step: already opening at its start
+	t0=THIT+0.01;
+	t1=THIT+0.02;
+	thit=approach(MISS,t0,t1);
+	report("opening over the whole step: start of the step",fabs(thit-t0)<TOL);
+
+	return nfailed;
+}
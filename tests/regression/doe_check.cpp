@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////
+//FILE: 'doe_check.cpp'
+//Stand-alone check of the design of experiments (DOE) sampling of the
+// 'utility_functions.cpp' it is linked with (ADS6, AGM6, GHAME6 or ROCKET6G)
+//Built and run by 'tests/regression/test_doe_sampling.py'
+//
+//	- LHS: every dimension has exactly one sample in each of the 'nmonte' strata
+//	- ANTITHETIC: the unit samples of runs 2k and 2k+1 sum to 1
+//	- SOBOL: dimension 2, with the digital shift removed, reproduces the
+//	  reference points of Joe and Kuo (gray-code order)
+//	- all designs: the samples of run k are the same whether or not the
+//	  runs before it were executed
+//Returns the number of failed checks.
+//'doe_check nmonte' only initializes an ANTITHETIC design of 'nmonte' runs
+// (rejected if 'nmonte' is odd).
+///////////////////////////////////////////////////////////////////////////////
+
+#include "utility_header.hpp"
+
+const int NMONTE=40;
+const int NDIM=25;	//beyond the 21 Sobol dimensions
+
+static int nfailed=0;
+
+///////////////////////////////////////////////////////////////////////////////
+//Writing the outcome of check 'name' to the console
+///////////////////////////////////////////////////////////////////////////////
+static void report(const char *name,bool ok)
+{
+	cout<<"  "<<(ok?"ok    ":"FAILED")<<"  "<<name<<'\n';
+	if(!ok) nfailed++;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Unit samples u[nmc*NDIM+dim] of all runs of 'method', executed in order
+///////////////////////////////////////////////////////////////////////////////
+static void design(double *u,const char *method,int nmonte)
+{
+	doe_initialize(method,nmonte,1234);
+	for(int nmc=0;nmc<nmonte;nmc++){
+		doe_run(nmc);
+		for(int dim=0;dim<NDIM;dim++) u[nmc*NDIM+dim]=doe_unituni();
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//True if each run of 'u' is reproduced by a fresh design that executes only
+// that run
+///////////////////////////////////////////////////////////////////////////////
+static bool independent(const double *u,const char *method,int nmonte)
+{
+	for(int nmc=nmonte-1;nmc>=0;nmc--){
+		doe_initialize(method,nmonte,1234);
+		doe_run(nmc);
+		for(int dim=0;dim<NDIM;dim++)
+			if(doe_unituni()!=u[nmc*NDIM+dim]) return false;
+	}
+	return true;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Main function of the check
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc,char **argv)
+{
+	if(argc>1){
+		doe_initialize("ANTITHETIC",atoi(argv[1]),1234);
+		return 0;
+	}
+	double *u=new double[NMONTE*NDIM];
+	int *count=new int[NMONTE];
+	int nmc(0),dim(0);
+	bool ok(true);
+
+	//Latin hypercube
+	design(u,"LHS",NMONTE);
+	for(dim=0;dim<NDIM;dim++){
+		for(nmc=0;nmc<NMONTE;nmc++) count[nmc]=0;
+		for(nmc=0;nmc<NMONTE;nmc++){
+			double x=u[nmc*NDIM+dim];
+			if(x<=0||x>=1) {ok=false;break;}
+			count[(int)(x*NMONTE)]++;
+		}
+		for(nmc=0;nmc<NMONTE;nmc++)
+			if(count[nmc]!=1) ok=false;
+	}
+	report("LHS: one sample per stratum in every dimension",ok);
+	report("LHS: run k independent of runs 1...k-1",independent(u,"LHS",NMONTE));
+
+	//antithetic pairs
+	design(u,"ANTITHETIC",NMONTE);
+	ok=true;
+	for(nmc=0;nmc<NMONTE;nmc+=2)
+		for(dim=0;dim<NDIM;dim++)
+			if(fabs(u[nmc*NDIM+dim]+u[(nmc+1)*NDIM+dim]-1)>1e-15) ok=false;
+	report("ANTITHETIC: pairs sum to 1",ok);
+	report("ANTITHETIC: run k independent of runs 1...k-1",independent(u,"ANTITHETIC",NMONTE));
+
+	//Sobol dimension 2: the first point is the shift itself
+	const int nref=10;
+	const double ref[nref]={0,0.5,0.25,0.75,0.375,0.875,0.125,0.625,0.3125,0.8125};
+	design(u,"SOBOL",NMONTE);
+	unsigned shift=(unsigned)(u[1]*4294967296.);
+	ok=true;
+	for(nmc=0;nmc<nref;nmc++){
+		unsigned x=(unsigned)(u[nmc*NDIM+1]*4294967296.)^shift;
+		if(x/4294967296.!=ref[nmc]) ok=false;
+	}
+	report("SOBOL: dimension 2 reproduces the Joe-Kuo points",ok);
+	report("SOBOL: run k independent of runs 1...k-1",independent(u,"SOBOL",NMONTE));
+
+	delete [] u;
+	delete [] count;
+	return nfailed;
+}
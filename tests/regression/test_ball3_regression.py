@@ -7,8 +7,6 @@ run, and validate the BALL3 ballistic simulation against a reference trajectory.
 """
 
 import sys
-import shutil
-import subprocess
 from pathlib import Path
 import numpy as np
 
@@ -43,7 +41,6 @@ class BALL3Test:
         # Add components in correct order
         sim.add_component(Component.time_management())
         sim.add_component(Component.kinematics_3dof_flat())
-        sim.add_component(Component.forces_3dof())
         sim.add_component(Component.drag_simple(cd=0.47, area=0.01))
         sim.add_component(Component.gravity_constant(grav=9.81))
         sim.add_component(Component.atmosphere_constant(rho=1.225))
@@ -79,263 +76,57 @@ class BALL3Test:
 
         return sim
 
-    def setup_build_environment(self):
-        """Copy necessary framework files for compilation"""
+    def compile_simulation(self, sim: Simulation) -> bool:
+        """Assemble the simulation from its components and compile it"""
         print("\n" + "="*60)
-        print("STEP 2: Setting up build environment")
+        print("STEP 2: Compiling simulation from components")
         print("="*60)
 
-        # Copy framework files from example
-        framework_files = [
-            'class_hierarchy.hpp',
-            'global_header.hpp',
-            'global_constants.hpp',
-            'utility_header.hpp',
-            'utility_functions.cpp',
-            'global_functions.cpp',
-            'class_functions.cpp',
-            'execution.cpp'
-        ]
-
-        for file in framework_files:
-            src = self.example_dir / file
-            dst = self.test_dir / file
-            if src.exists():
-                shutil.copy2(src, dst)
-                print(f"  ✓ Copied {file}")
-            else:
-                print(f"  ⚠ Warning: {file} not found in example")
-
-    def create_ball_functions(self):
-        """Create ball_functions.cpp with executive functions"""
-        print("\n" + "="*60)
-        print("STEP 3: Creating ball_functions.cpp")
-        print("="*60)
-
-        # Copy the executive functions from example, but note that module functions
-        # come from our adapted component files
-        example_ball = self.example_dir / 'ball_functions.cpp'
-
-        if not example_ball.exists():
-            print(f"  ⚠ Warning: Example ball_functions.cpp not found, creating minimal version")
-            ball_content = """//==============================================================================
-// BALL3 - Built from modular components via CADAC Builder
-//==============================================================================
-#include "class_hierarchy.hpp"
-
-// Note: Module function implementations (def_xxx, init_xxx, xxx) are provided by
-// the adapted component files. This file only needs to exist for linking.
-// Executive functions come from class_functions.cpp.
-"""
-        else:
-            # Read example and extract only executive functions
-            # Module functions will come from our components
-            content = example_ball.read_text()
-
-            # Keep everything except module function implementations
-            # We'll use adapted components for those
-            ball_content = content
-
-        ball_file = self.test_dir / 'ball_functions.cpp'
-        ball_file.write_text(ball_content)
-        print(f"✓ Created ball_functions.cpp")
-
-    def compile_simulation(self) -> bool:
-        """Compile the simulation"""
-        print("\n" + "="*60)
-        print("STEP 4: Compiling simulation")
-        print("="*60)
-
-        # Copy component files
-        component_dir = self.cadac_root / 'components'
-
-        # Map components to their files
-        components_needed = [
-            'kinematics/kinematics_3dof_flat.cpp',
-            'dynamics/forces_3dof.cpp',
-            'aerodynamics/drag_simple.cpp',
-            'environment/gravity_constant.cpp',
-            'environment/atmosphere_constant.cpp',
-            'utilities/time_management.cpp',
-            'utilities/termination.cpp',
-        ]
-
-        print("Creating adapted module files from components...")
-
-        # Just copy and adapt the kinematics component directly
-        kin_src = component_dir / 'kinematics/kinematics_3dof_flat.cpp'
-        kin_content = kin_src.read_text().replace('Vehicle::', 'Ball::').replace('vehicle[', 'ball[')
-        (self.test_dir / 'kinematics.cpp').write_text(kin_content)
-        print(f"  ✓ kinematics.cpp (from kinematics_3dof_flat)")
-
-        # Create merged environment module (gravity + atmosphere)
-        env_content = """// Merged environment module
-#include "class_hierarchy.hpp"
-
-void Ball::def_environment()
-{
-    // From gravity_constant
-    ball[0].init("grav","D",0,"Gravity acceleration - m/s^2","environment","out","");
-
-    // From atmosphere_constant
-    ball[12].init("rho",0,"Air density - kg/m^3","out","","");
-}
-
-void Ball::environment(double int_step)
-{
-    // From gravity_constant and atmosphere_constant
-    double grav=9.81; // constant gravity
-    double rho=1.225; // constant atmosphere
-
-    ball[0].gets(grav);
-    ball[12].gets(rho);
-}
-"""
-        (self.test_dir / 'environment.cpp').write_text(env_content)
-        print(f"  ✓ environment.cpp (merged gravity + atmosphere)")
-
-        # Create merged forces module (forces_3dof + drag_simple)
-        forces_content = """// Merged forces module
-#include "class_hierarchy.hpp"
-
-void Ball::def_forces()
-{
-    // Variable definitions from forces_3dof and drag_simple
-    ball[10].init("cd",0,"Drag coefficient - ND","data","","");
-    ball[11].init("area",0,"Reference area - m^2","data","","");
-    ball[13].init("dvbe",0,"Speed - m/s","out","scrn","plot");
-    ball[14].init("FSPA",0,0,0,"Specific force in body frame - m/s^2","forces","out","");
-}
-
-void Ball::forces(double int_step)
-{
-    // Read parameters
-    double cd=ball[10].real();
-    double area=ball[11].real();
-    double grav=ball[0].real();
-    double rho=ball[12].real();
-
-    // Read velocity
-    Matrix VBEL=ball[21].vec();
-
-    // Calculate speed
-    double dvbe=VBEL.absolute();
-    ball[13].gets(dvbe);
-
-    // Calculate drag force
-    Matrix FSPB(3,1);
-    if(dvbe>0.01) {
-        double q=0.5*rho*dvbe*dvbe; // dynamic pressure
-        Matrix drag_dir = VBEL * (-1.0/dvbe); // opposite to velocity
-        Matrix FDRAG = drag_dir * (q * cd * area / 1.0); // assuming unit mass
-        FSPB = FDRAG;
-    }
-
-    // Add gravity
-    FSPB[2] = FSPB[2] + grav; // down direction
-
-    ball[14].gets_vec(FSPB);
-}
-"""
-        (self.test_dir / 'forces.cpp').write_text(forces_content)
-        print(f"  ✓ forces.cpp (merged forces + drag)")
-
-        # Compile with merged module files
-        print("\nCompiling...")
-        compile_cmd = [
-            'g++',
-            '-std=c++11',
-            '-O2',
-            '-Wno-write-strings',  # Suppress string literal warnings
-            '-Wno-conversion-null',  # Suppress NULL conversion warnings
-            '-Wno-format-overflow',  # Suppress format warnings from framework
-            'ball_functions.cpp',
-            'class_functions.cpp',
-            'execution.cpp',
-            'global_functions.cpp',
-            'utility_functions.cpp',
-            # Merged module files
-            'environment.cpp',
-            'kinematics.cpp',
-            'forces.cpp',
-            '-o', 'ball3',
-            '-I', str(self.test_dir)
-        ]
-
         try:
-            result = subprocess.run(
-                compile_cmd,
-                cwd=self.test_dir,
-                capture_output=True,
-                text=True,
-                timeout=60
-            )
-
-            if result.returncode != 0:
-                print(f"❌ Compilation failed:")
-                print(result.stderr)
-                return False
-
+            sim.compile()
             print("✓ Compilation successful")
             return True
-
-        except Exception as e:
-            print(f"❌ Compilation error: {e}")
+        except (RuntimeError, ValueError) as e:
+            print(f"❌ Compilation failed:\n{e}")
             return False
 
-    def run_simulation(self) -> bool:
+    def run_simulation(self, sim: Simulation) -> bool:
         """Run the compiled simulation"""
         print("\n" + "="*60)
-        print("STEP 5: Running simulation")
+        print("STEP 3: Running simulation")
         print("="*60)
 
-        executable = self.test_dir / 'ball3'
-        if not executable.exists():
-            print("❌ Executable not found")
-            return False
-
         try:
-            result = subprocess.run(
-                [str(executable)],
-                cwd=self.test_dir,
-                capture_output=True,
-                text=True,
-                timeout=30
-            )
-
-            print("Simulation output:")
-            print(result.stdout[:500])  # Print first 500 chars
-
-            # Check for output files
-            output_files = list(self.test_dir.glob('*.asc'))
-            print(f"\n✓ Generated {len(output_files)} output files:")
-            for f in output_files:
-                if f.name != 'input.asc':
-                    print(f"  - {f.name} ({f.stat().st_size} bytes)")
-
-            return True
-
-        except Exception as e:
+            sim.run()
+        except RuntimeError as e:
             print(f"❌ Execution error: {e}")
             return False
 
+        # Runs happen in the executable's directory
+        output_files = list((self.test_dir / 'build').glob('*.asc'))
+        print(f"\n✓ Generated {len(output_files)} output files:")
+        for f in output_files:
+            if f.name != 'input.asc':
+                print(f"  - {f.name} ({f.stat().st_size} bytes)")
+        return True
+
     def compare_results(self) -> dict:
         """Compare test results with reference"""
         print("\n" + "="*60)
-        print("STEP 6: Comparing with reference trajectory")
+        print("STEP 4: Comparing with reference trajectory")
         print("="*60)
 
         # Find test trajectory - BALL3 generates plot1.asc
-        test_traj_file = self.test_dir / 'plot1.asc'
+        test_traj_file = self.test_dir / 'build' / 'plot1.asc'
         if not test_traj_file.exists():
             # Check if any plot files exist
-            plot_files = list(self.test_dir.glob('plot*.asc'))
+            plot_files = list((self.test_dir / 'build').glob('plot*.asc'))
             if plot_files:
                 test_traj_file = plot_files[0]
                 print(f"Using trajectory file: {test_traj_file.name}")
             else:
                 print("❌ Test trajectory not found")
-                print(f"Looking for plot1.asc or plot*.asc in {self.test_dir}")
+                print(f"Looking for plot1.asc or plot*.asc in {self.test_dir / 'build'}")
                 return {'success': False, 'error': 'No trajectory file'}
 
         if not self.reference_traj.exists():
@@ -431,60 +222,17 @@ void Ball::forces(double int_step)
             print("\n❌ TEST FAILED: Could not build simulation")
             return False
 
-        # Generate input file (but we'll override it with correct format)
-        input_file = sim.generate_input_file()
-
-        # Override with correct BALL3 format matching framework expectations
-        correct_input = f"""TITLE BALL3 - Built from modular components via CADAC Builder
-OPTIONS y_scrn n_events n_tabout y_plot n_merge y_doc n_comscrn n_traj
-MODULES
-\tenvironment\t\tdef,exec
-\tkinematics\t\tdef,init,exec
-\tforces\t\t\tdef,exec
-END
-TIMING
-\tscrn_step 0.5
-\tplot_step 0.05
-\tint_step 0.01
-END
-VEHICLES 1
-\tBALL BALL3_TEST
-\t\t//Initial position (meters)
-\t\t\tsbel1  0.0
-\t\t\tsbel2  0.0
-\t\t\tsbel3  0.0
-\t\t//Initial velocity (m/s) - 45 degree launch at 50 m/s
-\t\t\tvbel1  35.36
-\t\t\tvbel2  0.0
-\t\t\tvbel3  -35.36
-\t\t//Aerodynamic properties
-\t\t\tcd  0.47
-\t\t\tarea  0.01
-\tEND
-ENDTIME 10
-STOP
-"""
-        input_file_path = self.test_dir / 'input.asc'
-        input_file_path.write_text(correct_input)
-        print(f"\n✓ Generated input file: {input_file_path}")
-
-        # Step 2: Setup build environment
-        self.setup_build_environment()
-
-        # Step 3: Create ball_functions file
-        self.create_ball_functions()
-
-        # Step 4: Compile
-        if not self.compile_simulation():
+        # Step 2: Compile
+        if not self.compile_simulation(sim):
             print("\n❌ TEST FAILED: Compilation failed")
             return False
 
-        # Step 5: Run
-        if not self.run_simulation():
+        # Step 3: Run
+        if not self.run_simulation(sim):
             print("\n❌ TEST FAILED: Execution failed")
             return False
 
-        # Step 6: Compare
+        # Step 4: Compare
         results = self.compare_results()
 
         # Final verdict
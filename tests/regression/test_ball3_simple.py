@@ -38,7 +38,6 @@ def main():
     # Add components
     sim.add_component(Component.time_management())
     sim.add_component(Component.kinematics_3dof_flat())
-    sim.add_component(Component.forces_3dof())
     sim.add_component(Component.drag_simple(cd=0.47, area=0.01))
     sim.add_component(Component.gravity_constant(grav=9.81))
     sim.add_component(Component.atmosphere_constant(rho=1.225))
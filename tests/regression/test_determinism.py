@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""
+Determinism Regression Test
+
+Runs every example of the root Makefile whose input deck has a MONTE block
+once alone and twice concurrently, and requires all output streams (plot,
+traj, stat, tabout) to be bitwise identical. See tools/determinism.py.
+"""
+
+import re
+import subprocess
+import sys
+from pathlib import Path
+
+CADAC_ROOT = Path(__file__).resolve().parent.parent.parent
+sys.path.insert(0, str(CADAC_ROOT / 'tools'))
+
+import determinism
+
+# Candidate runs executed concurrently against the serial reference
+JOBS = 2
+
+
+def monte_examples():
+    """Examples of the root Makefile whose input.asc has a MONTE block"""
+    text = (CADAC_ROOT / 'Makefile').read_text()
+    examples = re.search(r'^EXAMPLES\s*=\s*(.+)$', text, re.MULTILINE).group(1).split()
+    return [e for e in examples if determinism.has_monte(e)]
+
+
+def main():
+    print("\n" + "="*70)
+    print(" DETERMINISM TEST - serial vs concurrent runs, bitwise")
+    print("="*70)
+
+    passed, failed, skipped = [], [], []
+    for example in monte_examples():
+        print(f"\n{example}")
+        build = subprocess.run(['make', '-C', str(determinism.EXAMPLE_DIR / example)],
+                               capture_output=True, text=True)
+        if build.returncode != 0:
+            print("  ⚠ SKIPPED: does not build")
+            skipped.append(example)
+            continue
+        try:
+            report = determinism.check(example, jobs=JOBS, mode='bitwise')
+        except RuntimeError as e:
+            print(f"  ❌ run failed: {e}")
+            failed.append(example)
+            continue
+        print('  ' + determinism.format_report(report).replace('\n', '\n  '))
+        (passed if report.deterministic else failed).append(example)
+
+    print("\n" + "="*70)
+    if failed:
+        print(f" ❌ TEST FAILED - not deterministic: {', '.join(failed)}")
+    else:
+        print(f" ✅ TEST PASSED - deterministic: {', '.join(passed)}")
+    if skipped:
+        print(f" skipped (build failure): {', '.join(skipped)}")
+    print("="*70)
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
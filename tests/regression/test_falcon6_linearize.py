@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""
+FALCON6 Linearization Test
+
+Runs the FALCON6 deck 'f16lin.asc', whose 'LINEARIZE' block requests linear
+pitch models xd=A*x+B*u, y=C*x+D*u at two design times and at every event,
+and checks that
+  - a model is written for each design time and event, with finite entries
+    and an elevator column B that is not zero;
+  - the models do not depend on the perturbation size: the run is repeated
+    with 'DELTA 1e-4' and every entry must agree within the tolerance;
+  - the linearization does not touch the trajectory: 'plot1.asc' is the same
+    as that of the deck without the block;
+  - 'document_input()' copies the block through 'END' as it stands when it
+    rewrites 'input.asc'.
+"""
+
+import math
+import re
+import shutil
+import subprocess
+import sys
+from pathlib import Path
+
+CADAC_ROOT = Path(__file__).resolve().parent.parent.parent
+sys.path.insert(0, str(CADAC_ROOT / 'tools'))
+
+import determinism
+
+EXAMPLE = 'FALCON6'
+DECK = 'f16lin.asc'
+DESIGN_TIMES = [1.0, 5.0]
+EVENTS = 2
+# relative agreement of the models at DELTA 1e-5 and 1e-4
+TOLERANCE = 1e-5
+
+_BLOCK_RE = re.compile(r'^\s*LINEARIZE\b.*?^\s*END\b[^\n]*\n', re.MULTILINE | re.DOTALL)
+
+
+def run(text: str) -> dict:
+    """Run the deck 'text' and return the console and the files written"""
+    example_dir = determinism.EXAMPLE_DIR / EXAMPLE
+    workspace = determinism.prepare_workspace(example_dir, DECK, None)
+    try:
+        (workspace / 'input.asc').write_text(text)
+        executable = example_dir / determinism._target(example_dir)
+        result = subprocess.run([str(executable)], cwd=workspace, stdin=subprocess.DEVNULL,
+                                capture_output=True, text=True, timeout=600)
+        files = {name: (workspace / name).read_text(errors='replace')
+                 for name in ('input.asc', 'plot1.asc', 'lin.asc')
+                 if (workspace / name).exists()}
+        files['console'] = result.stdout + result.stderr
+        return files
+    finally:
+        shutil.rmtree(workspace, ignore_errors=True)
+
+
+def models(text: str) -> list:
+    """(time, {'A': rows, 'B': rows, 'C': rows, 'D': rows}) of every model in 'lin.asc'"""
+    result = []
+    lines = text.splitlines()
+    i = 0
+    while i < len(lines):
+        match = re.match(r'LINEAR\s+time\s*=\s*(\S+)', lines[i])
+        i += 1
+        if not match:
+            continue
+        matrices = {}
+        while i < len(lines) and lines[i].strip() != 'END':
+            head = lines[i].split()
+            i += 1
+            if len(head) == 3 and head[0] in 'ABCD':
+                rows = int(head[1])
+                matrices[head[0]] = [[float(v) for v in lines[i + r].split()] for r in range(rows)]
+                i += rows
+        result.append((float(match.group(1)), matrices))
+    return result
+
+
+def main():
+    print("\n" + "="*70)
+    print(" FALCON6 LINEARIZATION TEST - 'LINEARIZE' block of f16lin.asc")
+    print("="*70)
+
+    build = subprocess.run(['make', '-C', str(determinism.EXAMPLE_DIR / EXAMPLE)],
+                           capture_output=True, text=True)
+    if build.returncode != 0:
+        print(f"\n ❌ TEST FAILED - {EXAMPLE} does not build")
+        return 1
+
+    deck = (determinism.EXAMPLE_DIR / EXAMPLE / DECK).read_text(errors='replace')
+    block = _BLOCK_RE.search(deck).group(0)
+    failed = []
+
+    def check(name, ok, detail=''):
+        print(f"  {name:<52} {'✓' if ok else '❌'} {detail}")
+        if not ok:
+            failed.append(name)
+
+    nominal = run(deck)
+    coarse = run(deck.replace(block, re.sub(r'^(\s*)END\b', r'\1DELTA 1e-4\n\g<0>', block,
+                                            flags=re.MULTILINE)))
+    plain = run(deck.replace(block, ''))
+
+    found = models(nominal.get('lin.asc', ''))
+    times = [t for t, _ in found]
+    print(f"\n  models at {', '.join(f'{t:g}' for t in times)} sec")
+    check("one model per design time and event", len(found) == len(DESIGN_TIMES) + EVENTS
+          and all(t in times for t in DESIGN_TIMES))
+    entries = [v for _, m in found for rows in m.values() for row in rows for v in row]
+    check("all entries finite", entries and all(math.isfinite(v) for v in entries))
+    check("elevator column B not zero", found and all(any(row[0] for row in m['B']) for _, m in found))
+
+    error = 0.0
+    others = models(coarse.get('lin.asc', ''))
+    same_points = [t for t, _ in others] == times
+    if same_points:
+        for (_, m), (_, n) in zip(found, others):
+            for key in 'ABCD':
+                scale = max(abs(v) for row in m[key] for v in row) or 1.0
+                for row_m, row_n in zip(m[key], n[key]):
+                    for a, b in zip(row_m, row_n):
+                        error = max(error, abs(a - b) / scale)
+    check("models independent of DELTA", same_points and error <= TOLERANCE, f"max rel. error {error:.1e}")
+
+    def body(plot):
+        return plot.splitlines()[1:]
+    check("trajectory unchanged by the block", 'plot1.asc' in nominal and
+          body(nominal['plot1.asc']) == body(plain.get('plot1.asc', '')))
+
+    rewritten = _BLOCK_RE.search(nominal.get('input.asc', ''))
+    check("block copied verbatim by document_input()", rewritten is not None and rewritten.group(0) == block)
+    check("no 'Check spelling' marks", 'Check spelling' not in nominal.get('input.asc', 'Check spelling'))
+
+    print("\n" + "="*70)
+    if failed:
+        print(f" ❌ TEST FAILED - {', '.join(failed)}")
+    else:
+        print(" ✅ TEST PASSED - linear models consistent, trajectory and deck untouched")
+    print("="*70)
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
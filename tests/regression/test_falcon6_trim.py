@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+"""
+FALCON6 Trim Test
+
+Runs the FALCON6 deck 'f16trim.asc', whose 'TRIM' block solves the initial
+angle of attack, pitch angle, throttle, engine power and elevator for steady
+level flight under the Mach hold (mprop=2), and checks that
+  - the trim converges below its tolerance;
+  - the trimmed point is level flight (pitch angle equal to angle of attack)
+    with the throttle inside the Mach hold limits;
+  - the Mach hold keeps the trimmed throttle: the speed stays at its initial
+    value until the first event, while without the block the hold drives the
+    throttle to its limit;
+  - the residuals are within the tolerance at the start of the run: a
+    'LINEARIZE' block at time 0 writes the state derivatives of the vehicle as
+    initialized with the trimmed values;
+  - 'document_input()' copies the block through 'END' as it stands when it
+    rewrites 'input.asc';
+  - decks without a 'TRIM' block are unchanged: 'plot1.asc' of 'f16c09_7.asc'
+    is compared as written, every 50 records, with the output of the build
+    before the trim in 'reference/falcon6_f16c09_7_reference.asc'.
+
+'--write-reference' rewrites the reference from the current build.
+"""
+
+import re
+import shutil
+import subprocess
+import sys
+from pathlib import Path
+
+CADAC_ROOT = Path(__file__).resolve().parent.parent.parent
+sys.path.insert(0, str(CADAC_ROOT / 'tools'))
+
+import determinism
+
+EXAMPLE = 'FALCON6'
+DECK = 'f16trim.asc'
+SPEED = 180.0
+FIRST_EVENT = 2.0
+# speed excursion before the first event - m/s
+SPEED_TOLERANCE = 0.5
+# state derivatives of the residuals at time 0, written to 'lin.asc'
+RESIDUAL_CHECK = """\t\tLINEARIZE lin.asc
+\t\t\tSTATES VBEB1 VBEB3 SBEL3 power WBEB2
+\t\t\tCONTROLS delex
+\t\t\tHOLD control actuator
+\t\t\tTIMES 0
+\t\tEND
+"""
+PLAIN_DECK = 'f16c09_7.asc'
+REFERENCE = Path(__file__).resolve().parent / 'reference' / 'falcon6_f16c09_7_reference.asc'
+# every 'EVERY'-th plot record and the last one
+EVERY = 50
+
+_BLOCK_RE = re.compile(r'^\s*TRIM\b.*?^\s*END\b[^\n]*\n', re.MULTILINE | re.DOTALL)
+_TRIM_RE = re.compile(r'Trim of.*?(\d+) iterations.*?max residual = (\S+) \*\*\*')
+_VALUE_RE = re.compile(r'^\t(\w+) = (\S+)', re.MULTILINE)
+
+
+def run(text: str) -> dict:
+    """Run the deck 'text' and return the console and the files written"""
+    example_dir = determinism.EXAMPLE_DIR / EXAMPLE
+    workspace = determinism.prepare_workspace(example_dir, DECK, None)
+    try:
+        (workspace / 'input.asc').write_text(text)
+        executable = example_dir / determinism._target(example_dir)
+        result = subprocess.run([str(executable)], cwd=workspace, stdin=subprocess.DEVNULL,
+                                capture_output=True, text=True, timeout=600)
+        files = {name: (workspace / name).read_text(errors='replace')
+                 for name in ('input.asc', 'plot1.asc', 'lin.asc')
+                 if (workspace / name).exists()}
+        files['console'] = result.stdout + result.stderr
+        return files
+    finally:
+        shutil.rmtree(workspace, ignore_errors=True)
+
+
+def plot_column(text: str, name: str) -> list:
+    """(time, value) of variable 'name' in 'plot1.asc'"""
+    lines = text.splitlines()
+    count = int(lines[1].split()[2])
+    tokens = ' '.join(lines[2:]).split()
+    names = tokens[:count]
+    values = [float(v) for v in tokens[count:]]
+    k = names.index(name)
+    return [(values[i], values[i + k]) for i in range(0, len(values) - count + 1, count)]
+
+
+def derivatives(lin: str) -> dict:
+    """State derivatives of the first nominal point in 'lin.asc'"""
+    lines = lin.splitlines()
+    for i, line in enumerate(lines):
+        if line.startswith('STATES'):
+            count = int(line.split()[1])
+            return {fields[0]: float(fields[2])
+                    for fields in (row.split() for row in lines[i + 1:i + 1 + count])}
+    return {}
+
+
+def table(plot: str) -> list:
+    """Rows of all values, as written, of every 'EVERY'-th record and the last"""
+    lines = plot.splitlines()
+    count = int(lines[1].split()[2])
+    tokens = ' '.join(lines[2:]).split()
+    values = tokens[count:]
+    records = len(values) // count
+    picked = list(range(0, records, EVERY))
+    if picked[-1] != records - 1:
+        picked.append(records - 1)
+    return [tokens[:count]] + [values[r * count:(r + 1) * count] for r in picked]
+
+
+def main():
+    print("\n" + "="*70)
+    print(" FALCON6 TRIM TEST - 'TRIM' block of f16trim.asc")
+    print("="*70)
+
+    build = subprocess.run(['make', '-C', str(determinism.EXAMPLE_DIR / EXAMPLE)],
+                           capture_output=True, text=True)
+    if build.returncode != 0:
+        print(f"\n ❌ TEST FAILED - {EXAMPLE} does not build")
+        return 1
+
+    plain_deck = (determinism.EXAMPLE_DIR / EXAMPLE / PLAIN_DECK).read_text(errors='replace')
+    rows = table(run(plain_deck).get('plot1.asc', ''))
+    if '--write-reference' in sys.argv:
+        with open(REFERENCE, 'w') as f:
+            f.write(f"FALCON6 {PLAIN_DECK}: 'plot1.asc' every {EVERY} records and the last\n")
+            for row in rows:
+                f.write(' '.join(row) + '\n')
+        print(f"\n reference written: {REFERENCE.name} ({len(rows) - 1} records)")
+        return 0
+
+    deck = (determinism.EXAMPLE_DIR / EXAMPLE / DECK).read_text(errors='replace')
+    block = _BLOCK_RE.search(deck).group(0)
+    failed = []
+
+    def check(name, ok, detail=''):
+        print(f"  {name:<52} {'✓' if ok else '❌'} {detail}")
+        if not ok:
+            failed.append(name)
+
+    trimmed = run(deck)
+    plain = run(deck.replace(block, ''))
+
+    match = _TRIM_RE.search(trimmed['console'])
+    check("trim converged", match is not None and float(match.group(2)) <= 1e-6,
+          f"{match.group(1)} iterations, max residual {match.group(2)}" if match else
+          trimmed['console'].strip().splitlines()[-1:])
+    values = {name: float(value) for name, value in _VALUE_RE.findall(trimmed['console'])}
+    for name, value in values.items():
+        print(f"      {name:<10} = {value:g}")
+    check("level flight: thtblx = alpha0x",
+          {'thtblx', 'alpha0x'} <= values.keys() and abs(values['thtblx'] - values['alpha0x']) < 1e-6)
+    check("throttle inside the Mach hold limits 0...0.77", 0 < values.get('throttle', -1) < 0.77)
+
+    def excursion(run_output):
+        if 'plot1.asc' not in run_output:
+            return float('inf')
+        speeds = [v for t, v in plot_column(run_output['plot1.asc'], 'dvbe') if t < FIRST_EVENT - 1e-3]
+        return max(abs(v - SPEED) for v in speeds)
+    held, free = excursion(trimmed), excursion(plain)
+    check("Mach hold keeps the trimmed speed", held <= SPEED_TOLERANCE,
+          f"{held:.3f} m/s (untrimmed {free:.3f} m/s)")
+
+    residual_deck = deck.replace(block, RESIDUAL_CHECK + block)
+    start = derivatives(run(residual_deck).get('lin.asc', ''))
+    untrimmed = derivatives(run(residual_deck.replace(block, '')).get('lin.asc', ''))
+    for name, value in start.items():
+        print(f"      {name + 'D':<10} = {value:<14.6g} (untrimmed {untrimmed.get(name, float('nan')):.6g})")
+    check("residuals within tolerance at time 0",
+          len(start) == 5 and all(abs(value) <= 1e-6 for value in start.values()))
+
+    rewritten = _BLOCK_RE.search(trimmed.get('input.asc', ''))
+    check("block copied verbatim by document_input()", rewritten is not None and rewritten.group(0) == block)
+    check("no 'Check spelling' marks", 'Check spelling' not in trimmed.get('input.asc', 'Check spelling'))
+
+    reference = [line.split() for line in REFERENCE.read_text().splitlines()[1:]]
+    changed = next((f"{name} at time {row[0]}: {value} (reference {expected})"
+                    for row, ref in zip(rows[1:], reference[1:])
+                    for name, value, expected in zip(rows[0], row, ref) if value != expected), '')
+    if not changed and (rows[0] != reference[0] or len(rows) != len(reference)):
+        changed = f"{len(rows) - 1} records (reference {len(reference) - 1})"
+    check(f"{PLAIN_DECK} without TRIM unchanged", not changed, changed)
+
+    print("\n" + "="*70)
+    if failed:
+        print(f" ❌ TEST FAILED - {', '.join(failed)}")
+    else:
+        print(" ✅ TEST PASSED - level flight trimmed under the Mach hold")
+    print("="*70)
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""
+GHAME6 Trim Test
+
+Runs the GHAME6 deck 'input_trim.asc', whose 'TRIM' block solves the initial
+angle of attack, pitch angle, throttle and elevator for level cruise at 27 km
+and 1800 m/s, flown open loop, and checks that
+  - the trim converges below its tolerance;
+  - the trimmed point is level flight (pitch angle equal to angle of attack)
+    with the throttle inside 0...1;
+  - the vehicle holds altitude and speed over the run, while without the block
+    it leaves them;
+  - 'document_input()' copies the block through 'END' as it stands when it
+    rewrites 'input.asc';
+  - decks without a 'TRIM' block are unchanged: 'plot1.asc' of 'input.asc' is
+    compared as written, every 100 records, with the output of the build before
+    the trim in 'reference/ghame6_input_reference.asc'.
+
+'--write-reference' rewrites the reference from the current build.
+"""
+
+import re
+import shutil
+import subprocess
+import sys
+from pathlib import Path
+
+CADAC_ROOT = Path(__file__).resolve().parent.parent.parent
+sys.path.insert(0, str(CADAC_ROOT / 'tools'))
+
+import determinism
+
+EXAMPLE = 'GHAME6'
+DECK = 'input_trim.asc'
+ALTITUDE = 27000.0
+SPEED = 1800.0
+# excursions over the run - m, m/s
+ALTITUDE_TOLERANCE = 50.0
+SPEED_TOLERANCE = 1.0
+PLAIN_DECK = 'input.asc'
+REFERENCE = Path(__file__).resolve().parent / 'reference' / 'ghame6_input_reference.asc'
+# every 'EVERY'-th plot record and the last one
+EVERY = 100
+
+_BLOCK_RE = re.compile(r'^\s*TRIM\b.*?^\s*END\b[^\n]*\n', re.MULTILINE | re.DOTALL)
+_TRIM_RE = re.compile(r'Trim of.*?(\d+) iterations.*?max residual = (\S+) \*\*\*')
+_VALUE_RE = re.compile(r'^\t(\w+) = (\S+)', re.MULTILINE)
+
+
+def run(text: str) -> dict:
+    """Run the deck 'text' and return the console and the files written"""
+    example_dir = determinism.EXAMPLE_DIR / EXAMPLE
+    workspace = determinism.prepare_workspace(example_dir, DECK, None)
+    try:
+        (workspace / 'input.asc').write_text(text)
+        executable = example_dir / determinism._target(example_dir)
+        result = subprocess.run([str(executable)], cwd=workspace, stdin=subprocess.DEVNULL,
+                                capture_output=True, text=True, timeout=600)
+        files = {name: (workspace / name).read_text(errors='replace')
+                 for name in ('input.asc', 'plot1.asc')
+                 if (workspace / name).exists()}
+        files['console'] = result.stdout + result.stderr
+        return files
+    finally:
+        shutil.rmtree(workspace, ignore_errors=True)
+
+
+def plot_column(text: str, name: str) -> list:
+    """(time, value) of variable 'name' in 'plot1.asc'"""
+    lines = text.splitlines()
+    count = int(lines[1].split()[2])
+    tokens = ' '.join(lines[2:]).split()
+    names = tokens[:count]
+    values = [float(v) for v in tokens[count:]]
+    k = names.index(name)
+    return [(values[i], values[i + k]) for i in range(0, len(values) - count + 1, count)]
+
+
+def table(plot: str) -> list:
+    """Rows of all values, as written, of every 'EVERY'-th record and the last"""
+    lines = plot.splitlines()
+    count = int(lines[1].split()[2])
+    tokens = ' '.join(lines[2:]).split()
+    values = tokens[count:]
+    records = len(values) // count
+    picked = list(range(0, records, EVERY))
+    if picked[-1] != records - 1:
+        picked.append(records - 1)
+    return [tokens[:count]] + [values[r * count:(r + 1) * count] for r in picked]
+
+
+def main():
+    print("\n" + "="*70)
+    print(" GHAME6 TRIM TEST - 'TRIM' block of input_trim.asc")
+    print("="*70)
+
+    build = subprocess.run(['make', '-C', str(determinism.EXAMPLE_DIR / EXAMPLE)],
+                           capture_output=True, text=True)
+    if build.returncode != 0:
+        print(f"\n ❌ TEST FAILED - {EXAMPLE} does not build")
+        return 1
+
+    plain_deck = (determinism.EXAMPLE_DIR / EXAMPLE / PLAIN_DECK).read_text(errors='replace')
+    rows = table(run(plain_deck).get('plot1.asc', ''))
+    if '--write-reference' in sys.argv:
+        with open(REFERENCE, 'w') as f:
+            f.write(f"GHAME6 {PLAIN_DECK}: 'plot1.asc' every {EVERY} records and the last\n")
+            for row in rows:
+                f.write(' '.join(row) + '\n')
+        print(f"\n reference written: {REFERENCE.name} ({len(rows) - 1} records)")
+        return 0
+
+    deck = (determinism.EXAMPLE_DIR / EXAMPLE / DECK).read_text(errors='replace')
+    block = _BLOCK_RE.search(deck).group(0)
+    failed = []
+
+    def check(name, ok, detail=''):
+        print(f"  {name:<52} {'✓' if ok else '❌'} {detail}")
+        if not ok:
+            failed.append(name)
+
+    trimmed = run(deck)
+    plain = run(deck.replace(block, ''))
+
+    match = _TRIM_RE.search(trimmed['console'])
+    check("trim converged", match is not None and float(match.group(2)) <= 1e-6,
+          f"{match.group(1)} iterations, max residual {match.group(2)}" if match else
+          trimmed['console'].strip().splitlines()[-1:])
+    values = {name: float(value) for name, value in _VALUE_RE.findall(trimmed['console'])}
+    for name, value in values.items():
+        print(f"      {name:<10} = {value:g}")
+    check("level flight: thtbdx = alpha0x",
+          {'thtbdx', 'alpha0x'} <= values.keys() and abs(values['thtbdx'] - values['alpha0x']) < 1e-6)
+    check("throttle inside 0...1", 0 < values.get('throttle', -1) < 1)
+
+    def excursion(run_output, name, start):
+        if 'plot1.asc' not in run_output:
+            return float('inf')
+        return max(abs(v - start) for t, v in plot_column(run_output['plot1.asc'], name))
+    for name, start, tolerance, unit in (('alt', ALTITUDE, ALTITUDE_TOLERANCE, 'm'),
+                                         ('dvbe', SPEED, SPEED_TOLERANCE, 'm/s')):
+        held, free = excursion(trimmed, name, start), excursion(plain, name, start)
+        check(f"open loop holds '{name}'", held <= tolerance,
+              f"{held:.3f} {unit} (untrimmed {free:.3f} {unit})")
+
+    rewritten = _BLOCK_RE.search(trimmed.get('input.asc', ''))
+    check("block copied verbatim by document_input()",
+          rewritten is not None and rewritten.group(0) == block)
+    check("no 'Check spelling' marks", 'Check spelling' not in trimmed.get('input.asc', 'Check spelling'))
+
+    reference = [line.split() for line in REFERENCE.read_text().splitlines()[1:]]
+    changed = next((f"{name} at time {row[0]}: {value} (reference {expected})"
+                    for row, ref in zip(rows[1:], reference[1:])
+                    for name, value, expected in zip(rows[0], row, ref) if value != expected), '')
+    if not changed and (rows[0] != reference[0] or len(rows) != len(reference)):
+        changed = f"{len(rows) - 1} records (reference {len(reference) - 1})"
+    check(f"{PLAIN_DECK} without TRIM unchanged", not changed, changed)
+
+    print("\n" + "="*70)
+    if failed:
+        print(f" ❌ TEST FAILED - {', '.join(failed)}")
+    else:
+        print(" ✅ TEST PASSED - level cruise trimmed open loop")
+    print("="*70)
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+"""
+Intercept Convergence Test
+
+The intercept modules compute the miss distance at the closest point of
+approach between the two integration steps that bracket it (cubic Hermite
+relative trajectory, see 'closest_approach()'). The miss distance must
+therefore not depend on the integration step: every engagement is run at a
+fine reference step and at coarser steps, and the miss distances written to
+the console must agree with the reference within a fraction of it. The coarse
+steps stop where the trajectory itself starts to move the miss: the CRUISE5
+missile hits within 1 mm, and its guidance error grows with the step.
+
+'approach_check.cpp' is linked with the 'utility_functions.o' of each example
+and checks 'closest_approach()' itself on a straight line with a known time
+of closest approach.
+"""
+
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+from pathlib import Path
+
+CADAC_ROOT = Path(__file__).resolve().parent.parent.parent
+sys.path.insert(0, str(CADAC_ROOT / 'tools'))
+
+import determinism
+
+# (example, input deck, reference int_step, coarse int_steps, tolerance - fraction of reference miss)
+ENGAGEMENTS = [
+    ('CRUISE5', 'insat2.asc', 0.001, [0.002, 0.005, 0.01], 0.1),
+    ('AIM5', 'input.asc', 0.0002, [0.001, 0.002], 0.05),
+    ('SRAAM6', 'input.asc', 0.0001, [0.0005, 0.001, 0.002], 0.1),
+]
+
+CHECK = Path(__file__).resolve().parent / 'approach_check.cpp'
+
+QUIET = 'OPTIONS n_scrn n_comscrn n_events n_doc n_tabout n_plot n_merge n_traj'
+
+_MISS_RE = re.compile(r'miss distance\s*=\s*(\S+)\s*m')
+
+
+def miss_distance(example: str, input_name: str, int_step: float) -> float:
+    """Miss distance of the first intercept of the deck run at 'int_step'"""
+    example_dir = determinism.EXAMPLE_DIR / example
+    workspace = determinism.prepare_workspace(example_dir, input_name, None)
+    try:
+        deck = workspace / 'input.asc'
+        text = deck.read_text(errors='replace')
+        text = re.sub(r'^OPTIONS.*$', QUIET, text, count=1, flags=re.MULTILINE)
+        text, count = re.subn(r'^(\s*int_step\s+)\S+', rf'\g<1>{int_step}', text,
+                              count=1, flags=re.MULTILINE)
+        if not count:
+            raise RuntimeError(f"{input_name} has no int_step line")
+        deck.write_text(text)
+
+        executable = example_dir / determinism._target(example_dir)
+        result = subprocess.run([str(executable)], cwd=workspace, stdin=subprocess.DEVNULL,
+                                capture_output=True, text=True, timeout=600)
+        match = _MISS_RE.search(result.stdout)
+        if not match:
+            raise RuntimeError(f"no intercept at int_step {int_step}")
+        return float(match.group(1))
+    finally:
+        shutil.rmtree(workspace, ignore_errors=True)
+
+
+def approach_check(example: str, workspace: Path) -> bool:
+    """Build 'approach_check.cpp' with the example's utilities and run it"""
+    example_dir = determinism.EXAMPLE_DIR / example
+    executable = workspace / example
+    build = subprocess.run(['g++', '-std=c++11', '-O2', '-Wno-write-strings',
+                            f'-I{example_dir}', str(CHECK),
+                            str(example_dir / 'utility_functions.o'), '-o', str(executable)],
+                           capture_output=True, text=True)
+    if build.returncode != 0:
+        print("  ❌ approach_check does not build")
+        print(build.stderr[-2000:])
+        return False
+    result = subprocess.run([str(executable)], capture_output=True, text=True, timeout=60)
+    print(result.stdout.rstrip())
+    return result.returncode == 0
+
+
+def main():
+    print("\n" + "="*70)
+    print(" INTERCEPT CONVERGENCE TEST - miss distance vs integration step")
+    print("="*70)
+
+    failed = []
+    workspace = Path(tempfile.mkdtemp(prefix='approach_check_'))
+    for example, input_name, fine_step, coarse_steps, tolerance in ENGAGEMENTS:
+        print(f"\n{example} {input_name}")
+        build = subprocess.run(['make', '-C', str(determinism.EXAMPLE_DIR / example)],
+                               capture_output=True, text=True)
+        if build.returncode != 0:
+            print("  ❌ does not build")
+            failed.append(example)
+            continue
+        if not approach_check(example, workspace):
+            failed.append(f"{example} closest_approach")
+        try:
+            reference = miss_distance(example, input_name, fine_step)
+            print(f"  int_step {fine_step:<8g} miss {reference:.6f} m (reference)")
+            for int_step in coarse_steps:
+                miss = miss_distance(example, input_name, int_step)
+                error = abs(miss - reference) / reference
+                ok = error <= tolerance
+                print(f"  int_step {int_step:<8g} miss {miss:.6f} m  error {100 * error:.1f} % "
+                      f"{'✓' if ok else '❌'}")
+                if not ok:
+                    failed.append(f"{example}@{int_step:g}")
+        except (RuntimeError, subprocess.TimeoutExpired) as e:
+            print(f"  ❌ run failed: {e}")
+            failed.append(example)
+    shutil.rmtree(workspace, ignore_errors=True)
+
+    print("\n" + "="*70)
+    if failed:
+        print(f" ❌ TEST FAILED - {', '.join(failed)}")
+    else:
+        print(" ✅ TEST PASSED - miss distance independent of the integration step")
+    print("="*70)
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""
+ROCKET6G Regression Test
+
+Runs the default ROCKET6G deck 'input.asc' (24 SV GPS quadriga, 'gnss_nsel'=0)
+and compares the GPS/INS navigation columns of 'plot1.asc' every 5 s with the
+baseline output in 'reference/rocket6g_reference.asc'. The values are compared
+as written, i.e. bitwise: additions to the GPS module (GNSS_DECK channels and
+their errors) must neither change the quadriga solution nor the random number
+sequence of the legacy deck.
+
+'--write-reference' rewrites the reference from the current build.
+"""
+
+import shutil
+import subprocess
+import sys
+from pathlib import Path
+
+CADAC_ROOT = Path(__file__).resolve().parent.parent.parent
+sys.path.insert(0, str(CADAC_ROOT / 'tools'))
+
+import determinism
+
+EXAMPLE = 'ROCKET6G'
+DECK = 'input.asc'
+REFERENCE = Path(__file__).resolve().parent / 'reference' / 'rocket6g_reference.asc'
+COLUMNS = ['time', 'alt', 'dvbe', 'ins_pos_err', 'ins_vel_err', 'ucbias_error', 'std_pos',
+           'gps_pos_meas', 'gps_vel_meas', 'state_pos', 'state_vel']
+# every 'EVERY'-th plot record and the last one
+EVERY = 50
+
+
+def run() -> str:
+    """'plot1.asc' of the default deck"""
+    example_dir = determinism.EXAMPLE_DIR / EXAMPLE
+    workspace = determinism.prepare_workspace(example_dir, DECK, None)
+    try:
+        executable = example_dir / determinism._target(example_dir)
+        subprocess.run([str(executable)], cwd=workspace, stdin=subprocess.DEVNULL,
+                       capture_output=True, text=True, timeout=900)
+        plot = workspace / 'plot1.asc'
+        return plot.read_text(errors='replace') if plot.exists() else ''
+    finally:
+        shutil.rmtree(workspace, ignore_errors=True)
+
+
+def table(plot: str) -> list:
+    """Rows of the 'COLUMNS' values, as written, of the sampled records"""
+    lines = plot.splitlines()
+    count = int(lines[1].split()[2])
+    tokens = ' '.join(lines[2:]).split()
+    names = tokens[:count]
+    values = tokens[count:]
+    index = [names.index(name) for name in COLUMNS]
+    records = len(values) // count
+    picked = list(range(0, records, EVERY))
+    if picked[-1] != records - 1:
+        picked.append(records - 1)
+    return [[values[r * count + k] for k in index] for r in picked]
+
+
+def main():
+    print("\n" + "="*70)
+    print(" ROCKET6G REGRESSION TEST - default deck vs baseline, bitwise")
+    print("="*70)
+
+    build = subprocess.run(['make', '-C', str(determinism.EXAMPLE_DIR / EXAMPLE)],
+                           capture_output=True, text=True)
+    if build.returncode != 0:
+        print(f"\n ❌ TEST FAILED - {EXAMPLE} does not build")
+        return 1
+    plot = run()
+    if not plot:
+        print(f"\n ❌ TEST FAILED - {DECK} wrote no plot1.asc")
+        return 1
+    rows = table(plot)
+
+    if '--write-reference' in sys.argv:
+        with open(REFERENCE, 'w') as f:
+            f.write(f"ROCKET6G {DECK}: 'plot1.asc' columns every {EVERY} records and the last\n")
+            f.write(' '.join(COLUMNS) + '\n')
+            for row in rows:
+                f.write(' '.join(row) + '\n')
+        print(f"\n reference written: {REFERENCE.name} ({len(rows)} records)")
+        return 0
+
+    reference = [line.split() for line in REFERENCE.read_text().splitlines()[2:]]
+    print(f"\n  {len(rows)} records of {len(COLUMNS)} columns (reference {len(reference)})")
+    mismatch = None
+    for row, ref in zip(rows, reference):
+        for name, value, expected in zip(COLUMNS, row, ref):
+            if value != expected:
+                mismatch = (row[0], name, value, expected)
+                break
+        if mismatch:
+            break
+    if len(rows) != len(reference) and not mismatch:
+        mismatch = (rows[-1][0], 'records', len(rows), len(reference))
+
+    print("\n" + "="*70)
+    if mismatch:
+        time, name, value, expected = mismatch
+        print(f" ❌ TEST FAILED - {name} at time {time}: {value} (reference {expected})")
+    else:
+        print(" ✅ TEST PASSED - default deck output identical to the baseline")
+    print("="*70)
+    return 1 if mismatch else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+"""
+Vehicle Pool Test
+
+GHAME6 and ROCKET6G keep the vehicle objects of the first Monte Carlo run in
+'vehicle_pool' and reset them in place for every further run. The test runs
+the default deck of each example with a short 'ENDTIME' for a few and for many
+Monte Carlo runs and checks that the peak resident set size does not grow with
+the number of runs: every run used to leave its vehicle objects and their
+tables behind, about 1 MB per run.
+
+'--runs N' sets the long sweep (default 1000).
+"""
+
+import os
+import re
+import subprocess
+import sys
+import shutil
+import time
+from pathlib import Path
+
+CADAC_ROOT = Path(__file__).resolve().parent.parent.parent
+sys.path.insert(0, str(CADAC_ROOT / 'tools'))
+
+import determinism
+
+EXAMPLES = ('GHAME6', 'ROCKET6G')
+DECK = 'input.asc'
+# end of each run - s
+ENDTIME = 0.001
+FEW = 10
+MANY = 1000
+# growth of the peak RSS from 'FEW' to 'MANY' runs - kB
+RSS_TOLERANCE = 2048
+
+
+def peak_rss(example: str, monte: int) -> tuple:
+    """Peak RSS (kB) and wall time (s) of 'monte' runs of the default deck"""
+    example_dir = determinism.EXAMPLE_DIR / example
+    workspace = determinism.prepare_workspace(example_dir, DECK, monte)
+    try:
+        deck = workspace / 'input.asc'
+        deck.write_text(re.sub(r'^(\s*ENDTIME\s+)\S+', rf'\g<1>{ENDTIME}',
+                               deck.read_text(errors='replace'), count=1, flags=re.MULTILINE))
+        start = time.time()
+        process = subprocess.Popen([str(example_dir / determinism._target(example_dir))],
+                                   cwd=workspace, stdin=subprocess.DEVNULL,
+                                   stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        _, status, usage = os.wait4(process.pid, 0)
+        process.returncode = os.waitstatus_to_exitcode(status)
+        if process.returncode != 0:
+            return -1, 0.0
+        return usage.ru_maxrss, time.time() - start
+    finally:
+        shutil.rmtree(workspace, ignore_errors=True)
+
+
+def main():
+    many = int(sys.argv[sys.argv.index('--runs') + 1]) if '--runs' in sys.argv else MANY
+
+    print("\n" + "="*70)
+    print(f" VEHICLE POOL TEST - peak RSS of {FEW} and {many} Monte Carlo runs")
+    print("="*70)
+
+    failed = []
+    for example in EXAMPLES:
+        build = subprocess.run(['make', '-C', str(determinism.EXAMPLE_DIR / example)],
+                               capture_output=True, text=True)
+        if build.returncode != 0:
+            print(f"  {example:<10} ❌ does not build")
+            failed.append(example)
+            continue
+        few, _ = peak_rss(example, FEW)
+        rss, seconds = peak_rss(example, many)
+        ok = few > 0 and rss > 0 and rss - few <= RSS_TOLERANCE
+        print(f"  {example:<10} {'✓' if ok else '❌'} {FEW} runs {few} kB, "
+              f"{many} runs {rss} kB ({seconds:.1f} s)")
+        if not ok:
+            failed.append(example)
+
+    print("\n" + "="*70)
+    if failed:
+        print(f" ❌ TEST FAILED - {', '.join(failed)}")
+    else:
+        print(" ✅ TEST PASSED - peak RSS flat across pooled runs")
+    print("="*70)
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,334 @@
+#!/usr/bin/env python3
+"""
+Static dataflow analysis of CADAC module-variables
+
+Every module reads its inputs from the module-variable arrays at the top of
+the function ('hyper[700].real()', 'round6[21].vec()', ...) and writes its
+outputs at the bottom ('.gets(...)', '.gets_vec(...)', '.gets_mat(...)').
+This tool extracts those read/write sets from the example sources (including
+member functions the module calls) and, for every vehicle class and the
+MODULES order of its input file, reports
+
+  - the dependency DAG of one integration step (read-after-write,
+    write-after-read and write-after-write between modules),
+  - the DAG levels: modules on the same level are independent and may run
+    concurrently within a step,
+  - stale reads: a module reads a variable that only later modules write,
+    so it always sees the previous step's value.
+
+Modules that draw random numbers (gauss(), uniform(), markov(), ...) share
+the generator state; they are kept in MODULES order with respect to each
+other so the random sequence, and with it every Monte Carlo run, stays the
+same.
+
+Usage:
+    python3 tools/dataflow.py ROCKET6G ADS6
+    python3 tools/dataflow.py --all --json dataflow.json
+    python3 tools/dataflow.py ROCKET6G --input input_insertion.asc --dot > rocket6g.dot
+"""
+
+import argparse
+import json
+import re
+import sys
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Dict, List, Optional, Set, Tuple
+
+EXAMPLE_DIR = Path(__file__).parent.parent / 'example'
+
+_CLASS_RE = re.compile(r'\bclass\s+(\w+)\s*:\s*public\s+(\w+)')
+_FUNCTION_RE = re.compile(r'^[ \t]*[\w\*&<> \t]*?\b(\w+)::(\w+)\s*\(([^)]*)\)\s*(?:const\s*)?\{',
+                          re.MULTILINE)
+_ACCESS_RE = re.compile(r'\b([a-z]\w*)\[(\d+)\]\.(init|real|integer|vec|mat|gets\w*)\s*\(')
+_INIT_NAME_RE = re.compile(r'\b([a-z]\w*)\[(\d+)\]\.init\(\s*"(\w+)"')
+_CALL_RE = re.compile(r'(?<![\w.>:])(\w+)\s*\(')
+_COMMENT_RE = re.compile(r'//[^\n]*|/\*.*?\*/', re.DOTALL)
+
+# Utility functions that advance the shared random number generator
+RNG_FUNCTIONS = {'gauss', 'uniform', 'exponential', 'rayleigh', 'markov', 'unituni', 'rand'}
+RNG = '<rng>'
+
+Var = Tuple[str, int]
+"""Module-variable: (array, slot)"""
+
+
+@dataclass
+class Access:
+    """Module-variables touched by a function and everything it calls"""
+    reads: Set[Var] = field(default_factory=set)
+    writes: Set[Var] = field(default_factory=set)
+
+
+@dataclass
+class Dependency:
+    """Edge of the step DAG: 'before' must run before 'after'"""
+    before: str
+    after: str
+    kinds: Dict[str, List[str]]
+    """'raw', 'war', 'waw' -> variable names"""
+
+
+@dataclass
+class StaleRead:
+    """A module reads a variable that only modules later in the step write"""
+    reader: str
+    variable: str
+    writers: List[str]
+
+
+@dataclass
+class ClassDataflow:
+    """Dataflow of one vehicle class through one integration step"""
+    example: str
+    vehicle_class: str
+    modules: List[str]
+    access: Dict[str, Access]
+    edges: List[Dependency]
+    levels: List[List[str]]
+    stale_reads: List[StaleRead]
+
+    def to_dict(self, names: Dict[Var, str]) -> dict:
+        return {
+            'modules': self.modules,
+            'reads': {m: sorted(_label(v, names) for v in a.reads) for m, a in self.access.items()},
+            'writes': {m: sorted(_label(v, names) for v in a.writes) for m, a in self.access.items()},
+            'edges': [{'before': e.before, 'after': e.after, **e.kinds} for e in self.edges],
+            'levels': self.levels,
+            'stale_reads': [{'reader': s.reader, 'variable': s.variable, 'writers': s.writers}
+                            for s in self.stale_reads],
+        }
+
+
+class ExampleSources:
+    """Member functions, class hierarchy and variable names of one example"""
+
+    def __init__(self, example_dir: Path):
+        self.example_dir = Path(example_dir)
+        self.bases: Dict[str, str] = {}
+        self.functions: Dict[Tuple[str, str], str] = {}
+        self.names: Dict[Var, str] = {}
+
+        for header in self.example_dir.glob('*.hpp'):
+            self.bases.update(dict(_CLASS_RE.findall(header.read_text(errors='replace'))))
+
+        for source in sorted(self.example_dir.glob('*.cpp')):
+            text = _COMMENT_RE.sub('', source.read_text(errors='replace'))
+            for match in _FUNCTION_RE.finditer(text):
+                body = _braced(text, match.end() - 1)
+                if body is not None:
+                    self.functions[(match.group(1), match.group(2))] = body
+            for array, slot, name in _INIT_NAME_RE.findall(text):
+                self.names.setdefault((array, int(slot)), name)
+
+    def chain(self, cls: str) -> List[str]:
+        """Class followed by its base classes"""
+        chain = [cls]
+        while chain[-1] in self.bases:
+            chain.append(self.bases[chain[-1]])
+        return chain
+
+    def vehicle_classes(self) -> List[str]:
+        """Classes no other class derives from"""
+        return sorted(c for c in self.bases if c not in self.bases.values())
+
+    def resolve(self, cls: str, function: str) -> Optional[Tuple[str, str]]:
+        """Most derived definition of a member function"""
+        for owner in self.chain(cls):
+            if (owner, function) in self.functions:
+                return owner, function
+        return None
+
+    def access(self, cls: str, function: str, stop: Set[str]) -> Access:
+        """
+        Accesses of a member function including the member functions it calls
+
+        Args:
+            cls: Vehicle class the function is called on
+            function: Member function name
+            stop: Functions not to descend into (the other modules)
+        """
+        result = Access()
+        visited = set()
+        pending = [function]
+        while pending:
+            name = pending.pop()
+            key = self.resolve(cls, name)
+            if key is None or key in visited:
+                continue
+            visited.add(key)
+            body = self.functions[key]
+            for array, slot, method in _ACCESS_RE.findall(body):
+                if method.startswith('gets'):
+                    result.writes.add((array, int(slot)))
+                elif method != 'init':
+                    result.reads.add((array, int(slot)))
+            for callee in _CALL_RE.findall(body):
+                if callee in RNG_FUNCTIONS:
+                    result.reads.add((RNG, 0))
+                    result.writes.add((RNG, 0))
+                elif callee not in stop and callee != name:
+                    pending.append(callee)
+        return result
+
+
+def read_modules(input_file: Path) -> List[Tuple[str, List[str]]]:
+    """MODULES block of an input file: (module, lifecycle functions)"""
+    modules = []
+    in_block = False
+    for line in input_file.read_text(errors='replace').splitlines():
+        line = line.split('//')[0].strip()
+        if not line:
+            continue
+        if line.startswith('MODULES'):
+            in_block = True
+        elif in_block and line.startswith('END'):
+            break
+        elif in_block:
+            tokens = line.split()
+            phases = tokens[1].split(',') if len(tokens) > 1 else []
+            modules.append((tokens[0], phases))
+    return modules
+
+
+def analyze_class(example: str, sources: ExampleSources, cls: str,
+                  modules: List[Tuple[str, List[str]]]) -> Optional[ClassDataflow]:
+    """Step DAG of the modules a vehicle class implements"""
+    names = [m for m, phases in modules if 'exec' in phases and sources.resolve(cls, m)]
+    if not names:
+        return None
+    stop = {m for m, _ in modules}
+    access = {m: sources.access(cls, m, stop - {m}) for m in names}
+
+    edges = []
+    for j, after in enumerate(names):
+        for before in names[:j]:
+            a, b = access[before], access[after]
+            kinds = {
+                'raw': a.writes & b.reads,
+                'war': a.reads & b.writes,
+                'waw': a.writes & b.writes,
+            }
+            kinds = {k: sorted(_label(v, sources.names) for v in vs) for k, vs in kinds.items() if vs}
+            if kinds:
+                edges.append(Dependency(before, after, kinds))
+
+    level = {}
+    for name in names:
+        preds = [level[e.before] for e in edges if e.after == name]
+        level[name] = max(preds) + 1 if preds else 0
+    levels = [[m for m in names if level[m] == n] for n in range(max(level.values()) + 1)]
+
+    stale = []
+    for j, reader in enumerate(names):
+        for var in sorted(access[reader].reads - access[reader].writes):
+            if var[0] == RNG:
+                continue
+            earlier = [m for m in names[:j] if var in access[m].writes]
+            later = [m for m in names[j + 1:] if var in access[m].writes]
+            if later and not earlier:
+                stale.append(StaleRead(reader, _label(var, sources.names), later))
+
+    return ClassDataflow(example, cls, names, access, edges, levels, stale)
+
+
+def analyze_example(example_dir: Path, input_name: str = 'input.asc') -> List[ClassDataflow]:
+    """Dataflow of every vehicle class of an example"""
+    input_file = example_dir / input_name
+    if not input_file.exists():
+        raise FileNotFoundError(f"{input_file} not found")
+    sources = ExampleSources(example_dir)
+    modules = read_modules(input_file)
+    results = []
+    for cls in sources.vehicle_classes():
+        result = analyze_class(example_dir.name, sources, cls, modules)
+        if result is not None:
+            results.append(result)
+    return results
+
+
+def format_report(result: ClassDataflow) -> str:
+    """Human-readable report of one vehicle class"""
+    lines = [f"{result.example} / {result.vehicle_class}: {len(result.modules)} modules, "
+             f"{len(result.levels)} levels"]
+    for n, level in enumerate(result.levels):
+        marker = '  <- concurrent' if len(level) > 1 else ''
+        lines.append(f"  level {n:2d}: {', '.join(level)}{marker}")
+    if result.stale_reads:
+        lines.append("  stale reads (value from previous step):")
+        for s in result.stale_reads:
+            lines.append(f"    {s.reader} reads '{s.variable}' written later by {', '.join(s.writers)}")
+    return '\n'.join(lines)
+
+
+def format_dot(result: ClassDataflow) -> str:
+    """Graphviz rendering of the step DAG"""
+    lines = [f'digraph "{result.example}_{result.vehicle_class}" {{', '  rankdir=LR;']
+    for e in result.edges:
+        label = ','.join(sorted(set(sum(e.kinds.values(), []))))[:60]
+        lines.append(f'  "{e.before}" -> "{e.after}" [label="{label}"];')
+    lines.append('}')
+    return '\n'.join(lines)
+
+
+def _label(var: Var, names: Dict[Var, str]) -> str:
+    if var[0] == RNG:
+        return RNG
+    name = names.get(var)
+    return f"{name} ({var[0]}[{var[1]}])" if name else f"{var[0]}[{var[1]}]"
+
+
+def _braced(text: str, start: int) -> Optional[str]:
+    """Text of the brace block opening at 'start', braces included"""
+    depth = 0
+    for pos in range(start, len(text)):
+        if text[pos] == '{':
+            depth += 1
+        elif text[pos] == '}':
+            depth -= 1
+            if depth == 0:
+                return text[start:pos + 1]
+    return None
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('examples', nargs='*', help="example names (directories under example/)")
+    parser.add_argument('--all', action='store_true', help="analyze every example")
+    parser.add_argument('--input', default='input.asc', help="input file with the MODULES block")
+    parser.add_argument('--json', type=Path, help="write the analysis to a JSON file")
+    parser.add_argument('--dot', action='store_true', help="print Graphviz DAGs instead of the report")
+    args = parser.parse_args()
+
+    if args.all:
+        examples = sorted(p.name for p in EXAMPLE_DIR.iterdir() if (p / args.input).exists())
+    else:
+        examples = args.examples
+    if not examples:
+        parser.error("name at least one example or use --all")
+
+    report = {}
+    for example in examples:
+        example_dir = EXAMPLE_DIR / example
+        try:
+            results = analyze_example(example_dir, args.input)
+        except FileNotFoundError as e:
+            print(f"*** Error: {e}", file=sys.stderr)
+            return 1
+        if not results:
+            print(f"{example}: no vehicle class implements the modules of {args.input}\n")
+        names = ExampleSources(example_dir).names if args.json else {}
+        for result in results:
+            print(format_dot(result) if args.dot else format_report(result))
+            if args.json:
+                report.setdefault(example, {})[result.vehicle_class] = result.to_dict(names)
+            if not args.dot:
+                print()
+
+    if args.json:
+        args.json.write_text(json.dumps(report, indent=2))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,391 @@
+#!/usr/bin/env python3
+"""
+Determinism checker for CADAC output streams
+
+Runs one input deck as a reference ('a') and again as one or more candidate
+runs ('b'), each in its own scratch workspace, and diffs every output stream
+the runs write: plot*.asc, traj*.asc, stat*.asc and tabout.asc. By default the
+reference runs alone and the candidates run concurrently ('--jobs'), so
+results must not depend on what else the machine is doing. Thread counts or a
+parallel build are compared with '--env-a/--env-b' and '--executable-b'.
+
+For every stream the first divergence is reported with its Monte Carlo run,
+simulated time and variable; the earliest over all streams is the summary.
+Two modes:
+
+  bitwise  every written value must be textually identical
+  ulp      values may differ by up to '--ulps' units in the last place of the
+           IEEE double they parse to
+
+Outputs are text, so both modes see the precision the executable writes.
+The first title line of plot-format files and lines carrying the date are
+not compared.
+
+Usage:
+    python3 tools/determinism.py ROCKET6G
+    python3 tools/determinism.py GHAME6 --monte 3 --jobs 4 --mode ulp --ulps 2
+    python3 tools/determinism.py AGM6 --env-a OMP_NUM_THREADS=1 --env-b OMP_NUM_THREADS=8
+"""
+
+import argparse
+import math
+import os
+import re
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+from dataclasses import dataclass, field
+from fnmatch import fnmatch
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+CADAC_ROOT = Path(__file__).resolve().parent.parent
+EXAMPLE_DIR = CADAC_ROOT / 'example'
+
+# Output streams compared, in report order
+STREAMS = ('plot*.asc', 'traj*.asc', 'stat*.asc', 'tabout.asc')
+
+# Time value that closes a Monte Carlo run in plot-format files
+END_OF_RUN = -1.0
+
+_DATE_RE = re.compile(r'\b(?:Jan|Feb|Mar|Apr|May|Jun|Jul|Aug|Sep|Oct|Nov|Dec)\s+\d+\s+\d{4}\b')
+_MONTE_RUN_RE = re.compile(r'MONTE Run #\s*(\d+)')
+
+
+@dataclass
+class Divergence:
+    """First point where two output streams differ"""
+    stream: str
+    run: int
+    """Monte Carlo run (1-based)"""
+
+    time: Optional[float]
+    variable: str
+    value_a: str
+    value_b: str
+    ulps: Optional[int] = None
+    candidate: int = 0
+    """Index of the candidate run ('b') that diverged"""
+
+    def __str__(self) -> str:
+        when = f"t = {self.time:g}" if self.time is not None else "t = ?"
+        ulps = f" ({self.ulps} ulp)" if self.ulps is not None else ""
+        return (f"{self.stream}: run {self.run}, {when}, '{self.variable}': "
+                f"{self.value_a} vs {self.value_b}{ulps}")
+
+
+@dataclass
+class Report:
+    """Outcome of one determinism check"""
+    example: str
+    streams: List[str] = field(default_factory=list)
+    divergences: List[Divergence] = field(default_factory=list)
+
+    @property
+    def first(self) -> Optional[Divergence]:
+        """Earliest divergence by run and simulated time"""
+        if not self.divergences:
+            return None
+        return min(self.divergences, key=lambda d: (d.run, d.time if d.time is not None else math.inf))
+
+    @property
+    def deterministic(self) -> bool:
+        return not self.divergences
+
+
+class Comparator:
+    """Compares written values in 'bitwise' or 'ulp' mode"""
+
+    def __init__(self, mode: str = 'bitwise', ulps: int = 0):
+        if mode not in ('bitwise', 'ulp'):
+            raise ValueError(f"unknown mode '{mode}'")
+        self.mode = mode
+        self.ulps = ulps
+
+    def equal(self, a: str, b: str) -> Tuple[bool, Optional[int]]:
+        """Whether two written tokens match, and their ULP distance if both are numbers"""
+        if a == b:
+            return True, 0
+        distance = ulp_distance(a, b)
+        if self.mode == 'bitwise' or distance is None:
+            return False, distance
+        return distance <= self.ulps, distance
+
+
+def ulp_distance(a: str, b: str) -> Optional[int]:
+    """Units in the last place between two numbers, None if either is not a number"""
+    try:
+        x, y = float(a), float(b)
+    except ValueError:
+        return None
+    if math.isnan(x) or math.isnan(y):
+        return 0 if math.isnan(x) and math.isnan(y) else None
+    return abs(_ordered(x) - _ordered(y))
+
+
+def _ordered(x: float) -> int:
+    """Map a double to an integer so adjacent doubles are adjacent integers"""
+    bits = struct.unpack('<q', struct.pack('<d', x))[0]
+    return bits if bits >= 0 else -(bits & 0x7FFFFFFFFFFFFFFF)
+
+
+def read_plot(path: Path) -> Tuple[List[str], List[List[str]]]:
+    """
+    Variable names and rows of a plot-format file (plot, traj, stat)
+
+    Line 1 is the title, line 2 ends with the number of variables, then the
+    names and the rows follow; both may wrap over several lines. Streams the
+    executable opens but never writes are empty.
+    """
+    lines = path.read_text(errors='replace').splitlines()
+    if len(lines) < 2:
+        return [], []
+    nvars = int(lines[1].split()[-1])
+    tokens = [t for line in lines[2:] for t in line.split()]
+    names, values = tokens[:nvars], tokens[nvars:]
+    rows = [values[k:k + nvars] for k in range(0, len(values), nvars)]
+    return names, rows
+
+
+def compare_plot(stream: str, path_a: Path, path_b: Path, comparator: Comparator) -> Optional[Divergence]:
+    """First divergence of a plot-format stream"""
+    names_a, rows_a = read_plot(path_a)
+    names_b, rows_b = read_plot(path_b)
+    if names_a != names_b:
+        return Divergence(stream, 1, None, 'variables', ' '.join(names_a)[:60], ' '.join(names_b)[:60])
+
+    run = 1
+    for row_a, row_b in zip(rows_a, rows_b):
+        time = _number(row_a[0])
+        for name, a, b in zip(names_a, row_a, row_b):
+            same, ulps = comparator.equal(a, b)
+            if not same:
+                return Divergence(stream, run, time, name, a, b, ulps)
+        if len(row_a) != len(row_b):
+            return Divergence(stream, run, time, 'row length', str(len(row_a)), str(len(row_b)))
+        if time == END_OF_RUN:
+            run += 1
+
+    if len(rows_a) != len(rows_b):
+        last = rows_a[len(rows_b)] if len(rows_a) > len(rows_b) else rows_b[len(rows_a)]
+        return Divergence(stream, run, _number(last[0]), 'rows', str(len(rows_a)), str(len(rows_b)))
+    return None
+
+
+def compare_text(stream: str, path_a: Path, path_b: Path, comparator: Comparator) -> Optional[Divergence]:
+    """First divergence of a formatted text stream (tabout)"""
+    lines_a = path_a.read_text(errors='replace').splitlines()
+    lines_b = path_b.read_text(errors='replace').splitlines()
+    run = 1
+    for number, (line_a, line_b) in enumerate(zip(lines_a, lines_b), 1):
+        match = _MONTE_RUN_RE.search(line_a)
+        if match:
+            run = int(match.group(1))
+        if line_a == line_b or (_DATE_RE.search(line_a) and _DATE_RE.search(line_b)):
+            continue
+        tokens_a, tokens_b = line_a.split(), line_b.split()
+        time = _number(tokens_a[0]) if tokens_a else None
+        for column, (a, b) in enumerate(zip(tokens_a, tokens_b), 1):
+            same, ulps = comparator.equal(a, b)
+            if not same:
+                return Divergence(stream, run, time, f"line {number} column {column}", a, b, ulps)
+        if len(tokens_a) != len(tokens_b):
+            return Divergence(stream, run, time, f"line {number}", line_a.strip()[:40], line_b.strip()[:40])
+    if len(lines_a) != len(lines_b):
+        return Divergence(stream, run, None, 'lines', str(len(lines_a)), str(len(lines_b)))
+    return None
+
+
+def output_streams(workspace: Path) -> List[str]:
+    """Output stream files in a workspace, in STREAMS order"""
+    names = sorted(p.name for p in workspace.iterdir() if p.is_file())
+    return [n for pattern in STREAMS for n in names if fnmatch(n, pattern)]
+
+
+def compare_workspaces(example: str, workspace_a: Path, workspaces_b: List[Path],
+                       comparator: Comparator) -> Report:
+    """Diff the output streams of the reference workspace against every candidate"""
+    report = Report(example, output_streams(workspace_a))
+    for index, workspace_b in enumerate(workspaces_b):
+        streams_b = output_streams(workspace_b)
+        for stream in sorted(set(report.streams) | set(streams_b)):
+            if stream not in streams_b or stream not in report.streams:
+                divergence = Divergence(stream, 1, None, 'file',
+                                        'written' if stream in report.streams else 'missing',
+                                        'written' if stream in streams_b else 'missing')
+            elif fnmatch(stream, 'tabout.asc'):
+                divergence = compare_text(stream, workspace_a / stream, workspace_b / stream, comparator)
+            else:
+                divergence = compare_plot(stream, workspace_a / stream, workspace_b / stream, comparator)
+            if divergence is not None:
+                divergence.candidate = index
+                report.divergences.append(divergence)
+    return report
+
+
+def prepare_workspace(example_dir: Path, input_name: str, monte: Optional[int]) -> Path:
+    """
+    Scratch copy of the example decks with the input deck as input.asc
+
+    Files matching STREAMS are left behind: they are outputs of earlier runs
+    (or archived results) and every stream in the workspace must come from
+    this run.
+    """
+    workspace = Path(tempfile.mkdtemp(prefix=f'determinism-{example_dir.name}-'))
+    for deck in example_dir.glob('*.asc'):
+        if not any(fnmatch(deck.name, pattern) for pattern in STREAMS):
+            shutil.copy(deck, workspace)
+    text = (example_dir / input_name).read_text(errors='replace')
+    if monte is not None:
+        text, count = re.subn(r'^(\s*MONTE\s+)\d+', rf'\g<1>{monte}', text, count=1, flags=re.MULTILINE)
+        if not count:
+            raise ValueError(f"{input_name} has no MONTE line")
+    (workspace / 'input.asc').write_text(text)
+    return workspace
+
+
+def run(executable: Path, workspaces: List[Path], env: Dict[str, str], timeout: float):
+    """Run the executable in every workspace concurrently"""
+    processes = [subprocess.Popen([str(executable)], cwd=w, env=dict(os.environ, **env),
+                                  stdin=subprocess.DEVNULL, stdout=subprocess.DEVNULL,
+                                  stderr=subprocess.PIPE)
+                 for w in workspaces]
+    failures = []
+    for workspace, process in zip(workspaces, processes):
+        try:
+            _, stderr = process.communicate(timeout=timeout)
+        except subprocess.TimeoutExpired:
+            process.kill()
+            process.communicate()
+            failures.append(f"{workspace.name}: timed out after {timeout:g} sec")
+            continue
+        if process.returncode != 0:
+            failures.append(f"{workspace.name}: exit code {process.returncode}\n"
+                            f"{stderr.decode(errors='replace')[-1000:]}")
+    if failures:
+        raise RuntimeError('\n'.join(failures))
+
+
+def check(example: str, input_name: str = 'input.asc', jobs: int = 2,
+          mode: str = 'bitwise', ulps: int = 0, monte: Optional[int] = None,
+          env_a: Optional[Dict[str, str]] = None, env_b: Optional[Dict[str, str]] = None,
+          executable_b: Optional[Path] = None, timeout: float = 900,
+          keep: bool = False) -> Report:
+    """
+    Run an example as reference and candidates and compare their outputs
+
+    Args:
+        example: Example name (directory under example/), already built
+        input_name: Input deck in the example directory
+        jobs: Number of candidate runs executed concurrently
+        mode: 'bitwise' or 'ulp'
+        ulps: Allowed ULP distance in 'ulp' mode
+        monte: Override the number of Monte Carlo runs of the deck
+        env_a, env_b: Extra environment of the reference and the candidates
+        executable_b: Executable of the candidates (default: the example's)
+        timeout: Wall-clock limit per run (sec)
+        keep: Leave the workspaces on disk
+
+    Raises:
+        RuntimeError: If a run fails
+    """
+    example_dir = EXAMPLE_DIR / example
+    executable = example_dir / _target(example_dir)
+    comparator = Comparator(mode, ulps)
+    workspace_a = prepare_workspace(example_dir, input_name, monte)
+    workspaces_b = [prepare_workspace(example_dir, input_name, monte) for _ in range(max(jobs, 1))]
+    try:
+        run(executable, [workspace_a], env_a or {}, timeout)
+        run(Path(executable_b) if executable_b else executable, workspaces_b, env_b or {}, timeout)
+        return compare_workspaces(example, workspace_a, workspaces_b, comparator)
+    finally:
+        if keep:
+            print(f"Workspaces kept: {workspace_a} {' '.join(map(str, workspaces_b))}")
+        else:
+            for workspace in [workspace_a] + workspaces_b:
+                shutil.rmtree(workspace, ignore_errors=True)
+
+
+def has_monte(example: str, input_name: str = 'input.asc') -> bool:
+    """Whether the example's input deck has a MONTE line"""
+    text = (EXAMPLE_DIR / example / input_name).read_text(errors='replace')
+    return re.search(r'^\s*MONTE\s+\d+', text, re.MULTILINE) is not None
+
+
+def format_report(report: Report) -> str:
+    """Human-readable report"""
+    lines = [f"{report.example}: {len(report.streams)} streams compared ({', '.join(report.streams)})"]
+    if report.deterministic:
+        lines.append("  deterministic")
+        return '\n'.join(lines)
+    first = report.first
+    lines.append(f"  first divergence (candidate {first.candidate}): {first}")
+    for divergence in report.divergences:
+        if divergence is not first:
+            lines.append(f"  candidate {divergence.candidate}: {divergence}")
+    return '\n'.join(lines)
+
+
+def _number(token: str) -> Optional[float]:
+    try:
+        return float(token)
+    except ValueError:
+        return None
+
+
+def _target(example_dir: Path) -> str:
+    """TARGET of an example Makefile"""
+    text = (example_dir / 'Makefile').read_text()
+    match = re.search(r'^TARGET\s*=\s*(\S+)', text, re.MULTILINE)
+    return match.group(1) if match else example_dir.name.lower()
+
+
+def _environment(assignments: List[str]) -> Dict[str, str]:
+    env = {}
+    for assignment in assignments:
+        key, sep, value = assignment.partition('=')
+        if not sep:
+            raise argparse.ArgumentTypeError(f"expected KEY=VALUE, got '{assignment}'")
+        env[key] = value
+    return env
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('examples', nargs='+', help="example names (directories under example/)")
+    parser.add_argument('--input', default='input.asc', help="input deck in the example directory")
+    parser.add_argument('--jobs', type=int, default=2, help="concurrent candidate runs")
+    parser.add_argument('--mode', choices=('bitwise', 'ulp'), default='bitwise')
+    parser.add_argument('--ulps', type=int, default=4, help="allowed ULP distance in ulp mode")
+    parser.add_argument('--monte', type=int, help="override the number of Monte Carlo runs")
+    parser.add_argument('--env-a', nargs='*', default=[], metavar='KEY=VALUE',
+                        help="environment of the reference run")
+    parser.add_argument('--env-b', nargs='*', default=[], metavar='KEY=VALUE',
+                        help="environment of the candidate runs")
+    parser.add_argument('--executable-b', type=Path, help="executable of the candidate runs")
+    parser.add_argument('--timeout', type=float, default=900, help="wall-clock limit per run (sec)")
+    parser.add_argument('--keep', action='store_true', help="keep the run workspaces")
+    args = parser.parse_args()
+
+    failed = False
+    for example in args.examples:
+        build = subprocess.run(['make', '-C', str(EXAMPLE_DIR / example)], capture_output=True, text=True)
+        if build.returncode != 0:
+            print(f"*** Error: {example} does not build\n{build.stderr[-1000:]}", file=sys.stderr)
+            return 2
+        try:
+            report = check(example, args.input, args.jobs, args.mode, args.ulps, args.monte,
+                           _environment(args.env_a), _environment(args.env_b),
+                           args.executable_b, args.timeout, args.keep)
+        except (RuntimeError, ValueError) as e:
+            print(f"*** Error: {example}: {e}", file=sys.stderr)
+            return 2
+        print(format_report(report))
+        failed |= not report.deterministic
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,313 @@
+#!/usr/bin/env python3
+"""
+Parallel sensitivity analysis of terminal quantities
+
+Replaces hand-built decks like ROCKET6G/input_insertion_sensitivity.asc (one
+vehicle copy per perturbed value, run serially). The input deck is parsed
+once; for every listed input variable the nominal case and the cases with
+the value perturbed by +delta and -delta are rendered from it and run
+concurrently, each in a workspace that links the example's data decks
+(aero, propulsion, weather) instead of copying them. With 2n+1 cores the
+study takes about as long as one run.
+
+The terminal quantities are read from the last row of plot1.asc (the
+'time = -1' row the executive writes with the final state) and the central
+difference
+
+    S[i][j] = (y_i(x_j + delta_j) - y_i(x_j - delta_j)) / (2 delta_j)
+
+forms the sensitivity matrix. Monte Carlo draws in the deck use the same
+seed in every case, so they do not add noise to the differences.
+
+Deltas are absolute ('factq=0.5') or relative to the nominal value
+('alt=2%').
+
+Usage:
+    python3 tools/sensitivity.py ROCKET6G --input input_insertion.asc \\
+        --vary factq=0.5 factp=0.5 xcg_ref=1% --outputs alt dvbe thtvdx
+    python3 tools/sensitivity.py ROCKET6G --vary factq=0.5 --json sens.json
+"""
+
+import argparse
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+from concurrent.futures import ThreadPoolExecutor
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+CADAC_ROOT = Path(__file__).resolve().parent.parent
+EXAMPLE_DIR = CADAC_ROOT / 'example'
+
+# Terminal quantities of an orbital insertion: altitude, speed, flight path angle
+DEFAULT_OUTPUTS = ('alt', 'dvbe', 'thtvdx')
+
+# Monte Carlo keywords that precede the variable name on a vehicle data line
+MC_KEYWORDS = {'UNI', 'GAUSS', 'RAYL', 'EXP', 'MARKOV'}
+
+_VEHICLE_RE = re.compile(r'^\s*VEHICLES\s+(\d+)')
+
+
+@dataclass
+class Perturbation:
+    """Input variable and its perturbation size"""
+    variable: str
+    delta: float
+    relative: bool = False
+
+    @classmethod
+    def parse(cls, text: str) -> 'Perturbation':
+        name, sep, size = text.partition('=')
+        if not sep or not name:
+            raise ValueError(f"expected NAME=DELTA or NAME=DELTA%, got '{text}'")
+        relative = size.endswith('%')
+        delta = float(size[:-1]) / 100 if relative else float(size)
+        if delta == 0:
+            raise ValueError(f"'{text}': perturbation must not be zero")
+        return cls(name, delta, relative)
+
+
+@dataclass
+class Case:
+    """One rendered run of the study"""
+    name: str
+    variable: Optional[str] = None
+    value: Optional[float] = None
+    terminal: Dict[str, float] = field(default_factory=dict)
+    error: str = ""
+
+
+class Scenario:
+    """Input deck parsed once; cases are rendered by replacing single values"""
+
+    def __init__(self, input_file: Path, vehicle: int = 1):
+        """
+        Args:
+            input_file: Input deck
+            vehicle: Vehicle block (1-based) whose variables are perturbed
+        """
+        self.input_file = Path(input_file)
+        self.lines = self.input_file.read_text(errors='replace').splitlines(keepends=True)
+        self.values: Dict[str, Tuple[int, int, float]] = {}
+        """variable -> (line index, token index, nominal value)"""
+
+        self.decks: List[str] = []
+        """Data decks the deck loads ('AERO_DECK aero_deck_SLV.asc', ...)"""
+
+        block = 0
+        in_vehicles = False
+        for index, line in enumerate(self.lines):
+            code = line.split('//')[0]
+            tokens = code.split()
+            if not tokens:
+                continue
+            if tokens[0].endswith('_DECK') and len(tokens) > 1 and tokens[1] not in self.decks:
+                self.decks.append(tokens[1])
+            if _VEHICLE_RE.match(code):
+                in_vehicles = True
+                continue
+            if not in_vehicles or not line[0].isspace():
+                continue
+            if line.startswith('\t') and not line.startswith('\t\t') and tokens[0] != 'END':
+                block += 1      # vehicle header line, e.g. '\tHYPER6 SLV'
+                continue
+            if block != vehicle:
+                continue
+            position = 1 if tokens[0] not in MC_KEYWORDS else 2
+            if len(tokens) > position:
+                try:
+                    value = float(tokens[position])
+                except ValueError:
+                    continue
+                self.values.setdefault(tokens[position - 1], (index, position, value))
+        if not self.values:
+            raise ValueError(f"{self.input_file.name}: vehicle {vehicle} has no numeric variables")
+
+    def nominal(self, variable: str) -> float:
+        if variable not in self.values:
+            raise KeyError(f"'{variable}' is not a numeric variable of the vehicle block "
+                           f"in {self.input_file.name}")
+        return self.values[variable][2]
+
+    def render(self, variable: Optional[str] = None, value: Optional[float] = None) -> str:
+        """Deck text with one value replaced (nominal deck without arguments)"""
+        if variable is None:
+            return ''.join(self.lines)
+        index, position, _ = self.values[variable]
+        lines = list(self.lines)
+        line = lines[index]
+        code, sep, comment = line.partition('//')
+        parts = re.split(r'(\s+)', code)
+        # re.split keeps separators at odd positions; a leading tab gives an empty first part
+        words = [k for k, part in enumerate(parts) if part and not part.isspace()]
+        parts[words[position]] = f"{value:.10g}"
+        lines[index] = ''.join(parts) + sep + comment
+        return ''.join(lines)
+
+
+def terminal_values(plot_file: Path, outputs: List[str]) -> Dict[str, float]:
+    """Last row of a plot file: the final state the executive writes with time = -1"""
+    lines = plot_file.read_text(errors='replace').splitlines()
+    nvars = int(lines[1].split()[-1])
+    tokens = [t for line in lines[2:] for t in line.split()]
+    names = tokens[:nvars]
+    missing = [o for o in outputs if o not in names]
+    if missing:
+        raise ValueError(f"{', '.join(missing)} not in {plot_file.name} (not plotted by any module)")
+    values = tokens[nvars:]
+    last = values[len(values) - len(values) % nvars - nvars:][:nvars]
+    row = dict(zip(names, last))
+    return {o: float(row[o]) for o in outputs}
+
+
+def run_case(executable: Path, example_dir: Path, decks: List[str], deck_text: str, case: Case,
+             outputs: List[str], scratch: Path, timeout: float) -> Case:
+    """
+    Run one case in a workspace of links to the shared data decks
+
+    Only the decks the input loads are linked: output files must never be
+    links, or the run would write through them into the example directory.
+    """
+    workspace = scratch / case.name
+    workspace.mkdir()
+    for deck in decks:
+        (workspace / deck).symlink_to((example_dir / deck).resolve())
+    (workspace / 'input.asc').write_text(deck_text)
+    try:
+        subprocess.run([str(executable)], cwd=workspace, stdin=subprocess.DEVNULL,
+                       stdout=subprocess.DEVNULL, stderr=subprocess.PIPE,
+                       timeout=timeout, check=True)
+        case.terminal = terminal_values(workspace / 'plot1.asc', outputs)
+    except subprocess.TimeoutExpired:
+        case.error = f"timed out after {timeout:g} sec"
+    except subprocess.CalledProcessError as e:
+        case.error = f"exit code {e.returncode}: {e.stderr.decode(errors='replace')[-500:]}"
+    except (FileNotFoundError, ValueError, IndexError) as e:
+        case.error = str(e)
+    return case
+
+
+def study(example: str, perturbations: List[Perturbation], outputs: List[str],
+          input_name: str = 'input.asc', vehicle: int = 1, workers: Optional[int] = None,
+          timeout: float = 900) -> dict:
+    """
+    Run the nominal and the +/-delta cases in parallel and build the sensitivity matrix
+
+    Returns:
+        {'nominal': {output: value}, 'inputs': {variable: {nominal, delta}},
+         'matrix': {output: {variable: dy/dx}}, 'cases': [...]}
+
+    Raises:
+        RuntimeError: If a case fails
+    """
+    example_dir = EXAMPLE_DIR / example
+    executable = example_dir / _target(example_dir)
+    scenario = Scenario(example_dir / input_name, vehicle)
+
+    cases = [(Case('nominal'), scenario.render())]
+    inputs = {}
+    for p in perturbations:
+        nominal = scenario.nominal(p.variable)
+        delta = abs(p.delta * nominal) if p.relative else abs(p.delta)
+        if delta == 0:
+            raise ValueError(f"'{p.variable}': relative perturbation of a zero nominal value")
+        inputs[p.variable] = {'nominal': nominal, 'delta': delta}
+        for sign, label in ((+1, 'plus'), (-1, 'minus')):
+            value = nominal + sign * delta
+            cases.append((Case(f"{p.variable}_{label}", p.variable, value),
+                          scenario.render(p.variable, value)))
+
+    scratch = Path(tempfile.mkdtemp(prefix=f'sensitivity-{example}-'))
+    try:
+        with ThreadPoolExecutor(max_workers=workers or os.cpu_count() or 1) as pool:
+            done = list(pool.map(lambda c: run_case(executable, example_dir, scenario.decks, c[1], c[0],
+                                                    outputs, scratch, timeout), cases))
+    finally:
+        shutil.rmtree(scratch, ignore_errors=True)
+
+    failed = [c for c in done if c.error]
+    if failed:
+        raise RuntimeError('\n'.join(f"{c.name}: {c.error}" for c in failed))
+
+    by_name = {c.name: c for c in done}
+    matrix = {o: {} for o in outputs}
+    for variable, info in inputs.items():
+        plus, minus = by_name[f"{variable}_plus"], by_name[f"{variable}_minus"]
+        for o in outputs:
+            matrix[o][variable] = (plus.terminal[o] - minus.terminal[o]) / (2 * info['delta'])
+    return {
+        'example': example,
+        'input': input_name,
+        'nominal': by_name['nominal'].terminal,
+        'inputs': inputs,
+        'matrix': matrix,
+        'cases': [{'name': c.name, 'variable': c.variable, 'value': c.value, 'terminal': c.terminal}
+                  for c in done],
+    }
+
+
+def format_matrix(result: dict) -> str:
+    """Sensitivity matrix as a table: one row per output, one column per input"""
+    variables = list(result['inputs'])
+    width = max([12] + [len(v) + 2 for v in variables])
+    lines = [f"{result['example']} / {result['input']}: d(output)/d(input), central differences"]
+    lines.append(f"{'output':<10} {'nominal':>14} " + ''.join(f"{v:>{width}}" for v in variables))
+    for output, row in result['matrix'].items():
+        lines.append(f"{output:<10} {result['nominal'][output]:>14.6g} "
+                     + ''.join(f"{row[v]:>{width}.4g}" for v in variables))
+    lines.append("")
+    lines.append("inputs: " + ', '.join(f"{v} = {i['nominal']:g} +/- {i['delta']:g}"
+                                        for v, i in result['inputs'].items()))
+    return '\n'.join(lines)
+
+
+def _target(example_dir: Path) -> str:
+    """TARGET of an example Makefile"""
+    text = (example_dir / 'Makefile').read_text()
+    match = re.search(r'^TARGET\s*=\s*(\S+)', text, re.MULTILINE)
+    return match.group(1) if match else example_dir.name.lower()
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('example', help="example name (directory under example/)")
+    parser.add_argument('--input', default='input.asc', help="input deck in the example directory")
+    parser.add_argument('--vehicle', type=int, default=1, help="vehicle block to perturb (1-based)")
+    parser.add_argument('--vary', nargs='+', required=True, metavar='NAME=DELTA[%]',
+                        help="input variables and perturbation sizes")
+    parser.add_argument('--outputs', nargs='+', default=list(DEFAULT_OUTPUTS),
+                        help="terminal quantities (plotted variables)")
+    parser.add_argument('--workers', type=int, help="concurrent runs (default: number of cores)")
+    parser.add_argument('--timeout', type=float, default=900, help="wall-clock limit per run (sec)")
+    parser.add_argument('--json', type=Path, help="write the study to a JSON file")
+    args = parser.parse_args()
+
+    try:
+        perturbations = [Perturbation.parse(v) for v in args.vary]
+    except ValueError as e:
+        parser.error(str(e))
+
+    build = subprocess.run(['make', '-C', str(EXAMPLE_DIR / args.example)], capture_output=True, text=True)
+    if build.returncode != 0:
+        print(f"*** Error: {args.example} does not build\n{build.stderr[-1000:]}", file=sys.stderr)
+        return 1
+    try:
+        result = study(args.example, perturbations, args.outputs, args.input, args.vehicle,
+                       args.workers, args.timeout)
+    except (KeyError, ValueError, RuntimeError) as e:
+        print(f"*** Error: {e}", file=sys.stderr)
+        return 1
+
+    print(format_matrix(result))
+    if args.json:
+        args.json.write_text(json.dumps(result, indent=2) + '\n')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())